@@ -25,7 +25,11 @@ AC_ARG_ENABLE(papi,
 	  #include <stdlib.h>
         ],[
 	  char *errstr = (char*)malloc(PAPI_MAX_STR_LEN);
+	  int event = PAPI_TOT_CYC;
 	  int ret = PAPI_library_init(PAPI_VER_CURRENT);
+	  /* dumpi uses the classic high-level API (gone in PAPI 6) */
+	  if(ret == PAPI_VER_CURRENT && PAPI_start_counters(&event, 1) != PAPI_OK)
+	    return EXIT_FAILURE;
 	  if(ret != PAPI_VER_CURRENT) {
             PAPI_perror(ret, errstr, PAPI_MAX_STR_LEN);
 	    return EXIT_FAILURE;
@@ -0,0 +1,40 @@
+AC_DEFUN([CHECK_PERF_EVENT], [
+
+# Check whether we can use the Linux perf_event_open interface for
+# performance counters (used when PAPI is not available).
+AH_TEMPLATE([DUMPI_HAVE_PERF_EVENT],
+            [Linux perf_event_open performance counters are supported.])
+AC_ARG_ENABLE(perf-event,
+  [  --disable-perf-event    Don't use Linux perf_event_open for perfcounters.],
+  [enable_perf_event=$enableval], [enable_perf_event=yes])
+AC_MSG_CHECKING([perf_event_open support])
+if test "$enable_perf_event" = "no"; then
+  AC_MSG_RESULT([disabled])
+else
+  AC_LINK_IFELSE(
+    [AC_LANG_PROGRAM(
+      [
+        #include <linux/perf_event.h>
+        #include <sys/syscall.h>
+        #include <unistd.h>
+        #include <string.h>
+      ],[
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_SOFTWARE;
+        attr.config = PERF_COUNT_SW_TASK_CLOCK;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+      ]
+    )],
+    [
+      AC_MSG_RESULT([yes])
+      AC_DEFINE(DUMPI_HAVE_PERF_EVENT)
+    ],[
+      AC_MSG_RESULT([no])
+    ]
+  )
+fi
+
+])
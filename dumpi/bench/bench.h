@@ -0,0 +1,89 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_BENCH_BENCH_H
+#define DUMPI_BENCH_BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Shared helpers for the microbenchmarks run by 'make bench'.
+ * Every result is printed as one JSON object per line on stdout so the
+ * output can be collected and compared between builds.
+ */
+
+/** Monotonic wall clock in seconds. */
+static inline double bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+/** Report one timed loop of iters operations. */
+static inline void bench_report(const char *name, long iters, double seconds) {
+  printf("{\"bench\":\"%s\",\"iterations\":%ld,\"seconds\":%.6f,"
+         "\"ns_per_op\":%.3f}\n", name, iters, seconds,
+         (iters > 0 ? 1e9 * seconds / (double)iters : 0.0));
+  fflush(stdout);
+}
+
+/** Iteration count from argv[1], or dflt when none was given. */
+static inline long bench_iterations(int argc, char **argv, long dflt) {
+  long iters = dflt;
+  if(argc > 1) {
+    iters = atol(argv[1]);
+    if(iters <= 0) {
+      fprintf(stderr, "Usage:  %s [iterations]\n", argv[0]);
+      exit(1);
+    }
+  }
+  return iters;
+}
+
+/** Keep the optimizer from discarding a computed value. */
+static volatile unsigned long bench_sink;
+
+#endif /* ! DUMPI_BENCH_BENCH_H */
@@ -0,0 +1,198 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bench/bench.h>
+#include <dumpi/libundumpi/reader.h>
+#include <dumpi/libundumpi/filter.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Selective reads of a trace set, with the selection pushed down into
+ * the reader (undumpi_set_filter) versus tested by the caller after each
+ * record has been decoded.  Every query is timed both ways over the same
+ * trace files, and the two runs have to select the same records.
+ *
+ * Usage:  benchfilter repeat trace.bin...
+ */
+
+namespace {
+
+  /** Nanoseconds of a dumpi_clock. */
+  inline int64_t to_nsec(const dumpi_clock &clk) {
+    return (int64_t)clk.sec * 1000000000LL + clk.nsec;
+  }
+
+  /** Counts the records it sees, testing them against filter first
+   *  unless filter is NULL.  The digest depends on the function and start
+   *  time of every record seen, in order. */
+  struct counter {
+    const undumpi_filter *filter;
+    long count;
+    int64_t first, last;
+    uint64_t digest;
+
+    template <typename T>
+    void on(const T &prm, const dumpi::event &ev) {
+      int64_t start = to_nsec(ev.wall.start);
+      if(filter != NULL && ! keep(prm, ev, start))
+        return;
+      if(count == 0 || start < first) first = start;
+      if(count == 0 || start > last) last = start;
+      digest = (digest * 1099511628211ULL) ^ (uint64_t)ev.function;
+      digest = (digest * 1099511628211ULL) ^ (uint64_t)start;
+      ++count;
+    }
+
+    template <typename T>
+    bool keep(const T &prm, const dumpi::event &ev, int64_t start) const {
+      int64_t begin = to_nsec(filter->wall_begin);
+      int64_t end = to_nsec(filter->wall_end);
+      if(! filter->function[ev.function])
+        return false;
+      if(begin < end && (start < begin || start >= end))
+        return false;
+      if(filter->thread >= 0 && ev.thread != filter->thread)
+        return false;
+      if(undumpi_filter_has_args(filter) &&
+         ! undumpi_filter_args(filter, ev.function, &prm))
+        return false;
+      return true;
+    }
+  };
+
+  /** Read every trace once.  With pushdown the filter is handed to the
+   *  reader, otherwise the counter applies it. */
+  void read_all(int nfiles, char **files, const undumpi_filter *filter,
+                bool pushdown, counter &cnt)
+  {
+    memset(&cnt, 0, sizeof(counter));
+    cnt.filter = (pushdown ? NULL : filter);
+    for(int i = 0; i < nfiles; ++i) {
+      dumpi_profile *profile = undumpi_open(files[i]);
+      if(profile == NULL) {
+        fprintf(stderr, "benchfilter:  Failed to open %s\n", files[i]);
+        exit(1);
+      }
+      if(pushdown)
+        undumpi_set_filter(profile, filter);
+      dumpi::read_stream(profile, cnt);
+      undumpi_close(profile);
+      free(profile);
+    }
+  }
+
+  /** Time one query both ways; returns false if the selections differ. */
+  bool run_query(const char *name, long repeat, int nfiles, char **files,
+                 const undumpi_filter *filter)
+  {
+    counter post, push;
+    char label[64];
+    double t0 = bench_now();
+    for(long r = 0; r < repeat; ++r)
+      read_all(nfiles, files, filter, false, post);
+    snprintf(label, sizeof(label), "filter.%s_post", name);
+    bench_report(label, repeat, bench_now() - t0);
+    t0 = bench_now();
+    for(long r = 0; r < repeat; ++r)
+      read_all(nfiles, files, filter, true, push);
+    snprintf(label, sizeof(label), "filter.%s_pushdown", name);
+    bench_report(label, repeat, bench_now() - t0);
+    if(post.count != push.count) {
+      fprintf(stderr, "benchfilter:  %s selected %ld records after "
+              "decoding but %ld with pushdown\n", name, post.count,
+              push.count);
+      return false;
+    }
+    if(post.digest != push.digest) {
+      fprintf(stderr, "benchfilter:  %s selected different records after "
+              "decoding and with pushdown\n", name);
+      return false;
+    }
+    bench_sink += push.count;
+    return true;
+  }
+
+}
+
+int main(int argc, char **argv) {
+  undumpi_filter filter;
+  counter all;
+  long repeat;
+  bool good = true;
+  if(argc < 3 || (repeat = atol(argv[1])) <= 0) {
+    fprintf(stderr, "Usage:  %s repeat trace.bin...\n", argv[0]);
+    return 1;
+  }
+  argc -= 2;
+  argv += 2;
+
+  /* Everything (the cost of having a filter at all) */
+  undumpi_filter_init(&filter);
+  good &= run_query("all", repeat, argc, argv, &filter);
+
+  /* Only the sends */
+  undumpi_filter_init(&filter);
+  undumpi_filter_all_functions(&filter, 0);
+  filter.function[DUMPI_Send] = filter.function[DUMPI_Isend] = 1;
+  good &= run_query("sends", repeat, argc, argv, &filter);
+
+  /* The middle tenth of the run */
+  read_all(argc, argv, NULL, true, all);
+  undumpi_filter_init(&filter);
+  filter.wall_begin = dumpi_clock_init_scale(all.first +
+                                             (all.last - all.first) * 45 / 100,
+                                             1000000000LL);
+  filter.wall_end = dumpi_clock_init_scale(all.first +
+                                           (all.last - all.first) * 55 / 100,
+                                           1000000000LL);
+  good &= run_query("window", repeat, argc, argv, &filter);
+
+  /* Point-to-point traffic with rank 0 */
+  undumpi_filter_init(&filter);
+  filter.peer = 0;
+  good &= run_query("peer", repeat, argc, argv, &filter);
+
+  return (good ? 0 : 1);
+}
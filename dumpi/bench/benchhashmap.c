@@ -0,0 +1,125 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bench/bench.h>
+#include <dumpi/common/hashmap.h>
+#include <stdint.h>
+
+/*
+ * Microbenchmarks for the DUMPI_DECLARE_HASHMAP maps libdumpi uses to
+ * translate MPI handles.  Two key layouts are measured: pointer-like
+ * handles (as in Open MPI, where handles are addresses of objects) and
+ * small integer handles (as in MPICH).
+ */
+
+DUMPI_DECLARE_HASHMAP(bench, intptr_t, int32_t)
+
+/** Handle number i in the given key layout. */
+static inline intptr_t bench_key(int pointers, long i) {
+  if(pointers)
+    return (intptr_t)0x7f0000100000LL + (intptr_t)i * 192;
+  return (intptr_t)0x44000000 + (intptr_t)i;
+}
+
+/** Lookups of live keys in a map holding nkeys entries. */
+static void bench_get(long iters, int pointers, long nkeys) {
+  dumpi_hm_bench *hm;
+  char label[64];
+  unsigned long sum = 0;
+  double t0;
+  long i;
+  dumpi_hm_bench_init(&hm, 0);
+  for(i = 0; i < nkeys; ++i)
+    dumpi_hm_bench_get(hm, bench_key(pointers, i));
+  t0 = bench_now();
+  for(i = 0; i < iters; ++i)
+    sum += dumpi_hm_bench_get(hm, bench_key(pointers, i % nkeys));
+  snprintf(label, sizeof(label), "hashmap.get_%s%ld",
+           (pointers ? "ptr" : "int"), nkeys);
+  bench_report(label, iters, bench_now() - t0);
+  bench_sink = sum;
+  dumpi_hm_bench_free(&hm);
+}
+
+/**
+ * The request life cycle: every operation maps a new handle and erases
+ * the one posted window operations earlier, so window requests are
+ * outstanding at any time.
+ */
+static void bench_churn(long iters, int pointers, long window) {
+  dumpi_hm_bench *hm;
+  char label[64];
+  unsigned long sum = 0;
+  double t0;
+  long i;
+  dumpi_hm_bench_init(&hm, 0);
+  for(i = 0; i < window; ++i)
+    dumpi_hm_bench_set(hm, bench_key(pointers, i), (int32_t)i);
+  t0 = bench_now();
+  for(i = window; i < iters + window; ++i) {
+    sum += dumpi_hm_bench_set(hm, bench_key(pointers, i % (4*window)),
+                              (int32_t)i);
+    sum += dumpi_hm_bench_test(hm, bench_key(pointers, (i-window) % (4*window)));
+    dumpi_hm_bench_erase(hm, bench_key(pointers, (i-window) % (4*window)));
+  }
+  snprintf(label, sizeof(label), "hashmap.set_erase_%s%ld",
+           (pointers ? "ptr" : "int"), window);
+  bench_report(label, iters, bench_now() - t0);
+  bench_sink = sum;
+  dumpi_hm_bench_free(&hm);
+}
+
+int main(int argc, char **argv) {
+  static const long sizes[] = {16, 256, 4096};
+  long iters = bench_iterations(argc, argv, 2000000);
+  int pointers;
+  size_t i;
+  for(pointers = 1; pointers >= 0; --pointers) {
+    for(i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+      bench_get(iters, pointers, sizes[i]);
+    for(i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+      bench_churn(iters, pointers, sizes[i]);
+  }
+  return 0;
+}
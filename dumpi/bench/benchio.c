@@ -0,0 +1,215 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bench/bench.h>
+#include <dumpi/common/iodefs.h>
+#include <dumpi/common/dumpiio.h>
+#include <dumpi/common/io.h>
+#include <string.h>
+
+/*
+ * Microbenchmarks for the iodefs.h put/get primitives and for the
+ * dumpi_write_* / dumpi_read_* routines of a few representative records.
+ * Writes go through the normal output buffer into a scratch file, and
+ * reads come back from that file, just as libdumpi and libundumpi do.
+ */
+
+/** Number of requests in the array benchmarks (a typical Waitall). */
+#define BENCH_ARRAY_LEN 16
+
+/** Output buffer used for the scratch profiles. */
+#define BENCH_MEMBUF_SIZE (1<<20)
+
+static dumpi_profile* open_scratch(void) {
+  dumpi_profile *profile = dumpi_alloc_output_profile(0, 0, BENCH_MEMBUF_SIZE);
+  assert(profile != NULL);
+  profile->file = tmpfile();
+  assert(profile->file != NULL);
+  return profile;
+}
+
+static void close_scratch(dumpi_profile *profile) {
+  fclose(profile->file);
+  dumpi_free_output_profile(profile);
+}
+
+/** Time ITERS calls of PUT, then read the values back with GET. */
+#define BENCH_PRIMITIVE(LABEL, TYPE, PUT, GET) do {			\
+    dumpi_profile *profile = open_scratch();				\
+    off_t start = DUMPI_WRITE_TELL(profile);				\
+    unsigned long sum = 0;						\
+    double t0;								\
+    long i;								\
+    t0 = bench_now();							\
+    for(i = 0; i < iters; ++i)						\
+      PUT(profile, (TYPE)i);						\
+    DUMPI_FLUSH(profile);						\
+    bench_report("iodefs." #PUT LABEL, iters, bench_now() - t0);	\
+    DUMPI_SEEK(profile, start, SEEK_SET);				\
+    t0 = bench_now();							\
+    for(i = 0; i < iters; ++i)						\
+      sum += GET(profile);						\
+    bench_report("iodefs." #GET LABEL, iters, bench_now() - t0);	\
+    bench_sink = sum;							\
+    close_scratch(profile);						\
+  } while(0)
+
+static void bench_primitives(long iters) {
+  BENCH_PRIMITIVE("", uint8_t, put8, get8);
+  BENCH_PRIMITIVE("", uint16_t, put16, get16);
+  BENCH_PRIMITIVE("", uint32_t, put32, get32);
+  BENCH_PRIMITIVE("", uint64_t, put64, get64);
+}
+
+static void bench_request_arrays(long iters) {
+  dumpi_profile *profile = open_scratch();
+  off_t start = DUMPI_WRITE_TELL(profile);
+  dumpi_request req[BENCH_ARRAY_LEN], *back = NULL;
+  unsigned long sum = 0;
+  int32_t count = 0;
+  double t0;
+  long i;
+  for(i = 0; i < BENCH_ARRAY_LEN; ++i)
+    req[i] = (dumpi_request)(i + 10);
+  t0 = bench_now();
+  for(i = 0; i < iters; ++i)
+    put_requests(profile, BENCH_ARRAY_LEN, req);
+  DUMPI_FLUSH(profile);
+  bench_report("iodefs.put_requests16", iters, bench_now() - t0);
+  DUMPI_SEEK(profile, start, SEEK_SET);
+  t0 = bench_now();
+  for(i = 0; i < iters; ++i) {
+    get_requests(profile, &count, &back);
+    if(count > 0) sum += back[count-1];
+    free(back);
+  }
+  bench_report("iodefs.get_requests16", iters, bench_now() - t0);
+  bench_sink = sum;
+  close_scratch(profile);
+}
+
+/** Arguments shared by every record write. */
+static dumpi_outputs output;
+static dumpi_time cpu, wall;
+
+/* Arguments filled in by every record read. */
+static uint16_t rthread;
+static dumpi_time rcpu, rwall;
+static dumpi_perfdata rperf;
+
+/**
+ * Time ITERS writes of VAL with dumpi_write_NAME, then read the records
+ * back with dumpi_read_NAME (running CLEANUP on each record read).
+ */
+#define BENCH_RECORD(NAME, TYPE, VAL, CLEANUP) do {			\
+    dumpi_profile *profile = open_scratch();				\
+    off_t start = DUMPI_WRITE_TELL(profile);				\
+    TYPE back;								\
+    double t0;								\
+    long i;								\
+    t0 = bench_now();							\
+    for(i = 0; i < iters; ++i) {					\
+      wall.start.nsec = (int32_t)i;					\
+      dumpi_write_##NAME(&VAL, 0, &cpu, &wall, NULL, &output, profile); \
+    }									\
+    DUMPI_FLUSH(profile);						\
+    bench_report("dumpiio.write_" #NAME, iters, bench_now() - t0);	\
+    DUMPI_SEEK(profile, start, SEEK_SET);				\
+    t0 = bench_now();							\
+    for(i = 0; i < iters; ++i) {					\
+      if(dumpi_read_next_function(profile) == DUMPI_END_OF_STREAM)	\
+        abort();							\
+      dumpi_read_##NAME(&back, &rthread, &rcpu, &rwall, &rperf, profile); \
+      CLEANUP;								\
+    }									\
+    bench_report("dumpiio.read_" #NAME, iters, bench_now() - t0);	\
+    close_scratch(profile);						\
+  } while(0)
+
+static void bench_records(long iters) {
+  dumpi_request requests[BENCH_ARRAY_LEN];
+  dumpi_status statuses[BENCH_ARRAY_LEN];
+  dumpi_send send;
+  dumpi_isend isend;
+  dumpi_wait wait;
+  dumpi_waitall waitall;
+  int i;
+
+  memset(&output, 0, sizeof(output));
+  output.timestamps = DUMPI_TIME_FULL;
+  output.statuses = DUMPI_ENABLE;
+  for(i = 0; i < DUMPI_END_OF_STREAM; ++i)
+    output.function[i] = DUMPI_ENABLE;
+  cpu.start.sec = cpu.stop.sec = wall.start.sec = wall.stop.sec = 0;
+  cpu.start.nsec = 100; cpu.stop.nsec = 200; wall.stop.nsec = 300;
+
+  memset(statuses, 0, sizeof(statuses));
+  for(i = 0; i < BENCH_ARRAY_LEN; ++i) {
+    requests[i] = (dumpi_request)(i + 10);
+    statuses[i].bytes = 1024;
+    statuses[i].source = i;
+    statuses[i].tag = 7;
+  }
+  send.count = 1024; send.datatype = DUMPI_DOUBLE; send.dest = 1;
+  send.tag = 7; send.comm = DUMPI_COMM_WORLD;
+  isend.count = 1024; isend.datatype = DUMPI_DOUBLE; isend.dest = 1;
+  isend.tag = 7; isend.comm = DUMPI_COMM_WORLD; isend.request = 10;
+  wait.request = 10; wait.status = statuses;
+  waitall.count = BENCH_ARRAY_LEN; waitall.requests = requests;
+  waitall.statuses = statuses;
+
+  BENCH_RECORD(send, dumpi_send, send, (void)0);
+  BENCH_RECORD(isend, dumpi_isend, isend, (void)0);
+  BENCH_RECORD(wait, dumpi_wait, wait, free(back.status));
+  BENCH_RECORD(waitall, dumpi_waitall, waitall,
+               (free(back.requests), free(back.statuses)));
+}
+
+int main(int argc, char **argv) {
+  long iters = bench_iterations(argc, argv, 2000000);
+  bench_primitives(iters);
+  bench_request_arrays(iters / 10);
+  bench_records(iters / 10);
+  return 0;
+}
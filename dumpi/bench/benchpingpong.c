@@ -0,0 +1,111 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bench/bench.h>
+#include <mpi.h>
+#include <string.h>
+
+/*
+ * Isend/Wait ping-pong between ranks 0 and 1.  The same source is built
+ * twice, once against plain MPI and once against libdumpi (with
+ * BENCH_TRACED defined), so the difference between the two runs is the
+ * per-call cost of the profiling wrappers.
+ */
+
+#ifdef BENCH_TRACED
+#define BENCH_PINGPONG_LABEL "pingpong.traced"
+#else
+#define BENCH_PINGPONG_LABEL "pingpong.untraced"
+#endif
+
+/** Message size in bytes; small, so the wrappers dominate. */
+#define BENCH_PINGPONG_BYTES 8
+
+static void pingpong(int rank, long iters) {
+  char buf[BENCH_PINGPONG_BYTES];
+  MPI_Request req;
+  int peer = 1 - rank;
+  long i;
+  memset(buf, 0, sizeof(buf));
+  for(i = 0; i < iters; ++i) {
+    if(rank == 0) {
+      MPI_Isend(buf, sizeof(buf), MPI_CHAR, peer, 0, MPI_COMM_WORLD, &req);
+      MPI_Wait(&req, MPI_STATUS_IGNORE);
+      MPI_Irecv(buf, sizeof(buf), MPI_CHAR, peer, 0, MPI_COMM_WORLD, &req);
+      MPI_Wait(&req, MPI_STATUS_IGNORE);
+    }
+    else {
+      MPI_Irecv(buf, sizeof(buf), MPI_CHAR, peer, 0, MPI_COMM_WORLD, &req);
+      MPI_Wait(&req, MPI_STATUS_IGNORE);
+      MPI_Isend(buf, sizeof(buf), MPI_CHAR, peer, 0, MPI_COMM_WORLD, &req);
+      MPI_Wait(&req, MPI_STATUS_IGNORE);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  int rank, size;
+  long iters;
+  double t0, elapsed;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  if(size != 2) {
+    if(rank == 0)
+      fprintf(stderr, "%s:  Needs exactly 2 ranks (got %d)\n", argv[0], size);
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+  iters = bench_iterations(argc, argv, 200000);
+  /* Warm up connections and the handle maps before timing. */
+  pingpong(rank, iters / 100 + 1);
+  MPI_Barrier(MPI_COMM_WORLD);
+  t0 = bench_now();
+  pingpong(rank, iters);
+  elapsed = bench_now() - t0;
+  /* Each rank makes four MPI calls per round trip. */
+  if(rank == 0)
+    bench_report(BENCH_PINGPONG_LABEL, 4*iters, elapsed);
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,41 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+
+# Selective reads with and without filter pushdown (see benchfilter.cc).
+# BENCH_TRACE names the metafile to read (default: a synthetic trace
+# written by dumpigen with BENCH_GENFLAGS).  BENCH_REPEAT sets the number
+# of timed runs of each query.
+
+srcdir=${srcdir:-.}
+genflags=${BENCH_GENFLAGS:-"-r 16 -s 20000 -g 2 -S 1"}
+repeat=${BENCH_REPEAT:-5}
+bindir=`pwd`/../bin
+benchdir=`pwd`
+workdir=`pwd`/`mktemp -d bench-filter.XXXXXX` || exit 1
+
+if test -n "$BENCH_TRACE"; then
+  meta=$BENCH_TRACE
+else
+  $bindir/dumpigen $genflags -o $workdir/gen || exit 1
+  meta=$workdir/gen.meta
+fi
+
+# The metafile names its traces relative to its own directory.
+cd `dirname $meta` || exit 1
+prefix=`sed -n 's/^fileprefix=//p' \`basename $meta\``
+
+good=0
+$benchdir/benchfilter $repeat $prefix-[0-9][0-9][0-9][0-9].bin || good=1
+
+rm -rf $workdir
+exit $good
@@ -0,0 +1,45 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+
+# Run the Isend/Wait ping-pong on two local ranks with and without
+# libdumpi and report the per-call cost of the wrappers.
+# Set MPIRUN to override the launcher (e.g. "mpirun --oversubscribe -np 2").
+
+MPIRUN=${MPIRUN:-"mpirun -np 2"}
+iters=${BENCH_PINGPONG_ITERATIONS:-200000}
+bindir=`pwd`
+workdir=`mktemp -d bench-pingpong.XXXXXX` || exit 1
+
+cd $workdir
+cat >dumpi.conf <<CONF
+fileroot=pingpong
+CONF
+
+$MPIRUN $bindir/benchpingpong $iters > untraced.json &&
+$MPIRUN $bindir/benchpingpong_traced $iters > traced.json
+good="$?"
+
+if test "$good" = "0"; then
+  cat untraced.json traced.json
+  tracebytes=`cat pingpong-*.bin | wc -c`
+  cat untraced.json traced.json | awk -v bytes=$tracebytes -F'[:,}]' '
+    { for(i = 1; i < NF; ++i) if($i == "\"ns_per_op\"") ns[NR] = $(i+1);
+      if(NR == 1) iters = $4 }
+    END { printf("{\"bench\":\"pingpong.overhead\",\"iterations\":%d,"  \
+                 "\"trace_bytes\":%d,\"ns_per_op\":%.3f}\n",
+                 iters, bytes, ns[2] - ns[1]) }'
+fi
+
+cd $bindir
+rm -rf $workdir
+exit $good
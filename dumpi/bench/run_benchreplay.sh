@@ -0,0 +1,76 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+
+# Replay throughput of dumpi2ascii and dumpistats.
+# BENCH_TRACE names the metafile to replay (default: a synthetic trace
+# written by dumpigen with BENCH_GENFLAGS).  BENCH_REPEAT sets the number
+# of timed runs.
+
+srcdir=${srcdir:-.}
+genflags=${BENCH_GENFLAGS:-"-r 16 -s 20000 -g 2 -S 1"}
+repeat=${BENCH_REPEAT:-5}
+bindir=`pwd`/../bin
+workdir=`pwd`/`mktemp -d bench-replay.XXXXXX` || exit 1
+
+if test -n "$BENCH_TRACE"; then
+  meta=$BENCH_TRACE
+else
+  $bindir/dumpigen $genflags -o $workdir/gen || exit 1
+  meta=$workdir/gen.meta
+fi
+
+# The metafile names its traces relative to its own directory.
+cd `dirname $meta` || exit 1
+meta=`basename $meta`
+prefix=`sed -n 's/^fileprefix=//p' $meta`
+bytes=`cat $prefix-[0-9][0-9][0-9][0-9].bin | wc -c`
+
+$bindir/dumpi2ascii -I $meta -o $workdir/ascii || exit 1
+records=`cat $workdir/ascii-*.txt | grep -c ' entering at '`
+
+now() {
+  date +%s.%N
+}
+
+report() {
+  awk -v name=$1 -v n=$repeat -v t0=$2 -v t1=$3 -v bytes=$bytes \
+      -v records=$records 'BEGIN {
+    s = (t1 - t0) / n;
+    printf("{\"bench\":\"%s\",\"iterations\":%d,\"seconds\":%.6f," \
+           "\"bytes\":%d,\"records\":%d,\"mb_per_s\":%.3f," \
+           "\"records_per_s\":%.1f}\n",
+           name, n, s, bytes, records, bytes / s / 1e6, records / s) }'
+}
+
+good=0
+t0=`now`
+i=0
+while test $i -lt $repeat; do
+  # dumpi2ascii -I will not replace the previous run's output
+  rm -f $workdir/ascii-*.txt
+  $bindir/dumpi2ascii -I $meta -o $workdir/ascii || good=1
+  i=`expr $i + 1`
+done
+report replay.dumpi2ascii $t0 `now`
+
+t0=`now`
+i=0
+while test $i -lt $repeat; do
+  $bindir/dumpistats --bin=all --count=all --time=mpi --sent=sends \
+      --recvd=recvs -i $meta -o $workdir/stats || good=1
+  i=`expr $i + 1`
+done
+report replay.dumpistats $t0 `now`
+
+rm -rf $workdir
+exit $good
@@ -0,0 +1,16 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+
+# Each query must select the same records with the filter pushed down
+# into the reader as when it is tested after decoding.
+./benchfilter 1 $srcdir/../../tests/traces/testtrace-*.bin > /dev/null
@@ -58,10 +58,15 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <string.h>
 #include <stdio.h>
 #include <errno.h>
-#include <regex.h>
 #include <getopt.h>
 #include <limits.h>
+#include <ctype.h>
 #include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
 #include <time.h>
 
 /* A simple conversion from ascii output from dumpi back to a binary trace */
@@ -107,6 +112,7 @@ static struct option options[] = {
   {"help", no_argument, NULL, 'h'},
   {"verbose", no_argument, NULL, 'v'},
   {"out", required_argument, NULL, 'o'},
+  {"threads", required_argument, NULL, 'j'},
   {NULL, 0, NULL, '\0'}
 };
 
@@ -121,6 +127,7 @@ typedef struct settings {
   char *out;
   int infiles;
   char **in;
+  int threads;
   /* This is the output profile.  It can only be "formally" initialized
    * once we know the time bias */
   dumpi_profile *profile;
@@ -133,6 +140,12 @@ typedef struct settings {
   int labels;
   uint64_t *label_value;
   char **label_name;
+  /* Call statistics (profile mode) and the function they are filling */
+  dumpi_callstats *callstats;
+  int callstats_fn;
+  /* Communication matrix (profile mode); rank is -1 until one is read */
+  dumpi_commstats commstats;
+  int commpeer_max, commcoll_max;
   /*
   int active_perfctrs;
   dumpi_perflabel_t *perfctr_labels;
@@ -141,20 +154,48 @@ typedef struct settings {
   int input_version[3];
 } settings;
 
+/* An input file.  Regular files are mapped into memory; anything else
+ * (standard input, pipes) is read a line at a time from fp. */
+typedef struct infile {
+  const char *fname;
+  FILE *fp;
+  char *data;
+  size_t size;
+} infile;
+
+/* A range of lines set aside by a worker thread (see parse_infile) */
+typedef struct linespan {
+  const char *start;
+  size_t len;
+  long lineno;
+} linespan;
+
 /* Unfortunately, ungetc only guarantees a single character push-back
  * (we really need a one-line push-back).  Fix this by providing a wrapper
- * around the file and stashing a single line as needed.
+ * around the input and stashing a single line as needed.
  * Wrapper returns NULL when input file is depleted. */
 typedef struct fwrapper {
   FILE *fp;
+  const char *pos, *end;  /* unread part of a mapped input */
+  const char *line;       /* start of the current line in a mapped input */
   char *buff;
   size_t buffsize;
   int hot;
   long lineno;
   const char *fname;
+  /* When set, only stream records are converted; everything else is
+   * collected in spans to be replayed later in input order. */
+  int defer;
+  linespan *spans;
+  int nspans, maxspans;
 } fwrapper;
-static inline fwrapper wrap_create(FILE *fp, const char *fname) {
-  fwrapper w = {fp, NULL, 0, 0, 0, fname};
+static inline fwrapper wrap_create(const infile *in) {
+  fwrapper w;
+  memset(&w, 0, sizeof(fwrapper));
+  w.fp = in->fp;
+  w.pos = in->data;
+  w.end = in->data + in->size;
+  w.fname = in->fname;
   return w;
 }
 
@@ -165,34 +206,29 @@ static inline char* wrap_getline(fwrapper *wrap) {
     wrap->hot = 0;
     return wrap->buff;
   }
-  /* Ensure we have a buffer */
-  if(! wrap->buff) {
-    wrap->buffsize = 8192;
-    assert((wrap->buff = (char*)calloc(wrap->buffsize, sizeof(char))) != NULL);
+  if(wrap->fp) {
+    ssize_t len = getline(&wrap->buff, &wrap->buffsize, wrap->fp);
+    if(len < 0)
+      return NULL;
+    if(len > 0 && wrap->buff[len-1] == '\n')
+      wrap->buff[len-1] = '\0';
   }
-  /* Grab next string.  Dynamically reallocate the buffer if needed */
-  if(fgets(wrap->buff, wrap->buffsize, wrap->fp) == NULL)
-    return NULL;
-  /*
-    fprintf(stderr, "Initial read: %s\n", wrap->buff);
-    fprintf(stderr, "strlen(wrap->buff)=%d, wrap->buffsize-1=%d\n", strlen(wrap->buff), wrap->buffsize-1);
-  */
-  while(strlen(wrap->buff) >= (wrap->buffsize-1) && !(wrap->buff[wrap->buffsize-2]=='\n' || feof(wrap->fp) || ferror(wrap->fp))) {
-    assert((wrap->buff =
-            (char*)realloc(wrap->buff, 2*wrap->buffsize*sizeof(char))) != NULL);
-    fgets(wrap->buff + wrap->buffsize - 1, wrap->buffsize+1, wrap->fp); 
-    wrap->buff[2*wrap->buffsize-1] = '\0';
-    wrap->buffsize *= 2;
-    /*
-      fprintf(stderr, "Increased read starting at %d: %s has length %d\n", wrap->buffsize-1, wrap->buff, strlen(wrap->buff));
-    */
-    /*
-      fprintf(stderr, "Updated strlen(wrap->buff)=%d, wrap->buffsize-1=%d\n", strlen(wrap->buff), wrap->buffsize-1);
-    */
+  else {
+    const char *nl;
+    size_t len;
+    if(wrap->pos >= wrap->end)
+      return NULL;
+    nl = (const char*)memchr(wrap->pos, '\n', wrap->end - wrap->pos);
+    len = (nl ? nl : wrap->end) - wrap->pos;
+    if(len >= wrap->buffsize) {
+      wrap->buffsize = (len < 8192 ? 8192 : 2*len);
+      assert((wrap->buff = (char*)realloc(wrap->buff, wrap->buffsize)) != NULL);
+    }
+    memcpy(wrap->buff, wrap->pos, len);
+    wrap->buff[len] = '\0';
+    wrap->line = wrap->pos;
+    wrap->pos = (nl ? nl+1 : wrap->end);
   }
-  /*fprintf(stderr, "Read: %s of length %lu\n", wrap->buff, strlen(wrap->buff));*/
-  if(wrap->buff[strlen(wrap->buff)-1] == '\n')
-    wrap->buff[strlen(wrap->buff)-1] = '\0';
   return wrap->buff;
 }
 
@@ -201,21 +237,78 @@ static inline void wrap_ungetline(fwrapper *wrap) {
   wrap->hot = 1;
 }
 
+/* Map a file into memory, or fall back on line-by-line reads. */
+static int infile_open(infile *in, const char *fname) {
+  struct stat st;
+  int fd;
+  memset(in, 0, sizeof(infile));
+  in->fname = fname;
+  if((fd = open(fname, O_RDONLY)) < 0)
+    return 0;
+  if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    void *addr = NULL;
+    if(st.st_size == 0) {
+      close(fd);
+      return 1;
+    }
+    addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(addr != MAP_FAILED) {
+      madvise(addr, st.st_size, MADV_SEQUENTIAL);
+      in->data = (char*)addr;
+      in->size = st.st_size;
+      close(fd);
+      return 1;
+    }
+  }
+  if((in->fp = fdopen(fd, "r")) == NULL) {
+    close(fd);
+    return 0;
+  }
+  return 1;
+}
+
+static void infile_close(infile *in) {
+  if(in->data) munmap(in->data, in->size);
+  if(in->fp && in->fp != stdin) fclose(in->fp);
+  in->data = NULL;
+  in->fp = NULL;
+}
+
 typedef void (*mpihandler)(fwrapper *wrapper, settings *opts);
-mpihandler get_handler(const char *func, const fwrapper *wrap);
+static mpihandler get_handler(const char *func, size_t len,
+                              const fwrapper *wrap);
+static int find_function(const char *name, size_t len);
+static void init_funchash(void);
+
+/* One input file converted by a worker thread (see convert_parallel) */
+typedef struct convjob {
+  infile in;
+  settings opts;  /* copy of the global settings with a private profile */
+  fwrapper wrap;
+  off_t body;     /* offset of the first record in the private stream */
+} convjob;
+
+typedef struct convpool {
+  convjob *jobs;
+  int count, next;
+  pthread_mutex_t lock;
+} convpool;
 
 static void print_help();
 static void parse_opts(int argc, char **argv, settings *opts);
-static void parse_infile(const char *fname, FILE *fp, settings *opts);
+static void parse_infile(fwrapper *wrap, settings *opts);
+static int convert_parallel(settings *opts);
 
 int main(int argc, char **argv) {
-  int i;
+  int i, rv;
   struct settings opts;
   /* These have to be right to avoid pain and suffering */
   memset(&opts, 0, sizeof(struct settings));
   opts.header.version[0] = dumpi_version;
   opts.header.version[1] = dumpi_subversion;
   opts.header.version[2] = dumpi_subsubversion;
+  opts.callstats_fn = -1;
+  opts.commstats.rank = -1;
   parse_opts(argc, argv, &opts);
   if(opts.help) {
     print_help(argv[0]);
@@ -226,23 +319,51 @@ int main(int argc, char **argv) {
   opts.outputs.perfinfo = 0; /* until we find out whether it's there or not */
   for(i = 0; i <= DUMPI_ALL_FUNCTIONS; ++i)
     opts.outputs.function[i] = DUMPI_ENABLE;
-  if(opts.infiles > 0) {
-    int i;
-    FILE *fp;
+  init_funchash();
+  /* The parallel path declines (-1) unless every input can be mapped */
+  rv = -1;
+  if(opts.infiles > 1 && opts.threads > 1)
+    rv = convert_parallel(&opts);
+  if(rv > 0)
+    return rv;
+  if(rv == 0) {
+    /* already converted */
+  }
+  else if(opts.infiles > 0) {
+    infile in;
+    fwrapper wrap;
     for(i = 0; i < opts.infiles; ++i) {
-      if((fp = fopen(opts.in[i], "r")) == NULL) {
+      if(! infile_open(&in, opts.in[i])) {
         fprintf(stderr, "Failed to open \"%s\" for reading:  %s\n",
                 opts.in[i], strerror(errno));
         return 3;
       }
       if(opts.verbose) fprintf(stderr, "Processing infile %s\n", opts.in[i]);
-      parse_infile(opts.in[i], fp, &opts);
-      fclose(fp);
+      wrap = wrap_create(&in);
+      parse_infile(&wrap, &opts);
+      free(wrap.buff);
+      infile_close(&in);
     }
   }
   else {
+    infile in;
+    fwrapper wrap;
+    memset(&in, 0, sizeof(infile));
+    in.fname = "<stdin>";
+    in.fp = stdin;
     if(opts.verbose) fprintf(stderr, "Processing standard input\n");
-    parse_infile("<stdin>", stdin, &opts);
+    wrap = wrap_create(&in);
+    parse_infile(&wrap, &opts);
+    free(wrap.buff);
+  }
+  /* Profile-mode traces carry statistics but no stream data */
+  if(! opts.profile && (opts.callstats || opts.commstats.rank >= 0)) {
+    assert((opts.profile = dumpi_alloc_output_profile(0, 0, 4096)) != NULL);
+    if((opts.profile->file = dumpi_open_output_file(opts.out)) == NULL) {
+      fprintf(stderr, "Failed to create output file %s: %s\n",
+              opts.out, strerror(errno));
+      return 3;
+    }
   }
   /* Clean up. */
   if(opts.profile && opts.profile->file) {
@@ -253,6 +374,10 @@ int main(int argc, char **argv) {
             (int)opts.header.version[2]);
     dumpi_write_header(opts.profile, &opts.header);
     dumpi_write_footer(opts.profile, &opts.footer);
+    if(opts.callstats)
+      dumpi_write_callstats(opts.profile, opts.callstats);
+    if(opts.commstats.rank >= 0)
+      dumpi_write_commstats(opts.profile, &opts.commstats);
     dumpi_write_keyval_record(opts.profile, &opts.keyval);
     dumpi_write_datatype_sizes(opts.profile, &opts.typesize);
     /*
@@ -275,10 +400,12 @@ int main(int argc, char **argv) {
 void print_help(const char *name) {
   fprintf(stderr,
           "%s: Convert ASCII dumpi trace back to binary form\n"
-          "    Usage: %s [-h] [-v] -o outfile [infile(s)]\n"
+          "    Usage: %s [-h] [-v] [-j threads] -o outfile [infile(s)]\n"
           "    If one or more infiles are given, all infiles will be parsed\n"
           "    to generate the single outfile.  If no infiles are given,\n"
-          "    data will be read from standard input\n", name, name);
+          "    data will be read from standard input\n"
+          "    Several infiles are parsed concurrently on -j threads\n"
+          "    (default: one per online processor)\n", name, name);
 }
 
 void parse_opts(int argc, char **argv, settings *opts) {
@@ -294,11 +421,13 @@ void parse_opts(int argc, char **argv, settings *opts) {
   opts->verbose = opts->help = opts->infiles = 0;
   opts->in = NULL;
   opts->out = NULL;
+  opts->threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
   while((ch = getopt_long(argc, argv, shopts, options, NULL)) != -1) {
     switch(ch) {
     case 'v': opts->verbose = 1; break;
     case 'h': opts->help = 1; break;
     case 'o': assert((opts->out = strdup(optarg)) != NULL); break;
+    case 'j': opts->threads = atoi(optarg); break;
     default:
       fprintf(stderr, "Invalid option %c\n", ch);
       exit(1);
@@ -323,27 +452,35 @@ void parse_opts(int argc, char **argv, settings *opts) {
   }
 }
 
-/* The regular expressions recognized as input keys. */
-#define REHEAD_1 "version=[0-9]+\\.[0-9]+\\.[0-9]+)|starttime=.*|hostname=.*"
-#define REHEAD_2 "username=.*|meshdim=[0-9]+|meshsize=(.*|\\[.*\\])|meshcrd=(.*|\\[.*\\]"
-#define REHEADER "^(" REHEAD_1 "|" REHEAD_2 ")$"
-#define RETIME "[0-9]+\\.[0-9]+"
-#define RESTREAM_START "[^ ]+ entering at walltime " RETIME \
-  ", cputime " RETIME " seconds in thread [0-9]+"
-#define RESTREAM_STOP "[^ ]+ returning at walltime " RETIME \
-  ", cputime " RETIME " seconds in thread [0-9]+"
-#define RESTREAM_PERF "Perfcounters: [([^= ]+?=[0-9]+(, )?)*]"
-#define REKEYVAL_START "^Total keyvals: [0-9]+$"
-#define REFUNCCOUNT "[^ ]+ called [0-9]+ times and ignored [0-9]+ times"
-#define REPERFCTR_START "Performance counters: [0-9]+"
-#define READDRLABEL "Function adress [0-9]+ has label"
-#define REDATATYPE "Datatype [0-9]+ (\\([-A-Za-z0-9_]+\\) )?has size [0-9]+"
-
-typedef struct matchmap {
-  const char *rexp;
-  regex_t *preg;
-  int (*handler)(fwrapper *wrapper, settings *opts);
-} matchmap;
+/*
+ * Recognized input keys.  Every top-level line is classified by a
+ * hand-written scan of its leading text; the forms accepted are those
+ * the regular expressions below used to describe:
+ *
+ *   header:    version=[0-9]+\.[0-9]+\.[0-9]+ | starttime=.* | hostname=.*
+ *              | username=.* | meshdim=[0-9]+ | meshsize=.* | meshcrd=.*
+ *   stream:    [^ ]+ entering at walltime [0-9]+\.[0-9]+, cputime
+ *              [0-9]+\.[0-9]+ seconds in thread [0-9]+
+ *   keyvals:   ^Total keyvals: [0-9]+$
+ *   counts:    [^ ]+ called [0-9]+ times and ignored [0-9]+ times
+ *   perfctrs:  Performance counters: [0-9]+
+ *   labels:    Function address [0-9]+ has label
+ *   datatypes: Datatype [0-9]+ (\([-A-Za-z0-9_]+\) )?has size [0-9]+
+ *   stats:     Call statistics from [0-9]+ thread\(s\)
+ *   calls:     [^ ]+ count=[0-9]+ total_ns=[0-9]+ min_ns=[0-9]+
+ *              max_ns=[0-9]+ bytes=[0-9]+
+ *   buckets:   "    "(time_ns|bytes) (0|[0-9]+-[0-9]+|[0-9]+\+): [0-9]+
+ *   matrix:    Communication matrix for rank -?[0-9]+ \([0-9]+ peer\(s\),
+ *              [0-9]+ communicator\(s\)\)
+ *   peers:     send peer=[0-9]+ messages=[0-9]+ bytes=[0-9]+
+ *   colls:     collective size=[0-9]+ leader=[0-9]+ calls=[0-9]+
+ *              bytes=[0-9]+
+ */
+typedef enum lineclass {
+  LINE_HEADER = 0, LINE_STREAM, LINE_KEYVAL, LINE_FUNCCOUNT, LINE_PERFCTR,
+  LINE_LABEL, LINE_DATATYPE, LINE_CALLSTATS, LINE_CALLENTRY, LINE_CALLBUCKET,
+  LINE_COMMSTATS, LINE_COMMPEER, LINE_COMMCOLL, LINE_UNKNOWN
+} lineclass;
 
 static int parse_header_entry(fwrapper *wrapper, settings *opts);
 static int start_stream_entry(fwrapper *wrapper, settings *opts);
@@ -352,64 +489,200 @@ static int add_function_entry(fwrapper *wrapper, settings *opts);
 static int parse_perfctr_entries(fwrapper *wrapper, settings *opts);
 static int add_label_entry(fwrapper *wrapper, settings *opts);
 static int add_datatype_size_entry(fwrapper *wrapper, settings *opts);
-
-static matchmap matches[] = {
-  {REHEADER, NULL, parse_header_entry},
-  {RESTREAM_START, NULL, start_stream_entry},
-  {REKEYVAL_START, NULL, parse_keyval_entries},
-  {REFUNCCOUNT, NULL, add_function_entry},
-  {REPERFCTR_START, NULL, parse_perfctr_entries},
-  {READDRLABEL, NULL, add_label_entry},
-  {REDATATYPE, NULL, add_datatype_size_entry},
-  {NULL, NULL, NULL}
+static int parse_callstats_entry(fwrapper *wrapper, settings *opts);
+static int add_callstats_entry(fwrapper *wrapper, settings *opts);
+static int add_callstats_bucket(fwrapper *wrapper, settings *opts);
+static int parse_commstats_entry(fwrapper *wrapper, settings *opts);
+static int add_commpeer_entry(fwrapper *wrapper, settings *opts);
+static int add_commcoll_entry(fwrapper *wrapper, settings *opts);
+
+/* Indexed by lineclass */
+static int (*const entry_handlers[])(fwrapper *wrapper, settings *opts) = {
+  parse_header_entry, start_stream_entry, parse_keyval_entries,
+  add_function_entry, parse_perfctr_entries, add_label_entry,
+  add_datatype_size_entry, parse_callstats_entry, add_callstats_entry,
+  add_callstats_bucket, parse_commstats_entry, add_commpeer_entry,
+  add_commcoll_entry
 };
 
-static inline regex_t* precompile_regex(const char *rexp) {
-  int rv;
-  regex_t *preg;
-  assert((preg = (regex_t*)calloc(1, sizeof(regex_t))) != NULL);
-  if((rv = regcomp(preg, rexp, REG_EXTENDED|REG_NOSUB)) != 0) {
-    fprintf(stderr, "Failed to compile regex \"%s\":  error=%d\n", rexp, rv);
-    abort();
+/* Skip a literal prefix; NULL if it does not match. */
+static inline const char* skip_lit(const char *p, const char *lit, size_t len) {
+  return (p && strncmp(p, lit, len) == 0) ? p + len : NULL;
+}
+#define SKIP_LIT(P, LIT) skip_lit(P, LIT, sizeof(LIT)-1)
+
+/* Skip one or more decimal digits; NULL if there are none. */
+static inline const char* skip_digits(const char *p) {
+  const char *start = p;
+  if(! p) return NULL;
+  while((unsigned)(*p - '0') < 10) ++p;
+  return (p > start) ? p : NULL;
+}
+
+/* Skip [0-9]+\.[0-9]+ */
+static inline const char* skip_time(const char *p) {
+  p = skip_digits(p);
+  if(p && *p == '.') return skip_digits(p+1);
+  return NULL;
+}
+
+/* Skip a run of non-blank characters followed by a space */
+static inline const char* skip_word(const char *p) {
+  const char *start = p;
+  while(*p != ' ' && *p != '\0') ++p;
+  return (p > start && *p == ' ') ? p : NULL;
+}
+
+static lineclass classify_line(const char *buf) {
+  const char *p;
+  switch(buf[0]) {
+  case 'v':
+    p = skip_digits(SKIP_LIT(buf, "version="));
+    if(p && *p == '.') p = skip_digits(p+1);
+    if(p && *p == '.' && skip_digits(p+1)) return LINE_HEADER;
+    break;
+  case 's':
+    if(SKIP_LIT(buf, "starttime=")) return LINE_HEADER;
+    if(skip_digits(SKIP_LIT(buf, "send peer="))) return LINE_COMMPEER;
+    break;
+  case 'c':
+    if(skip_digits(SKIP_LIT(buf, "collective size="))) return LINE_COMMCOLL;
+    break;
+  case ' ':
+    p = SKIP_LIT(buf, "    time_ns ");
+    if(! p) p = SKIP_LIT(buf, "    bytes ");
+    if(skip_digits(p)) return LINE_CALLBUCKET;
+    break;
+  case 'C':
+    if(skip_digits(SKIP_LIT(buf, "Call statistics from ")))
+      return LINE_CALLSTATS;
+    p = SKIP_LIT(buf, "Communication matrix for rank ");
+    if(p && *p == '-') ++p;
+    if(skip_digits(p)) return LINE_COMMSTATS;
+    break;
+  case 'h':
+    if(SKIP_LIT(buf, "hostname=")) return LINE_HEADER;
+    break;
+  case 'u':
+    if(SKIP_LIT(buf, "username=")) return LINE_HEADER;
+    break;
+  case 'm':
+    if(skip_digits(SKIP_LIT(buf, "meshdim=")) ||
+       SKIP_LIT(buf, "meshsize=") || SKIP_LIT(buf, "meshcrd="))
+      return LINE_HEADER;
+    break;
+  case 'T':
+    p = skip_digits(SKIP_LIT(buf, "Total keyvals: "));
+    if(p && *p == '\0') return LINE_KEYVAL;
+    break;
+  case 'P':
+    if(skip_digits(SKIP_LIT(buf, "Performance counters: ")))
+      return LINE_PERFCTR;
+    break;
+  case 'F':
+    p = skip_digits(SKIP_LIT(buf, "Function address "));
+    if(SKIP_LIT(p, " has label")) return LINE_LABEL;
+    break;
+  case 'D':
+    p = skip_digits(SKIP_LIT(buf, "Datatype "));
+    if(p && p[0] == ' ' && p[1] == '(') {
+      const char *q = p + 2;
+      while(*q == '-' || *q == '_' || isalnum((unsigned char)*q)) ++q;
+      if(q > p + 2 && q[0] == ')' && q[1] == ' ') p = q + 1;
+    }
+    if(skip_digits(SKIP_LIT(p, " has size "))) return LINE_DATATYPE;
+    break;
+  }
+  /* Stream records, call counts and call statistics lead with a name */
+  if((p = skip_word(buf)) == NULL)
+    return LINE_UNKNOWN;
+  if(skip_digits(SKIP_LIT(p, " count=")))
+    return LINE_CALLENTRY;
+  if(p[1] == 'e') {
+    p = skip_time(SKIP_LIT(p, " entering at walltime "));
+    p = skip_time(SKIP_LIT(p, ", cputime "));
+    if(skip_digits(SKIP_LIT(p, " seconds in thread "))) return LINE_STREAM;
   }
-  return preg;
+  else if(p[1] == 'c') {
+    p = skip_digits(SKIP_LIT(p, " called "));
+    p = skip_digits(SKIP_LIT(p, " times and ignored "));
+    if(SKIP_LIT(p, " times")) return LINE_FUNCCOUNT;
+  }
+  return LINE_UNKNOWN;
 }
 
-void parse_infile(const char *fname, FILE *fp, settings *opts) {
-  int i;
-  fwrapper wrap = wrap_create(fp, fname);
-  /* Precompile regexes on first pass */
-  for(i = 0; matches[i].rexp != NULL; ++i) {
-    if(matches[i].preg == NULL) {
-      matches[i].preg = precompile_regex(matches[i].rexp);
-    }
+/*
+ * Set aside a non-stream entry (one line, or a keyval/perfctr block
+ * with its entries) to be replayed once the worker threads are done.
+ */
+static void defer_entry(fwrapper *wrap, lineclass kind) {
+  long i, lines = 0;
+  linespan *span;
+  const char *buf = wrap_getline(wrap);
+  if(kind == LINE_KEYVAL || kind == LINE_PERFCTR)
+    lines = strtol(strchr(buf, ':') + 1, NULL, 10);
+  if(wrap->nspans >= wrap->maxspans) {
+    wrap->maxspans = (wrap->maxspans ? 2*wrap->maxspans : 64);
+    assert((wrap->spans = (linespan*)realloc(wrap->spans,
+                                             wrap->maxspans*sizeof(linespan)))
+           != NULL);
   }
-  while(! (feof(fp) || ferror(fp))) {
-    int matched = 0;
-    const char *buff = wrap_getline(&wrap);
-    if(! buff) break; /* All done */
-    for(i = 0; matches[i].rexp != NULL; ++i) {
-      if(regexec(matches[i].preg, buff, 0, NULL, 0) == 0) {
-        wrap_ungetline(&wrap);
-        /*fprintf(stderr, "Match:\n    %s\nmatches\n    %s\n\n", buff, matches[i].rexp);*/
-        matches[i].handler(&wrap, opts);
-        matched = 1;
-        break;
-      }
-    }
-    if(! matched) {
+  span = &wrap->spans[wrap->nspans++];
+  span->start = wrap->line;
+  span->lineno = wrap->lineno;
+  for(i = 0; i < lines; ++i)
+    if(! wrap_getline(wrap)) break;
+  span->len = wrap->pos - span->start;
+}
+
+void parse_infile(fwrapper *wrap, settings *opts) {
+  const char *buff;
+  while((buff = wrap_getline(wrap)) != NULL) {
+    lineclass kind = classify_line(buff);
+    if(kind == LINE_UNKNOWN) {
       fprintf(stderr, "No match for \"%s\" at %s:%ld\n",
-              buff, wrap.fname, wrap.lineno);
+              buff, wrap->fname, wrap->lineno);
+      continue;
     }
+    wrap_ungetline(wrap);
+    if(wrap->defer && kind != LINE_STREAM)
+      defer_entry(wrap, kind);
+    else
+      entry_handlers[kind](wrap, opts);
+  }
+}
+
+/*
+ * Parse a decimal integer with optional leading blanks and sign.
+ * Sets *end to the first character past the digits (or to str if
+ * there were no digits).
+ */
+static inline long long scan_int(const char *str, const char **end) {
+  const char *p = str;
+  unsigned long long val = 0;
+  unsigned digit;
+  int neg;
+  while(*p == ' ' || *p == '\t') ++p;
+  neg = (*p == '-');
+  p += (*p == '-' || *p == '+');
+  if((unsigned)(*p - '0') >= 10) {
+    *end = str;
+    return 0;
   }
+  while((digit = (unsigned)(*p - '0')) < 10) {
+    val = 10*val + digit;
+    ++p;
+  }
+  *end = p;
+  return neg ? -(long long)val : (long long)val;
 }
 
 static inline long long to_int(const char *ent, const char *caller,
                           const fwrapper *wrap)
 {
-  char *end;
-  long long val = strtoll(ent, &end, 10);
-  if((*ent == '\0') || (*end != '\0')) {
+  const char *end;
+  long long val = scan_int(ent, &end);
+  if((end == ent) || (*end != '\0')) {
     fprintf(stderr, "%s:  Invalid integer value \"%s\" at %s:%ld\n",
             caller, ent, wrap->fname, wrap->lineno);
     abort();
@@ -417,10 +690,43 @@ static inline long long to_int(const char *ent, const char *caller,
   return val;
 }
 
-void copymatch(char *scratch, const char *ivalue, regmatch_t *match) {
-  int len = match->rm_eo - match->rm_so;
-  strncpy(scratch, ivalue + match->rm_so, len);
-  scratch[len] = '\0';
+/*
+ * Reentrant, non-destructive strtok: returns the next token starting at
+ * *str (skipping leading delimiters) and its length, and leaves *str just
+ * past the delimiter that ended it.  Returns NULL (with length 0) when
+ * out of tokens.
+ */
+static inline const char* next_tok(const char **str, const char *delim,
+                                   size_t *len)
+{
+  const char *tok = *str + strspn(*str, delim);
+  if(*tok == '\0') {
+    *str = tok;
+    *len = 0;
+    return NULL;
+  }
+  *len = strcspn(tok, delim);
+  *str = tok + *len + (tok[*len] != '\0');
+  return tok;
+}
+
+/* to_int for a token returned by next_tok */
+static inline long long tok_int(const char *tok, size_t len,
+                                const char *caller, const fwrapper *wrap)
+{
+  const char *end;
+  long long val = scan_int(tok, &end);
+  if((end == tok) || (end != tok + len)) {
+    fprintf(stderr, "%s:  Invalid integer value \"%.*s\" at %s:%ld\n",
+            caller, (int)len, tok, wrap->fname, wrap->lineno);
+    abort();
+  }
+  return val;
+}
+
+/* Does the token equal the given string? */
+static inline int tok_eq(const char *tok, size_t len, const char *str) {
+  return (tok != NULL && strncmp(tok, str, len) == 0 && str[len] == '\0');
 }
 
 static inline void save_old_version(char *value, settings *opts,
@@ -446,13 +752,19 @@ static inline void save_old_starttime(char *value, settings *opts,
 {
   /* strptime converts ascii string to struct tm */
   /* mktime converts struct tm to time_t */
+  /* Start from a clean struct tm: a partial match must not pick up
+   * whatever happened to be on the stack. */
   struct tm tmo;
-  time_t tout;
-  strptime(value, "%a %b %d %T %Z %Y", &tmo);
-  tout = mktime(&tmo);
-  if(tout <= 0) {
-    strptime(value, "%a %b %d %T %Y", &tmo);
+  time_t tout = 0;
+  memset(&tmo, 0, sizeof(struct tm));
+  tmo.tm_isdst = -1;
+  if(strptime(value, "%a %b %d %T %Z %Y", &tmo) != NULL)
     tout = mktime(&tmo);
+  if(tout <= 0) {
+    memset(&tmo, 0, sizeof(struct tm));
+    tmo.tm_isdst = -1;
+    if(strptime(value, "%a %b %d %T %Y", &tmo) != NULL)
+      tout = mktime(&tmo);
   }
   if(tout <= 0) {
     fprintf(stderr, "Invalid time value \"%s\" at %s:%ld\n",
@@ -573,19 +885,17 @@ int parse_header_entry(fwrapper *wrapper, settings *opts) {
 
 int start_stream_entry(fwrapper *wrapper, settings *opts) {
   mpihandler handler = NULL;
-  char *buf, *tok;
-  buf = strdup(wrap_getline(wrapper));
+  const char *buf = wrap_getline(wrapper);
   wrap_ungetline(wrapper);
-  tok = strtok(buf, " ");
-  handler = get_handler(tok, wrapper);
+  buf += strspn(buf, " ");
+  handler = get_handler(buf, strcspn(buf, " "), wrapper);
   handler(wrapper, opts);
-  free(buf);
   return 1;
 }
 
 int parse_keyval_entries(fwrapper *wrapper, settings *opts) {
   int i;
-  char *buf, *totv, *key, *val;
+  char *buf, *totv, *key, *val, *sav;
   buf = wrap_getline(wrapper);
   /* first line is 'Total keyvals: [0-9]+' */
   totv = strchr(buf, ':');
@@ -604,8 +914,8 @@ int parse_keyval_entries(fwrapper *wrapper, settings *opts) {
     opts->keyval.tail = kv;
     /* subsequent lines are key=value (spaces are significant) */
     buf = wrap_getline(wrapper);
-    key = strtok(buf, "=");
-    val = strtok(NULL, "= ");
+    key = strtok_r(buf, "=", &sav);
+    val = strtok_r(NULL, "= ", &sav);
     if((! key) || (! val)) {
       fprintf(stderr, "parse_keyval_entries:  Invalid key=val "
               "at %s:%ld\n", wrapper->fname, wrapper->lineno);
@@ -617,192 +927,75 @@ int parse_keyval_entries(fwrapper *wrapper, settings *opts) {
   return 1;
 }
 
-typedef struct functag {
-  const char *name;
-  int index;
-} functag;
-static functag *funcnames = NULL;
-static int funccmp(const void *a, const void *b) {
-  const functag *left = (functag*)a;
-  const functag *right = (functag*)b;
-  return strcmp(left->name, right->name);
-}
-
-static inline int find_funcname(const char *name, fwrapper *wrapper) {
-  int pivot, old_pivot, lower_bound, upper_bound;
-  if(! funcnames) {
-    int i;
-    assert((funcnames =
-            (functag*)calloc(DUMPI_END_OF_STREAM+1, sizeof(functag))) != NULL);
-    for(i = 0; i < DUMPI_END_OF_STREAM; ++i) {
-      funcnames[i].name = dumpi_function_names[i];
-      funcnames[i].index = i;
-    }
-    qsort(funcnames, DUMPI_END_OF_STREAM, sizeof(functag), funccmp);
-  }
-  /* Bisect search to find the right element. */
-  lower_bound = 0;
-  upper_bound = DUMPI_END_OF_STREAM;
-  pivot = upper_bound / 2;
-  old_pivot = 0;
-  while(1) {
-    int cmp = strcmp(name, funcnames[pivot].name);
-    if(cmp == 0)
-      break;
-    else if(cmp < 0)
-      upper_bound = pivot;
-    else if(cmp > 0)
-      lower_bound = pivot;
-    pivot = lower_bound + (upper_bound - lower_bound) / 2;
-    if(pivot == old_pivot) {
-      fprintf(stderr, "find_funcname:  Failed to find \"%s\" at %s:%ld\n", 
-              name, wrapper->fname, wrapper->lineno);
-      abort();
-    }
-    old_pivot = pivot;
-  }
-  return funcnames[pivot].index;
-}
-
 int add_function_entry(fwrapper *wrapper, settings *opts) {
   int i, funcid;
-  char *buf, *funcname, *called, *ignored;
-  buf = wrap_getline(wrapper);
-  funcname = strtok(buf, " "); /* MPI.* */
-  strtok(NULL, " ");           /* called */
-  called = strtok(NULL, " ");  /* [0-9]+ */
-  for(i = 0; i < 3; ++i) strtok(NULL, " "); /* times and ignored */
-  ignored = strtok(NULL, " "); /* [0-9]+ */
-  funcid = find_funcname(funcname, wrapper);
-
-    for(i = 0; i < DUMPI_END_OF_STREAM; ++i) {
-    if(strcmp(dumpi_function_names[i], funcname) == 0)
-      break;
+  size_t len, namelen, calledlen, ignoredlen = 0;
+  const char *funcname, *called, *ignored = NULL;
+  const char *buf = wrap_getline(wrapper);
+  funcname = next_tok(&buf, " ", &namelen);     /* MPI.* */
+  next_tok(&buf, " ", &len);                    /* called */
+  called = next_tok(&buf, " ", &calledlen);     /* [0-9]+ */
+  for(i = 0; i < 3; ++i) next_tok(&buf, " ", &len); /* times and ignored */
+  if(called) ignored = next_tok(&buf, " ", &ignoredlen); /* [0-9]+ */
+  if(! (funcname && called && ignored)) {
+    fprintf(stderr, "add_function_entry:  Truncated entry at %s:%ld\n",
+            wrapper->fname, wrapper->lineno);
+    abort();
   }
-  if(i >= DUMPI_END_OF_STREAM) {
-    fprintf(stderr, "add_function_entry:  Invalid name \"%s\" at %s:%ld\n", 
-            funcname, wrapper->fname, wrapper->lineno);
+  if((funcid = find_function(funcname, namelen)) < 0) {
+    fprintf(stderr, "add_function_entry:  Invalid name \"%.*s\" at %s:%ld\n",
+            (int)namelen, funcname, wrapper->fname, wrapper->lineno);
     abort();
   }
-  opts->footer.call_count[i] = to_int(called, "add_function_entry", wrapper);
-  opts->footer.ignored_count[i] = to_int(ignored, "add_function_entry", wrapper);
+  opts->footer.call_count[funcid] =
+    tok_int(called, calledlen, "add_function_entry", wrapper);
+  opts->footer.ignored_count[funcid] =
+    tok_int(ignored, ignoredlen, "add_function_entry", wrapper);
   return 1;
 }
 
-static regex_t *perfctr_header_re = NULL;
-static regmatch_t *perfctr_match = NULL;
 int parse_perfctr_entries(fwrapper *wrapper, settings *opts) {
   /* Skipping perfctrs for now (running out of time). */
   int i, counters;
-  char *buf = wrap_getline(wrapper);
-  (void)wrapper;
+  const char *buf = wrap_getline(wrapper);
   (void)opts;
-  if(! perfctr_header_re) {
-    assert((perfctr_header_re = (regex_t*)calloc(1, sizeof(regex_t))) != NULL);
-    assert((perfctr_match = (regmatch_t*)calloc(2, sizeof(regmatch_t)))!=NULL);
-    assert(regcomp(perfctr_header_re, "^Performance counters: ([0-9]+)$",
-                   REG_EXTENDED) == 0);
-  }
-  if(regexec(perfctr_header_re, buf, 2, perfctr_match, 0) != 0) {
-    fprintf(stderr, "parse_perfctr_entries:  Invalid header line \"%s\" at %s:%ld\n", buf, wrapper->fname, wrapper->lineno);
-    abort();
-  }
-  buf[perfctr_match[1].rm_eo] = '\0';
-  counters =
-    to_int(buf + perfctr_match[1].rm_so, "parse_perfctr_entries", wrapper);
+  /* ^Performance counters: ([0-9]+)$ */
+  counters = to_int(buf + sizeof("Performance counters:")-1,
+                    "parse_perfctr_entries", wrapper);
   for(i = 0; i < counters; ++i)
     wrap_getline(wrapper);
   return 1;
-  /*
-  int i;
-  char *buf;
-  if(! perfctr_header_re) {
-    assert((perfctr_header_re = (regex_t*)calloc(1, sizeof(regex_t))) != NULL);
-    assert((perfctr_entry_re = (regex_t*)calloc(1, sizeof(regex_t))) != NULL);
-    assert((perfctr_match = (regmatch_t*)calloc(2, sizeof(regmatch_t)))!=NULL);
-    assert(regcomp(perfctr_header_re, "^Performance counters: ([0-9]+)$",
-                   REG_EXTENDED) == 0);
-    assert(regcomp(perfctr_entry_re, "^ *([A-Z0-9_]+)$", REG_EXTENDED) == 0);
-  }
-  buf = wrap_getline(wrapper);
-  if(regexec(perfctr_header_re, buf, 2, perfctr_match, 0) != 0) {
-    fprintf(stderr, "parse_perfctr_entries:  Invalid header line \"%s\" at %s:%ld\n", buf, wrapper->fname, wrapper->lineno);
-    abort();
-  }
-  buf[perfctr_match[1].rm_eo] = '\0';
-  opts->active_perfctrs =
-    to_int(buf + perfctr_match[1].rm_so, "parse_perfctr_entries", wrapper);
-  if(opts->active_perfctrs > 0) 
-    assert((opts->perfctr_labels =
-            (dumpi_perflabel_t*)calloc(opts->active_perfctrs,
-                                       sizeof(dumpi_perflabel_t))) != NULL);
-  for(i = 0; i < opts->active_perfctrs; ++i) {
-    if(regexec(perfctr_entry_re, buf, 3, perfctr_match, 0) != 0) {
-      fprintf(stderr, "parse_perfctr_entries:  Invalid key=val \"%s\" at %s:%ld\n", buf, wrapper->fname, wrapper->lineno);
-      abort();
-    }
-    buf[perfctr_match[1].rm_eo] = '\0';
-    opts->input_perfctr[i] = to_int(buf + perfctr_match[1].rm_so,
-                                    "parse_perfctr_entries", wrapper);
-  }
-  return 1;
-  */
 }
 
-static regex_t *label_re = NULL;
-static regmatch_t *label_match = NULL;
-static const char *label_string = "Function address ([0-9]+) has label (.*)";
 int add_label_entry(fwrapper *wrapper, settings *opts) {
-  char *addr, *lbl;
-  char *buf = wrap_getline(wrapper);
-  if(! label_re) {
-    assert((label_re = (regex_t*)calloc(1, sizeof(regex_t))) != NULL);
-    assert((label_match = (regmatch_t*)calloc(3, sizeof(regmatch_t))) != NULL);
-    assert(regcomp(label_re, label_string, REG_EXTENDED) == 0);
-  }
-  if(regexec(label_re, buf, 3, label_match, 0) != 0) {
-    fprintf(stderr, "Failed to match \"%s\" with the regex \"%s\" at %s:%ld\n",
-            buf, label_string, wrapper->fname, wrapper->lineno);
-    abort();
-  }
-  buf[label_match[1].rm_eo] = '\0';
-  buf[label_match[2].rm_eo] = '\0';
-  addr = buf + label_match[1].rm_so;
-  lbl = buf + label_match[2].rm_so;
+  const char *addr, *lbl;
+  const char *buf = wrap_getline(wrapper);
+  /* Function address ([0-9]+) has label (.*) */
+  addr = buf + sizeof("Function address ")-1;
+  lbl = strstr(addr, " has label");
+  lbl += sizeof(" has label")-1;
+  if(*lbl == ' ') ++lbl;
   opts->label_value = (uint64_t*)realloc(opts->label_value,
                                          (opts->labels+1)*sizeof(uint64_t));
   opts->label_name = (char**)realloc(opts->label_name,
                                      (opts->labels+1)*sizeof(char*));
-  opts->label_value[opts->labels] = to_int(addr, "add_label_entry", wrapper);
+  opts->label_value[opts->labels] =
+    tok_int(addr, strcspn(addr, " "), "add_label_entry", wrapper);
   opts->label_name[opts->labels] = strdup(lbl);
   ++opts->labels;
   return 1;
 }
 
-static regex_t *datatype_re = NULL;
-static regmatch_t *datatype_match = NULL;
-static const char *datatype_string = 
-  "Datatype ([0-9]+) (\\([-A-Za-z0-9_]+\\) )?has size ([0-9]+)";
 int add_datatype_size_entry(fwrapper *wrapper, settings *opts) {
   int index, size;
-  char *buf = wrap_getline(wrapper);
-  if(! datatype_re) {
-    assert((datatype_re = (regex_t*)calloc(1, sizeof(regex_t))) != NULL);
-    assert((datatype_match=(regmatch_t*)calloc(4, sizeof(regmatch_t))) != NULL);
-    assert(regcomp(datatype_re, datatype_string, REG_EXTENDED) == 0);
-  }
-  if(regexec(datatype_re, buf, 4, datatype_match, 0) != 0) {
-    fprintf(stderr, "add_label_entry: Failed to match \"%s\" with the "
-            "regex \"%s\" at %s:%ld\n", buf, datatype_string,
-            wrapper->fname, wrapper->lineno);
-    abort();
-  }
-  buf[datatype_match[1].rm_eo] = '\0';
-  buf[datatype_match[3].rm_eo] = '\0';
-  index = to_int(buf + datatype_match[1].rm_so,
-                 "add_datatype_size_entry", wrapper);
-  size = to_int(buf + datatype_match[3].rm_so,
-                "add_datatype_size_entry", wrapper);
+  const char *idx, *sz;
+  const char *buf = wrap_getline(wrapper);
+  /* Datatype ([0-9]+) (\([-A-Za-z0-9_]+\) )?has size ([0-9]+) */
+  idx = buf + sizeof("Datatype ")-1;
+  sz = strstr(idx, "has size ") + sizeof("has size ")-1;
+  index = tok_int(idx, strcspn(idx, " "), "add_datatype_size_entry", wrapper);
+  size = tok_int(sz, strspn(sz, "0123456789"), "add_datatype_size_entry",
+                 wrapper);
   if(index < 0 || index > 100000) {
     fprintf(stderr, "Bogus (negative) datatype index at %s:%ld\n",
             wrapper->fname, wrapper->lineno);
@@ -820,24 +1013,160 @@ int add_datatype_size_entry(fwrapper *wrapper, settings *opts) {
   return 1;
 }
 
+/* Read "<lit>[-0-9]+" at *p and step past it. */
+static long long field_int(const char **p, const char *lit,
+                           const char *caller, const fwrapper *wrap)
+{
+  const char *val = skip_lit(*p, lit, strlen(lit));
+  if(! val) {
+    fprintf(stderr, "%s:  Expected \"%s\" in \"%s\" at %s:%ld\n",
+            caller, lit, *p, wrap->fname, wrap->lineno);
+    abort();
+  }
+  *p = val + strspn(val, "-0123456789");
+  return tok_int(val, *p - val, caller, wrap);
+}
+
+int parse_callstats_entry(fwrapper *wrapper, settings *opts) {
+  const char *p = wrap_getline(wrapper);
+  /* Call statistics from N thread(s) */
+  if(! opts->callstats)
+    assert((opts->callstats =
+            (dumpi_callstats*)calloc(1, sizeof(dumpi_callstats))) != NULL);
+  opts->callstats->threads = field_int(&p, "Call statistics from ",
+                                       "parse_callstats_entry", wrapper);
+  opts->callstats_fn = -1;
+  return 1;
+}
+
+int add_callstats_entry(fwrapper *wrapper, settings *opts) {
+  int fn;
+  dumpi_callstats_entry *entry;
+  const char *p = wrap_getline(wrapper);
+  size_t len = strcspn(p, " ");
+  /* MPI_X count=N total_ns=T min_ns=T max_ns=T bytes=B */
+  fn = find_function(p, len);
+  if(fn < 0 || fn >= DUMPI_ALL_FUNCTIONS || ! opts->callstats) {
+    fprintf(stderr, "add_callstats_entry:  Unexpected entry for \"%.*s\" "
+            "at %s:%ld\n", (int)len, p, wrapper->fname, wrapper->lineno);
+    abort();
+  }
+  p += len;
+  entry = &opts->callstats->entry[fn];
+  entry->count = field_int(&p, " count=", "add_callstats_entry", wrapper);
+  entry->total_ns = field_int(&p, " total_ns=", "add_callstats_entry",
+                              wrapper);
+  entry->min_ns = field_int(&p, " min_ns=", "add_callstats_entry", wrapper);
+  entry->max_ns = field_int(&p, " max_ns=", "add_callstats_entry", wrapper);
+  entry->bytes = field_int(&p, " bytes=", "add_callstats_entry", wrapper);
+  opts->callstats_fn = fn;
+  return 1;
+}
+
+int add_callstats_bucket(fwrapper *wrapper, settings *opts) {
+  uint64_t low;
+  dumpi_callstats_entry *entry;
+  const char *p, *lo, *buf = wrap_getline(wrapper);
+  /* "    "(time_ns|bytes) LO-HI: N, where LO is the bucket's lower bound */
+  if(opts->callstats_fn < 0) {
+    fprintf(stderr, "add_callstats_bucket:  Bucket without a function "
+            "at %s:%ld\n", wrapper->fname, wrapper->lineno);
+    abort();
+  }
+  entry = &opts->callstats->entry[opts->callstats_fn];
+  lo = buf + sizeof("    ")-1;
+  lo += strcspn(lo, " ") + 1;
+  p = skip_digits(lo);
+  low = tok_int(lo, p - lo, "add_callstats_bucket", wrapper);
+  p += strcspn(p, ":");
+  if(SKIP_LIT(buf, "    time_ns "))
+    entry->time_hist[dumpi_callstats_bucket(low)] =
+      field_int(&p, ": ", "add_callstats_bucket", wrapper);
+  else
+    entry->size_hist[dumpi_callstats_bucket(low)] =
+      field_int(&p, ": ", "add_callstats_bucket", wrapper);
+  return 1;
+}
+
+int parse_commstats_entry(fwrapper *wrapper, settings *opts) {
+  int rank, peers, colls;
+  dumpi_commstats *stats = &opts->commstats;
+  const char *p = wrap_getline(wrapper);
+  /* Communication matrix for rank R (P peer(s), C communicator(s)) */
+  rank = field_int(&p, "Communication matrix for rank ",
+                   "parse_commstats_entry", wrapper);
+  peers = field_int(&p, " (", "parse_commstats_entry", wrapper);
+  colls = field_int(&p, " peer(s), ", "parse_commstats_entry", wrapper);
+  if(peers < 0 || colls < 0) {
+    fprintf(stderr, "Bogus (negative) matrix size at %s:%ld\n",
+            wrapper->fname, wrapper->lineno);
+    abort();
+  }
+  dumpi_clear_commstats(stats);
+  stats->rank = rank;
+  assert((stats->peer =
+          (dumpi_commpeer*)calloc(peers + 1, sizeof(dumpi_commpeer))) != NULL);
+  assert((stats->coll =
+          (dumpi_commcoll*)calloc(colls + 1, sizeof(dumpi_commcoll))) != NULL);
+  opts->commpeer_max = peers;
+  opts->commcoll_max = colls;
+  return 1;
+}
+
+int add_commpeer_entry(fwrapper *wrapper, settings *opts) {
+  dumpi_commpeer *peer;
+  dumpi_commstats *stats = &opts->commstats;
+  const char *p = wrap_getline(wrapper);
+  /* send peer=X messages=M bytes=B */
+  if(stats->peers >= opts->commpeer_max) {
+    fprintf(stderr, "Unexpected matrix peer entry at %s:%ld\n",
+            wrapper->fname, wrapper->lineno);
+    abort();
+  }
+  peer = &stats->peer[stats->peers++];
+  peer->peer = field_int(&p, "send peer=", "add_commpeer_entry", wrapper);
+  peer->messages = field_int(&p, " messages=", "add_commpeer_entry", wrapper);
+  peer->bytes = field_int(&p, " bytes=", "add_commpeer_entry", wrapper);
+  return 1;
+}
+
+int add_commcoll_entry(fwrapper *wrapper, settings *opts) {
+  dumpi_commcoll *coll;
+  dumpi_commstats *stats = &opts->commstats;
+  const char *p = wrap_getline(wrapper);
+  /* collective size=S leader=L calls=N bytes=B */
+  if(stats->colls >= opts->commcoll_max) {
+    fprintf(stderr, "Unexpected matrix communicator entry at %s:%ld\n",
+            wrapper->fname, wrapper->lineno);
+    abort();
+  }
+  coll = &stats->coll[stats->colls++];
+  coll->size = field_int(&p, "collective size=", "add_commcoll_entry", wrapper);
+  coll->leader = field_int(&p, " leader=", "add_commcoll_entry", wrapper);
+  coll->calls = field_int(&p, " calls=", "add_commcoll_entry", wrapper);
+  coll->bytes = field_int(&p, " bytes=", "add_commcoll_entry", wrapper);
+  return 1;
+}
+
 static long read_int(const char *type, const char *name, fwrapper *wrapper) {
-  char *buf, *itype, *iname, *ivalue;
-  int retval;
+  const char *buf, *itype, *iname, *ivalue;
+  size_t typelen, namelen, valuelen = 0;
   buf = wrap_getline(wrapper);
-  itype = strtok(buf, " ");
-  iname = strtok(NULL, "=");
-  ivalue = strtok(NULL, "] ");
-  if(ivalue[0] == '[') ivalue[0] = ' '; /* some entries are a little messed up */
-  if(strcmp(type, itype) != 0) {
+  itype = next_tok(&buf, " ", &typelen);
+  iname = next_tok(&buf, "=", &namelen);
+  ivalue = next_tok(&buf, "] ", &valuelen);
+  if(! tok_eq(itype, typelen, type)) {
     fprintf(stderr, "Invalid type name at %s%ld: "
-            "Expected \"%s\" but got \"%s\"\n",
-            wrapper->fname, wrapper->lineno, type, itype);
+            "Expected \"%s\" but got \"%.*s\"\n",
+            wrapper->fname, wrapper->lineno, type,
+            (int)(itype ? typelen : 0), itype);
     abort();
   }
-  if(strcmp(name, iname) != 0) {
+  if(! tok_eq(iname, namelen, name)) {
     fprintf(stderr, "Invalid variable name at %s%ld: "
-            "Expected \"%s\" but got \"%s\"\n",
-            wrapper->fname, wrapper->lineno, name, iname);
+            "Expected \"%s\" but got \"%.*s\"\n",
+            wrapper->fname, wrapper->lineno, name,
+            (int)(iname ? namelen : 0), iname);
     abort();
   }
   if(! ivalue) {
@@ -846,212 +1175,191 @@ static long read_int(const char *type, const char *name, fwrapper *wrapper) {
             wrapper->fname, wrapper->lineno);
     abort();
   }
-  retval = to_int(ivalue, "read_int", wrapper);
-  /*fprintf(stderr, "Now have %s %s=%d\n", itype, iname, retval);*/
-  return retval;
+  /* some entries are a little messed up */
+  if(ivalue[0] == '[') {
+    ++ivalue;
+    --valuelen;
+  }
+  return tok_int(ivalue, valuelen, "read_int", wrapper);
 }
 
-int read_int16vec(int16_t **outvec, const char *type,
-                  const char *name, fwrapper *wrapper)
+/*
+ * Read "TYPE NAME[LEN]=[v0, v1, ...]" into a freshly allocated
+ * vector of the given element size.  Returns LEN.
+ */
+static long read_vec(void **outvec, size_t elemsize, const char *caller,
+                     const char *type, const char *name, fwrapper *wrapper)
 {
-  char *buf, *itype, *iname, *ilen, *rawvec, *entry;
+  const char *buf, *itype, *iname, *ilen, *entry;
+  size_t typelen, namelen, lenlen, len;
   long arrlen, i;
   buf = wrap_getline(wrapper);
-  itype = strtok(buf, " ");
-  iname = strtok(NULL, "[");
-  ilen = strtok(NULL, "]");
-  if(strcmp(type, itype) != 0) {
-    fprintf(stderr, "read_int16vec:  Expected type label \"%s\""
-	    " but found \"%s\" at %s:%ld\n",
-	    type, itype, wrapper->fname, wrapper->lineno);
+  itype = next_tok(&buf, " ", &typelen);
+  iname = next_tok(&buf, "[", &namelen);
+  ilen = next_tok(&buf, "]", &lenlen);
+  if(! tok_eq(itype, typelen, type)) {
+    fprintf(stderr, "%s:  Expected type label \"%s\""
+	    " but found \"%.*s\" at %s:%ld\n", caller,
+	    type, (int)(itype ? typelen : 0), itype,
+            wrapper->fname, wrapper->lineno);
     abort();
   }
-  if(strcmp(name, iname) != 0) {
-    fprintf(stderr, "read_int16vec:  Expected variable name \"%s\""
-	    " but found \"%s\" at %s:%ld\n",
-	    name, iname, wrapper->fname, wrapper->lineno);
+  if(! tok_eq(iname, namelen, name)) {
+    fprintf(stderr, "%s:  Expected variable name \"%s\""
+	    " but found \"%.*s\" at %s:%ld\n", caller,
+	    name, (int)(iname ? namelen : 0), iname,
+            wrapper->fname, wrapper->lineno);
     abort();
   }
-  strtok(NULL, "[");
-  rawvec = strtok(NULL, "]");
-  arrlen = to_int(ilen, "read_int16vec", wrapper);
-  if(arrlen > 0) assert((*outvec = (int16_t*)calloc(arrlen, sizeof(int16_t))) != NULL);
+  if(! ilen) {
+    fprintf(stderr, "%s:  Missing array length at %s:%ld\n", caller,
+            wrapper->fname, wrapper->lineno);
+    abort();
+  }
+  next_tok(&buf, "[", &len);
+  arrlen = tok_int(ilen, lenlen, caller, wrapper);
+  if(arrlen > 0) assert((*outvec = calloc(arrlen, elemsize)) != NULL);
   else *outvec = NULL;
   for(i = 0; i < arrlen; ++i) {
-    entry = strtok((i ? NULL : rawvec), ", ");
+    long long val;
+    entry = next_tok(&buf, ", ]", &len);
     if(! entry) {
-      fprintf(stderr, "read_int16vec:  Insufficient vector length.  Expected %ld"
-	      " entries but found %ld at %s:%ld\n", arrlen, i, wrapper->fname,
-	      wrapper->lineno);
+      fprintf(stderr, "%s:  Insufficient vector length.  Expected %ld"
+	      " entries but found %ld at %s:%ld\n", caller, arrlen, i,
+              wrapper->fname, wrapper->lineno);
       abort();
     }
-    (*outvec)[i] = to_int(entry, "read_intvec", wrapper);
+    val = tok_int(entry, len, caller, wrapper);
+    if(elemsize == sizeof(int16_t))
+      ((int16_t*)*outvec)[i] = (int16_t)val;
+    else
+      ((int*)*outvec)[i] = (int)val;
   }
-  /*
-  fprintf(stderr, "Now have %s %s[%ld]=[", itype, iname, arrlen);
-  for(i = 0; i < arrlen; ++i)
-    fprintf(stderr, "%d%s", (*outvec)[i], (i < arrlen-1 ? ", " : ""));
-  fprintf(stderr, "]\n");
-  */
+  return arrlen;
+}
+
+int read_int16vec(int16_t **outvec, const char *type,
+                  const char *name, fwrapper *wrapper)
+{
+  void *vec;
+  long arrlen = read_vec(&vec, sizeof(int16_t), "read_int16vec",
+                         type, name, wrapper);
+  *outvec = (int16_t*)vec;
   return arrlen;
 }
 
 int read_intvec(int **outvec, const char *type,
                 const char *name, fwrapper *wrapper)
 {
-  char *buf, *itype, *iname, *ilen, *rawvec, *entry;
-  long arrlen, i;
-  buf = wrap_getline(wrapper);
-  itype = strtok(buf, " ");
-  iname = strtok(NULL, "[");
-  ilen = strtok(NULL, "]");
-  if(strcmp(type, itype) != 0) {
-    fprintf(stderr, "read_intvec:  Expected type label \"%s\""
-	    " but found \"%s\" at %s:%ld\n",
-	    type, itype, wrapper->fname, wrapper->lineno);
-    abort();
-  }
-  if(strcmp(name, iname) != 0) {
-    fprintf(stderr, "read_intvec:  Expected variable name \"%s\""
-	    " but found \"%s\" at %s:%ld\n",
-	    name, iname, wrapper->fname, wrapper->lineno);
-    abort();
-  }
-  strtok(NULL, "[");
-  rawvec = strtok(NULL, "]");
-  arrlen = to_int(ilen, "read_intvec", wrapper);
-  if(arrlen > 0) assert((*outvec = (int*)calloc(arrlen, sizeof(int))) != NULL);
-  else *outvec = NULL;
-  for(i = 0; i < arrlen; ++i) {
-    entry = strtok((i ? NULL : rawvec), ", ");
-    if(! entry) {
-      fprintf(stderr, "read_intvec:  Insufficient vector length.  Expected %ld"
-	      " entries but found %ld at %s:%ld\n", arrlen, i, wrapper->fname,
-	      wrapper->lineno);
-      abort();
-    }
-    (*outvec)[i] = to_int(entry, "read_intvec", wrapper);
-  }
-  /*
-  fprintf(stderr, "Now have %s %s[%ld]=[", itype, iname, arrlen);
-  for(i = 0; i < arrlen; ++i)
-    fprintf(stderr, "%d%s", (*outvec)[i], (i < arrlen-1 ? ", " : ""));
-  fprintf(stderr, "]\n");
-  */
+  void *vec;
+  long arrlen = read_vec(&vec, sizeof(int), "read_intvec",
+                         type, name, wrapper);
+  *outvec = (int*)vec;
   return arrlen;
 }
 
-static regex_t *status_re = NULL;
-static regmatch_t *status_match = NULL;
-static const char *status_pat =
-  "("
-    "<IGNORED>"
-  "|"
-    "\\{bytes=([0-9]+), cancelled=([0-9]+), source=([0-9]+), "
-    "tag=([0-9]+), error=([0-9]+)\\}"
-  ")";
-inline static void init_status_re() {
-  if(! status_re) {
-    int rv;
-    assert((status_re = (regex_t*)calloc(1, sizeof(regex_t))) != NULL);
-    assert((status_match = (regmatch_t*)calloc(8, sizeof(regmatch_t))) != NULL);
-    rv = regcomp(status_re, status_pat, REG_EXTENDED);
-    if(rv != 0) {
-      char buff[256]; buff[255] = '\0';
-      regerror(rv, status_re, buff, 255);
-      fprintf(stderr, "init_status_re: regcomp failed: %s\n", buff);
-      abort();
-    }
+/*
+ * Parse one "{bytes=B, cancelled=C, source=S, tag=T, error=E}" entry
+ * starting at str.  Returns a pointer past the closing brace, or NULL
+ * if the entry is malformed.
+ */
+static const char* scan_status(const char *str, dumpi_status *status) {
+  static const char *const keys[5] = {
+    "{bytes=", ", cancelled=", ", source=", ", tag=", ", error="
+  };
+  long long val[5];
+  const char *p = str;
+  int i;
+  for(i = 0; i < 5; ++i) {
+    size_t keylen = strlen(keys[i]);
+    const char *num = p + keylen;
+    if(strncmp(p, keys[i], keylen) != 0) return NULL;
+    val[i] = scan_int(num, &p);
+    if(p == num) return NULL;
   }
+  if(*p != '}') return NULL;
+  status->bytes = val[0];
+  status->cancelled = val[1];
+  status->source = val[2];
+  status->tag = val[3];
+  status->error = val[4];
+  return p + 1;
+}
+
+/*
+ * Find the first status value ("<IGNORED>" or "{bytes=...}") in str.
+ * Returns -1 if there is none, 0 if it is ignored, and 1 if it was
+ * stored in *status.
+ */
+static int find_status(const char *str, dumpi_status *status) {
+  const char *p;
+  for(p = strpbrk(str, "<{"); p; p = strpbrk(p+1, "<{")) {
+    if(*p == '<' && strncmp(p, "<IGNORED>", 9) == 0) return 0;
+    if(*p == '{' && scan_status(p, status)) return 1;
+  }
+  return -1;
 }
 
 dumpi_status* read_status(const char *name, fwrapper *wrapper) {
-  int i;
-  char *buf, *itype, *iname, *ivalue;
-  char scratch[256];
-  dumpi_status *retval = NULL;
-  init_status_re();
+  const char *buf, *itype, *iname, *ivalue;
+  size_t typelen, namelen, valuelen;
+  dumpi_status status, *retval = NULL;
   buf = wrap_getline(wrapper);
-  itype = strtok(buf, " ");
-  iname = strtok(NULL, "=");
-  ivalue = strtok(NULL, "]");
-  if(strcmp(itype, "MPI_Status") != 0) {
-    fprintf(stderr, "read_status:  Invalid type \"%s\" declared at %s:%ld\n",
-	    itype, wrapper->fname, wrapper->lineno);
+  itype = next_tok(&buf, " ", &typelen);
+  iname = next_tok(&buf, "=", &namelen);
+  ivalue = next_tok(&buf, "]", &valuelen);
+  if(! tok_eq(itype, typelen, "MPI_Status")) {
+    fprintf(stderr, "read_status:  Invalid type \"%.*s\" declared at %s:%ld\n",
+	    (int)(itype ? typelen : 0), itype, wrapper->fname, wrapper->lineno);
     abort();
   }
-  if(strcmp(iname, name) != 0) {
+  if(! tok_eq(iname, namelen, name)) {
     fprintf(stderr, "read_status:  Invalid variable name at %s:%ld.  "
-	    "Expected \"%s\" but got \"%s\"\n",
-	    wrapper->fname, wrapper->lineno, name, iname);
+	    "Expected \"%s\" but got \"%.*s\"\n",
+	    wrapper->fname, wrapper->lineno, name,
+            (int)(iname ? namelen : 0), iname);
     abort();
   }
-  if((! ivalue) || (ivalue[0] == '\0')) {
+  if(! ivalue) {
     fprintf(stderr, "read_status:  Invalid blank status at %s:%ld\n",
 	    wrapper->fname, wrapper->lineno);
     abort();
   }
-  if(regexec(status_re, ivalue, 8, status_match, 0) != 0) {
-    fprintf(stderr, "read_status:  Failed matching \"%s\" to the regex "
-	    "\"%s\" at %s:%ld\n", ivalue, status_pat,
-	    wrapper->fname, wrapper->lineno);
+  switch(find_status(ivalue, &status)) {
+  case 0:
+    break;
+  case 1:
+    assert((retval = (dumpi_status*)calloc(1, sizeof(dumpi_status))) != NULL);
+    *retval = status;
+    break;
+  default:
+    fprintf(stderr, "read_status:  Failed to parse status \"%s\" at %s:%ld\n",
+            ivalue, wrapper->fname, wrapper->lineno);
     abort();
   }
-  for(i = 0; i < 8; ++i) {
-    int len = status_match[i].rm_eo - status_match[i].rm_so;
-    if(len > 255) len = 255;
-    strncpy(scratch, ivalue+status_match[i].rm_so, len);
-    scratch[len] = '\0';
-  }
-  if(strncmp(ivalue+status_match[1].rm_so, "<IGNORED>", 
-	     status_match[1].rm_eo - status_match[1].rm_so) != 0)
-    {
-      assert((retval = (dumpi_status*)calloc(1, sizeof(dumpi_status))) != NULL);
-      copymatch(scratch, ivalue, status_match+2);
-      retval->bytes = to_int(scratch, "read_status", wrapper);
-      copymatch(scratch, ivalue, status_match+3);
-      retval->cancelled = to_int(scratch, "read_status", wrapper);
-      copymatch(scratch, ivalue, status_match+4);
-      retval->source = to_int(scratch, "read_status", wrapper);
-      copymatch(scratch, ivalue, status_match+5);
-      retval->tag = to_int(scratch, "read_status", wrapper);
-      copymatch(scratch, ivalue, status_match+6);
-      retval->error = to_int(scratch, "read_status", wrapper);
-    }
-  /*
-  fprintf(stderr, "We now have MPI_Status %s=", iname);
-  if(! retval) fprintf(stderr, "<IGNORED>\n");
-  else fprintf(stderr, "{bytes=%d, cancelled=%d, source=%d, tag=%d, error=%d}\n",
-	       retval->bytes, retval->cancelled, retval->source, retval->tag, retval->error);
-  */
   return retval;
 }
 
-static regex_t *statuses_re = NULL;
-static regmatch_t *statuses_match = NULL;
-static const char *statuses_line =
-  "MPI_Status ([A-Za-z][A-Za-z0-9_]*)\\[([0-9]+)\\]=(\\[(.*)\\]|<IGNORED>)";
-static inline void init_statuses_re() {
-  if(! statuses_re) {
-    assert((statuses_re = (regex_t*)calloc(1, sizeof(regex_t))) != NULL);
-    assert((statuses_match = (regmatch_t*)calloc(8, sizeof(regmatch_t))) != NULL);
-    assert(regcomp(statuses_re, statuses_line, REG_EXTENDED) == 0);    
-  }
-}
-
+/* MPI_Status ([A-Za-z][A-Za-z0-9_]*)\[([0-9]+)\]=(\[(.*)\]|<IGNORED>) */
 dumpi_status* read_statuses(int *arrlen, const char *name, fwrapper *wrapper) {
-  int i, ignored;
-  char *buf;
-  char scratch[256];
-  dumpi_status *retval = NULL;
+  int i;
+  const char *buf, *iname, *ilen, *p;
+  size_t namelen;
+  dumpi_status status, *retval = NULL;
   buf = wrap_getline(wrapper);
-  init_status_re();
-  init_statuses_re();
-  if(regexec(statuses_re, buf, 8, statuses_match, 0) != 0) {
-    fprintf(stderr, "read_statuses: Failed matching \"%s\" to pattern \"%s\" "
-	    "at %s:%ld.\n",
-            buf, statuses_line, wrapper->fname, wrapper->lineno);
-    if(regexec(status_re, buf, 0, NULL, 0) != 0) {
+  iname = SKIP_LIT(buf, "MPI_Status ");
+  p = iname;
+  if(p && isalpha((unsigned char)*p))
+    while(*p == '_' || isalnum((unsigned char)*p)) ++p;
+  namelen = (p ? p - iname : 0);
+  ilen = (namelen > 0 && *p == '[') ? p + 1 : NULL;
+  p = skip_digits(ilen);
+  p = SKIP_LIT(SKIP_LIT(p, "]"), "=");
+  if(! (p && (strncmp(p, "<IGNORED>", 9) == 0 ||
+              (p[0] == '[' && strchr(p, ']'))))) {
+    fprintf(stderr, "read_statuses: Failed to parse \"%s\" as a status "
+            "array at %s:%ld.\n", buf, wrapper->fname, wrapper->lineno);
+    if(find_status(buf, &status) < 0) {
       abort();
     }
     else {
@@ -1061,104 +1369,82 @@ dumpi_status* read_statuses(int *arrlen, const char *name, fwrapper *wrapper) {
       return NULL;
     }
   }
-  /*
-  for(i = 0; i < 8; ++i) {
-    copymatch(scratch, buf, statuses_match+i);
-    fprintf(stderr, "read_statuses: Match %d is \"%s\"\n", i, scratch);
-  }
-  */
-  copymatch(scratch, buf, statuses_match+1);
-  if(strcmp(scratch, name) != 0) {
+  if(! tok_eq(iname, namelen, name)) {
     fprintf(stderr, "read_statuses: Expected variable named \"%s\" but found "
-	    "\"%s\" at %s:%ld\n", name, scratch, wrapper->fname, wrapper->lineno);
-    abort();
-  }
-  copymatch(scratch, buf, statuses_match+2);
-  *arrlen = to_int(scratch, "read_statuses", wrapper);
-  if(*arrlen < 0) {
-    fprintf(stderr, "read_statuses:  Invalid (negative) array length at "
-	    "%s:%ld\n", wrapper->fname, wrapper->lineno);
+	    "\"%.*s\" at %s:%ld\n", name, (int)namelen, iname,
+            wrapper->fname, wrapper->lineno);
     abort();
   }
-  ignored = (strncmp(buf+statuses_match[3].rm_so, "<IGNORED>", 
-                     statuses_match[3].rm_eo - statuses_match[3].rm_so)
-             == 0);
-  if((*arrlen > 0) && (! ignored)) {
-    /* Store a pointer to the start of the actual array */
-    char *basepos = buf + statuses_match[4].rm_so;
+  *arrlen = tok_int(ilen, strspn(ilen, "0123456789"), "read_statuses",
+                    wrapper);
+  if((*arrlen > 0) && (*p == '[')) {
     assert((retval = (dumpi_status*)calloc(*arrlen, sizeof(dumpi_status))) != NULL);
     for(i = 0; i < *arrlen; ++i) {
-      if(regexec(status_re, basepos, 8, status_match, 0) != 0) {
+      if((p = strchr(p, '{')) == NULL ||
+         (p = scan_status(p, &retval[i])) == NULL) {
 	fprintf(stderr, "read_statuses:  Failed to extract status output at "
 		"%s:%ld\n", wrapper->fname, wrapper->lineno);
 	abort();
       }
-      /* Reset base pointer to be unmatched part of regex */
-      copymatch(scratch, basepos, status_match+2);
-      retval[i].bytes = to_int(scratch, "read_statuses", wrapper);
-      copymatch(scratch, basepos, status_match+3);
-      retval[i].cancelled = to_int(scratch, "read_statuses", wrapper);
-      copymatch(scratch, basepos, status_match+4);
-      retval[i].source = to_int(scratch, "read_statuses", wrapper);
-      copymatch(scratch, basepos, status_match+5);
-      retval[i].tag = to_int(scratch, "read_statuses", wrapper);
-      copymatch(scratch, basepos, status_match+6);
-      retval[i].error = to_int(scratch, "read_statuses", wrapper);
-      basepos = basepos + status_match[6].rm_eo;
-      /*
-      fprintf(stderr, "Status entry %d is {bytes=%d, cancelled=%d, source=%d, tag=%d, error=%d}\n",
-	      i, retval[i].bytes, retval[i].cancelled, retval[i].source, retval[i].tag, retval[i].error);
-      */
     }
   }
   return retval;
 }
 
+/* string NAME="value" (or string NAME=value) */
 static char* read_string(const char *type, const char *name, fwrapper *wrapper)
 {
-  char *itype, *iname, *ivalue;
-  char *buf = wrap_getline(wrapper);
-  itype = strtok(buf, " ");
-  iname = strtok(buf, " =\"");
-  ivalue = strtok(buf, "\"");
-  if((! itype) || (strcmp(itype, type) != 0)) {
+  const char *buf, *itype, *iname, *ivalue;
+  size_t typelen, namelen, valuelen;
+  buf = wrap_getline(wrapper);
+  itype = next_tok(&buf, " ", &typelen);
+  iname = next_tok(&buf, "=", &namelen);
+  if(! tok_eq(itype, typelen, type)) {
     fprintf(stderr, "read_string: Invalid type declaration: Expected \"%s\" "
-            "but received \"%s\" at %s:%ld\n", type, itype,
+            "but received \"%.*s\" at %s:%ld\n", type,
+            (int)(itype ? typelen : 0), itype,
             wrapper->fname, wrapper->lineno);
     abort();
   }
-  if((! iname) || (strcmp(iname, name) != 0)) {
+  if(! tok_eq(iname, namelen, name)) {
     fprintf(stderr, "read_string: Invalid variable name: Expected \"%s\" "
-            "but received \"%s\" at %s:%ld\n", name, iname,
+            "but received \"%.*s\" at %s:%ld\n", name,
+            (int)(iname ? namelen : 0), iname,
             wrapper->fname, wrapper->lineno);
     abort();
   }
-  if(! ivalue) {
+  ivalue = buf;
+  valuelen = strlen(ivalue);
+  if(valuelen >= 2 && ivalue[0] == '"' && ivalue[valuelen-1] == '"') {
+    ++ivalue;
+    valuelen -= 2;
+  }
+  if(valuelen == 0 && iname[namelen] != '=') {
     fprintf(stderr, "read_string: Invalid null value at %s:%ld\n",
             wrapper->fname, wrapper->lineno);
     abort();
   }
-  return strdup(ivalue);
+  return strndup(ivalue, valuelen);
 }
 
 static char** read_stringarr(int *arrlen, const char *type, const char *name, fwrapper *wrapper) {
   int i;
-  char *buf, *itype, *iname, *iarr;
+  char *buf, *itype, *iname, *iarr, *sav;
   char **retval = NULL;
   buf = wrap_getline(wrapper);
-  itype = strtok(buf, " ");
+  itype = strtok_r(buf, " ", &sav);
   if(strcmp(itype, type) != 0) {
     fprintf(stderr, "read_stringarr: Expected type label \"%s\" but got \"%s\" "
 	    "at %s:%ld\n", type, itype, wrapper->fname, wrapper->lineno);
     abort();
   }
-  iname = strtok(NULL, " [");
+  iname = strtok_r(NULL, " [", &sav);
   if(strcmp(iname, name) != 0) {
     fprintf(stderr, "read_stringarr: Expected name label \"%s\" but got \"%s\" "
 	    "at %s:%ld\n", name, iname, wrapper->fname, wrapper->lineno);
     abort();
   }  
-  iarr = strtok(NULL, "]=[");
+  iarr = strtok_r(NULL, "]=[", &sav);
   if(iarr)
     *arrlen = to_int(iarr, "read_stringarr", wrapper);
   else {
@@ -1172,7 +1458,7 @@ static char** read_stringarr(int *arrlen, const char *type, const char *name, fw
     abort();
   }
   if(*arrlen > 0) {
-    char *tok = strtok(NULL, "]");
+    char *tok = strtok_r(NULL, "]", &sav);
     if(! tok) {
       fprintf(stderr, "read_stringarr:  Failed to find end of array at %s:%ld\n",
 	      wrapper->fname, wrapper->lineno);
@@ -1200,17 +1486,99 @@ static char** read_stringarr(int *arrlen, const char *type, const char *name, fw
       tok = end;
     }
   }
-  /*
-  fprintf(stderr, "read_stringarr:  Returning array of length %d: [", *arrlen);
-  if(*arrlen > 0) {
-    for(i = 0; i < *arrlen; ++i)
-      fprintf(stderr, "\"%s\"%s", retval[i], ((i < *arrlen-1) ? ", " : ""));
-  }
-  fprintf(stderr, "]\n");
-  */
   return retval;
 }
 
+/*
+ * Parse the time stamps off an entry or exit line:
+ * MPI_.* (entering|returning) at walltime [0-9]+\.[0-9]+, cputime [0-9]+\.[0-9]+ seconds in thread [0-9]+
+ */
+static int parse_time_line(const char *mpicall, const char *what,
+                           dumpi_clock *wall, dumpi_clock *cpu,
+                           fwrapper *wrap)
+{
+  int i;
+  size_t len[6], skip;
+  const char *tok[6];
+  const char *buf = wrap_getline(wrap);
+  tok[0] = next_tok(&buf, " ", &len[0]);             /* MPI_.* */
+  for(i = 0; i < 3; ++i) next_tok(&buf, " ", &skip);  /* entering at walltime */
+  tok[1] = next_tok(&buf, ".", &len[1]);             /* xxx */
+  tok[2] = next_tok(&buf, ", ", &len[2]);            /* yyy */
+  next_tok(&buf, " ", &skip);                         /* cputime */
+  tok[3] = next_tok(&buf, ".", &len[3]);             /* xxx */
+  tok[4] = next_tok(&buf, ", ", &len[4]);            /* yyy */
+  for(i = 0; i < 3; ++i) next_tok(&buf, " ", &skip);  /* seconds in thread */
+  tok[5] = next_tok(&buf, ". ", &len[5]);            /* ttt */
+  for(i = 0; i < 6; ++i) {
+    if(! tok[i]) {
+      fprintf(stderr, "report_%s Failed reading %s line at %s:%ld\n",
+              mpicall, what, wrap->fname, wrap->lineno);
+      abort();
+    }
+  }
+  if(! tok_eq(tok[0], len[0], mpicall)) {
+    fprintf(stderr, "report_%s: Incorrect MPI function name %.*s at "
+            "%s:%ld\n", mpicall, (int)len[0], tok[0],
+            wrap->fname, wrap->lineno);
+    abort();
+  }
+  wall->sec = tok_int(tok[1], len[1], mpicall, wrap);
+  wall->nsec = tok_int(tok[2], len[2], mpicall, wrap);
+  cpu->sec = tok_int(tok[3], len[3], mpicall, wrap);
+  cpu->nsec = tok_int(tok[4], len[4], mpicall, wrap);
+  return tok_int(tok[5], len[5], mpicall, wrap);
+}
+
+/*
+ * Parse an optional "Perfcounters: [tag=value, ...]" line following an
+ * entry or exit line.  On entry the tags are recorded; on exit they are
+ * checked against the ones recorded on entry.
+ */
+static void parse_perf_line(const char *mpicall, dumpi_perfinfo *perf,
+                            int64_t *value, int entering, fwrapper *wrap)
+{
+  int counterid = 0;
+  size_t len;
+  const char *ctrs, *end, *tok;
+  const char *buf = wrap_getline(wrap);
+  if(! buf)
+    return;
+  if(strncmp(buf, "Perfcounters:", 12) != 0) {
+    wrap_ungetline(wrap);
+    return;
+  }
+  ctrs = strchr(buf, '[');
+  end = (ctrs ? strchr(ctrs, ']') : NULL);
+  if(! (ctrs && end)) {
+    fprintf(stderr, "Invalid perfcounter line \"%s\" at %s:%ld\n",
+            buf, wrap->fname, wrap->lineno);
+    abort();
+  }
+  ++ctrs;
+  while(ctrs < end && (tok = next_tok(&ctrs, ", ]", &len)) != NULL &&
+        tok < end) {
+    const char *val = memchr(tok, '=', len);
+    size_t keylen = (val ? (size_t)(val - tok) : len);
+    if(! val || counterid >= DUMPI_MAX_PERFCTRS) {
+      fprintf(stderr, "Invalid perfcounter entry at %s:%ld\n",
+              wrap->fname, wrap->lineno);
+      abort();
+    }
+    ++val;
+    if(entering) {
+      if(keylen >= DUMPI_MAX_PERFCTR_NAME) keylen = DUMPI_MAX_PERFCTR_NAME-1;
+      memcpy(perf->counter_tag[counterid], tok, keylen);
+      perf->counter_tag[counterid][keylen] = '\0';
+    }
+    else {
+      assert(strncmp(perf->counter_tag[counterid], tok, keylen) == 0);
+    }
+    value[counterid] = tok_int(val, len - (val - tok), mpicall, wrap);
+    ++counterid;
+  }
+}
+
 /* The actual (messy) MPI function mappings start here */
 /* MPI_.* (entering|returning) at walltime [0-9]+\.[0-9]+, cputime [0-9]+\.[0-9]+ seconds in thread [0-9]+ */
 #define DUMPI_ENTERING(MPICALL, PRM, THREAD, CPU, WALL, PERF, OPTS)     \
@@ -1220,40 +1588,11 @@ static uint16_t dumpi_entering(const char *mpicall, dumpi_time *cpu,
                                dumpi_time *wall, dumpi_perfinfo *perf,
                                fwrapper *wrap, settings *opts)
 {
-  int i;
-  char *buf, *iname, *iwall_sec, *iwall_nsec, *icpu_sec, *icpu_nsec, *ithread;
-  int thread;
-  buf = wrap_getline(wrap);
-  iname = strtok(buf, " ");                  /* MPI_.* */
-  for(i = 0; i < 3; ++i) strtok(NULL, " ");  /* entering at walltime */
-  iwall_sec = strtok(NULL, ".");             /* xxx */
-  iwall_nsec = strtok(NULL, ", ");           /* yyy */
-  strtok(NULL, " ");                         /* cputime */
-  icpu_sec = strtok(NULL, ".");              /* xxx */
-  icpu_nsec = strtok(NULL, ", ");            /* yyy */
-  for(i = 0; i < 3; ++i) strtok(NULL, " ");  /* seconds in thread */
-  ithread = strtok(NULL, ". ");              /* ttt */
-  if(! (iname && iwall_sec && iwall_nsec && icpu_sec && icpu_nsec && ithread)) {
-    fprintf(stderr, "iname=%s, iwall_sec=%s, iwall_nsec=%s, icpu_sec=%s, "
-            "icpu_nsec=%s, ithread=%s\n", iname, iwall_sec, iwall_nsec,
-            icpu_sec, icpu_nsec, ithread);
-    fprintf(stderr, "report_%s Failed reading entry line at %s:%ld\n",
-            mpicall, wrap->fname, wrap->lineno);
-    abort();
-  }
-  if(strcmp(iname, mpicall) != 0) {
-    fprintf(stderr, "report_%s: Incorrect MPI function name %s at "
-            "%s:%ld\n", mpicall, iname, wrap->fname, wrap->lineno);
-    abort();
-  }
-  wall->start.sec = to_int(iwall_sec, mpicall, wrap);
-  wall->start.nsec = to_int(iwall_nsec, mpicall, wrap);
-  cpu->start.sec = to_int(icpu_sec, mpicall, wrap);
-  cpu->start.nsec = to_int(icpu_nsec, mpicall, wrap);
-  thread = to_int(ithread, mpicall, wrap);
+  int thread = parse_time_line(mpicall, "entry", &wall->start, &cpu->start,
+                               wrap);
   if(thread < 0) {
-    fprintf(stderr, "report_%s:  Invalid thread id %s at %s:%ld\n",
-            mpicall, ithread, wrap->fname, wrap->lineno);
+    fprintf(stderr, "report_%s:  Invalid thread id %d at %s:%ld\n",
+            mpicall, thread, wrap->fname, wrap->lineno);
     abort();
   }
   /* If we get here, we have enough info to set up the profile. */
@@ -1267,38 +1606,7 @@ static uint16_t dumpi_entering(const char *mpicall, dumpi_time *cpu,
     }
   }
   /* Now check whether we have any performance counters. */
-  buf = wrap_getline(wrap);
-  if(strncmp(buf, "Perfcounters:", 12) == 0) {
-    /* yes */
-    int counterid = 0;
-    char *ctrs, *tmp;
-    ctrs = strchr(buf, '[');
-    tmp = strchr(ctrs, ']');
-    if(! (ctrs && tmp)) {
-      fprintf(stderr, "Invalid perfcounter line \"%s\" at %s:%ld\n",
-              buf, wrap->fname, wrap->lineno);
-      abort();
-    }
-    ++ctrs;
-    tmp = strchr(ctrs, ']');
-    *tmp = '\0';
-    for(tmp = strtok(ctrs, ", "); tmp; tmp = strtok(NULL, ", ")) {
-      char *key, *val; 
-      key = strtok(tmp, "= ");
-      val = strtok(NULL, "= ");
-      if(! (key && val)) {
-        fprintf(stderr, "Invalid perfcounter entry at %s:%ld\n",
-                wrap->fname, wrap->lineno);
-        abort();
-      }
-      strncpy(perf->counter_tag[counterid], key, DUMPI_MAX_PERFCTR_NAME-1);
-      perf->invalue[counterid] = to_int(val, mpicall, wrap);
-      ++counterid;      
-    }
-  }
-  else {
-    wrap_ungetline(wrap);
-  }
+  parse_perf_line(mpicall, perf, perf->invalue, 1, wrap);
   return thread;
 }
   
@@ -1312,78 +1620,16 @@ static uint16_t dumpi_returning(const char *mpicall, uint16_t enter_thread,
                                 dumpi_perfinfo *perf, fwrapper *wrap,
                                 settings *opts)
 {
-  int i;
-  char *buf, *iname, *iwall_sec, *iwall_nsec, *icpu_sec, *icpu_nsec, *ithread;
   int thread;
   (void)opts;
-  buf = wrap_getline(wrap);
-  iname = strtok(buf, " ");                  /* MPI_.* */
-  for(i = 0; i < 3; ++i) strtok(NULL, " ");  /* returning at walltime */
-  iwall_sec = strtok(NULL, ".");             /* xxx */
-  iwall_nsec = strtok(NULL, ", ");           /* yyy */
-  strtok(NULL, " ");                         /* cputime */
-  icpu_sec = strtok(NULL, ".");              /* xxx */
-  icpu_nsec = strtok(NULL, ", ");            /* yyy */
-  for(i = 0; i < 3; ++i) strtok(NULL, " ");  /* seconds in thread */
-  ithread = strtok(NULL, ". ");              /* ttt */
-  if(! (iname && iwall_sec && iwall_nsec && icpu_sec && icpu_nsec && ithread)) {
-    fprintf(stderr, "report_%s Failed reading exit line at %s:%ld\n",
-            mpicall, wrap->fname, wrap->lineno);
-    abort();
-  }
-  if(strcmp(iname, mpicall) != 0) {
-    fprintf(stderr, "report_%s: Incorrect MPI function name %s at "
-            "%s:%ld\n", mpicall, iname, wrap->fname, wrap->lineno);
-    abort();
-  }
-  wall->stop.sec = to_int(iwall_sec, mpicall, wrap);
-  wall->stop.nsec = to_int(iwall_nsec, mpicall, wrap);
-  cpu->stop.sec = to_int(icpu_sec, mpicall, wrap);
-  cpu->stop.nsec = to_int(icpu_nsec, mpicall, wrap);
-  thread = to_int(ithread, mpicall, wrap);
+  thread = parse_time_line(mpicall, "exit", &wall->stop, &cpu->stop, wrap);
   if(thread != (int)enter_thread) {
     fprintf(stderr, "report_%s:  Changed thread id from %d to %d at %s:%ld\n",
             mpicall, enter_thread, thread, wrap->fname, wrap->lineno);
     abort();
   }
   /* Now check whether we have any performance counters. */
-  buf = wrap_getline(wrap);
-  if(buf) {
-    if(strncmp(buf, "Perfcounters:", 12) == 0) {
-      /* yes */
-      int counterid = 0;
-      char *ctrs, *tmp;
-      ctrs = strchr(buf, '[');
-      tmp = strchr(ctrs, ']');
-      if(! (ctrs && tmp)) {
-        fprintf(stderr, "Invalid perfcounter line \"%s\" at %s:%ld\n",
-                buf, wrap->fname, wrap->lineno);
-        abort();
-      }
-      ++ctrs;
-      tmp = strchr(ctrs, ']');
-      *tmp = '\0';
-      for(tmp = strtok(ctrs, ", "); tmp; tmp = strtok(NULL, ", ")) {
-        char *key, *val; 
-        key = strtok(tmp, "= ");
-        val = strtok(NULL, "= ");
-        if(! (key && val)) {
-          fprintf(stderr, "Invalid perfcounter entry at %s:%ld\n",
-                  wrap->fname, wrap->lineno);
-          abort();
-        }
-        assert(strcmp(perf->counter_tag[counterid], key) == 0);
-        perf->outvalue[counterid] = to_int(val, mpicall, wrap);
-        ++counterid;      
-      }
-    }
-    else {
-      wrap_ungetline(wrap);
-    }
-  }
-  else {
-    wrap_ungetline(wrap);
-  }
+  parse_perf_line(mpicall, perf, perf->outvalue, 0, wrap);
   return thread;
 }
 
@@ -4548,58 +4794,248 @@ static funmap handlers[] = {
   {NULL, NULL}
 };
 
-static int handler_count = 0;
-
-static int funcomp(const void *a, const void *b) {
-  const funmap *left = (funmap*)a;
-  const funmap *right = (funmap*)b;
-  return strcmp(left->label, right->label);
+/*
+ * Perfect hash over dumpi_function_names (hash and displace): each name
+ * hashes to one of PH_BUCKETS buckets, and every bucket carries a
+ * displacement chosen so that its names land in distinct slots.
+ * A lookup is one hash, two table reads and one string compare.
+ */
+#define PH_BUCKETS 128
+#define PH_SLOTS   1024
+
+static uint32_t ph_disp[PH_BUCKETS];
+static int16_t ph_slot[PH_SLOTS];
+static mpihandler funchandler[DUMPI_END_OF_STREAM];
+
+static inline uint32_t ph_hash(const char *str, size_t len) {
+  uint32_t hash = 2166136261u;
+  size_t i;
+  for(i = 0; i < len; ++i)
+    hash = (hash ^ (unsigned char)str[i]) * 16777619u;
+  return hash;
+}
+
+static inline int ph_index(uint32_t hash, uint32_t disp) {
+  return (int)(((hash ^ disp) * 2654435761u) >> 22); /* top 10 bits */
+}
+
+static int find_function(const char *name, size_t len) {
+  uint32_t hash = ph_hash(name, len);
+  int idx = ph_slot[ph_index(hash, ph_disp[hash % PH_BUCKETS])];
+  if(idx >= 0 && strncmp(dumpi_function_names[idx], name, len) == 0 &&
+     dumpi_function_names[idx][len] == '\0')
+    return idx;
+  return -1;
+}
+
+static void init_funchash(void) {
+  int i, b, *bucket[PH_BUCKETS];
+  int fill[PH_BUCKETS] = {0}, order[PH_BUCKETS];
+  uint32_t hash[DUMPI_END_OF_STREAM];
+  for(i = 0; i < PH_SLOTS; ++i) ph_slot[i] = -1;
+  for(b = 0; b < PH_BUCKETS; ++b)
+    assert((bucket[b] = (int*)calloc(DUMPI_END_OF_STREAM, sizeof(int))) != NULL);
+  for(i = 0; i < DUMPI_END_OF_STREAM; ++i) {
+    const char *name = dumpi_function_names[i];
+    hash[i] = ph_hash(name, strlen(name));
+    b = hash[i] % PH_BUCKETS;
+    bucket[b][fill[b]++] = i;
+  }
+  /* Place the fullest buckets first */
+  for(b = 0; b < PH_BUCKETS; ++b) {
+    int j = b;
+    while(j > 0 && fill[order[j-1]] < fill[b]) {
+      order[j] = order[j-1];
+      --j;
+    }
+    order[j] = b;
+  }
+  for(b = 0; b < PH_BUCKETS && fill[order[b]] > 0; ++b) {
+    int k, *ent = bucket[order[b]], count = fill[order[b]];
+    uint32_t disp;
+    for(disp = 0; ; ++disp) {
+      for(k = 0; k < count; ++k) {
+        int j, slot = ph_index(hash[ent[k]], disp);
+        if(ph_slot[slot] >= 0) break;
+        for(j = 0; j < k; ++j)
+          if(ph_index(hash[ent[j]], disp) == slot) break;
+        if(j < k) break;
+      }
+      if(k == count) break;
+    }
+    ph_disp[order[b]] = disp;
+    for(k = 0; k < count; ++k)
+      ph_slot[ph_index(hash[ent[k]], disp)] = ent[k];
+  }
+  for(b = 0; b < PH_BUCKETS; ++b)
+    free(bucket[b]);
+  /* Index the handlers by function id */
+  for(i = 0; handlers[i].handler; ++i) {
+    int idx = find_function(handlers[i].label, strlen(handlers[i].label));
+    assert(idx >= 0);
+    funchandler[idx] = handlers[i].handler;
+  }
 }
 
 /* Get a function corresponding to a label */
-mpihandler get_handler(const char *func, const fwrapper *wrap) {
-  int pivot, old_pivot, lower_bound, upper_bound;
-  /* mpihandler retval = NULL; */
-  if(! handler_count) {
-    for(handler_count = 0; handlers[handler_count].handler; ++handler_count)
-      { /* running the counter */ }
-    qsort(handlers, handler_count, sizeof(funmap), funcomp);
+mpihandler get_handler(const char *func, size_t len, const fwrapper *wrap) {
+  int idx = find_function(func, len);
+  if(idx < 0 || funchandler[idx] == NULL) {
+    fprintf(stderr, "get_handler:  No handler found for \"%.*s\" at %s:%ld\n",
+            (int)len, func, wrap->fname, wrap->lineno);
+    abort();
   }
-  /* Bisectional search */
-  lower_bound = 0;
-  upper_bound = handler_count;
-  pivot = upper_bound / 2;
-  old_pivot = 0;
+  return funchandler[idx];
+}
+
+/*
+ * Parallel conversion of several input files.
+ *
+ * Every stream record is written relative to the time bias taken from the
+ * first entry line of the whole input, so that bias is found up front by a
+ * quick scan.  Each file is then converted on a worker thread into a
+ * private stream in a temporary file, while its header, footer, keyval,
+ * label and datatype entries are set aside.  Finally the private streams
+ * are appended to the output in file order and the set-aside entries are
+ * replayed in input order, which yields the same trace as a sequential run.
+ */
+
+/* Find the time bias of the first stream record; 0 if there is none. */
+static int find_time_bias(convjob *jobs, int count, dumpi_clock *cpu,
+                          dumpi_clock *wall)
+{
+  int i;
+  for(i = 0; i < count; ++i) {
+    const char *buf;
+    fwrapper wrap = wrap_create(&jobs[i].in);
+    while((buf = wrap_getline(&wrap)) != NULL) {
+      lineclass kind = classify_line(buf);
+      if(kind == LINE_STREAM) {
+        const char *name = buf + strspn(buf, " ");
+        char mpicall[128];
+        size_t len = strcspn(name, " ");
+        if(len >= sizeof(mpicall)) len = sizeof(mpicall)-1;
+        memcpy(mpicall, name, len);
+        mpicall[len] = '\0';
+        wrap_ungetline(&wrap);
+        parse_time_line(mpicall, "entry", wall, cpu, &wrap);
+        free(wrap.buff);
+        return 1;
+      }
+      if(kind == LINE_KEYVAL || kind == LINE_PERFCTR) {
+        long lines = strtol(strchr(buf, ':') + 1, NULL, 10);
+        while(lines-- > 0 && wrap_getline(&wrap)) { }
+      }
+    }
+    free(wrap.buff);
+  }
+  return 0;
+}
+
+static void* convert_worker(void *arg) {
+  convpool *pool = (convpool*)arg;
   while(1) {
-    int cmp = strcmp(func, handlers[pivot].label);
-    if(cmp == 0)
-      break;
-    if(cmp < 0)
-      upper_bound = pivot;
-    if(cmp > 0)
-      lower_bound = pivot;
-    pivot = lower_bound + (upper_bound - lower_bound)/2;
-    if(pivot == old_pivot) {
-      fprintf(stderr, "get_handler:  No handler found for \"%s\" at %s:%ld\n",
-              func, wrap->fname, wrap->lineno);
+    convjob *job;
+    pthread_mutex_lock(&pool->lock);
+    job = (pool->next < pool->count ? &pool->jobs[pool->next++] : NULL);
+    pthread_mutex_unlock(&pool->lock);
+    if(! job) break;
+    parse_infile(&job->wrap, &job->opts);
+    if(job->opts.profile) DUMPI_FLUSH(job->opts.profile);
+  }
+  return NULL;
+}
+
+/* Copy the records of a private stream to the end of the output. */
+static void append_stream(dumpi_profile *dst, dumpi_profile *src, off_t body) {
+  char buf[65536];
+  size_t len;
+  DUMPI_FLUSH(dst);
+  assert(fseeko(src->file, body, SEEK_SET) == 0);
+  while((len = fread(buf, 1, sizeof(buf), src->file)) > 0)
+    assert(fwrite(buf, 1, len, dst->file) == len);
+  fclose(src->file);
+  src->file = NULL;
+  dumpi_free_output_profile(src);
+}
+
+int convert_parallel(settings *opts) {
+  int i, j, nthreads, have_bias;
+  dumpi_clock cpu, wall;
+  convpool pool;
+  pthread_t *threads;
+  assert((pool.jobs = (convjob*)calloc(opts->infiles, sizeof(convjob))) != NULL);
+  pool.count = opts->infiles;
+  pool.next = 0;
+  for(i = 0; i < opts->infiles; ++i) {
+    if(! infile_open(&pool.jobs[i].in, opts->in[i])) {
+      fprintf(stderr, "Failed to open \"%s\" for reading:  %s\n",
+              opts->in[i], strerror(errno));
+      return 3;
+    }
+    if(pool.jobs[i].in.fp) {
+      /* Not a regular file; set-aside entries need the whole input mapped */
+      for(j = 0; j <= i; ++j) infile_close(&pool.jobs[j].in);
+      free(pool.jobs);
+      return -1;
+    }
+  }
+  have_bias = find_time_bias(pool.jobs, pool.count, &cpu, &wall);
+  if(have_bias) {
+    assert((opts->profile =
+            dumpi_alloc_output_profile(cpu.sec, wall.sec, 4096)) != NULL);
+    if((opts->profile->file = dumpi_open_output_file(opts->out)) == NULL) {
+      fprintf(stderr, "Failed to create output file %s: %s\n",
+              opts->out, strerror(errno));
       abort();
     }
-    old_pivot = pivot;
   }
-  return handlers[pivot].handler;
-
-  /*
-  for(i = 0; handlers[i].handler; ++i) {
-    if(strcmp(func, handlers[i].label) == 0) {
-      retval = handlers[i].handler;
-      break;
+  for(i = 0; i < pool.count; ++i) {
+    convjob *job = &pool.jobs[i];
+    if(opts->verbose) fprintf(stderr, "Processing infile %s\n", opts->in[i]);
+    job->opts = *opts;
+    job->opts.profile = NULL;
+    if(have_bias) {
+      assert((job->opts.profile =
+              dumpi_alloc_output_profile(cpu.sec, wall.sec, 1<<20)) != NULL);
+      if((job->opts.profile->file = tmpfile()) == NULL) {
+        fprintf(stderr, "Failed to create temporary file: %s\n",
+                strerror(errno));
+        abort();
+      }
+      job->body = DUMPI_WRITE_TELL(job->opts.profile);
     }
+    job->wrap = wrap_create(&job->in);
+    job->wrap.defer = 1;
   }
-  if(! retval) {
-    fprintf(stderr, "get_handler:  No handler defined for the label %s "
-            "at %s:%ld\n", func, wrap->fname, wrap->lineno);
-    abort();
+  nthreads = (opts->threads < pool.count ? opts->threads : pool.count);
+  assert((threads = (pthread_t*)calloc(nthreads, sizeof(pthread_t))) != NULL);
+  pthread_mutex_init(&pool.lock, NULL);
+  for(i = 0; i < nthreads; ++i)
+    assert(pthread_create(&threads[i], NULL, convert_worker, &pool) == 0);
+  for(i = 0; i < nthreads; ++i)
+    pthread_join(threads[i], NULL);
+  pthread_mutex_destroy(&pool.lock);
+  free(threads);
+  for(i = 0; i < pool.count; ++i) {
+    convjob *job = &pool.jobs[i];
+    if(job->opts.profile)
+      append_stream(opts->profile, job->opts.profile, job->body);
+    for(j = 0; j < job->wrap.nspans; ++j) {
+      const linespan *span = &job->wrap.spans[j];
+      fwrapper replay;
+      memset(&replay, 0, sizeof(fwrapper));
+      replay.pos = span->start;
+      replay.end = span->start + span->len;
+      replay.fname = job->in.fname;
+      replay.lineno = span->lineno - 1;
+      parse_infile(&replay, opts);
+      free(replay.buff);
+    }
+    free(job->wrap.spans);
+    free(job->wrap.buff);
+    infile_close(&job->in);
   }
-  return retval;
-  */
+  free(pool.jobs);
+  return 0;
 }
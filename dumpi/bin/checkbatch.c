@@ -0,0 +1,266 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/libundumpi/libundumpi.h>
+#include <dumpi/libundumpi/batch.h>
+#include <dumpi/common/funcs.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/*
+ * Check batched reading against the plain stream reader (run by make
+ * check).
+ *
+ *   checkbatch trace.bin ...
+ *
+ * Each trace is read once with undumpi_read_stream.  undumpi_next_batch
+ * must then give the same calls in the same order, in batches of varying
+ * size, with the times and threads the callbacks saw and the peer, tag
+ * and communicator of every Send, Recv, Isend and Irecv.  Decoding each
+ * call of a batch with undumpi_batch_decode must reach a callback with
+ * the same times, and the function column must add up to the call counts
+ * in the footer (unless the trace has no calls at all, as in profile
+ * mode).
+ */
+
+#define CHECKBATCH_CAPACITY 7
+
+typedef struct callrec {
+  int function;          /* only set for the four point-to-point calls */
+  int32_t peer, tag, comm;
+  uint16_t thread;
+  int64_t cpu_start, cpu_stop, wall_start, wall_stop;
+} callrec;
+
+typedef struct callseq {
+  callrec *call;
+  int calls, maxcalls;
+  /* the call undumpi_batch_decode is expected to reach, and how often
+     a callback was reached */
+  const callrec *expect;
+  int reached, failed;
+} callseq;
+
+static inline int64_t to_nsec(const dumpi_clock *clock) {
+  return (int64_t)clock->sec * 1000000000 + clock->nsec;
+}
+
+static callrec* add_call(callseq *seq, uint16_t thread, const dumpi_time *cpu,
+			 const dumpi_time *wall)
+{
+  callrec *rec;
+  if(seq->calls == seq->maxcalls) {
+    seq->maxcalls = (seq->maxcalls ? 2*seq->maxcalls : 1024);
+    assert((seq->call = (callrec*)realloc(seq->call, seq->maxcalls *
+					  sizeof(callrec))) != NULL);
+  }
+  rec = &seq->call[seq->calls++];
+  rec->function = -1;
+  rec->peer = rec->tag = rec->comm = UNDUMPI_BATCH_NONE;
+  rec->thread = thread;
+  rec->cpu_start = to_nsec(&cpu->start);
+  rec->cpu_stop = to_nsec(&cpu->stop);
+  rec->wall_start = to_nsec(&wall->start);
+  rec->wall_stop = to_nsec(&wall->stop);
+  return rec;
+}
+
+static int any_call(const void *prm, uint16_t thread, const dumpi_time *cpu,
+		    const dumpi_time *wall, const dumpi_perfinfo *perf,
+		    void *userarg)
+{
+  (void)prm;
+  (void)perf;
+  add_call((callseq*)userarg, thread, cpu, wall);
+  return 1;
+}
+
+#define CHECKBATCH_P2P(NAME, FUNC, PEER)				\
+  static int NAME##_call(const dumpi_##NAME *prm, uint16_t thread,	\
+			 const dumpi_time *cpu, const dumpi_time *wall,	\
+			 const dumpi_perfinfo *perf, void *userarg)	\
+  {									\
+    callrec *rec = add_call((callseq*)userarg, thread, cpu, wall);	\
+    (void)perf;								\
+    rec->function = FUNC;						\
+    rec->peer = prm->PEER;						\
+    rec->tag = prm->tag;						\
+    rec->comm = prm->comm;						\
+    return 1;								\
+  }
+
+CHECKBATCH_P2P(send, DUMPI_Send, dest)
+CHECKBATCH_P2P(recv, DUMPI_Recv, source)
+CHECKBATCH_P2P(isend, DUMPI_Isend, dest)
+CHECKBATCH_P2P(irecv, DUMPI_Irecv, source)
+
+/* Reached through undumpi_batch_decode */
+static int decoded_call(const void *prm, uint16_t thread,
+			const dumpi_time *cpu, const dumpi_time *wall,
+			const dumpi_perfinfo *perf, void *userarg)
+{
+  callseq *seq = (callseq*)userarg;
+  const callrec *rec = seq->expect;
+  (void)prm;
+  (void)perf;
+  ++seq->reached;
+  if(rec->thread != thread ||
+     rec->cpu_start != to_nsec(&cpu->start) ||
+     rec->cpu_stop != to_nsec(&cpu->stop) ||
+     rec->wall_start != to_nsec(&wall->start) ||
+     rec->wall_stop != to_nsec(&wall->stop))
+    seq->failed = 1;
+  return 1;
+}
+
+static int same_call(const callrec *rec, const undumpi_batch *batch, int i) {
+  if(rec->thread != batch->thread[i] ||
+     rec->cpu_start != batch->cpu_start[i] ||
+     rec->cpu_stop != batch->cpu_stop[i] ||
+     rec->wall_start != batch->wall_start[i] ||
+     rec->wall_stop != batch->wall_stop[i])
+    return 0;
+  if(rec->function >= 0 &&
+     (rec->function != batch->function[i] || rec->peer != batch->peer[i] ||
+      rec->tag != batch->tag[i] || rec->comm != batch->comm[i]))
+    return 0;
+  return 1;
+}
+
+static int check_trace(const char *fname) {
+  libundumpi_callbacks cback;
+  callseq seq;
+  undumpi_batch *batch;
+  dumpi_profile *profile;
+  dumpi_footer *footer;
+  uint32_t counted[DUMPI_ALL_FUNCTIONS+1];
+  int64_t last_offset = -1;
+  int pos = 0, batches = 0, count, i, status = 1;
+
+  memset(&seq, 0, sizeof(seq));
+  if((profile = undumpi_open(fname)) == NULL) {
+    fprintf(stderr, "Failed to open %s\n", fname);
+    return 0;
+  }
+  libundumpi_set_callbacks(&cback, any_call);
+  cback.on_send = send_call;
+  cback.on_recv = recv_call;
+  cback.on_isend = isend_call;
+  cback.on_irecv = irecv_call;
+  undumpi_read_stream(profile, &cback, &seq, false);
+  undumpi_close(profile);
+  free(profile);
+
+  if((profile = undumpi_open(fname)) == NULL) {
+    fprintf(stderr, "Failed to reopen %s\n", fname);
+    free(seq.call);
+    return 0;
+  }
+  libundumpi_set_callbacks(&cback, decoded_call);
+  memset(counted, 0, sizeof(counted));
+  batch = undumpi_batch_alloc(CHECKBATCH_CAPACITY);
+  /* Batch sizes cycle through 1 .. CHECKBATCH_CAPACITY */
+  while(status &&
+	(count = undumpi_next_batch(profile, batch,
+				    1 + batches++ % CHECKBATCH_CAPACITY)) > 0) {
+    for(i = 0; i < count && status; ++i, ++pos) {
+      if(pos >= seq.calls || ! same_call(&seq.call[pos], batch, i) ||
+	 batch->offset[i] <= last_offset ||
+	 batch->function[i] >= DUMPI_ALL_FUNCTIONS) {
+	fprintf(stderr, "%s:  call %d differs from undumpi_read_stream\n",
+		fname, pos);
+	status = 0;
+	break;
+      }
+      last_offset = batch->offset[i];
+      ++counted[batch->function[i]];
+      seq.expect = &seq.call[pos];
+      seq.reached = 0;
+      if(! undumpi_batch_decode(profile, batch, i, &cback, &seq) ||
+	 seq.reached != 1 || seq.failed) {
+	fprintf(stderr, "%s:  undumpi_batch_decode of call %d differs\n",
+		fname, pos);
+	status = 0;
+      }
+    }
+  }
+  if(status && pos != seq.calls) {
+    fprintf(stderr, "%s:  %d batched calls, %d streamed\n", fname, pos,
+	    seq.calls);
+    status = 0;
+  }
+  /* Profile-mode traces count their calls but do not write them */
+  if(status && pos > 0 && (footer = undumpi_read_footer(profile)) != NULL) {
+    for(i = 0; i < DUMPI_ALL_FUNCTIONS && status; ++i) {
+      if(footer->call_count[i] != counted[i]) {
+	fprintf(stderr, "%s:  %u batched calls of %s, footer has %u\n",
+		fname, counted[i], dumpi_function_names[i],
+		footer->call_count[i]);
+	status = 0;
+      }
+    }
+    dumpi_free_footer(footer);
+  }
+  if(status)
+    printf("%s:  %d calls in %d batches\n", fname, pos, batches - 1);
+  undumpi_batch_free(batch);
+  undumpi_close(profile);
+  free(profile);
+  free(seq.call);
+  return status;
+}
+
+int main(int argc, char **argv) {
+  int i, status = 1;
+  if(argc < 2) {
+    fprintf(stderr, "Usage:  %s trace.bin ...\n", argv[0]);
+    return 1;
+  }
+  for(i = 1; i < argc; ++i)
+    if(! check_trace(argv[i]))
+      status = 0;
+  return (status ? 0 : 1);
+}
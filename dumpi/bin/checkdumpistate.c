@@ -0,0 +1,380 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/libundumpi/dumpistate.h>
+#include <dumpi/libundumpi/libundumpi.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/*
+ * Check dumpistate against the plain stream reader (run by make check).
+ *
+ *   checkdumpistate metafile rank0.bin rank1.bin ...
+ *
+ * Every rank is read with dumpistate_parse_single and with
+ * undumpi_read_stream, which must agree call for call.  The merged
+ * stream from dumpistate_parse_all must contain the same calls, and
+ * each call must start no later than the next call of every other rank
+ * (measured from the end of MPI_Init on each rank).  MPI_COMM_WORLD and
+ * the communicators made by MPI_Comm_split of MPI_COMM_WORLD must have
+ * the size, rank and members the recorded colors and keys give them.
+ */
+
+typedef struct callrec {
+  dumpi_function func;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+} callrec;
+
+typedef struct splitrec {
+  int color, key;
+  dumpi_comm newcomm;
+  dumpi_clock done;
+} splitrec;
+
+typedef struct rankcalls {
+  callrec *call;
+  int calls, maxcalls;
+  splitrec *split;
+  int splits, maxsplits;
+  int has_init;
+  int64_t init_ns;
+} rankcalls;
+
+typedef struct mergecheck {
+  rankcalls *rank;
+  int *pos;
+  int procs, skewed, failed;
+} mergecheck;
+
+typedef struct streamcheck {
+  const rankcalls *rank;
+  int pos, failed;
+} streamcheck;
+
+static inline int64_t to_nsec(const dumpi_clock *clock) {
+  return (int64_t)clock->sec * 1000000000 + clock->nsec;
+}
+
+static int same_times(const callrec *rec, uint16_t thread,
+		      const dumpi_time *cpu, const dumpi_time *wall)
+{
+  return (rec->thread == thread &&
+	  to_nsec(&rec->cpu.start) == to_nsec(&cpu->start) &&
+	  to_nsec(&rec->cpu.stop) == to_nsec(&cpu->stop) &&
+	  to_nsec(&rec->wall.start) == to_nsec(&wall->start) &&
+	  to_nsec(&rec->wall.stop) == to_nsec(&wall->stop));
+}
+
+static int single_call(int node, dumpi_function func, void *prm,
+		       uint16_t thread, const dumpi_time *cpu,
+		       const dumpi_time *wall, const dumpi_perfinfo *perf,
+		       void *userarg)
+{
+  rankcalls *rc = (rankcalls*)userarg;
+  callrec *rec;
+  (void)node;
+  (void)perf;
+  if(rc->calls == rc->maxcalls) {
+    rc->maxcalls = (rc->maxcalls ? 2*rc->maxcalls : 1024);
+    assert((rc->call = (callrec*)realloc(rc->call, rc->maxcalls *
+					 sizeof(callrec))) != NULL);
+  }
+  rec = &rc->call[rc->calls++];
+  rec->func = func;
+  rec->thread = thread;
+  rec->cpu = *cpu;
+  rec->wall = *wall;
+  if((func == DUMPI_Init || func == DUMPI_Init_thread) && ! rc->has_init) {
+    rc->has_init = 1;
+    rc->init_ns = to_nsec(&wall->stop);
+  }
+  if(func == DUMPI_Comm_split &&
+     ((const dumpi_comm_split*)prm)->oldcomm == DUMPI_COMM_WORLD) {
+    const dumpi_comm_split *split = (const dumpi_comm_split*)prm;
+    splitrec *sr;
+    if(rc->splits == rc->maxsplits) {
+      rc->maxsplits = (rc->maxsplits ? 2*rc->maxsplits : 16);
+      assert((rc->split = (splitrec*)realloc(rc->split, rc->maxsplits *
+					     sizeof(splitrec))) != NULL);
+    }
+    sr = &rc->split[rc->splits++];
+    sr->color = split->color;
+    sr->key = split->key;
+    sr->newcomm = split->newcomm;
+    sr->done = wall->stop;
+  }
+  return 1;
+}
+
+static inline int64_t merge_time(const mergecheck *mc, int rank, int pos) {
+  return (to_nsec(&mc->rank[rank].call[pos].wall.start) -
+	  (mc->skewed ? mc->rank[rank].init_ns : 0));
+}
+
+static int merged_call(int node, dumpi_function func, void *prm,
+		       uint16_t thread, const dumpi_time *cpu,
+		       const dumpi_time *wall, const dumpi_perfinfo *perf,
+		       void *userarg)
+{
+  mergecheck *mc = (mergecheck*)userarg;
+  int64_t now;
+  int other;
+  (void)prm;
+  (void)perf;
+  if(node < 0 || node >= mc->procs ||
+     mc->pos[node] >= mc->rank[node].calls) {
+    fprintf(stderr, "dumpistate_parse_all:  extra call on rank %d\n", node);
+    mc->failed = 1;
+    return 0;
+  }
+  if(mc->rank[node].call[mc->pos[node]].func != func ||
+     ! same_times(&mc->rank[node].call[mc->pos[node]], thread, cpu, wall)) {
+    fprintf(stderr, "dumpistate_parse_all:  call %d of rank %d differs "
+	    "from dumpistate_parse_single\n", mc->pos[node], node);
+    mc->failed = 1;
+    return 0;
+  }
+  now = merge_time(mc, node, mc->pos[node]);
+  for(other = 0; other < mc->procs; ++other) {
+    if(other != node && mc->pos[other] < mc->rank[other].calls &&
+       merge_time(mc, other, mc->pos[other]) < now) {
+      fprintf(stderr, "dumpistate_parse_all:  call %d of rank %d came "
+	      "before the earlier call %d of rank %d\n",
+	      mc->pos[node], node, mc->pos[other], other);
+      mc->failed = 1;
+      return 0;
+    }
+  }
+  ++mc->pos[node];
+  return 1;
+}
+
+static int stream_call(const void *prm, uint16_t thread,
+		       const dumpi_time *cpu, const dumpi_time *wall,
+		       const dumpi_perfinfo *perf, void *userarg)
+{
+  streamcheck *sc = (streamcheck*)userarg;
+  (void)prm;
+  (void)perf;
+  if(sc->failed)
+    return 1;
+  if(sc->pos >= sc->rank->calls ||
+     ! same_times(&sc->rank->call[sc->pos], thread, cpu, wall))
+    sc->failed = 1;
+  else
+    ++sc->pos;
+  return 1;
+}
+
+/* Compare one trace file with the calls dumpistate_parse_single gave */
+static int check_stream(const char *fname, int rank, const rankcalls *rc) {
+  libundumpi_callbacks cback;
+  streamcheck sc = {rc, 0, 0};
+  dumpi_profile *profile;
+  if((profile = undumpi_open(fname)) == NULL) {
+    fprintf(stderr, "Failed to open %s\n", fname);
+    return 0;
+  }
+  libundumpi_set_callbacks(&cback, stream_call);
+  undumpi_read_stream(profile, &cback, &sc, false);
+  undumpi_close(profile);
+  free(profile);
+  if(sc.failed || sc.pos != rc->calls) {
+    fprintf(stderr, "undumpi_read_stream:  rank %d differs from "
+	    "dumpistate_parse_single after %d of %d calls\n",
+	    rank, sc.pos, rc->calls);
+    return 0;
+  }
+  return 1;
+}
+
+/* Check a communicator against the world ranks it should hold */
+static int check_comm(const dumpistate_comm *comm, int rank,
+		      const int *members, int size, const char *what)
+{
+  int i;
+  if(comm == NULL) {
+    fprintf(stderr, "%s:  no communicator on rank %d\n", what, rank);
+    return 0;
+  }
+  if(dumpistate_comm_size(comm) != size) {
+    fprintf(stderr, "%s:  size %d on rank %d, expected %d\n", what,
+	    dumpistate_comm_size(comm), rank, size);
+    return 0;
+  }
+  for(i = 0; i < size; ++i) {
+    if(dumpistate_comm_global_rank(comm, i) != members[i]) {
+      fprintf(stderr, "%s:  local rank %d is world rank %d on rank %d, "
+	      "expected %d\n", what, i, dumpistate_comm_global_rank(comm, i),
+	      rank, members[i]);
+      return 0;
+    }
+    if(members[i] == rank && dumpistate_comm_rank(comm) != i) {
+      fprintf(stderr, "%s:  rank %d has local rank %d, expected %d\n",
+	      what, rank, dumpistate_comm_rank(comm), i);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* The k-th split of MPI_COMM_WORLD on every rank is the same call */
+static int check_splits(const dumpistate *state, const rankcalls *rc,
+			int procs, int *members)
+{
+  int k, rank, other, size, i;
+  for(rank = 1; rank < procs; ++rank) {
+    if(rc[rank].splits != rc[0].splits) {
+      fprintf(stderr, "MPI_Comm_split:  rank %d split MPI_COMM_WORLD %d "
+	      "times, rank 0 %d times\n", rank, rc[rank].splits,
+	      rc[0].splits);
+      return 0;
+    }
+  }
+  for(k = 0; k < rc[0].splits; ++k) {
+    for(rank = 0; rank < procs; ++rank) {
+      const splitrec *mine = &rc[rank].split[k];
+      if(mine->newcomm == DUMPI_COMM_NULL)
+	continue;
+      /* Same color, ordered by key and then by world rank */
+      size = 0;
+      for(other = 0; other < procs; ++other) {
+	const splitrec *theirs = &rc[other].split[k];
+	if(theirs->newcomm == DUMPI_COMM_NULL || theirs->color != mine->color)
+	  continue;
+	for(i = size++; i > 0 && rc[members[i-1]].split[k].key > theirs->key;
+	    --i)
+	  members[i] = members[i-1];
+	members[i] = other;
+      }
+      if(! check_comm(dumpistate_get_comm(state, rank, mine->newcomm,
+					  &mine->done),
+		      rank, members, size, "MPI_Comm_split"))
+	return 0;
+    }
+  }
+  return 1;
+}
+
+int main(int argc, char **argv) {
+  dumpistate *state;
+  char *message = NULL;
+  rankcalls *rc;
+  mergecheck mc;
+  int procs, rank, calls = 0, status = 1;
+  if(argc < 2) {
+    fprintf(stderr, "Usage:  %s metafile trace0.bin trace1.bin ...\n",
+	    argv[0]);
+    return 1;
+  }
+  if((state = dumpistate_create(argv[1], &message)) == NULL) {
+    fprintf(stderr, "dumpistate_create:  %s\n",
+	    (message ? message : "failed"));
+    free(message);
+    return 1;
+  }
+  procs = dumpistate_world_size(state);
+  if(argc != procs + 2) {
+    fprintf(stderr, "%s has %d ranks but %d trace files were given\n",
+	    argv[1], procs, argc - 2);
+    dumpistate_free(state);
+    return 1;
+  }
+  assert((rc = (rankcalls*)calloc(procs, sizeof(rankcalls))) != NULL);
+  assert((mc.pos = (int*)calloc(procs, sizeof(int))) != NULL);
+  mc.rank = rc;
+  mc.procs = procs;
+  mc.skewed = 1;
+  mc.failed = 0;
+  for(rank = 0; rank < procs && status; ++rank) {
+    if(! dumpistate_parse_single(state, rank, single_call, &rc[rank])) {
+      fprintf(stderr, "dumpistate_parse_single failed on rank %d\n", rank);
+      status = 0;
+      break;
+    }
+    calls += rc[rank].calls;
+    if(! rc[rank].has_init)
+      mc.skewed = 0;
+    status = check_stream(argv[rank + 2], rank, &rc[rank]);
+  }
+  if(status) {
+    int *members;
+    assert((members = (int*)malloc(procs * sizeof(int))) != NULL);
+    for(rank = 0; rank < procs; ++rank)
+      members[rank] = rank;
+    for(rank = 0; rank < procs && status; ++rank)
+      status = check_comm(dumpistate_comm_world(state, rank), rank,
+			  members, procs, "MPI_COMM_WORLD");
+    if(status)
+      status = check_splits(state, rc, procs, members);
+    free(members);
+  }
+  if(status) {
+    if(! dumpistate_parse_all(state, merged_call, NULL, &mc) || mc.failed) {
+      fprintf(stderr, "dumpistate_parse_all failed\n");
+      status = 0;
+    }
+    for(rank = 0; rank < procs && status; ++rank) {
+      if(mc.pos[rank] != rc[rank].calls) {
+	fprintf(stderr, "dumpistate_parse_all:  %d of %d calls on rank %d\n",
+		mc.pos[rank], rc[rank].calls, rank);
+	status = 0;
+      }
+    }
+  }
+  if(status)
+    printf("%d ranks, %d calls, %d splits of MPI_COMM_WORLD\n", procs,
+	   calls, rc[0].splits);
+  for(rank = 0; rank < procs; ++rank) {
+    free(rc[rank].call);
+    free(rc[rank].split);
+  }
+  free(rc);
+  free(mc.pos);
+  dumpistate_free(state);
+  return (status ? 0 : 1);
+}
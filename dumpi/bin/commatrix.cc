@@ -0,0 +1,175 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bin/commatrix.h>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+
+namespace dumpi {
+
+  static const char csr_magic[8] = {'D','U','M','P','I','C','S','R'};
+  static const int32_t csr_version = 1;
+
+  //
+  // Empty matrix.
+  //
+  commatrix::commatrix(int32_t world_size) :
+    world_size_(world_size), row_start_(1, 0)
+  {}
+
+  //
+  // Append a row.
+  //
+  void commatrix::add_row(int32_t rank, const std::vector<cell> &cells) {
+    rank_.push_back(rank);
+    for(size_t i = 0; i < cells.size(); ++i) {
+      peer_.push_back(cells[i].peer);
+      bytes_.push_back(cells[i].bytes);
+      count_.push_back(cells[i].count);
+    }
+    row_start_.push_back(int64_t(peer_.size()));
+  }
+
+  template <typename T>
+  inline bool put(FILE *fp, const std::vector<T> &vec) {
+    return (vec.empty() ||
+            fwrite(&vec[0], sizeof(T), vec.size(), fp) == vec.size());
+  }
+
+  template <typename T>
+  inline bool get(FILE *fp, std::vector<T> &vec, int64_t size) {
+    vec.resize(size);
+    return (vec.empty() ||
+            fread(&vec[0], sizeof(T), vec.size(), fp) == vec.size());
+  }
+
+  //
+  // Write the matrix to the given file.
+  //
+  void commatrix::write(const std::string &fname) const {
+    FILE *fp = fopen(fname.c_str(), "wb");
+    if(fp == NULL) {
+      std::cerr << "commatrix:  Failed to open outfile " << fname << "\n";
+      throw "commatrix:  Failed to open outfile.";
+    }
+    int64_t rows = int64_t(rank_.size()), nonzeros = int64_t(peer_.size());
+    bool ok = (fwrite(csr_magic, sizeof(csr_magic), 1, fp) == 1 &&
+               fwrite(&csr_version, sizeof(int32_t), 1, fp) == 1 &&
+               fwrite(&world_size_, sizeof(int32_t), 1, fp) == 1 &&
+               fwrite(&rows, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&nonzeros, sizeof(int64_t), 1, fp) == 1 &&
+               put(fp, rank_) && put(fp, row_start_) && put(fp, peer_) &&
+               put(fp, bytes_) && put(fp, count_));
+    if(fclose(fp) != 0) ok = false;
+    if(! ok) {
+      std::cerr << "commatrix:  Failed to write " << fname << "\n";
+      throw "commatrix:  Failed to write outfile.";
+    }
+  }
+
+  //
+  // Read a matrix from file.
+  //
+  bool commatrix::read(const std::string &fname) {
+    FILE *fp = fopen(fname.c_str(), "rb");
+    if(fp == NULL)
+      return false;
+    char magic[sizeof(csr_magic)];
+    int32_t version = 0;
+    int64_t rows = 0, nonzeros = 0;
+    bool ok = (fread(magic, sizeof(magic), 1, fp) == 1 &&
+               memcmp(magic, csr_magic, sizeof(magic)) == 0 &&
+               fread(&version, sizeof(int32_t), 1, fp) == 1 &&
+               version == csr_version &&
+               fread(&world_size_, sizeof(int32_t), 1, fp) == 1 &&
+               fread(&rows, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&nonzeros, sizeof(int64_t), 1, fp) == 1 &&
+               rows >= 0 && nonzeros >= 0);
+    ok = (ok && get(fp, rank_, rows) && get(fp, row_start_, rows+1) &&
+          get(fp, peer_, nonzeros) && get(fp, bytes_, nonzeros) &&
+          get(fp, count_, nonzeros));
+    fclose(fp);
+    if(ok && (row_start_.front() != 0 || row_start_.back() != nonzeros))
+      ok = false;
+    if(! ok) {
+      *this = commatrix();
+    }
+    return ok;
+  }
+
+  //
+  // Write several matrices, spreading the files over worker threads.
+  //
+  void commatrix::write_all
+    (const std::vector<std::pair<std::string, const commatrix*> > &files)
+  {
+    size_t nthread = std::thread::hardware_concurrency();
+    if(nthread < 1) nthread = 1;
+    if(nthread > files.size()) nthread = files.size();
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> workers;
+    for(size_t t = 0; t < nthread; ++t) {
+      workers.push_back(std::thread([&]() {
+            size_t i;
+            while((i = next++) < files.size()) {
+              try {
+                files[i].second->write(files[i].first);
+              }
+              catch(const char*) {
+                failed = true;
+              }
+            }
+          }));
+    }
+    for(size_t t = 0; t < workers.size(); ++t)
+      workers[t].join();
+    if(failed)
+      throw "commatrix:  Failed to write outfiles.";
+  }
+
+} // end of namespace dumpi
@@ -0,0 +1,126 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_BIN_COMMATRIX_H
+#define DUMPI_BIN_COMMATRIX_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdint.h>
+
+namespace dumpi {
+
+  /**
+   * \ingroup dumpi_utilities
+   */
+  /*@{*/
+
+  /**
+   * A sparse communication matrix stored in compressed-sparse-row form.
+   * Each row holds the peers one rank sent to, with the byte and message
+   * counts for each peer (peers are sorted within a row).
+   *
+   * The binary file layout (native byte order) is:
+   *    char    magic[8] = "DUMPICSR"
+   *    int32_t version, world_size
+   *    int64_t rows, nonzeros
+   *    int32_t rank[rows]
+   *    int64_t row_start[rows+1]
+   *    int32_t peer[nonzeros]
+   *    int64_t bytes[nonzeros]
+   *    int64_t count[nonzeros]
+   * so row r covers entries row_start[r] up to row_start[r+1].
+   * A rank may appear in more than one row (e.g. accumulated gather bins).
+   */
+  class commatrix {
+  public:
+    /// A single non-zero entry.
+    struct cell {
+      int32_t peer;
+      int64_t bytes, count;
+    };
+
+  private:
+    int32_t world_size_;
+    std::vector<int32_t> rank_;
+    std::vector<int64_t> row_start_;
+    std::vector<int32_t> peer_;
+    std::vector<int64_t> bytes_, count_;
+
+  public:
+    /// Empty matrix.
+    commatrix(int32_t world_size = 0);
+
+    /// Append a row.  Cells must be sorted by peer.
+    void add_row(int32_t rank, const std::vector<cell> &cells);
+
+    /// Write the matrix to the given file.  Throws on failure.
+    void write(const std::string &fname) const;
+
+    /// Replace this matrix with the content of the given file.
+    /// \return false if the file could not be read or is not a matrix.
+    bool read(const std::string &fname);
+
+    /// Write several matrices at once, one file per thread.
+    static void write_all
+      (const std::vector<std::pair<std::string, const commatrix*> > &files);
+
+    int32_t world_size() const { return world_size_; }
+    size_t rows() const { return rank_.size(); }
+    size_t nonzeros() const { return peer_.size(); }
+    int32_t rank(size_t row) const { return rank_.at(row); }
+    /// Entries for a row run from row_begin(row) up to row_end(row).
+    int64_t row_begin(size_t row) const { return row_start_.at(row); }
+    int64_t row_end(size_t row) const { return row_start_.at(row+1); }
+    int32_t peer(int64_t entry) const { return peer_.at(entry); }
+    int64_t bytes(int64_t entry) const { return bytes_.at(entry); }
+    int64_t count(int64_t entry) const { return count_.at(entry); }
+  };
+
+  /*@}*/
+
+} // end of namespace dumpi
+
+#endif // ! DUMPI_BIN_COMMATRIX_H
@@ -49,8 +49,6 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/bin/dumpi2ascii-defs.h>
 #include <assert.h>
 
-d2a_addrmap *d2a_addr = NULL;
-
 int report_MPI_Send(const dumpi_send *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
   DUMPI_ENTERING(MPI_Send, prm, thread, cpu, wall, perf);
   DUMPI_REPORT_INT(count);
@@ -60,14 +60,9 @@ Questions? Contact sst-macro-help@sandia.gov
 /*@{*/
 
 /**
- * A debugging sanity check -- used in place of a more "real" user arg.
- * If we need to, we could use the shared containers (static variables)
- * instead of this fake user arg.
- */
-#define DUMPI_UARG (void*)0xFF00FF00 /* debugging sanity check */
-
-/**
- * The address mapping is stored in a shared container.
+ * Function address labels read from the trace.  Each conversion keeps
+ * its own table in its d2a_output (see dumpi2ascii-defs.h), which is
+ * passed to the callbacks as the user argument.
  */
 typedef struct d2a_addrmap {
   int        count;
@@ -75,9 +70,6 @@ typedef struct d2a_addrmap {
   char     **name;
 } d2a_addrmap;
 
-/** The shared container for address mapping */
-extern d2a_addrmap *d2a_addr;
-
 /** Define all our callbacks. */
 void set_callbacks(libundumpi_callbacks *cbacks);
 
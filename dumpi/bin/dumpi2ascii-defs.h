@@ -46,6 +46,9 @@ Questions? Contact sst-macro-help@sandia.gov
 #define DUMPI_BIN_DUMPI2ASCII_DEFS_H
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
 #include <dumpi/common/perfctrtags.h>
 
 #ifdef __cplusplus
@@ -64,10 +67,142 @@ extern "C" {
    */
   /*@{*/
 
+  /** Forward declaration (see dumpi2ascii-callbacks.h) */
+  struct d2a_addrmap;
+
+  /**
+   * Buffered output for dumpi2ascii.  Each converted file gets its own
+   * buffer (so files can be converted concurrently); callbacks find it
+   * through their user argument.  Formatting is done by hand below
+   * rather than through fprintf, which spends most of its time parsing
+   * format strings.
+   */
+  typedef struct d2a_output {
+    FILE *fh;
+    char *buf;
+    size_t pos, size;
+    /** Function address labels (used by DUMPI_REPORT_FUNC) */
+    const struct d2a_addrmap *addr;
+  } d2a_output;
+
+  /** Default size for the output buffer */
+#define D2A_BUFSIZE (1<<20)
+
+  /** The output buffer for the current callback */
+#define D2A_OUT ((d2a_output*)uarg)
+
+  /** Set up a buffer writing to the given file. */
+static inline void d2a_output_init(d2a_output *out, FILE *fh) {
+  out->fh = fh;
+  out->pos = 0;
+  out->size = D2A_BUFSIZE;
+  out->addr = NULL;
+  out->buf = (char*)malloc(out->size);
+  assert(out->buf != NULL);
+}
+
+  /** Write out everything buffered so far. */
+static inline void d2a_flush(d2a_output *out) {
+  if(out->pos > 0) {
+    fwrite(out->buf, 1, out->pos, out->fh);
+    out->pos = 0;
+  }
+}
+
+  /** Flush and release the buffer (the file is left open) */
+static inline void d2a_output_free(d2a_output *out) {
+  d2a_flush(out);
+  free(out->buf);
+  out->buf = NULL;
+}
+
+  /** Append len bytes. */
+static inline void d2a_write(d2a_output *out, const char *str, size_t len) {
+  if(out->pos + len > out->size) {
+    d2a_flush(out);
+    if(len > out->size) {
+      fwrite(str, 1, len, out->fh);
+      return;
+    }
+  }
+  memcpy(out->buf + out->pos, str, len);
+  out->pos += len;
+}
+
+  /** Append a string literal. */
+#define D2A_LIT(OUT, STR) d2a_write(OUT, STR, sizeof(STR)-1)
+
+  /** Append a string (NULL is written as "(null)", like glibc printf). */
+static inline void d2a_puts(d2a_output *out, const char *str) {
+  if(str == NULL) str = "(null)";
+  d2a_write(out, str, strlen(str));
+}
+
+  /** Append a single character. */
+static inline void d2a_putc(d2a_output *out, char ch) {
+  if(out->pos >= out->size) d2a_flush(out);
+  out->buf[out->pos++] = ch;
+}
+
   /**
-   * The filehandle to which dumpi2ascii writes its stuff.
+   * Append an integer, zero-padded to at least width characters
+   * (counting the sign) as with printf("%0*lld").
    */
-  extern FILE *dumpfh;
+static inline void d2a_int_pad(d2a_output *out, long long value, int width) {
+  char tmp[24];
+  int len = 0, neg = (value < 0);
+  unsigned long long uv = (neg ? 0ULL - (unsigned long long)value
+                           : (unsigned long long)value);
+  do {
+    tmp[len++] = (char)('0' + (uv % 10));
+    uv /= 10;
+  } while(uv);
+  if(out->pos + width + 24 > out->size) d2a_flush(out);
+  if(neg) {
+    out->buf[out->pos++] = '-';
+    --width;
+  }
+  for(; width > len; --width)
+    out->buf[out->pos++] = '0';
+  while(len > 0)
+    out->buf[out->pos++] = tmp[--len];
+}
+
+  /** Append an integer (printf("%lld")). */
+static inline void d2a_int(d2a_output *out, long long value) {
+  d2a_int_pad(out, value, 0);
+}
+
+  /** Append an unsigned 64-bit integer. */
+static inline void d2a_uint64(d2a_output *out, unsigned long long value) {
+  char tmp[24];
+  int len = 0;
+  do {
+    tmp[len++] = (char)('0' + (value % 10));
+    value /= 10;
+  } while(value);
+  if(out->pos + 24 > out->size) d2a_flush(out);
+  while(len > 0)
+    out->buf[out->pos++] = tmp[--len];
+}
+
+  /** Append a time as seconds.nanoseconds (printf("%d.%09d")). */
+static inline void d2a_time(d2a_output *out, int sec, int nsec) {
+  d2a_int(out, sec);
+  d2a_putc(out, '.');
+  d2a_int_pad(out, nsec, 9);
+}
+
+  /** Append "<label><value> (<name>)\n" -- the common form for handles */
+static inline void d2a_named(d2a_output *out, const char *label, int value,
+                             const char *name)
+{
+  d2a_puts(out, label);
+  d2a_int(out, value);
+  D2A_LIT(out, " (");
+  d2a_puts(out, name);
+  D2A_LIT(out, ")\n");
+}
 
   /** "Magic" value to indicate that we're dealing with a
    * NUL-terminated std::string */
@@ -88,20 +223,30 @@ extern "C" {
    * If the input array is NULL or count < 1 the status will be
    * reported as <IGNORED> (corresponding to MPI_IGNORE_STATUSES).
    */
-static inline void print_statuses(const dumpi_status *status, int count) {
+static inline void print_statuses(d2a_output *out, const dumpi_status *status,
+                                  int count)
+{
   if(count < 1 || status == NULL) {
-    fprintf(dumpfh, "<IGNORED>\n");
+    D2A_LIT(out, "<IGNORED>\n");
   }
   else {
     int i;
-    fprintf(dumpfh, "[");
+    d2a_putc(out, '[');
     for(i = 0; i < count; ++i) {
-      fprintf(dumpfh, "{bytes=%d, cancelled=%d, source=%d, tag=%d, error=%d}",
-             status[i].bytes, status[i].cancelled, status[i].source,
-             status[i].tag, status[i].error);
-      if(i < count-1) fprintf(dumpfh, ", ");
+      D2A_LIT(out, "{bytes=");
+      d2a_int(out, status[i].bytes);
+      D2A_LIT(out, ", cancelled=");
+      d2a_int(out, status[i].cancelled);
+      D2A_LIT(out, ", source=");
+      d2a_int(out, status[i].source);
+      D2A_LIT(out, ", tag=");
+      d2a_int(out, status[i].tag);
+      D2A_LIT(out, ", error=");
+      d2a_int(out, status[i].error);
+      d2a_putc(out, '}');
+      if(i < count-1) D2A_LIT(out, ", ");
     }
-    fprintf(dumpfh, "]\n");
+    D2A_LIT(out, "]\n");
   }
 }
 
@@ -111,29 +256,51 @@ static inline void print_statuses(const dumpi_status *status, int count) {
    * because the dumpi configuration file specified 'statuses disable'
    * or this is a call with 'statuses success' where no match was found.
    */
-static inline void print_requests(const dumpi_request *req, int count) {
+static inline void print_requests(d2a_output *out, const dumpi_request *req,
+                                  int count)
+{
   if(count < 0 || req == NULL) {
-    fprintf(dumpfh, "<IGNORED>\n");
+    D2A_LIT(out, "<IGNORED>\n");
   }
   else {
     int i;
-    fprintf(dumpfh, "[");
+    d2a_putc(out, '[');
     for(i = 0; i < count; ++i) {
-      fprintf(dumpfh, "%d", req[i]);
-      if(i < count-1) fprintf(dumpfh, ", ");
+      d2a_int(out, req[i]);
+      if(i < count-1) D2A_LIT(out, ", ");
+    }
+    D2A_LIT(out, "]\n");
   }
-    fprintf(dumpfh, "]\n");
+}
+
+  /** Print a comma-separated list of integers in brackets */
+static inline void print_ints(d2a_output *out, const int *arr, int count) {
+  int i;
+  d2a_putc(out, '[');
+  for(i = 0; i < count; ++i) {
+    d2a_int(out, arr[i]);
+    if(i < count-1) D2A_LIT(out, ", ");
   }
+  D2A_LIT(out, "]\n");
+}
+
+  /** Print a quoted string followed by ", " unless it is the last one */
+static inline void print_quoted(d2a_output *out, const char *str, int last) {
+  d2a_putc(out, '"');
+  d2a_puts(out, str);
+  d2a_putc(out, '"');
+  if(! last) D2A_LIT(out, ", ");
 }
 
   /** Common preamble for profiling methods */
 #define DUMPI_ENTERING(METHOD, PRM, THREAD, CPU, WALL, PERF) do { \
-    (void)uarg;						    \
-    fprintf(dumpfh, #METHOD " entering at walltime %d.%09d, "        \
-           "cputime %d.%09d seconds in thread %d.\n",       \
-           (WALL)->start.sec, (WALL)->start.nsec,	    \
-           (CPU)->start.sec,  (CPU)->start.nsec,	    \
-           (int)(THREAD));				    \
+    D2A_LIT(D2A_OUT, #METHOD " entering at walltime ");          \
+    d2a_time(D2A_OUT, (WALL)->start.sec, (WALL)->start.nsec);   \
+    D2A_LIT(D2A_OUT, ", cputime ");                             \
+    d2a_time(D2A_OUT, (CPU)->start.sec, (CPU)->start.nsec);     \
+    D2A_LIT(D2A_OUT, " seconds in thread ");                    \
+    d2a_int(D2A_OUT, (int)(THREAD));                            \
+    D2A_LIT(D2A_OUT, ".\n");                                    \
     DUMPI_PUT_PERF_IN(PERF);				    \
 } while(0)
 #ifndef ENTERING
@@ -142,30 +309,38 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Common postamble for profiling methods */
 #define DUMPI_RETURNING(METHOD, PRM, THREAD, CPU, WALL, PERF)	    \
-  fprintf(dumpfh, #METHOD " returning at walltime %d.%09d, "         \
-         "cputime %d.%09d seconds in thread %d.\n",         \
-         (WALL)->stop.sec, (WALL)->stop.nsec,		    \
-         (CPU)->stop.sec,  (CPU)->stop.nsec,		    \
-         (int)(THREAD));				    \
+  D2A_LIT(D2A_OUT, #METHOD " returning at walltime ");            \
+  d2a_time(D2A_OUT, (WALL)->stop.sec, (WALL)->stop.nsec);         \
+  D2A_LIT(D2A_OUT, ", cputime ");                                 \
+  d2a_time(D2A_OUT, (CPU)->stop.sec, (CPU)->stop.nsec);           \
+  D2A_LIT(D2A_OUT, " seconds in thread ");                        \
+  d2a_int(D2A_OUT, (int)(THREAD));                                \
+  D2A_LIT(D2A_OUT, ".\n");                                        \
   DUMPI_PUT_PERF_OUT(PERF);				    \
   return 1
 #ifndef RETURNING
 #define RETURNING DUMPI_RETURNING
 #endif
 
+  /** Print PAPI perfcounter values (in or out) */
+static inline void print_perf(d2a_output *out, const dumpi_perfinfo *perf,
+                              const int64_t *value)
+{
+  int i;
+  D2A_LIT(out, "Perfcounters: [");
+  for(i = 0; i < perf->count; ++i) {
+    d2a_puts(out, perf->counter_tag[i]);
+    d2a_putc(out, '=');
+    d2a_int(out, (long long)value[i]);
+    if(i < (perf->count-1)) D2A_LIT(out, ", ");
+  }
+  D2A_LIT(out, "]\n");
+}
+
   /** Print PAPI perfcounter information at start of MPI call if available */
 #define DUMPI_PUT_PERF_IN(PERF) do {			            \
-  if(PERF != NULL && perf->count > 0) {			    \
-    int i;						    \
-    fprintf(dumpfh, "Perfcounters: [");				    \
-    for(i = 0; i < perf->count; ++i) {			    \
-      fprintf(dumpfh, "%s=%lld",					    \
-	     perf->counter_tag[i],                          \
-	     (long long)perf->invalue[i]);		    \
-      if(i < (perf->count-1)) fprintf(dumpfh, ", ");		    \
-    }							    \
-    fprintf(dumpfh, "]\n");					    \
-  }							    \
+  if(PERF != NULL && perf->count > 0)			    \
+    print_perf(D2A_OUT, perf, perf->invalue);               \
 } while(0)
 #ifndef PUT_PERF_IN
 #define PUT_PERF_IN DUMPI_PUT_PERF_IN
@@ -173,24 +348,19 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print PAPI perfcounter information at completion of MPI call */
 #define DUMPI_PUT_PERF_OUT(PERF) do {			            \
-  if(PERF != NULL && perf->count > 0) {			    \
-    int i;						    \
-    fprintf(dumpfh, "Perfcounters: [");				    \
-    for(i = 0; i < perf->count; ++i) {			    \
-      fprintf(dumpfh, "%s=%lld",					    \
-	     perf->counter_tag[i],                          \
-	     (long long)perf->outvalue[i]);		    \
-      if(i < (perf->count-1)) fprintf(dumpfh, ", ");		    \
-    }							    \
-    fprintf(dumpfh, "]\n");					    \
-  }							    \
+  if(PERF != NULL && perf->count > 0)			    \
+    print_perf(D2A_OUT, perf, perf->outvalue);              \
 } while(0)
 #ifndef PUT_PERF_OUT
 #define PUT_PERF_OUT DUMPI_PUT_PERF_OUT
 #endif
 
   /** Print the name of an integer variable and its value */
-#define DUMPI_REPORT_INT(TTAG) fprintf(dumpfh, "int " #TTAG "=%d\n", prm->TTAG)
+#define DUMPI_REPORT_INT(TTAG) do {                             \
+  D2A_LIT(D2A_OUT, "int " #TTAG "=");                           \
+  d2a_int(D2A_OUT, prm->TTAG);                                  \
+  d2a_putc(D2A_OUT, '\n');                                      \
+} while(0)
 #ifndef REPORT_INT
 #define REPORT_INT DUMPI_REPORT_INT
 #endif
@@ -200,26 +370,24 @@ static inline void print_requests(const dumpi_request *req, int count) {
    * If the array is NULL or length < 1, the array is reported as <IGNORED>
    */
 #define DUMPI_REPORT_INT_ARRAY_1(LEN, TTAG) do {                  \
-  int i;						    \
-  fprintf(dumpfh, "int " #TTAG "[%d]=", LEN);			    \
-  if((LEN) < 1 || prm->TTAG == NULL) {			    \
-    fprintf(dumpfh, "<IGNORED>\n");				    \
-  }							    \
-  else {						    \
-    fprintf(dumpfh, "[");					    \
-    for(i = 0; i < (LEN); ++i) {			    \
-      fprintf(dumpfh, "%d", prm->TTAG[i]);			    \
-      if(i < ((LEN)-1)) fprintf(dumpfh, ", ");			    \
-    }							    \
-    fprintf(dumpfh, "]\n");					    \
-  }							    \
+  D2A_LIT(D2A_OUT, "int " #TTAG "[");                             \
+  d2a_int(D2A_OUT, LEN);                                          \
+  D2A_LIT(D2A_OUT, "]=");                                         \
+  if((LEN) < 1 || prm->TTAG == NULL)			    \
+    D2A_LIT(D2A_OUT, "<IGNORED>\n");                              \
+  else                                                            \
+    print_ints(D2A_OUT, prm->TTAG, (LEN));                        \
 } while(0)
 #ifndef REPORT_INT_ARRAY_1
 #define REPORT_INT_ARRAY_1 DUMPI_REPORT_INT_ARRAY_1
 #endif
 
   /** Print the name of an int64_t variable and its value. */
-#define DUMPI_REPORT_INT64_T(TTAG) fprintf(dumpfh, "int64_t " #TTAG "=%lld\n", (long long int)(prm->TTAG))
+#define DUMPI_REPORT_INT64_T(TTAG) do {                         \
+  D2A_LIT(D2A_OUT, "int64_t " #TTAG "=");                       \
+  d2a_int(D2A_OUT, (long long int)(prm->TTAG));                 \
+  d2a_putc(D2A_OUT, '\n');                                      \
+} while(0)
 #ifndef REPORT_INT64_T
 #define REPORT_INT64_T DUMPI_REPORT_INT64_T
 #endif
@@ -231,22 +399,26 @@ static inline void print_requests(const dumpi_request *req, int count) {
    */
 #define DUMPI_REPORT_INT_ARRAY_2(X, Y, TTAG) do {                 \
   int i,j;						    \
-  fprintf(dumpfh, "int " #TTAG "[%d][%d]=", X, Y);                   \
+  D2A_LIT(D2A_OUT, "int " #TTAG "[");                             \
+  d2a_int(D2A_OUT, X);                                            \
+  D2A_LIT(D2A_OUT, "][");                                         \
+  d2a_int(D2A_OUT, Y);                                            \
+  D2A_LIT(D2A_OUT, "]=");                                         \
   if((X) < 1 || prm->TTAG == NULL) {			    \
-    fprintf(dumpfh, "<IGNORED>\n");				    \
+    D2A_LIT(D2A_OUT, "<IGNORED>\n");                              \
   }							    \
   else {						    \
-    fprintf(dumpfh, "[");					    \
+    d2a_putc(D2A_OUT, '[');                                       \
     for(i = 0; i < (X); ++i) {                              \
-      fprintf(dumpfh, "[");                                          \
+      d2a_putc(D2A_OUT, '[');                                     \
       for(j = 0; j < (Y); ++j) {                            \
-        fprintf(dumpfh, "%d", prm->TTAG[i][j]);			    \
-        if(j < ((Y)-1)) fprintf(dumpfh, ", ");			    \
+        d2a_int(D2A_OUT, prm->TTAG[i][j]);                        \
+        if(j < ((Y)-1)) D2A_LIT(D2A_OUT, ", ");                   \
       }							    \
-      fprintf(dumpfh, "]\n");					    \
-      if(i < ((X)-1)) fprintf(dumpfh, ", ");                         \
+      D2A_LIT(D2A_OUT, "]\n");                                    \
+      if(i < ((X)-1)) D2A_LIT(D2A_OUT, ", ");                     \
     }                                                       \
-    fprintf(dumpfh, "]");                                            \
+    d2a_putc(D2A_OUT, ']');                                       \
   }							    \
 } while(0)
 #ifndef REPORT_INT_ARRAY_2
@@ -254,8 +426,11 @@ static inline void print_requests(const dumpi_request *req, int count) {
 #endif
 
   /** Print the name of a std::string variable and its value */
-#define DUMPI_REPORT_CHAR_ARRAY_1(IGNORED, TTAG)              \
-  fprintf(dumpfh, "string " #TTAG "=\"%s\"\n", prm->TTAG)
+#define DUMPI_REPORT_CHAR_ARRAY_1(IGNORED, TTAG) do {         \
+  D2A_LIT(D2A_OUT, "string " #TTAG "=\"");                    \
+  d2a_puts(D2A_OUT, prm->TTAG);                               \
+  D2A_LIT(D2A_OUT, "\"\n");                                   \
+} while(0)
 #ifndef REPORT_CHAR_ARRAY_1
 #define REPORT_CHAR_ARRAY_1 DUMPI_REPORT_CHAR_ARRAY_1
 #endif
@@ -263,79 +438,70 @@ static inline void print_requests(const dumpi_request *req, int count) {
   /** Print an array of std::strings. */
 #define DUMPI_REPORT_CHAR_ARRAY_2(LEN, IGNORED, TTAG) do {        \
   int i;						    \
-  fprintf(dumpfh, "string " #TTAG "[%d]=", LEN);			    \
+  D2A_LIT(D2A_OUT, "string " #TTAG "[");                          \
+  d2a_int(D2A_OUT, LEN);                                          \
+  D2A_LIT(D2A_OUT, "]=");                                         \
   if((LEN) ==0 || prm->TTAG == NULL) {			    \
-    fprintf(dumpfh, "<IGNORED>\n");				    \
+    D2A_LIT(D2A_OUT, "<IGNORED>\n");                              \
   }							    \
   else {						    \
-    fprintf(dumpfh, "[");					    \
+    d2a_putc(D2A_OUT, '[');                                       \
     if((LEN) > 0) {                                         \
-      for(i = 0; i < (LEN); ++i) {			    \
-        fprintf(dumpfh, "\"%s\"", prm->TTAG[i]);			    \
-        if(i < ((LEN)-1)) fprintf(dumpfh, ", ");			    \
-      }							    \
+      for(i = 0; i < (LEN); ++i)                            \
+        print_quoted(D2A_OUT, prm->TTAG[i], i >= ((LEN)-1));      \
     }                                                       \
     else {                                                  \
-      for(i = 0; prm->TTAG[i] != NULL; ++i) {             \
-        fprintf(dumpfh, "\"%s\"", prm->TTAG[i]);                     \
-        if(i < ((LEN)-1)) fprintf(dumpfh, ", ");			    \
-      }							    \
+      for(i = 0; prm->TTAG[i] != NULL; ++i)                 \
+        print_quoted(D2A_OUT, prm->TTAG[i], i >= ((LEN)-1));      \
     }                                                       \
-    fprintf(dumpfh, "]\n");					    \
+    D2A_LIT(D2A_OUT, "]\n");                                      \
   }							    \
 } while(0)
 #ifndef REPORT_CHAR_ARRAY_2
 #define REPORT_CHAR_ARRAY_2 DUMPI_REPORT_CHAR_ARRAY_2
 #endif
 
+  /** Print one row of a 2D array of strings (see DUMPI_REPORT_CHAR_ARRAY_3) */
+static inline void print_quoted_row(d2a_output *out, char **row, int len) {
+  int j;
+  d2a_putc(out, '[');
+  if(len >= 0) {
+    for(j = 0; j < len; ++j)
+      print_quoted(out, row[j], j >= (len-1));
+  }
+  else {
+    for(j = 0; row[j] != NULL; ++j)
+      print_quoted(out, row[j], j >= (len-1));
+  }
+  d2a_putc(out, ']');
+}
+
   /** Print a 2D array of std::strings (annoying MPI_Comm_spawn_multiple) */
 #define DUMPI_REPORT_CHAR_ARRAY_3(X, Y, IGNORED, TTAG) do {       \
-  int i,j;						    \
-  fprintf(dumpfh, "string " #TTAG "[%d][%d]=", X, Y);                \
+  int i;						    \
+  D2A_LIT(D2A_OUT, "string " #TTAG "[");                          \
+  d2a_int(D2A_OUT, X);                                            \
+  D2A_LIT(D2A_OUT, "][");                                         \
+  d2a_int(D2A_OUT, Y);                                            \
+  D2A_LIT(D2A_OUT, "]=");                                         \
   if((X) ==0 || prm->TTAG == NULL) {			    \
-    fprintf(dumpfh, "<IGNORED>\n");				    \
+    D2A_LIT(D2A_OUT, "<IGNORED>\n");                              \
   }							    \
   else {						    \
-    fprintf(dumpfh, "[");					    \
+    d2a_putc(D2A_OUT, '[');                                       \
     if((X) > 0) {                                           \
       for(i = 0; i < (X); ++i) {			    \
-        fprintf(dumpfh, "[");                                        \
-        if((Y) >= 0) {                                      \
-          for(j = 0; j < (Y); ++j) {                        \
-            fprintf(dumpfh, "\"%s\"", prm->TTAG[i][j]);              \
-            if(j < ((Y)-1)) fprintf(dumpfh, ", ");                   \
-          }                                                 \
-        }                                                   \
-        else {                                              \
-          for(j = 0; prm->TTAG[i][j] != NULL; ++j) {        \
-            fprintf(dumpfh, "\"%s\"", prm->TTAG[i][j]);              \
-            if(j < ((Y)-1)) fprintf(dumpfh, ", ");                   \
-          }                                                 \
-        }                                                   \
-        fprintf(dumpfh, "]");                                        \
-        if(i < ((X)-1)) fprintf(dumpfh, ", ");                       \
+        print_quoted_row(D2A_OUT, prm->TTAG[i], (Y));             \
+        if(i < ((X)-1)) D2A_LIT(D2A_OUT, ", ");                   \
       }							    \
     }                                                       \
     else {                                                  \
       for(i = 0; prm->TTAG[i] != NULL; ++i) {             \
-        fprintf(dumpfh, "[");                                        \
-        if((Y) >= 0) {                                      \
-          for(j = 0; j < (Y); ++j) {                        \
-            fprintf(dumpfh, "\"%s\"", prm->TTAG[i][j]);              \
-            if(j < ((Y)-1)) fprintf(dumpfh, ", ");                   \
-          }                                                 \
-        }                                                   \
-        else {                                              \
-          for(j = 0; prm->TTAG[i][j] != NULL; ++j) {        \
-            fprintf(dumpfh, "\"%s\"", prm->TTAG[i][j]);              \
-            if(j < ((Y)-1)) fprintf(dumpfh, ", ");                   \
-          }                                                 \
-        }                                                   \
-        fprintf(dumpfh, "]");                                        \
-        if(i < ((X)-1)) fprintf(dumpfh, ", ");			    \
+        print_quoted_row(D2A_OUT, prm->TTAG[i], (Y));             \
+        if(i < ((X)-1)) D2A_LIT(D2A_OUT, ", ");                   \
       }							    \
     }                                                       \
-    fprintf(dumpfh, "]\n");					    \
+    D2A_LIT(D2A_OUT, "]\n");                                      \
   }							    \
 } while(0)
 #ifndef REPORT_CHAR_ARRAY_3
@@ -344,7 +510,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of an MPI_Combiner variable and its value */
 #define DUMPI_REPORT_COMBINER(TTAG) do {            \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_combiner_name(prm->TTAG));    \
 } while(0)
 #ifndef REPORT_DUMPI_COMBINER
@@ -356,8 +522,8 @@ static inline void print_requests(const dumpi_request *req, int count) {
    * Provides special handling for MPI_ROOT. 
    */
 #define DUMPI_REPORT_DEST(TTAG) do {                                    \
-    if(prm->TTAG == DUMPI_ROOT)                                         \
-    fprintf(dumpfh, "int " #TTAG "=%d (MPI_ROOT)\n", prm->TTAG);                 \
+  if(prm->TTAG == DUMPI_ROOT)                                           \
+    d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG, "MPI_ROOT");        \
   else                                                                  \
     DUMPI_REPORT_INT(TTAG);                                                   \
 } while(0)
@@ -368,12 +534,14 @@ static inline void print_requests(const dumpi_request *req, int count) {
   /** Print the name of a distribution array variable and all the values */
 #define DUMPI_REPORT_DISTRIBUTION_ARRAY_1(LEN, TTAG) do {       \
     int i;                                                      \
-    fprintf(dumpfh, "int " #TTAG "[%d]=[", LEN);                         \
+    D2A_LIT(D2A_OUT, "int " #TTAG "[");                         \
+    d2a_int(D2A_OUT, LEN);                                      \
+    D2A_LIT(D2A_OUT, "]=[");                                    \
     for(i = 0; i < (LEN); ++i) {                                \
-      fprintf(dumpfh, "%d", (int)(prm->TTAG[i]));                        \
-      if(i < ((LEN)-1)) fprintf(dumpfh, ", ");                           \
+      d2a_int(D2A_OUT, (int)(prm->TTAG[i]));                    \
+      if(i < ((LEN)-1)) D2A_LIT(D2A_OUT, ", ");                 \
     }                                                           \
-    fprintf(dumpfh, "]\n");                                              \
+    D2A_LIT(D2A_OUT, "]\n");                                    \
 } while(0)
 #ifndef REPORT_DUMPI_DISTRIBUTION_ARRAY_1
 #define REPORT_DUMPI_DISTRIBUTION_ARRAY_1 DUMPI_REPORT_DISTRIBUTION_ARRAY_1
@@ -387,7 +555,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of a file variable and its dumpi value */
 #define DUMPI_REPORT_FILE(TTAG) do {                        \
-    fprintf(dumpfh, "MPI_File " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+    d2a_named(D2A_OUT, "MPI_File " #TTAG "=", prm->TTAG,          \
            dumpi_get_file_name(prm->TTAG));                 \
 } while(0)
 #ifndef REPORT_DUMPI_FILE
@@ -396,7 +564,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of an info variable and its value */
 #define DUMPI_REPORT_INFO(TTAG) do {                    \
-    fprintf(dumpfh, "MPI_Info " #TTAG "=%d (%s)\n", prm->TTAG,   \
+    d2a_named(D2A_OUT, "MPI_Info " #TTAG "=", prm->TTAG,      \
            dumpi_get_info_name(prm->TTAG));             \
 } while(0)
 #ifndef REPORT_DUMPI_INFO
@@ -406,12 +574,14 @@ static inline void print_requests(const dumpi_request *req, int count) {
   /** Print the name of an array of info variables and their values */
 #define DUMPI_REPORT_INFO_ARRAY_1(LEN, TTAG) do {       \
   int i;                                                \
-  fprintf(dumpfh, "MPI_Info " #TTAG "[%d]=[", LEN);              \
+  D2A_LIT(D2A_OUT, "MPI_Info " #TTAG "[");              \
+  d2a_int(D2A_OUT, LEN);                                \
+  D2A_LIT(D2A_OUT, "]=[");                              \
   for(i = 0; i < LEN; ++i) {                            \
-    fprintf(dumpfh, "%d", prm->TTAG[i]);                         \
-    if(i < ((LEN)-1)) fprintf(dumpfh, ", ");                     \
+    d2a_int(D2A_OUT, prm->TTAG[i]);                     \
+    if(i < ((LEN)-1)) D2A_LIT(D2A_OUT, ", ");           \
   }                                                     \
-  fprintf(dumpfh, "]\n");                                        \
+  D2A_LIT(D2A_OUT, "]\n");                              \
 } while(0)
 #ifndef REPORT_DUMPI_INFO_ARRAY_1
 #define REPORT_DUMPI_INFO_ARRAY_1 DUMPI_REPORT_INFO_ARRAY_1
@@ -419,7 +589,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of a keyval variable, its value, and description */
 #define DUMPI_REPORT_KEYVAL(TTAG) do {              \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_keyval_name(prm->TTAG));         \
 } while(0)
 #ifndef REPORT_DUMPI_KEYVAL
@@ -428,7 +598,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of a comm keyval variable, its value, and description */
 #define DUMPI_REPORT_COMM_KEYVAL(TTAG) do {              \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_keyval_name(prm->TTAG));         \
 } while(0)
 #ifndef REPORT_DUMPI_COMM_KEYVAL
@@ -437,7 +607,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of a type keyval variable, its value, and description */
 #define DUMPI_REPORT_TYPE_KEYVAL(TTAG) do {              \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_keyval_name(prm->TTAG));         \
 } while(0)
 #ifndef REPORT_DUMPI_TYPE_KEYVAL
@@ -446,7 +616,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of a win keyval variable, its value, and description */
 #define DUMPI_REPORT_WIN_KEYVAL(TTAG) do {              \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_keyval_name(prm->TTAG));         \
 } while(0)
 #ifndef REPORT_DUMPI_WIN_KEYVAL
@@ -455,7 +625,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of a locktype variable, its value, and description */
 #define DUMPI_REPORT_LOCKTYPE(TTAG) do {            \
-    fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,    \
+    d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,       \
            dumpi_get_locktype_name(prm->TTAG));     \
 } while(0)
 #ifndef REPORT_DUMPI_LOCKTYPE
@@ -464,7 +634,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of an errhandler variable, its value, and description */
 #define DUMPI_REPORT_ERRHANDLER(TTAG) do {          \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_errhandler_name(prm->TTAG));     \
 } while(0)
 #ifndef REPORT_DUMPI_ERRHANDLER
@@ -473,7 +643,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of a file mode variable, its value, and descriptive name */
 #define DUMPI_REPORT_FILEMODE(TTAG) do {          \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,       \
 	 dumpi_get_filemode_name(prm->TTAG));     \
 } while(0)
 #ifndef REPORT_DUMPI_FILEMODE
@@ -482,7 +652,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print the name of an ordering variable, its value, and descriptive name */
 #define DUMPI_REPORT_ORDERING(TTAG) do {            \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_ordering_name(prm->TTAG));    \
 } while(0)
 #ifndef REPORT_DUMPI_ORDERING
@@ -494,9 +664,9 @@ static inline void print_requests(const dumpi_request *req, int count) {
    * MPI_ANY_SOURCE and MPI_ROOT */
 #define DUMPI_REPORT_SOURCE(TTAG) do {				    \
   if(prm->TTAG == DUMPI_ANY_SOURCE)                                 \
-    fprintf(dumpfh, "int " #TTAG "=%d (MPI_ANY_SOURCE)\n", prm->TTAG);       \
+    d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG, "MPI_ANY_SOURCE");  \
   else if(prm->TTAG == DUMPI_ROOT)                                  \
-    fprintf(dumpfh, "int " #TTAG "=%d (MPI_ROOT)\n", prm->TTAG);             \
+    d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG, "MPI_ROOT");    \
   else                                                              \
     DUMPI_REPORT_INT(TTAG);                                                   \
 } while(0)
@@ -506,10 +676,10 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Print a the name and value of a tag.  Special handling for MPI_ANY_TAG */
 #define DUMPI_REPORT_TAG(TTAG) do {                         \
-    if(prm->TTAG != DUMPI_ANY_TAG)			    \
-      DUMPI_REPORT_INT(TTAG);					    \
+  if(prm->TTAG != DUMPI_ANY_TAG)			    \
+    DUMPI_REPORT_INT(TTAG);					    \
   else							    \
-    fprintf(dumpfh, "int " #TTAG "=%d (MPI_ANY_TAG)\n", prm->TTAG);  \
+    d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG, "MPI_ANY_TAG"); \
 } while(0)
 #ifndef REPORT_DUMPI_TAG
 #define REPORT_DUMPI_TAG DUMPI_REPORT_TAG
@@ -517,7 +687,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name and value of a thread level variable, and a description */
 #define DUMPI_REPORT_THREADLEVEL(TTAG) do {         \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_threadlevel_name(prm->TTAG));    \
 } while(0)
 #ifndef REPORT_DUMPI_THREADLEVEL
@@ -526,7 +696,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name and value of a topology variable, and a description */
 #define DUMPI_REPORT_TOPOLOGY(TTAG) do {            \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_topology_name(prm->TTAG));       \
 } while(0)
 #ifndef REPORT_DUMPI_TOPOLOGY
@@ -535,7 +705,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name and value of a typeclass variable, and a description */
 #define DUMPI_REPORT_TYPECLASS(TTAG) do {           \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_typeclass_name(prm->TTAG));    \
 } while(0)
 #ifndef REPORT_DUMPI_TYPECLASS
@@ -544,7 +714,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name and value of a win variable, and a description */
 #define DUMPI_REPORT_WIN(TTAG) do {                 \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,         \
 	 dumpi_get_win_name(prm->TTAG));            \
 } while(0)
 #ifndef REPORT_DUMPI_WIN
@@ -553,7 +723,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name & value of a win assertion variable, and a description */
 #define DUMPI_REPORT_WIN_ASSERT(TTAG) do {        \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,    \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,       \
 	 dumpi_get_win_assert_name(prm->TTAG));   \
 } while(0)
 #ifndef REPORT_DUMPI_WIN_ASSERT
@@ -562,8 +732,8 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name and value of a status variable */
 #define DUMPI_REPORT_STATUS_PTR(TTAG) do {                    \
-  fprintf(dumpfh, "MPI_Status " #TTAG "=");                            \
-  print_statuses(prm->TTAG, 1);                               \
+  D2A_LIT(D2A_OUT, "MPI_Status " #TTAG "=");                  \
+  print_statuses(D2A_OUT, prm->TTAG, 1);                      \
 } while(0)
 #ifndef REPORT_DUMPI_STATUS_PTR
 #define REPORT_DUMPI_STATUS_PTR DUMPI_REPORT_STATUS_PTR
@@ -571,42 +741,46 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name and values of an array of statuses */
 #define DUMPI_REPORT_STATUS_ARRAY_1(COUNT, TTAG) do {         \
-    fprintf(dumpfh, "MPI_Status " #TTAG "[%d]=", (COUNT));             \
-    print_statuses(prm->TTAG, COUNT);                         \
+  D2A_LIT(D2A_OUT, "MPI_Status " #TTAG "[");                  \
+  d2a_int(D2A_OUT, (COUNT));                                  \
+  D2A_LIT(D2A_OUT, "]=");                                     \
+  print_statuses(D2A_OUT, prm->TTAG, COUNT);                  \
 } while(0)
 #ifndef REPORT_DUMPI_STATUS_ARRAY_1
 #define REPORT_DUMPI_STATUS_ARRAY_1 DUMPI_REPORT_STATUS_ARRAY_1
 #endif
 
   /** Print the name and value of a std::string variable */
-#define DUMPI_STRVAL(TTAG) fprintf(dumpfh, "string " #TTAG "=%s\n", prm->TTAG)
-#ifndef STRVAL
+#define DUMPI_STRVAL(TTAG) do {                                 \
+  D2A_LIT(D2A_OUT, "string " #TTAG "=");                        \
+  d2a_puts(D2A_OUT, prm->TTAG);                                 \
+  d2a_putc(D2A_OUT, '\n');                                      \
+} while(0)
 #define STRVAL DUMPI_STRVAL
-#endif
 
   /** Print the name and values of a std::string array variable */
 #define DUMPI_STRARR(TTAG, LEN) do {			            \
   int i;						    \
-  fprintf(dumpfh, "string " #TTAG "[%d]=\n", LEN);		    \
+  D2A_LIT(D2A_OUT, "string " #TTAG "[");                          \
+  d2a_int(D2A_OUT, LEN);                                          \
+  D2A_LIT(D2A_OUT, "]=\n");                                       \
   if((LEN) < 1 || prm->TTAG == NULL) {			    \
-    fprintf(dumpfh, "<IGNORED>\n");				    \
+    D2A_LIT(D2A_OUT, "<IGNORED>\n");                              \
   }							    \
   else {						    \
-    fprintf(dumpfh, "[");					    \
+    d2a_putc(D2A_OUT, '[');                                       \
     for(i = 0; i < (LEN); ++i) {			    \
-      fprintf(dumpfh, "%s", prm->TTAG[i]);			    \
-      if(i < ((LEN)-1)) fprintf(dumpfh, ", ");			    \
+      d2a_puts(D2A_OUT, prm->TTAG[i]);                            \
+      if(i < ((LEN)-1)) D2A_LIT(D2A_OUT, ", ");                   \
     }							    \
-    fprintf(dumpfh, "]\n");					    \
+    D2A_LIT(D2A_OUT, "]\n");                                      \
   }							    \
 } while(0)
-#ifndef STRARR
 #define STRARR DUMPI_STRARR
-#endif
 
   /** Report the name, value, and descriptor of a communicator variable */
 #define DUMPI_REPORT_COMM(TTAG) do {                        \
-  fprintf(dumpfh, "MPI_Comm " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "MPI_Comm " #TTAG "=", prm->TTAG,            \
 	 dumpi_get_comm_name(prm->TTAG));		    \
 } while(0)
 #ifndef REPORT_DUMPI_COMM
@@ -615,7 +789,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name, value, and description of a comparison */
 #define DUMPI_REPORT_COMPARISON(TTAG) do {                  \
-  fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	            \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,                 \
          dumpi_get_comparison_name(prm->TTAG));             \
 } while(0)
 #ifndef REPORT_DUMPI_COMPARISON
@@ -623,19 +797,21 @@ static inline void print_requests(const dumpi_request *req, int count) {
 #endif
 
   /** print the name and values of a data type array variable */
-  static inline void print_datatypes(dumpi_datatype *dtarr, int count) {
+  static inline void print_datatypes(d2a_output *out, dumpi_datatype *dtarr,
+                                     int count)
+  {
     int i;
-    fprintf(dumpfh, "[");
+    d2a_putc(out, '[');
     for(i = 0; i < count; ++i) {
-      fprintf(dumpfh, "%d", (int)dtarr[i]);
-      if(i < (count-1)) fprintf(dumpfh, ", ");
+      d2a_int(out, (int)dtarr[i]);
+      if(i < (count-1)) D2A_LIT(out, ", ");
     }
-    fprintf(dumpfh, "]\n");
+    D2A_LIT(out, "]\n");
   }
 
   /** Report the name, value, and description of a datatype variable */
 #define DUMPI_REPORT_DATATYPE(TTAG) do {                    \
-  fprintf(dumpfh, "MPI_Datatype " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "MPI_Datatype " #TTAG "=", prm->TTAG,        \
 	 dumpi_get_datatype_name(prm->TTAG));		    \
 } while(0)
 #ifndef REPORT_DUMPI_DATATYPE
@@ -644,8 +820,10 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name, values, and descriptions of an array of datatypes */
 #define DUMPI_REPORT_DATATYPE_ARRAY_1(COUNT, TTAG) do {     \
-    fprintf(dumpfh, "MPI_Datatype " #TTAG "[%d]=", COUNT);           \
-    print_datatypes(prm->TTAG, COUNT);                      \
+  D2A_LIT(D2A_OUT, "MPI_Datatype " #TTAG "[");              \
+  d2a_int(D2A_OUT, COUNT);                                  \
+  D2A_LIT(D2A_OUT, "]=");                                   \
+  print_datatypes(D2A_OUT, prm->TTAG, COUNT);               \
 } while(0)
 #ifndef REPORT_DUMPI_DATATYPE_ARRAY_1
 #define REPORT_DUMPI_DATATYPE_ARRAY_1 DUMPI_REPORT_DATATYPE_ARRAY_1
@@ -653,7 +831,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name, value, and description of a group variable */
 #define DUMPI_REPORT_GROUP(TTAG) do {                       \
-  fprintf(dumpfh, "MPI_Group " #TTAG "=%d (%s)\n", prm->TTAG,	    \
+  d2a_named(D2A_OUT, "MPI_Group " #TTAG "=", prm->TTAG,           \
 	 dumpi_get_group_name(prm->TTAG));		    \
 } while(0)
 #ifndef REPORT_DUMPI_GROUP
@@ -662,7 +840,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name, value, and description of an MPI_Op. */
 #define DUMPI_REPORT_OP(TTAG) do {                                  \
-    fprintf(dumpfh, "MPI_Op " #TTAG "=%d (%s)\n", prm->TTAG,	            \
+  d2a_named(D2A_OUT, "MPI_Op " #TTAG "=", prm->TTAG,                      \
            dumpi_get_op_name(prm->TTAG));			    \
 } while(0)
 #ifndef REPORT_DUMPI_OP
@@ -671,8 +849,8 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name and value of a request handle */
 #define DUMPI_REPORT_REQUEST(TTAG) do {                       \
-  fprintf(dumpfh, "MPI_Request " #TTAG "=");                           \
-  print_requests(&(prm->TTAG), 1);                            \
+  D2A_LIT(D2A_OUT, "MPI_Request " #TTAG "=");                 \
+  print_requests(D2A_OUT, &(prm->TTAG), 1);                   \
 } while(0)
 #ifndef REPORT_DUMPI_REQUEST
 #define REPORT_DUMPI_REQUEST DUMPI_REPORT_REQUEST
@@ -680,8 +858,10 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name and values of an array of request handles */
 #define DUMPI_REPORT_REQUEST_ARRAY_1(COUNT, TTAG) do {  \
-  fprintf(dumpfh, "MPI_Request " #TTAG "[%d]=", COUNT);                \
-  print_requests(prm->TTAG, COUNT);                           \
+  D2A_LIT(D2A_OUT, "MPI_Request " #TTAG "[");           \
+  d2a_int(D2A_OUT, COUNT);                              \
+  D2A_LIT(D2A_OUT, "]=");                               \
+  print_requests(D2A_OUT, prm->TTAG, COUNT);            \
 } while(0)
 #ifndef REPORT_DUMPI_REQUEST_ARRAY_1
 #define REPORT_DUMPI_REQUEST_ARRAY_1 DUMPI_REPORT_REQUEST_ARRAY_1
@@ -689,8 +869,8 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name and value of an MPI IO request */
 #define DUMPIO_REPORT_REQUEST(TTAG) do {                       \
-  fprintf(dumpfh, "MPIO_Request " #TTAG "=");                           \
-  print_requests(&(prm->TTAG), 1);                            \
+  D2A_LIT(D2A_OUT, "MPIO_Request " #TTAG "=");                 \
+  print_requests(D2A_OUT, &(prm->TTAG), 1);                    \
 } while(0)
 #ifndef REPORT_DUMPIO_REQUEST
 #define REPORT_DUMPIO_REQUEST DUMPIO_REPORT_REQUEST
@@ -698,8 +878,10 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name and values of an array of MPI IO requests */
 #define DUMPIO_REPORT_REQUEST_ARRAY_1(COUNT, TTAG) do {       \
-    fprintf(dumpfh, "MPIO_Request " #TTAG "[%d]=", COUNT);             \
-    print_requests(prm->TTAG, COUNT);                         \
+  D2A_LIT(D2A_OUT, "MPIO_Request " #TTAG "[");                \
+  d2a_int(D2A_OUT, COUNT);                                    \
+  D2A_LIT(D2A_OUT, "]=");                                     \
+  print_requests(D2A_OUT, prm->TTAG, COUNT);                  \
 } while(0)
 #ifndef REPORT_DUMPIO_REQUEST_ARRAY_1
 #define REPORT_DUMPIO_REQUEST_ARRAY_1 DUMPIO_REPORT_REQUEST_ARRAY_1
@@ -707,7 +889,7 @@ static inline void print_requests(const dumpi_request *req, int count) {
 
   /** Report the name, value, and description of an MPI whence variable */
 #define DUMPI_REPORT_WHENCE(TTAG) do {                              \
-    fprintf(dumpfh, "int " #TTAG "=%d (%s)\n", prm->TTAG,	            \
+  d2a_named(D2A_OUT, "int " #TTAG "=", prm->TTAG,                         \
            dumpi_get_whence_name(prm->TTAG));			    \
 } while(0)
 #ifndef REPORT_DUMPI_WHENCE
@@ -719,17 +901,22 @@ static inline void print_requests(const dumpi_request *req, int count) {
    * of a profiled function
    */
 #define DUMPI_REPORT_FUNC(FN) do {                                      \
-    int i;                                                              \
+  int i;                                                                \
   const char *name = NULL;                                              \
-  if(d2a_addr != NULL) {                                                \
-    for(i = 0; i < d2a_addr->count; ++i) {                              \
-      if(prm->FN == d2a_addr->address[i]) {                             \
-        name = d2a_addr->name[i];                                       \
+  const d2a_addrmap *addr = D2A_OUT->addr;                              \
+  if(addr != NULL) {                                                    \
+    for(i = 0; i < addr->count; ++i) {                                  \
+      if(prm->FN == addr->address[i]) {                                 \
+        name = addr->name[i];                                           \
         break;                                                          \
       }                                                                 \
     }                                                                   \
   }                                                                     \
-  fprintf(dumpfh, "int " #FN "=%lld (\"%s\")\n", (long long)prm->FN, name);      \
+  D2A_LIT(D2A_OUT, "int " #FN "=");                                     \
+  d2a_int(D2A_OUT, (long long)prm->FN);                                 \
+  D2A_LIT(D2A_OUT, " (\"");                                             \
+  d2a_puts(D2A_OUT, name);                                              \
+  D2A_LIT(D2A_OUT, "\")\n");                                            \
 } while(0)
 #ifndef REPORT_DUMPI_FUNC
 #define REPORT_DUMPI_FUNC DUMPI_REPORT_FUNC
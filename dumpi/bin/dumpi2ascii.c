@@ -54,9 +54,10 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <getopt.h>
 #include <time.h>
 #include <assert.h>
+#include <unistd.h>
+#include <pthread.h>
 
 extern int optind;
-FILE *dumpfh = NULL;
 
 /*
  * User options.
@@ -64,90 +65,277 @@ FILE *dumpfh = NULL;
 typedef struct d2aopt {
   int verbose, help;
   int read_header, read_stream, read_keyval, read_footer, read_perf;
-  int read_addresses, read_sizes;
+  int read_addresses, read_sizes, read_stats, read_matrix;
   const char *file;
+  const char *metafile, *outroot;
+  int threads;
+  /* Seconds to wait for more of a growing trace (-1 to not follow) */
+  int follow;
 } d2aopt;
 
+/*
+ * Conversion of all the traces named in a metafile.
+ * Workers pull the next rank off a shared counter.
+ */
+typedef struct d2ajobs {
+  const d2aopt *opt;
+  const libundumpi_callbacks *cback;
+  char *inprefix, *outformat;
+  int fanout, numprocs, next, failed;
+  pthread_mutex_t lock;
+} d2ajobs;
+
 static int parse_options(int argc, char **argv, d2aopt *opt);
-static void print_header(const dumpi_header *head);
-static void print_keyval(const dumpi_keyval_record *kv);
-static void print_footer(const dumpi_footer *foot);
-static void print_perflbl(const dumpi_perfinfo *pinfo);
-static void print_addresses(int count, const uint64_t *addresses,char **names);
-static void print_sizes(const dumpi_sizeof *sizes);
+static int parse_metafile(const d2aopt *opt, d2ajobs *jobs);
+static void* convert_worker(void *arg);
+static int convert(const d2aopt *opt, const libundumpi_callbacks *cback,
+                   const char *fname, FILE *fh);
+static void print_header(d2a_output *out, const dumpi_header *head);
+static void print_checkpoint(d2a_output *out, const dumpi_checkpoint *chk);
+static void follow_idle(void *uarg);
+static void print_keyval(d2a_output *out, const dumpi_keyval_record *kv);
+static void print_footer(d2a_output *out, const dumpi_footer *foot);
+static void print_perflbl(d2a_output *out, const dumpi_perfinfo *pinfo);
+static void print_addresses(d2a_output *out, int count,
+                            const uint64_t *addresses, char **names);
+static void print_sizes(d2a_output *out, const dumpi_sizeof *sizes);
+static void print_callstats(d2a_output *out, const dumpi_callstats *stats);
+static void print_commstats(d2a_output *out, const dumpi_commstats *stats);
 
 int main(int argc, char **argv) {
-  dumpi_profile *profile;
   libundumpi_callbacks cback;
   d2aopt opt;
-  dumpfh = stdout;
+  d2ajobs jobs;
+  pthread_t *workers;
+  int i, nthreads;
   
   if(parse_options(argc, argv, &opt) == 0) {
     return 1;
   }
   libundumpi_clear_callbacks(&cback);
   set_callbacks(&cback);
+
+  if(opt.metafile == NULL) {
+    return convert(&opt, &cback, opt.file, stdout);
+  }
+
+  memset(&jobs, 0, sizeof(d2ajobs));
+  jobs.opt = &opt;
+  jobs.cback = &cback;
+  if(parse_metafile(&opt, &jobs) == 0) {
+    return 2;
+  }
+  pthread_mutex_init(&jobs.lock, NULL);
+  nthreads = (opt.threads < jobs.numprocs ? opt.threads : jobs.numprocs);
+  if(nthreads < 1) nthreads = 1;
+  workers = (pthread_t*)malloc(nthreads * sizeof(pthread_t));
+  assert(workers != NULL);
+  for(i = 0; i < nthreads; ++i)
+    assert(pthread_create(&workers[i], NULL, convert_worker, &jobs) == 0);
+  for(i = 0; i < nthreads; ++i)
+    pthread_join(workers[i], NULL);
+  free(workers);
+  pthread_mutex_destroy(&jobs.lock);
+  free(jobs.inprefix);
+  free(jobs.outformat);
+  return (jobs.failed ? 2 : 0);
+}
+
+/*
+ * Convert a single trace file, writing the requested records to fh.
+ * Returns 0 on success (same as the exit status of main).
+ */
+int convert(const d2aopt *opt, const libundumpi_callbacks *cback,
+            const char *fname, FILE *fh)
+{
+  dumpi_profile *profile;
+  d2a_output out;
   
-  if((profile = undumpi_open(opt.file)) == NULL) {
+  if((profile = undumpi_open(fname)) == NULL) {
     return 2;
   }
-  if(opt.read_header) {
+  d2a_output_init(&out, fh);
+  if(opt->read_header) {
     dumpi_header *head = undumpi_read_header(profile);
-    print_header(head);
+    print_header(&out, head);
     dumpi_free_header(head);
+    if(profile->chkpt > 0) {
+      dumpi_checkpoint chk;
+      dumpi_read_checkpoint(profile, &chk);
+      print_checkpoint(&out, &chk);
+    }
   }
-  if(opt.read_stream) {
+  if(opt->read_stream) {
     int i;
-    d2a_addr = (d2a_addrmap*)calloc(1, sizeof(d2a_addrmap));
-    assert(d2a_addr != NULL);
-    dumpi_read_function_addresses(profile, &(d2a_addr->count),
-				  &(d2a_addr->address), &(d2a_addr->name));
-    undumpi_read_stream(profile, &cback, DUMPI_UARG, false);
-    for(i = 0; i < d2a_addr->count; ++i)
-      free(d2a_addr->name[i]);
-    free(d2a_addr->address);
-    free(d2a_addr->name);
-    free(d2a_addr);
-    d2a_addr = NULL;
+    d2a_addrmap addr;
+    memset(&addr, 0, sizeof(d2a_addrmap));
+    dumpi_read_function_addresses(profile, &addr.count,
+				  &addr.address, &addr.name);
+    out.addr = &addr;
+    if(opt->follow >= 0) {
+      if(! undumpi_follow_stream(profile, cback, &out, opt->follow,
+                                 follow_idle))
+        fprintf(stderr, "Gave up waiting for more of %s\n", fname);
+    }
+    else {
+      undumpi_read_stream(profile, cback, &out, false);
+    }
+    out.addr = NULL;
+    for(i = 0; i < addr.count; ++i)
+      free(addr.name[i]);
+    free(addr.address);
+    free(addr.name);
   }
-  if(opt.read_keyval) {
+  if(opt->read_keyval) {
     dumpi_keyval_record *kv = undumpi_read_keyval_record(profile);
-    print_keyval(kv);
+    print_keyval(&out, kv);
     dumpi_free_keyval_record(kv);
   }
-  if(opt.read_footer) {
+  if(opt->read_footer) {
     dumpi_footer *foot = undumpi_read_footer(profile);
-    print_footer(foot);
+    print_footer(&out, foot);
     dumpi_free_footer(foot);
   }
-  if(opt.read_perf) {
+  if(opt->read_perf) {
     dumpi_perfinfo pinfo;
     dumpi_read_perfctr_labels(profile, &pinfo.count, pinfo.counter_tag,
 			      DUMPI_MAX_PERFCTR_NAME);
-    print_perflbl(&pinfo);
+    print_perflbl(&out, &pinfo);
   }
-  if(opt.read_addresses) {
+  if(opt->read_addresses) {
     int i;
     int count = 0;
     uint64_t *addresses = NULL;
     char **names = NULL;
     dumpi_read_function_addresses(profile, &count, &addresses, &names);
-    print_addresses(count, addresses, names);
+    print_addresses(&out, count, addresses, names);
     free(addresses);
     for(i = 0; i < count; ++i)
       free(names[i]);
     free(names);
   }
-  if(opt.read_sizes) {
+  if(opt->read_sizes) {
     dumpi_sizeof sizes;
     dumpi_read_datatype_sizes(profile, &sizes);
-    print_sizes(&sizes);
+    print_sizes(&out, &sizes);
     free(sizes.size);
   }
+  /* Call statistics and the communication matrix are optional records */
+  if(opt->read_stats && profile->statslbl > 0) {
+    dumpi_callstats *stats = (dumpi_callstats*)malloc(sizeof(dumpi_callstats));
+    assert(stats != NULL);
+    dumpi_read_callstats(profile, stats);
+    print_callstats(&out, stats);
+    dumpi_free_callstats(stats);
+  }
+  if(opt->read_matrix && profile->commlbl > 0) {
+    dumpi_commstats matrix;
+    dumpi_read_commstats(profile, &matrix);
+    print_commstats(&out, &matrix);
+    dumpi_clear_commstats(&matrix);
+  }
+  d2a_output_free(&out);
+  undumpi_close(profile);
+  free(profile);
 
   return 0;
 }
 
+/* Thread body for metafile conversion */
+void* convert_worker(void *arg) {
+  d2ajobs *jobs = (d2ajobs*)arg;
+  size_t len = 2*strlen(jobs->inprefix) + strlen(jobs->outformat) + 32;
+  char *infile = (char*)malloc(len), *outfile = (char*)malloc(len);
+  assert(infile != NULL && outfile != NULL);
+  while(1) {
+    int rank;
+    FILE *fh;
+    pthread_mutex_lock(&jobs->lock);
+    rank = jobs->next++;
+    pthread_mutex_unlock(&jobs->lock);
+    if(rank >= jobs->numprocs) break;
+    dumpi_trace_filename(infile, len, jobs->inprefix, DUMPI_TRACE_WIDTH,
+                         jobs->fanout, rank);
+    snprintf(outfile, len, jobs->outformat, rank);
+    if(jobs->opt->verbose)
+      fprintf(stderr, "Converting %s to %s\n", infile, outfile);
+    /* Never replace existing files (such as reference output kept
+       next to the traces) */
+    if((fh = fopen(outfile, "wx")) == NULL) {
+      fprintf(stderr, "Error: Failed to create \"%s\": %s\n",
+              outfile, strerror(errno));
+      jobs->failed = 1;
+      continue;
+    }
+    if(convert(jobs->opt, jobs->cback, infile, fh) != 0) {
+      fprintf(stderr, "Error: Failed to convert \"%s\"\n", infile);
+      jobs->failed = 1;
+    }
+    fclose(fh);
+  }
+  free(infile);
+  free(outfile);
+  return NULL;
+}
+
+/*
+ * Read numprocs and fileprefix from the metafile.  Traces are expected
+ * next to the metafile with dumpi's default naming (prefix-%04d.bin).
+ */
+int parse_metafile(const d2aopt *opt, d2ajobs *jobs) {
+  char buf[1024], *dir, *prefix = NULL;
+  size_t len;
+  int i;
+  FILE *metafile = fopen(opt->metafile, "r");
+  if(metafile == NULL) {
+    fprintf(stderr, "Error: Failed to open metafile \"%s\" for reading: %s\n",
+	    opt->metafile, strerror(errno));
+    return 0;
+  }
+  jobs->numprocs = -1;
+  while(fgets(buf, sizeof(buf), metafile) != NULL) {
+    char *value = strchr(buf, '=');
+    if(value == NULL) continue;
+    *value++ = '\0';
+    value[strcspn(value, "\r\n")] = '\0';
+    if(strcmp(buf, "numprocs") == 0)
+      jobs->numprocs = atoi(value);
+    else if(strcmp(buf, "fileprefix") == 0 && prefix == NULL)
+      prefix = strdup(value);
+    else if(strcmp(buf, "fanout") == 0)
+      jobs->fanout = atoi(value);
+  }
+  fclose(metafile);
+  if(jobs->numprocs < 0 || prefix == NULL) {
+    fprintf(stderr, "Error: Invalid input in metafile (size or prefix)\n");
+    free(prefix);
+    return 0;
+  }
+  dir = strdup(opt->metafile);
+  for(i = strlen(dir)-1; i >= 0; --i) {
+    if(dir[i] == '/') break;
+  }
+  dir[i+1] = '\0';
+  len = strlen(dir) + strlen(prefix) + 16;
+  jobs->inprefix = (char*)malloc(len);
+  assert(jobs->inprefix != NULL);
+  snprintf(jobs->inprefix, len, "%s%s", dir, prefix);
+  if(opt->outroot != NULL) {
+    len = strlen(opt->outroot) + 16;
+    jobs->outformat = (char*)malloc(len);
+    assert(jobs->outformat != NULL);
+    snprintf(jobs->outformat, len, "%s-%%04d.txt", opt->outroot);
+  }
+  else {
+    jobs->outformat = (char*)malloc(len);
+    assert(jobs->outformat != NULL);
+    snprintf(jobs->outformat, len, "%s%s-%%04d.txt", dir, prefix);
+  }
+  free(dir);
+  free(prefix);
+  return 1;
+}
+
 /*
   int verbose, help;
   int read_header, read_stream, read_keyval, read_footer;
@@ -157,7 +345,9 @@ int parse_options(int argc, char **argv, d2aopt *settings) {
   int opt;
   assert(settings != NULL);
   memset(settings, 0, sizeof(d2aopt));
-  while((opt = getopt(argc, argv, "vhaHSKFPAXf:")) != -1) {
+  settings->threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  settings->follow = -1;
+  while((opt = getopt(argc, argv, "vhaHSKFPAXCMf:I:o:j:w:")) != -1) {
     switch(opt) {
     case 'v':
       if(settings->verbose) dumpi_debug = DUMPI_DEBUG_ALL;
@@ -170,7 +360,8 @@ int parse_options(int argc, char **argv, d2aopt *settings) {
       settings->read_header = settings->read_stream = 1;
       settings->read_keyval = settings->read_footer = 1;
       settings->read_perf = settings->read_addresses = 1;
-      settings->read_sizes = 1;
+      settings->read_sizes = settings->read_stats = 1;
+      settings->read_matrix = 1;
       break;
     case 'H':
       settings->read_header = 1; break;
@@ -186,9 +377,25 @@ int parse_options(int argc, char **argv, d2aopt *settings) {
       settings->read_addresses = 1; break;
     case 'X':
       settings->read_sizes = 1; break;
+    case 'C':
+      settings->read_stats = 1; break;
+    case 'M':
+      settings->read_matrix = 1; break;
     case 'f':
       settings->file = strdup(optarg);
       break;
+    case 'I':
+      settings->metafile = strdup(optarg);
+      break;
+    case 'o':
+      settings->outroot = strdup(optarg);
+      break;
+    case 'j':
+      settings->threads = atoi(optarg);
+      break;
+    case 'w':
+      settings->follow = atoi(optarg);
+      break;
     default:
       fprintf(stderr, "Invalid argument %c.\n", opt);
       settings->help = 1;
@@ -196,11 +403,12 @@ int parse_options(int argc, char **argv, d2aopt *settings) {
     }
     if(settings->help) {
       fprintf(stderr, 
-	      "Usage:  %s [-h] [-v] [-HSKF] [-f] filename\n"
+	      "Usage:  %s [-h] [-v] [-HSKF] [-w seconds] [-f] filename\n"
+	      "        %s [-h] [-v] [-HSKF] [-o outroot] [-j n] -I metafile\n"
 	      "   Options:\n"
 	      "        -h               Print this help\n"
 	      "        -v               Verbose status output\n"
-              "        -a               Equivalent to -HSKFPAX\n"
+              "        -a               Equivalent to -HSKFPAXCM\n"
 	      "        -H               Print header record\n"
 	      "        -S               Print stream of MPI calls (default)\n"
 	      "        -K               Print keyval record(s)\n"
@@ -208,21 +416,34 @@ int parse_options(int argc, char **argv, d2aopt *settings) {
 	      "        -P               Print PAPI counter information\n"
 	      "        -A               Print function address labels\n"
 	      "        -X               Print type sizes\n"
-	      "        -f  filename     Read the given binary tracefile\n",
-	      argv[0]);
+	      "        -C               Print call statistics (profile mode)\n"
+	      "        -M               Print communication matrix row (if recorded)\n"
+	      "        -f  filename     Read the given binary tracefile\n"
+	      "        -I  metafile     Convert every trace named in the metafile\n"
+	      "                         to outroot-NNNN.txt\n"
+	      "        -o  outroot      Output prefix for -I (default: the\n"
+	      "                         trace prefix, next to the traces);\n"
+	      "                         existing files are not overwritten\n"
+	      "        -j  n            Threads used for -I (default: one\n"
+	      "                         per online processor)\n"
+	      "        -w  seconds      Follow a trace that is still being\n"
+	      "                         written, until it is complete or\n"
+	      "                         nothing was added for this many\n"
+	      "                         seconds (0 waits forever)\n",
+	      argv[0], argv[0]);
       break;
     }
   }
-  if(settings->file == NULL && optind < argc)
+  if(settings->file == NULL && settings->metafile == NULL && optind < argc)
     settings->file = argv[optind];
   if((settings->read_header + settings->read_stream + settings->read_keyval +
       settings->read_footer + settings->read_perf + settings->read_addresses +
-      settings->read_sizes) == 0)
+      settings->read_sizes + settings->read_stats + settings->read_matrix) == 0)
     settings->read_stream = 1;
   return (settings->help == 0);
 }
 
-void print_header(const dumpi_header *head) {
+void print_header(d2a_output *out, const dumpi_header *head) {
   /*
     char      version[3];
     uint64_t  starttime;
@@ -232,68 +453,195 @@ void print_header(const dumpi_header *head) {
     int      *meshcrd;
     int      *meshsize;
   */
-  int i;
+  char timebuf[64];
   time_t timev = (time_t)head->starttime;
-  fprintf(dumpfh, "version=%d.%d.%d\n"
-	  "starttime=%s"
-	  "hostname=%s\n"
-	  "username=%s\n"
-	  "meshdim=%d\n",
-	  head->version[0], head->version[1], head->version[2],
-	  ctime(&timev), head->hostname, head->username, head->meshdim);
-  fprintf(dumpfh, "meshsize=[");
-  for(i = 0; i < head->meshdim; ++i) {
-    fprintf(dumpfh, "%d", head->meshsize[i]);
-    if(i < (head->meshdim-1)) fprintf(dumpfh, ", ");
-  }
-  fprintf(dumpfh, "]\n");
-  fprintf(dumpfh, "meshcrd=[");
-  for(i = 0; i < head->meshdim; ++i) {
-    fprintf(dumpfh, "%d", head->meshcrd[i]);
-    if(i < (head->meshdim-1)) fprintf(dumpfh, ", ");
-  }
-  fprintf(dumpfh, "]\n");
+  D2A_LIT(out, "version=");
+  d2a_int(out, head->version[0]);
+  d2a_putc(out, '.');
+  d2a_int(out, head->version[1]);
+  d2a_putc(out, '.');
+  d2a_int(out, head->version[2]);
+  D2A_LIT(out, "\nstarttime=");
+  d2a_puts(out, ctime_r(&timev, timebuf));
+  D2A_LIT(out, "hostname=");
+  d2a_puts(out, head->hostname);
+  D2A_LIT(out, "\nusername=");
+  d2a_puts(out, head->username);
+  D2A_LIT(out, "\nmeshdim=");
+  d2a_int(out, head->meshdim);
+  D2A_LIT(out, "\nmeshsize=");
+  print_ints(out, head->meshsize, head->meshdim);
+  D2A_LIT(out, "meshcrd=");
+  print_ints(out, head->meshcrd, head->meshdim);
+}
+
+void print_checkpoint(d2a_output *out, const dumpi_checkpoint *chk) {
+  D2A_LIT(out, "incomplete=");
+  d2a_uint64(out, chk->records);
+  D2A_LIT(out, " records up to offset ");
+  d2a_uint64(out, (uint64_t)chk->position);
+  D2A_LIT(out, " wall_sec=");
+  d2a_int(out, chk->wall.sec);
+  D2A_LIT(out, " wall_nsec=");
+  d2a_int(out, chk->wall.nsec);
+  d2a_putc(out, '\n');
+}
+
+void follow_idle(void *uarg) {
+  d2a_flush(D2A_OUT);
+  fflush(D2A_OUT->fh);
 }
 
-void print_keyval(const dumpi_keyval_record *kv) {
+void print_keyval(d2a_output *out, const dumpi_keyval_record *kv) {
   dumpi_keyval_entry *curr;
   assert(kv != NULL);
-  fprintf(dumpfh, "Total keyvals: %d\n", kv->count);
+  D2A_LIT(out, "Total keyvals: ");
+  d2a_int(out, kv->count);
+  d2a_putc(out, '\n');
   curr = kv->head;
   while(curr) {
-    fprintf(dumpfh, "%s=%s\n", curr->key, curr->val);
+    d2a_puts(out, curr->key);
+    d2a_putc(out, '=');
+    d2a_puts(out, curr->val);
+    d2a_putc(out, '\n');
     curr = curr->next;
   }
 }
 
-void print_footer(const dumpi_footer *foot) {
+void print_footer(d2a_output *out, const dumpi_footer *foot) {
   int i;
   assert(foot != NULL);
   for(i = 0; i <= DUMPI_ALL_FUNCTIONS; ++i) {
-    fprintf(dumpfh, "%s called %d times and ignored %d times\n",
-	    dumpi_function_names[i], foot->call_count[i],
-	    foot->ignored_count[i]);
+    d2a_puts(out, dumpi_function_names[i]);
+    D2A_LIT(out, " called ");
+    d2a_int(out, foot->call_count[i]);
+    D2A_LIT(out, " times and ignored ");
+    d2a_int(out, foot->ignored_count[i]);
+    D2A_LIT(out, " times\n");
   }
 }
 
-void print_perflbl(const dumpi_perfinfo *pinfo) {
+void print_perflbl(d2a_output *out, const dumpi_perfinfo *pinfo) {
   int i;
-  fprintf(dumpfh, "Performance counters: %d\n", pinfo->count);
-  for(i = 0; i < pinfo->count; ++i)
-    fprintf(dumpfh, "    %s\n", pinfo->counter_tag[i]);
+  D2A_LIT(out, "Performance counters: ");
+  d2a_int(out, pinfo->count);
+  d2a_putc(out, '\n');
+  for(i = 0; i < pinfo->count; ++i) {
+    D2A_LIT(out, "    ");
+    d2a_puts(out, pinfo->counter_tag[i]);
+    d2a_putc(out, '\n');
+  }
 }
 
-void print_addresses(int count, const uint64_t *addresses, char **names)
+void print_addresses(d2a_output *out, int count, const uint64_t *addresses,
+                     char **names)
 {
   int i;
   for(i = 0; i < count; ++i) {
-    fprintf(dumpfh, "Function address %" PRIu64 " has label %s\n", addresses[i], names[i]);
+    D2A_LIT(out, "Function address ");
+    d2a_uint64(out, addresses[i]);
+    D2A_LIT(out, " has label ");
+    d2a_puts(out, names[i]);
+    d2a_putc(out, '\n');
   }
 }
 
-void print_sizes(const dumpi_sizeof *sizes) {
+void print_sizes(d2a_output *out, const dumpi_sizeof *sizes) {
   int i;
-  for(i = 0; i < sizes->count; ++i)
-    fprintf(dumpfh, "Datatype %d (%s) has size %d\n",
-	   i, dumpi_get_datatype_name(i), sizes->size[i]);
+  for(i = 0; i < sizes->count; ++i) {
+    D2A_LIT(out, "Datatype ");
+    d2a_int(out, i);
+    D2A_LIT(out, " (");
+    d2a_puts(out, dumpi_get_datatype_name(i));
+    D2A_LIT(out, ") has size ");
+    d2a_int(out, sizes->size[i]);
+    d2a_putc(out, '\n');
+  }
+}
+
+/* Print the value range covered by a call statistics histogram bucket */
+static void print_bucket(d2a_output *out, const char *label, int bucket,
+                         uint64_t count)
+{
+  D2A_LIT(out, "    ");
+  d2a_puts(out, label);
+  d2a_putc(out, ' ');
+  if(bucket == 0) {
+    d2a_putc(out, '0');
+  }
+  else {
+    d2a_uint64(out, 1ULL << (bucket-1));
+    if(bucket == DUMPI_CALLSTATS_BUCKETS-1) {
+      d2a_putc(out, '+');
+    }
+    else {
+      d2a_putc(out, '-');
+      d2a_uint64(out, (1ULL << bucket) - 1);
+    }
+  }
+  D2A_LIT(out, ": ");
+  d2a_uint64(out, count);
+  d2a_putc(out, '\n');
+}
+
+void print_callstats(d2a_output *out, const dumpi_callstats *stats) {
+  int fn, i;
+  D2A_LIT(out, "Call statistics from ");
+  d2a_int(out, stats->threads);
+  D2A_LIT(out, " thread(s)\n");
+  for(fn = 0; fn < DUMPI_ALL_FUNCTIONS; ++fn) {
+    const dumpi_callstats_entry *entry = &stats->entry[fn];
+    if(entry->count == 0)
+      continue;
+    d2a_puts(out, dumpi_function_names[fn]);
+    D2A_LIT(out, " count=");
+    d2a_uint64(out, entry->count);
+    D2A_LIT(out, " total_ns=");
+    d2a_uint64(out, entry->total_ns);
+    D2A_LIT(out, " min_ns=");
+    d2a_uint64(out, entry->min_ns);
+    D2A_LIT(out, " max_ns=");
+    d2a_uint64(out, entry->max_ns);
+    D2A_LIT(out, " bytes=");
+    d2a_uint64(out, entry->bytes);
+    d2a_putc(out, '\n');
+    for(i = 0; i < DUMPI_CALLSTATS_BUCKETS; ++i)
+      if(entry->time_hist[i])
+        print_bucket(out, "time_ns", i, entry->time_hist[i]);
+    if(entry->bytes > 0)
+      for(i = 0; i < DUMPI_CALLSTATS_BUCKETS; ++i)
+        if(entry->size_hist[i])
+          print_bucket(out, "bytes", i, entry->size_hist[i]);
+  }
+}
+
+void print_commstats(d2a_output *out, const dumpi_commstats *stats) {
+  int i;
+  D2A_LIT(out, "Communication matrix for rank ");
+  d2a_int(out, stats->rank);
+  D2A_LIT(out, " (");
+  d2a_int(out, stats->peers);
+  D2A_LIT(out, " peer(s), ");
+  d2a_int(out, stats->colls);
+  D2A_LIT(out, " communicator(s))\n");
+  for(i = 0; i < stats->peers; ++i) {
+    D2A_LIT(out, "send peer=");
+    d2a_int(out, stats->peer[i].peer);
+    D2A_LIT(out, " messages=");
+    d2a_uint64(out, stats->peer[i].messages);
+    D2A_LIT(out, " bytes=");
+    d2a_uint64(out, stats->peer[i].bytes);
+    d2a_putc(out, '\n');
+  }
+  for(i = 0; i < stats->colls; ++i) {
+    D2A_LIT(out, "collective size=");
+    d2a_int(out, stats->coll[i].size);
+    D2A_LIT(out, " leader=");
+    d2a_int(out, stats->coll[i].leader);
+    D2A_LIT(out, " calls=");
+    d2a_uint64(out, stats->coll[i].calls);
+    D2A_LIT(out, " bytes=");
+    d2a_uint64(out, stats->coll[i].bytes);
+    d2a_putc(out, '\n');
+  }
 }
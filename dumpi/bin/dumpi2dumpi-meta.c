@@ -76,6 +76,7 @@ int d2d_parse_metadata(const d2dopts *opt, d2dmeta *meta) {
   assert(opt != NULL);
   assert(meta != NULL);
   memset(meta, 0, sizeof(d2dmeta));
+  meta->fanout = -1;
   dir = strdup(opt->metafile);
   for(i = strlen(dir)-1; i > 0; --i) {
     if(dir[i] == '/') break;
@@ -123,6 +124,7 @@ int d2d_parse_metadata(const d2dopts *opt, d2dmeta *meta) {
       else if(strcmp(key, "hostname") == 0) meta->hostname = strdup(value);
       else if(strcmp(key, "username") == 0) meta->username = strdup(value);
       else if(strcmp(key, "startime")== 0) meta->starttime= strdup(value);
+      else if(strcmp(key, "fanout") == 0) meta->fanout = get_int(value, &error);
       if(error) goto escape_hatch;
     }
   }
@@ -132,11 +134,18 @@ int d2d_parse_metadata(const d2dopts *opt, d2dmeta *meta) {
     error = 8;
     goto escape_hatch;
   }
-  /* Figure out the fully qualified format for the input files */
+  /* Figure out the fully qualified prefix for the input files */
+  snprintf(buf, DUMPI_BLEN, "%s%s%s", dir, (*dir != '\0' ? "/" : ""), prefix);
+  meta->traceprefix = strdup(buf);
+  if(meta->fanout >= 0) {
+    /* Newer metafiles give the layout of the trace files */
+    meta->tracewidth = DUMPI_TRACE_WIDTH;
+    meta->maxname = 2 * strlen(meta->traceprefix) + DUMPI_TRACE_WIDTH + 50;
+  }
   /* We assume that the user has not opted for more than 500 digits
    * to write the node rank (otherwise, the user is a twit) */
   /* We start by searching at %04d, since that is the default from dumpi */
-  for(zeroes = 0; zeroes < 500; ++zeroes) {
+  for(zeroes = 0; zeroes < 500 && meta->maxname == 0; ++zeroes) {
     int all_found = 1;
     int fmtw = (zeroes+4)%500;
     FILE *tmpf;
@@ -144,8 +153,7 @@ int d2d_parse_metadata(const d2dopts *opt, d2dmeta *meta) {
       continue; /* we simply skip names that would overflow our boundaryx */
     }
     for(i = 0; i < meta->size; ++i) {
-      snprintf(buf, DUMPI_BLEN, "%s%s%s-%0*d.bin",
-	       dir, (*dir != '\0' ? "/" : ""), prefix, fmtw, i);
+      dumpi_trace_filename(buf, DUMPI_BLEN, meta->traceprefix, fmtw, 0, i);
       if((tmpf = fopen(buf, "r")) == NULL) {
 	all_found = 0;
 	break;
@@ -156,15 +164,13 @@ int d2d_parse_metadata(const d2dopts *opt, d2dmeta *meta) {
     }
     if(all_found) {
       /* this is the format we want. */
-      snprintf(buf, DUMPI_BLEN, "%s%s%s-%%0%dd.bin",
-	       dir, (*dir != '\0' ? "/" : ""), prefix, fmtw);
-      meta->traceformat = strdup(buf);
-      meta->maxname = strlen(dir) + 1 + strlen(prefix) + fmtw + 50;
-      break;
+      meta->fanout = 0;
+      meta->tracewidth = fmtw;
+      meta->maxname = strlen(meta->traceprefix) + fmtw + 50;
     }
   }
   /* Did we find the inroot? */
-  if(! meta->traceformat) {
+  if(meta->maxname == 0) {
     fprintf(stderr, "Error:  Failed to find a set of trace files with "
 	    "the common file prefix %s\n", prefix);
     error = 9;
@@ -176,9 +182,9 @@ int d2d_parse_metadata(const d2dopts *opt, d2dmeta *meta) {
   if(len > meta->maxname) meta->maxname = len;
   meta->outformat = strdup(buf);
   if(opt->verbose)
-    fprintf(stderr, "  Full input file format string: %s\n"
+    fprintf(stderr, "  Full input file prefix: %s (fanout %d)\n"
 	    "  Full output file format string: %s\n",
-	    meta->traceformat, meta->outformat);
+	    meta->traceprefix, meta->fanout, meta->outformat);
   /* Clean up, clean up, everybody everywhere */
   free(dir);
   free(prefix);
@@ -205,6 +211,7 @@ int d2d_write_metadata(const d2dopts *opt, const d2dmeta *meta) {
   fprintf(mfile, "username=%s\n", meta->username);
   fprintf(mfile, "startime=%s\n", meta->starttime);
   fprintf(mfile, "fileprefix=%s\n", opt->outfile);
+  fprintf(mfile, "fanout=0\n");
   fprintf(mfile, "version=%d\n", (int)dumpi_version);
   fprintf(mfile, "subversion=%d\n", (int)dumpi_subversion);
   fprintf(mfile, "subsubversion=%d\n", (int)dumpi_subsubversion);  
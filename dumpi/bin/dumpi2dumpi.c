@@ -66,7 +66,8 @@ int main(int argc, char **argv) {
     ifname = (char*)malloc(meta.maxname);
     ofname = (char*)malloc(meta.maxname);
     for(rank = 0; rank < meta.size; ++rank) {
-      snprintf(ifname, meta.maxname, meta.traceformat, rank);
+      dumpi_trace_filename(ifname, meta.maxname, meta.traceprefix,
+			   meta.tracewidth, meta.fanout, rank);
       snprintf(ofname, meta.maxname, meta.outformat, rank);
       if(opt.verbose) {
 	fprintf(stderr, "  Processing rank %d\n"
@@ -46,6 +46,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #define DUMPI_BIN_DUMPI2DUMPI_H
 
 #include <dumpi/common/types.h>
+#include <dumpi/common/io.h>
 #include <dumpi/libundumpi/callbacks.h>
 
 #ifdef __cplusplus
@@ -80,8 +81,10 @@ extern "C" {
   typedef struct d2dmeta {
     /** The total number of nodes (numprocs in the input/output metafiles */
     int size;
-    /** The format std::string for input trace files (complete with %0xd). */
-    char *traceformat;
+    /** Input trace files are named as in dumpi_trace_filename. */
+    char *traceprefix;
+    int tracewidth;
+    int fanout;
     /** The format std::string for output trace files */
     char *outformat;
     /** The longest tracefile name encountered for input or output */
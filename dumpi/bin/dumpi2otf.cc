@@ -50,21 +50,46 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <string>
 #include <vector>
 #include <stdio.h> // ftello
+#include <stdlib.h>
+#include <unistd.h>
 #include <getopt.h>
 
 namespace dumpi {
 
   // Options.
   struct d2oopt {
-    d2oopt() : verbose(0), help(0) {}
+    d2oopt() : verbose(0), help(0) {
+      writer.threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
 
     int verbose, help;
     std::string metafile, outroot;
+    otfwriter::options writer;
   };
 
   static void parse_options(int argc, char **argv, d2oopt &opt);
   static void print_help(int argc, char **argv, d2oopt &opt);
 
+  // Only these calls make a trace block on other ranks during preparse.
+  static bool creates_communicators(const metadata &meta) {
+    for(int i = 0; i < meta.numTraces(); ++i) {
+      dumpi_profile *profile = undumpi_open(meta.tracename(i).c_str());
+      if(! profile)
+        throw "creates_communicators:  Failed to open trace.";
+      bool creates = true;   // without a footer we cannot tell
+      if(profile->footer > 0) {
+        dumpi_footer *footer = undumpi_read_footer(profile);
+        creates = (footer->call_count[DUMPI_Comm_dup] ||
+                   footer->call_count[DUMPI_Comm_create] ||
+                   footer->call_count[DUMPI_Comm_split]);
+        dumpi_free_footer(footer);
+      }
+      undumpi_close(profile);
+      if(creates) return true;
+    }
+    return false;
+  }
+
   int realmain(int argc, char **argv) {
     if(argc < 2) {
       std::cerr << "Usage: " << argv[0] << " infile.meta\n";
@@ -94,27 +119,37 @@ namespace dumpi {
     // This also constructs COMM_WORLD for us.
     sharedstate shared(meta.numTraces());
 
-    // Open traces.
-    if(opt.verbose) std::cout << "Pre-parsing traces.\n";
+    // Open traces.  The preparse only has to run ahead of the conversion
+    // when ranks must agree on new communicators; otherwise each trace is
+    // preparsed by the thread that converts it.
     std::vector<trace> traces(meta.numTraces());
-    preparse_traces(meta, &shared, traces);
-    // and now we should have all the preparse state we could wish for
-    // ...do whatever we want with the preparse data.
+    sharedstate *deferred = NULL;
+    if(creates_communicators(meta)) {
+      if(opt.verbose) std::cout << "Pre-parsing traces.\n";
+      preparse_traces(meta, &shared, traces);
+    }
+    else {
+      if(opt.verbose) std::cout << "No communicator creation; single pass.\n";
+      deferred = &shared;
+    }
     if(opt.verbose) std::cout << "Converting DUMPI traces to OTF.\n";
-    otfwriter writer(opt.outroot.c_str());
-    writer.write(meta, traces);
+    otfwriter writer(opt.outroot.c_str(), opt.writer);
+    writer.write(meta, traces, deferred);
     // Done.
     return 0;
   }
 
   void parse_options(int argc, char **argv, d2oopt &opt) {
     int optid;
-    while((optid = getopt(argc, argv, "vhf:o:")) != -1) {
+    while((optid = getopt(argc, argv, "vhf:o:j:F:B:")) != -1) {
       switch(optid) {
       case 'v': opt.verbose = 1; break;
       case 'h': opt.help = 1; break;
       case 'f': opt.metafile = optarg; break;
       case 'o': opt.outroot = optarg; break;
+      case 'j': opt.writer.threads = atoi(optarg); break;
+      case 'F': opt.writer.max_files = atoi(optarg); break;
+      case 'B': opt.writer.buffer_size = atoi(optarg); break;
       }
     }
     if(opt.metafile == "" && optind < argc) {
@@ -127,12 +162,18 @@ namespace dumpi {
   }
 
   void print_help(int, char **argv, d2oopt &opt) {
-    std::cout << "Usage:  " << argv[0] << " [-h] [-v] -f metafile -o outroot\n"
+    std::cout << "Usage:  " << argv[0] << " [-h] [-v] [-j threads] [-F files] [-B bytes]"
+              << " -f metafile -o outroot\n"
               << "   Options:\n"
               << "        -h             Print this help\n"
               << "        -v             Verbose status output\n"
               << "        -f  metafile   Read traces based on the given metafile\n"
-              << "        -o  outroot    Write OTF files to the given fileroot\n";
+              << "        -o  outroot    Write OTF files to the given fileroot\n"
+              << "        -j  threads    Convert this many ranks at once (default: all cores)\n"
+              << "        -F  files      Open file limit per OTF stream (default "
+              << opt.writer.max_files << ")\n"
+              << "        -B  bytes      Write buffer size per OTF stream (default "
+              << opt.writer.buffer_size << ")\n";
   }
 
 } // end of namespace dumpi
@@ -44,15 +44,24 @@ Questions? Contact sst-macro-help@sandia.gov
 #ifndef DUMPI2OTF2_H
 #define DUMPI2OTF2_H
 
-#include <dumpi/libundumpi/callbacks.h>
+#include <dumpi/common/types.h>
 #include <dumpi/libotf2dump/otf2writer.h>
 #include <string>
 #include <vector>
 
+/** Replay a whole trace into the writer (second pass). */
+void read_second_pass(dumpi_profile *profile, dumpi::OTF2_Writer *writer,
+                      bool print_progress);
+
+/**
+ * Feed communicator and group construction to the writer (first pass)
+ * until the trace blocks on a pending communicator or runs out.
+ * \return 1 if the stream is still active.
+ */
+int read_first_pass(dumpi_profile *profile, dumpi::OTF2_Writer *writer,
+                    int *mpi_finalized);
+
 extern "C" {
-  /** Define all our callbacks. */
-  void set_callbacks(libundumpi_callbacks *cbacks);
-  void set_first_pass_callbacks(libundumpi_callbacks *cbacks);
 
   /**
    * Program options struct.
@@ -46,14 +46,19 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/libundumpi/libundumpi.h>
 #include <dumpi/libotf2dump/otf2writer.h>
 #include <dumpi/bin/metadata.h>
-#include <dumpi/libundumpi/bindings.h>
 
 #include <glob.h>
+#include <sys/resource.h>
 #include <string.h>
 #include <getopt.h>
 #include <assert.h>
 #include <cstdlib>
 #include <algorithm>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
 
 static int parse_cli_options(int argc, char **argv, d2o2opt *opt);
 static std::vector<std::string> glob_files(const char* path);
@@ -63,9 +68,6 @@ static void mk_archive_dir(const char* path);
 static void print_usage();
 static std::vector<int> get_type_sizes(dumpi_profile*);
 
-/** These are stateless lambdas and can be global variables */
-static libundumpi_callbacks first_pass_cback, second_cback;
-
 int run_second_pass(dumpi::OTF2_Writer& writer, int rank, dumpi::metadata& md,
                     int terminate_percent)
 {
@@ -75,7 +77,7 @@ int run_second_pass(dumpi::OTF2_Writer& writer, int rank, dumpi::metadata& md,
   if (terminate_percent < 100){
     profile->terminate_pos = (profile->total_file_size * terminate_percent) / 100;
   }
-  undumpi_read_stream(profile, &second_cback, (void*)&writer, true);
+  read_second_pass(profile, &writer, true);
   undumpi_close(profile);
   return 0;
 }
@@ -83,6 +85,7 @@ int run_second_pass(dumpi::OTF2_Writer& writer, int rank, dumpi::metadata& md,
 struct active_profile {
   dumpi_profile* profile;
   dumpi::OTF2_Writer* writer;
+  int finalized;
 };
 
 static int add_new_comm(int global_id_offset, std::vector<active_profile>& creators)
@@ -100,8 +103,12 @@ static int add_new_comm(int global_id_offset, std::vector<active_profile>& creat
     std::map<int, std::vector<dumpi::OTF2_Writer*>> color_map;
     for (active_profile& prof : creators){
       dumpi::OTF2_MPI_Comm::shared_ptr comm = prof.writer->pending_comm();
-      if (comm->color != DUMPI_UNDEFINED)
+      //colors are traced as raw MPI values, so MPI_UNDEFINED shows up as
+      //the library's own (negative) constant rather than DUMPI_UNDEFINED
+      if (comm->color >= 0)
         color_map[comm->color].emplace_back(prof.writer);
+      else
+        prof.writer->clear_pending_comm(); //gets MPI_COMM_NULL, nothing to build
     }
 
     auto sorter = [](const dumpi::OTF2_Writer* lw, const dumpi::OTF2_Writer* rw){
@@ -124,9 +131,11 @@ static int add_new_comm(int global_id_offset, std::vector<active_profile>& creat
         comm->global_id = next_id;
       }
 
+      //every member's group shares this one membership list
+      auto members = dumpi::OTF2RankListTable::global().intern(std::move(global_ranks));
       for (dumpi::OTF2_Writer* writer : vec){
         dumpi::OTF2_MPI_Comm::shared_ptr comm = writer->pending_comm();
-        dumpi::OTF2_MPI_Group::shared_ptr group = writer->make_comm_split(comm, global_ranks);
+        dumpi::OTF2_MPI_Group::shared_ptr group = writer->make_comm_split(comm, members);
         comm->group = group;
         group->global_id = writer->global_group_id_from_comm_id(comm->global_id);
         writer->clear_pending_comm();
@@ -147,18 +156,74 @@ static int add_new_comm(int global_id_offset, std::vector<active_profile>& creat
   }
 }
 
+// Calls the first pass has to see.  A rank whose footer shows none of them
+// can skip the first pass entirely.
+static const dumpi_function first_pass_calls[] = {
+  DUMPI_Comm_group, DUMPI_Group_union, DUMPI_Group_intersection,
+  DUMPI_Group_difference, DUMPI_Group_incl, DUMPI_Group_excl,
+  DUMPI_Group_range_incl, DUMPI_Group_range_excl,
+  DUMPI_Comm_dup, DUMPI_Comm_create, DUMPI_Comm_split
+};
+
+static bool needs_first_pass(dumpi_profile* profile)
+{
+  if (profile->footer <= 0) return true; //no footer, no way to tell
+  dumpi_footer* footer = undumpi_read_footer(profile);
+  bool needed = false;
+  for (dumpi_function func : first_pass_calls){
+    if (footer->call_count[func] || footer->ignored_count[func]) needed = true;
+  }
+  dumpi_free_footer(footer);
+  return needed;
+}
+
+/**
+ * Advance each of the given ranks through the first pass until it blocks on
+ * a communicator collective or its stream ends.  Ranks only touch their own
+ * profile and writer here, so they are spread over worker threads.
+ * \return for each rank whether its stream is still active.
+ */
+static std::vector<char> advance_first_pass(std::vector<active_profile*>& ranks)
+{
+  std::vector<char> stream_active(ranks.size(), 0);
+  size_t nthread = std::thread::hardware_concurrency();
+  if (nthread < 1) nthread = 1;
+  if (nthread > ranks.size()) nthread = ranks.size();
+
+  std::atomic<size_t> next(0);
+  std::exception_ptr error;
+  std::mutex error_lock;
+  auto work = [&](){
+    size_t i;
+    while ((i = next++) < ranks.size()){
+      active_profile* active = ranks[i];
+      try {
+        stream_active[i] = read_first_pass(active->profile, active->writer, &active->finalized)
+                        && active->profile->pos < active->profile->terminate_pos;
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_lock);
+        if (!error) error = std::current_exception();
+      }
+    }
+  };
+
+  if (nthread == 1){
+    work();
+  } else {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < nthread; ++t) workers.push_back(std::thread(work));
+    for (std::thread& t : workers) t.join();
+  }
+  if (error) std::rethrow_exception(error);
+  return stream_active;
+}
+
 int main(int argc, char **argv)
 {
   d2o2opt opt;
-  dumpi::OTF2_Writer writer;
 
   if(parse_cli_options(argc, argv, &opt) != 0) return 1;
 
-  libundumpi_clear_callbacks(&first_pass_cback);
-  libundumpi_clear_callbacks(&second_cback);
-  set_first_pass_callbacks(&first_pass_cback);
-  set_callbacks(&second_cback);
-
   if (opt.dumpi_meta.empty()){
     fprintf(stderr, "Must specify input DUMPI meta file (-i)\n");
     return 1;
@@ -168,8 +233,9 @@ int main(int argc, char **argv)
 
   std::vector<dumpi::OTF2_Writer> writers(md.numTraces());
 
-  // Initialize the writer
-  writer.set_verbosity(opt.verbose ? dumpi::OWV_INFO : dumpi::OWV_WARN);
+  // Initialize the writers
+  for (dumpi::OTF2_Writer& writer : writers)
+    writer.set_verbosity(opt.verbose ? dumpi::OWV_INFO : dumpi::OWV_WARN);
 
 
   // Loop over trace files. Dumpi creates one trace file per MPI rank
@@ -177,6 +243,7 @@ int main(int argc, char **argv)
   if (opt.print_progress) printf("Identifying Communicators, Groups, and types\n");
 
   std::vector<active_profile> active_profiles(md.numTraces());
+  std::vector<active_profile*> runnable;
   for (int rank=0; rank < md.numTraces(); ++rank){
     dumpi::OTF2_Writer& writer = writers[rank];
     writer.set_write_global_comms(true); //remapping will not work - ids get reused
@@ -194,70 +261,77 @@ int main(int argc, char **argv)
       throw std::runtime_error("failed opening trace " + trace_file);
     }
     active.writer = &writer;
+    active.finalized = 0;
 
     // this has to come here after undumpi_open
     register_type_sizes(active.profile, &writer);
 
+    if (!needs_first_pass(active.profile)){
+      undumpi_close(active.profile);
+      continue;
+    }
+    if (opt.percent < 100){
+      active.profile->terminate_pos = (active.profile->terminate_pos * opt.percent) / 100;
+    }
     dumpi_start_stream_read(active.profile);
+    runnable.push_back(&active);
   }
 
-  std::map<int, std::vector<active_profile>> pending_comm_creates;
+  if (opt.print_progress){
+    std::cout << md.numTraces() - runnable.size()
+              << " ranks build no communicators and skip the first pass" << std::endl;
+  }
 
-  int num_finished = 0;
-  int finalized;
+  // Ranks blocked in a communicator collective, keyed by the global id of
+  // the parent communicator.  A collective completes once every rank of the
+  // parent has arrived, and only those ranks are woken.  Collectives are
+  // completed in parent id order after each round so that new communicator
+  // ids do not depend on thread timing.
+  std::map<int, std::vector<active_profile>> pending_comm_creates;
   int comm_id_counter = dumpi::OTF2_Writer::MPI_COMM_USER_ID_OFFSET;
-  libundumpi_cbpair first_pass_callarr[DUMPI_END_OF_STREAM] = {{NULL, NULL}};
-  libundumpi_populate_callbacks(&first_pass_cback, first_pass_callarr);
 
   std::cout << "Executing first pass to construct communicators" << std::endl;
 
-  while(num_finished < md.numTraces()){
-    if (active_profiles.empty()){
-      for (auto iter = pending_comm_creates.begin(); iter != pending_comm_creates.end(); ++iter){
-        int num_created = add_new_comm(comm_id_counter, iter->second);
-        if (num_created > 0){
-          auto& collective_profiles = iter->second;
-          active_profiles.insert(active_profiles.end(),
-                                 collective_profiles.begin(), collective_profiles.end());
-          pending_comm_creates.erase(iter);
-          comm_id_counter += num_created;
-          std::cout << comm_id_counter << " communicators constructed " << std::endl;
-          break;
-        }
-      }
-    } else {
-      active_profile active = active_profiles.back();
-      active_profiles.pop_back();
-
-      if (active.writer->pending_comm()){
-        std::cerr << "Rank " << active.writer->world_rank()
-              << " has pending comm but is still in active list " << std::endl;
-        abort();
-      }
+  while (!runnable.empty()){
+    std::vector<char> stream_active = advance_first_pass(runnable);
 
-      int stream_active = 1;
-      if (opt.percent < 100){
-        active.profile->terminate_pos = (active.profile->terminate_pos * opt.percent) / 100;
-      }
-      while (!active.writer->pending_comm()
-             && stream_active
-             && active.profile->pos < active.profile->terminate_pos){
-        stream_active = undumpi_read_single_call(active.profile, first_pass_callarr, active.writer,
-                                            &finalized);
-      }
-
-      if (stream_active && active.profile->pos < active.profile->terminate_pos){
+    std::set<int> arrivals;
+    for (size_t i = 0; i < runnable.size(); ++i){
+      active_profile* active = runnable[i];
+      if (stream_active[i]){
         //we have more calls, but progress has stalled on a collective
-        int global_id = active.writer->pending_comm()->parent->global_id;
-        pending_comm_creates[global_id].push_back(active);
+        int global_id = active->writer->pending_comm()->parent->global_id;
+        pending_comm_creates[global_id].push_back(*active);
+        arrivals.insert(global_id);
       } else {
         //nope, stream is over
-        undumpi_close(active.profile);
-        ++num_finished;
+        undumpi_close(active->profile);
       }
     }
+
+    runnable.clear();
+    for (int global_id : arrivals){
+      auto iter = pending_comm_creates.find(global_id);
+      auto& creators = iter->second;
+      dumpi::OTF2_MPI_Comm::shared_ptr first = creators[0].writer->pending_comm();
+      if (first->parent->group->size() > creators.size()){
+        continue; //still waiting on other ranks
+      }
+      int num_created = add_new_comm(comm_id_counter, creators);
+      comm_id_counter += num_created;
+      if (opt.print_progress){
+        std::cout << comm_id_counter << " communicators constructed " << std::endl;
+      }
+      for (active_profile& prof : creators){
+        runnable.push_back(&active_profiles[prof.writer->world_rank()]);
+      }
+      pending_comm_creates.erase(iter);
+    }
   }
 
+  if (!pending_comm_creates.empty()){
+    throw std::runtime_error("first pass ended with ranks still waiting on a communicator collective");
+  }
 
   std::cout << "Executing second pass to build traces" << std::endl;
 
@@ -266,6 +340,7 @@ int main(int argc, char **argv)
 
   uint64_t min_start_time = std::numeric_limits<uint64_t>::max();
   uint64_t max_stop_time = std::numeric_limits<uint64_t>::min();
+  size_t peak_requests = 0;
 
   std::vector<dumpi::OTF2_MPI_Comm::shared_ptr> unique_comms;
   int old_percent = 0;
@@ -295,10 +370,14 @@ int main(int argc, char **argv)
 
     event_counts[rank] = writer.event_count();
     writer.write_local_def_file();
+    if (rank > 0) writers[0].add_regions(writer);
     if (rank > 0) writer.close_archive(); //rank 0 is special
 
     min_start_time = std::min(min_start_time, writer.start_time());
     max_stop_time = std::max(max_stop_time, writer.stop_time());
+    peak_requests = std::max(peak_requests, writer.peak_requests());
+    //only the root comms collected above are needed from here on
+    writer.release_rank_state();
   }
 
   std::cout << "Writing definition files" << std::endl;
@@ -306,6 +385,13 @@ int main(int argc, char **argv)
   writers[0].write_global_def_file(event_counts, unique_comms,
                                    min_start_time, max_stop_time);
   writers[0].close_archive();
+
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    //ru_maxrss is in kilobytes on Linux
+    std::cout << "Peak memory: " << usage.ru_maxrss / 1024 << " MB, "
+              << "peak outstanding requests per rank: " << peak_requests << std::endl;
+  }
   return 0;
 }
 
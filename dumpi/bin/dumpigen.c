@@ -0,0 +1,805 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/common/io.h>
+#include <dumpi/common/iodefs.h>
+#include <dumpi/common/dumpiio.h>
+#include <dumpi/common/funcs.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <getopt.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+
+/*
+ * Generate a synthetic trace set (a metafile plus one binary trace per
+ * rank) through the same dumpi_write_* calls libdumpi uses.
+ *
+ * The run is a sequence of steps.  Everything all ranks have to agree on
+ * (the kind of step, communicator, peers, message sizes and the nominal
+ * start time of the step) is drawn from a generator seeded by the seed
+ * and the step number alone, so every rank can be written independently
+ * and the point-to-point traffic always matches up.  Per-rank noise
+ * (start jitter, the number of polls before a test succeeds) comes from
+ * a generator seeded by the seed and the rank.  The output only depends
+ * on the options, not on the number of worker threads.
+ *
+ * Step kinds:
+ *   p2p    Irecv from (me-shift) and Isend to (me+shift), then Waitall.
+ *   coll   One of Barrier, Bcast, Allreduce, Reduce and Alltoall.
+ *   poll   Like p2p, but completed by polling with Testall.
+ * Each step runs on MPI_COMM_WORLD or (with -g) on the communicator
+ * returned by an MPI_Comm_split of the world into contiguous groups.
+ */
+
+static struct option options[] = {
+  {"help", no_argument, NULL, 'h'},
+  {"verbose", no_argument, NULL, 'v'},
+  {"out", required_argument, NULL, 'o'},
+  {"ranks", required_argument, NULL, 'r'},
+  {"steps", required_argument, NULL, 's'},
+  {"seed", required_argument, NULL, 'S'},
+  {"mix", required_argument, NULL, 'm'},
+  {"size", required_argument, NULL, 'z'},
+  {"groups", required_argument, NULL, 'g'},
+  {"rank-threads", required_argument, NULL, 't'},
+  {"perfctrs", required_argument, NULL, 'p'},
+  {"polls", required_argument, NULL, 'P'},
+  {"compute", required_argument, NULL, 'C'},
+  {"buffer", required_argument, NULL, 'B'},
+  {"threads", required_argument, NULL, 'j'},
+  {NULL, 0, NULL, '\0'}
+};
+
+/* All generated traces start at 2020-01-01 00:00:00 UTC so that runs
+ * with the same options are byte-for-byte identical. */
+#define DUMPIGEN_EPOCH 1577836800
+
+/* Request handles (a real code reuses the same small request array) */
+#define DUMPIGEN_RECV_REQUEST DUMPI_FIRST_USER_REQUEST
+#define DUMPIGEN_SEND_REQUEST (DUMPI_FIRST_USER_REQUEST+1)
+
+/* The communicator made by the optional MPI_Comm_split */
+#define DUMPIGEN_GROUP_COMM DUMPI_FIRST_USER_COMM
+
+typedef enum genstep {
+  GEN_P2P = 0, GEN_COLL, GEN_POLL, GEN_STEP_KINDS
+} genstep;
+
+typedef enum gencoll {
+  GEN_BARRIER = 0, GEN_BCAST, GEN_ALLREDUCE, GEN_REDUCE, GEN_ALLTOALL,
+  GEN_COLL_KINDS
+} gencoll;
+
+typedef enum gendist {
+  GEN_FIXED = 0, GEN_UNIFORM, GEN_LOG
+} gendist;
+
+/* Message size distribution (bytes) */
+typedef struct gensize {
+  gendist dist;
+  uint64_t min, max;
+} gensize;
+
+typedef struct settings {
+  int help;
+  int verbose;
+  char *out;
+  int ranks;
+  long steps;
+  uint64_t seed;
+  int mix[GEN_STEP_KINDS];
+  int mixtotal;
+  gensize size;
+  int groups;
+  int rank_threads;
+  int perfctrs;
+  int polls;
+  double compute_us;
+  size_t bufsize;
+  int threads;
+  dumpi_outputs outputs;
+  dumpi_perflabel_t *perflabels;
+  dumpi_sizeof typesize;
+} settings;
+
+/* A splitmix64 generator; cheap, and good enough for a workload model */
+typedef struct genrng {
+  uint64_t state;
+} genrng;
+
+static inline uint64_t rng_next(genrng *rng) {
+  uint64_t z = (rng->state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+static inline genrng rng_create(uint64_t seed, uint64_t stream, uint64_t id) {
+  genrng rng;
+  rng.state = seed ^ (stream << 56);
+  rng.state ^= rng_next(&rng) + id;
+  rng_next(&rng);
+  return rng;
+}
+
+/* Uniform integer in [0, n) */
+static inline uint64_t rng_below(genrng *rng, uint64_t n) {
+  return (n ? rng_next(rng) % n : 0);
+}
+
+static inline uint64_t rng_size(genrng *rng, const gensize *size) {
+  uint64_t lo, hi;
+  int lobit, hibit, bit;
+  switch(size->dist) {
+  case GEN_UNIFORM:
+    return size->min + rng_below(rng, size->max - size->min + 1);
+  case GEN_LOG:
+    /* Pick an octave uniformly, then a size uniformly inside it */
+    for(lobit = 0; (2ULL << lobit) <= size->min; ++lobit) {}
+    for(hibit = lobit; (2ULL << hibit) <= size->max; ++hibit) {}
+    bit = lobit + (int)rng_below(rng, hibit - lobit + 1);
+    lo = (1ULL << bit);
+    hi = (bit < 63 ? (2ULL << bit) - 1 : ~0ULL);
+    if(lo < size->min) lo = size->min;
+    if(hi > size->max) hi = size->max;
+    return lo + rng_below(rng, hi - lo + 1);
+  default:
+    return size->min;
+  }
+}
+
+/* What every rank agrees on about one step */
+typedef struct stepinfo {
+  genstep kind;
+  gencoll coll;
+  int group;         /* 0: MPI_COMM_WORLD, 1: the split communicator */
+  uint64_t bytes;
+  uint64_t shiftsel; /* shift = 1 + shiftsel % (commsize-1) */
+  uint64_t rootsel;  /* root = rootsel % commsize */
+  int64_t compute_ns;
+} stepinfo;
+
+static void step_info(const settings *opts, long step, stepinfo *info) {
+  genrng rng = rng_create(opts->seed, 1, (uint64_t)step);
+  int pick = (int)rng_below(&rng, opts->mixtotal);
+  info->kind = GEN_P2P;
+  while(pick >= opts->mix[info->kind]) {
+    pick -= opts->mix[info->kind];
+    info->kind = (genstep)(info->kind + 1);
+  }
+  info->coll = (gencoll)rng_below(&rng, GEN_COLL_KINDS);
+  info->group = (opts->groups > 1 ? (int)rng_below(&rng, 2) : 0);
+  info->bytes = rng_size(&rng, &opts->size);
+  info->shiftsel = rng_next(&rng);
+  info->rootsel = rng_next(&rng);
+  info->compute_ns = (int64_t)(2e3 * opts->compute_us *
+                               (double)rng_below(&rng, 1000) / 1000.0);
+}
+
+/* Nominal cost of moving bytes between two ranks */
+static inline int64_t xfer_ns(uint64_t bytes) {
+  return 1000 + (int64_t)(bytes / 10);
+}
+
+/* The state of one rank while its trace is written */
+typedef struct genrank {
+  const settings *opts;
+  int rank;
+  dumpi_profile *profile;
+  dumpi_footer footer;
+  dumpi_perfinfo perf;
+  genrng rng;
+  int64_t now_ns;    /* wall clock since DUMPIGEN_EPOCH */
+  int64_t step_ns;   /* nominal start of the current step */
+  uint16_t thread;
+  int group, grank, gsize;
+} genrank;
+
+/* Stamp a call that takes duration_ns and advance the clocks. */
+static void call_times(genrank *gr, int64_t duration_ns,
+                       dumpi_time *cpu, dumpi_time *wall)
+{
+  int64_t start = gr->now_ns, stop = gr->now_ns + duration_ns;
+  int i;
+  wall->start.sec = DUMPIGEN_EPOCH + (int32_t)(start / 1000000000);
+  wall->start.nsec = (int32_t)(start % 1000000000);
+  wall->stop.sec = DUMPIGEN_EPOCH + (int32_t)(stop / 1000000000);
+  wall->stop.nsec = (int32_t)(stop % 1000000000);
+  /* The process is busy from the start of the trace on */
+  cpu->start.sec = (int32_t)(start / 1000000000);
+  cpu->start.nsec = wall->start.nsec;
+  cpu->stop.sec = (int32_t)(stop / 1000000000);
+  cpu->stop.nsec = wall->stop.nsec;
+  for(i = 0; i < gr->perf.count; ++i) {
+    gr->perf.invalue[i] = start * (i+1) / 4;
+    gr->perf.outvalue[i] = stop * (i+1) / 4;
+  }
+  gr->now_ns = stop + 100;
+}
+
+/* Write one record of type dumpi_NAME and count it in the footer. */
+#define GEN_WRITE(GR, NAME, LABEL, VAL, DURATION) do {			\
+    dumpi_time cpu_, wall_;						\
+    call_times(GR, DURATION, &cpu_, &wall_);				\
+    dumpi_write_##NAME(&(VAL), (GR)->thread, &cpu_, &wall_, &(GR)->perf, \
+                       &(GR)->opts->outputs, (GR)->profile);		\
+    ++(GR)->footer.call_count[LABEL];					\
+  } while(0)
+
+static void write_preamble(genrank *gr) {
+  const settings *opts = gr->opts;
+  static char *argv[] = {(char*)"dumpigen", NULL};
+  dumpi_comm_rank crank;
+  dumpi_comm_size csize;
+  gr->thread = 0;
+  if(opts->rank_threads > 1) {
+    dumpi_init_thread init;
+    init.argc = 1;
+    init.argv = argv;
+    init.required = init.provided = DUMPI_THREAD_MULTIPLE;
+    GEN_WRITE(gr, init_thread, DUMPI_Init_thread, init, 20000);
+  }
+  else {
+    dumpi_init init;
+    init.argc = 1;
+    init.argv = argv;
+    GEN_WRITE(gr, init, DUMPI_Init, init, 20000);
+  }
+  crank.comm = DUMPI_COMM_WORLD;
+  crank.rank = gr->rank;
+  GEN_WRITE(gr, comm_rank, DUMPI_Comm_rank, crank, 200);
+  csize.comm = DUMPI_COMM_WORLD;
+  csize.size = opts->ranks;
+  GEN_WRITE(gr, comm_size, DUMPI_Comm_size, csize, 200);
+  if(opts->groups > 1) {
+    dumpi_comm_split split;
+    split.oldcomm = DUMPI_COMM_WORLD;
+    split.color = gr->group;
+    split.key = gr->rank;
+    split.newcomm = DUMPIGEN_GROUP_COMM;
+    GEN_WRITE(gr, comm_split, DUMPI_Comm_split, split, 5000);
+    crank.comm = csize.comm = DUMPIGEN_GROUP_COMM;
+    crank.rank = gr->grank;
+    csize.size = gr->gsize;
+    GEN_WRITE(gr, comm_rank, DUMPI_Comm_rank, crank, 200);
+    GEN_WRITE(gr, comm_size, DUMPI_Comm_size, csize, 200);
+  }
+}
+
+static void write_postamble(genrank *gr) {
+  dumpi_barrier barrier;
+  dumpi_finalize fin;
+  gr->thread = 0;
+  if(gr->opts->groups > 1) {
+    dumpi_comm_free cfree;
+    cfree.comm = DUMPIGEN_GROUP_COMM;
+    GEN_WRITE(gr, comm_free, DUMPI_Comm_free, cfree, 500);
+  }
+  barrier.comm = DUMPI_COMM_WORLD;
+  GEN_WRITE(gr, barrier, DUMPI_Barrier, barrier, 5000);
+  fin.dummy = 0;
+  GEN_WRITE(gr, finalize, DUMPI_Finalize, fin, 10000);
+}
+
+static void write_exchange(genrank *gr, const stepinfo *info, long step,
+                           dumpi_comm comm, int me, int size)
+{
+  int shift = 1 + (int)(info->shiftsel % (uint64_t)(size-1));
+  int count = (int)info->bytes;
+  int tag = (int)(step & 0x7fff);
+  dumpi_request requests[2] = {DUMPIGEN_RECV_REQUEST, DUMPIGEN_SEND_REQUEST};
+  dumpi_status statuses[2];
+  dumpi_irecv irecv;
+  dumpi_isend isend;
+  irecv.count = count;
+  irecv.datatype = DUMPI_BYTE;
+  irecv.source = (me - shift + size) % size;
+  irecv.tag = tag;
+  irecv.comm = comm;
+  irecv.request = DUMPIGEN_RECV_REQUEST;
+  GEN_WRITE(gr, irecv, DUMPI_Irecv, irecv, 300);
+  isend.count = count;
+  isend.datatype = DUMPI_BYTE;
+  isend.dest = (me + shift) % size;
+  isend.tag = tag;
+  isend.comm = comm;
+  isend.request = DUMPIGEN_SEND_REQUEST;
+  GEN_WRITE(gr, isend, DUMPI_Isend, isend, 300 + (int64_t)(info->bytes/40));
+  memset(statuses, 0, sizeof(statuses));
+  statuses[0].bytes = count;
+  statuses[0].source = irecv.source;
+  statuses[0].tag = tag;
+  statuses[1].source = DUMPI_ANY_SOURCE;
+  statuses[1].tag = DUMPI_ANY_TAG;
+  if(info->kind == GEN_POLL) {
+    dumpi_testall testall;
+    int polls = (int)rng_below(&gr->rng, gr->opts->polls + 1), i;
+    testall.count = 2;
+    testall.requests = requests;
+    testall.flag = 0;
+    testall.statuses = NULL;
+    for(i = 0; i < polls; ++i)
+      GEN_WRITE(gr, testall, DUMPI_Testall, testall,
+                200 + xfer_ns(info->bytes) / (polls + 1));
+    testall.flag = 1;
+    testall.statuses = statuses;
+    GEN_WRITE(gr, testall, DUMPI_Testall, testall, 200);
+  }
+  else {
+    dumpi_waitall waitall;
+    waitall.count = 2;
+    waitall.requests = requests;
+    waitall.statuses = statuses;
+    GEN_WRITE(gr, waitall, DUMPI_Waitall, waitall, xfer_ns(info->bytes));
+  }
+}
+
+static void write_collective(genrank *gr, const stepinfo *info,
+                             dumpi_comm comm, int size)
+{
+  int count = (int)(info->bytes / 8 ? info->bytes / 8 : 1);
+  int root = (int)(info->rootsel % (uint64_t)size);
+  int64_t hops = 1, duration;
+  while((1 << hops) < size) ++hops;
+  duration = hops * xfer_ns(info->bytes);
+  switch(info->coll) {
+  case GEN_BARRIER: {
+    dumpi_barrier val;
+    val.comm = comm;
+    GEN_WRITE(gr, barrier, DUMPI_Barrier, val, hops * xfer_ns(0));
+    break;
+  }
+  case GEN_BCAST: {
+    dumpi_bcast val;
+    val.count = count;
+    val.datatype = DUMPI_DOUBLE;
+    val.root = root;
+    val.comm = comm;
+    GEN_WRITE(gr, bcast, DUMPI_Bcast, val, duration);
+    break;
+  }
+  case GEN_ALLREDUCE: {
+    dumpi_allreduce val;
+    val.count = count;
+    val.datatype = DUMPI_DOUBLE;
+    val.op = DUMPI_SUM;
+    val.comm = comm;
+    GEN_WRITE(gr, allreduce, DUMPI_Allreduce, val, 2 * duration);
+    break;
+  }
+  case GEN_REDUCE: {
+    dumpi_reduce val;
+    val.count = count;
+    val.datatype = DUMPI_DOUBLE;
+    val.op = DUMPI_SUM;
+    val.root = root;
+    val.comm = comm;
+    GEN_WRITE(gr, reduce, DUMPI_Reduce, val, duration);
+    break;
+  }
+  default: {
+    dumpi_alltoall val;
+    int per_peer = (count / size ? count / size : 1);
+    val.sendcount = val.recvcount = per_peer;
+    val.sendtype = val.recvtype = DUMPI_DOUBLE;
+    val.comm = comm;
+    GEN_WRITE(gr, alltoall, DUMPI_Alltoall, val,
+              (size - 1) * xfer_ns(8 * (uint64_t)per_peer));
+    break;
+  }
+  }
+}
+
+static void write_step(genrank *gr, long step) {
+  const settings *opts = gr->opts;
+  stepinfo info;
+  dumpi_comm comm;
+  int me, size;
+  int64_t jitter;
+  step_info(opts, step, &info);
+  /* Every rank starts the step near the same nominal time */
+  gr->step_ns += info.compute_ns;
+  jitter = (int64_t)rng_below(&gr->rng, info.compute_ns / 4 + 1);
+  if(gr->now_ns < gr->step_ns + jitter)
+    gr->now_ns = gr->step_ns + jitter;
+  gr->thread = (uint16_t)(step % opts->rank_threads);
+  if(info.group) {
+    comm = DUMPIGEN_GROUP_COMM;
+    me = gr->grank;
+    size = gr->gsize;
+  }
+  else {
+    comm = DUMPI_COMM_WORLD;
+    me = gr->rank;
+    size = opts->ranks;
+  }
+  if(info.kind == GEN_COLL)
+    write_collective(gr, &info, comm, size);
+  else if(size > 1)
+    write_exchange(gr, &info, step, comm, me, size);
+  /* Ranks that finished early wait for the slowest one */
+  gr->step_ns += 4 * xfer_ns(info.bytes);
+  if(gr->step_ns < gr->now_ns - info.compute_ns)
+    gr->step_ns = gr->now_ns - info.compute_ns;
+}
+
+/* Write the trace for one rank; returns the file size (0 on failure). */
+static off_t write_rank(const settings *opts, int rank) {
+  genrank gr;
+  dumpi_header header;
+  char *fname;
+  size_t len;
+  off_t bytes;
+  long step;
+  int i, first, end;
+  memset(&gr, 0, sizeof(genrank));
+  gr.opts = opts;
+  gr.rank = rank;
+  gr.rng = rng_create(opts->seed, 2, (uint64_t)rank);
+  /* Group g holds the ranks i with i*groups/ranks == g */
+  gr.group = (int)((int64_t)rank * opts->groups / opts->ranks);
+  first = (int)(((int64_t)gr.group * opts->ranks + opts->groups - 1) /
+                opts->groups);
+  end = (int)(((int64_t)(gr.group+1) * opts->ranks + opts->groups - 1) /
+              opts->groups);
+  gr.grank = rank - first;
+  gr.gsize = end - first;
+  gr.perf.count = opts->perfctrs;
+  for(i = 0; i < opts->perfctrs; ++i)
+    strcpy(gr.perf.counter_tag[i], opts->perflabels[i]);
+  len = strlen(opts->out) + 32;
+  assert((fname = (char*)malloc(len)) != NULL);
+  snprintf(fname, len, "%s-%04d.bin", opts->out, rank);
+  assert((gr.profile = dumpi_alloc_output_profile(0, DUMPIGEN_EPOCH,
+                                                  opts->bufsize)) != NULL);
+  if((gr.profile->file = fopen(fname, "w")) == NULL) {
+    fprintf(stderr, "Failed to create output file %s: %s\n",
+            fname, strerror(errno));
+    dumpi_free_output_profile(gr.profile);
+    free(fname);
+    return 0;
+  }
+  write_preamble(&gr);
+  gr.step_ns = gr.now_ns;
+  for(step = 0; step < opts->steps; ++step)
+    write_step(&gr, step);
+  write_postamble(&gr);
+  memset(&header, 0, sizeof(dumpi_header));
+  header.version[0] = dumpi_version;
+  header.version[1] = dumpi_subversion;
+  header.version[2] = dumpi_subsubversion;
+  header.starttime = DUMPIGEN_EPOCH;
+  header.hostname = (char*)"dumpigen";
+  header.username = (char*)"dumpigen";
+  dumpi_write_header(gr.profile, &header);
+  dumpi_write_footer(gr.profile, &gr.footer);
+  dumpi_write_keyval_record(gr.profile, NULL);
+  dumpi_write_perfctr_labels(gr.profile, opts->perfctrs, opts->perflabels);
+  dumpi_write_datatype_sizes(gr.profile, &opts->typesize);
+  dumpi_write_function_addresses(gr.profile, 0, NULL, NULL);
+  /* The index is eight 64-bit offsets */
+  bytes = DUMPI_WRITE_TELL(gr.profile) + 8*sizeof(uint64_t);
+  dumpi_write_index(gr.profile);
+  dumpi_free_output_profile(gr.profile);
+  if(opts->verbose)
+    fprintf(stderr, "Wrote %s (%lld bytes)\n", fname, (long long)bytes);
+  free(fname);
+  return bytes;
+}
+
+static int write_meta(const settings *opts) {
+  const char *prefix = strrchr(opts->out, '/');
+  char *fname;
+  size_t len = strlen(opts->out) + 8;
+  FILE *fp;
+  assert((fname = (char*)malloc(len)) != NULL);
+  snprintf(fname, len, "%s.meta", opts->out);
+  if((fp = fopen(fname, "w")) == NULL) {
+    fprintf(stderr, "Failed to create metafile %s: %s\n",
+            fname, strerror(errno));
+    free(fname);
+    return 0;
+  }
+  fprintf(fp, "hostname=dumpigen\n");
+  fprintf(fp, "numprocs=%d\n", opts->ranks);
+  fprintf(fp, "username=dumpigen\n");
+  fprintf(fp, "startime=%llu\n", (unsigned long long)DUMPIGEN_EPOCH);
+  fprintf(fp, "fileprefix=%s\n", (prefix ? prefix+1 : opts->out));
+  fprintf(fp, "fanout=0\n");
+  fprintf(fp, "version=%d\nsubversion=%d\nsubsubversion=%d\n",
+          dumpi_version, dumpi_subversion, dumpi_subsubversion);
+  fclose(fp);
+  free(fname);
+  return 1;
+}
+
+/* Ranks handed out to the worker threads */
+typedef struct genpool {
+  const settings *opts;
+  int next, failed;
+  uint64_t bytes;
+  pthread_mutex_t lock;
+} genpool;
+
+static void* gen_worker(void *arg) {
+  genpool *pool = (genpool*)arg;
+  while(1) {
+    int rank;
+    off_t bytes;
+    pthread_mutex_lock(&pool->lock);
+    rank = (pool->failed ? pool->opts->ranks : pool->next++);
+    pthread_mutex_unlock(&pool->lock);
+    if(rank >= pool->opts->ranks) break;
+    bytes = write_rank(pool->opts, rank);
+    pthread_mutex_lock(&pool->lock);
+    if(bytes == 0) pool->failed = 1;
+    pool->bytes += bytes;
+    pthread_mutex_unlock(&pool->lock);
+  }
+  return NULL;
+}
+
+static void print_help(const char *name);
+static void parse_opts(int argc, char **argv, settings *opts);
+static void init_typesizes(dumpi_sizeof *typesize);
+
+int main(int argc, char **argv) {
+  static const char *papi_names[] = {
+    "PAPI_TOT_CYC", "PAPI_TOT_INS", "PAPI_L1_DCM", "PAPI_L2_DCM",
+    "PAPI_L3_TCM", "PAPI_BR_MSP", "PAPI_FP_OPS", "PAPI_TLB_DM"
+  };
+  settings opts;
+  genpool pool;
+  pthread_t *threads;
+  struct timespec t0, t1;
+  double seconds;
+  int i, nthreads;
+  parse_opts(argc, argv, &opts);
+  if(opts.help) {
+    print_help(argv[0]);
+    return 1;
+  }
+  opts.outputs.timestamps = DUMPI_TIME_FULL;
+  opts.outputs.statuses = DUMPI_ENABLE;
+  opts.outputs.perfinfo = (opts.perfctrs > 0);
+  for(i = 0; i <= DUMPI_ALL_FUNCTIONS; ++i)
+    opts.outputs.function[i] = DUMPI_ENABLE;
+  assert((opts.perflabels = (dumpi_perflabel_t*)
+          calloc(opts.perfctrs + 1, sizeof(dumpi_perflabel_t))) != NULL);
+  for(i = 0; i < opts.perfctrs; ++i) {
+    if(i < (int)(sizeof(papi_names) / sizeof(papi_names[0])))
+      strcpy(opts.perflabels[i], papi_names[i]);
+    else
+      snprintf(opts.perflabels[i], DUMPI_MAX_PERFCTR_NAME, "GEN_CTR_%d", i);
+  }
+  init_typesizes(&opts.typesize);
+  if(! write_meta(&opts))
+    return 3;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  memset(&pool, 0, sizeof(genpool));
+  pool.opts = &opts;
+  nthreads = (opts.threads < opts.ranks ? opts.threads : opts.ranks);
+  if(nthreads < 1) nthreads = 1;
+  assert((threads = (pthread_t*)calloc(nthreads, sizeof(pthread_t))) != NULL);
+  pthread_mutex_init(&pool.lock, NULL);
+  for(i = 0; i < nthreads; ++i)
+    assert(pthread_create(&threads[i], NULL, gen_worker, &pool) == 0);
+  for(i = 0; i < nthreads; ++i)
+    pthread_join(threads[i], NULL);
+  pthread_mutex_destroy(&pool.lock);
+  free(threads);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  seconds = (double)(t1.tv_sec - t0.tv_sec) + 1e-9 * (t1.tv_nsec - t0.tv_nsec);
+  if(opts.verbose)
+    fprintf(stderr, "Wrote %d ranks, %llu bytes in %.3f seconds "
+            "(%.1f MB/s)\n", opts.ranks, (unsigned long long)pool.bytes,
+            seconds, (seconds > 0 ? pool.bytes / seconds / 1e6 : 0.0));
+  free(opts.typesize.size);
+  free(opts.perflabels);
+  free(opts.out);
+  return (pool.failed ? 3 : 0);
+}
+
+/* Sizes of the built-in datatypes, as MPI_Type_size would report them */
+void init_typesizes(dumpi_sizeof *typesize) {
+  int *size;
+  typesize->count = DUMPI_FIRST_USER_DATATYPE;
+  assert((size = (int*)calloc(typesize->count, sizeof(int))) != NULL);
+  size[DUMPI_CHAR] = size[DUMPI_SIGNED_CHAR] = sizeof(char);
+  size[DUMPI_UNSIGNED_CHAR] = size[DUMPI_BYTE] = sizeof(char);
+  size[DUMPI_WCHAR] = 4;
+  size[DUMPI_SHORT] = size[DUMPI_UNSIGNED_SHORT] = sizeof(short);
+  size[DUMPI_INT] = size[DUMPI_UNSIGNED] = sizeof(int);
+  size[DUMPI_LONG] = size[DUMPI_UNSIGNED_LONG] = sizeof(long);
+  size[DUMPI_FLOAT] = sizeof(float);
+  size[DUMPI_DOUBLE] = sizeof(double);
+  size[DUMPI_LONG_DOUBLE] = sizeof(long double);
+  size[DUMPI_LONG_LONG_INT] = size[DUMPI_UNSIGNED_LONG_LONG] =
+    size[DUMPI_LONG_LONG] = sizeof(long long);
+  size[DUMPI_PACKED] = 1;
+  size[DUMPI_FLOAT_INT] = sizeof(float) + sizeof(int);
+  size[DUMPI_DOUBLE_INT] = sizeof(double) + sizeof(int);
+  size[DUMPI_LONG_INT] = sizeof(long) + sizeof(int);
+  size[DUMPI_SHORT_INT] = sizeof(short) + sizeof(int);
+  size[DUMPI_2INT] = 2 * sizeof(int);
+  size[DUMPI_LONG_DOUBLE_INT] = sizeof(long double) + sizeof(int);
+  typesize->size = size;
+}
+
+void print_help(const char *name) {
+  fprintf(stderr,
+          "%s: Generate a synthetic DUMPI trace set\n"
+          "    Usage: %s [options] -o outroot\n"
+          "    Writes outroot.meta and outroot-NNNN.bin for every rank.\n"
+          "    Options:\n"
+          "      -r, --ranks n           Number of ranks (default 4)\n"
+          "      -s, --steps n           Communication steps per rank\n"
+          "                              (default 1000)\n"
+          "      -S, --seed n            Seed for the workload model (default 1)\n"
+          "      -m, --mix p2p:coll:poll Relative weights of the step kinds\n"
+          "                              (default 70:20:10)\n"
+          "      -z, --size dist         Message sizes in bytes, one of\n"
+          "                              N, uniform:MIN:MAX or log:MIN:MAX\n"
+          "                              (default log:8:65536)\n"
+          "      -g, --groups n          Split the world into n groups; steps\n"
+          "                              alternate between the world and the\n"
+          "                              group communicator (default 1)\n"
+          "      -t, --rank-threads n    Threads per rank (default 1)\n"
+          "      -p, --perfctrs n        Perfcounters per record (default 0)\n"
+          "      -P, --polls n           Most Testall polls per poll step\n"
+          "                              (default 8)\n"
+          "      -C, --compute usec      Mean compute time between steps\n"
+          "                              (default 20)\n"
+          "      -B, --buffer bytes      Output buffer per rank (default 4 MB)\n"
+          "      -j, --threads n         Ranks written concurrently\n"
+          "                              (default: one per online processor)\n"
+          "      -v, --verbose           Report progress\n"
+          "    The output depends only on the options, not on -j.\n",
+          name, name);
+}
+
+static int parse_size(const char *arg, gensize *size) {
+  unsigned long long a, b;
+  char *colon;
+  if(strncmp(arg, "uniform:", 8) == 0 || strncmp(arg, "log:", 4) == 0) {
+    size->dist = (arg[0] == 'u' ? GEN_UNIFORM : GEN_LOG);
+    colon = strchr(arg, ':');
+    if(sscanf(colon+1, "%llu:%llu", &a, &b) != 2 || a > b || b > INT32_MAX)
+      return 0;
+    size->min = a;
+    size->max = b;
+    return 1;
+  }
+  if(sscanf(arg, "%llu", &a) != 1 || a > INT32_MAX)
+    return 0;
+  size->dist = GEN_FIXED;
+  size->min = size->max = a;
+  return 1;
+}
+
+void parse_opts(int argc, char **argv, settings *opts) {
+  int i, j, ch;
+  char *shopts = NULL;
+  for(i = 0; options[i].name != NULL; ++i) { /* just counting i */ }
+  assert((shopts = (char*)calloc(2*i+1, sizeof(char))) != NULL);
+  for(i = 0, j = 0; options[i].name != NULL; ++i, ++j) {
+    shopts[j] = options[i].val;
+    if(options[i].has_arg != no_argument) shopts[++j] = ':';
+  }
+  memset(opts, 0, sizeof(settings));
+  opts->ranks = 4;
+  opts->steps = 1000;
+  opts->seed = 1;
+  opts->mix[GEN_P2P] = 70;
+  opts->mix[GEN_COLL] = 20;
+  opts->mix[GEN_POLL] = 10;
+  parse_size("log:8:65536", &opts->size);
+  opts->groups = 1;
+  opts->rank_threads = 1;
+  opts->polls = 8;
+  opts->compute_us = 20;
+  opts->bufsize = 4 << 20;
+  opts->threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  while((ch = getopt_long(argc, argv, shopts, options, NULL)) != -1) {
+    switch(ch) {
+    case 'v': opts->verbose = 1; break;
+    case 'h': opts->help = 1; break;
+    case 'o': assert((opts->out = strdup(optarg)) != NULL); break;
+    case 'r': opts->ranks = atoi(optarg); break;
+    case 's': opts->steps = atol(optarg); break;
+    case 'S': opts->seed = strtoull(optarg, NULL, 0); break;
+    case 'm':
+      if(sscanf(optarg, "%d:%d:%d", &opts->mix[GEN_P2P], &opts->mix[GEN_COLL],
+                &opts->mix[GEN_POLL]) != 3) {
+        fprintf(stderr, "ERROR:  Invalid call mix %s\n", optarg);
+        exit(2);
+      }
+      break;
+    case 'z':
+      if(! parse_size(optarg, &opts->size)) {
+        fprintf(stderr, "ERROR:  Invalid size distribution %s\n", optarg);
+        exit(2);
+      }
+      break;
+    case 'g': opts->groups = atoi(optarg); break;
+    case 't': opts->rank_threads = atoi(optarg); break;
+    case 'p': opts->perfctrs = atoi(optarg); break;
+    case 'P': opts->polls = atoi(optarg); break;
+    case 'C': opts->compute_us = atof(optarg); break;
+    case 'B': opts->bufsize = (size_t)atol(optarg); break;
+    case 'j': opts->threads = atoi(optarg); break;
+    default:
+      fprintf(stderr, "Invalid option %c\n", ch);
+      exit(1);
+    }
+  }
+  free(shopts);
+  if(opts->help)
+    return;
+  /* We require the -o argument */
+  if(opts->out == NULL) {
+    fprintf(stderr, "ERROR:  The -o argument is not optional\n");
+    exit(2);
+  }
+  for(i = 0; i < GEN_STEP_KINDS; ++i) {
+    if(opts->mix[i] < 0) opts->mix[i] = 0;
+    opts->mixtotal += opts->mix[i];
+  }
+  if(opts->mixtotal <= 0 || opts->ranks <= 0 || opts->steps < 0 ||
+     opts->groups <= 0 || opts->groups > opts->ranks ||
+     opts->rank_threads <= 0 || opts->rank_threads > 65535 ||
+     opts->perfctrs < 0 || opts->perfctrs > DUMPI_MAX_PERFCTRS ||
+     opts->polls < 0 || opts->compute_us < 0)
+  {
+    fprintf(stderr, "ERROR:  Option out of range (see %s -h)\n", argv[0]);
+    exit(2);
+  }
+}
@@ -0,0 +1,119 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bin/commatrix.h>
+#include <iostream>
+#include <vector>
+#include <getopt.h>
+#include <stdio.h>
+
+using namespace dumpi;
+
+static const struct option longopts[] = {
+  {"help", no_argument, NULL, 'h'},
+  {"dense", no_argument, NULL, 'd'},
+  {NULL, 0, NULL, 0}
+};
+
+void print_help(const std::string &name) {
+  std::cerr << name << ":  Print communication matrices written by "
+            << "dumpistats --exchange\n"
+            << "Usage:  " << name << " [options] matrix.csr [...]\n"
+            << "Options:\n"
+            << "   (-h|--help)       Print help screen and exit\n"
+            << "   (-d|--dense)      Print one line per row with a column\n"
+            << "                     of bytes for every rank\n"
+            << "By default, each non-zero entry is printed as\n"
+            << "   rank peer bytes messages\n";
+}
+
+int main(int argc, char **argv) {
+  bool dense = false;
+  int ch;
+  while((ch = getopt_long(argc, argv, "hd", longopts, NULL)) != -1) {
+    switch(ch) {
+    case 'h':
+      print_help(argv[0]);
+      return 1;
+    case 'd':
+      dense = true;
+      break;
+    default:
+      std::cerr << "Invalid argument: " << char(ch) << "\n";
+      return 2;
+    }
+  }
+  if(optind >= argc) {
+    print_help(argv[0]);
+    return 3;
+  }
+  for(int arg = optind; arg < argc; ++arg) {
+    commatrix mtx;
+    if(! mtx.read(argv[arg])) {
+      std::cerr << argv[arg] << ":  Not a valid matrix file\n";
+      return 4;
+    }
+    std::cout << "# " << argv[arg] << ":  " << mtx.rows() << " rows, "
+              << mtx.nonzeros() << " non-zero entries, world size "
+              << mtx.world_size() << "\n";
+    for(size_t row = 0; row < mtx.rows(); ++row) {
+      if(dense) {
+        std::vector<int64_t> bytes(mtx.world_size(), 0);
+        for(int64_t i = mtx.row_begin(row); i < mtx.row_end(row); ++i)
+          if(mtx.peer(i) >= 0 && mtx.peer(i) < mtx.world_size())
+            bytes[mtx.peer(i)] = mtx.bytes(i);
+        std::cout << mtx.rank(row);
+        for(size_t peer = 0; peer < bytes.size(); ++peer)
+          std::cout << " " << bytes[peer];
+        std::cout << "\n";
+      }
+      else {
+        for(int64_t i = mtx.row_begin(row); i < mtx.row_end(row); ++i)
+          std::cout << mtx.rank(row) << " " << mtx.peer(i) << " "
+                    << mtx.bytes(i) << " " << mtx.count(i) << "\n";
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,154 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_BIN_DUMPISTATS_BATCH_H
+#define DUMPI_BIN_DUMPISTATS_BATCH_H
+
+#include <dumpi/common/funclabels.h>
+#include <dumpi/common/types.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+
+namespace dumpi {
+
+  /// Flatten a timestamp to nanoseconds.
+  inline int64_t flatten(const dumpi_clock &tt) {
+    return (int64_t(tt.sec * int64_t(1e9)) + tt.nsec);
+  }
+
+  /// Turn a flattened timestamp back into a dumpi_clock.
+  inline dumpi_clock unflatten(int64_t flattime) {
+    return dumpi_clock_init_scale(flattime, int64_t(1e9));
+  }
+
+  /**
+   * Perfcounter names are mapped to small integer slots once per trace,
+   * so the handlers can keep their totals in plain arrays.
+   * Slots are shared by every handler and every trace.
+   */
+  class perfslots {
+    static std::vector<std::string> names_;
+    static std::map<std::string, int> slots_;
+    static std::mutex lock_;
+  public:
+    /// Get the slot for the given counter name, adding it if needed.
+    /// Safe to call from several threads.
+    static int lookup(const char *name);
+    /// The number of slots handed out so far.
+    static int size() { return int(names_.size()); }
+    /// The counter name for a slot.
+    static const std::string& name(int slot) { return names_.at(slot); }
+  };
+
+  /**
+   * A single call, as needed to start or stop collection in a bin.
+   * Perfcounter values are stored by slot, and a record can carry as many
+   * counters as the stream format allows.
+   */
+  struct eventstamp {
+    int64_t cpu_start, cpu_stop, wall_start, wall_stop;
+    int perf_count;
+    int perf_slot[DUMPI_MAX_STREAM_PERFCTRS];
+    int64_t perf_in[DUMPI_MAX_STREAM_PERFCTRS];
+    int64_t perf_out[DUMPI_MAX_STREAM_PERFCTRS];
+  };
+
+  /**
+   * A run of consecutive calls from one trace, stored one column per field
+   * so that handlers process a whole range of calls in a single loop.
+   * Calls with perfcounters have perf_count[i] values starting at
+   * perf_first[i] in perf_in/perf_out, belonging to the slots in
+   * perf_slot (which is the same for every call in a trace).
+   */
+  struct eventbatch {
+    /// The number of calls gathered before the bins are run.
+    static const size_t capacity = 1024;
+
+    size_t size;
+    std::vector<dumpi_function> func;
+    std::vector<int64_t> cpu_start, cpu_stop, wall_start, wall_stop;
+    std::vector<int64_t> bytes_sent, bytes_recvd;
+    std::vector<int> to_rank, from_rank;
+    std::vector<int> perf_count;
+    std::vector<size_t> perf_first;
+    std::vector<int64_t> perf_in, perf_out;
+    std::vector<int> perf_slot;
+
+    eventbatch() :
+      size(0), func(capacity), cpu_start(capacity), cpu_stop(capacity),
+      wall_start(capacity), wall_stop(capacity), bytes_sent(capacity),
+      bytes_recvd(capacity), to_rank(capacity), from_rank(capacity),
+      perf_count(capacity), perf_first(capacity)
+    {}
+
+    bool full() const { return size >= capacity; }
+
+    /// Drop all calls (but keep the perfcounter slots).
+    void clear() {
+      size = 0;
+      perf_in.clear();
+      perf_out.clear();
+    }
+
+    /// Copy out call i.
+    void stamp(size_t i, eventstamp &ev) const {
+      ev.cpu_start = cpu_start[i];
+      ev.cpu_stop = cpu_stop[i];
+      ev.wall_start = wall_start[i];
+      ev.wall_stop = wall_stop[i];
+      ev.perf_count = perf_count[i];
+      for(int c = 0; c < ev.perf_count; ++c) {
+        ev.perf_slot[c] = perf_slot[c];
+        ev.perf_in[c] = perf_in[perf_first[i] + c];
+        ev.perf_out[c] = perf_out[perf_first[i] + c];
+      }
+    }
+  };
+
+} // end of namespace dumpi
+
+#endif // ! DUMPI_BIN_DUMPISTATS_BATCH_H
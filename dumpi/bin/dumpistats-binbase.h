@@ -77,18 +77,19 @@ namespace dumpi {
     /// Process the given annotation call.  Ignored by default.
     virtual void annotate(const char* /*message*/,
                           uint16_t /*thread*/,
-                          const dumpi_time* /*cpu*/,
-                          const dumpi_time* /*wall*/,
-                          const dumpi_perfinfo* /*perf*/)
+                          const eventstamp& /*ev*/)
     {}
 
-    /// Process the given MPI call type.
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg) = 0;
+    /// Process a batch of MPI calls (all from the current trace).
+    virtual void handle(const eventbatch &batch) = 0;
+
+    /// True if the bin (with all its handlers) can be filled from the
+    /// given rollup instead of the trace.  False by default.
+    virtual bool covers(const rollup& /*ru*/) const { return false; }
+
+    /// Fill the bin from the rollup of a trace rather than from its calls.
+    /// Only valid if covers(ru) is true.  Ignored by default.
+    virtual void replay(const rollup& /*ru*/) {}
 
     /// Reset counters and internal state in preparation for a new trace.
     /// Forces a flush of all active handlers unless callcount_ is zero.
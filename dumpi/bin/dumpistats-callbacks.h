@@ -57,7 +57,6 @@ namespace dumpi {
    * Callbacks for dumpistats.
    */
   class callbacks {
-    libundumpi_callbacks cb;
     /// Temporary stash for preparse state -- goes out of scope after parse(...).
     std::vector<trace> *trace_;
     std::vector<binbase*> *bin_;
@@ -65,6 +64,11 @@ namespace dumpi {
     int current_trace_;
     /// All valid function entry addresses
     std::map<uint64_t, std::string> labels_;
+    /// Calls not yet handed to the bins.
+    eventbatch batch_;
+
+    /// Make sure batch_.perf_slot covers all counters in perf.
+    void resolve_perf(const dumpi_perfdata *perf);
 
   public:
     /// Setup.
@@ -74,19 +78,27 @@ namespace dumpi {
     void go(const metadata &meta, std::vector<trace> &trace,
             std::vector<binbase*> &bin);
 
-    /// Forward a call to all bins.
+    /// Run through the trace for one rank only.  The bins are not reset
+    /// afterwards.  Separate callbacks objects may do this concurrently.
+    void go(const metadata &meta, std::vector<trace> &trace,
+            std::vector<binbase*> &bin, int rank);
+
+    /// Queue a call for all bins (they see it once the batch fills up,
+    /// at the next annotation, or at the end of the trace).
     void handle(dumpi_function func, uint16_t thread,
                 const dumpi_time *cpu, const dumpi_time *wall,
-                const dumpi_perfinfo *perf,
+                const dumpi_perfdata *perf,
                 int64_t bytes_sent, int to_global_rank,
-                int64_t bytes_recvd, int from_global_rank,
-                const void *dumpi_arg);
+                int64_t bytes_recvd, int from_global_rank);
+
+    /// Hand all queued calls to the bins.
+    void flush();
 
     /// Given an annotation, pass it on to the handlers.
     /// Valid annotations are assumed to start with "ANNOTATE: "
     void annotate(const dumpi_func_call *prm, uint16_t thread,
                   const dumpi_time *cpu, const dumpi_time *wall,
-                  const dumpi_perfinfo *perf);
+                  const dumpi_perfdata *perf);
   
     /// Get the size of the given type.
     int typesize(dumpi_datatype dtype, const dumpi_clock &when) const;
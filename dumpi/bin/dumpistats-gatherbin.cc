@@ -121,6 +121,10 @@ namespace dumpi {
                                  << values.at(j) << " ";
         }
         *file_[current_bin_] << std::endl;
+        std::stringstream root;
+        root << binid_ << "-" << current_bin_;
+        for(size_t i = 0; i < handlers_.size(); ++i)
+          handlers_[i]->dump_row(root.str(), current_rank_);
         //file_[current_bin_]->close();
         callcount_ = 0;
       }
@@ -138,23 +142,17 @@ namespace dumpi {
   //
   // Private method to activate all handlers.
   //
-  void gatherbin::mark_handlers_active(const dumpi_time *cpu,
-                                       const dumpi_time *wall,
-                                       const dumpi_perfinfo *perf)
-  {
+  void gatherbin::mark_handlers_active(const eventstamp &ev) {
     for(size_t i = 0; i < handlers_.size(); ++i)
-      handlers_[i]->mark_active(cpu, wall, perf);
+      handlers_[i]->mark_active(ev);
   }
 
   //
   // Private method to deactivate all handlers.
   //
-  void gatherbin::mark_handlers_inactive(const dumpi_time *cpu,
-                                         const dumpi_time *wall,
-                                         const dumpi_perfinfo *perf)
-  {
+  void gatherbin::mark_handlers_inactive(const eventstamp &ev) {
     for(size_t i = 0; i < handlers_.size(); ++i)
-      handlers_[i]->mark_inactive(cpu, wall, perf);
+      handlers_[i]->mark_inactive(ev);
   }
 
   //
@@ -283,8 +281,10 @@ namespace dumpi {
     if(callcount_ > 0) {
       this->dump_output();
     }
-    for(size_t i = 0; i < handlers_.size(); ++i)
+    for(size_t i = 0; i < handlers_.size(); ++i) {
+      handlers_[i]->finish();
       delete handlers_[i];
+    }
   }
 
   //
@@ -306,9 +306,9 @@ namespace dumpi {
   // Process the given annotation call.
   //
   void gatherbin::annotate(const char *message, uint16_t thread,
-                           const dumpi_time *cpu, const dumpi_time *wall,
-                           const dumpi_perfinfo *perf)
+                           const eventstamp &ev)
   {
+    const dumpi_clock start = unflatten(ev.wall_start);
     //std::cerr << "Annotate:  start_pattern_=\"" << start_pattern_ 
     //          << "\", stop_pattern_=\"" << stop_pattern_ << "\", message=\""
     //          << message << "\"\n";
@@ -318,14 +318,14 @@ namespace dumpi {
         //          << " to message " << message << "\n";
         if(regexec(&start_regex_, message, 0, NULL, 0) == 0) {
           //std::cerr << "MATCH\n";
-          start_gather_[current_rank_] = wall->start;
-          stop_gather_[current_rank_] = wall->start;
-          if(first_stamp_[current_rank_] > wall->start)
-            first_stamp_[current_rank_] = wall->start;
+          start_gather_[current_rank_] = start;
+          stop_gather_[current_rank_] = start;
+          if(first_stamp_[current_rank_] > start)
+            first_stamp_[current_rank_] = start;
           // Match.
           intervals_[current_rank_] += 1;
-          if(wall->start > last_stamp_[current_rank_])
-            last_stamp_[current_rank_] = wall->start;
+          if(start > last_stamp_[current_rank_])
+            last_stamp_[current_rank_] = start;
           if(! accumulate_) {
             first_stamp_.clear();
             last_stamp_.clear();
@@ -333,7 +333,7 @@ namespace dumpi {
             stop_gather_.clear();
             tot_act_.clear();
             accumulated_.clear();
-            first_stamp_[current_rank_] = wall->start;
+            first_stamp_[current_rank_] = start;
             // Notify the handlers so we get good timings
             ++current_bin_;
             //std::cerr << "Bumped bin to " << current_bin_ << "\n";
@@ -341,10 +341,10 @@ namespace dumpi {
             //          << first_stamp_[current_rank_] << "\n";
           }
           else {
-            if(wall->start < first_stamp_[current_rank_])
-              first_stamp_[current_rank_] = wall->start;
+            if(start < first_stamp_[current_rank_])
+              first_stamp_[current_rank_] = start;
           }
-          this->mark_handlers_active(cpu, wall, perf);
+          this->mark_handlers_active(ev);
           active_ = true;
         }
       }
@@ -355,12 +355,12 @@ namespace dumpi {
         //          << " to message " << message << "\n";
         if(regexec(&stop_regex_, message, 0, NULL, 0) == 0) {
           //std::cerr << "MATCH\n";
-          stop_gather_[current_rank_] = wall->start;
-          if(wall->start < first_stamp_[current_rank_])
-            first_stamp_[current_rank_] = wall->start;
-          if(wall->start > last_stamp_[current_rank_])
-            last_stamp_[current_rank_] = wall->start;
-          this->mark_handlers_inactive(cpu, wall, perf);
+          stop_gather_[current_rank_] = start;
+          if(start < first_stamp_[current_rank_])
+            first_stamp_[current_rank_] = start;
+          if(start > last_stamp_[current_rank_])
+            last_stamp_[current_rank_] = start;
+          this->mark_handlers_inactive(ev);
           if(! accumulate_) {
             tot_act_[current_rank_] = 
               stop_gather_[current_rank_] - start_gather_[current_rank_];
@@ -378,24 +378,15 @@ namespace dumpi {
   }
 
   //
-  // Process the given MPI call type.
+  // Process a batch of MPI calls.
+  // Annotations flush the batch first, so the whole batch is either
+  // inside or outside the gathered region.
   //
-  void gatherbin::handle(dumpi_function func, uint16_t thread,
-                         const dumpi_time *cpu, const dumpi_time *wall,
-                         const dumpi_perfinfo *perf,
-                         int64_t bytes_sent, int to_global_rank,
-                         int64_t bytes_recvd, int from_global_rank,
-                         const void *dumpi_arg)
-  {
-    // Figure out which bin (if any) this goes into.
-    //std::cerr << "handle(" << func << ")\n";
+  void gatherbin::handle(const eventbatch &batch) {
     if(active_) {
-      ++callcount_;
-      //std::cerr << " -- handler active.  Bumped call count to " << callcount_ << "\n";
+      callcount_ += int(batch.size);
       for(size_t i = 0; i < handlers_.size(); ++i)
-        handlers_[i]->handle(func, thread, cpu, wall, perf,
-                             bytes_sent, to_global_rank,
-                             bytes_recvd, from_global_rank, dumpi_arg);
+        handlers_[i]->handle(batch, 0, batch.size);
     }
   }
 
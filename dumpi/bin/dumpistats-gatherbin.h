@@ -118,12 +118,10 @@ namespace dumpi {
     void clear_handlers();
 
     /// Private method to activate all handlers.
-    void mark_handlers_active(const dumpi_time *cpu, const dumpi_time *wall,
-                              const dumpi_perfinfo *perf);
+    void mark_handlers_active(const eventstamp &ev);
 
     /// Private method to deactivate all handlers.
-    void mark_handlers_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                                const dumpi_perfinfo *perf);
+    void mark_handlers_inactive(const eventstamp &ev);
 
     /// Private method to parse the input expression into start and
     /// end patterns.
@@ -154,17 +152,10 @@ namespace dumpi {
 
     /// Process the given annotation call.
     virtual void annotate(const char *message, uint16_t thread,
-                          const dumpi_time *cpu,
-                          const dumpi_time *wall,
-                          const dumpi_perfinfo *perf);
+                          const eventstamp &ev);
 
     /// Process the given MPI call type.
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg);
+    virtual void handle(const eventbatch &batch);
 
     /// Reset counters and internal state in preparation for a new trace.
     /// Forces a flush of all active handlers unless callcount_ is zero.
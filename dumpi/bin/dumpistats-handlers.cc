@@ -44,17 +44,15 @@ Questions? Contact sst-macro-help@sandia.gov
 
 #include <dumpi/bin/dumpistats-handlers.h>
 #include <dumpi/bin/timeutils.h>
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
+#include <mutex>
 #include <string.h>
 #include <regex.h>
 
 namespace dumpi {
 
-  inline int64_t flatten(const dumpi_clock &tt) {
-    return (int64_t(tt.sec * int64_t(1e9)) + tt.nsec);
-  }
-
   inline dumpi_clock dtime(int64_t flattime) {
     //explicit cast needed for c++11 compatibility
     int32_t arg1 = (int32_t) flattime/int64_t(1e9);
@@ -129,8 +127,24 @@ namespace dumpi {
     DUMPIO_Waitsome, DUMPIO_Testsome, -1
   };
 
-  // Counter.
-  handlerbase::handlerbase(const std::string &pattern) {
+  std::vector<std::string> perfslots::names_;
+  std::map<std::string, int> perfslots::slots_;
+  std::mutex perfslots::lock_;
+
+  int perfslots::lookup(const char *name) {
+    std::lock_guard<std::mutex> guard(lock_);
+    std::map<std::string, int>::iterator it = slots_.find(name);
+    if(it != slots_.end())
+      return it->second;
+    int slot = int(names_.size());
+    names_.push_back(name);
+    slots_[name] = slot;
+    return slot;
+  }
+
+  void match_functions(const std::string &pattern,
+                       bool collect_[DUMPI_END_OF_STREAM])
+  {
     memset(collect_, 0, DUMPI_END_OF_STREAM*sizeof(bool));
     if(pattern == "all") {
       for(int i = 0; i < DUMPI_END_OF_STREAM; ++i)
@@ -194,9 +208,15 @@ namespace dumpi {
           collect_[i] = true;
         }
       }
+      regfree(&preg);
     }
   }
 
+  // Counter.
+  handlerbase::handlerbase(const std::string &pattern) {
+    match_functions(pattern, collect_);
+  }
+
   handlerbase::~handlerbase() {
   }
 
@@ -226,18 +246,23 @@ namespace dumpi {
   handlerbase* counter::clone() const {
     return new counter(*this);
   }
-  void counter::mark_active(const dumpi_time *, const dumpi_time *,
-                            const dumpi_perfinfo *)
+  void counter::mark_active(const eventstamp&)
   {}
-  void counter::mark_inactive(const dumpi_time*, const dumpi_time*,
-                              const dumpi_perfinfo*)
+  void counter::mark_inactive(const eventstamp&)
   {}
-  void counter::handle(dumpi_function func, uint16_t,
-                       const dumpi_time*, const dumpi_time*,
-                       const dumpi_perfinfo*,
-                       int64_t, int, int64_t, int, const void*) 
+  void counter::handle(const eventbatch &batch, size_t first, size_t last)
   {
-    if(collect_[func]) ++count_;
+    const dumpi_function *func = &batch.func[0];
+    int64_t count = 0;
+    for(size_t i = first; i < last; ++i)
+      count += collect_[func[i]];
+    count_ += count;
+  }
+  void counter::handle_rollup(const rollup &ru, size_t b)
+  {
+    for(int64_t e = ru.entry_begin(b); e < ru.entry_end(b); ++e)
+      if(collect_[ru.func(e)])
+        count_ += ru.count(e);
   }
 
   timer::timer(const std::string &pattern) :
@@ -266,8 +291,8 @@ namespace dumpi {
     tmp += "\"";
     desc_.push_back(tmp);
 
-    dumpi_time neg1 = {{-1, -1}, {-1, -1}};
-    last_cpu_ = last_wall_ = neg1;
+    last_cpu_stop_ = last_wall_stop_ = 0;
+    started_ = fresh_ = false;
   }
   timer::~timer() {
   }
@@ -291,49 +316,80 @@ namespace dumpi {
   handlerbase* timer::clone() const {
     return new timer(*this);
   }
-  void timer::mark_active(const dumpi_time *cpu, const dumpi_time *wall,
-                          const dumpi_perfinfo*)
+  void timer::mark_active(const eventstamp &ev)
+  {
+    last_cpu_stop_ = ev.cpu_stop;
+    last_wall_stop_ = ev.wall_stop;
+    started_ = fresh_ = true;
+  }
+  void timer::mark_inactive(const eventstamp &ev)
   {
-    last_cpu_ = *cpu;
-    last_wall_ = *wall;
+    cpu_outside_mpi_ += ev.cpu_stop - last_cpu_stop_;
+    wall_outside_mpi_ += ev.wall_stop - last_wall_stop_;
+    last_cpu_stop_ = ev.cpu_stop;
+    last_wall_stop_ = ev.wall_stop;
+    started_ = true;
   }
-  void timer::mark_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                            const dumpi_perfinfo*)
+  void timer::handle(const eventbatch &batch, size_t first, size_t last)
   {
-      int64_t flat_cpu_stop = flatten(cpu->stop);
-      int64_t flat_wall_stop = flatten(wall->stop);
-      int64_t flat_last_cpu_stop = flatten(last_cpu_.stop);
-      int64_t flat_last_wall_stop = flatten(last_wall_.stop);
-      cpu_outside_mpi_ += flat_cpu_stop - flat_last_cpu_stop;
-      wall_outside_mpi_ += flat_wall_stop - flat_last_wall_stop;
-      last_cpu_ = *cpu;
-      last_wall_ = *wall;    
-  }
-  void timer::handle(dumpi_function func, uint16_t,
-                     const dumpi_time *cpu, const dumpi_time *wall,
-                     const dumpi_perfinfo*,
-                     int64_t, int, int64_t, int, const void*) 
+    if(first >= last)
+      return;
+    if(! started_) {
+      last_cpu_stop_ = batch.cpu_stop[first];
+      last_wall_stop_ = batch.wall_stop[first];
+      started_ = true;
+    }
+    const dumpi_function *func = &batch.func[0];
+    const int64_t *cpu_start = &batch.cpu_start[0];
+    const int64_t *cpu_stop = &batch.cpu_stop[0];
+    const int64_t *wall_start = &batch.wall_start[0];
+    const int64_t *wall_stop = &batch.wall_stop[0];
+    int64_t last_cpu = last_cpu_stop_, last_wall = last_wall_stop_;
+    int64_t cpu_in = 0, cpu_out = 0, wall_in = 0, wall_out = 0;
+    for(size_t i = first; i < last; ++i) {
+      if(collect_[func[i]]) {
+        cpu_in += cpu_stop[i] - cpu_start[i];
+        if(cpu_start[i] > last_cpu)
+          cpu_out += cpu_start[i] - last_cpu;
+        wall_in += wall_stop[i] - wall_start[i];
+        if(wall_start[i] > last_wall)
+          wall_out += wall_start[i] - last_wall;
+        last_cpu = cpu_stop[i];
+        last_wall = wall_stop[i];
+      }
+    }
+    cpu_inside_mpi_ += cpu_in;
+    cpu_outside_mpi_ += cpu_out;
+    wall_inside_mpi_ += wall_in;
+    wall_outside_mpi_ += wall_out;
+    last_cpu_stop_ = last_cpu;
+    last_wall_stop_ = last_wall;
+    fresh_ = false;
+  }
+  void timer::handle_rollup(const rollup &ru, size_t b)
   {
-    if(last_cpu_.stop.sec < 0)
-      last_cpu_ = *cpu;
-    if(last_wall_.stop.sec < 0)
-      last_wall_ = *wall;
-    if(collect_[func]) {
-      int64_t flat_cpu_start = flatten(cpu->start);
-      int64_t flat_cpu_stop = flatten(cpu->stop);
-      int64_t flat_wall_start = flatten(wall->start);
-      int64_t flat_wall_stop = flatten(wall->stop);
-      int64_t flat_last_cpu_stop = flatten(last_cpu_.stop);
-      int64_t flat_last_wall_stop = flatten(last_wall_.stop);
-      cpu_inside_mpi_ += flat_cpu_stop - flat_cpu_start;
-      if(flat_cpu_start > flat_last_cpu_stop)
-        cpu_outside_mpi_ += flat_cpu_start - flat_last_cpu_stop;
-      wall_inside_mpi_ += flat_wall_stop - flat_wall_start;
-      if(flat_wall_start > flat_last_wall_stop)
-        wall_outside_mpi_ += flat_wall_start - flat_last_wall_stop;
-      last_cpu_ = *cpu;
-      last_wall_ = *wall;
+    int64_t cpu_in = 0, wall_in = 0;
+    for(int64_t e = ru.entry_begin(b); e < ru.entry_end(b); ++e) {
+      if(collect_[ru.func(e)]) {
+        cpu_in += ru.cpu(e);
+        wall_in += ru.wall(e);
+      }
+    }
+    cpu_inside_mpi_ += cpu_in;
+    wall_inside_mpi_ += wall_in;
+    // Calls in a rollup never overlap, so the time outside is the time
+    // since the last stop less the time inside.  Moving the last stop on
+    // by the time inside leaves the rest to mark_inactive.  mark_active
+    // has already moved past the first call of the bin.
+    if(fresh_ && collect_[ru.first_func(b)]) {
+      eventstamp ev;
+      ru.first_stamp(b, ev);
+      cpu_in -= ev.cpu_stop - ev.cpu_start;
+      wall_in -= ev.wall_stop - ev.wall_start;
     }
+    last_cpu_stop_ += cpu_in;
+    last_wall_stop_ += wall_in;
+    fresh_ = false;
   }
 
   // Sender.
@@ -360,19 +416,24 @@ namespace dumpi {
   handlerbase* sender::clone() const {
     return new sender(*this);
   }
-  void sender::mark_active(const dumpi_time *, const dumpi_time *,
-                           const dumpi_perfinfo *)
+  void sender::mark_active(const eventstamp&)
   {}
-  void sender::mark_inactive(const dumpi_time*, const dumpi_time*,
-                             const dumpi_perfinfo*)
+  void sender::mark_inactive(const eventstamp&)
   {}
-  void sender::handle(dumpi_function func, uint16_t,
-                      const dumpi_time*, const dumpi_time*,
-                      const dumpi_perfinfo *perf,
-                      int64_t bytes_sent, int, int64_t, int, const void*) 
+  void sender::handle(const eventbatch &batch, size_t first, size_t last)
   {
-    if(collect_[func])
-      bytes_ += bytes_sent;
+    const dumpi_function *func = &batch.func[0];
+    const int64_t *bytes_sent = &batch.bytes_sent[0];
+    int64_t bytes = 0;
+    for(size_t i = first; i < last; ++i)
+      bytes += (collect_[func[i]] ? bytes_sent[i] : 0);
+    bytes_ += bytes;
+  }
+  void sender::handle_rollup(const rollup &ru, size_t b)
+  {
+    for(int64_t e = ru.entry_begin(b); e < ru.entry_end(b); ++e)
+      if(collect_[ru.func(e)])
+        bytes_ += ru.sent(e);
   }
 
   // Recver.
@@ -399,25 +460,37 @@ namespace dumpi {
   handlerbase* recver::clone() const {
     return new recver(*this);
   }
-  void recver::mark_active(const dumpi_time *, const dumpi_time *,
-                           const dumpi_perfinfo *)
+  void recver::mark_active(const eventstamp&)
   {}
-  void recver::mark_inactive(const dumpi_time*, const dumpi_time*,
-                              const dumpi_perfinfo*)
+  void recver::mark_inactive(const eventstamp&)
   {}
-  void recver::handle(dumpi_function func, uint16_t,
-                      const dumpi_time*, const dumpi_time*,
-                      const dumpi_perfinfo*,
-                      int64_t, int, int64_t bytes_recvd, int, const void*) 
+  void recver::handle(const eventbatch &batch, size_t first, size_t last)
+  {
+    const dumpi_function *func = &batch.func[0];
+    const int64_t *bytes_recvd = &batch.bytes_recvd[0];
+    int64_t bytes = 0;
+    for(size_t i = first; i < last; ++i)
+      bytes += (collect_[func[i]] ? bytes_recvd[i] : 0);
+    bytes_ += bytes;
+  }
+  void recver::handle_rollup(const rollup &ru, size_t b)
   {
-    if(collect_[func])
-      bytes_ += bytes_recvd;
+    for(int64_t e = ru.entry_begin(b); e < ru.entry_end(b); ++e)
+      if(collect_[ru.func(e)])
+        bytes_ += ru.recvd(e);
   }
 
   // Monitor full set of exchanges.
+  inline bool peer_less(const commatrix::cell &a, const commatrix::cell &b) {
+    return a.peer < b.peer;
+  }
+
   exchanger::exchanger(const std::string &pattern) :
     handlerbase(pattern), pat_(pattern), collsent_(0), collrecvd_(0)
-  {}
+  {
+    static int instances = 0;
+    index_ = instances++;
+  }
   exchanger::~exchanger() {
   }
   void exchanger::reset() {
@@ -427,58 +500,99 @@ namespace dumpi {
   const std::vector<std::string>& exchanger::description() const {
     desc_.clear();
     std::stringstream ss;
-    for(int i = 0; i < world_size_; ++i) {
-      ss << "bytes sent by funcs matching \"" << pat_ << "\" to node " << i;
-      desc_.push_back(ss.str());
-      ss.str("");
-    }
+    ss << "number of nodes sent to by funcs matching \"" << pat_ << "\"";
+    desc_.push_back(ss.str());
+    ss.str("");
+    ss << "messages sent by funcs matching \"" << pat_ << "\" to other nodes";
+    desc_.push_back(ss.str());
+    ss.str("");
+    ss << "bytes sent by funcs matching \"" << pat_ << "\" to other nodes"
+       << " (per node in .x" << index_ << ".csr)";
+    desc_.push_back(ss.str());
+    ss.str("");
     // Skipping collectives -- the actual data sent is too dependent
     // on the algorithm used to implement the collective.
-    //ss << "xchg{" << pat_ << "}{coll-send}";
-    //ss << "xchg{" << pat_ << "}{coll-recv} ";
     return desc_;
   }
   const std::vector<std::string>& exchanger::values() const {
     values_.clear();
-    std::stringstream ss;
-    for(int i = 0; i < world_size_; ++i) {
-      int64_t sc = (size_t(i) < sent_.size() ? sent_[i] : 0);
-      ss << sc; values_.push_back(ss.str()); ss.str("");
+    int64_t count = 0, bytes = 0;
+    for(size_t i = 0; i < sent_.size(); ++i) {
+      count += sent_[i].count;
+      bytes += sent_[i].bytes;
     }
-    // Skip collectives.
-    //ss << collsent_;
-    //ss << collrecvd_;
+    std::stringstream ss;
+    ss << sent_.size(); values_.push_back(ss.str()); ss.str("");
+    ss << count; values_.push_back(ss.str()); ss.str("");
+    ss << bytes; values_.push_back(ss.str()); ss.str("");
     return values_;
   }
   handlerbase* exchanger::clone() const {
     return new exchanger(*this);
   }
-  void exchanger::mark_active(const dumpi_time *, const dumpi_time *,
-                              const dumpi_perfinfo *)
+  void exchanger::mark_active(const eventstamp&)
   {}
-  void exchanger::mark_inactive(const dumpi_time*, const dumpi_time*,
-                                const dumpi_perfinfo*)
+  void exchanger::mark_inactive(const eventstamp&)
   {}
-  void exchanger::handle(dumpi_function func, uint16_t,
-                         const dumpi_time*, const dumpi_time*,
-                         const dumpi_perfinfo*,
-                         int64_t bytes_sent, int to_global_rank,
-                         int64_t bytes_recvd, int from_global_rank, const void*) 
+  // Find (or add) the entry for the given peer.
+  commatrix::cell& exchanger::peer(int rank) {
+    commatrix::cell key = {rank, 0, 0};
+    std::vector<commatrix::cell>::iterator it =
+      std::lower_bound(sent_.begin(), sent_.end(), key, peer_less);
+    if(it == sent_.end() || it->peer != rank)
+      it = sent_.insert(it, key);
+    return *it;
+  }
+  void exchanger::handle(const eventbatch &batch, size_t first, size_t last)
   {
-    if(int(sent_.size()) < world_size_) sent_.resize(world_size_);
-    if((to_global_rank >= world_size_) || (from_global_rank >= world_size_)) {
-      std::cerr << "exchanger::handle:  Invalid rank entered.  World size: "
-                << world_size_ << ", sending to " << to_global_rank
-                << " and receiving from " << from_global_rank << "\n";
+    commatrix::cell *prev = NULL;
+    for(size_t i = first; i < last; ++i) {
+      int to_global_rank = batch.to_rank[i];
+      int from_global_rank = batch.from_rank[i];
+      if((to_global_rank >= world_size_) || (from_global_rank >= world_size_)) {
+        std::cerr << "exchanger::handle:  Invalid rank entered.  World size: "
+                  << world_size_ << ", sending to " << to_global_rank
+                  << " and receiving from " << from_global_rank << "\n";
+        continue;
+      }
+      if(collect_[batch.func[i]]) {
+        if(to_global_rank >= 0) {
+          // Runs of sends to the same peer are common.
+          if(prev == NULL || prev->peer != to_global_rank)
+            prev = &peer(to_global_rank);
+          prev->bytes += batch.bytes_sent[i];
+          prev->count += 1;
+        }
+        else
+          collsent_ += batch.bytes_sent[i];
+        if(from_global_rank < 0)
+          collrecvd_ += batch.bytes_recvd[i];
+      }
+    }
+  }
+  void exchanger::dump_row(const std::string &fileroot, int rank) {
+    std::map<std::string, commatrix>::iterator it = matrix_.find(fileroot);
+    if(it == matrix_.end())
+      it = matrix_.insert(std::make_pair(fileroot,
+                                         commatrix(world_size_))).first;
+    it->second.add_row(rank, sent_);
+  }
+  void exchanger::finish() {
+    std::vector<std::pair<std::string, const commatrix*> > files;
+    for(std::map<std::string, commatrix>::const_iterator it = matrix_.begin();
+        it != matrix_.end(); ++it)
+    {
+      std::stringstream ss;
+      ss << it->first << ".x" << index_ << ".csr";
+      files.push_back(std::make_pair(ss.str(), &it->second));
     }
-    if(collect_[func]) {
-      if(to_global_rank >= 0)
-        sent_.at(to_global_rank) += bytes_sent;
-      else
-        collsent_ += bytes_sent;
-      if(from_global_rank < 0)
-        collrecvd_ += bytes_recvd;
+    try {
+      commatrix::write_all(files);
     }
+    catch(const char *err) {
+      std::cerr << err << "\n";
+    }
+    matrix_.clear();
   }
 
   perfcounter::perfcounter(const std::string &pattern) :
@@ -487,87 +601,117 @@ namespace dumpi {
   perfcounter::~perfcounter() {
   }
   void perfcounter::reset() {
-    inside_mpi_.clear();
-    outside_mpi_.clear();
+    inside_mpi_.assign(inside_mpi_.size(), 0);
+    outside_mpi_.assign(outside_mpi_.size(), 0);
+    has_inside_.assign(has_inside_.size(), 0);
+    has_outside_.assign(has_outside_.size(), 0);
+  }
+
+  // Make room for any slots added since we last looked.
+  void perfcounter::grow() {
+    size_t slots = perfslots::size();
+    if(last_out_.size() < slots) {
+      last_out_.resize(slots);
+      inside_mpi_.resize(slots);
+      outside_mpi_.resize(slots);
+      has_last_.resize(slots);
+      has_inside_.resize(slots);
+      has_outside_.resize(slots);
+    }
   }
+
+  // Slots holding a value, in order of counter name.
+  static std::vector<int> sorted_slots(const std::vector<char> &has) {
+    std::map<std::string, int> byname;
+    for(size_t i = 0; i < has.size(); ++i)
+      if(has[i]) byname[perfslots::name(int(i))] = int(i);
+    std::vector<int> rv;
+    for(std::map<std::string, int>::const_iterator it = byname.begin();
+        it != byname.end(); ++it)
+      rv.push_back(it->second);
+    return rv;
+  }
+
   const std::vector<std::string>& perfcounter::description() const {
     desc_.clear();
     std::stringstream ss;
-    for(tracker_t::const_iterator in = inside_mpi_.begin(),
-          out = outside_mpi_.begin();
-        in != inside_mpi_.end() && out != outside_mpi_.end();
-        ++in, ++out)
-      {
-        ss << "performance counter " << in->first << " inside MPI";
-        desc_.push_back(ss.str());
-        ss.str("");
-        ss << "performance counter " << out->first << " outside MPI";
-        desc_.push_back(ss.str());
-        ss.str("");
-      }
+    std::vector<int> in = sorted_slots(has_inside_);
+    std::vector<int> out = sorted_slots(has_outside_);
+    for(size_t i = 0; i < in.size() && i < out.size(); ++i) {
+      ss << "performance counter " << perfslots::name(in[i]) << " inside MPI";
+      desc_.push_back(ss.str());
+      ss.str("");
+      ss << "performance counter " << perfslots::name(out[i]) << " outside MPI";
+      desc_.push_back(ss.str());
+      ss.str("");
+    }
     return desc_;
   }
   
   const std::vector<std::string>& perfcounter::values() const {
     values_.clear();
     std::stringstream ss;
-    for(tracker_t::const_iterator in = inside_mpi_.begin(),
-          out = outside_mpi_.begin();
-        in != inside_mpi_.end() && out != outside_mpi_.end();
-        ++in, ++out)
-      {
-        ss << in->second;
-        values_.push_back(ss.str());
-        ss.str("");
-        ss << out->second;
-        values_.push_back(ss.str());
-        ss.str("");
-      }
+    std::vector<int> in = sorted_slots(has_inside_);
+    std::vector<int> out = sorted_slots(has_outside_);
+    for(size_t i = 0; i < in.size() && i < out.size(); ++i) {
+      ss << inside_mpi_[in[i]];
+      values_.push_back(ss.str());
+      ss.str("");
+      ss << outside_mpi_[out[i]];
+      values_.push_back(ss.str());
+      ss.str("");
+    }
     return values_;
   }
   handlerbase* perfcounter::clone() const {
     return new perfcounter(*this);
   }
-  void perfcounter::mark_active(const dumpi_time*, const dumpi_time*,
-                                const dumpi_perfinfo *perf)
+  void perfcounter::mark_active(const eventstamp &ev)
   {
-    if(perf) {
-      for(int i = 0; i < perf->count; ++i) {
-        last_out_[perf->counter_tag[i]] = perf->outvalue[i];
-      }
+    grow();
+    for(int i = 0; i < ev.perf_count; ++i) {
+      last_out_[ev.perf_slot[i]] = ev.perf_out[i];
+      has_last_[ev.perf_slot[i]] = 1;
     }
   }
   
-  void perfcounter::mark_inactive(const dumpi_time *, const dumpi_time *,
-                                    const dumpi_perfinfo *perf)
+  void perfcounter::mark_inactive(const eventstamp &ev)
   {
-    if(perf) {
-      for(int i = 0; i < perf->count; ++i) {
-        const std::string label = perf->counter_tag[i];
-        if(last_out_.find(label) != last_out_.end())
-          outside_mpi_[label] += perf->invalue[i] - last_out_[label];
+    grow();
+    for(int i = 0; i < ev.perf_count; ++i) {
+      int slot = ev.perf_slot[i];
+      if(has_last_[slot]) {
+        outside_mpi_[slot] += ev.perf_in[i] - last_out_[slot];
+        has_outside_[slot] = 1;
       }
     }
   }
-  void perfcounter::handle(dumpi_function func, uint16_t,
-                           const dumpi_time*, const dumpi_time*,
-                           const dumpi_perfinfo *perf,
-                           int64_t, int, int64_t, int, const void*) 
+  void perfcounter::handle(const eventbatch &batch, size_t first, size_t last)
   {
-    if(perf) {
-      if(collect_[func]) {
-        for(int i = 0; i < perf->count; ++i) {
-          const std::string label = perf->counter_tag[i];
-          if(last_out_.find(label) != last_out_.end())
-            outside_mpi_[label] += perf->invalue[i] - last_out_[label];
-          inside_mpi_[label] += perf->outvalue[i] - perf->invalue[i];
-          last_out_[label] = perf->outvalue[i];
+    grow();
+    const int *slots = (batch.perf_slot.empty() ? NULL : &batch.perf_slot[0]);
+    for(size_t e = first; e < last; ++e) {
+      int count = batch.perf_count[e];
+      if(count <= 0 || ! collect_[batch.func[e]])
+        continue;
+      const int64_t *in = &batch.perf_in[batch.perf_first[e]];
+      const int64_t *out = &batch.perf_out[batch.perf_first[e]];
+      for(int i = 0; i < count; ++i) {
+        int slot = slots[i];
+        if(has_last_[slot]) {
+          outside_mpi_[slot] += in[i] - last_out_[slot];
+          has_outside_[slot] = 1;
         }
+        inside_mpi_[slot] += out[i] - in[i];
+        has_inside_[slot] = 1;
+        last_out_[slot] = out[i];
+        has_last_[slot] = 1;
       }
     }
   }
 
   const int lumper::maxbin_ = 40;
+  static const int lumper_maxbin = 40;
 
   lumper::lumper(const std::string &pattern) :
     handlerbase(pattern), sends_(maxbin_), recvs_(maxbin_), pat_(pattern)
@@ -616,35 +760,27 @@ namespace dumpi {
   handlerbase* lumper::clone() const {
     return new lumper(*this);
   }
-  void lumper::mark_active(const dumpi_time*, const dumpi_time*,
-                           const dumpi_perfinfo*)
+  void lumper::mark_active(const eventstamp&)
   {}
   
-  void lumper::mark_inactive(const dumpi_time *, const dumpi_time *,
-                             const dumpi_perfinfo*)
+  void lumper::mark_inactive(const eventstamp&)
   {}
+  // Bin i holds sizes from 2^(i-1)+1 up to 2^i (bin 0 holds 1 byte).
   inline int binid(int64_t value) {
-    int64_t one(1);
-    int x = 0;
-    while((one << x) < value) x++;
-    return (x - 1);
-  }
-  void lumper::handle(dumpi_function func, uint16_t,
-                      const dumpi_time*, const dumpi_time*,
-                      const dumpi_perfinfo*,
-                      int64_t bytes_sent, int,
-                      int64_t bytes_recvd, int, const void*) 
+    int bin = (value > 1 ? 64 - __builtin_clzll(uint64_t(value - 1)) : 0);
+    return (bin < lumper_maxbin ? bin : lumper_maxbin - 1);
+  }
+  void lumper::handle(const eventbatch &batch, size_t first, size_t last)
   {
-    if(collect_[func]) {
-      if(bytes_sent > 0) {
-        int bin = binid(bytes_sent);
-        if(bin >= maxbin_) bin = maxbin_ - 1;
-        sends_.at(bin)++;
-      }
-      if(bytes_recvd > 0) {
-        int bin = binid(bytes_sent);
-        if(bin >= maxbin_) bin = maxbin_ - 1;
-        recvs_.at(bin)++;
+    const dumpi_function *func = &batch.func[0];
+    const int64_t *bytes_sent = &batch.bytes_sent[0];
+    const int64_t *bytes_recvd = &batch.bytes_recvd[0];
+    for(size_t i = first; i < last; ++i) {
+      if(collect_[func[i]]) {
+        if(bytes_sent[i] > 0)
+          sends_[binid(bytes_sent[i])]++;
+        if(bytes_recvd[i] > 0)
+          recvs_[binid(bytes_recvd[i])]++;
       }
     }
   }
@@ -45,6 +45,9 @@ Questions? Contact sst-macro-help@sandia.gov
 #ifndef DUMPI_BIN_DUMPISTATS_HANDLERS_H
 #define DUMPI_BIN_DUMPISTATS_HANDLERS_H
 
+#include <dumpi/bin/dumpistats-batch.h>
+#include <dumpi/bin/commatrix.h>
+#include <dumpi/bin/rollup.h>
 #include <dumpi/common/funclabels.h>
 #include <dumpi/common/types.h>
 #include <iostream>
@@ -54,6 +57,13 @@ Questions? Contact sst-macro-help@sandia.gov
 
 namespace dumpi {
 
+  /**
+   * Flag the functions matching a funcname pattern (all, mpi, sends,
+   * a regular expression, ...) as described in the dumpistats help.
+   */
+  void match_functions(const std::string &pattern,
+                       bool collect[DUMPI_END_OF_STREAM]);
+
   /**
    * Base class for handlers that manage statistics gathering for dumpistats.
    */
@@ -83,20 +93,28 @@ namespace dumpi {
     virtual handlerbase* clone() const = 0;
 
     /// Mark the handler active starting at the given point
-    virtual void mark_active(const dumpi_time *cpu, const dumpi_time *wall,
-                             const dumpi_perfinfo *perf) = 0;
+    virtual void mark_active(const eventstamp &ev) = 0;
 
     /// Mark the handler active starting as of the given point
-    virtual void mark_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                               const dumpi_perfinfo *perf) = 0;
-
-    /// New incoming call.
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg) = 0;
+    virtual void mark_inactive(const eventstamp &ev) = 0;
+
+    /// New incoming calls (entries first up to last of the batch).
+    virtual void handle(const eventbatch &batch, size_t first,
+                        size_t last) = 0;
+
+    /// True if handle_rollup gives the same totals as handling each
+    /// call of a bucket (see rollup).
+    virtual bool rollup_ok() const { return false; }
+
+    /// Add the totals of bucket b of the given rollup.
+    virtual void handle_rollup(const rollup &/*ru*/, size_t /*b*/) {}
+
+    /// Called by the bin right after it writes a row of values() to
+    /// <fileroot>.tbl.  Handlers with output of their own keep it here.
+    virtual void dump_row(const std::string &/*fileroot*/, int /*rank*/) {}
+
+    /// Called once before the bin goes out of scope.
+    virtual void finish() {}
   };
 
   class counter : public handlerbase {
@@ -108,20 +126,18 @@ namespace dumpi {
     virtual const std::vector<std::string>& description() const;
     virtual const std::vector<std::string>& values() const;
     virtual handlerbase* clone() const;
-    virtual void mark_active(const dumpi_time *cpu, const dumpi_time *wall,
-                             const dumpi_perfinfo *perf);
-    virtual void mark_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                               const dumpi_perfinfo *perf);
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg);
+    virtual void mark_active(const eventstamp &ev);
+    virtual void mark_inactive(const eventstamp &ev);
+    virtual void handle(const eventbatch &batch, size_t first, size_t last);
+    virtual bool rollup_ok() const { return true; }
+    virtual void handle_rollup(const rollup &ru, size_t b);
   };
 
   class timer : public handlerbase {
-    dumpi_time last_cpu_, last_wall_;
+    int64_t last_cpu_stop_, last_wall_stop_;
+    bool started_;
+    /// The first call since mark_active has not been handled yet.
+    bool fresh_;
     int64_t cpu_inside_mpi_, cpu_outside_mpi_;
     int64_t wall_inside_mpi_, wall_outside_mpi_;
   public:
@@ -131,16 +147,11 @@ namespace dumpi {
     virtual const std::vector<std::string>& description() const;
     virtual const std::vector<std::string>& values() const;
     virtual handlerbase* clone() const;
-    virtual void mark_active(const dumpi_time *cpu, const dumpi_time *wall,
-                             const dumpi_perfinfo *perf);
-    virtual void mark_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                               const dumpi_perfinfo *perf);
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg);
+    virtual void mark_active(const eventstamp &ev);
+    virtual void mark_inactive(const eventstamp &ev);
+    virtual void handle(const eventbatch &batch, size_t first, size_t last);
+    virtual bool rollup_ok() const { return true; }
+    virtual void handle_rollup(const rollup &ru, size_t b);
   };
 
   class sender : public handlerbase {
@@ -152,16 +163,11 @@ namespace dumpi {
     virtual const std::vector<std::string>& description() const;
     virtual const std::vector<std::string>& values() const;
     virtual handlerbase* clone() const;
-    virtual void mark_active(const dumpi_time *cpu, const dumpi_time *wall,
-                             const dumpi_perfinfo *perf);
-    virtual void mark_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                               const dumpi_perfinfo *perf);
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg);
+    virtual void mark_active(const eventstamp &ev);
+    virtual void mark_inactive(const eventstamp &ev);
+    virtual void handle(const eventbatch &batch, size_t first, size_t last);
+    virtual bool rollup_ok() const { return true; }
+    virtual void handle_rollup(const rollup &ru, size_t b);
   };
 
   class recver : public handlerbase {
@@ -173,22 +179,28 @@ namespace dumpi {
     virtual const std::vector<std::string>& description() const;
     virtual const std::vector<std::string>& values() const;
     virtual handlerbase* clone() const;
-    virtual void mark_active(const dumpi_time *cpu, const dumpi_time *wall,
-                             const dumpi_perfinfo *perf);
-    virtual void mark_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                               const dumpi_perfinfo *perf);
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg);
+    virtual void mark_active(const eventstamp &ev);
+    virtual void mark_inactive(const eventstamp &ev);
+    virtual void handle(const eventbatch &batch, size_t first, size_t last);
+    virtual bool rollup_ok() const { return true; }
+    virtual void handle_rollup(const rollup &ru, size_t b);
   };
 
+  /**
+   * Point-to-point traffic between ranks.  The table gets per-rank totals;
+   * the full exchange goes to a sparse matrix per table file, written as
+   * <fileroot>.x<index>.csr (see commatrix) when the bin is done.
+   */
   class exchanger : public handlerbase {
     std::string pat_;
-    std::vector<int64_t> sent_;
-    int collsent_, collrecvd_;
+    /// Distinguishes the output of several --exchange options.
+    int index_;
+    /// Peers sent to by the current rank, sorted by peer.
+    std::vector<commatrix::cell> sent_;
+    int64_t collsent_, collrecvd_;
+    /// One matrix per table file.
+    std::map<std::string, commatrix> matrix_;
+    commatrix::cell& peer(int rank);
   public:
     exchanger(const std::string &pattern);
     virtual ~exchanger();
@@ -196,21 +208,18 @@ namespace dumpi {
     virtual const std::vector<std::string>& description() const;
     virtual const std::vector<std::string>& values() const;
     virtual handlerbase* clone() const;
-    virtual void mark_active(const dumpi_time *cpu, const dumpi_time *wall,
-                             const dumpi_perfinfo *perf);
-    virtual void mark_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                               const dumpi_perfinfo *perf);
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg);
+    virtual void mark_active(const eventstamp &ev);
+    virtual void mark_inactive(const eventstamp &ev);
+    virtual void handle(const eventbatch &batch, size_t first, size_t last);
+    virtual void dump_row(const std::string &fileroot, int rank);
+    virtual void finish();
   };
 
   class perfcounter : public handlerbase {
-    typedef std::map<std::string, int64_t> tracker_t;
-    tracker_t last_out_, inside_mpi_, outside_mpi_;
+    /// Indexed by perfslots slot; the flags record which totals exist.
+    std::vector<int64_t> last_out_, inside_mpi_, outside_mpi_;
+    std::vector<char> has_last_, has_inside_, has_outside_;
+    void grow();
   public:
     perfcounter(const std::string &pattern);
     virtual ~perfcounter();
@@ -218,16 +227,9 @@ namespace dumpi {
     virtual const std::vector<std::string>& description() const;
     virtual const std::vector<std::string>& values() const;
     virtual handlerbase* clone() const;
-    virtual void mark_active(const dumpi_time *cpu, const dumpi_time *wall,
-                             const dumpi_perfinfo *perf);
-    virtual void mark_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                               const dumpi_perfinfo *perf);
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg);
+    virtual void mark_active(const eventstamp &ev);
+    virtual void mark_inactive(const eventstamp &ev);
+    virtual void handle(const eventbatch &batch, size_t first, size_t last);
   };
 
   class lumper : public handlerbase {
@@ -242,16 +244,9 @@ namespace dumpi {
     virtual const std::vector<std::string>& description() const;
     virtual const std::vector<std::string>& values() const;
     virtual handlerbase* clone() const;
-    virtual void mark_active(const dumpi_time *cpu, const dumpi_time *wall,
-                             const dumpi_perfinfo *perf);
-    virtual void mark_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                               const dumpi_perfinfo *perf);
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg);
+    virtual void mark_active(const eventstamp &ev);
+    virtual void mark_inactive(const eventstamp &ev);
+    virtual void handle(const eventbatch &batch, size_t first, size_t last);
   };
 
 } // end of namespace dumpi
@@ -0,0 +1,209 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bin/dumpistats-profile.h>
+#include <dumpi/bin/dumpistats-handlers.h>
+#include <dumpi/bin/commatrix.h>
+#include <dumpi/libundumpi/libundumpi.h>
+#include <dumpi/common/io.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+#include <string.h>
+#include <stdlib.h>
+
+namespace dumpi {
+
+  profilesummary::profilesummary(const std::string &pattern) :
+    pat_(pattern)
+  {
+    match_functions(pattern, collect_);
+  }
+
+  static void open_table(std::ofstream &out, const std::string &fname) {
+    out.open(fname.c_str());
+    if(! out) {
+      std::cerr << "profile:  Failed to open outfile " << fname << "\n";
+      throw "profile:  Failed to open outfile.";
+    }
+  }
+
+  void profilesummary::write(const metadata &meta,
+                             const std::string &fileroot) const
+  {
+    std::ofstream tbl, hist;
+    open_table(tbl, fileroot + ".tbl");
+    tbl << "########################################################\n"
+        << "# Profile-mode call statistics for calls matching \""
+        << pat_ << "\"\n"
+        << "#\n"
+        << "# Column 1 is rank\n"
+        << "# Column 2 is function\n"
+        << "# Column 3 is number of calls\n"
+        << "# Column 4 is total time in the calls (ns)\n"
+        << "# Column 5 is shortest call (ns)\n"
+        << "# Column 6 is longest call (ns)\n"
+        << "# Column 7 is message bytes\n"
+        << "#\n# ";
+    for(int lbl = 1; lbl <= 7; ++lbl)
+      tbl << std::setw(20) << lbl << " ";
+    tbl << "\n";
+
+    dumpi_callstats *stats = new dumpi_callstats;
+    std::vector<dumpi_callstats_entry> total(DUMPI_ALL_FUNCTIONS);
+    memset(&total[0], 0, DUMPI_ALL_FUNCTIONS*sizeof(dumpi_callstats_entry));
+    commatrix matrix(meta.numTraces());
+    std::map<std::pair<int32_t,int32_t>, std::pair<int64_t,int64_t> > colls;
+    int missing = 0;
+    for(int rank = 0; rank < meta.numTraces(); ++rank) {
+      std::string fname = meta.tracename(rank);
+      dumpi_profile *profile = undumpi_open(fname.c_str());
+      if(profile == NULL) {
+        delete stats;
+        throw "profile:  Failed to open trace file.";
+      }
+      dumpi_commstats comm;
+      dumpi_read_callstats(profile, stats);
+      dumpi_read_commstats(profile, &comm);
+      undumpi_close(profile);
+      free(profile);
+      if(stats->threads == 0 && comm.rank < 0) {
+        ++missing;
+        continue;
+      }
+      if(comm.rank >= 0) {
+        std::vector<commatrix::cell> cells(comm.peers);
+        for(int i = 0; i < comm.peers; ++i) {
+          cells[i].peer = comm.peer[i].peer;
+          cells[i].bytes = comm.peer[i].bytes;
+          cells[i].count = comm.peer[i].messages;
+        }
+        matrix.add_row(comm.rank, cells);
+        for(int i = 0; i < comm.colls; ++i) {
+          std::pair<int64_t,int64_t> &coll =
+            colls[std::make_pair(comm.coll[i].size, comm.coll[i].leader)];
+          coll.first += comm.coll[i].calls;
+          coll.second += comm.coll[i].bytes;
+        }
+        dumpi_clear_commstats(&comm);
+      }
+      for(int fn = 0; fn < DUMPI_ALL_FUNCTIONS; ++fn) {
+        const dumpi_callstats_entry &entry = stats->entry[fn];
+        if(! collect_[fn] || entry.count == 0)
+          continue;
+        dumpi_merge_callstats_entry(&total[fn], &entry);
+        tbl << std::setw(22) << rank << " "
+            << std::setw(20) << dumpi_function_label(dumpi_function(fn)) << " "
+            << std::setw(20) << entry.count << " "
+            << std::setw(20) << entry.total_ns << " "
+            << std::setw(20) << entry.min_ns << " "
+            << std::setw(20) << entry.max_ns << " "
+            << std::setw(20) << entry.bytes << "\n";
+      }
+    }
+    delete stats;
+    if(missing > 0)
+      std::cerr << "profile:  " << missing << " of " << meta.numTraces()
+                << " traces have no call statistics (they were not written"
+                << " with mode=profile)\n";
+    if(matrix.rows() > 0) {
+      matrix.write(fileroot + ".csr");
+      std::ofstream coll;
+      open_table(coll, fileroot + ".coll");
+      coll << "########################################################\n"
+           << "# Collective traffic by communicator, summed over members\n"
+           << "#\n"
+           << "# Column 1 is communicator size\n"
+           << "# Column 2 is the MPI_COMM_WORLD rank of its rank 0\n"
+           << "# Column 3 is number of calls (counted once per member)\n"
+           << "# Column 4 is bytes contributed by the members\n"
+           << "#\n# ";
+      for(int lbl = 1; lbl <= 4; ++lbl)
+        coll << std::setw(20) << lbl << " ";
+      coll << "\n";
+      std::map<std::pair<int32_t,int32_t>,
+               std::pair<int64_t,int64_t> >::const_iterator it;
+      for(it = colls.begin(); it != colls.end(); ++it)
+        coll << std::setw(22) << it->first.first << " "
+             << std::setw(20) << it->first.second << " "
+             << std::setw(20) << it->second.first << " "
+             << std::setw(20) << it->second.second << "\n";
+    }
+
+    open_table(hist, fileroot + ".hist");
+    hist << "########################################################\n"
+         << "# Profile-mode histograms for calls matching \""
+         << pat_ << "\", summed over all ranks\n"
+         << "#\n"
+         << "# Column 1 is function\n"
+         << "# Column 2 is the lower bound of the bucket\n"
+         << "# Column 3 is the upper bound of the bucket (-1 if open)\n"
+         << "# Column 4 is number of calls taking that many ns\n"
+         << "# Column 5 is number of calls moving that many bytes\n"
+         << "#\n# ";
+    for(int lbl = 1; lbl <= 5; ++lbl)
+      hist << std::setw(20) << lbl << " ";
+    hist << "\n";
+    for(int fn = 0; fn < DUMPI_ALL_FUNCTIONS; ++fn) {
+      const dumpi_callstats_entry &entry = total[fn];
+      if(entry.count == 0)
+        continue;
+      for(int b = 0; b < DUMPI_CALLSTATS_BUCKETS; ++b) {
+        if(entry.time_hist[b] == 0 && entry.size_hist[b] == 0)
+          continue;
+        int64_t lo = (b == 0 ? 0 : int64_t(1) << (b-1));
+        int64_t hi = (b == 0 ? 0 : (b == DUMPI_CALLSTATS_BUCKETS-1 ? -1 :
+                                    (int64_t(1) << b) - 1));
+        hist << std::setw(22) << dumpi_function_label(dumpi_function(fn)) << " "
+             << std::setw(20) << lo << " "
+             << std::setw(20) << hi << " "
+             << std::setw(20) << entry.time_hist[b] << " "
+             << std::setw(20) << entry.size_hist[b] << "\n";
+      }
+    }
+  }
+
+} // end of namespace dumpi
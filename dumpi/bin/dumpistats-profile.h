@@ -0,0 +1,76 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_BIN_DUMPISTATS_PROFILE_H
+#define DUMPI_BIN_DUMPISTATS_PROFILE_H
+
+#include <dumpi/bin/metadata.h>
+#include <dumpi/common/types.h>
+#include <string>
+
+namespace dumpi {
+
+  /**
+   * Summarize the call statistics written by libdumpi in profile mode
+   * (mode=profile in dumpi.conf).  These traces have no call stream,
+   * so the time bins and handlers have nothing to work with.
+   */
+  class profilesummary {
+    std::string pat_;
+    bool collect_[DUMPI_END_OF_STREAM];
+
+  public:
+    profilesummary(const std::string &pattern);
+
+    /// Read the call statistics of every trace in the metafile and write
+    /// <fileroot>.tbl (one row per rank and function) and <fileroot>.hist
+    /// (the duration and message size histograms summed over all ranks).
+    /// Traces with a communication matrix also get <fileroot>.csr (see
+    /// commatrix) and <fileroot>.coll (collective traffic by communicator).
+    void write(const metadata &meta, const std::string &fileroot) const;
+  };
+
+} // end of namespace dumpi
+
+#endif // ! DUMPI_BIN_DUMPISTATS_PROFILE_H
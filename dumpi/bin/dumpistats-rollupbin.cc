@@ -0,0 +1,147 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bin/dumpistats-rollupbin.h>
+#include <dumpi/bin/dumpistats-callbacks.h>
+#include <iostream>
+#include <thread>
+#include <atomic>
+
+namespace dumpi {
+
+  //
+  // Collect with the given bucket width.
+  //
+  rollupbin::rollupbin(int64_t width) :
+    traces_(NULL), width_(width)
+  {}
+
+  //
+  // Bye.
+  //
+  rollupbin::~rollupbin() {
+  }
+
+  //
+  // Handlers are not used.
+  //
+  void rollupbin::init(const std::string &,
+                       const std::vector<trace> *traces,
+                       const std::vector<handlerbase*>)
+  {
+    traces_ = traces;
+  }
+
+  //
+  // Sum up a batch of MPI calls.
+  //
+  void rollupbin::handle(const eventbatch &batch) {
+    for(size_t i = 0; i < batch.size; ++i)
+      rollup_.add(batch.func[i], batch.cpu_start[i], batch.cpu_stop[i],
+                  batch.wall_start[i], batch.wall_stop[i],
+                  batch.bytes_sent[i], batch.to_rank[i],
+                  batch.bytes_recvd[i], batch.from_rank[i]);
+  }
+
+  //
+  // Buckets are counted from the start of the trace.
+  //
+  void rollupbin::start_trace(int rank) {
+    const trace &curr = traces_->at(rank);
+    rollup_.begin(rank, flatten(curr.start_time()), width_);
+    rollup_.set_times(curr.start_time(), curr.stop_time(),
+                      curr.init_time(), curr.finalize_time());
+  }
+
+  //
+  // Finish the current rollup.
+  //
+  void rollupbin::reset_trace() {
+    rollup_.end();
+  }
+
+  //
+  // Build rollups, spreading the traces over worker threads.
+  // Each worker has its own callbacks and bin.
+  //
+  void rollupbin::build(const metadata &meta, std::vector<trace> &traces,
+                        const std::vector<int> &ranks)
+  {
+    size_t nthread = std::thread::hardware_concurrency();
+    if(nthread < 1) nthread = 1;
+    if(nthread > ranks.size()) nthread = ranks.size();
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> workers;
+    for(size_t t = 0; t < nthread; ++t) {
+      workers.push_back(std::thread([&]() {
+            callbacks cb;
+            rollupbin bin;
+            bin.init("", &traces, std::vector<handlerbase*>());
+            std::vector<binbase*> bins(1, &bin);
+            size_t i;
+            while((i = next++) < ranks.size()) {
+              std::string tname = meta.tracename(ranks[i]);
+              try {
+                cb.go(meta, traces, bins, ranks[i]);
+                bin.reset_trace();
+                rollup ru(bin.result());
+                if(! ru.set_source(tname))
+                  throw "rollupbin:  Failed to stat trace file.";
+                ru.write(rollup::sidecar(tname));
+              }
+              catch(const char *desc) {
+                std::cerr << tname << ":  " << desc << "\n";
+                failed = true;
+              }
+            }
+          }));
+    }
+    for(size_t t = 0; t < workers.size(); ++t)
+      workers[t].join();
+    if(failed)
+      throw "rollupbin:  Failed to write rollups.";
+  }
+
+} // end of namespace dumpi
@@ -0,0 +1,105 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_BIN_DUMPISTATS_ROLLUPBIN_H
+#define DUMPI_BIN_DUMPISTATS_ROLLUPBIN_H
+
+#include <dumpi/bin/dumpistats-binbase.h>
+#include <dumpi/bin/metadata.h>
+#include <dumpi/bin/rollup.h>
+#include <dumpi/bin/trace.h>
+#include <vector>
+
+namespace dumpi {
+
+  /**
+   * Collect the rollup of a trace for dumpistats (see rollup).
+   * Handlers are ignored; the bin only sums calls into buckets.
+   */
+  class rollupbin : public binbase {
+    /// The preparsed trace info.
+    const std::vector<trace> *traces_;
+
+    /// The rollup for the current trace.
+    rollup rollup_;
+
+    /// Bucket width (nanoseconds).
+    int64_t width_;
+
+    /// Blocked assignment operator.
+    void operator=(const rollupbin&) {}
+
+  public:
+    /// Collect with the given bucket width (nanoseconds).
+    rollupbin(int64_t width = rollup::default_width);
+
+    /// Bye.
+    virtual ~rollupbin();
+
+    /// Handlers are not used.
+    virtual void init(const std::string &binid,
+                      const std::vector<trace> *traces,
+                      const std::vector<handlerbase*> handlers);
+
+    /// Process a batch of MPI calls.
+    virtual void handle(const eventbatch &batch);
+
+    /// Start the rollup for a new trace.
+    virtual void start_trace(int rank);
+
+    /// Finish the rollup of the current trace.
+    virtual void reset_trace();
+
+    /// The rollup of the last trace.
+    const rollup& result() const { return rollup_; }
+
+    /// Write rollup::sidecar files for the given ranks, reading several
+    /// traces at a time.  Throws if any of them could not be written.
+    static void build(const metadata &meta, std::vector<trace> &traces,
+                      const std::vector<int> &ranks);
+  };
+
+} // end of namespace dumpi
+
+#endif // ! DUMPI_BIN_DUMPISTATS_ROLLUPBIN_H
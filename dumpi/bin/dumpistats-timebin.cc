@@ -173,7 +173,7 @@ namespace dumpi {
   void timebin::dump_output() {
     if(callcount_ > 0) {
       if(current_rank_ >= 0) {
-        mark_handlers_inactive(&last_cpu_, &last_wall_, &last_perf_);
+        mark_handlers_inactive(last_);
         if(file_.find(current_bin_) == file_.end()) {
           // Open a file for this bin.
           std::stringstream ss;
@@ -225,12 +225,13 @@ namespace dumpi {
           }
         }
         //*file_[current_bin_] << "# Bounds: " << begin_<< " to "<< end_<< "\n";
-        dumpi_time last_t_ = last_wall_;
-        dumpi_clock delta_t_ = last_t_.stop - first_t_.start;
+        dumpi_clock first_t_ = unflatten(first_wall_start_);
+        dumpi_clock last_t_ = unflatten(last_.wall_stop);
+        dumpi_clock delta_t_ = last_t_ - first_t_;
         *file_[current_bin_] << std::setw(22) << current_rank_ << " "
                              << std::setw(22) << 1 << " "
-                             << std::setw(20) << first_t_.start << " "
-                             << std::setw(20) << last_t_.stop << " "
+                             << std::setw(20) << first_t_ << " "
+                             << std::setw(20) << last_t_ << " "
                              << std::setw(20) << delta_t_ << " ";
         for(size_t i = 0; i < handlers_.size(); ++i) {
           const std::vector<std::string> &values = handlers_[i]->values();
@@ -239,6 +240,10 @@ namespace dumpi {
                                  << values.at(j) << " ";
         }
         *file_[current_bin_] << std::endl;
+        std::stringstream root;
+        root << binid_ << "-" << current_bin_;
+        for(size_t i = 0; i < handlers_.size(); ++i)
+          handlers_[i]->dump_row(root.str(), current_rank_);
         callcount_ = 0;
       }
     }
@@ -255,23 +260,17 @@ namespace dumpi {
   //
   // Private method to activate all handlers.
   //
-  void timebin::mark_handlers_active(const dumpi_time *cpu,
-                                     const dumpi_time *wall,
-                                     const dumpi_perfinfo *perf)
-  {
+  void timebin::mark_handlers_active(const eventstamp &ev) {
     for(size_t i = 0; i < handlers_.size(); ++i)
-      handlers_[i]->mark_active(cpu, wall, perf);
+      handlers_[i]->mark_active(ev);
   }
 
   //
   // Private method to deactivate all handlers.
   //
-  void timebin::mark_handlers_inactive(const dumpi_time *cpu,
-                                       const dumpi_time *wall,
-                                       const dumpi_perfinfo *perf)
-  {
+  void timebin::mark_handlers_inactive(const eventstamp &ev) {
     for(size_t i = 0; i < handlers_.size(); ++i)
-      handlers_[i]->mark_inactive(cpu, wall, perf);
+      handlers_[i]->mark_inactive(ev);
   }
 
   //
@@ -350,8 +349,10 @@ namespace dumpi {
   timebin::~timebin() {
     if(callcount_ > 0)
       this->dump_output();
-    for(size_t i = 0; i < handlers_.size(); ++i)
+    for(size_t i = 0; i < handlers_.size(); ++i) {
+      handlers_[i]->finish();
       delete handlers_[i];
+    }
   }
 
   //
@@ -369,52 +370,66 @@ namespace dumpi {
   }
 
   //
-  // Process the given MPI call type.
+  // Write out the current bin and start collecting into another one,
+  // beginning with the given call.
   //
-  void timebin::handle(dumpi_function func, uint16_t thread,
-                       const dumpi_time *cpu, const dumpi_time *wall,
-                       const dumpi_perfinfo *perf,
-                       int64_t bytes_sent, int to_global_rank,
-                       int64_t bytes_recvd, int from_global_rank,
-                       const void *dumpi_arg)
-  {
-    // Figure out which bin (if any) this goes into.
-    int64_t flattime = wall->start.sec * int64_t(1e9) + wall->start.nsec;
-    int newbin = -1;
-    //std::cerr << "timebin::handle(" << func << ") at " 
-    //          << wall->start << "\n";
-    if((flattime >= begin_) && (flattime < end_)) {
+  void timebin::start_bin(int newbin, const eventstamp &ev) {
+    this->dump_output();
+    this->clear_handlers();
+    first_wall_start_ = ev.wall_start;
+    this->mark_handlers_active(ev);
+    if(file_.find(current_bin_) != file_.end()) {
+      *file_[current_bin_] << std::flush;
+      file_[current_bin_]->close();
+    }
+    current_bin_ = newbin;
+    callcount_ = 0;
+  }
+
+  //
+  // Process a batch of MPI calls.
+  // Consecutive calls that land in the same bin are handed to the
+  // handlers as a single run.
+  //
+  void timebin::handle(const eventbatch &batch) {
+    const int64_t *wall_start = &batch.wall_start[0];
+    size_t i = 0;
+    while(i < batch.size) {
+      // Figure out which bin (if any) this goes into.
+      int64_t flattime = wall_start[i];
+      if(! ((flattime >= begin_) && (flattime < end_))) {
+        ++i;
+        continue;
+      }
+      int newbin = 0;
       if(bin_size_ > 0)
         newbin = static_cast<int>((flattime - begin_) / bin_size_);
-      else
-        newbin = 0;
       if(newbin != current_bin_) {
-        this->dump_output();
-        this->clear_handlers();
-        first_t_ = *wall;
-        this->mark_handlers_active(cpu, wall, perf);
-        if(file_.find(current_bin_) != file_.end()) {
-          *file_[current_bin_] << std::flush;
-          file_[current_bin_]->close();
-        }
-        current_bin_ = newbin;
-        callcount_ = 0;
+        eventstamp ev;
+        batch.stamp(i, ev);
+        this->start_bin(newbin, ev);
       }
-      ++callcount_;
-      last_cpu_ = *cpu;
-      last_wall_ = *wall;
-      last_perf_ = *perf;
-      for(size_t i = 0; i < handlers_.size(); ++i)
-        handlers_[i]->handle(func, thread, cpu, wall, perf,
-                             bytes_sent, to_global_rank,
-                             bytes_recvd, from_global_rank, dumpi_arg);
+      // Extend the run as far as the bin reaches.
+      int64_t binend = end_;
+      if(bin_size_ > 0 && begin_ + (newbin+1) * bin_size_ < binend)
+        binend = begin_ + (newbin+1) * bin_size_;
+      size_t j = i + 1;
+      while(j < batch.size && wall_start[j] >= begin_ &&
+            wall_start[j] < binend)
+        ++j;
+      callcount_ += int(j - i);
+      batch.stamp(j-1, last_);
+      for(size_t h = 0; h < handlers_.size(); ++h)
+        handlers_[h]->handle(batch, i, j);
+      i = j;
     }
   }
 
   //
   // Figure out timestamp.
   //
-  int64_t timebin::resolve_time(refpoint type, int64_t bias, const trace &curr) const
+  template <typename T>
+  int64_t timebin::resolve_time(refpoint type, int64_t bias, const T &curr) const
   {
     dumpi_clock clk = {0, 0};
     switch(type) {
@@ -436,6 +451,17 @@ namespace dumpi {
     return (clk.sec * int64_t(1e9) + clk.nsec + bias);
   }
 
+  //
+  // Time window for a trace (or its rollup).
+  //
+  template <typename T>
+  void timebin::bounds(const T &curr, int64_t &begin, int64_t &end) const {
+    begin = resolve_time(begin_ref_, begin_bias_, curr);
+    end = resolve_time(end_ref_, end_bias_, curr);
+    if(bin_size_ <= 0)
+      end += 1;
+  }
+
   //
   // Reset counters and internal state in preparation for a new trace.
   //
@@ -445,15 +471,63 @@ namespace dumpi {
       current_bin_ = -1;
       current_rank_ = rank;
       // Figure out the bounds.
-      const trace &curr = traces_->at(rank);
-      begin_ = resolve_time(begin_ref_, begin_bias_, curr);
-      end_ = resolve_time(end_ref_, end_bias_, curr);
-      if(bin_size_ <= 0)
-        end_ += 1;
+      this->bounds(traces_->at(rank), begin_, end_);
       //std::cerr << "DEBUG:  begin_ = " << begin_ << ", end_ = " << end_ << "\n";
     }
   }
 
+  //
+  // Can the rollup stand in for the trace?  Every bucket has to fall
+  // inside a single bin (or outside the window) as a whole.
+  //
+  bool timebin::covers(const rollup &ru) const {
+    if(! ru.ordered())
+      return false;
+    for(size_t h = 0; h < handlers_.size(); ++h)
+      if(! handlers_[h]->rollup_ok())
+        return false;
+    int64_t begin, end;
+    this->bounds(ru, begin, end);
+    for(size_t b = 0; b < ru.buckets(); ++b) {
+      int64_t first = ru.first_wall_start(b), last = ru.last_wall_start(b);
+      bool first_in = (first >= begin && first < end);
+      bool last_in = (last >= begin && last < end);
+      if(first_in != last_in)
+        return false;
+      if(first_in && bin_size_ > 0 &&
+         (first - begin) / bin_size_ != (last - begin) / bin_size_)
+        return false;
+    }
+    return true;
+  }
+
+  //
+  // Fill the bin from a rollup, one bucket at a time.
+  //
+  void timebin::replay(const rollup &ru) {
+    this->reset_trace();
+    current_bin_ = -1;
+    current_rank_ = ru.rank();
+    this->bounds(ru, begin_, end_);
+    for(size_t b = 0; b < ru.buckets(); ++b) {
+      int64_t flattime = ru.first_wall_start(b);
+      if(! ((flattime >= begin_) && (flattime < end_)))
+        continue;
+      int newbin = 0;
+      if(bin_size_ > 0)
+        newbin = static_cast<int>((flattime - begin_) / bin_size_);
+      if(newbin != current_bin_) {
+        eventstamp ev;
+        ru.first_stamp(b, ev);
+        this->start_bin(newbin, ev);
+      }
+      callcount_ += int(ru.calls(b));
+      ru.last_stamp(b, last_);
+      for(size_t h = 0; h < handlers_.size(); ++h)
+        handlers_[h]->handle_rollup(ru, b);
+    }
+  }
+
   //
   // Clear handlers in preparation for another bin.
   //
@@ -88,12 +88,11 @@ namespace dumpi {
     /// State flags.
     bool initialized_, active_;
 
-    /// First timestamp seen in a bin.
-    dumpi_time first_t_;
-    /// Last active stamps encountered -- used to wrap up last trace
+    /// First (flattened) wall-clock start time seen in a bin.
+    int64_t first_wall_start_;
+    /// Last active call encountered -- used to wrap up last trace
     /// if the bin exist while active.
-    dumpi_time last_cpu_, last_wall_;
-    dumpi_perfinfo last_perf_;
+    eventstamp last_;
 
     refpoint  begin_ref_, end_ref_;
 
@@ -122,18 +121,24 @@ namespace dumpi {
     void clear_handlers();
 
     /// Private method to activate all handlers.
-    void mark_handlers_active(const dumpi_time *cpu, const dumpi_time *wall,
-                              const dumpi_perfinfo *perf);
+    void mark_handlers_active(const eventstamp &ev);
 
     /// Private method to deactivate all handlers.
-    void mark_handlers_inactive(const dumpi_time *cpu, const dumpi_time *wall,
-                                const dumpi_perfinfo *perf);
+    void mark_handlers_inactive(const eventstamp &ev);
 
     /// Private method to turn a description pattern into a time window.
     void compute_interval();
 
-    /// Private method to figure out time stamps.
-    int64_t resolve_time(refpoint type, int64_t bias, const trace &curr) const;
+    /// Private method to start collecting into a new bin.
+    void start_bin(int newbin, const eventstamp &ev);
+
+    /// Private method to figure out time stamps (from a trace or rollup).
+    template <typename T>
+    int64_t resolve_time(refpoint type, int64_t bias, const T &curr) const;
+
+    /// Private method to figure out the time window for a trace or rollup.
+    template <typename T>
+    void bounds(const T &curr, int64_t &begin, int64_t &end) const;
 
     /// Blocked assignment operator.
     void operator=(const timebin&) {}
@@ -151,13 +156,15 @@ namespace dumpi {
                       const std::vector<trace> *traces,
                       const std::vector<handlerbase*> handlers);
 
-    /// Process the given MPI call type.
-    virtual void handle(dumpi_function func, uint16_t thread,
-                        const dumpi_time *cpu, const dumpi_time *wall,
-                        const dumpi_perfinfo *perf,
-                        int64_t bytes_sent, int to_global_rank,
-                        int64_t bytes_recvd, int from_global_rank,
-                        const void *dumpi_arg);
+    /// Process a batch of MPI calls.
+    virtual void handle(const eventbatch &batch);
+
+    /// True if every bucket of the rollup falls into a single bin and
+    /// all handlers can work from bucket totals.
+    virtual bool covers(const rollup &ru) const;
+
+    /// Fill the bin from a rollup rather than from the trace.
+    virtual void replay(const rollup &ru);
 
     /// Reset counters and internal state in preparation for a new trace.
     /// Forces a flush of all active handlers unless callcount_ is zero.
@@ -48,6 +48,9 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/bin/dumpistats-gatherbin.h>
 #include <dumpi/bin/dumpistats-handlers.h>
 #include <dumpi/bin/dumpistats-callbacks.h>
+#include <dumpi/bin/dumpistats-profile.h>
+#include <dumpi/bin/dumpistats-rollupbin.h>
+#include <dumpi/bin/p2pmatch.h>
 #include <sstream>
 #include <getopt.h>
 #include <stdio.h>
@@ -69,6 +72,9 @@ static const struct option longopts[] = {
   {"exchange", required_argument, NULL, 'x'},
   {"lump", required_argument, NULL, 'l'},
   {"perfctr", required_argument, NULL, 'p'},
+  {"aggregate", required_argument, NULL, 'a'},
+  {"match", no_argument, NULL, 'M'},
+  {"rollup", no_argument, NULL, 'R'},
   {"in", required_argument, NULL, 'i'},
   {"out", required_argument, NULL, 'o'},
   {NULL, 0, NULL, 0}
@@ -86,9 +92,13 @@ void print_help(const std::string &name) {
             << "   (-t|--time)     funcname   Accumulate time in a function\n"
             << "   (-s|--sent)     funcname   Count bytes sent by a function\n"
             << "   (-r|--recvd)    funcname   Count bytes recvd by function\n"
-            << "   (-x|--exchange) funcname   Full send/recv exchange info\n"
+            << "   (-x|--exchange) funcname   Sparse send matrix (see dumpimatrix)\n"
             << "   (-l|--lump)     funcname   Lump (bin) messages by size\n"
             << "   (-p|--perfctr)  funcname   PAPI perfcounter info\n"
+            << "   (-a|--aggregate) funcname  Call statistics from traces\n"
+            << "                              written with mode=profile\n"
+            << "   (-M|--match)               Pair sends with receives\n"
+            << "   (-R|--rollup)              Keep per-trace rollup files\n"
             << "   (-i|--in)       metafile   DUMPI metafile (required)\n"
             << "   (-o|--out)      fileroot   Output file root (required)\n"
             << "\n"
@@ -136,15 +146,53 @@ void print_help(const std::string &name) {
             << "         -i dumpi.meta -o stats \\\n"
             << "      Writes a new file containing bytes sent and received\n"
             << "      starting 10 seconds after first and ending 10 seconds\n"
-            << "      before last simulation timestamp\n";
+            << "      before last simulation timestamp\n"
+            << "\n"
+            << "Example 4\n"
+            << "  " << name << "  --aggregate=mpi -i dumpi.meta -o stats\n"
+            << "      For traces written in profile mode, writes per-rank\n"
+            << "      call counts, times and bytes to stats-profile0.tbl and\n"
+            << "      duration/size histograms to stats-profile0.hist\n"
+            << "      (and, with commmatrix enabled, the communication\n"
+            << "      matrix to stats-profile0.csr and stats-profile0.coll)\n"
+            << "\n"
+            << "Example 5\n"
+            << "  " << name << "  --match -i dumpi.meta -o stats\n"
+            << "      Pairs every point-to-point send with its receive and\n"
+            << "      writes one row per message (ranks, tag, bytes, post\n"
+            << "      and completion times, late sender or receiver) to\n"
+            << "      stats-match.dat, with the totals in stats-match.sum\n"
+            << "\n"
+            << "Example 6\n"
+            << "  " << name << "  --rollup --bin='init to finalize by 0.01' \\\n"
+            << "         -c mpi -t mpi -s all -r all -i dumpi.meta -o stats\n"
+            << "      Also writes a .rollup file next to each .bin file with\n"
+            << "      counts, times and bytes per function in 1 ms buckets.\n"
+            << "      Later runs that only use --count, --time, --sent and\n"
+            << "      --recvd with time bins read these instead of the\n"
+            << "      traces, as long as the traces are unchanged and no\n"
+            << "      bucket straddles a bin boundary (bin widths that are\n"
+            << "      multiples of 1 ms always qualify).\n";
+}
+
+// Can all bins be filled from the rollups alone?
+static bool covered(const std::vector<binbase*> &bin,
+                    const std::vector<rollup> &rollups)
+{
+  for(size_t i = 0; i < bin.size(); ++i)
+    for(size_t r = 0; r < rollups.size(); ++r)
+      if(! bin.at(i)->covers(rollups.at(r)))
+        return false;
+  return true;
 }
 
 struct options {
-  bool verbose;
+  bool verbose, match, rollup;
   std::string infile, outroot;
   std::vector<binbase*> bin;
   std::vector<handlerbase*> handlers;
-  options() : verbose(false) {}
+  std::vector<profilesummary*> profiles;
+  options() : verbose(false), match(false), rollup(false) {}
 };
 
 int main(int argc, char **argv) {
@@ -207,6 +255,15 @@ int main(int argc, char **argv) {
     case 'p':
       opt.handlers.push_back(new perfcounter(optarg));
       break;
+    case 'a':
+      opt.profiles.push_back(new profilesummary(optarg));
+      break;
+    case 'M':
+      opt.match = true;
+      break;
+    case 'R':
+      opt.rollup = true;
+      break;
     case 'i':
       opt.infile = optarg;
       break;
@@ -230,39 +287,88 @@ int main(int argc, char **argv) {
   }
 
   try {
+    if(opt.verbose) std::cerr << "Parsing metafile\n";
+    metadata meta(opt.infile);
+
+    // Profile-mode statistics come straight from each trace's index.
+    for(size_t i = 0; i < opt.profiles.size(); ++i) {
+      std::stringstream ss;
+      ss << opt.outroot << "-profile" << i;
+      if(opt.verbose) std::cerr << "Writing " << ss.str() << ".tbl\n";
+      opt.profiles.at(i)->write(meta, ss.str());
+      delete opt.profiles.at(i);
+    }
+    // Don't parse the streams if that was all we were asked for.
+    bool stats = ! (opt.bin.empty() && opt.handlers.empty());
+    if(! opt.profiles.empty() && ! stats && ! opt.match && ! opt.rollup)
+      return 0;
+    if(! (opt.match || opt.rollup))
+      stats = true;
+
     // Provide some sensible defaults (time in MPI and non-MPI functions).
-    if(opt.bin.empty())
+    if(stats && opt.bin.empty())
       opt.bin.push_back(new timebin("all"));
-    if(opt.handlers.empty()) {
+    if(stats && opt.handlers.empty()) {
       opt.handlers.push_back(new timer("mpi"));
     }
 
-    // Preparse the streams to get data types etc. correct.
-    if(opt.verbose) std::cerr << "Parsing metafile\n";
-
-    metadata meta(opt.infile);
-
-    // Open traces.
-    if(opt.verbose) std::cout << "Pre-parsing traces.\n";
-    sharedstate shared(meta.numTraces());
-    std::vector<trace> traces;
-    preparse_traces(meta, &shared, traces);
-
     // Tell the handlers about world size.
     if(opt.verbose) std::cerr << "Setting up handlers\n";
     for(size_t i = 0; i < opt.handlers.size(); ++i)
       opt.handlers.at(i)->set_world_size(meta.numTraces());
     // Set up.  Each bin gets a copy of all the handlers.
+    std::vector<trace> traces;
     for(size_t i = 0; i < opt.bin.size(); ++i) {
       std::stringstream ss;
       ss << opt.outroot << "-bin" << i;
       std::string name = ss.str();
       opt.bin.at(i)->init(name, &traces, opt.handlers);
     }
-    callbacks cb;
 
-    if(opt.verbose) std::cerr << "Re-parsing files and building tables\n";
-    cb.go(meta, traces, opt.bin);
+    // Up-to-date rollups can stand in for the traces if every bin
+    // can be filled from bucket totals.
+    std::vector<rollup> rollups;
+    bool fresh = rollup::read_all(meta, rollups);
+    bool replay = (stats && fresh && covered(opt.bin, rollups));
+
+    sharedstate shared(meta.numTraces());
+    if(opt.match || (opt.rollup && ! fresh) || (stats && ! replay)) {
+      // Preparse the streams to get data types etc. correct.
+      // Open traces.
+      if(opt.verbose) std::cout << "Pre-parsing traces.\n";
+      preparse_traces(meta, &shared, traces);
+    }
+
+    if(opt.match) {
+      if(opt.verbose) std::cerr << "Matching point-to-point messages\n";
+      p2pmatch(meta, traces).write(opt.outroot + "-match");
+    }
+
+    if(opt.rollup && ! fresh) {
+      if(opt.verbose) std::cerr << "Writing trace rollups\n";
+      std::vector<int> ranks;
+      for(int rank = 0; rank < meta.numTraces(); ++rank)
+        ranks.push_back(rank);
+      rollupbin::build(meta, traces, ranks);
+      fresh = rollup::read_all(meta, rollups);
+      replay = (stats && fresh && covered(opt.bin, rollups));
+    }
+
+    if(stats) {
+      if(replay) {
+        if(opt.verbose) std::cerr << "Building tables from trace rollups\n";
+        for(size_t i = 0; i < opt.bin.size(); ++i) {
+          for(size_t r = 0; r < rollups.size(); ++r)
+            opt.bin.at(i)->replay(rollups.at(r));
+          opt.bin.at(i)->reset_trace();
+        }
+      }
+      else {
+        callbacks cb;
+        if(opt.verbose) std::cerr << "Re-parsing files and building tables\n";
+        cb.go(meta, traces, opt.bin);
+      }
+    }
     // Clean up.
     for(size_t i = 0; i < opt.bin.size(); ++i)
       delete opt.bin.at(i);
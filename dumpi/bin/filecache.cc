@@ -0,0 +1,181 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bin/filecache.h>
+#include <dumpi/libundumpi/libundumpi.h>
+#include <iostream>
+#include <sys/resource.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+namespace dumpi {
+
+  filecache::filecache(size_t max_open) :
+    max_open_(max_open), open_(0)
+  {
+    if(max_open_ == 0) {
+      const char *envsetting = getenv("DUMPI_MAX_OPEN_FILES");
+      if(envsetting != NULL)
+        max_open_ = atol(envsetting);
+    }
+    if(max_open_ == 0) {
+      struct rlimit lim;
+      max_open_ = 512;
+      if(getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur != RLIM_INFINITY)
+        max_open_ = lim.rlim_cur / 2;
+    }
+    if(max_open_ < 1)
+      max_open_ = 1;
+  }
+
+  filecache::~filecache() {
+    for(size_t i = 0; i < entries_.size(); ++i)
+      if(entries_[i].used)
+        this->remove(i);
+  }
+
+  filecache& filecache::global() {
+    static filecache cache;
+    return cache;
+  }
+
+  filecache::id filecache::add(const std::string &fname) {
+    std::lock_guard<std::mutex> guard(lock_);
+    id file;
+    if(unused_.empty()) {
+      file = entries_.size();
+      entries_.push_back(entry());
+    }
+    else {
+      file = unused_.back();
+      unused_.pop_back();
+    }
+    entry &ent = entries_[file];
+    ent.fname = fname;
+    ent.profile = NULL;
+    ent.pos = 0;
+    ent.pinned = 0;
+    ent.used = true;
+    return file;
+  }
+
+  void filecache::remove(id file) {
+    std::lock_guard<std::mutex> guard(lock_);
+    entry &ent = entries_.at(file);
+    if(! ent.used)
+      return;
+    if(ent.profile != NULL) {
+      if(ent.profile->file != NULL) {
+        if(ent.pinned == 0)
+          lru_.erase(ent.lru);
+        --open_;
+        undumpi_close(ent.profile);
+      }
+      else {
+        dumpi_free_perfctr_cache(ent.profile);
+      }
+      free(ent.profile);
+      ent.profile = NULL;
+    }
+    ent.fname.clear();
+    ent.used = false;
+    unused_.push_back(file);
+  }
+
+  bool filecache::evict() {
+    if(lru_.empty())
+      return false;
+    entry &ent = entries_[lru_.front()];
+    lru_.pop_front();
+    ent.pos = ftello(ent.profile->file);
+    fclose(ent.profile->file);
+    ent.profile->file = NULL;
+    --open_;
+    return true;
+  }
+
+  dumpi_profile* filecache::acquire(id file) {
+    std::lock_guard<std::mutex> guard(lock_);
+    entry &ent = entries_.at(file);
+    if(ent.profile != NULL && ent.profile->file != NULL) {
+      if(ent.pinned++ == 0)
+        lru_.erase(ent.lru);
+      return ent.profile;
+    }
+    while(open_ >= max_open_ && evict())
+      ;
+    if(ent.profile == NULL) {
+      ent.profile = undumpi_open(ent.fname.c_str());
+      if(ent.profile == NULL)
+        return NULL;
+    }
+    else {
+      ent.profile->file = fopen(ent.fname.c_str(), "r");
+      if(ent.profile->file == NULL) {
+        std::cerr << "filecache:  Failed to reopen " << ent.fname << ": "
+                  << strerror(errno) << "\n";
+        return NULL;
+      }
+      if(fseeko(ent.profile->file, ent.pos, SEEK_SET) != 0) {
+        std::cerr << "filecache:  Failed to seek in " << ent.fname << "\n";
+        fclose(ent.profile->file);
+        ent.profile->file = NULL;
+        return NULL;
+      }
+    }
+    ++open_;
+    ++ent.pinned;
+    return ent.profile;
+  }
+
+  void filecache::release(id file) {
+    std::lock_guard<std::mutex> guard(lock_);
+    entry &ent = entries_.at(file);
+    if(ent.pinned > 0 && --ent.pinned == 0)
+      ent.lru = lru_.insert(lru_.end(), file);
+  }
+
+} // end of namespace dumpi
@@ -0,0 +1,155 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_BIN_FILECACHE_H
+#define DUMPI_BIN_FILECACHE_H
+
+#include <dumpi/common/types.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dumpi {
+
+  /**
+   * \ingroup dumpi_utilities
+   */
+  /*@{*/
+
+  /**
+   * Trace files opened on demand, with a bounded number of descriptors.
+   *
+   * Each registered file keeps its (small) dumpi_profile once it has been
+   * read, but the FILE itself is closed again when too many files are
+   * open, least recently used first.  acquire() reopens the file and
+   * restores the position it had when it was last released, so a caller
+   * sees a stream that simply stayed open.
+   *
+   * The limit defaults to half of RLIMIT_NOFILE; it can be set with
+   * DUMPI_MAX_OPEN_FILES in the environment.  Safe to use from several
+   * threads, as long as each file is used by one thread at a time.
+   */
+  class filecache {
+  public:
+    typedef int id;
+
+  private:
+    struct entry {
+      std::string fname;
+      dumpi_profile *profile;
+      /// Stream position while the file is closed.
+      off_t pos;
+      /// Number of callers between acquire and release.
+      int pinned;
+      bool used;
+      /// Place in lru_ (valid while the file is open and not pinned).
+      std::list<id>::iterator lru;
+    };
+
+    std::mutex lock_;
+    size_t max_open_, open_;
+    std::vector<entry> entries_;
+    /// Free slots in entries_.
+    std::vector<id> unused_;
+    /// Open files nobody is using, least recently used first.
+    std::list<id> lru_;
+
+    /// Close the least recently used file (false if all are in use).
+    bool evict();
+
+  public:
+    /// Keep at most max_open files open (0 for the default).
+    filecache(size_t max_open = 0);
+
+    ~filecache();
+
+    /// The cache used by preparse_traces and the other tools.
+    static filecache& global();
+
+    /// The file limit in effect.
+    size_t max_open() const { return max_open_; }
+
+    /// Register a file.  Nothing is opened yet.
+    id add(const std::string &fname);
+
+    /// Forget a file and release its profile.
+    void remove(id file);
+
+    /// Get the profile for a file, opening it if need be.
+    /// The file stays open until the matching release().
+    /// \return NULL (after a message on stderr) if it cannot be opened.
+    dumpi_profile* acquire(id file);
+
+    /// Done with the profile for now.
+    void release(id file);
+  };
+
+  /// Holds a file from the cache for the lifetime of the object.
+  class cachedfile {
+    filecache &cache_;
+    filecache::id file_;
+    dumpi_profile *profile_;
+
+    cachedfile(const cachedfile&);
+    cachedfile& operator=(const cachedfile&);
+
+  public:
+    cachedfile(filecache &cache, filecache::id file) :
+      cache_(cache), file_(file), profile_(cache.acquire(file))
+    {}
+
+    ~cachedfile() {
+      if(profile_ != NULL)
+        cache_.release(file_);
+    }
+
+    dumpi_profile* get() const { return profile_; }
+  };
+
+  /*@}*/
+
+} // end of namespace dumpi
+
+#endif // ! DUMPI_BIN_FILECACHE_H
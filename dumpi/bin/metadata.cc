@@ -51,7 +51,7 @@ Questions? Contact sst-macro-help@sandia.gov
 namespace dumpi {
 
   metadata::metadata(const std::string& metafile) :
-    metafile_(metafile)
+    metafile_(metafile), width_(DUMPI_TRACE_WIDTH), fanout_(-1)
   {
     std::ifstream in(metafile.c_str());
     if(! in) {
@@ -76,6 +76,10 @@ namespace dumpi {
         }
 	if(std::string("fileprefix") == key)
 	  fileprefix_ = pathprefix + val;
+	if(std::string("fanout") == key) {
+          std::istringstream ss(val);
+          ss >> fanout_;
+        }
       }
     }
     if(numprocs_ <= 0 || fileprefix_ == "") {
@@ -96,8 +100,12 @@ namespace dumpi {
       fileprefix_ = folder_ + "/" + fileprefix_;
     }
 
-    // Now expand the fileprefix to have the "right" number of zeros.
+    // Newer metafiles give the layout of the trace files.
+    if(fanout_ >= 0)
+      return;
+    // Otherwise expand the fileprefix to have the "right" number of zeros.
     // Start with a %04f format, and move on from there.
+    fanout_ = 0;
     static const int maxwidth=10;
     std::stringstream ss;
     int files_found = 0;
@@ -115,14 +123,8 @@ namespace dumpi {
 	  fclose(exists);
 	}
       }
-      if(files_found == numprocs_) {
-	// Create a printf-style format.
-	ss.clear();
-	ss.str("");
-	ss << fileprefix_ << "-%0" << width_ << "d.bin";
-	tracefmt_ = ss.str();
+      if(files_found == numprocs_)
 	break;
-      }
     }
     if(files_found != numprocs_) {
       throw "metadata:  Failed to find binary trace files.";
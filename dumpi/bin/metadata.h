@@ -51,6 +51,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <stdio.h>
 #include <errno.h>
 #include <stdexcept>
+#include <dumpi/common/io.h>
 
 namespace dumpi {
 
@@ -68,10 +69,10 @@ namespace dumpi {
     std::string metafile_;
     std::string folder_;
     std::string fileprefix_;
-    /// This gets expanded to be the sprintf-format needed to open trace files.
-    std::string tracefmt_;
     /// The number of digit in the filename.
     int width_;
+    /// The number of subdirectories the trace files are spread over.
+    int fanout_;
 
   public:
     metadata(const std::string& metafile);
@@ -91,11 +92,12 @@ namespace dumpi {
 
     /// Get the full filename corresponding to the given trace index.
     std::string tracename(int index) const {
-      static char buf[1024];
+      char buf[1024];
       if (index >= numprocs_){
         throw std::runtime_error("Requested trace index is too large");
       }
-      if (snprintf(buf, 1024, tracefmt_.c_str(), index) > 1023){
+      if (dumpi_trace_filename(buf, 1024, fileprefix_.c_str(), width_,
+                               fanout_, index) > 1023){
         throw std::runtime_error("snprintf failed to generate trace name");
       }
       return std::string(buf);
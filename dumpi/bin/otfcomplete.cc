@@ -61,13 +61,13 @@ namespace dumpi {
   //
   // Complete an outstanding request.
   //
-  void otfcomplete::complete(OTF_Writer *writer, uint64_t stop,
+  void otfcomplete::complete(OTF_WStream *writer, uint64_t stop,
 			     dumpi_request requestid)
   {
     pending_t::iterator it = pending_.find(requestid);
     if(it != pending_.end()) {
       args a = it->second;
-      OTF_Writer_writeRecvMsg(writer, stop, a.recver, a.sender, a.procgroup,
+      OTF_WStream_writeRecvMsg(writer, stop, a.recver, a.sender, a.procgroup,
 			      a.tag, a.length, a.source);
       pending_.erase(it);
     }
@@ -76,7 +76,7 @@ namespace dumpi {
   //
   // Complete a list of outstanding requests (waitany or waitall).
   //
-  void otfcomplete::complete_all(OTF_Writer *writer, uint64_t stop,
+  void otfcomplete::complete_all(OTF_WStream *writer, uint64_t stop,
 				 int count, const dumpi_request *requests)
   {
     for(int i = 0; i < count; ++i)
@@ -82,10 +82,10 @@ namespace dumpi {
 
     /// Complete an outstanding request.
     /// This is a no-op if the request is not defined (e.g. isend).
-    void complete(OTF_Writer *writer, uint64_t stop, dumpi_request requestid);
+    void complete(OTF_WStream *writer, uint64_t stop, dumpi_request requestid);
 
     /// Complete a list of outstanding requests (waitany or waitall).
-    void complete_all(OTF_Writer *writer, uint64_t stop,
+    void complete_all(OTF_WStream *writer, uint64_t stop,
 		      int count, const dumpi_request *requests);
   };
 
@@ -48,6 +48,9 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <sstream>
 #include <assert.h>
 #include <math.h>
+#include <thread>
+#include <atomic>
+#include <mutex>
 
 namespace dumpi {
 
@@ -62,17 +65,19 @@ namespace dumpi {
   //
   // Hello.
   //
-  otfwriter::otfwriter(const std::string &fileroot) :
-    mgr_(NULL), writer_(NULL), meta_(NULL), info_(NULL)
+  otfwriter::otfwriter(const std::string &fileroot, const options &opt) :
+    mgr_(NULL), writer_(NULL), fileroot_(fileroot), opt_(opt),
+    meta_(NULL), info_(NULL), preparse_(NULL)
   {
     memset(&callbacks_, 0, sizeof(libundumpi_callbacks));
-    // Unfortunately, the OTF writer expects a char* (not const char*).
-    char *scratch = strdup(fileroot.c_str());
-    assert(scratch != NULL);
-    if((mgr_ = OTF_FileManager_open(16)) == NULL) {
+    if(opt_.threads < 1) opt_.threads = 1;
+    if(opt_.max_files < 1) opt_.max_files = 1;
+    if((mgr_ = OTF_FileManager_open(opt_.max_files)) == NULL) {
       throw "otfwriter:  Failed to create file manager.";
     }
-    if((writer_ = OTF_Writer_open(scratch, 0, mgr_)) == NULL) {
+    // The global definitions and the master file (which maps processes to
+    // streams) go through this writer; every rank gets its own OTF_WStream.
+    if((writer_ = OTF_Writer_open(fileroot_.c_str(), 0, mgr_)) == NULL) {
       std::cerr << "Problems opening OTF output file root \"" << fileroot <<"\"\n";
       throw "otfwriter:  Failed to create writer.";
     }
@@ -80,7 +85,6 @@ namespace dumpi {
     if(OTF_Writer_setCompression(writer_, OTF_FILECOMPRESSION_COMPRESSED) == 0) {
       ;//std::cerr << "otfwriter:  Writing uncompressed trace file (no zlib?)\n";
     }
-    free(scratch);
   }
   
   //
@@ -94,9 +98,12 @@ namespace dumpi {
   //
   // Make magic.
   //
-  void otfwriter::write(const metadata &meta, const std::vector<trace> &info) {
+  void otfwriter::write(const metadata &meta, std::vector<trace> &info,
+                        sharedstate *shared)
+  {
     meta_ = &meta;
     info_ = &info;
+    preparse_ = shared;
     set_callbacks();
     define_mpi_functions();
     // Define a special counter for CPU time.
@@ -115,20 +122,78 @@ namespace dumpi {
         the_process += ss.str();
       }
       OTF_Writer_writeDefProcess(writer_, i+1, i+1, the_process.c_str(), 0);
+      OTF_Writer_assignProcess(writer_, i+1, i+1);
+    }
+    // Now write the streams, several ranks at a time.
+    size_t nthread = opt_.threads;
+    if(nthread > info.size()) nthread = info.size();
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::mutex errlock;
+    std::string errmsg;
+    std::vector<std::thread> workers;
+    for(size_t t = 0; t < nthread; ++t) {
+      workers.push_back(std::thread([&]() {
+            size_t i;
+            while(!failed && (i = next++) < info_->size()) {
+              try {
+                write_rank(i);
+              }
+              catch(const char *msg) {
+                std::lock_guard<std::mutex> lock(errlock);
+                if(! failed) errmsg = msg;
+                failed = true;
+              }
+            }
+          }));
+    }
+    for(size_t t = 0; t < workers.size(); ++t)
+      workers[t].join();
+    if(failed) {
+      std::cerr << "otfwriter::write:  " << errmsg << "\n";
+      throw "otfwriter::write:  Failed to write OTF streams.";
     }
-    // Now parse the files one after the other.
-    for(current_rank_ = 0; current_rank_ < int(info.size()); ++current_rank_) {
-      std::string tracename = meta.tracename(current_rank_);
-      dumpi_profile *profile = undumpi_open(tracename.c_str());
-      if(! profile) {
-	std::cerr << "otfwriter::write:  Failed to open " << tracename << ": "
-		  << strerror(errno) << "\n";
+  }
+
+  //
+  // Write the stream for one rank.
+  //
+  void otfwriter::write_rank(int rank) {
+    trace &tr = info_->at(rank);
+    std::string tracename = meta_->tracename(rank);
+    if(preparse_) {
+      tr.init(preparse_, tracename, rank);
+      trace::state st;
+      while((st = tr.preparse()) != trace::PREPARSE_DONE) {
+        if(st != trace::PREPARSE_ADVANCED)
+          throw "otfwriter::write_rank:  Trace blocked on communicator "
+            "creation during single-pass conversion.";
       }
-      define_local_functions(current_rank_+1, profile);
-      define_perfctr_labels(current_rank_+1, profile);
-      undumpi_read_stream(profile, &callbacks_, this, false);
-      undumpi_close(profile);
     }
+    dumpi_profile *profile = undumpi_open(tracename.c_str());
+    if(! profile) {
+      std::cerr << "otfwriter::write:  Failed to open " << tracename << ": "
+		<< strerror(errno) << "\n";
+      throw "otfwriter::write_rank:  Failed to open trace.";
+    }
+    rankstate state;
+    state.current_rank_ = rank;
+    state.info_ = info_;
+    if((state.mgr_ = OTF_FileManager_open(opt_.max_files)) == NULL)
+      throw "otfwriter::write_rank:  Failed to create file manager.";
+    if((state.writer_ = OTF_WStream_open(fileroot_.c_str(), rank+1, state.mgr_)) == NULL)
+      throw "otfwriter::write_rank:  Failed to open stream.";
+    OTF_WStream_setFormat(state.writer_, OTF_WSTREAM_FORMAT_SHORT);
+    OTF_WStream_setCompression(state.writer_, OTF_FILECOMPRESSION_COMPRESSED);
+    OTF_WStream_setBufferSizes(state.writer_, opt_.buffer_size);
+    state.define_local_functions(profile);
+    state.define_perfctr_labels(profile);
+    undumpi_read_stream(profile, &callbacks_, &state, false);
+    undumpi_close(profile);
+    OTF_WStream_close(state.writer_);
+    OTF_FileManager_close(state.mgr_);
+    // A trace we preparsed ourselves is no longer needed.
+    if(preparse_) tr = trace();
   }
 
   /*
@@ -158,7 +223,7 @@ namespace dumpi {
   {
     static const int func = functag + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     if(self->info_->at(r).rank() != r) 
       throw "probable coding mistake:  Mismatched ranks.";
@@ -166,10 +231,10 @@ namespace dumpi {
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -183,7 +248,7 @@ namespace dumpi {
   {
     (void)thread; (void)cpu; (void)perf;
     static const int func = functag + 1;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
@@ -195,12 +260,12 @@ namespace dumpi {
     uint32_t tag = prm->tag;
     uint32_t length = the_type.get_size() * prm->count;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, sender, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, sender, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeSendMsg(self->writer_, start, sender, recver, procgroup,
+    OTF_WStream_writeSendMsg(self->writer_, start, sender, recver, procgroup,
 			    tag, length, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, sender, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, sender, source);
     return 1;
   }
 
@@ -213,7 +278,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Recv + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     if(self->info_->at(r).rank() != r) 
       throw "probable coding mistake:  Mismatched ranks.";
@@ -232,12 +297,12 @@ namespace dumpi {
     uint32_t tag = prm->tag;
     uint32_t length = the_type.get_size() * prm->count;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, recver, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, recver, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeRecvMsg(self->writer_, stop, recver, sender, procgroup,
+    OTF_WStream_writeRecvMsg(self->writer_, stop, recver, sender, procgroup,
 			    tag, length, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, recver, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, recver, source);
     return 1;
   }
 
@@ -250,7 +315,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Irecv + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     if(self->info_->at(r).rank() != r) 
       throw "probable coding mistake:  Mismatched ranks.";
@@ -269,12 +334,12 @@ namespace dumpi {
     uint32_t tag = prm->tag;
     uint32_t length = the_type.get_size() * prm->count;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, recver, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, recver, source);
     self->write_counters_enter(start, cpu, perf);
-    self->complete_[recver].add(prm->request, recver, sender,
+    self->complete_.add(prm->request, recver, sender,
 				procgroup, tag, length, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, recver, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, recver, source);
     return 1;
   }
 
@@ -287,17 +352,17 @@ namespace dumpi {
   {
     static const uint32_t func = DUMPI_Wait + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r + 1;
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    self->complete_[otfrank].complete(self->writer_, stop, prm->request);
+    self->complete_.complete(self->writer_, stop, prm->request);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -310,16 +375,16 @@ namespace dumpi {
   {
     static const uint32_t func = DUMPI_Waitany + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r + 1;
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
-    self->complete_[otfrank].complete(self->writer_, stop,
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
+    self->complete_.complete(self->writer_, stop,
 				      prm->requests[prm->index]);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -332,19 +397,19 @@ namespace dumpi {
   {
     static const uint32_t func = DUMPI_Waitsome + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r + 1;
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
     for(int i = 0; i < prm->outcount; ++i)
-      self->complete_[otfrank].complete(self->writer_, stop,
+      self->complete_.complete(self->writer_, stop,
 					prm->requests[prm->indices[i]]);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -357,18 +422,18 @@ namespace dumpi {
   {
     static const uint32_t func = DUMPI_Waitall + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r + 1;
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    self->complete_[otfrank].complete_all(self->writer_, stop,
+    self->complete_.complete_all(self->writer_, stop,
 					  prm->count, prm->requests);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -381,18 +446,18 @@ namespace dumpi {
   {
     static const uint32_t func = DUMPI_Test + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r + 1;
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
     if(prm->flag)
-      self->complete_[otfrank].complete(self->writer_, stop, prm->request);
+      self->complete_.complete(self->writer_, stop, prm->request);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -405,19 +470,19 @@ namespace dumpi {
   {
     static const uint32_t func = DUMPI_Testany + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r + 1;
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
     if(prm->flag)
-      self->complete_[otfrank].complete(self->writer_, stop,
+      self->complete_.complete(self->writer_, stop,
 					prm->requests[prm->index]);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -430,19 +495,19 @@ namespace dumpi {
   {
     static const uint32_t func = DUMPI_Testsome + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r + 1;
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
     for(int i = 0; i < prm->outcount; ++i)
-      self->complete_[otfrank].complete(self->writer_, stop,
+      self->complete_.complete(self->writer_, stop,
 					prm->requests[prm->indices[i]]);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -455,19 +520,19 @@ namespace dumpi {
   {
     static const uint32_t func = DUMPI_Testall + 1;
     (void)prm; (void)thread; (void)cpu; (void)wall; (void)perf; (void)userarg;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r + 1;
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
     if(prm->flag)
-      self->complete_[otfrank].complete_all(self->writer_, stop,
+      self->complete_.complete_all(self->writer_, stop,
 					    prm->count, prm->requests);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -481,20 +546,20 @@ namespace dumpi {
   {
     (void)prm; (void)thread; (void)cpu; (void)perf;
     static const int func = functag + 1;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     int otfrank = r+1;
     uint64_t start = to_nsec(wall->start);
     uint64_t stop = to_nsec(wall->stop);
     uint64_t duration = stop - start;
     uint32_t procgroup = 0, root = 0, sent = 0, recvd = 0, source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -507,7 +572,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Bcast + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     const comm &the_comm =self->info_->at(r).get_comm(prm->comm, wall->start);
@@ -524,13 +589,13 @@ namespace dumpi {
     else
       recvd = bytes;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -543,7 +608,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Gather + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     const comm &the_comm = self->info_->at(r).get_comm(prm->comm, wall->start);
@@ -566,13 +631,13 @@ namespace dumpi {
       sent = stype.get_size() * prm->sendcount;
     }
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -585,7 +650,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Gatherv + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     const comm &the_comm = self->info_->at(r).get_comm(prm->comm, wall->start);
@@ -612,13 +677,13 @@ namespace dumpi {
       sent = stype.get_size() * prm->sendcount;
     }
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -631,7 +696,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Scatter + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     const comm &the_comm = self->info_->at(r).get_comm(prm->comm, wall->start);
@@ -654,13 +719,13 @@ namespace dumpi {
       recvd = stype.get_size() * prm->sendcount;
     }
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -673,7 +738,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Scatterv + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     const comm &the_comm = self->info_->at(r).get_comm(prm->comm, wall->start);
@@ -700,13 +765,13 @@ namespace dumpi {
       recvd = rtype.get_size() * prm->recvcount;
     }
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -719,7 +784,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Allgather + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     const comm &the_comm = self->info_->at(r).get_comm(prm->comm, wall->start);
@@ -734,13 +799,13 @@ namespace dumpi {
     uint32_t recvd = rtype.get_size() * prm->recvcount * (commsize-1);
     uint32_t root = 0;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -753,7 +818,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Allgatherv + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     const type &stype = self->info_->at(r).get_type(prm->sendtype, wall->start);
@@ -771,13 +836,13 @@ namespace dumpi {
     recvd *= rtype.get_size();
     uint32_t root = 0;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -790,7 +855,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Alltoall + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     const comm &the_comm = self->info_->at(r).get_comm(prm->comm, wall->start);
@@ -805,13 +870,13 @@ namespace dumpi {
     uint32_t recvd = rtype.get_size() * prm->recvcount * (commsize-1);
     uint32_t root = 0;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -825,7 +890,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Alltoallv + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     const type &stype = self->info_->at(r).get_type(prm->sendtype, wall->start);
@@ -845,13 +910,13 @@ namespace dumpi {
     recvd *= rtype.get_size();
     uint32_t root = 0;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -864,7 +929,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Alltoallw + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     uint64_t start = to_nsec(wall->start);
@@ -884,13 +949,13 @@ namespace dumpi {
     }
     uint32_t root = 0;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -904,7 +969,7 @@ namespace dumpi {
   {  
     static const int func = typetag + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     const comm &the_comm = self->info_->at(r).get_comm(prm->comm, wall->start);
     const type &the_type = self->info_->at(r).get_type(prm->datatype, wall->start);
@@ -918,13 +983,13 @@ namespace dumpi {
     uint32_t sent = message_estimate, recvd = message_estimate;
     uint32_t root = 0;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -939,7 +1004,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Reduce_scatter + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     const comm &the_comm = self->info_->at(r).get_comm(prm->comm, wall->start);
     const type &the_type = self->info_->at(r).get_type(prm->datatype, wall->start);
@@ -956,13 +1021,13 @@ namespace dumpi {
     uint32_t sent = message_estimate, recvd = message_estimate;
     uint32_t root = 0;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -976,7 +1041,7 @@ namespace dumpi {
   {
     static const int func = DUMPI_Alltoall + 1;
     (void)thread; (void)cpu; (void)perf;
-    otfwriter *self = (otfwriter*)userarg;
+    rankstate *self = (rankstate*)userarg;
     int r = self->current_rank_;
     uint32_t otfrank = r+1;
     const comm &the_comm = self->info_->at(r).get_comm(prm->comm, wall->start);
@@ -993,13 +1058,13 @@ namespace dumpi {
       sent = 0;
     uint32_t root = 0;
     uint32_t source = 0;
-    OTF_Writer_writeEnter(self->writer_, start, func, otfrank, source);
+    OTF_WStream_writeEnter(self->writer_, start, func, otfrank, source);
     self->write_counters_enter(start, cpu, perf);
-    OTF_Writer_writeCollectiveOperation(self->writer_, start, otfrank,
+    OTF_WStream_writeCollectiveOperation(self->writer_, start, otfrank,
 					func, procgroup, root, sent, recvd,
 					duration, source);
     self->write_counters_leave(stop, cpu, perf);
-    OTF_Writer_writeLeave(self->writer_, stop, func, otfrank, source);
+    OTF_WStream_writeLeave(self->writer_, stop, func, otfrank, source);
     return 1;
   }
 
@@ -1684,15 +1749,14 @@ namespace dumpi {
   //
   // Define traced functions locally.
   //
-  void otfwriter::define_local_functions(uint32_t stream, dumpi_profile *profile) {
-    int i;
+  void otfwriter::rankstate::define_local_functions(dumpi_profile *profile) {
     int count = 0;
     uint64_t *addresses = NULL;
     char **names = NULL;
     dumpi_read_function_addresses(profile, &count, &addresses, &names);
     if(count) {
-      OTF_Writer_writeDefFunctionGroup(writer_, stream, userfuncs,
-				       "User-profiled functions");
+      OTF_WStream_writeDefFunctionGroup(writer_, userfuncs,
+				        "User-profiled functions");
       for(int add = 0; add < count; ++add) {
 	std::string lbl("Function address ");
         {
@@ -1706,12 +1770,15 @@ namespace dumpi {
 	  lbl += ")";
 	}
 	uint32_t otffunc = add + 3000;
-	OTF_Writer_writeDefFunction(writer_, stream, otffunc,
-				    lbl.c_str(), userfuncs, 0);
-	funclabel_[stream][otffunc] = addresses[add];
+	OTF_WStream_writeDefFunction(writer_, otffunc,
+				     lbl.c_str(), userfuncs, 0);
+	funclabel_[otffunc] = addresses[add];
       }
       free(addresses);
-      free(names[i]);
+      if(names) {
+        for(int add = 0; add < count; ++add)
+          free(names[add]);
+      }
       free(names);
     }
   }
@@ -1719,17 +1786,17 @@ namespace dumpi {
   //
   // Define perfcounter labels.
   //
-  void otfwriter::define_perfctr_labels(uint32_t stream, dumpi_profile *profile) {
+  void otfwriter::rankstate::define_perfctr_labels(dumpi_profile *profile) {
     dumpi_perfinfo pinfo;
     dumpi_read_perfctr_labels(profile, &pinfo.count, pinfo.counter_tag,
 			      DUMPI_MAX_PERFCTR_NAME);
     if(pinfo.count) {
-      OTF_Writer_writeDefCounterGroup(writer_, stream, papictrs,
-				      "User-profiled functions");
+      OTF_WStream_writeDefCounterGroup(writer_, papictrs,
+				       "User-profiled functions");
       for(int i = 0; i < pinfo.count; ++i) {
-	OTF_Writer_writeDefCounter(writer_, stream, i, pinfo.counter_tag[i],
-				   OTF_COUNTER_TYPE_ACC + OTF_COUNTER_SCOPE_START,
-				   papictrs, 0);
+	OTF_WStream_writeDefCounter(writer_, i, pinfo.counter_tag[i],
+				    OTF_COUNTER_TYPE_ACC + OTF_COUNTER_SCOPE_START,
+				    papictrs, 0);
       }
     }
   }
@@ -1737,17 +1804,17 @@ namespace dumpi {
   //
   // Write the state of perfcounters at function entry.
   //
-  void otfwriter::write_counters_enter(uint64_t start, const dumpi_time *cpu,
-				       const dumpi_perfinfo *perf)
+  void otfwriter::rankstate::write_counters_enter(uint64_t start, const dumpi_time *cpu,
+						  const dumpi_perfinfo *perf)
   {
     if(cpu) {
       uint64_t value = to_nsec(cpu->start);
-      OTF_Writer_writeCounter(writer_, start, current_rank_+1, cputimer, value);
+      OTF_WStream_writeCounter(writer_, start, current_rank_+1, cputimer, value);
     }
     if(perf && perf->count) {
       for(int i = 0; i < perf->count; ++i) {
-	OTF_Writer_writeCounter(writer_, start, current_rank_+1,
-				i, perf->invalue[i]);
+	OTF_WStream_writeCounter(writer_, start, current_rank_+1,
+				 i, perf->invalue[i]);
       }
     }
   }
@@ -1755,17 +1822,17 @@ namespace dumpi {
   //
   // Write the state of perfcounters at function exit.
   //
-  void otfwriter::write_counters_leave(uint64_t stop, const dumpi_time *cpu,
-				       const dumpi_perfinfo *perf)
+  void otfwriter::rankstate::write_counters_leave(uint64_t stop, const dumpi_time *cpu,
+						  const dumpi_perfinfo *perf)
   {
     if(cpu) {
       uint64_t value = to_nsec(cpu->stop);
-      OTF_Writer_writeCounter(writer_, stop, current_rank_+1, cputimer, value);
+      OTF_WStream_writeCounter(writer_, stop, current_rank_+1, cputimer, value);
     }
     if(perf && perf->count) {
       for(int i = 0; i < perf->count; ++i) {
-	OTF_Writer_writeCounter(writer_, stop, current_rank_+1,
-				i, perf->outvalue[i]);
+	OTF_WStream_writeCounter(writer_, stop, current_rank_+1,
+				 i, perf->outvalue[i]);
       }
     }
   }
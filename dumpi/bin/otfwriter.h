@@ -48,6 +48,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/bin/trace.h>
 #include <dumpi/bin/metadata.h>
 #include <dumpi/bin/otfcomplete.h>
+#include <dumpi/bin/sharedstate.h>
 #include <dumpi/libundumpi/libundumpi.h>
 #include <dumpi/libundumpi/bindings.h>
 #include <otf.h>
@@ -66,65 +67,97 @@ namespace dumpi {
    * Handle writing OTF traces given pre-parsed state information.
    */
   class otfwriter {
-    /// The file manager for our writer.
+  public:
+    /// Tuning knobs for the conversion.
+    struct options {
+      /// Number of ranks converted concurrently.
+      int threads;
+      /// Open file limit for each stream's OTF file manager.
+      uint32_t max_files;
+      /// Write buffer size (bytes) for each stream.
+      uint32_t buffer_size;
+      options() : threads(1), max_files(16), buffer_size(1024*1024) {}
+    };
+
+  private:
+    /// The file manager for the global definitions.
     OTF_FileManager *mgr_;
-    /// Our writer.
+    /// Writer for global definitions (stream 0) and the process map.
     OTF_Writer *writer_;
+    /// The file root shared by all streams.
+    std::string fileroot_;
+    options opt_;
 
     /// We stash info about the metadata and trace info here to allow
     /// callbacks to proceed properly.
     const metadata *meta_;
-    const std::vector<trace> *info_;
-    /// The current rank we're working on (needed for callbacks).
-    int current_rank_;
+    std::vector<trace> *info_;
+    /// Set if the traces still have to be preparsed (one at a time,
+    /// on the thread that writes them).
+    sharedstate *preparse_;
 
-    /// The callbacks we use during preparsing
+    /// The callbacks we use while writing streams (shared, read-only).
     libundumpi_callbacks callbacks_;
 
-    /// Completions -- only MPI_Irecv is handled here (I*send operations
-    /// are marked as soon as the Isend call is made).
-    std::map<uint32_t, otfcomplete> complete_;
-
-    /// Persistent sends or receives are handled here.
-    //std::map<uint32_t, otfpersistent> persistent_;
-
     /// Map function addresses to OTF function labels (local to each node).
     /// We can't just use the address, because it may well have the high-bits set.
     typedef std::map<uint64_t, uint32_t> funcadd_t;
-    /// Store a funcadd mapping for each stream.
-    typedef std::map<uint32_t, funcadd_t> funclabel_t;
-    funclabel_t funclabel_;
+
+    /// Everything the callbacks need to write one rank.  Each worker thread
+    /// owns one of these at a time, so ranks never share mutable state.
+    struct rankstate {
+      /// The rank we're working on.
+      int current_rank_;
+      /// The stream this rank is written to (stream id is rank+1).
+      OTF_WStream *writer_;
+      /// File manager private to this stream.
+      OTF_FileManager *mgr_;
+      /// The preparsed trace info for all ranks.
+      const std::vector<trace> *info_;
+      /// Completions -- only MPI_Irecv is handled here (I*send operations
+      /// are marked as soon as the Isend call is made).
+      otfcomplete complete_;
+      /// Function address labels for this stream.
+      funcadd_t funclabel_;
+
+      /// Write the state of perfcounters at function entry.
+      void write_counters_enter(uint64_t start, const dumpi_time *cpu,
+                                const dumpi_perfinfo *perf);
+
+      /// Write the state of perfcounters at function exit.
+      void write_counters_leave(uint64_t stop, const dumpi_time *cpu,
+                                const dumpi_perfinfo *perf);
+
+      /// Define traced functions (if any).  These are defined locally
+      /// since there is no guarantee on how they will be ordered.
+      void define_local_functions(dumpi_profile *profile);
+
+      /// Define performance counter labels.  These are defined locally
+      /// since it is not guaranteed (albeit very likely) that they will have
+      /// the same value on all nodes.
+      void define_perfctr_labels(dumpi_profile *profile);
+    };
 
   public:
     /// Hello.
-    explicit otfwriter(const std::string &fileroot);
+    otfwriter(const std::string &fileroot, const options &opt = options());
   
     /// Goodbye.
     virtual ~otfwriter() throw();
 
-    /// Make magic.
-    void write(const metadata &meta, const std::vector<trace> &info);
+    /// Make magic.  If shared is not NULL, the traces have not been
+    /// preparsed yet; each one is then preparsed right before it is
+    /// written (only valid if no trace creates communicators) and
+    /// released right after.
+    void write(const metadata &meta, std::vector<trace> &info,
+               sharedstate *shared = NULL);
 
   private:
     /// Define MPI function labels.  We define MPI functions globally (stream 0)
     void define_mpi_functions();
 
-    /// Define traced functions (if any).  These are defined locally
-    /// since there is no guarantee on how they will be ordered.
-    void define_local_functions(uint32_t stream, dumpi_profile *profile);
-
-    /// Define performance counter labels.  These are defined locally
-    /// since it is not guaranteed (albeit very likely) that they will have
-    /// the same value on all nodes.
-    void define_perfctr_labels(uint32_t stream, dumpi_profile *profile);
-
-    /// Write the state of perfcounters at function entry.
-    void write_counters_enter(uint64_t start, const dumpi_time *cpu,
-			      const dumpi_perfinfo *perf);
-
-    /// Write the state of perfcounters at function exit.
-    void write_counters_leave(uint64_t stop, const dumpi_time *cpu,
-			      const dumpi_perfinfo *perf);
+    /// Write the stream for one rank (called on a worker thread).
+    void write_rank(int rank);
 
     /// Common functionality for functions that are 'tagged' (entry and exit)
     /// but don't do any communication.
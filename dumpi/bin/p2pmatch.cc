@@ -0,0 +1,857 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bin/p2pmatch.h>
+#include <dumpi/bin/filecache.h>
+#include <dumpi/libundumpi/reader.h>
+#include <dumpi/common/constants.h>
+#include <dumpi/common/funclabels.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace dumpi {
+
+  p2psummary::p2psummary() :
+    matched(0), unmatched_sends(0), unmatched_recvs(0), incomplete_recvs(0),
+    late_senders(0), late_receivers(0),
+    late_sender_wait(0), late_receiver_wait(0), bytes(0), unresolved(0)
+  {}
+
+  namespace {
+
+    /// One thing a rank did that matters for matching.
+    struct p2pevent {
+      enum kind_t { SEND, RECV, DONE } kind;
+      dumpi_function func;
+      /// SEND: global destination.  RECV: global source (or
+      /// DUMPI_ANY_SOURCE).  DONE: source from the status (-1 if unknown).
+      int32_t peer;
+      int32_t comm;
+      /// Same pattern as peer.
+      int32_t tag;
+      int64_t bytes;
+      /// Entry into the call (SEND, RECV) or return from it (DONE).
+      int64_t time;
+      /// RECV:  return from a blocking receive (-1 for nonblocking ones).
+      int64_t done;
+      /// RECV, DONE:  receive number on this rank.
+      int64_t id;
+    };
+
+    inline int64_t to_nsec(const dumpi_clock &cc) {
+      return int64_t(cc.sec) * 1000000000 + cc.nsec;
+    }
+
+    /**
+     * Turns the MPI call stream of one rank into p2pevents, translating
+     * communicator-local ranks to global ranks.  Only one thread at a time
+     * decodes a given stream; the queues are guarded by the matcher lock.
+     */
+    class p2pstream {
+      struct active {
+        int64_t id;
+        dumpi_comm comm;
+      };
+      struct persistent {
+        bool send;
+        dumpi_function func;
+        int count;
+        dumpi_datatype datatype;
+        int peer, tag;
+        dumpi_comm comm;
+      };
+
+      int rank_;
+      const trace *trace_;
+      int64_t origin_;
+      /// Opened through filecache::global() while a worker decodes.
+      filecache::id file_;
+      bool started_;
+      int mpi_finalized_;
+      int64_t next_id_;
+      /// Outstanding nonblocking receives, by request handle.
+      std::unordered_map<dumpi_request, active> recvs_;
+      /// Inactive persistent requests (Send_init, Recv_init).
+      std::unordered_map<dumpi_request, persistent> persistent_;
+      std::vector<p2pevent> *out_;
+
+      bool resolve(dumpi_comm comm, int local, const dumpi_clock &when,
+                   int32_t &uid, int32_t &global)
+      {
+        try {
+          const dumpi::comm &cc = trace_->get_comm(comm, when);
+          uid = cc.get_unique_index();
+          global = (local < 0 ? local : cc.get_group().get_global_peer_rank(local));
+          return true;
+        } catch(const char*) {
+        } catch(const std::out_of_range&) {
+        }
+        ++unresolved;
+        return false;
+      }
+
+      int64_t bytes(dumpi_datatype datatype, int count, const dumpi_clock &when) {
+        try {
+          return int64_t(count) * trace_->get_type(datatype, when).get_size();
+        } catch(const char*) {
+          return -1;
+        }
+      }
+
+      void send(dumpi_function func, int count, dumpi_datatype datatype,
+                int dest, int tag, dumpi_comm comm, const dumpi_clock &when)
+      {
+        p2pevent ev;
+        if(dest < 0)
+          return;                  // MPI_PROC_NULL
+        if(! resolve(comm, dest, when, ev.comm, ev.peer))
+          return;
+        ev.kind = p2pevent::SEND;
+        ev.func = func;
+        ev.tag = tag;
+        ev.bytes = bytes(datatype, count, when);
+        ev.time = to_nsec(when) - origin_;
+        ev.done = ev.id = -1;
+        out_->push_back(ev);
+      }
+
+      /// Returns the receive number (-1 if the receive was skipped).
+      int64_t recv(dumpi_function func, int source, int tag, dumpi_comm comm,
+                   const dumpi_time &wall, const dumpi_status *status)
+      {
+        p2pevent ev;
+        if(source < 0 && source != DUMPI_ANY_SOURCE)
+          return -1;               // MPI_PROC_NULL
+        if(status != NULL && status->source >= 0) {
+          source = status->source;
+          tag = status->tag;
+        }
+        if(! resolve(comm, source, wall.start, ev.comm, ev.peer))
+          return -1;
+        ev.kind = p2pevent::RECV;
+        ev.func = func;
+        ev.tag = tag;
+        ev.bytes = -1;
+        ev.time = to_nsec(wall.start) - origin_;
+        ev.done = (status != NULL ? to_nsec(wall.stop) - origin_ : -1);
+        ev.id = next_id_++;
+        out_->push_back(ev);
+        return ev.id;
+      }
+
+      void start_recv(dumpi_function func, dumpi_request request, int source,
+                      int tag, dumpi_comm comm, const dumpi_time &wall)
+      {
+        int64_t id = recv(func, source, tag, comm, wall, NULL);
+        if(id >= 0) {
+          active &aa = recvs_[request];
+          aa.id = id;
+          aa.comm = comm;
+        }
+        else {
+          recvs_.erase(request);
+        }
+      }
+
+      void start(dumpi_request request, const dumpi_time &wall) {
+        std::unordered_map<dumpi_request, persistent>::const_iterator it =
+          persistent_.find(request);
+        if(it == persistent_.end())
+          return;
+        const persistent &pp = it->second;
+        if(pp.send)
+          send(pp.func, pp.count, pp.datatype, pp.peer, pp.tag, pp.comm,
+               wall.start);
+        else
+          start_recv(pp.func, request, pp.peer, pp.tag, pp.comm, wall);
+      }
+
+      void init(bool is_send, dumpi_function func, dumpi_request request,
+                int count, dumpi_datatype datatype, int peer, int tag,
+                dumpi_comm comm)
+      {
+        persistent &pp = persistent_[request];
+        pp.send = is_send;
+        pp.func = func;
+        pp.count = count;
+        pp.datatype = datatype;
+        pp.peer = peer;
+        pp.tag = tag;
+        pp.comm = comm;
+      }
+
+      void complete(dumpi_request request, const dumpi_status *status,
+                    const dumpi_time &wall)
+      {
+        std::unordered_map<dumpi_request, active>::iterator it =
+          recvs_.find(request);
+        if(it == recvs_.end())
+          return;                  // a send, or nothing we know about
+        p2pevent ev;
+        ev.kind = p2pevent::DONE;
+        ev.func = DUMPI_ALL_FUNCTIONS;
+        ev.peer = ev.tag = ev.comm = -1;
+        if(status != NULL && status->source >= 0) {
+          int32_t uid;
+          if(resolve(it->second.comm, status->source, wall.start, uid, ev.peer))
+            ev.tag = status->tag;
+        }
+        ev.bytes = -1;
+        ev.time = to_nsec(wall.stop) - origin_;
+        ev.done = -1;
+        ev.id = it->second.id;
+        out_->push_back(ev);
+        recvs_.erase(it);
+      }
+
+      void complete_some(const dumpi_request *requests, int outcount,
+                         const int *indices, const dumpi_status *statuses,
+                         int count, const dumpi_time &wall)
+      {
+        for(int i = 0; i < outcount; ++i)
+          if(indices[i] >= 0 && indices[i] < count)
+            complete(requests[indices[i]],
+                     (statuses != NULL ? &statuses[i] : NULL), wall);
+      }
+
+      void complete_all(const dumpi_request *requests, int count,
+                        const dumpi_status *statuses, const dumpi_time &wall)
+      {
+        for(int i = 0; i < count; ++i)
+          complete(requests[i], (statuses != NULL ? &statuses[i] : NULL), wall);
+      }
+
+    public:
+      /// Decoding is done but the merger has not taken these yet.
+      std::deque<p2pevent> ready;
+      /// The merger is working through these.
+      std::deque<p2pevent> current;
+      /// A worker is decoding this stream.
+      bool busy;
+      /// Nothing left to decode.
+      bool finished;
+      /// Calls whose communicator or peer could not be resolved.
+      int64_t unresolved;
+
+      p2pstream(int rank, const std::string &fname, const trace *tr,
+                int64_t origin) :
+        rank_(rank), trace_(tr), origin_(origin),
+        file_(filecache::global().add(fname)), started_(false),
+        mpi_finalized_(0), next_id_(0), out_(NULL), busy(false),
+        finished(false), unresolved(0)
+      {}
+
+      ~p2pstream() {
+        this->close();
+      }
+
+      int rank() const { return rank_; }
+
+      void close() {
+        if(file_ >= 0) {
+          filecache::global().remove(file_);
+          file_ = -1;
+        }
+      }
+
+      /// Decode until at least want events are in out.
+      /// \return false when the end of the stream was reached.
+      bool fill(std::vector<p2pevent> &out, size_t want) {
+        bool more = (file_ >= 0);
+        if(more) {
+          cachedfile file(filecache::global(), file_);
+          dumpi_profile *profile = file.get();
+          if(profile == NULL || (! started_ && ! dumpi_start_stream_read(profile)))
+            more = false;
+          started_ = true;
+          out_ = &out;
+          while(more && out.size() < want)
+            more = (read_single_call(profile, *this, &mpi_finalized_) &&
+                    profile->pos < profile->terminate_pos);
+        }
+        if(! more)
+          this->close();
+        return more;
+      }
+
+      // Visitor overloads for read_single_call.
+#define P2P_SEND(NAME)                                                   \
+      void on(const dumpi_##NAME &prm, const event &ev) {               \
+        send(ev.function, prm.count, prm.datatype, prm.dest, prm.tag,   \
+             prm.comm, ev.wall.start);                                   \
+      }
+#define P2P_ISEND(NAME)                                                  \
+      void on(const dumpi_##NAME &prm, const event &ev) {               \
+        recvs_.erase(prm.request);                                       \
+        send(ev.function, prm.count, prm.datatype, prm.dest, prm.tag,   \
+             prm.comm, ev.wall.start);                                   \
+      }
+#define P2P_SEND_INIT(NAME)                                              \
+      void on(const dumpi_##NAME &prm, const event &ev) {               \
+        recvs_.erase(prm.request);                                       \
+        init(true, ev.function, prm.request, prm.count, prm.datatype,   \
+             prm.dest, prm.tag, prm.comm);                               \
+      }
+      P2P_SEND(send)
+      P2P_SEND(bsend)
+      P2P_SEND(ssend)
+      P2P_SEND(rsend)
+      P2P_ISEND(isend)
+      P2P_ISEND(ibsend)
+      P2P_ISEND(issend)
+      P2P_ISEND(irsend)
+      P2P_SEND_INIT(send_init)
+      P2P_SEND_INIT(bsend_init)
+      P2P_SEND_INIT(ssend_init)
+      P2P_SEND_INIT(rsend_init)
+#undef P2P_SEND
+#undef P2P_ISEND
+#undef P2P_SEND_INIT
+
+      void on(const dumpi_recv &prm, const event &ev) {
+        recv(ev.function, prm.source, prm.tag, prm.comm, ev.wall,
+             (prm.status != NULL ? prm.status : &ignored_));
+      }
+
+      void on(const dumpi_irecv &prm, const event &ev) {
+        start_recv(ev.function, prm.request, prm.source, prm.tag, prm.comm,
+                   ev.wall);
+      }
+
+      void on(const dumpi_recv_init &prm, const event &ev) {
+        recvs_.erase(prm.request);
+        init(false, ev.function, prm.request, prm.count, prm.datatype,
+             prm.source, prm.tag, prm.comm);
+      }
+
+      void on(const dumpi_sendrecv &prm, const event &ev) {
+        send(ev.function, prm.sendcount, prm.sendtype, prm.dest,
+             prm.sendtag, prm.comm, ev.wall.start);
+        recv(ev.function, prm.source, prm.recvtag, prm.comm, ev.wall,
+             (prm.status != NULL ? prm.status : &ignored_));
+      }
+
+      void on(const dumpi_sendrecv_replace &prm, const event &ev) {
+        send(ev.function, prm.count, prm.datatype, prm.dest,
+             prm.sendtag, prm.comm, ev.wall.start);
+        recv(ev.function, prm.source, prm.recvtag, prm.comm, ev.wall,
+             (prm.status != NULL ? prm.status : &ignored_));
+      }
+
+      void on(const dumpi_start &prm, const event &ev) {
+        start(prm.request, ev.wall);
+      }
+
+      void on(const dumpi_startall &prm, const event &ev) {
+        for(int i = 0; i < prm.count; ++i)
+          start(prm.requests[i], ev.wall);
+      }
+
+      void on(const dumpi_request_free &prm, const event &) {
+        persistent_.erase(prm.request);
+        recvs_.erase(prm.request);
+      }
+
+      void on(const dumpi_wait &prm, const event &ev) {
+        complete(prm.request, prm.status, ev.wall);
+      }
+
+      void on(const dumpi_waitany &prm, const event &ev) {
+        if(prm.index >= 0 && prm.index < prm.count)
+          complete(prm.requests[prm.index], prm.status, ev.wall);
+      }
+
+      void on(const dumpi_waitall &prm, const event &ev) {
+        complete_all(prm.requests, prm.count, prm.statuses, ev.wall);
+      }
+
+      void on(const dumpi_waitsome &prm, const event &ev) {
+        complete_some(prm.requests, prm.outcount, prm.indices, prm.statuses,
+                      prm.count, ev.wall);
+      }
+
+      void on(const dumpi_test &prm, const event &ev) {
+        if(prm.flag)
+          complete(prm.request, prm.status, ev.wall);
+      }
+
+      void on(const dumpi_testany &prm, const event &ev) {
+        if(prm.flag && prm.index >= 0 && prm.index < prm.count)
+          complete(prm.requests[prm.index], prm.status, ev.wall);
+      }
+
+      void on(const dumpi_testall &prm, const event &ev) {
+        if(prm.flag)
+          complete_all(prm.requests, prm.count, prm.statuses, ev.wall);
+      }
+
+      void on(const dumpi_testsome &prm, const event &ev) {
+        complete_some(prm.requests, prm.outcount, prm.indices, prm.statuses,
+                      prm.count, ev.wall);
+      }
+
+    private:
+      /// Stands in for the status of a blocking receive traced without
+      /// statuses (the receive still completed when the call returned).
+      static const dumpi_status ignored_;
+    };
+
+    const dumpi_status p2pstream::ignored_ = { 0, -1, -1, 0, 0 };
+
+    /**
+     * The matching queues.  Posted receives and unexpected messages are
+     * kept per (communicator, destination) so every lookup only scans
+     * the messages that could possibly match.
+     */
+    class p2pqueues {
+      struct recvstate {
+        p2pmessage msg;
+        int32_t want_src, want_tag;
+      };
+      struct partition {
+        std::deque<int64_t> posted;
+        std::deque<p2pmessage> unexpected;
+      };
+
+      const p2pmatch::sink &out_;
+      p2psummary &sum_;
+      /// Receives that are posted, or matched but not yet completed.
+      std::unordered_map<int64_t, recvstate> recvs_;
+      std::unordered_map<int64_t, partition> parts_;
+
+      static int64_t recvkey(int rank, int64_t id) {
+        return (int64_t(rank) << 40) | id;
+      }
+
+      static int64_t partkey(int32_t comm, int32_t dst) {
+        return (int64_t(comm) << 32) | uint32_t(dst);
+      }
+
+      static bool accepts(int32_t want_src, int32_t want_tag,
+                          const p2pmessage &msg)
+      {
+        return ((want_src == DUMPI_ANY_SOURCE || want_src == msg.src) &&
+                (want_tag == DUMPI_ANY_TAG || want_tag == msg.tag));
+      }
+
+      void emit(const p2pmessage &msg) {
+        if(msg.matched()) {
+          ++sum_.matched;
+          if(msg.bytes > 0)
+            sum_.bytes += msg.bytes;
+          if(msg.late_sender()) {
+            ++sum_.late_senders;
+            sum_.late_sender_wait += msg.send_post - msg.recv_post;
+          }
+          else {
+            ++sum_.late_receivers;
+            sum_.late_receiver_wait += msg.recv_post - msg.send_post;
+          }
+          if(msg.recv_done < 0)
+            ++sum_.incomplete_recvs;
+        }
+        else if(msg.send_post >= 0) {
+          ++sum_.unmatched_sends;
+        }
+        else {
+          ++sum_.unmatched_recvs;
+        }
+        out_(msg);
+      }
+
+      /// Fill in the send side of a receive.
+      static void pair(p2pmessage &recv, const p2pmessage &send) {
+        recv.src = send.src;
+        recv.tag = send.tag;
+        recv.bytes = send.bytes;
+        recv.send_post = send.send_post;
+        recv.send_func = send.send_func;
+      }
+
+      /// Take the first unexpected message the receive accepts.
+      bool take_unexpected(partition &part, recvstate &rr) {
+        std::deque<p2pmessage>::iterator it;
+        for(it = part.unexpected.begin(); it != part.unexpected.end(); ++it) {
+          if(accepts(rr.want_src, rr.want_tag, *it)) {
+            pair(rr.msg, *it);
+            part.unexpected.erase(it);
+            return true;
+          }
+        }
+        return false;
+      }
+
+      void prune(std::unordered_map<int64_t, partition>::iterator it) {
+        if(it->second.posted.empty() && it->second.unexpected.empty())
+          parts_.erase(it);
+      }
+
+    public:
+      p2pqueues(const p2pmatch::sink &out, p2psummary &sum) :
+        out_(out), sum_(sum)
+      {}
+
+      void send(int rank, const p2pevent &ev) {
+        p2pmessage msg;
+        msg.src = rank;
+        msg.dst = ev.peer;
+        msg.comm = ev.comm;
+        msg.tag = ev.tag;
+        msg.bytes = ev.bytes;
+        msg.send_post = ev.time;
+        msg.recv_post = msg.recv_done = -1;
+        msg.send_func = ev.func;
+        msg.recv_func = DUMPI_ALL_FUNCTIONS;
+        partition &part = parts_[partkey(ev.comm, ev.peer)];
+        std::deque<int64_t>::iterator it;
+        for(it = part.posted.begin(); it != part.posted.end(); ++it) {
+          std::unordered_map<int64_t, recvstate>::iterator rr = recvs_.find(*it);
+          if(accepts(rr->second.want_src, rr->second.want_tag, msg)) {
+            pair(rr->second.msg, msg);
+            part.posted.erase(it);
+            if(rr->second.msg.recv_done >= 0) {
+              emit(rr->second.msg);
+              recvs_.erase(rr);
+            }
+            prune(parts_.find(partkey(ev.comm, ev.peer)));
+            return;
+          }
+        }
+        part.unexpected.push_back(msg);
+      }
+
+      void recv(int rank, const p2pevent &ev) {
+        recvstate rr;
+        rr.msg.src = -1;
+        rr.msg.dst = rank;
+        rr.msg.comm = ev.comm;
+        rr.msg.tag = -1;
+        rr.msg.bytes = -1;
+        rr.msg.send_post = -1;
+        rr.msg.recv_post = ev.time;
+        rr.msg.recv_done = ev.done;
+        rr.msg.send_func = DUMPI_ALL_FUNCTIONS;
+        rr.msg.recv_func = ev.func;
+        rr.want_src = ev.peer;
+        rr.want_tag = ev.tag;
+        int64_t pk = partkey(ev.comm, rank);
+        std::unordered_map<int64_t, partition>::iterator part = parts_.find(pk);
+        if(part != parts_.end() && take_unexpected(part->second, rr)) {
+          prune(part);
+          if(rr.msg.recv_done >= 0)
+            emit(rr.msg);
+          else
+            recvs_[recvkey(rank, ev.id)] = rr;
+          return;
+        }
+        recvs_[recvkey(rank, ev.id)] = rr;
+        parts_[pk].posted.push_back(recvkey(rank, ev.id));
+      }
+
+      void done(int rank, const p2pevent &ev) {
+        int64_t rk = recvkey(rank, ev.id);
+        std::unordered_map<int64_t, recvstate>::iterator rr = recvs_.find(rk);
+        if(rr == recvs_.end())
+          return;
+        recvstate &state = rr->second;
+        state.msg.recv_done = ev.time;
+        if(state.msg.matched()) {
+          emit(state.msg);
+          recvs_.erase(rr);
+          return;
+        }
+        if(ev.peer < 0)
+          return;
+        // The status tells us which message this was;  it has not been
+        // sent yet as far as the clocks are concerned.
+        state.want_src = ev.peer;
+        state.want_tag = ev.tag;
+        std::unordered_map<int64_t, partition>::iterator part =
+          parts_.find(partkey(state.msg.comm, rank));
+        if(part != parts_.end() && take_unexpected(part->second, state)) {
+          std::deque<int64_t> &posted = part->second.posted;
+          posted.erase(std::find(posted.begin(), posted.end(), rk));
+          prune(part);
+          emit(state.msg);
+          recvs_.erase(rr);
+        }
+      }
+
+      /// Hand out everything that is left, in a reproducible order.
+      void finish() {
+        std::vector<p2pmessage> left;
+        std::unordered_map<int64_t, partition>::const_iterator part;
+        for(part = parts_.begin(); part != parts_.end(); ++part)
+          left.insert(left.end(), part->second.unexpected.begin(),
+                      part->second.unexpected.end());
+        std::unordered_map<int64_t, recvstate>::const_iterator rr;
+        for(rr = recvs_.begin(); rr != recvs_.end(); ++rr)
+          left.push_back(rr->second.msg);
+        parts_.clear();
+        recvs_.clear();
+        std::sort(left.begin(), left.end(), earlier);
+        for(size_t i = 0; i < left.size(); ++i)
+          emit(left[i]);
+      }
+
+      static bool earlier(const p2pmessage &a, const p2pmessage &b) {
+        int64_t ta = std::max(a.send_post, a.recv_post);
+        int64_t tb = std::max(b.send_post, b.recv_post);
+        if(ta != tb) return ta < tb;
+        if(a.src != b.src) return a.src < b.src;
+        return a.dst < b.dst;
+      }
+    };
+
+  } // end of anonymous namespace
+
+  p2pmatch::p2pmatch(const metadata &meta, const std::vector<trace> &traces,
+                     size_t threads, size_t readahead) :
+    meta_(meta), traces_(traces), threads_(threads), readahead_(readahead)
+  {
+    if(threads_ < 1)
+      threads_ = std::thread::hardware_concurrency();
+    if(threads_ < 1)
+      threads_ = 1;
+    if(readahead_ < 2)
+      readahead_ = 2;
+  }
+
+  p2psummary p2pmatch::run(const sink &out) const {
+    p2psummary sum;
+    const size_t ranks = traces_.size();
+    if(ranks == 0)
+      return sum;
+    // All ranks share one time origin (the earliest return from MPI_Init);
+    // shifting ranks against each other would break the latencies when
+    // the clocks are in sync, and MPI_Init is no barrier to sync them by.
+    int64_t origin = -1;
+    for(size_t i = 0; i < ranks; ++i) {
+      int64_t init = to_nsec(traces_[i].init_time());
+      if(init > 0 && (origin < 0 || init < origin))
+        origin = init;
+    }
+    if(origin < 0)
+      origin = 0;
+    std::vector<std::unique_ptr<p2pstream> > streams;
+    for(size_t i = 0; i < ranks; ++i)
+      streams.push_back(std::unique_ptr<p2pstream>
+                        (new p2pstream(i, meta_.tracename(i), &traces_[i],
+                                       origin)));
+
+    // Each stream holds at most two chunks:  one the merger works through
+    // and one a worker decodes in the meantime.
+    const size_t chunk = readahead_ / 2;
+    std::mutex lock;
+    std::condition_variable wake_worker, wake_merger;
+    std::deque<size_t> todo;
+    bool stop = false;
+    auto schedule = [&](size_t rank) {
+      p2pstream &ss = *streams[rank];
+      if(! ss.busy && ! ss.finished) {
+        ss.busy = true;
+        todo.push_back(rank);
+        wake_worker.notify_one();
+      }
+    };
+    auto work = [&]() {
+      std::vector<p2pevent> buf;
+      for(;;) {
+        size_t rank;
+        {
+          std::unique_lock<std::mutex> guard(lock);
+          wake_worker.wait(guard, [&]() { return stop || ! todo.empty(); });
+          if(todo.empty())
+            return;
+          rank = todo.front();
+          todo.pop_front();
+        }
+        p2pstream &ss = *streams[rank];
+        buf.clear();
+        bool more = ss.fill(buf, chunk);
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          ss.ready.insert(ss.ready.end(), buf.begin(), buf.end());
+          ss.finished = ! more;
+          ss.busy = false;
+        }
+        wake_merger.notify_all();
+      }
+    };
+    // Make the merger's queue for a rank non-empty if anything is left.
+    auto refill = [&](size_t rank) {
+      p2pstream &ss = *streams[rank];
+      std::unique_lock<std::mutex> guard(lock);
+      while(ss.ready.empty() && ! ss.finished) {
+        schedule(rank);
+        wake_merger.wait(guard);
+      }
+      ss.current.swap(ss.ready);
+      schedule(rank);
+      return ! ss.current.empty();
+    };
+
+    std::vector<std::thread> workers;
+    size_t nthread = std::min(threads_, ranks);
+    for(size_t t = 0; t < nthread; ++t)
+      workers.push_back(std::thread(work));
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      for(size_t i = 0; i < ranks; ++i)
+        schedule(i);
+    }
+
+    p2pqueues queues(out, sum);
+    typedef std::pair<int64_t, size_t> head;
+    std::priority_queue<head, std::vector<head>, std::greater<head> > heap;
+    for(size_t i = 0; i < ranks; ++i)
+      if(refill(i))
+        heap.push(head(streams[i]->current.front().time, i));
+    while(! heap.empty()) {
+      size_t rank = heap.top().second;
+      heap.pop();
+      p2pstream &ss = *streams[rank];
+      const p2pevent &ev = ss.current.front();
+      switch(ev.kind) {
+      case p2pevent::SEND: queues.send(rank, ev); break;
+      case p2pevent::RECV: queues.recv(rank, ev); break;
+      case p2pevent::DONE: queues.done(rank, ev); break;
+      }
+      ss.current.pop_front();
+      if(! ss.current.empty() || refill(rank))
+        heap.push(head(ss.current.front().time, rank));
+    }
+    queues.finish();
+
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stop = true;
+    }
+    wake_worker.notify_all();
+    for(size_t t = 0; t < workers.size(); ++t)
+      workers[t].join();
+    for(size_t i = 0; i < ranks; ++i)
+      sum.unresolved += streams[i]->unresolved;
+    return sum;
+  }
+
+  static void open_table(std::ofstream &out, const std::string &fname) {
+    out.open(fname.c_str());
+    if(! out) {
+      std::cerr << "p2pmatch:  Failed to open outfile " << fname << "\n";
+      throw "p2pmatch:  Failed to open outfile.";
+    }
+  }
+
+  p2psummary p2pmatch::write(const std::string &fileroot) const {
+    std::ofstream dat, sum;
+    open_table(dat, fileroot + ".dat");
+    dat << "########################################################\n"
+        << "# Point-to-point messages paired by MPI matching rules\n"
+        << "# (times in ns since the first MPI_Init returned, -1 if missing)\n"
+        << "#\n"
+        << "# Column 1 is sending rank\n"
+        << "# Column 2 is receiving rank\n"
+        << "# Column 3 is communicator\n"
+        << "# Column 4 is tag\n"
+        << "# Column 5 is bytes\n"
+        << "# Column 6 is send posted\n"
+        << "# Column 7 is receive posted\n"
+        << "# Column 8 is receive completed\n"
+        << "# Column 9 is latency (receive completed - send posted)\n"
+        << "# Column 10 is LS (late sender), LR (late receiver),\n"
+        << "#           US (unmatched send) or UR (unmatched receive)\n"
+        << "# Column 11 is send function\n"
+        << "# Column 12 is receive function\n"
+        << "#\n# ";
+    for(int lbl = 1; lbl <= 12; ++lbl)
+      dat << std::setw(lbl == 10 ? 3 : (lbl > 10 ? 16 : 12)) << lbl << " ";
+    dat << "\n";
+    p2psummary total = this->run([&](const p2pmessage &msg) {
+        const char *cls = (msg.matched() ?
+                           (msg.late_sender() ? "LS" : "LR") :
+                           (msg.send_post >= 0 ? "US" : "UR"));
+        int64_t latency = (msg.matched() && msg.recv_done >= 0 ?
+                           msg.recv_done - msg.send_post : -1);
+        dat << "  " << std::setw(12) << msg.src << " "
+            << std::setw(12) << msg.dst << " "
+            << std::setw(12) << msg.comm << " "
+            << std::setw(12) << msg.tag << " "
+            << std::setw(12) << msg.bytes << " "
+            << std::setw(12) << msg.send_post << " "
+            << std::setw(12) << msg.recv_post << " "
+            << std::setw(12) << msg.recv_done << " "
+            << std::setw(12) << latency << " "
+            << std::setw(3) << cls << " "
+            << std::setw(16) << (msg.send_post >= 0 ?
+                                 dumpi_function_label(msg.send_func) : "-") << " "
+            << std::setw(16) << (msg.recv_post >= 0 ?
+                                 dumpi_function_label(msg.recv_func) : "-")
+            << "\n";
+      });
+    open_table(sum, fileroot + ".sum");
+    sum << "matched             " << total.matched << "\n"
+        << "bytes               " << total.bytes << "\n"
+        << "late_senders        " << total.late_senders << "\n"
+        << "late_sender_wait    " << total.late_sender_wait << "\n"
+        << "late_receivers      " << total.late_receivers << "\n"
+        << "late_receiver_wait  " << total.late_receiver_wait << "\n"
+        << "incomplete_recvs    " << total.incomplete_recvs << "\n"
+        << "unmatched_sends     " << total.unmatched_sends << "\n"
+        << "unmatched_recvs     " << total.unmatched_recvs << "\n"
+        << "unresolved_calls    " << total.unresolved << "\n";
+    return total;
+  }
+
+} // end of namespace dumpi
@@ -0,0 +1,146 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_BIN_P2PMATCH_H
+#define DUMPI_BIN_P2PMATCH_H
+
+#include <dumpi/bin/metadata.h>
+#include <dumpi/bin/trace.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace dumpi {
+
+  /**
+   * \ingroup dumpi_utilities
+   */
+  /*@{*/
+
+  /**
+   * A point-to-point message with the send paired to its receive.
+   * Ranks are MPI_COMM_WORLD ranks.  Times are nanoseconds since the
+   * first rank returned from MPI_Init (the clocks of all ranks are taken
+   * to be in sync), and -1 where an end is missing.
+   */
+  struct p2pmessage {
+    int32_t src, dst;
+    /// Communicator (comm::get_unique_index, the same on every rank).
+    int32_t comm;
+    int32_t tag;
+    /// Bytes sent (-1 if the datatype is not known).
+    int64_t bytes;
+    /// Entry into the send and receive calls.
+    int64_t send_post, recv_post;
+    /// Return from the call that completed the receive.
+    int64_t recv_done;
+    /// The calls that sent and received the message.
+    dumpi_function send_func, recv_func;
+
+    bool matched() const { return send_post >= 0 && recv_post >= 0; }
+    /// True if the receive was posted before the message was sent.
+    bool late_sender() const { return matched() && recv_post < send_post; }
+  };
+
+  /// Totals over everything the matcher saw.
+  struct p2psummary {
+    int64_t matched, unmatched_sends, unmatched_recvs, incomplete_recvs;
+    int64_t late_senders, late_receivers;
+    /// Time receivers were posted before the matching send (late sender)
+    /// and sends were posted before the matching receive (late receiver).
+    int64_t late_sender_wait, late_receiver_wait;
+    int64_t bytes;
+    /// Calls skipped because the communicator or peer could not be resolved.
+    int64_t unresolved;
+    p2psummary();
+  };
+
+  /**
+   * Pair sends with receives across all ranks of a trace, following the
+   * MPI matching rules:  a message goes to the first posted receive on the
+   * same communicator whose source and tag match (or are wildcards), and
+   * messages between a pair of ranks on a communicator are not overtaken.
+   *
+   * The streams are decoded by worker threads into small per-rank event
+   * queues.  A single thread merges them in time order
+   * and keeps a posted-receive and an unexpected-message queue for each
+   * communicator and destination, so memory is bounded by the messages
+   * in flight rather than by the size of the trace.  The trace files are
+   * opened through filecache::global(), so the number of ranks is not
+   * limited by the number of open files.
+   * Wildcard receives that complete with a status are resolved using
+   * the source and tag from the status.
+   */
+  class p2pmatch {
+  public:
+    /// Receives each message once both ends are known and the receive
+    /// has completed; unmatched and incomplete ones follow at the end.
+    typedef std::function<void(const p2pmessage&)> sink;
+
+  private:
+    const metadata &meta_;
+    const std::vector<trace> &traces_;
+    size_t threads_, readahead_;
+
+  public:
+    /// Match the traces in meta (preparsed into traces).
+    /// \param threads    decoding threads (0 for one per core).
+    /// \param readahead  events kept in memory per rank.
+    p2pmatch(const metadata &meta, const std::vector<trace> &traces,
+             size_t threads = 0, size_t readahead = 4096);
+
+    /// Read all streams and hand every message to out.
+    p2psummary run(const sink &out) const;
+
+    /// Run and write <fileroot>.dat (one row per message) and
+    /// <fileroot>.sum (the totals).
+    p2psummary write(const std::string &fileroot) const;
+  };
+
+  /*@}*/
+
+} // end of namespace dumpi
+
+#endif // ! DUMPI_BIN_P2PMATCH_H
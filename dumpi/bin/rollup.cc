@@ -0,0 +1,356 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/bin/rollup.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+namespace dumpi {
+
+  static const char rollup_magic[8] = {'D','U','M','P','I','R','L','P'};
+  static const int32_t rollup_version = 1;
+
+  template <typename T>
+  inline bool put(FILE *fp, const std::vector<T> &vec) {
+    return (vec.empty() ||
+            fwrite(&vec[0], sizeof(T), vec.size(), fp) == vec.size());
+  }
+
+  template <typename T>
+  inline bool get(FILE *fp, std::vector<T> &vec, int64_t size) {
+    vec.resize(size);
+    return (vec.empty() ||
+            fread(&vec[0], sizeof(T), vec.size(), fp) == vec.size());
+  }
+
+  //
+  // Empty rollup.
+  //
+  rollup::rollup() :
+    rank_(-1), ordered_(1), trace_size_(-1), trace_mtime_(-1),
+    width_(default_width), origin_(0), start_time_(0), stop_time_(0),
+    init_time_(0), finalize_time_(0), entry_start_(1, 0),
+    prev_cpu_stop_(INT64_MIN), prev_wall_stop_(INT64_MIN)
+  {}
+
+  //
+  // Start over.
+  //
+  void rollup::begin(int32_t rank, int64_t origin, int64_t width) {
+    *this = rollup();
+    rank_ = rank;
+    origin_ = origin;
+    width_ = (width > 0 ? width : default_width);
+  }
+
+  //
+  // Reference times.
+  //
+  void rollup::set_times(const dumpi_clock &start, const dumpi_clock &stop,
+                         const dumpi_clock &init, const dumpi_clock &finalize)
+  {
+    start_time_ = flatten(start);
+    stop_time_ = flatten(stop);
+    init_time_ = flatten(init);
+    finalize_time_ = flatten(finalize);
+  }
+
+  //
+  // Close the entry list of the last bucket.
+  //
+  void rollup::close_bucket() {
+    entry_start_.push_back(int64_t(func_.size()));
+    open_.clear();
+  }
+
+  //
+  // Add a call.
+  //
+  void rollup::add(dumpi_function func, int64_t cpu_start, int64_t cpu_stop,
+                   int64_t wall_start, int64_t wall_stop,
+                   int64_t bytes_sent, int to_rank,
+                   int64_t bytes_recvd, int from_rank)
+  {
+    // Overlapping calls (threads) make bucket totals differ from what
+    // timebin collects call by call.
+    if(wall_start < prev_wall_stop_ || cpu_start < prev_cpu_stop_ ||
+       wall_stop < wall_start || cpu_stop < cpu_start)
+      ordered_ = 0;
+    prev_cpu_stop_ = cpu_stop;
+    prev_wall_stop_ = wall_stop;
+    int64_t offset = wall_start - origin_;
+    int64_t idx = (offset >= 0 ? offset / width_ :
+                   -((width_ - 1 - offset) / width_));
+    if(index_.empty() || idx != index_.back()) {
+      if(! index_.empty()) {
+        if(idx < index_.back())
+          ordered_ = 0;
+        this->close_bucket();
+      }
+      index_.push_back(idx);
+      calls_.push_back(0);
+      first_func_.push_back(int32_t(func));
+      first_cpu_start_.push_back(cpu_start);
+      first_cpu_stop_.push_back(cpu_stop);
+      first_wall_start_.push_back(wall_start);
+      first_wall_stop_.push_back(wall_stop);
+      last_wall_start_.push_back(0);
+      last_cpu_stop_.push_back(0);
+      last_wall_stop_.push_back(0);
+    }
+    size_t b = index_.size() - 1;
+    ++calls_[b];
+    last_wall_start_[b] = wall_start;
+    last_cpu_stop_[b] = cpu_stop;
+    last_wall_stop_[b] = wall_stop;
+    std::map<int32_t, size_t>::iterator it = open_.find(int32_t(func));
+    if(it == open_.end()) {
+      it = open_.insert(std::make_pair(int32_t(func), func_.size())).first;
+      func_.push_back(int32_t(func));
+      count_.push_back(0);
+      cpu_.push_back(0);
+      wall_.push_back(0);
+      sent_.push_back(0);
+      recvd_.push_back(0);
+    }
+    size_t e = it->second;
+    ++count_[e];
+    cpu_[e] += cpu_stop - cpu_start;
+    wall_[e] += wall_stop - wall_start;
+    sent_[e] += bytes_sent;
+    recvd_[e] += bytes_recvd;
+    if(to_rank >= 0 && bytes_sent > 0)
+      peers_[to_rank].first += bytes_sent;
+    if(from_rank >= 0 && bytes_recvd > 0)
+      peers_[from_rank].second += bytes_recvd;
+  }
+
+  //
+  // Done adding calls.
+  //
+  void rollup::end() {
+    if(entry_start_.size() == index_.size())
+      this->close_bucket();
+    std::map<int32_t, std::pair<int64_t, int64_t> >::const_iterator it;
+    for(it = peers_.begin(); it != peers_.end(); ++it) {
+      peer_.push_back(it->first);
+      peer_sent_.push_back(it->second.first);
+      peer_recvd_.push_back(it->second.second);
+    }
+    peers_.clear();
+  }
+
+  //
+  // Remember what the trace file looked like.
+  //
+  bool rollup::set_source(const std::string &tracename) {
+    struct stat st;
+    if(stat(tracename.c_str(), &st) != 0)
+      return false;
+    trace_size_ = int64_t(st.st_size);
+    trace_mtime_ = int64_t(st.st_mtime);
+    return true;
+  }
+
+  //
+  // Is the trace file unchanged?
+  //
+  bool rollup::matches(const std::string &tracename) const {
+    struct stat st;
+    return (stat(tracename.c_str(), &st) == 0 &&
+            trace_size_ == int64_t(st.st_size) &&
+            trace_mtime_ == int64_t(st.st_mtime));
+  }
+
+  //
+  // Write the rollup to the given file.
+  //
+  void rollup::write(const std::string &fname) const {
+    FILE *fp = fopen(fname.c_str(), "wb");
+    if(fp == NULL) {
+      std::cerr << "rollup:  Failed to open outfile " << fname << "\n";
+      throw "rollup:  Failed to open outfile.";
+    }
+    int32_t unused = 0;
+    int64_t buckets = int64_t(index_.size()), entries = int64_t(func_.size());
+    int64_t peers = int64_t(peer_.size());
+    bool ok = (fwrite(rollup_magic, sizeof(rollup_magic), 1, fp) == 1 &&
+               fwrite(&rollup_version, sizeof(int32_t), 1, fp) == 1 &&
+               fwrite(&rank_, sizeof(int32_t), 1, fp) == 1 &&
+               fwrite(&ordered_, sizeof(int32_t), 1, fp) == 1 &&
+               fwrite(&unused, sizeof(int32_t), 1, fp) == 1 &&
+               fwrite(&trace_size_, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&trace_mtime_, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&width_, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&origin_, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&start_time_, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&stop_time_, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&init_time_, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&finalize_time_, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&buckets, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&entries, sizeof(int64_t), 1, fp) == 1 &&
+               fwrite(&peers, sizeof(int64_t), 1, fp) == 1 &&
+               put(fp, index_) && put(fp, calls_) && put(fp, first_func_) &&
+               put(fp, first_cpu_start_) && put(fp, first_cpu_stop_) &&
+               put(fp, first_wall_start_) && put(fp, first_wall_stop_) &&
+               put(fp, last_wall_start_) && put(fp, last_cpu_stop_) &&
+               put(fp, last_wall_stop_) && put(fp, entry_start_) &&
+               put(fp, func_) && put(fp, count_) && put(fp, cpu_) &&
+               put(fp, wall_) && put(fp, sent_) && put(fp, recvd_) &&
+               put(fp, peer_) && put(fp, peer_sent_) && put(fp, peer_recvd_));
+    if(fclose(fp) != 0) ok = false;
+    if(! ok) {
+      std::cerr << "rollup:  Failed to write " << fname << "\n";
+      throw "rollup:  Failed to write outfile.";
+    }
+  }
+
+  //
+  // Read a rollup from file.
+  //
+  bool rollup::read(const std::string &fname) {
+    FILE *fp = fopen(fname.c_str(), "rb");
+    if(fp == NULL)
+      return false;
+    *this = rollup();
+    char magic[sizeof(rollup_magic)];
+    int32_t version = 0, unused = 0;
+    int64_t buckets = 0, entries = 0, peers = 0;
+    bool ok = (fread(magic, sizeof(magic), 1, fp) == 1 &&
+               memcmp(magic, rollup_magic, sizeof(magic)) == 0 &&
+               fread(&version, sizeof(int32_t), 1, fp) == 1 &&
+               version == rollup_version &&
+               fread(&rank_, sizeof(int32_t), 1, fp) == 1 &&
+               fread(&ordered_, sizeof(int32_t), 1, fp) == 1 &&
+               fread(&unused, sizeof(int32_t), 1, fp) == 1 &&
+               fread(&trace_size_, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&trace_mtime_, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&width_, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&origin_, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&start_time_, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&stop_time_, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&init_time_, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&finalize_time_, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&buckets, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&entries, sizeof(int64_t), 1, fp) == 1 &&
+               fread(&peers, sizeof(int64_t), 1, fp) == 1 &&
+               width_ > 0 && buckets >= 0 && entries >= 0 && peers >= 0);
+    ok = (ok && get(fp, index_, buckets) && get(fp, calls_, buckets) &&
+          get(fp, first_func_, buckets) &&
+          get(fp, first_cpu_start_, buckets) &&
+          get(fp, first_cpu_stop_, buckets) &&
+          get(fp, first_wall_start_, buckets) &&
+          get(fp, first_wall_stop_, buckets) &&
+          get(fp, last_wall_start_, buckets) &&
+          get(fp, last_cpu_stop_, buckets) &&
+          get(fp, last_wall_stop_, buckets) &&
+          get(fp, entry_start_, buckets+1) &&
+          get(fp, func_, entries) && get(fp, count_, entries) &&
+          get(fp, cpu_, entries) && get(fp, wall_, entries) &&
+          get(fp, sent_, entries) && get(fp, recvd_, entries) &&
+          get(fp, peer_, peers) && get(fp, peer_sent_, peers) &&
+          get(fp, peer_recvd_, peers));
+    fclose(fp);
+    if(ok && (entry_start_.front() != 0 || entry_start_.back() != entries))
+      ok = false;
+    for(int64_t e = 0; ok && e < entries; ++e)
+      if(func_[e] < 0 || func_[e] >= DUMPI_END_OF_STREAM)
+        ok = false;
+    if(! ok) {
+      *this = rollup();
+    }
+    return ok;
+  }
+
+  //
+  // The first call of a bucket.
+  //
+  void rollup::first_stamp(size_t b, eventstamp &ev) const {
+    ev.cpu_start = first_cpu_start_.at(b);
+    ev.cpu_stop = first_cpu_stop_.at(b);
+    ev.wall_start = first_wall_start_.at(b);
+    ev.wall_stop = first_wall_stop_.at(b);
+    ev.perf_count = 0;
+  }
+
+  //
+  // The last call of a bucket (its cpu start time is not kept).
+  //
+  void rollup::last_stamp(size_t b, eventstamp &ev) const {
+    ev.cpu_start = ev.cpu_stop = last_cpu_stop_.at(b);
+    ev.wall_start = last_wall_start_.at(b);
+    ev.wall_stop = last_wall_stop_.at(b);
+    ev.perf_count = 0;
+  }
+
+  //
+  // dumpi-<host>-<rank>.bin gets dumpi-<host>-<rank>.rollup
+  //
+  std::string rollup::sidecar(const std::string &tracename) {
+    std::string::size_type len = tracename.size();
+    if(len > 4 && tracename.compare(len-4, 4, ".bin") == 0)
+      return tracename.substr(0, len-4) + ".rollup";
+    return tracename + ".rollup";
+  }
+
+  //
+  // Read the rollups of all traces.
+  //
+  bool rollup::read_all(const metadata &meta, std::vector<rollup> &ru) {
+    ru.clear();
+    ru.resize(meta.numTraces());
+    for(int rank = 0; rank < meta.numTraces(); ++rank) {
+      std::string tname = meta.tracename(rank);
+      if(! (ru[rank].read(sidecar(tname)) && ru[rank].rank() == rank &&
+            ru[rank].matches(tname))) {
+        ru.clear();
+        return false;
+      }
+    }
+    return true;
+  }
+
+} // end of namespace dumpi
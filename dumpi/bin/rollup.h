@@ -0,0 +1,209 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_BIN_ROLLUP_H
+#define DUMPI_BIN_ROLLUP_H
+
+#include <dumpi/bin/dumpistats-batch.h>
+#include <dumpi/bin/metadata.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+
+namespace dumpi {
+
+  /**
+   * \ingroup dumpi_utilities
+   */
+  /*@{*/
+
+  /**
+   * Per-function call counts, times and bytes of one trace, summed over
+   * fixed-width wall-clock buckets (1 ms by default), plus the bytes
+   * exchanged with each peer over the whole trace.  dumpistats keeps
+   * one next to every trace file (see sidecar()) so that counts, times
+   * and bytes can be binned without reading the trace again.
+   *
+   * Only buckets holding calls are kept.  For each of them, the first
+   * and last call are stored as well, so a time bin that starts or ends
+   * inside a bucket looks exactly like one collected from the trace.
+   *
+   * The binary file layout (native byte order) is:
+   *    char    magic[8] = "DUMPIRLP"
+   *    int32_t version, rank, ordered, (unused)
+   *    int64_t trace_size, trace_mtime, width, origin
+   *    int64_t start_time, stop_time, init_time, finalize_time
+   *    int64_t buckets, entries, peers
+   *    int64_t index[buckets], calls[buckets]
+   *    int32_t first_func[buckets]
+   *    int64_t first_cpu_start[buckets], first_cpu_stop[buckets]
+   *    int64_t first_wall_start[buckets], first_wall_stop[buckets]
+   *    int64_t last_wall_start[buckets]
+   *    int64_t last_cpu_stop[buckets], last_wall_stop[buckets]
+   *    int64_t entry_start[buckets+1]
+   *    int32_t func[entries]
+   *    int64_t count[entries], cpu[entries], wall[entries]
+   *    int64_t sent[entries], recvd[entries]
+   *    int32_t peer[peers]
+   *    int64_t peer_sent[peers], peer_recvd[peers]
+   * Times are flattened nanoseconds; bucket b covers the wall-clock
+   * start times origin + index[b]*width up to origin + (index[b]+1)*width
+   * and holds entries entry_start[b] up to entry_start[b+1].
+   */
+  class rollup {
+  public:
+    /// Default bucket width (nanoseconds).
+    static const int64_t default_width = 1000000;
+
+  private:
+    int32_t rank_, ordered_;
+    int64_t trace_size_, trace_mtime_, width_, origin_;
+    int64_t start_time_, stop_time_, init_time_, finalize_time_;
+    std::vector<int64_t> index_, calls_;
+    std::vector<int32_t> first_func_;
+    std::vector<int64_t> first_cpu_start_, first_cpu_stop_;
+    std::vector<int64_t> first_wall_start_, first_wall_stop_;
+    std::vector<int64_t> last_wall_start_, last_cpu_stop_, last_wall_stop_;
+    std::vector<int64_t> entry_start_;
+    std::vector<int32_t> func_;
+    std::vector<int64_t> count_, cpu_, wall_, sent_, recvd_;
+    std::vector<int32_t> peer_;
+    std::vector<int64_t> peer_sent_, peer_recvd_;
+
+    /// Build state: previous call and per-function totals of the
+    /// bucket being filled.
+    int64_t prev_cpu_stop_, prev_wall_stop_;
+    std::map<int32_t, size_t> open_;
+    std::map<int32_t, std::pair<int64_t, int64_t> > peers_;
+
+    void close_bucket();
+
+  public:
+    /// Empty rollup.
+    rollup();
+
+    /// Start over for the given rank.  Buckets are counted from origin.
+    void begin(int32_t rank, int64_t origin, int64_t width = default_width);
+
+    /// Record the reference times of the trace (see timebin).
+    void set_times(const dumpi_clock &start, const dumpi_clock &stop,
+                   const dumpi_clock &init, const dumpi_clock &finalize);
+
+    /// Add a call.  Calls must be added in trace order.
+    void add(dumpi_function func, int64_t cpu_start, int64_t cpu_stop,
+             int64_t wall_start, int64_t wall_stop,
+             int64_t bytes_sent, int to_rank,
+             int64_t bytes_recvd, int from_rank);
+
+    /// Done adding calls.
+    void end();
+
+    /// Remember the size and modification time of the trace file.
+    /// \return false if the file could not be stat'ed.
+    bool set_source(const std::string &tracename);
+
+    /// True if the trace file is unchanged since set_source.
+    bool matches(const std::string &tracename) const;
+
+    /// Write the rollup to the given file.  Throws on failure.
+    void write(const std::string &fname) const;
+
+    /// Replace this rollup with the content of the given file.
+    /// \return false if the file could not be read or is not a rollup.
+    bool read(const std::string &fname);
+
+    /// The rollup file kept for the given trace file.
+    static std::string sidecar(const std::string &tracename);
+
+    /// Read the rollups for all traces in the metafile.
+    /// \return false unless every trace has an up-to-date rollup.
+    static bool read_all(const metadata &meta, std::vector<rollup> &ru);
+
+    int32_t rank() const { return rank_; }
+    /// True if no two calls overlap in time (e.g. single-threaded).
+    /// Only then are calls in bucket order and times exact.
+    bool ordered() const { return ordered_ != 0; }
+    int64_t width() const { return width_; }
+    int64_t origin() const { return origin_; }
+    dumpi_clock start_time() const { return unflatten(start_time_); }
+    dumpi_clock stop_time() const { return unflatten(stop_time_); }
+    dumpi_clock init_time() const { return unflatten(init_time_); }
+    dumpi_clock finalize_time() const { return unflatten(finalize_time_); }
+
+    size_t buckets() const { return index_.size(); }
+    int64_t index(size_t b) const { return index_.at(b); }
+    /// All calls in a bucket, whichever function.
+    int64_t calls(size_t b) const { return calls_.at(b); }
+    /// The first and last call of a bucket.
+    dumpi_function first_func(size_t b) const {
+      return dumpi_function(first_func_.at(b));
+    }
+    void first_stamp(size_t b, eventstamp &ev) const;
+    void last_stamp(size_t b, eventstamp &ev) const;
+    int64_t first_wall_start(size_t b) const { return first_wall_start_.at(b); }
+    int64_t last_wall_start(size_t b) const { return last_wall_start_.at(b); }
+
+    /// Entries for a bucket run from entry_begin(b) up to entry_end(b).
+    int64_t entry_begin(size_t b) const { return entry_start_.at(b); }
+    int64_t entry_end(size_t b) const { return entry_start_.at(b+1); }
+    dumpi_function func(int64_t e) const { return dumpi_function(func_.at(e)); }
+    int64_t count(int64_t e) const { return count_.at(e); }
+    int64_t cpu(int64_t e) const { return cpu_.at(e); }
+    int64_t wall(int64_t e) const { return wall_.at(e); }
+    int64_t sent(int64_t e) const { return sent_.at(e); }
+    int64_t recvd(int64_t e) const { return recvd_.at(e); }
+
+    /// Bytes exchanged with each peer (by MPI_COMM_WORLD rank).
+    size_t peers() const { return peer_.size(); }
+    int32_t peer(size_t p) const { return peer_.at(p); }
+    int64_t peer_sent(size_t p) const { return peer_sent_.at(p); }
+    int64_t peer_recvd(size_t p) const { return peer_recvd_.at(p); }
+  };
+
+  /*@}*/
+
+} // end of namespace dumpi
+
+#endif // ! DUMPI_BIN_ROLLUP_H
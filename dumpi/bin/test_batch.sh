@@ -0,0 +1,26 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+# Batched reading must give the same calls as undumpi_read_stream, on the
+# test traces and on a generated trace with two threads per rank and
+# perfcounters.
+good=0
+./checkbatch $srcdir/../../tests/traces/*.bin
+good=`expr $good + $?`
+
+rm -rf batch.d
+mkdir batch.d
+./dumpigen -r 2 -s 200 -t 2 -p 2 -o batch.d/gen > /dev/null &&
+  ./checkbatch batch.d/gen-*.bin
+good=`expr $good + $?`
+rm -rf batch.d
+exit $good
@@ -0,0 +1,35 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+# profile-0000.bin is rank 0 of a four-rank run recorded with "mode
+# profile" in dumpi.conf.  Check the call statistics dumpi2ascii -C prints
+# for it, also after a round trip through ascii2dumpi, and that a trace
+# without them (whose index predates the statistics) prints nothing.
+traces=$srcdir/../../tests/traces
+good=0
+
+./dumpi2ascii -C $traces/profile-0000.bin > callstats.txt
+diff -q callstats.txt $traces/profile-0000.txt
+good=`expr $good + $?`
+
+./dumpi2ascii -a $traces/profile-0000.bin > callstats-all.txt &&
+  ./ascii2dumpi -o callstats.bin callstats-all.txt &&
+  ./dumpi2ascii -C callstats.bin > callstats.txt &&
+  diff -q callstats.txt $traces/profile-0000.txt
+good=`expr $good + $?`
+
+./dumpi2ascii -C $traces/testtrace-0000.bin > callstats.txt &&
+  test ! -s callstats.txt
+good=`expr $good + $?`
+
+rm -f callstats.txt callstats-all.txt callstats.bin
+exit $good
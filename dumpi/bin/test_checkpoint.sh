@@ -0,0 +1,28 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+
+# checkpoint-0000.bin was recorded with "checkpoint 1" in dumpi.conf.
+# Cut it off before the index, as if the job had been killed, and check
+# that the records up to the last checkpoint can still be read.
+trace=$srcdir/../../tests/traces/checkpoint-0000.bin
+
+./dumpi2ascii -S $trace > chkfull.txt
+head -c 1000 $trace > chktrunc.bin
+./dumpi2ascii -S chktrunc.bin > chktrunc.txt 2> /dev/null
+
+size=`wc -c < chktrunc.txt`
+test $size -gt 0 && test $size -lt `wc -c < chkfull.txt` &&
+  head -c $size chkfull.txt | cmp -s - chktrunc.txt
+retval="$?"
+rm -f chkfull.txt chktrunc.bin chktrunc.txt
+exit $retval
@@ -0,0 +1,41 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+# commstats-0000.bin and commstats-0001.bin are ranks 0 and 1 of a run of
+# the program behind profile-0000.bin, recorded with "commmatrix enable".
+# Rank 0 sends to rank 1 only, rank 1 to rank 2 only; rank 1 leads the
+# communicator of the odd ranks.  Check the rows dumpi2ascii -M prints,
+# also after a round trip through ascii2dumpi, and that a trace without
+# a matrix prints nothing.
+traces=$srcdir/../../tests/traces
+good=0
+
+for rank in 0 1; do
+  ./dumpi2ascii -M $traces/commstats-000$rank.bin
+done > commstats.txt
+diff -q commstats.txt $traces/commstats.txt
+good=`expr $good + $?`
+
+for rank in 0 1; do
+  ./dumpi2ascii -a $traces/commstats-000$rank.bin > commstats-all.txt &&
+    ./ascii2dumpi -o commstats.bin commstats-all.txt &&
+    ./dumpi2ascii -M commstats.bin
+done > commstats.txt
+diff -q commstats.txt $traces/commstats.txt
+good=`expr $good + $?`
+
+./dumpi2ascii -M $traces/testtrace-0000.bin > commstats.txt &&
+  test ! -s commstats.txt
+good=`expr $good + $?`
+
+rm -f commstats.txt commstats-all.txt commstats.bin
+exit $good
@@ -0,0 +1,31 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+# Check dumpistate against the stream reader on the test traces and on a
+# generated trace that splits MPI_COMM_WORLD into three groups.
+here=`pwd`
+good=0
+cd $srcdir/../../tests/traces
+$here/checkdumpistate testtrace.meta testtrace-*.bin
+good=`expr $good + $?`
+cd $here
+
+rm -rf dumpistate.d
+mkdir dumpistate.d
+./dumpigen -r 7 -g 3 -s 40 -o dumpistate.d/gen > /dev/null
+good=`expr $good + $?`
+cd dumpistate.d
+../checkdumpistate gen.meta gen-*.bin
+good=`expr $good + $?`
+cd $here
+rm -rf dumpistate.d
+exit $good
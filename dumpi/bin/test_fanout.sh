@@ -0,0 +1,56 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+
+# Lay the test traces out as libdumpi does with "fanout 4" and check that
+# the tools read them as they read the flat layout.  Ranks 0-3 hash to
+# the subdirectories 000, 003, 002 and 003 (see dumpi_trace_bucket); the
+# layout of existing traces must not change.
+here=`pwd`
+traces=$srcdir/../../tests/traces
+rm -rf fanout.d
+mkdir fanout.d fanout.d/flat fanout.d/fan
+cp $traces/testtrace.meta $traces/testtrace-*.bin fanout.d/flat
+cp $traces/testtrace.meta fanout.d/fan
+echo "fanout=4" >> fanout.d/fan/testtrace.meta
+rank=0
+for bucket in 000 003 002 003; do
+  mkdir -p fanout.d/fan/testtrace.d/$bucket
+  cp $traces/testtrace-000$rank.bin fanout.d/fan/testtrace.d/$bucket
+  rank=`expr $rank + 1`
+done
+
+good=0
+for layout in flat fan; do
+  cd fanout.d/$layout
+  $here/dumpi2ascii -I testtrace.meta -o ascii > /dev/null &&
+    $here/dumpistats --bin=all --count=mpi --sent=sends \
+                     -i testtrace.meta -o stats > /dev/null &&
+    $here/dumpi2dumpi -F -I testtrace.meta -o d2d > /dev/null
+  current=$?
+  good=`expr $good + $current`
+  for file in d2d-*.bin; do
+    $here/dumpi2ascii -F $file > callcounts${file#d2d}.txt
+  done
+  cd $here
+done
+
+cd fanout.d/flat
+for file in ascii-*.txt stats-*.tbl callcounts-*.txt; do
+  cmp -s $file ../fan/$file
+  current=$?
+  good=`expr $good + $current`
+done
+
+cd $here
+rm -rf fanout.d
+exit $good
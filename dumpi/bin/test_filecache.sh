@@ -0,0 +1,35 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+
+# Statistics and message matching must not depend on how many trace
+# files may be open at once.
+here=`pwd`
+cd $srcdir/../../tests/traces
+for limit in 0 1; do
+  DUMPI_MAX_OPEN_FILES=$limit                                 \
+    $here/dumpistats --bin='init to finalize by 0.001'        \
+                     --count=mpi --time=mpi --sent=sends --match \
+                     -i testtrace.meta -o $here/fcache$limit > /dev/null ||
+    exit 1
+done
+cd $here
+
+good=0
+for file in fcache0-*; do
+  cmp -s $file fcache1${file#fcache0}
+  current=$?
+  good=`expr $good + $current`
+done
+
+rm -f fcache0-* fcache1-*
+exit $good
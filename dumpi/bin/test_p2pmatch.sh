@@ -0,0 +1,36 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+
+# Pair the sends and receives of the test traces and check the totals
+# against the call counts of the traces themselves.
+here=`pwd`
+cd $srcdir/../../tests/traces
+$here/dumpistats --match -i testtrace.meta -o $here/p2p > /dev/null || exit 1
+sends=0
+for file in testtrace-*.bin; do
+  count=`$here/dumpi2ascii -F $file |
+         awk '/^MPI_I?[bsr]?send called/ {n += $3} END {print n+0}'`
+  sends=`expr $sends + $count`
+done
+cd $here
+
+# Every send is received, and the bytes add up to the matched messages
+bytes=`awk '!/^#/ {n += $5} END {print n+0}' p2p-match.dat`
+awk -v sends=$sends -v bytes=$bytes '
+  $1 == "matched" && ($2 != sends || sends == 0) { bad = 1 }
+  $1 == "bytes" && $2 != bytes                     { bad = 1 }
+  /^(unmatched_|incomplete_|unresolved_)/ && $2 != 0 { bad = 1 }
+  END { exit bad }' p2p-match.sum
+retval="$?"
+rm -f p2p-match.dat p2p-match.sum
+exit $retval
@@ -0,0 +1,52 @@
+#!/bin/sh
+
+#
+#   This file is part of DUMPI: 
+#                The MPI profiling library from the SST suite.
+#   Copyright (c) 2009-2023 NTESS.
+#   This software is distributed under the BSD License.
+#   Under the terms of Contract DE-NA0003525 with NTESS,
+#   the U.S. Government retains certain rights in this software.
+#   For more information, see the LICENSE file in the top 
+#   SST/macroscale directory.
+#
+
+# Time bins answered from the per-trace rollup files must match the ones
+# built by streaming the traces.  The rollups are written next to the
+# traces, so work on a copy of them.
+here=`pwd`
+rm -rf rollup.d
+mkdir rollup.d
+cp $srcdir/../../tests/traces/testtrace.meta   \
+   $srcdir/../../tests/traces/testtrace-*.bin rollup.d
+cd rollup.d
+
+stats() {
+  $here/dumpistats --bin='init to finalize by 0.002' --count=mpi      \
+                   --time=mpi --sent=sends --recvd=recvs "$@"        \
+                   -i testtrace.meta > /dev/null
+}
+# Streamed, then streamed while writing the rollups, then rollups only
+stats -o stream && stats --rollup -o build && test -f testtrace-0000.rollup
+good="$?"
+# Zero most of the calls but keep the size and mtime of each trace, so the
+# rollups still count as current.  The replay must not read the calls.
+for file in testtrace-*.bin; do
+  cp -p $file stamp
+  dd if=/dev/zero of=$file bs=100 seek=2 count=20 conv=notrunc 2> /dev/null
+  touch -r stamp $file
+done
+rm -f stamp
+stats -v -o replay 2> replay.log &&
+  grep 'Building tables from trace rollups' replay.log > /dev/null
+current=$?
+good=`expr $good + $current`
+for file in stream-*; do
+  cmp -s $file build${file#stream} && cmp -s $file replay${file#stream}
+  current=$?
+  good=`expr $good + $current`
+done
+
+cd $here
+rm -rf rollup.d
+exit $good
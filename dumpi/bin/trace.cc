@@ -86,7 +86,8 @@ namespace dumpi {
   // Creation.
   //
   trace::trace() :
-    index_(-1), filename_(""), profile_(NULL), off_(0), state_(PREPARSE_FRESH),
+    index_(-1), filename_(""), file_(-1), loaded_(false),
+    state_(PREPARSE_FRESH),
     shared_(NULL), mpi_finalized_(0)
   {
     pending_communicator_.id = -1;
@@ -143,28 +144,10 @@ namespace dumpi {
     assert(shared != NULL);
     assert(index >= 0);
     filename_ = filename;
-    //std::cerr << "undumpi_open(" << filename_ << ")\n";
-    profile_ = undumpi_open(filename_.c_str());
-    if(! profile_) {
-      std::cerr << "trace::init:  Failed to open " << filename_ << ": "
-		<< strerror(errno) << "\n";
-    }
+    file_ = filecache::global().add(filename_);
     index_ = index;
     shared_ = shared;
     setup_callbacks();
-    dumpi_start_stream_read(profile_);
-    this->off_ = ftello(profile_->file);
-    // Initialize built-in types.  This is, unfortunately, a bit of a mess.
-    dumpi_sizeof size = undumpi_read_datatype_sizes(profile_);
-    // We may need to set defaults if this trace file is very old.
-    if(size.count < DUMPI_FIRST_USER_DATATYPE-1)
-      assign_default_sizes();
-    else
-      for(int i = 0; i < size.count; ++i)
-	types_.insert(std::make_pair(i, typeentry(type(size.size[i]))));
-    free(size.size);
-    // Done with the file.
-    fclose(profile_->file);
     // Initialize containers.
     comm world = shared_->retrieve_world(index_);
     if(world.get_group().get_global_rank() != index_) {
@@ -178,6 +161,24 @@ namespace dumpi {
     state_ = PREPARSE_READY;
   }
 
+  //
+  // Read the built-in type sizes and move to the start of the stream.
+  //
+  void trace::load(dumpi_profile *profile) {
+    // Initialize built-in types.  This is, unfortunately, a bit of a mess.
+    dumpi_sizeof size = undumpi_read_datatype_sizes(profile);
+    // We may need to set defaults if this trace file is very old.
+    if(size.count < DUMPI_FIRST_USER_DATATYPE-1)
+      assign_default_sizes();
+    else
+      for(int i = 0; i < size.count; ++i)
+	types_.insert(std::make_pair(i, typeentry(type(size.size[i]))));
+    free(size.size);
+    if(! dumpi_start_stream_read(profile))
+      throw "trace::load:  Failed to find the start of the stream.";
+    loaded_ = true;
+  }
+
   //
   // Preparse until we hit a blocking call or finish the trace stream.
   //
@@ -222,21 +223,30 @@ namespace dumpi {
       return state_;
     }
     // We get here because we have PREPARSE_READY.
-    assert((profile_->file = fopen(filename_.c_str(), "r")) != NULL);
-    assert(profile_->file != NULL);
-    assert(fseeko(profile_->file, this->off_, SEEK_SET) == 0);
-    // Resume parsing until we hit end of stream or another comm. operation.
-    do {
-      int active_stream =
-	undumpi_read_single_call(profile_, callarr_, this,
-				 &this->mpi_finalized_);
-      if(! active_stream) {
-	state_ = PREPARSE_DONE;
-	break;
+    {
+      cachedfile file(filecache::global(), file_);
+      if(file.get() == NULL) {
+        std::cerr << "trace::preparse:  Failed to open " << filename_ << "\n";
+        throw "trace::preparse:  Failed to open trace file.";
       }
-    } while(this->state_ != PREPARSE_BLOCKED);
-    this->off_ = ftello(profile_->file);
-    fclose(profile_->file);
+      if(! loaded_)
+        load(file.get());
+      // Resume parsing until we hit end of stream or another comm. operation.
+      do {
+        int active_stream =
+          undumpi_read_single_call(file.get(), callarr_, this,
+                                   &this->mpi_finalized_);
+        if(! active_stream) {
+          state_ = PREPARSE_DONE;
+          break;
+        }
+      } while(this->state_ != PREPARSE_BLOCKED);
+    }
+    if(state_ == PREPARSE_DONE) {
+      // Nothing more to read from this file.
+      filecache::global().remove(file_);
+      file_ = -1;
+    }
     // We get here because we are either done or blocked.
     if(state_ != PREPARSE_DONE) {
       // Signal to the caller that we advanced until we hit a block.
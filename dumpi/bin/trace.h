@@ -51,6 +51,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/bin/comm.h>
 #include <dumpi/bin/type.h>
 #include <dumpi/bin/timeutils.h>
+#include <dumpi/bin/filecache.h>
 #include <dumpi/libundumpi/libundumpi.h>
 #include <dumpi/libundumpi/bindings.h>
 #include <string>
@@ -81,10 +82,12 @@ namespace dumpi {
     int index_;
     /// The full (qualified) filename for this trace.
     std::string filename_;
-    /// The profile we're working from.
-    dumpi_profile *profile_;
-    /// The current offset in the profile.
-    off_t off_;
+    /// Our trace file.  Only opened (through filecache::global()) while
+    /// we are preparsing, so that the number of ranks is not limited by
+    /// the number of open files.
+    filecache::id file_;
+    /// Whether we have read the datatype sizes yet.
+    bool loaded_;
     /// Our state of preparsing.
     state state_;
     /// The state we share with all other trace instances.
@@ -167,6 +170,9 @@ namespace dumpi {
     /// Private function to set up callbacks.
     void setup_callbacks();
 
+    /// Private function to read the built-in type sizes on first use.
+    void load(dumpi_profile *profile);
+
     /// Private function to handle state checks before comm creation routines.
     /// Returns the "old" communicator handle.
     inline const comm& comm_creation_precheck(int index);
@@ -342,7 +348,7 @@ namespace dumpi {
     /// Global rank for this trace.
     int rank() const { return index_; }
 
-    /// Initialize the trace.
+    /// Initialize the trace.  The file is not opened until preparse().
     void init(sharedstate *shared, const std::string &filename, int index);
 
     /// Preparse until we hit a blocking call or finish the trace stream.
@@ -89,8 +89,9 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/common/iodefs.h>
 #include <dumpi/common/funcs.h>
 
-/* Added to accommodate the handling of NULL terminated arrays etc. */
-static int ignore_bounds_0, ignore_bounds_1, ignore_bounds_2;
+/* Unused array bounds (for NULL terminated arrays etc.) are declared as
+ * ignore_bounds_N locals where needed, so that profiles can be read
+ * concurrently from several threads. */
 
 int dumpi_write_func_enter(const dumpi_func_call *val, DUMPI_WRITEARGS) {
   STARTWRITE(profile, DUMPI_Function_enter);
@@ -976,6 +977,9 @@ int dumpi_read_type_struct(dumpi_type_struct *val, DUMPI_READARGS) {
   if(dumpi_have_version(profile->version, 0, 6, 9)) {
     GET_INT_ARRAY_1(profile, val->count, val->indices);
   }
+  else if(profile->skipping) {
+    GET_INT(profile);
+  }
   else {
     val->indices = (int*)calloc(val->count, sizeof(int));
     val->indices[0] = GET_INT(profile); /* Unfortunate error prior to 0.6.9 */
@@ -1738,7 +1742,7 @@ int dumpi_read_group_range_incl(dumpi_group_range_incl *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Group_range_incl);
   val->group = GET_DUMPI_GROUP(profile);
   val->count = GET_INT(profile);
-  GET_INT_ARRAY_2(profile, val->count, ignore_bounds_1, val->ranges);
+  { int ignore_bounds_1; GET_INT_ARRAY_2(profile, val->count, ignore_bounds_1, val->ranges); }
   val->newgroup = GET_DUMPI_GROUP(profile);
   ENDREAD(profile);
   return 1;
@@ -1758,7 +1762,7 @@ int dumpi_read_group_range_excl(dumpi_group_range_excl *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Group_range_excl);
   val->group = GET_DUMPI_GROUP(profile);
   val->count = GET_INT(profile);
-  GET_INT_ARRAY_2(profile, val->count, ignore_bounds_1, val->ranges);
+  { int ignore_bounds_1; GET_INT_ARRAY_2(profile, val->count, ignore_bounds_1, val->ranges); }
   val->newgroup = GET_DUMPI_GROUP(profile);
   ENDREAD(profile);
   return 1;
@@ -2233,6 +2237,9 @@ int dumpi_read_cart_get(dumpi_cart_get *val, DUMPI_READARGS) {
   if(dumpi_have_version(profile->version, 0, 6, 8)) {
     GET_INT_ARRAY_1(profile, val->ndim, val->coords);
   }
+  else if(profile->skipping) {
+    GET_INT(profile);
+  }
   else {
     val->coords = (int*)calloc(val->ndim, sizeof(int));
     val->coords[0] = GET_INT(profile);
@@ -2588,7 +2595,7 @@ int dumpi_read_init(dumpi_init *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Init);
   /*
   val->argc = GET_INT(profile);
-  GET_CHAR_ARRAY_2(profile, val->argc, ignore_bounds_1, val->argv);
+  { int ignore_bounds_1; GET_CHAR_ARRAY_2(profile, val->argc, ignore_bounds_1, val->argv); }
   */
   val->argc = get32(profile);
   /* There was a mistake in early versions of DUMPI where the
@@ -2597,7 +2604,12 @@ int dumpi_read_init(dumpi_init *val, DUMPI_READARGS) {
     get32(profile);
   
   /* OK, now we can proceed normally */
-  if(val->argc > 0) {
+  if(val->argc > 0 && profile->skipping) {
+    int i, scratch;
+    for(i = 0; i < val->argc; ++i)
+      getchararr(profile, &scratch, NULL);
+  }
+  else if(val->argc > 0) {
     int i, scratch;
     val->argv = (char**)calloc(val->argc+1, sizeof(char*));
     assert(val->argv != NULL);
@@ -2663,7 +2675,7 @@ int dumpi_write_close_port(const dumpi_close_port *val, DUMPI_WRITEARGS) {
 
 int dumpi_read_close_port(dumpi_close_port *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Close_port);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname); }
   ENDREAD(profile);
   return 1;
 }
@@ -2681,7 +2693,7 @@ int dumpi_write_comm_accept(const dumpi_comm_accept *val, DUMPI_WRITEARGS) {
 
 int dumpi_read_comm_accept(dumpi_comm_accept *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Comm_accept);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname); }
   val->info = GET_DUMPI_INFO(profile);
   val->root = GET_INT(profile);
   val->oldcomm = GET_DUMPI_COMM(profile);
@@ -2703,7 +2715,7 @@ int dumpi_write_comm_connect(const dumpi_comm_connect *val, DUMPI_WRITEARGS) {
 
 int dumpi_read_comm_connect(dumpi_comm_connect *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Comm_connect);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname); }
   val->info = GET_DUMPI_INFO(profile);
   val->root = GET_INT(profile);
   val->oldcomm = GET_DUMPI_COMM(profile);
@@ -2777,8 +2789,8 @@ int dumpi_read_comm_spawn(dumpi_comm_spawn *val, DUMPI_READARGS) {
   val->root = GET_INT(profile);
   val->oldcomm = GET_DUMPI_COMM(profile);
   val->newcomm = GET_DUMPI_COMM(profile);
-  if(val->oldcommrank == val->root)   GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->command);
-  if(val->oldcommrank == val->root)   GET_CHAR_ARRAY_2(profile, ignore_bounds_0, ignore_bounds_1, val->argv);
+  if(val->oldcommrank == val->root)   { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->command); }
+  if(val->oldcommrank == val->root)   { int ignore_bounds_0, ignore_bounds_1; GET_CHAR_ARRAY_2(profile, ignore_bounds_0, ignore_bounds_1, val->argv); }
   if(val->oldcommrank == val->root)   val->maxprocs = GET_INT(profile);
   if(val->oldcommrank == val->root)   val->info = GET_DUMPI_INFO(profile);
   if(val->oldcommrank == val->root)   GET_DUMPI_ERRCODE_ARRAY_1(profile, val->maxprocs, val->errcodes);
@@ -2811,8 +2823,8 @@ int dumpi_read_comm_spawn_multiple(dumpi_comm_spawn_multiple *val, DUMPI_READARG
   val->oldcomm = GET_DUMPI_COMM(profile);
   val->newcomm = GET_DUMPI_COMM(profile);
   if(val->oldcommrank == val->root)   val->count = GET_INT(profile);
-  if(val->oldcommrank == val->root)   GET_CHAR_ARRAY_2(profile, val->count, ignore_bounds_1, val->commands);
-  if(val->oldcommrank == val->root)   GET_CHAR_ARRAY_3(profile, val->count, ignore_bounds_1, ignore_bounds_2, val->argvs);
+  if(val->oldcommrank == val->root)   { int ignore_bounds_1; GET_CHAR_ARRAY_2(profile, val->count, ignore_bounds_1, val->commands); }
+  if(val->oldcommrank == val->root)   { int ignore_bounds_1, ignore_bounds_2; GET_CHAR_ARRAY_3(profile, val->count, ignore_bounds_1, ignore_bounds_2, val->argvs); }
   if(val->oldcommrank == val->root)   GET_INT_ARRAY_1(profile, val->count, val->maxprocs);
   if(val->oldcommrank == val->root)   GET_DUMPI_INFO_ARRAY_1(profile, val->count, val->info);
   if(val->oldcommrank == val->root)   GET_DUMPI_ERRCODE_ARRAY_1(profile, val->totprocs, val->errcodes);
@@ -2831,9 +2843,9 @@ int dumpi_write_lookup_name(const dumpi_lookup_name *val, DUMPI_WRITEARGS) {
 
 int dumpi_read_lookup_name(dumpi_lookup_name *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Lookup_name);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->servicename);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->servicename); }
   val->info = GET_DUMPI_INFO(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname); }
   ENDREAD(profile);
   return 1;
 }
@@ -2849,7 +2861,7 @@ int dumpi_write_open_port(const dumpi_open_port *val, DUMPI_WRITEARGS) {
 int dumpi_read_open_port(dumpi_open_port *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Open_port);
   val->info = GET_DUMPI_INFO(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname); }
   ENDREAD(profile);
   return 1;
 }
@@ -2865,9 +2877,9 @@ int dumpi_write_publish_name(const dumpi_publish_name *val, DUMPI_WRITEARGS) {
 
 int dumpi_read_publish_name(dumpi_publish_name *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Publish_name);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->servicename);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->servicename); }
   val->info = GET_DUMPI_INFO(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname); }
   ENDREAD(profile);
   return 1;
 }
@@ -2883,9 +2895,9 @@ int dumpi_write_unpublish_name(const dumpi_unpublish_name *val, DUMPI_WRITEARGS)
 
 int dumpi_read_unpublish_name(dumpi_unpublish_name *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Unpublish_name);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->servicename);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->servicename); }
   val->info = GET_DUMPI_INFO(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->portname); }
   ENDREAD(profile);
   return 1;
 }
@@ -3243,7 +3255,7 @@ int dumpi_write_add_error_string(const dumpi_add_error_string *val, DUMPI_WRITEA
 int dumpi_read_add_error_string(dumpi_add_error_string *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Add_error_string);
   val->errorcode = GET_INT(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->errorstring);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->errorstring); }
   ENDREAD(profile);
   return 1;
 }
@@ -3371,7 +3383,7 @@ int dumpi_write_comm_set_name(const dumpi_comm_set_name *val, DUMPI_WRITEARGS) {
 int dumpi_read_comm_set_name(dumpi_comm_set_name *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Comm_set_name);
   val->comm = GET_DUMPI_COMM(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name); }
   ENDREAD(profile);
   return 1;
 }
@@ -3441,10 +3453,15 @@ int dumpi_read_init_thread(dumpi_init_thread *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Init_thread);
   /*
   val->argc = GET_INT(profile);
-  GET_CHAR_ARRAY_2(profile, val->argc, ignore_bounds_1, val->argv);
+  { int ignore_bounds_1; GET_CHAR_ARRAY_2(profile, val->argc, ignore_bounds_1, val->argv); }
   */
   val->argc = get32(profile);
-  if(val->argc > 0) {
+  if(val->argc > 0 && profile->skipping) {
+    int i, scratch;
+    for(i = 0; i < val->argc; ++i)
+      getchararr(profile, &scratch, NULL);
+  }
+  else if(val->argc > 0) {
     int i, scratch;
     val->argv = (char**)calloc(val->argc+1, sizeof(char*));
     assert(val->argv != NULL);
@@ -3667,7 +3684,7 @@ int dumpi_write_type_get_name(const dumpi_type_get_name *val, DUMPI_WRITEARGS) {
 int dumpi_read_type_get_name(dumpi_type_get_name *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Type_get_name);
   val->datatype = GET_DUMPI_DATATYPE(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name); }
   val->resultlen = GET_INT(profile);
   ENDREAD(profile);
   return 1;
@@ -3700,7 +3717,7 @@ int dumpi_write_type_set_name(const dumpi_type_set_name *val, DUMPI_WRITEARGS) {
 int dumpi_read_type_set_name(dumpi_type_set_name *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Type_set_name);
   val->datatype = GET_DUMPI_DATATYPE(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name); }
   ENDREAD(profile);
   return 1;
 }
@@ -3813,7 +3830,7 @@ int dumpi_write_win_get_name(const dumpi_win_get_name *val, DUMPI_WRITEARGS) {
 int dumpi_read_win_get_name(dumpi_win_get_name *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Win_get_name);
   val->win = GET_DUMPI_WIN(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name); }
   val->resultlen = GET_INT(profile);
   ENDREAD(profile);
   return 1;
@@ -3846,7 +3863,7 @@ int dumpi_write_win_set_name(const dumpi_win_set_name *val, DUMPI_WRITEARGS) {
 int dumpi_read_win_set_name(dumpi_win_set_name *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Win_set_name);
   val->win = GET_DUMPI_WIN(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name); }
   ENDREAD(profile);
   return 1;
 }
@@ -4024,7 +4041,7 @@ int dumpi_write_info_delete(const dumpi_info_delete *val, DUMPI_WRITEARGS) {
 int dumpi_read_info_delete(dumpi_info_delete *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Info_delete);
   val->info = GET_DUMPI_INFO(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->key);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->key); }
   ENDREAD(profile);
   return 1;
 }
@@ -4073,9 +4090,9 @@ int dumpi_write_info_get(const dumpi_info_get *val, DUMPI_WRITEARGS) {
 int dumpi_read_info_get(dumpi_info_get *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Info_get);
   val->info = GET_DUMPI_INFO(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->key);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->key); }
   val->valuelength = GET_INT(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->value);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->value); }
   val->flag = GET_INT(profile);
   ENDREAD(profile);
   return 1;
@@ -4110,7 +4127,7 @@ int dumpi_read_info_get_nthkey(dumpi_info_get_nthkey *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Info_get_nthkey);
   val->info = GET_DUMPI_INFO(profile);
   val->n = GET_INT(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->key);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->key); }
   ENDREAD(profile);
   return 1;
 }
@@ -4128,7 +4145,7 @@ int dumpi_write_info_get_valuelen(const dumpi_info_get_valuelen *val, DUMPI_WRIT
 int dumpi_read_info_get_valuelen(dumpi_info_get_valuelen *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Info_get_valuelen);
   val->info = GET_DUMPI_INFO(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->key);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->key); }
   val->valuelen = GET_INT(profile);
   val->flag = GET_INT(profile);
   ENDREAD(profile);
@@ -4147,8 +4164,8 @@ int dumpi_write_info_set(const dumpi_info_set *val, DUMPI_WRITEARGS) {
 int dumpi_read_info_set(dumpi_info_set *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Info_set);
   val->info = GET_DUMPI_INFO(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->key);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->value);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->key); }
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->value); }
   ENDREAD(profile);
   return 1;
 }
@@ -4167,7 +4184,7 @@ int dumpi_write_pack_external(const dumpi_pack_external *val, DUMPI_WRITEARGS) {
 
 int dumpi_read_pack_external(dumpi_pack_external *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Pack_external);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->datarep);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->datarep); }
   val->incount = GET_INT(profile);
   val->intype = GET_DUMPI_DATATYPE(profile);
   val->outcount = GET_INT(profile);
@@ -4189,7 +4206,7 @@ int dumpi_write_pack_external_size(const dumpi_pack_external_size *val, DUMPI_WR
 
 int dumpi_read_pack_external_size(dumpi_pack_external_size *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Pack_external_size);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->datarep);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->datarep); }
   val->incount = GET_INT(profile);
   val->datatype = GET_DUMPI_DATATYPE(profile);
   val->size = GET_INT(profile);
@@ -4431,7 +4448,7 @@ int dumpi_write_unpack_external(const dumpi_unpack_external *val, DUMPI_WRITEARG
 
 int dumpi_read_unpack_external(dumpi_unpack_external *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Unpack_external);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->datarep);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->datarep); }
   val->insize = GET_INT(profile);
   val->position.in = GET_INT(profile);
   val->position.out = GET_INT(profile);
@@ -4501,7 +4518,7 @@ int dumpi_write_file_open(const dumpi_file_open *val, DUMPI_WRITEARGS) {
 int dumpi_read_file_open(dumpi_file_open *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_File_open);
   val->comm = GET_DUMPI_COMM(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->filename);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->filename); }
   val->amode = GET_DUMPI_FILEMODE(profile);
   val->info = GET_DUMPI_INFO(profile);
   val->file = GET_DUMPI_FILE(profile);
@@ -4533,7 +4550,7 @@ int dumpi_write_file_delete(const dumpi_file_delete *val, DUMPI_WRITEARGS) {
 
 int dumpi_read_file_delete(dumpi_file_delete *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_File_delete);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->filename);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->filename); }
   val->info = GET_DUMPI_INFO(profile);
   ENDREAD(profile);
   return 1;
@@ -4669,7 +4686,7 @@ int dumpi_read_file_set_view(dumpi_file_set_view *val, DUMPI_READARGS) {
   val->offset = GET_INT64_T(profile);
   val->hosttype = GET_DUMPI_DATATYPE(profile);
   val->filetype = GET_DUMPI_DATATYPE(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->datarep);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->datarep); }
   val->info = GET_DUMPI_INFO(profile);
   ENDREAD(profile);
   return 1;
@@ -4692,7 +4709,7 @@ int dumpi_read_file_get_view(dumpi_file_get_view *val, DUMPI_READARGS) {
   val->offset = GET_INT64_T(profile);
   val->hosttype = GET_DUMPI_DATATYPE(profile);
   val->filetype = GET_DUMPI_DATATYPE(profile);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->datarep);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->datarep); }
   ENDREAD(profile);
   return 1;
 }
@@ -5390,7 +5407,7 @@ int dumpi_write_register_datarep(const dumpi_register_datarep *val, DUMPI_WRITEA
 
 int dumpi_read_register_datarep(dumpi_register_datarep *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Register_datarep);
-  GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name);
+  { int ignore_bounds_0; GET_CHAR_ARRAY_1(profile, ignore_bounds_0, val->name); }
   ENDREAD(profile);
   return 1;
 }
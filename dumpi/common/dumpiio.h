@@ -60,7 +60,7 @@ extern "C" {
   /*@{*/
 
 #define DUMPI_WRITEARGS uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf,  const dumpi_outputs *output, dumpi_profile *profile
-#define DUMPI_READARGS  uint16_t *thread, dumpi_time *cpu, dumpi_time *wall, dumpi_perfinfo *perf, dumpi_profile *profile
+#define DUMPI_READARGS  uint16_t *thread, dumpi_time *cpu, dumpi_time *wall, dumpi_perfdata *perf, dumpi_profile *profile
 
   /** Write a func_enter record (including function id) at current position */
   int DUMPI_SKIP_INSTRUMENTING
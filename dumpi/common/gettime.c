@@ -185,3 +185,22 @@ void dumpi_get_time(dumpi_clock *cpu, dumpi_clock *wall)
   get_lowres_timers(cpu, wall);
 #endif /* DUMPI_ON_REDSTORM / DUMPI_ON_BGP / POSIX_TIMERS conditional */
 }
+
+/*
+ * Get wall time only.  Used for profile-only mode, where the cpu timer
+ * would roughly double the cost of timing a call.
+ */
+uint64_t dumpi_get_wall_ns(void)
+{
+#if (! defined(DUMPI_ON_REDSTORM)) && (! defined(DUMPI_ON_BGP)) && \
+    (! defined(DUMPI_DISABLE_POSIX_TIMERS)) && (_POSIX_TIMERS > 0) && \
+    defined(_POSIX_MONOTONIC_CLOCK)
+  struct timespec tspec;
+  clock_gettime(CLOCK_MONOTONIC, &tspec);
+  return (uint64_t)tspec.tv_sec * 1000000000 + tspec.tv_nsec;
+#else
+  dumpi_clock cpu, wall;
+  dumpi_get_time(&cpu, &wall);
+  return (uint64_t)wall.sec * 1000000000 + wall.nsec;
+#endif
+}
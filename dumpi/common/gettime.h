@@ -63,6 +63,12 @@ extern "C" {
    */ 
   void dumpi_get_time(dumpi_clock *cpu, dumpi_clock *wall);
 
+  /**
+   * Retrieve only the wall time, in nanoseconds.
+   * Cheaper than dumpi_get_time since no cpu time is read.
+   */
+  uint64_t dumpi_get_wall_ns(void);
+
   /*@}*/ 
 
 # ifdef __cplusplus
@@ -52,6 +52,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <errno.h>
 #include <assert.h>
 #include <unistd.h>
+#include <sys/stat.h>
 
 void dumpi_init_profile(dumpi_profile *profile) {
   assert(profile != NULL);
@@ -66,6 +67,15 @@ void dumpi_init_profile(dumpi_profile *profile) {
 /* This gets output just before the footer for error checking */
 #define DUMPI_FOOT_MAGIC ((uint64_t)(0xf007fee7))
 
+/* This gets output at the start of the call statistics record */
+#define DUMPI_STATS_MAGIC ((uint64_t)(0x57a75c0d))
+
+/* This gets output at the start of the communication matrix record */
+#define DUMPI_COMM_MAGIC ((uint64_t)(0xc0aa7a1c))
+
+/* This follows the label of each checkpoint record in the call stream */
+#define DUMPI_CHECKPOINT_MAGIC ((((uint64_t)(0xc4ec4b01))<<32) | 0x6e7d0a7a)
+
 
 /*
  * Common routines to read and write dumpi datatypes to a file.
@@ -297,6 +307,28 @@ void dumpi_read_perfctr_labels(dumpi_profile *profile, int *counters,
   }
 }
 
+void dumpi_load_perfctr_labels(dumpi_profile *profile) {
+  int counters = 0;
+  assert(profile);
+  if(profile->perflabels != NULL)
+    return;
+  assert((profile->perflabels = (dumpi_perflabel_t*)
+	  calloc(DUMPI_MAX_STREAM_PERFCTRS, sizeof(dumpi_perflabel_t)))
+	 != NULL);
+  dumpi_read_perfctr_labels(profile, &counters, profile->perflabels,
+			    DUMPI_MAX_STREAM_PERFCTRS);
+}
+
+void dumpi_free_perfctr_cache(dumpi_profile *profile) {
+  assert(profile);
+  free(profile->perflabels);
+  free(profile->perfvalues);
+  free(profile->perfcompat);
+  profile->perflabels = NULL;
+  profile->perfvalues = NULL;
+  profile->perfcompat = NULL;
+}
+
 int dumpi_write_function_addresses(dumpi_profile *profile, int count,
 				   const uint64_t *addresses,
 				   char **names)
@@ -400,12 +432,372 @@ int dumpi_read_datatype_sizes(dumpi_profile *profile, dumpi_sizeof *sizes) {
   return 1;  
 }
 
+int dumpi_write_callstats(dumpi_profile *profile,
+                          const dumpi_callstats *stats)
+{
+  int fn, i;
+  uint32_t used = 0;
+  if(dumpi_debug & DUMPI_DEBUG_TRACEIO)
+    fprintf(stderr, "[DUMPI-IO] dumpi_write_callstats at offset 0x%llx\n",
+	    ((long long)DUMPI_WRITE_TELL(profile)));
+  assert(stats && profile);
+  profile->statslbl = DUMPI_WRITE_TELL(profile);
+  put64(profile, DUMPI_STATS_MAGIC);
+  put32(profile, stats->threads);
+  put8(profile, DUMPI_CALLSTATS_BUCKETS);
+  /* Only functions that were actually called are written. */
+  for(fn = 0; fn < DUMPI_ALL_FUNCTIONS; ++fn)
+    if(stats->entry[fn].count > 0)
+      ++used;
+  put32(profile, used);
+  for(fn = 0; fn < DUMPI_ALL_FUNCTIONS; ++fn) {
+    const dumpi_callstats_entry *entry = &stats->entry[fn];
+    if(entry->count == 0)
+      continue;
+    put16(profile, fn);
+    put64(profile, entry->count);
+    put64(profile, entry->total_ns);
+    put64(profile, entry->min_ns);
+    put64(profile, entry->max_ns);
+    put64(profile, entry->bytes);
+    for(i = 0; i < DUMPI_CALLSTATS_BUCKETS; ++i)
+      put64(profile, entry->time_hist[i]);
+    for(i = 0; i < DUMPI_CALLSTATS_BUCKETS; ++i)
+      put64(profile, entry->size_hist[i]);
+  }
+  return 1;
+}
+
+int dumpi_read_callstats(dumpi_profile *profile, dumpi_callstats *stats) {
+  int i, buckets;
+  uint32_t it, used;
+  long callpos;
+  assert(stats != NULL);
+  memset(stats, 0, sizeof(dumpi_callstats));
+  if(profile->statslbl > 0) {
+    assert(profile && profile->file);
+    callpos = DUMPI_READ_TELL(profile);
+    assert(DUMPI_SEEK(profile, profile->statslbl, SEEK_SET) == 0);
+    if(dumpi_debug & DUMPI_DEBUG_TRACEIO)
+      fprintf(stderr, "[DUMPI-IO] dumpi_read_callstats at offset 0x%llx\n",
+	      ((long long)DUMPI_READ_TELL(profile)));
+    if(get64(profile) != DUMPI_STATS_MAGIC) {
+      fprintf(stderr, "dumpi_read_callstats:  Bad magic\n");
+      abort();
+    }
+    stats->threads = get32(profile);
+    buckets = get8(profile);
+    used = get32(profile);
+    for(it = 0; it < used; ++it) {
+      uint64_t value;
+      dumpi_callstats_entry scratch, *entry;
+      uint16_t fn = get16(profile);
+      /* Skip functions this version does not know about. */
+      entry = (fn < DUMPI_ALL_FUNCTIONS ? &stats->entry[fn] : &scratch);
+      entry->count    = get64(profile);
+      entry->total_ns = get64(profile);
+      entry->min_ns   = get64(profile);
+      entry->max_ns   = get64(profile);
+      entry->bytes    = get64(profile);
+      for(i = 0; i < buckets; ++i) {
+        value = get64(profile);
+        entry->time_hist[(i < DUMPI_CALLSTATS_BUCKETS ? i :
+                          DUMPI_CALLSTATS_BUCKETS-1)] += value;
+      }
+      for(i = 0; i < buckets; ++i) {
+        value = get64(profile);
+        entry->size_hist[(i < DUMPI_CALLSTATS_BUCKETS ? i :
+                          DUMPI_CALLSTATS_BUCKETS-1)] += value;
+      }
+    }
+    assert(DUMPI_SEEK(profile, callpos, SEEK_SET) == 0);
+  }
+  return 1;
+}
+
+int dumpi_write_commstats(dumpi_profile *profile,
+                          const dumpi_commstats *stats)
+{
+  int i;
+  if(dumpi_debug & DUMPI_DEBUG_TRACEIO)
+    fprintf(stderr, "[DUMPI-IO] dumpi_write_commstats at offset 0x%llx\n",
+	    ((long long)DUMPI_WRITE_TELL(profile)));
+  assert(stats && profile);
+  profile->commlbl = DUMPI_WRITE_TELL(profile);
+  put64(profile, DUMPI_COMM_MAGIC);
+  put32(profile, stats->rank);
+  put32(profile, stats->peers);
+  for(i = 0; i < stats->peers; ++i) {
+    put32(profile, stats->peer[i].peer);
+    put64(profile, stats->peer[i].messages);
+    put64(profile, stats->peer[i].bytes);
+  }
+  put32(profile, stats->colls);
+  for(i = 0; i < stats->colls; ++i) {
+    put32(profile, stats->coll[i].size);
+    put32(profile, stats->coll[i].leader);
+    put64(profile, stats->coll[i].calls);
+    put64(profile, stats->coll[i].bytes);
+  }
+  return 1;
+}
+
+int dumpi_read_commstats(dumpi_profile *profile, dumpi_commstats *stats) {
+  int i;
+  long callpos;
+  assert(stats != NULL);
+  memset(stats, 0, sizeof(dumpi_commstats));
+  stats->rank = -1;
+  if(profile->commlbl > 0) {
+    assert(profile && profile->file);
+    callpos = DUMPI_READ_TELL(profile);
+    assert(DUMPI_SEEK(profile, profile->commlbl, SEEK_SET) == 0);
+    if(dumpi_debug & DUMPI_DEBUG_TRACEIO)
+      fprintf(stderr, "[DUMPI-IO] dumpi_read_commstats at offset 0x%llx\n",
+	      ((long long)DUMPI_READ_TELL(profile)));
+    if(get64(profile) != DUMPI_COMM_MAGIC) {
+      fprintf(stderr, "dumpi_read_commstats:  Bad magic\n");
+      abort();
+    }
+    stats->rank = get32(profile);
+    stats->peers = get32(profile);
+    assert(stats->peers >= 0);
+    stats->peer = (dumpi_commpeer*)calloc(stats->peers+1, sizeof(dumpi_commpeer));
+    assert(stats->peer != NULL);
+    for(i = 0; i < stats->peers; ++i) {
+      stats->peer[i].peer     = get32(profile);
+      stats->peer[i].messages = get64(profile);
+      stats->peer[i].bytes    = get64(profile);
+    }
+    stats->colls = get32(profile);
+    assert(stats->colls >= 0);
+    stats->coll = (dumpi_commcoll*)calloc(stats->colls+1, sizeof(dumpi_commcoll));
+    assert(stats->coll != NULL);
+    for(i = 0; i < stats->colls; ++i) {
+      stats->coll[i].size   = get32(profile);
+      stats->coll[i].leader = get32(profile);
+      stats->coll[i].calls  = get64(profile);
+      stats->coll[i].bytes  = get64(profile);
+    }
+    assert(DUMPI_SEEK(profile, callpos, SEEK_SET) == 0);
+  }
+  return 1;
+}
+
+/* Words in the longest index record (see dumpi_write_index) */
+#define DUMPI_INDEX_WORDS 10
+
+/* Bytes read from the end of a trace when it is opened.  The header,
+ * footer and index records are all written at MPI_Finalize, so this is
+ * normally enough to get the index and the version in a single read. */
+#define DUMPI_TAIL_WINDOW 65536
+
+/* A 64-bit value in the byte order used by put64. */
+static uint64_t decode64(const unsigned char *buf) {
+  uint64_t value = 0;
+  int i;
+  for(i = 0; i < 8; ++i)
+    value = (value << 8) | buf[i];
+  return value;
+}
+
+/* Read len bytes at offset pos without moving the stream position. */
+static int read_at(dumpi_profile *profile, void *buf, size_t len,
+                   DUMPI_FPOS pos)
+{
+  size_t done = 0;
+  while(done < len) {
+    ssize_t got = pread(fileno(profile->file), (char*)buf + done, len - done,
+                        pos + done);
+    if(got <= 0)
+      return 0;
+    done += got;
+  }
+  return 1;
+}
+
+/*
+ * Read the index at the end of the file.  Offsets have been pre-pended
+ * to the index over time, so everything after the (first) magic word
+ * is an offset:
+ * -- perflbl was pre-pended to the index records on Oct 21. 2009.
+ * -- addrlbl was pre-pended to the index records on Dec. 8. 2009.
+ *    Both of those were added before consistent versioning was implemented.
+ * -- sizelbl was pre-pended in version 0.6.6 (May 2010).
+ * -- statslbl is only pre-pended by profile-only traces.
+ * -- commlbl is only pre-pended if libdumpi kept a communication matrix.
+ * The words are passed in as they appear at the end of the file.
+ * Returns 0 (and leaves the profile alone) if there is no plausible index.
+ */
+static int parse_index(dumpi_profile *profile, const unsigned char *tail) {
+  int i, first;
+  uint64_t word[DUMPI_INDEX_WORDS];
+  DUMPI_FPOS *optional[5];
+  if(profile->total_file_size < (DUMPI_INDEX_WORDS+1)*sizeof(uint64_t))
+    return 0;
+  for(i = 0; i < DUMPI_INDEX_WORDS; ++i)
+    word[i] = decode64(tail + i*sizeof(uint64_t));
+  /* The four "original" index records come last. */
+  for(first = 0; first < DUMPI_INDEX_WORDS-4; ++first)
+    if(word[first] == DUMPI_HEAD_MAGIC)
+      break;
+  if(first == DUMPI_INDEX_WORDS-4)
+    return 0;
+  for(i = first+1; i < DUMPI_INDEX_WORDS; ++i)
+    if(word[i] >= profile->total_file_size)
+      return 0;
+  if(word[DUMPI_INDEX_WORDS-3] == 0)
+    return 0;
+  optional[0] = &profile->commlbl;
+  optional[1] = &profile->statslbl;
+  optional[2] = &profile->sizelbl;
+  optional[3] = &profile->addrlbl;
+  optional[4] = &profile->perflbl;
+  for(i = first; i < DUMPI_INDEX_WORDS-5; ++i)
+    *optional[i] = word[i+1];
+  profile->header  = word[DUMPI_INDEX_WORDS-4];
+  profile->body    = word[DUMPI_INDEX_WORDS-3];
+  profile->footer  = word[DUMPI_INDEX_WORDS-2];
+  profile->keyval  = word[DUMPI_INDEX_WORDS-1];
+  profile->chkpt   = 0;
+  return 1;
+}
+
+static int read_index(dumpi_profile *profile) {
+  unsigned char tail[DUMPI_INDEX_WORDS*sizeof(uint64_t)];
+  if(profile->total_file_size < sizeof(tail) ||
+     ! read_at(profile, tail, sizeof(tail),
+               profile->total_file_size - sizeof(tail)))
+    return 0;
+  return parse_index(profile, tail);
+}
+
+static uint64_t checkpoint_sum(const dumpi_checkpoint *chk) {
+  return (DUMPI_CHECKPOINT_MAGIC ^ (uint64_t)chk->position ^
+	  (uint64_t)chk->body ^ chk->records ^
+	  (((uint64_t)(uint32_t)chk->wall.sec << 32) |
+	   (uint32_t)chk->wall.nsec) ^
+	  (((uint64_t)(uint8_t)chk->version[0] << 16) |
+	   ((uint64_t)(uint8_t)chk->version[1] << 8) |
+	   (uint64_t)(uint8_t)chk->version[2]));
+}
+
+/* Read and validate a checkpoint record at the given offset. */
+static int get_checkpoint(dumpi_profile *profile, DUMPI_FPOS pos,
+			  dumpi_checkpoint *chk)
+{
+  int i;
+  if(pos < (DUMPI_FPOS)sizeof(uint64_t) ||
+     pos + DUMPI_CHECKPOINT_SIZE > (DUMPI_FPOS)profile->total_file_size ||
+     DUMPI_SEEK(profile, pos, SEEK_SET) != 0)
+    return 0;
+  if(get16(profile) != DUMPI_CHECKPOINT_LABEL ||
+     get64(profile) != DUMPI_CHECKPOINT_MAGIC)
+    return 0;
+  chk->position = get64(profile);
+  chk->body     = get64(profile);
+  chk->records  = get64(profile);
+  for(i = 0; i < 3; ++i)
+    chk->version[i] = get8(profile);
+  chk->wall.sec  = get32(profile);
+  chk->wall.nsec = get32(profile);
+  return (chk->position == pos && chk->body > 0 && chk->body <= pos &&
+	  get64(profile) == checkpoint_sum(chk));
+}
+
+/*
+ * Find the last valid checkpoint at or after the given offset by
+ * scanning backwards from the end of the file.
+ */
+static int find_checkpoint(dumpi_profile *profile, DUMPI_FPOS lower,
+			   dumpi_checkpoint *chk)
+{
+  enum { block = 1<<16 };
+  unsigned char buf[block + sizeof(uint64_t)], magic[sizeof(uint64_t)];
+  DUMPI_FPOS start, end = profile->total_file_size;
+  size_t i, len;
+  for(i = 0; i < sizeof(uint64_t); ++i)
+    magic[i] = (unsigned char)(DUMPI_CHECKPOINT_MAGIC >> (56 - 8*i));
+  while(end > lower) {
+    start = (end - block > lower ? end - block : lower);
+    /* Blocks overlap so that a magic word spanning two is still found */
+    len = (size_t)(end - start);
+    if(end + (DUMPI_FPOS)sizeof(uint64_t) - 1 <=
+       (DUMPI_FPOS)profile->total_file_size)
+      len += sizeof(uint64_t) - 1;
+    else
+      len += profile->total_file_size - end;
+    if(DUMPI_SEEK(profile, start, SEEK_SET) != 0 ||
+       fread(buf, 1, len, profile->file) != len)
+      return 0;
+    for(i = len; i-- >= sizeof(uint64_t); ) {
+      DUMPI_FPOS pos = start + (DUMPI_FPOS)(i - (sizeof(uint64_t)-1)) -
+	(DUMPI_FPOS)sizeof(uint16_t);
+      if(memcmp(buf + i - (sizeof(uint64_t)-1), magic, sizeof(uint64_t)) == 0 &&
+	 pos >= lower && get_checkpoint(profile, pos, chk))
+	return 1;
+    }
+    end = start;
+  }
+  return 0;
+}
+
+int dumpi_write_checkpoint(dumpi_profile *profile, uint64_t records,
+                           const dumpi_clock *wall)
+{
+  int i;
+  dumpi_checkpoint chk;
+  assert(profile && wall);
+  chk.position = DUMPI_WRITE_TELL(profile);
+  chk.body = profile->body;
+  chk.records = records;
+  chk.wall = *wall;
+  for(i = 0; i < 3; ++i)
+    chk.version[i] = profile->version[i];
+  if(dumpi_debug & DUMPI_DEBUG_TRACEIO)
+    fprintf(stderr, "[DUMPI-IO] dumpi_write_checkpoint at offset 0x%llx\n",
+	    ((long long)chk.position));
+  put16(profile, DUMPI_CHECKPOINT_LABEL);
+  put64(profile, DUMPI_CHECKPOINT_MAGIC);
+  put64(profile, chk.position);
+  put64(profile, chk.body);
+  put64(profile, chk.records);
+  for(i = 0; i < 3; ++i)
+    put8(profile, chk.version[i]);
+  put32(profile, chk.wall.sec);
+  put32(profile, chk.wall.nsec);
+  put64(profile, checkpoint_sum(&chk));
+  if(profile->file)
+    DUMPI_FLUSH(profile);
+  profile->chkpt = chk.position;
+  return 1;
+}
+
+int dumpi_read_checkpoint(dumpi_profile *profile, dumpi_checkpoint *chk) {
+  int retval = 0;
+  assert(profile && profile->file && chk);
+  memset(chk, 0, sizeof(dumpi_checkpoint));
+  if(profile->chkpt > 0) {
+    DUMPI_FPOS callpos = DUMPI_READ_TELL(profile);
+    retval = get_checkpoint(profile, profile->chkpt, chk);
+    assert(DUMPI_SEEK(profile, callpos, SEEK_SET) == 0);
+  }
+  return retval;
+}
+
 int dumpi_write_index(dumpi_profile *profile) {
   if(dumpi_debug & DUMPI_DEBUG_TRACEIO)
     fprintf(stderr, "[DUMPI-IO] dumpi_write_index at offset 0x%llx\n",
 	    ((long long)DUMPI_WRITE_TELL(profile)));
   if(profile && profile->file) {
     put64(profile, DUMPI_HEAD_MAGIC);
+    /* Traces without call statistics or a communication matrix keep the
+     * older index layout, so that they stay readable by older versions.
+     * Newer offsets are pre-pended (each implies the ones after it). */
+    if(profile->commlbl > 0)
+      put64(profile, profile->commlbl);
+    if(profile->commlbl > 0 || profile->statslbl > 0)
+      put64(profile, profile->statslbl);
     put64(profile, profile->sizelbl); /* added in v. 0.6.6 */
     put64(profile, profile->addrlbl);
     put64(profile, profile->perflbl);
@@ -424,15 +816,14 @@ int dumpi_write_index(dumpi_profile *profile) {
 }
 
 dumpi_profile *dumpi_open_input_file(const char *fname) {
-  /* The file must start with magic. */
+  /* The whole tail of the file is read in one go, which normally takes
+   * care of both the index and the header (for the version number). */
   dumpi_profile *retval;
-  uint64_t magic;
+  struct stat st;
+  unsigned char head[sizeof(uint64_t)], *tail = NULL;
+  size_t taillen = 0;
+  DUMPI_FPOS tailpos = 0;
   DUMPIFILE fp = DUMPI_FOPEN(fname, "r");
-  retval = (dumpi_profile*)calloc(1, sizeof(dumpi_profile));
-  assert(retval != NULL);
-  retval->addrlbl = retval->perflbl = 0;
-  retval->file = fp;
-  retval->pos = 0;
   if(dumpi_debug & DUMPI_DEBUG_TRACEIO)
     fprintf(stderr, "[DUMPI-IO] dumpi_open_input_file\n");
   if(fp == NULL) {
@@ -440,84 +831,44 @@ dumpi_profile *dumpi_open_input_file(const char *fname) {
 	    "  errno=%d (%s)\n", fname, errno, strerror(errno));
     return NULL;
   }
-  fseek(fp, 0L, SEEK_END);
-  retval->total_file_size = ftell(fp);
+  retval = (dumpi_profile*)calloc(1, sizeof(dumpi_profile));
+  assert(retval != NULL);
+  retval->addrlbl = retval->perflbl = 0;
+  retval->file = fp;
+  retval->pos = 0;
+  if(fstat(fileno(fp), &st) == 0)
+    retval->total_file_size = st.st_size;
   retval->terminate_pos = retval->total_file_size;
-  rewind(fp);
-  magic = get64(retval);
-  if(magic != DUMPI_HEAD_MAGIC) {
-    fprintf(stderr, "dumpi_open_input_file:  File \"%s\" does not start with "
-	    "the correct magic incantation.  Not a valid DUMPI file.\n", fname);
-    DUMPI_FCLOSE(fp);
-    errno = EIO;
-    return NULL;
-  }
-  if(DUMPI_SEEK(retval, -8*((long)sizeof(int64_t)), SEEK_END) != 0) {
-    fprintf(stderr, "dumpi_open_input_file:  Cannot seek to index record in "
-	    "\"%s\".  File might be truncated.\n", fname);
-    return NULL;
-  }
-  magic = get64(retval);
-  /* We might be dealing with an older tracefile -- 
-   * sizelbl was pre-pended in version 0.6.6 (May 2010).
-   */
-  if(magic != DUMPI_HEAD_MAGIC) {
-    /* We don't have a datatype size record. */
-    magic = get64(retval);
-  }
-  else {
-    retval->sizelbl = get64(retval);
-  }
-  /*
-   * -- perflbl was pre-pended to the index records on Oct 21. 2009.
-   * -- addrlbl was pre-pended to the index records on Dec. 8. 2009.
-   * Both of those were added before consistent versioning was implemented.
-   */
-  if(magic != DUMPI_HEAD_MAGIC) {
-    /* We don't have an address label record */
-    magic = get64(retval);
-  }
-  else {
-    retval->addrlbl = get64(retval);
+  if(retval->total_file_size >= (DUMPI_INDEX_WORDS+1)*sizeof(uint64_t)) {
+    taillen = (retval->total_file_size < DUMPI_TAIL_WINDOW ?
+	       (size_t)retval->total_file_size : DUMPI_TAIL_WINDOW);
+    tailpos = retval->total_file_size - taillen;
+    tail = (unsigned char*)malloc(taillen);
+    assert(tail != NULL);
+    if(! read_at(retval, tail, taillen, tailpos))
+      taillen = 0;
   }
-  if(magic != DUMPI_HEAD_MAGIC) {
-    /* We don't have a perfctr record either */
-    magic = get64(retval);
-  }
-  else {
-    retval->perflbl = get64(retval);
-  }
-  /* At this point, we better have found a valid magic record entry */
-  if(magic != DUMPI_HEAD_MAGIC) {
-    /* Actually, we don't seem to have a valid index record at all */
-    fprintf(stderr, "dumpi_open_input_file:  Index record in \"%s\" does not "
-	    "start with correct magic incantation.  File may be truncated.\n",
-	    fname);
-    DUMPI_FCLOSE(fp);
-    errno = EIO;
-    free(retval);
-    return NULL;
-  }
-  /* These are the four "original" index records. */
-  retval->header  = get64(retval);
-  retval->body    = get64(retval);
-  retval->footer  = get64(retval);
-  retval->keyval  = get64(retval);
-  /* Finally, read in the version number */
+  if(taillen > 0 &&
+     parse_index(retval, tail + taillen - DUMPI_INDEX_WORDS*sizeof(uint64_t)))
   {
-    int i;
+    /* The index starts with the same magic as the file. */
     int version_cmp[3];
-    dumpi_header header;
-    assert(dumpi_read_header(retval, &header) != 0);
-    for(i = 0; i < 3; ++i)
-      retval->version[i] = header.version[i];
+    char *version = retval->version;
+    if(retval->header > 0) {
+      if(retval->header >= tailpos &&
+	 retval->header + 3 <= (DUMPI_FPOS)retval->total_file_size)
+	memcpy(version, tail + (retval->header - tailpos), 3);
+      else
+	read_at(retval, version, 3, retval->header);
+    }
+    free(tail);
     /* Sanity check -- added in v.0.6.4 */
-    version_cmp[0] = (dumpi_version > header.version[0] ? 1 :
-		      (dumpi_version < header.version[0]  ? -1 : 0));
-    version_cmp[1] = (dumpi_subversion > header.version[1] ? 1 :
-		      (dumpi_subversion < header.version[1]  ? -1 : 0));
-    version_cmp[2] = (dumpi_subsubversion > header.version[2] ? 1 :
-		      (dumpi_subsubversion < header.version[2]  ? -1 : 0));
+    version_cmp[0] = (dumpi_version > version[0] ? 1 :
+		      (dumpi_version < version[0]  ? -1 : 0));
+    version_cmp[1] = (dumpi_subversion > version[1] ? 1 :
+		      (dumpi_subversion < version[1]  ? -1 : 0));
+    version_cmp[2] = (dumpi_subsubversion > version[2] ? 1 :
+		      (dumpi_subsubversion < version[2]  ? -1 : 0));
     if(version_cmp[0] < 0 ||
        (version_cmp[0] == 0 && version_cmp[1] < 0) ||
        (version_cmp[0] == 0 && version_cmp[1] == 0 && version_cmp[2] < 0))
@@ -525,9 +876,68 @@ dumpi_profile *dumpi_open_input_file(const char *fname) {
 	      "trace file is from dumpi version %d.%d.%d.  Things may not "
 	      "work correctly (forward-compatibility is not guaranteed)\n",
 	      (int)dumpi_version, (int)dumpi_subversion, 
-	      (int)dumpi_subsubversion, (int)header.version[0],
-	      (int)header.version[1], (int)header.version[2]);
+	      (int)dumpi_subsubversion, (int)version[0],
+	      (int)version[1], (int)version[2]);
+    return retval;
+  }
+  free(tail);
+  /* No index.  The file must still start with magic. */
+  if(! read_at(retval, head, sizeof(head), 0) ||
+     decode64(head) != DUMPI_HEAD_MAGIC)
+  {
+    fprintf(stderr, "dumpi_open_input_file:  File \"%s\" does not start with "
+	    "the correct magic incantation.  Not a valid DUMPI file.\n", fname);
+    DUMPI_FCLOSE(fp);
+    free(retval);
+    errno = EIO;
+    return NULL;
+  }
+  {
+    dumpi_checkpoint chk;
+    if(! find_checkpoint(retval, sizeof(uint64_t), &chk)) {
+      /* Actually, we don't seem to have a valid index record at all */
+      fprintf(stderr, "dumpi_open_input_file:  Index record in \"%s\" does not "
+	      "start with correct magic incantation.  File may be truncated.\n",
+	      fname);
+      DUMPI_FCLOSE(fp);
+      errno = EIO;
+      free(retval);
+      return NULL;
+    }
+    fprintf(stderr, "dumpi_open_input_file:  \"%s\" has no index record "
+	    "(the job was killed or is still running).  Reading the %llu "
+	    "records up to its last checkpoint.\n", fname,
+	    (unsigned long long)chk.records);
+    retval->body = chk.body;
+    retval->chkpt = chk.position;
+    memcpy(retval->version, chk.version, 3);
+    return retval;
   }
+}
+
+int dumpi_refresh_input_file(dumpi_profile *profile) {
+  DUMPI_FPOS callpos;
+  dumpi_checkpoint chk;
+  uint64_t size;
+  int retval = 0;
+  assert(profile && profile->file);
+  if(profile->chkpt == 0)
+    return 0;
+  callpos = DUMPI_READ_TELL(profile);
+  assert(DUMPI_SEEK(profile, 0, SEEK_END) == 0);
+  size = DUMPI_READ_TELL(profile);
+  if(size != profile->total_file_size) {
+    profile->total_file_size = profile->terminate_pos = size;
+    if(read_index(profile)) {
+      retval = 1;
+    }
+    else if(find_checkpoint(profile, profile->chkpt + DUMPI_CHECKPOINT_SIZE,
+			    &chk)) {
+      profile->chkpt = chk.position;
+      retval = 1;
+    }
+  }
+  assert(DUMPI_SEEK(profile, callpos, SEEK_SET) == 0);
   return retval;
 }
 
@@ -550,6 +960,7 @@ int dumpi_start_stream_read(dumpi_profile *profile) {
 	    ((long long)DUMPI_READ_TELL(profile)));
   profile->cpu_time_offset  = get32(profile);
   profile->wall_time_offset = get32(profile);
+  profile->pos = DUMPI_READ_TELL(profile);
   /*
     printf("Read time offsets %d (CPU) and %d (wall)\n",
 	 profile->cpu_time_offset, profile->wall_time_offset);
@@ -557,6 +968,52 @@ int dumpi_start_stream_read(dumpi_profile *profile) {
   return 1;
 }
 
+/**
+ * Subdirectory index of a rank when traces fan out over several.
+ */
+int dumpi_trace_bucket(int rank, int fanout) {
+  uint32_t h = (uint32_t)rank;
+  if(fanout <= 1)
+    return 0;
+  /* murmur3 finalizer */
+  h ^= h >> 16;
+  h *= 0x85ebca6bU;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35U;
+  h ^= h >> 16;
+  return (int)(h % (uint32_t)fanout);
+}
+
+/**
+ * Name of a trace subdirectory (or of the directory above them).
+ */
+int dumpi_trace_dirname(char *buf, size_t size, const char *prefix,
+                        int bucket)
+{
+  if(bucket < 0)
+    return snprintf(buf, size, "%s.d", prefix);
+  return snprintf(buf, size, "%s.d/%03x", prefix, bucket);
+}
+
+/**
+ * Name of the trace file of a rank, with or without fanout.
+ */
+int dumpi_trace_filename(char *buf, size_t size, const char *prefix,
+                         int width, int fanout, int rank)
+{
+  const char *base;
+  int len;
+  if(fanout <= 0)
+    return snprintf(buf, size, "%s-%0*d.bin", prefix, width, rank);
+  base = strrchr(prefix, '/');
+  base = (base != NULL ? base+1 : prefix);
+  len = dumpi_trace_dirname(buf, size, prefix,
+                            dumpi_trace_bucket(rank, fanout));
+  if(len < 0 || (size_t)len >= size)
+    return len;
+  return len + snprintf(buf+len, size-len, "/%s-%0*d.bin", base, width, rank);
+}
+
 /**
  * Create output profile with null file pointer
  */
@@ -177,6 +177,20 @@ extern "C" {
                                  dumpi_perflabel_t *labels,
                                  int maxlabels);
 
+  /**
+   * Read the perfcounter labels into the label table kept by the profile
+   * (profile->perflabels).  This is done once per profile, the first time
+   * a record with perfcounter data is read.  Labels for counters that are
+   * not named in the trace are left empty.
+   * \param profile   A valid input profile (open for reading). 
+   */
+  void dumpi_load_perfctr_labels(dumpi_profile *profile);
+
+  /**
+   * Release the reader-side perfcounter storage held by a profile.
+   */
+  void dumpi_free_perfctr_cache(dumpi_profile *profile);
+
   /** 
    * Write labels for profiled functions.
    * Added in version 0.4 
@@ -238,6 +252,53 @@ extern "C" {
    */
   int dumpi_read_datatype_sizes(dumpi_profile *profile, dumpi_sizeof *sizes);
 
+  /**
+   * Write the call statistics gathered in profile-only mode.
+   * The record gets written at current file position.
+   * \param stats    The merged call statistics.
+   * \param profile  The profile to which we write.  The profile->statslbl
+   *                 member will be updated to reflect the file position of
+   *                 the record.
+   * \return non-zero on success.
+   */
+  int dumpi_write_callstats(dumpi_profile *profile,
+                            const dumpi_callstats *stats);
+
+  /**
+   * Read the call statistics record.
+   * Sets the file position back to its original (input) position
+   * before returning.  If the profile has no call statistics
+   * (profile->statslbl is 0), stats is cleared and stats->threads is 0.
+   * \param stats    A non-null record to be filled in.
+   * \param profile  A valid input profile.
+   * \return non-zero on success.
+   */
+  int dumpi_read_callstats(dumpi_profile *profile, dumpi_callstats *stats);
+
+  /**
+   * Write the communication matrix record gathered by libdumpi.
+   * The record gets written at current file position.
+   * \param stats    The traffic of this rank.
+   * \param profile  The profile to which we write.  The profile->commlbl
+   *                 member will be updated to reflect the file position of
+   *                 the record.
+   * \return non-zero on success.
+   */
+  int dumpi_write_commstats(dumpi_profile *profile,
+                            const dumpi_commstats *stats);
+
+  /**
+   * Read the communication matrix record.
+   * Sets the file position back to its original (input) position
+   * before returning.  If the profile has no such record (profile->commlbl
+   * is 0), stats->peers and stats->colls are 0 and stats->rank is -1.
+   * It is the caller's responsibility to call dumpi_clear_commstats.
+   * \param stats    A non-null record to be filled in.
+   * \param profile  A valid input profile.
+   * \return non-zero on success.
+   */
+  int dumpi_read_commstats(dumpi_profile *profile, dumpi_commstats *stats);
+
   /**
    * Write the index to a file.
    * This must be the the last write call made to a profile (closes the stream) 
@@ -245,12 +306,46 @@ extern "C" {
    */
   int dumpi_write_index(dumpi_profile *profile);
 
+  /**
+   * Write a checkpoint record at the current position in the call stream
+   * and flush the output buffer, so that everything up to the checkpoint
+   * is on disk.  Must only be called between records.
+   * \param profile  The profile to which we write.  The profile->chkpt
+   *                 member will be updated to the position of the record.
+   * \param records  The number of records written so far.
+   * \param wall     The current wall time.
+   * \return non-zero on success.
+   */
+  int dumpi_write_checkpoint(dumpi_profile *profile, uint64_t records,
+                             const dumpi_clock *wall);
+
+  /**
+   * Read the checkpoint a trace without an index was recovered from.
+   * Sets the file position back to its original (input) position
+   * before returning.
+   * \return 0 if the trace is complete (profile->chkpt is 0).
+   */
+  int dumpi_read_checkpoint(dumpi_profile *profile, dumpi_checkpoint *chk);
+
   /* Open a profile file and read its header magic, footer magic,
    * and index table.
+   * If the file has no valid index (the job was killed, or is still
+   * running), the call stream is recovered up to the last checkpoint
+   * record and profile->chkpt is set.
    * \param fname  The name of the file to be opened.
    * \return NULL if the file is not recognized as a valid dumpi file. */
   dumpi_profile* dumpi_open_input_file(const char *fname);
 
+  /**
+   * Look for more of a trace that is still being written.
+   * Does nothing for complete traces.  If the file now has an index,
+   * it is read and the trace becomes complete; otherwise the stream
+   * is extended to the newest checkpoint.
+   * The file position is left unchanged.
+   * \return non-zero if more of the call stream became readable.
+   */
+  int dumpi_refresh_input_file(dumpi_profile *profile);
+
   /**
    * Create a new blank profile with a null file pointer.
    * This method is most appropriate for creating an output profile prior
@@ -281,6 +376,40 @@ extern "C" {
    */
   int dumpi_start_stream_read(dumpi_profile *profile);
 
+  /** The number of digits libdumpi uses for the rank in trace names. */
+#define DUMPI_TRACE_WIDTH 4
+
+  /** The largest number of trace subdirectories (see dumpi_trace_bucket). */
+#define DUMPI_MAX_FANOUT 4096
+
+  /**
+   * The subdirectory that holds the trace of a rank when the traces of
+   * a run are spread over fanout directories.  Ranks are hashed, so any
+   * contiguous block of ranks is spread evenly.
+   */
+  int dumpi_trace_bucket(int rank, int fanout);
+
+  /**
+   * Write the name of a subdirectory of a run into buf: PREFIX.d for
+   * bucket < 0, and PREFIX.d/BBB (bucket in hex) otherwise.
+   * \return the length of the name (as for snprintf).
+   */
+  int dumpi_trace_dirname(char *buf, size_t size, const char *prefix,
+                          int bucket);
+
+  /**
+   * Write the name of the trace file of a rank into buf.
+   * With fanout 0, this is PREFIX-NNNN.bin (the rank printed with width
+   * digits).  Otherwise the file is in the subdirectory of the rank:
+   * PREFIX.d/BBB/BASE-NNNN.bin, where BASE is PREFIX without its
+   * leading directories.
+   * \param prefix  the fileprefix of the metafile, including the path
+   *                of the metafile.
+   * \return the length of the name (as for snprintf).
+   */
+  int dumpi_trace_filename(char *buf, size_t size, const char *prefix,
+                           int width, int fanout, int rank);
+
   /*@}*/ /* Close the documentation module */
 
 #ifdef __cplusplus
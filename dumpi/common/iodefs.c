@@ -171,3 +171,16 @@ off_t dumpi_membuf_tell(dumpi_profile *profile) {
     return dumpi_membuf_pos(profile);
   }
 }
+
+void dumpi_membuf_usage(const dumpi_profile *profile, size_t *used,
+			size_t *length)
+{
+  assert(profile && used && length);
+  if(profile->membuf) {
+    *used = profile->membuf->pos;
+    *length = profile->membuf->length;
+  }
+  else {
+    *used = *length = 0;
+  }
+}
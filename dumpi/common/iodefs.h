@@ -53,6 +53,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/common/funcs.h>
 #include <dumpi/dumpiconfig.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
@@ -105,6 +106,13 @@ extern "C" {
    */
   off_t dumpi_membuf_tell(dumpi_profile *profile);
 
+  /**
+   * Report how many bytes are waiting in the memory buffer and how
+   * large it is (both 0 if nothing was written yet).
+   */
+  void dumpi_membuf_usage(const dumpi_profile *profile, size_t *used,
+			  size_t *length);
+
   /**
    * Utility definition (dating back to when we used compressed files).
    * May be deprecated at a later time.
@@ -151,6 +159,22 @@ extern "C" {
 #define DUMPI_SEEK(PROFILE, OFFSET, WHENCE)	\
   fseeko(PROFILE->file, OFFSET, WHENCE)
 
+  /** Step over size bytes of a record that is being skipped.
+   * Short runs are read into scratch space, which keeps us inside the
+   * stdio buffer; longer ones are seeked over. */
+  static inline void skip_bytes(dumpi_profile *fp, int64_t size) {
+    char scratch[256];
+    if(size <= 0)
+      return;
+    if(size <= (int64_t)sizeof(scratch)) {
+      DUMPI_FREAD(fp, scratch, (size_t)size, 1);
+    }
+    else {
+      int status = DUMPI_SEEK(fp, (off_t)size, SEEK_CUR);
+      assert(status == 0);
+      (void)status;
+    }
+  }
 
   /** Utility routine to get a 8 bit integer from a binary stream. */
   static inline uint8_t get8(dumpi_profile *fp) {
@@ -225,6 +249,10 @@ extern "C" {
   {
     int i;
     *count = get32(fp);
+    if(fp->skipping) {
+      skip_bytes(fp, (int64_t)*count * sizeof(int32_t));
+      return;
+    }
     if(*count > 0)
       *arr = (int32_t*)malloc(*count * sizeof(int32_t));
     else
@@ -248,6 +276,11 @@ extern "C" {
   /** Utility routine to read an array of characters. */
   static inline void getchararr(dumpi_profile *fp, int32_t *count, char **arr) {
     off_t startpos, endpos;
+    if(fp->skipping) {
+      *count = get32(fp);
+      skip_bytes(fp, *count);
+      return;
+    }
     assert(arr != NULL);
     startpos = DUMPI_READ_TELL(fp);
     *count = get32(fp);
@@ -365,16 +398,36 @@ extern "C" {
   {
     int i;
     *count = get32(fp);
+    if(fp->skipping) {
+      skip_bytes(fp, (int64_t)*count * sizeof(int32_t));
+      return;
+    }
     *req = (dumpi_request*)malloc(*count * sizeof(dumpi_request));
     assert(req);
     for(i = 0; i < *count; ++i)
       (*req)[i] = get_single_request(fp);
   }
 
-  /** Read the token for next function. */
+  /** Function label marking a checkpoint record in the call stream */
+#define DUMPI_CHECKPOINT_LABEL ((uint16_t)0xfffe)
+
+  /** The size of a checkpoint record (including its label) */
+#define DUMPI_CHECKPOINT_SIZE 53
+
+  /** The file offset where the readable part of the call stream ends. */
+  static inline uint64_t dumpi_stream_end(const dumpi_profile *profile) {
+    return (profile->chkpt > 0 ? profile->chkpt : profile->footer);
+  }
+
+  /** Read the token for next function (skipping checkpoint records). */
   static inline dumpi_function dumpi_read_next_function(dumpi_profile *profile) 
   {
     uint16_t next = get16(profile);
+    while(next == DUMPI_CHECKPOINT_LABEL) {
+      assert(DUMPI_SEEK(profile, DUMPI_CHECKPOINT_SIZE-sizeof(uint16_t),
+                        SEEK_CUR) == 0);
+      next = get16(profile);
+    }
     /*fprintf(stderr, "Encountered function label %d at offset 0x%llx\n",
               (int)next, (long long)DUMPI_READ_TELL(profile));*/
     assert(next <= DUMPI_END_OF_STREAM);  
@@ -479,6 +532,10 @@ extern "C" {
   static inline char* get_string(dumpi_profile *fp) {
     char *str;
     uint16_t len = get16(fp);
+    if(fp->skipping) {
+      skip_bytes(fp, len);
+      return NULL;
+    }
     str = (char*)malloc(len+1); str[len] = '\0';
     DUMPI_FREAD(fp, str, sizeof(char), len);
     return str;
@@ -506,6 +563,11 @@ extern "C" {
   static inline void get_string_arr(dumpi_profile *fp, int *count, char ***arr){
     int i;
     *count = get32(fp);
+    if(fp->skipping) {
+      for(i = 0; i < *count; ++i)
+        get_string(fp);
+      return;
+    }
     *arr = (char**)malloc(*count * sizeof(char*));
     for(i = 0; i < *count; ++i) {
       (*arr)[i] = get_string(fp);
@@ -529,22 +591,38 @@ extern "C" {
     }
   }
 
-  /** Read PAPI performance counter state from the stream */
+  /** Read PAPI performance counter state from the stream.
+   * Labels come from the per-profile table, which is loaded once. */
   static inline void get_perfinfo(dumpi_profile *profile,
-				  dumpi_perfinfo *perf, uint8_t config_mask)
+				  dumpi_perfdata *perf, uint8_t config_mask)
   {
     perf->count = 0;
     if(DO_PERFINFO(config_mask)) {
-      int i;
-      perf->count = get8(profile);
-      /* Read the std::string labels for the performance counters */
-      dumpi_read_perfctr_labels(profile, &perf->count, perf->counter_tag,
-                                DUMPI_MAX_PERFCTR_NAME);
-      /* Done reading std::string labels -- get the actual values */
-      for(i = 0; i < perf->count; ++i) {
-        perf->invalue[i] = get64(profile);
-        perf->outvalue[i] = get64(profile);
+      int i, count;
+      int64_t *in, *out;
+      count = get8(profile);
+      if(profile->perflabels == NULL)
+        dumpi_load_perfctr_labels(profile);
+      perf->counter_tag =
+        (const char (*)[DUMPI_MAX_PERFCTR_NAME])profile->perflabels;
+      if(count <= DUMPI_PERFDATA_INLINE) {
+        in = perf->inline_in;
+        out = perf->inline_out;
+      }
+      else {
+        if(profile->perfvalues == NULL)
+          assert((profile->perfvalues = (int64_t*)
+                  malloc(2*DUMPI_MAX_STREAM_PERFCTRS*sizeof(int64_t))) != NULL);
+        in = profile->perfvalues;
+        out = profile->perfvalues + DUMPI_MAX_STREAM_PERFCTRS;
       }
+      for(i = 0; i < count; ++i) {
+        in[i] = get64(profile);
+        out[i] = get64(profile);
+      }
+      perf->invalue = in;
+      perf->outvalue = out;
+      perf->count = count;
     }
   }
 
@@ -583,6 +661,13 @@ extern "C" {
     if(config_mask & DUMPI_ENABLE) {
       int i;
       int count = get32(profile);
+      if(profile->skipping) {
+        int64_t width = 10;
+        if(dumpi_have_version(profile->version, 0, 6, 3))
+          width += 4;
+        skip_bytes(profile, count * width);
+        return NULL;
+      }
       if(count > 0) {
         statuses = (dumpi_status*)malloc(count * sizeof(dumpi_status));
         for(i = 0; i < count; ++i) {
@@ -640,6 +725,17 @@ extern "C" {
     get_times(profile, &val->cpu, &val->wall, config_mask);
   */
 
+  /** Read the fixed part of a record (following the function label). */
+  static inline void get_record_prefix(dumpi_profile *profile,
+				       dumpi_record_prefix *prefix)
+  {
+    prefix->config_mask = get_config_mask(profile);
+    prefix->thread = 0;
+    if(prefix->config_mask & DUMPI_THREADID_MASK)
+      prefix->thread = get16(profile);
+    get_times(profile, &prefix->cpu, &prefix->wall, prefix->config_mask);
+  }
+
   /** Shared back-end stuff when starting to read a profiled call */
 #define STARTREAD(PROFILE, LABEL)					\
   uint8_t config_mask;                                                  \
@@ -651,10 +747,21 @@ extern "C" {
             (long long)DUMPI_READ_TELL(PROFILE)-sizeof(uint16_t));	\
   }                                                                     \
   assert(val && PROFILE && PROFILE->file);				\
-  config_mask = get_config_mask(PROFILE);                               \
-  if(config_mask & DUMPI_THREADID_MASK)                                 \
-    *thread = get16(profile);						\
-  get_times(PROFILE, cpu, wall, config_mask);				\
+  if(PROFILE->prefix != NULL) {                                         \
+    /* the record filter has already read the prefix */                 \
+    config_mask = PROFILE->prefix->config_mask;                         \
+    if(config_mask & DUMPI_THREADID_MASK)                               \
+      *thread = PROFILE->prefix->thread;                                \
+    *cpu = PROFILE->prefix->cpu;                                        \
+    *wall = PROFILE->prefix->wall;                                      \
+    PROFILE->prefix = NULL;                                             \
+  }                                                                     \
+  else {                                                                \
+    config_mask = get_config_mask(PROFILE);                             \
+    if(config_mask & DUMPI_THREADID_MASK)                               \
+      *thread = get16(profile);						\
+    get_times(PROFILE, cpu, wall, config_mask);				\
+  }                                                                     \
   get_perfinfo(PROFILE, perf, config_mask);
 
   /** Shared back-end stuff when finishing a read */
@@ -722,6 +829,11 @@ extern "C" {
 #define GET_INT_ARRAY_2(PROFILE, LEN0, LEN1, VALUE) do {	\
     int i0;                                             \
     LEN0 = get32(PROFILE);				\
+    if((PROFILE)->skipping) {                           \
+      for(i0 = 0; i0 < (LEN0); ++i0)                    \
+        get32arr(PROFILE, &(LEN1), NULL);               \
+      break;                                            \
+    }                                                   \
     VALUE = (int**)calloc(LEN0+1, sizeof(int*));	\
     assert((VALUE) != NULL);				\
     for(i0 = 0; i0 < (LEN0); ++i0) {                    \
@@ -781,6 +893,11 @@ void do_get_char_array_2(dumpi_profile *profile, int *len0, int *len1,
 { 
     int i0;                                              
     *len0 = get32(profile);
+    if(profile->skipping) {
+      for(i0 = 0; i0 < (*len0); ++i0)
+        getchararr(profile, len1, NULL);
+      return;
+    }
     *value = (char**)calloc((*len0)+1, sizeof(char*));
     for(i0 = 0; i0 < (*len0); ++i0) {                     
       getchararr(profile, len1, ((*value)+i0));
@@ -823,6 +940,14 @@ void do_get_char_array_2(dumpi_profile *profile, int *len0, int *len1,
 #define GET_CHAR_ARRAY_3(PROFILE, LEN0, LEN1, LEN2, VALUE) do {	  \
     int i0, i1;                                                   \
     LEN0 = get32(PROFILE);					  \
+    if((PROFILE)->skipping) {                                     \
+      for(i0 = 0; i0 < (LEN0); ++i0) {                            \
+        LEN1 = get32(PROFILE);                                    \
+        for(i1 = 0; i1 < (LEN1); ++i1)                            \
+          getchararr(PROFILE, &(LEN2), NULL);                     \
+      }                                                           \
+      break;                                                      \
+    }                                                             \
     VALUE = (char***)calloc((LEN0)+1, sizeof(char**));            \
     for(i0 = 0; i0 < (LEN0); ++i0) {                              \
       LEN1 = get32(PROFILE);					  \
@@ -857,6 +982,10 @@ void do_get_char_array_2(dumpi_profile *profile, int *len0, int *len1,
 #define GET_DUMPI_DATATYPE_ARRAY_1(PROFILE, LEN, VALUE) do {		\
     int i0;                                                             \
     LEN = get32(PROFILE);						\
+    if((PROFILE)->skipping) {                                           \
+      skip_bytes(PROFILE, (int64_t)(LEN) * sizeof(uint16_t));           \
+      break;                                                            \
+    }                                                                   \
     VALUE = (dumpi_datatype*)calloc((LEN)+1, sizeof(dumpi_datatype));   \
     for(i0 = 0; i0 < LEN; ++i0)                                         \
       VALUE[i0] = GET_DUMPI_DATATYPE(PROFILE);				\
@@ -879,6 +1008,10 @@ void do_get_char_array_2(dumpi_profile *profile, int *len0, int *len1,
 #define GET_DUMPI_DISTRIBUTION_ARRAY_1(PROFILE, LEN, VALUE)  do {	\
     int i0;                                                             \
     LEN = get32(PROFILE);						\
+    if((PROFILE)->skipping) {                                           \
+      skip_bytes(PROFILE, (int64_t)(LEN) * sizeof(uint8_t));            \
+      break;                                                            \
+    }                                                                   \
     VALUE = (dumpi_distribution*)calloc((LEN)+1, sizeof(dumpi_info));   \
     for(i0 = 0; i0 < (LEN); ++i0)                                       \
       VALUE[i0] = GET_DUMPI_DISTRIBUTION(PROFILE);			\
@@ -918,6 +1051,10 @@ void do_get_char_array_2(dumpi_profile *profile, int *len0, int *len1,
 #define GET_DUMPI_INFO_ARRAY_1(PROFILE, LEN, VALUE)  do {	\
     int i0;                                                     \
     LEN = get32(PROFILE);					\
+    if((PROFILE)->skipping) {                                   \
+      skip_bytes(PROFILE, (int64_t)(LEN) * sizeof(uint16_t));   \
+      break;                                                    \
+    }                                                           \
     VALUE = (dumpi_info*)calloc((LEN)+1, sizeof(dumpi_info));   \
     for(i0 = 0; i0 < (LEN); ++i0)                               \
       VALUE[i0] = GET_DUMPI_INFO(PROFILE);			\
@@ -165,6 +165,11 @@ int dumpi_init_perfctrs(dumpi_perfinfo *ctrs) {
 	      ctrs->counter_tag[i], PAPI_strerror(ret));
     }
   }
+  /* The labels do not change after this, so set them up once here
+   * rather than on every read. */
+  ctrs->count = active_counters_;
+  for(i = 0; i < active_counters_; ++i)
+    strcpy(ctrs->counter_tag[i], papi_label_[i]);
   /* Initialize accumulators for the current thread */
   return (get_accumulators() != NULL);
 }
@@ -182,12 +187,8 @@ void dumpi_get_perfctrs(const dumpi_profile *profile, dumpi_perfinfo *perf,
     perf->count = active_counters_;
     if(active_counters_) {
       PAPI_accum_counters(accum, active_counters_);
-      for(i = 0; i < active_counters_; ++i) {
-	/* THIS NEEDS TO BE FIXED */
-	strncpy(perf->counter_tag[i], papi_label_[i], DUMPI_MAX_PERFCTR_NAME-1);
-	perf->counter_tag[i][DUMPI_MAX_PERFCTR_NAME-1] = '\0';
+      for(i = 0; i < active_counters_; ++i)
 	active_ctr[i] = accum[i];
-      }
     }
   }
   else {
@@ -210,7 +211,343 @@ dumpi_perflabel_t* dumpi_perfctr_labels(void) {
   return papi_label_;
 }
 
-#else /* ! DUMPI_HAVE_PAPI */
+#elif defined(DUMPI_HAVE_PERF_EVENT)
+
+/*
+ * Native Linux backend using perf_event_open.
+ * Each thread opens its own counters (pid 0, any cpu) on first use.
+ * Counters are opened as a single group so that one read() returns all
+ * values; on x86, hardware counters are read with rdpmc from userspace
+ * when the kernel allows it (see perf_event_mmap_page::cap_user_rdpmc).
+ */
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DUMPI_PERF_RDPMC 1
+#endif
+
+/* Map counter names (perf tool names and the common PAPI presets)
+ * to perf event types. */
+typedef struct dumpi_perf_name {
+  const char *name;
+  uint32_t    type;
+  uint64_t    config;
+} dumpi_perf_name;
+
+static const dumpi_perf_name perf_names_[] = {
+  {"cycles",           PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+  {"PAPI_TOT_CYC",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+  {"instructions",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+  {"PAPI_TOT_INS",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+  {"cache-references", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+  {"cache-misses",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+  {"branches",         PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+  {"PAPI_BR_INS",      PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+  {"branch-misses",    PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+  {"PAPI_BR_MSP",      PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+  {"bus-cycles",       PERF_TYPE_HARDWARE, PERF_COUNT_HW_BUS_CYCLES},
+  {"ref-cycles",       PERF_TYPE_HARDWARE, PERF_COUNT_HW_REF_CPU_CYCLES},
+  {"PAPI_REF_CYC",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_REF_CPU_CYCLES},
+  {"cpu-clock",        PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_CLOCK},
+  {"task-clock",       PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+  {"page-faults",      PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+  {"minor-faults",     PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MIN},
+  {"major-faults",     PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MAJ},
+  {"context-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+  {"cpu-migrations",   PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS},
+  {"alignment-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_ALIGNMENT_FAULTS},
+  {"emulation-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_EMULATION_FAULTS},
+  {NULL, 0, 0}
+};
+
+/* The counters that were successfully opened on the initializing thread. */
+static int active_counters_ = 0;
+static uint32_t perf_type_[DUMPI_MAX_PERFCTRS];
+static uint64_t perf_config_[DUMPI_MAX_PERFCTRS];
+static dumpi_perflabel_t *perf_label_ = NULL;
+
+/* Per-thread counter state. */
+typedef struct dumpi_perf_thread {
+  int leader;                           /* group leader fd (or -1) */
+  int fd[DUMPI_MAX_PERFCTRS];           /* -1 if not available */
+  int slot[DUMPI_MAX_PERFCTRS];         /* index in group read, -1 if none */
+  int members;                          /* number of counters in the group */
+  struct perf_event_mmap_page *page[DUMPI_MAX_PERFCTRS];
+  int rdpmc;                            /* all counters readable by rdpmc */
+  uint64_t buffer[DUMPI_MAX_PERFCTRS+1];
+} dumpi_perf_thread;
+
+#ifdef DUMPI_USE_PTHREADS
+static pthread_key_t *thread_key_ = NULL;
+static pthread_mutex_t thread_key_lock_ = PTHREAD_MUTEX_INITIALIZER;
+#else
+static dumpi_perf_thread *thread_global_ = NULL;
+#endif /* ! DUMPI_USE_PTHREADS */
+
+/* Parse a counter name; raw events can be given as rNNNN (hex). */
+static int lookup_perf_event(const char *name, uint32_t *type,
+                             uint64_t *config)
+{
+  int i;
+  for(i = 0; perf_names_[i].name != NULL; ++i) {
+    if(strcmp(name, perf_names_[i].name) == 0) {
+      *type = perf_names_[i].type;
+      *config = perf_names_[i].config;
+      return 1;
+    }
+  }
+  if(name[0] == 'r' && name[1] != '\0') {
+    char *end = NULL;
+    unsigned long long raw = strtoull(name+1, &end, 16);
+    if(end != NULL && *end == '\0') {
+      *type = PERF_TYPE_RAW;
+      *config = raw;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Open one counter for the calling thread.
+ * We first ask for kernel-mode counts as well; if the system does not allow
+ * that (perf_event_paranoid > 1, as in most containers) retry user-only.
+ */
+static int open_perf_event(uint32_t type, uint64_t config, int group) {
+  int fd;
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.read_format = PERF_FORMAT_GROUP;
+  attr.exclude_hv = 1;
+  fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+  if(fd < 0 && (errno == EACCES || errno == EPERM)) {
+    attr.exclude_kernel = 1;
+    fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+  }
+  return fd;
+}
+
+static void free_thread_counters(void *arg) {
+  int i;
+  dumpi_perf_thread *state = (dumpi_perf_thread*)arg;
+  if(state == NULL) return;
+  for(i = 0; i < active_counters_; ++i) {
+    if(state->page[i] != NULL)
+      munmap(state->page[i], sysconf(_SC_PAGESIZE));
+    if(state->fd[i] >= 0)
+      close(state->fd[i]);
+  }
+  free(state);
+}
+
+/* Open all active counters for the calling thread. */
+static dumpi_perf_thread* open_thread_counters(void) {
+  int i;
+  long pagesize = sysconf(_SC_PAGESIZE);
+  dumpi_perf_thread *state;
+  assert((state = (dumpi_perf_thread*)calloc(1, sizeof(dumpi_perf_thread)))
+         != NULL);
+  state->leader = -1;
+  state->rdpmc = 1;
+  for(i = 0; i < active_counters_; ++i) {
+    state->fd[i] = open_perf_event(perf_type_[i], perf_config_[i],
+                                   state->leader);
+    state->slot[i] = -1;
+    state->page[i] = NULL;
+    if(state->fd[i] < 0) {
+      state->rdpmc = 0;
+      continue;
+    }
+    if(state->leader < 0)
+      state->leader = state->fd[i];
+    state->slot[i] = state->members++;
+#ifdef DUMPI_PERF_RDPMC
+    if(perf_type_[i] != PERF_TYPE_SOFTWARE) {
+      void *page = mmap(NULL, pagesize, PROT_READ, MAP_SHARED,
+                        state->fd[i], 0);
+      if(page != MAP_FAILED) {
+        state->page[i] = (struct perf_event_mmap_page*)page;
+        if(! state->page[i]->cap_user_rdpmc)
+          state->rdpmc = 0;
+      }
+      else {
+        state->rdpmc = 0;
+      }
+    }
+    else {
+      state->rdpmc = 0;
+    }
+#else
+    (void)pagesize;
+    state->rdpmc = 0;
+#endif /* ! DUMPI_PERF_RDPMC */
+  }
+  return state;
+}
+
+/* Get (or set up) the counters for the current thread. */
+static inline dumpi_perf_thread* get_thread_counters(void) {
+#ifdef DUMPI_USE_PTHREADS
+  dumpi_perf_thread *state;
+  if(thread_key_ == NULL) {
+    assert(pthread_mutex_lock(&thread_key_lock_) == 0);
+    if(thread_key_ == NULL) {
+      pthread_key_t *key = (pthread_key_t*)malloc(sizeof(pthread_key_t));
+      assert(key != NULL);
+      assert(pthread_key_create(key, free_thread_counters) == 0);
+      thread_key_ = key;
+    }
+    assert(pthread_mutex_unlock(&thread_key_lock_) == 0);
+  }
+  state = (dumpi_perf_thread*)pthread_getspecific(*thread_key_);
+  if(state == NULL) {
+    state = open_thread_counters();
+    assert(pthread_setspecific(*thread_key_, state) == 0);
+  }
+  return state;
+#else /* ! DUMPI_USE_PTHREADS */
+  if(thread_global_ == NULL)
+    thread_global_ = open_thread_counters();
+  return thread_global_;
+#endif /* ! DUMPI_USE_PTHREADS */
+}
+
+#ifdef DUMPI_PERF_RDPMC
+static inline uint64_t dumpi_rdpmc(uint32_t counter) {
+  uint32_t low, high;
+  __asm__ __volatile__("rdpmc" : "=a" (low), "=d" (high) : "c" (counter));
+  return (uint64_t)low | ((uint64_t)high << 32);
+}
+
+/* Read a counter from userspace.  Returns 0 if the counter is not
+ * currently scheduled on a hardware register. */
+static inline int read_rdpmc(volatile struct perf_event_mmap_page *pc,
+                             int64_t *value)
+{
+  uint32_t seq, idx;
+  int64_t count, pmc;
+  int width;
+  do {
+    seq = pc->lock;
+    __sync_synchronize();
+    idx = pc->index;
+    if(!(pc->cap_user_rdpmc && idx))
+      return 0;
+    count = pc->offset;
+    width = pc->pmc_width;
+    pmc = (int64_t)dumpi_rdpmc(idx - 1);
+    pmc <<= 64 - width;
+    pmc >>= 64 - width;
+    count += pmc;
+    __sync_synchronize();
+  } while(pc->lock != seq);
+  *value = count;
+  return 1;
+}
+#endif /* DUMPI_PERF_RDPMC */
+
+int dumpi_init_perfctrs(dumpi_perfinfo *ctrs) {
+  int i, fd, count;
+  uint32_t type;
+  uint64_t config;
+  assert(ctrs != NULL);
+  count = ctrs->count;
+  active_counters_ = 0;
+  dumpi_init_perfctr_tags();
+  perf_label_ = (dumpi_perflabel_t*)calloc(DUMPI_MAX_PERFCTRS,
+                                           sizeof(dumpi_perflabel_t));
+  assert(perf_label_ != NULL);
+  /* Figure out which counters can be opened on this system. */
+  for(i = 0; i < count && active_counters_ < DUMPI_MAX_PERFCTRS; ++i) {
+    if(! lookup_perf_event(ctrs->counter_tag[i], &type, &config)) {
+      fprintf(stderr, "perf_event counter %s not known -- skipped\n",
+              ctrs->counter_tag[i]);
+      continue;
+    }
+    if((fd = open_perf_event(type, config, -1)) < 0) {
+      fprintf(stderr, "perf_event counter %s not supported -- skipped "
+              "(error: %s)\n", ctrs->counter_tag[i], strerror(errno));
+      continue;
+    }
+    close(fd);
+    perf_type_[active_counters_] = type;
+    perf_config_[active_counters_] = config;
+    strcpy(perf_label_[active_counters_], ctrs->counter_tag[i]);
+    ++active_counters_;
+  }
+  ctrs->count = active_counters_;
+  for(i = 0; i < active_counters_; ++i)
+    strcpy(ctrs->counter_tag[i], perf_label_[i]);
+  if(active_counters_ == 0)
+    return (count == 0);
+  /* Open the group for the current thread */
+  return (get_thread_counters()->leader >= 0);
+}
+
+void dumpi_get_perfctrs(const dumpi_profile *profile, dumpi_perfinfo *perf,
+			dumpi_perfinfo_direction direction)
+{
+  int i;
+  dumpi_perf_thread *state;
+  int64_t *active_ctr = (direction == DUMPI_PERFCTR_IN ?
+			 perf->invalue : perf->outvalue);
+  (void)profile;
+  if(active_counters_ > 0) {
+    perf->count = active_counters_;
+    state = get_thread_counters();
+#ifdef DUMPI_PERF_RDPMC
+    if(state->rdpmc) {
+      for(i = 0; i < active_counters_; ++i) {
+        if(! read_rdpmc(state->page[i], &active_ctr[i]))
+          break;
+      }
+      if(i == active_counters_)
+        return;
+    }
+#endif /* DUMPI_PERF_RDPMC */
+    /* One read returns { nr, values[nr] } for the whole group */
+    if(state->leader < 0 ||
+       read(state->leader, state->buffer,
+            (state->members+1)*sizeof(uint64_t)) <= 0)
+    {
+      memset(active_ctr, 0, active_counters_*sizeof(int64_t));
+      return;
+    }
+    for(i = 0; i < active_counters_; ++i)
+      active_ctr[i] = (state->slot[i] >= 0 ?
+                       (int64_t)state->buffer[state->slot[i]+1] : 0);
+  }
+  else {
+    perf->count = 0;
+  }
+}
+
+/**
+ * How many perfcounters are currently active?
+ */
+size_t dumpi_active_perfctrs(void) {
+  return active_counters_;
+}
+
+/**
+ * What are the labels of currently active perfctrs?
+ * Array at least of length dumpi_active_perfctrs().
+ */
+dumpi_perflabel_t* dumpi_perfctr_labels(void) {
+  return perf_label_;
+}
+
+#else /* ! DUMPI_HAVE_PAPI && ! DUMPI_HAVE_PERF_EVENT */
 
 int dumpi_init_perfctrs(dumpi_perfinfo *ctrs) {
   assert(ctrs != NULL);
@@ -55,7 +55,7 @@ extern "C" {
   /**
    * \ingroup common
    * \defgroup common_perfctrs common/perfctrs:  \
-   *      Support for PAPI performance monitors
+   *      Support for performance monitors (PAPI or Linux perf_event)
    */
   /*@{*/
 
@@ -73,6 +73,14 @@ extern "C" {
    * performance counters as possible (up to the value provided by PAPI
    * or DUMPI_MAX_PERFCTRS, whichever is smaller).
    *
+   * When PAPI is not available, counters are opened with perf_event_open
+   * instead; they can be given by perf tool name (e.g. cycles, task-clock,
+   * page-faults), as one of the common PAPI presets (PAPI_TOT_CYC,
+   * PAPI_TOT_INS, PAPI_BR_INS, PAPI_BR_MSP, PAPI_REF_CYC) or as a raw
+   * event (rNNNN, hex).
+   *
+   * On return, ctrs holds the labels and count of the active counters.
+   *
    * Counters that are not provided by the current system are ignored.
    * All other counters are processed in first-in order, so if the system
    * supports (for example) 2 concurrent counters but 4 are requested
@@ -81,7 +89,7 @@ extern "C" {
   int dumpi_init_perfctrs(dumpi_perfinfo *ctrs);
 
   /**
-   * Read PAPI performance counters.
+   * Read performance counters for the calling thread.
    */
   void dumpi_get_perfctrs(const dumpi_profile *profile, dumpi_perfinfo *perf,
                           dumpi_perfinfo_direction direction);
@@ -300,3 +300,48 @@ void dumpi_free_keyval_record(dumpi_keyval_record *record) {
 void dumpi_free_footer(dumpi_footer *footer) {
   free(footer);
 }
+
+int dumpi_callstats_bucket(uint64_t value) {
+  int bucket = 0;
+#ifdef __GNUC__
+  if(value > 0)
+    bucket = 64 - __builtin_clzll(value);
+#else
+  while(value > 0) {
+    value >>= 1;
+    ++bucket;
+  }
+#endif
+  return (bucket < DUMPI_CALLSTATS_BUCKETS ? bucket : DUMPI_CALLSTATS_BUCKETS-1);
+}
+
+void dumpi_merge_callstats_entry(dumpi_callstats_entry *dest,
+                                 const dumpi_callstats_entry *src)
+{
+  int i;
+  if(src->count == 0)
+    return;
+  if(dest->count == 0 || src->min_ns < dest->min_ns)
+    dest->min_ns = src->min_ns;
+  if(src->max_ns > dest->max_ns)
+    dest->max_ns = src->max_ns;
+  dest->count    += src->count;
+  dest->total_ns += src->total_ns;
+  dest->bytes    += src->bytes;
+  for(i = 0; i < DUMPI_CALLSTATS_BUCKETS; ++i) {
+    dest->time_hist[i] += src->time_hist[i];
+    dest->size_hist[i] += src->size_hist[i];
+  }
+}
+
+void dumpi_free_callstats(dumpi_callstats *stats) {
+  free(stats);
+}
+
+void dumpi_clear_commstats(dumpi_commstats *stats) {
+  free(stats->peer);
+  free(stats->coll);
+  stats->peer = NULL;
+  stats->coll = NULL;
+  stats->peers = stats->colls = 0;
+}
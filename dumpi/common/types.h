@@ -248,9 +248,113 @@ extern "C" {
    */
   void dumpi_free_footer(dumpi_footer *footer);
 
+  /** The number of log2 buckets in a call statistics histogram. */
+#define DUMPI_CALLSTATS_BUCKETS 32
+
+  /**
+   * Aggregated statistics for one MPI function, written instead of
+   * per-call records when libdumpi runs in profile-only mode.
+   * Histogram bucket 0 holds zero values and bucket i (i > 0) holds
+   * values in [2^(i-1), 2^i); the last bucket also holds anything larger.
+   */
+  typedef struct dumpi_callstats_entry {
+    /** The number of profiled calls */
+    uint64_t         count;
+    /** Total, shortest and longest wall time spent in the call (ns) */
+    uint64_t         total_ns, min_ns, max_ns;
+    /** Total message payload (count times type size) in bytes */
+    uint64_t         bytes;
+    /** Log2 histogram of call durations in nanoseconds */
+    uint64_t         time_hist[DUMPI_CALLSTATS_BUCKETS];
+    /** Log2 histogram of message payloads in bytes */
+    uint64_t         size_hist[DUMPI_CALLSTATS_BUCKETS];
+  } dumpi_callstats_entry;
+
+  /**
+   * A call statistics record -- one entry per MPI function,
+   * merged over all threads that made MPI calls.
+   */
+  typedef struct dumpi_callstats {
+    /** The number of threads whose statistics were merged */
+    uint32_t              threads;
+    dumpi_callstats_entry entry[DUMPI_ALL_FUNCTIONS];
+  } dumpi_callstats;
+
+  /**
+   * Find the histogram bucket for a value.
+   */
+  int dumpi_callstats_bucket(uint64_t value);
+
+  /**
+   * Add the statistics in src to dest.
+   */
+  void dumpi_merge_callstats_entry(dumpi_callstats_entry *dest,
+                                   const dumpi_callstats_entry *src);
+
+  /**
+   * Free up a call statistics record.
+   */
+  void dumpi_free_callstats(dumpi_callstats *stats);
+
+  /**
+   * Point-to-point traffic from one rank to a peer,
+   * recorded by libdumpi when the message is sent.
+   */
+  typedef struct dumpi_commpeer {
+    /** The destination rank in MPI_COMM_WORLD */
+    int32_t          peer;
+    /** The number of messages and bytes sent to the peer */
+    uint64_t         messages, bytes;
+  } dumpi_commpeer;
+
+  /**
+   * Collective traffic on one communicator.  A communicator is identified
+   * by its size and the MPI_COMM_WORLD rank of its rank 0, so duplicates
+   * of a communicator are counted together.
+   */
+  typedef struct dumpi_commcoll {
+    int32_t          size, leader;
+    /** The number of collective calls and their payload in bytes */
+    uint64_t         calls, bytes;
+  } dumpi_commcoll;
+
+  /**
+   * A communication matrix record -- the row of the rank-to-rank traffic
+   * matrix for one rank, plus its collective traffic.
+   */
+  typedef struct dumpi_commstats {
+    /** The rank in MPI_COMM_WORLD */
+    int32_t          rank;
+    /** Peers (sorted by peer) and communicators */
+    int32_t          peers, colls;
+    dumpi_commpeer  *peer;
+    dumpi_commcoll  *coll;
+  } dumpi_commstats;
+
+  /**
+   * Free the arrays in a communication matrix record and set the
+   * counts to zero (does not free the record itself).
+   */
+  void dumpi_clear_commstats(dumpi_commstats *stats);
+
   /** Forward declaration of the memory buffer type (defined in iodefs.c). */
   struct dumpi_memory_buffer;
 
+  /** The maximum number of perfcounters we support.
+   * We may need to consider growing this */
+#define DUMPI_MAX_PERFCTRS 128
+  /** The maximum string name for a perfcounter.
+   * We have yet to encounter a performance counter that gets anywhere
+   * close to this name length */
+#define DUMPI_MAX_PERFCTR_NAME 80
+  /** The largest number of perfcounters a record can carry on the stream
+   * (the count is stored as an 8-bit value). */
+#define DUMPI_MAX_STREAM_PERFCTRS 255
+
+  struct dumpi_perfinfo;
+  struct dumpi_record_prefix;
+  struct undumpi_filter;
+
   /**
    * Specify what output gets written and keep track of call counts.
    * This is mainly for internal consumption (not instrumentation/undumping).
@@ -270,6 +374,13 @@ extern "C" {
     int32_t          wall_time_offset;
     /** The file positions of the various record entries in a trace file */
     DUMPI_FPOS       header, body, footer, keyval, perflbl, addrlbl, sizelbl;
+    /** The file positions of the call statistics and communication
+     *  matrix (0 if the trace has none) */
+    DUMPI_FPOS       statslbl, commlbl;
+    /** The file position of the checkpoint a trace without an index was
+     *  recovered from (0 for a complete trace).  The readable part of
+     *  the call stream ends at the checkpoint. */
+    DUMPI_FPOS       chkpt;
     /**
      * The version of DUMPI involved in generating a trace file.
      * This information is also available from the header record --
@@ -291,6 +402,27 @@ extern "C" {
     uint64_t total_file_size;
     uint64_t pos;
     uint64_t terminate_pos;
+    /**
+     * Reader-side perfcounter state (not used for writes).
+     * The label table is read from the trace once, on first use, and
+     * shared by all dumpi_perfdata records read from this profile.
+     */
+    char           (*perflabels)[DUMPI_MAX_PERFCTR_NAME];
+    /** Value storage for records with more than DUMPI_PERFDATA_INLINE
+     *  counters (in values followed by out values). */
+    int64_t         *perfvalues;
+    /** Expanded dumpi_perfinfo handed to callbacks (see libundumpi). */
+    struct dumpi_perfinfo *perfcompat;
+    /** Reader-side record filter (see libundumpi/filter.h), or NULL. */
+    const struct undumpi_filter *filter;
+    /** A record prefix that was already read off the stream to test it
+     *  against the filter.  The next dumpi_read_* call takes its values
+     *  from here instead of the stream, then clears it. */
+    struct dumpi_record_prefix *prefix;
+    /** Non-zero while a rejected record is being stepped over.
+     *  Array arguments are then skipped instead of allocated, and the
+     *  pointers in the record are left alone. */
+    int skipping;
   } dumpi_profile;
 
   /**
@@ -321,13 +453,6 @@ extern "C" {
     int              *size;
   } dumpi_sizeof;
 
-  /** The maximum number of perfcounters we support.
-   * We may need to consider growing this */
-#define DUMPI_MAX_PERFCTRS 128
-  /** The maximum string name for a perfcounter.
-   * We have yet to encounter a performance counter that gets anywhere
-   * close to this name length */
-#define DUMPI_MAX_PERFCTR_NAME 80
   /**
    * The container for PAPI perfcounter information.
    */
@@ -342,6 +467,32 @@ extern "C" {
     int64_t outvalue[DUMPI_MAX_PERFCTRS];
   } dumpi_perfinfo;
 
+  /** The number of counter values stored inside a dumpi_perfdata */
+#define DUMPI_PERFDATA_INLINE 8
+  /**
+   * Compact perfcounter information used when reading a trace.
+   * dumpi_perfinfo is over 12 KB, most of it labels that are the same
+   * for every record in a trace; this holds only the count, a pointer to
+   * the per-profile label table and the values.
+   *
+   * counter_tag, invalue and outvalue point either into this struct or
+   * into storage owned by the profile, so the struct should not be copied
+   * and the values are only valid until the next record is read.
+   */
+  typedef struct dumpi_perfdata {
+    /** The number of perfcounters collected. */
+    int32_t count;
+    /** The names of the performance counters (owned by the profile). */
+    const char (*counter_tag)[DUMPI_MAX_PERFCTR_NAME];
+    /** The value of each of the counters at DUMPI_PERFCTR_IN */
+    const int64_t *invalue;
+    /** The value of each of the counters at DUMPI_PERFCTR_OUT */
+    const int64_t *outvalue;
+    /** Inline value storage for the common case of few counters */
+    int64_t inline_in[DUMPI_PERFDATA_INLINE];
+    int64_t inline_out[DUMPI_PERFDATA_INLINE];
+  } dumpi_perfdata;
+
   /**
    * This is effectively identical to struct timespec from time.h,
    * but some target platforms don't have high resolution timers.
@@ -375,6 +526,34 @@ extern "C" {
     dumpi_clock stop;    /* stored as 6 bytes */
   } dumpi_time;
 
+  /**
+   * The fixed part at the start of every record in the call stream
+   * (following the function label).
+   */
+  typedef struct dumpi_record_prefix {
+    uint8_t     config_mask;
+    uint16_t    thread;
+    dumpi_time  cpu, wall;
+  } dumpi_record_prefix;
+
+  /**
+   * A checkpoint record.  libdumpi puts one in the call stream each time
+   * it flushes its output buffer, so that the part of a trace written
+   * before the job was killed (or while it is still running) can be read.
+   */
+  typedef struct dumpi_checkpoint {
+    /** The file offset of the checkpoint (end of the readable stream) */
+    DUMPI_FPOS  position;
+    /** The file offset of the call stream */
+    DUMPI_FPOS  body;
+    /** The number of records written before the checkpoint */
+    uint64_t    records;
+    /** Wall time when the checkpoint was written */
+    dumpi_clock wall;
+    /** The version of DUMPI that wrote the trace */
+    char        version[3];
+  } dumpi_checkpoint;
+
   /*@}*/ /* close the doxygen documentation module */
 
 #ifdef __cplusplus
@@ -43,10 +43,15 @@ Questions? Contact sst-macro-help@sandia.gov
 */
 
 #include <dumpi/libdumpi/callprofile-addrset.h>
+#include <dumpi/dumpiconfig.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+#endif /* ! DUMPI_USE_PTHREADS */
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* !__cplusplus */
@@ -69,7 +74,7 @@ extern "C" {
   } dumpi_addrlist;
 
   /** Note that the number of buckets goes with the size of HASH_TYPE
-   * HASH_TYPE unsigned short results in 32Ki buckets */
+   * HASH_TYPE unsigned short results in 64Ki buckets */
 #define HASH_TYPE unsigned short
 
   /** Figure out how many buckets we can fit */
@@ -81,20 +86,38 @@ extern "C" {
    */
   static dumpi_addrlist *addresses = NULL;
 
+#ifdef DUMPI_USE_PTHREADS
+  /** Insertions can come from any thread.  Callers are expected to keep a
+   * thread-local cache in front of this set (see callprofile.c), so the lock
+   * is only taken the first time a thread encounters a given address. */
+  static pthread_mutex_t addresses_lock = PTHREAD_MUTEX_INITIALIZER;
+#define DUMPI_LOCK_ADDRESSES   assert(pthread_mutex_lock(&addresses_lock) == 0)
+#define DUMPI_UNLOCK_ADDRESSES assert(pthread_mutex_unlock(&addresses_lock) == 0)
+#else /* ! DUMPI_USE_PTHREADS */
+#define DUMPI_LOCK_ADDRESSES
+#define DUMPI_UNLOCK_ADDRESSES
+#endif /* ! DUMPI_USE_PTHREADS */
+
+  /**
+   * Compute a bucket index from the address value.
+   * Function entry points are aligned, so we use a multiplicative
+   * (Fibonacci) hash and keep the high bits rather than folding the
+   * low-order bits together.
+   */
+  static inline HASH_TYPE DUMPI_SKIP_INSTRUMENTING
+  hash_address(uint64_t address) {
+    return (HASH_TYPE)((address * 0x9E3779B97F4A7C15ULL) >>
+                       (64 - 8*sizeof(HASH_TYPE)));
+  }
+
   /**
    * Insert an address on the shared address list.
-   * This might be better handled without the shared back-end list.
+   * Returns 1 if the address was not previously in the set.
    */
-  static void insert_address(uint64_t address) {
-    const HASH_TYPE *hash_view = NULL;
-    int seen, i, range;
-    HASH_TYPE hash = 0;
-    range = sizeof(uint64_t) / sizeof(HASH_TYPE);
-    /* Compute a hash of the address */
-    hash_view = (const HASH_TYPE*)(address);
-    for(i = 0; i < range; ++i) {
-      hash ^= hash_view[i];
-    }
+  static int DUMPI_SKIP_INSTRUMENTING insert_address(uint64_t address) {
+    int seen, i;
+    HASH_TYPE hash = hash_address(address);
+    DUMPI_LOCK_ADDRESSES;
     /* This may be a first time we enter this function */
     if(addresses == NULL) {
       addresses = (dumpi_addrlist*) calloc(BUCKETS, sizeof(dumpi_addrlist));
@@ -129,6 +152,15 @@ extern "C" {
       addresses[hash].addr[addresses[hash].count] = address;
       ++addresses[hash].count;
     }
+    DUMPI_UNLOCK_ADDRESSES;
+    return (seen == 0);
+  }
+
+  /**
+   * Insert an address on the shared address list.
+   */
+  int libdumpi_insert_address(void *address) {
+    return insert_address((uint64_t)address);
   }
 
   /**
@@ -70,9 +70,12 @@ extern "C" {
 
   /**
    * Insert an address on the shared address list.
-   * Uses libdl (if available) to figure out the name at this address.
+   * This is safe to call from multiple threads.  Function names are not
+   * looked up here; that happens in one pass when the profile is written
+   * (see dumpi_profile_function_names).
+   * \return 1 if the address was not already in the list, 0 otherwise.
    */
-  void libdumpi_insert_address(void *address);
+  int libdumpi_insert_address(void *address);
 
   /**
    * Get an iterator to the first valid pointer on the address list. 
@@ -42,12 +42,29 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 Questions? Contact sst-macro-help@sandia.gov
 */
 
+/* dladdr and dlsym need the GNU extensions enabled before any
+ * system header is pulled in. */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE 1
+#endif
+
 #include <dumpi/libdumpi/callprofile.h>
 #include <dumpi/libdumpi/callprofile-addrset.h>
 #include <dumpi/libdumpi/mpibindings.h>
+#include <dumpi/libdumpi/mpibindings-utils.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+#endif /* ! DUMPI_USE_PTHREADS */
+
+#ifdef DUMPI_DLADDR_WORKS
+#include <dlfcn.h>
+#endif /* ! DUMPI_DLADDR_WORKS */
 
 /*
  * We keep annotations and data blocks here.
@@ -146,31 +163,207 @@ const char* data_map_find(uint64_t key) {
   return retval;
 }
 
+/*
+ * Restrictions on which user functions get written to the trace.
+ * These are set up while reading the configuration (before any
+ * instrumented function is traced) and are read-only afterwards.
+ */
+typedef struct libdumpi_call_range {
+  uint64_t lo, hi;  /* half-open interval [lo, hi) */
+} libdumpi_call_range;
+
+static int call_depth_limit_ = 0;       /* 0 means no limit */
+static int call_range_count_ = 0, call_range_length_ = 0;
+static libdumpi_call_range *call_ranges_ = NULL;
+
+/* Set the maximum call depth for user function tracing. */
+void libdumpi_set_call_depth_limit(int depth) {
+  call_depth_limit_ = (depth > 0 ? depth : 0);
+}
+
+/* Add an address range to the list of traced user functions. */
+void libdumpi_add_call_range(uint64_t lo, uint64_t hi) {
+  if(hi <= lo)
+    return;
+  if(call_range_count_ >= call_range_length_) {
+    call_range_length_ = (call_range_length_ ? 2*call_range_length_ : 8);
+    assert((call_ranges_ = (libdumpi_call_range*)
+            realloc(call_ranges_, call_range_length_ *
+                    sizeof(libdumpi_call_range))) != NULL);
+  }
+  call_ranges_[call_range_count_].lo = lo;
+  call_ranges_[call_range_count_].hi = hi;
+  ++call_range_count_;
+}
+
+/* Add a function (by symbol name) to the list of traced user functions. */
+int libdumpi_add_call_symbol(const char *symbol) {
+#ifdef DUMPI_DLADDR_WORKS
+  void *addr = dlsym(RTLD_DEFAULT, symbol);
+  if(addr == NULL) {
+    fprintf(stderr, "[DUMPI-LIBDUMPI]: No symbol %s found for tracing -- "
+            "ignored\n", symbol);
+    return 0;
+  }
+  libdumpi_add_call_range((uint64_t)addr, (uint64_t)addr + 1);
+  return 1;
+#else /* ! DUMPI_DLADDR_WORKS */
+  fprintf(stderr, "[DUMPI-LIBDUMPI]: Symbol lookup not supported; cannot "
+          "trace %s by name -- ignored\n", symbol);
+  return 0;
+#endif /* ! DUMPI_DLADDR_WORKS */
+}
+
 #ifdef DUMPI_ENABLE_INSTRUMENTATION
 
-static int calldepth = 0;
+/*
+ * Per-thread state for the instrumentation hooks.
+ * Each thread keeps its own call depth and a small open-addressing cache
+ * that remembers whether a given function address passed the trace filter.
+ * The shared address set (callprofile-addrset) is only consulted the first
+ * time a thread sees a function, so the common path takes no locks.
+ */
+typedef struct libdumpi_call_state {
+  int depth;
+  int count, length;   /* length is always a power of two */
+  uint64_t *addr;      /* 0 marks an empty slot */
+  uint8_t *traced;
+} libdumpi_call_state;
+
+static inline size_t DUMPI_SKIP_INSTRUMENTING call_slot(uint64_t fn, int length) {
+  return (size_t)((fn * 0x9E3779B97F4A7C15ULL) >> 32) & (length - 1);
+}
+
+static void DUMPI_SKIP_INSTRUMENTING
+call_state_grow(libdumpi_call_state *state) {
+  int i, oldlength = state->length;
+  uint64_t *oldaddr = state->addr;
+  uint8_t *oldtraced = state->traced;
+  state->length = (oldlength ? 2*oldlength : 256);
+  assert((state->addr = (uint64_t*)calloc(state->length, sizeof(uint64_t)))
+         != NULL);
+  assert((state->traced = (uint8_t*)calloc(state->length, sizeof(uint8_t)))
+         != NULL);
+  for(i = 0; i < oldlength; ++i) {
+    if(oldaddr[i] != 0) {
+      size_t slot = call_slot(oldaddr[i], state->length);
+      while(state->addr[slot] != 0)
+        slot = (slot + 1) & (state->length - 1);
+      state->addr[slot] = oldaddr[i];
+      state->traced[slot] = oldtraced[i];
+    }
+  }
+  free(oldaddr);
+  free(oldtraced);
+}
+
+static void DUMPI_SKIP_INSTRUMENTING call_state_free(void *arg) {
+  libdumpi_call_state *state = (libdumpi_call_state*)arg;
+  if(state) {
+    free(state->addr);
+    free(state->traced);
+    free(state);
+  }
+}
+
+#ifdef DUMPI_USE_PTHREADS
+
+static pthread_key_t call_state_key;
+static pthread_once_t call_state_once = PTHREAD_ONCE_INIT;
+
+static void DUMPI_SKIP_INSTRUMENTING call_state_key_init(void) {
+  assert(pthread_key_create(&call_state_key, call_state_free) == 0);
+}
+
+static libdumpi_call_state* DUMPI_SKIP_INSTRUMENTING get_call_state(void) {
+  libdumpi_call_state *state;
+  pthread_once(&call_state_once, call_state_key_init);
+  state = (libdumpi_call_state*)pthread_getspecific(call_state_key);
+  if(state == NULL) {
+    assert((state = (libdumpi_call_state*)
+            calloc(1, sizeof(libdumpi_call_state))) != NULL);
+    assert(pthread_setspecific(call_state_key, state) == 0);
+  }
+  return state;
+}
+
+#else /* ! DUMPI_USE_PTHREADS */
+
+static libdumpi_call_state call_state_;
+
+static libdumpi_call_state* DUMPI_SKIP_INSTRUMENTING get_call_state(void) {
+  return &call_state_;
+}
+
+#endif /* ! DUMPI_USE_PTHREADS */
+
+/* Check a function address against the configured address ranges. */
+static int DUMPI_SKIP_INSTRUMENTING call_in_ranges(uint64_t fn) {
+  int i;
+  if(call_range_count_ == 0)
+    return 1;
+  for(i = 0; i < call_range_count_; ++i) {
+    if(fn >= call_ranges_[i].lo && fn < call_ranges_[i].hi)
+      return 1;
+  }
+  return 0;
+}
+
+/*
+ * Figure out whether the given function should be traced, caching the
+ * answer for this thread.  Traced functions are recorded in the shared
+ * address set so that their names are written out at finalize.
+ */
+static int DUMPI_SKIP_INSTRUMENTING
+call_is_traced(libdumpi_call_state *state, uint64_t fn) {
+  size_t slot;
+  if(state->length > 0) {
+    slot = call_slot(fn, state->length);
+    while(state->addr[slot] != 0) {
+      if(state->addr[slot] == fn)
+        return state->traced[slot];
+      slot = (slot + 1) & (state->length - 1);
+    }
+  }
+  /* First time this thread has seen this function. */
+  if(2*(state->count + 1) > state->length)
+    call_state_grow(state);
+  slot = call_slot(fn, state->length);
+  while(state->addr[slot] != 0)
+    slot = (slot + 1) & (state->length - 1);
+  state->addr[slot] = fn;
+  state->traced[slot] = (uint8_t)call_in_ranges(fn);
+  ++state->count;
+  if(state->traced[slot])
+    libdumpi_insert_address((void*)fn);
+  return state->traced[slot];
+}
 
 /* Indicate entry into a profiled function. */
 void __cyg_profile_func_enter(void *fn, void *site) {
   dumpi_func_call stat;
   uint16_t thread;
   dumpi_time cpu, wall;
-  /*
-  printf("__cyg_profile_func_enter(%p [\"%s\"], %p)\n",
-	 fn, dumpi_function_name(fn), site);
-  */
+  libdumpi_call_state *state;
+  (void)site;
   if(dumpi_global == NULL)
     libdumpi_init();
-  STARTTIME(cpu, wall);
-  THREAD_ID(thread);
-  (void)site;
-  ++calldepth;
-  libdumpi_insert_address(fn);
-  if(dumpi_global->output->function[DUMPI_Function_enter]) {
+  state = get_call_state();
+  ++state->depth;
+  /* Filter before doing any timing work. */
+  if(call_depth_limit_ > 0 && state->depth > call_depth_limit_)
+    return;
+  if(! call_is_traced(state, (uint64_t)fn))
+    return;
+  if(DUMPI_PROFILING(DUMPI_Function_enter)) {
+    DUMPI_START_TIME(cpu, wall);
     stat.fn = (uint64_t)fn;
-    STOPTIME(cpu, wall);
+    thread = libdumpi_get_thread_id();
+    DUMPI_STOP_TIME(cpu, wall);
+    libdumpi_lock_io();
     dumpi_write_func_enter(&stat, thread, &cpu, &wall, dumpi_global->perf,
 			   dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
   }
 }
 
@@ -179,18 +372,28 @@ void __cyg_profile_func_exit(void *fn, void *site) {
   dumpi_func_call stat;
   uint16_t thread;
   dumpi_time cpu, wall;
+  libdumpi_call_state *state;
+  int depth;
+  (void)site;
   if(dumpi_global == NULL)
     libdumpi_init();
-  STARTTIME(cpu, wall);
-  THREAD_ID(thread);
-  (void)site;
-  --calldepth;
-  insert_address(fn); /* should not be needed - but better safe than sorry */
-  if(dumpi_global->output->function[DUMPI_Function_exit]) {
+  state = get_call_state();
+  depth = state->depth;
+  if(state->depth > 0)
+    --state->depth;
+  if(call_depth_limit_ > 0 && depth > call_depth_limit_)
+    return;
+  if(! call_is_traced(state, (uint64_t)fn))
+    return;
+  if(DUMPI_PROFILING(DUMPI_Function_exit)) {
+    DUMPI_START_TIME(cpu, wall);
     stat.fn = (uint64_t)fn;
-    STOPTIME(cpu, wall);
+    thread = libdumpi_get_thread_id();
+    DUMPI_STOP_TIME(cpu, wall);
+    libdumpi_lock_io();
     dumpi_write_func_exit(&stat, thread, &cpu, &wall, dumpi_global->perf,
 			  dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
   }
 }
 
@@ -207,13 +410,13 @@ void libdumpi_insert_data(uint64_t key, const char *data) {
 }
 
 #ifdef DUMPI_DLADDR_WORKS
-#define _GNU_SOURCE 1
-#define __USE_GNU 1
-#include <dlfcn.h>
+
+static const char *none = "(none)";
 
 static const char* lookup_function_name(uint64_t fn) {
   Dl_info din;
-  assert(dladdr((void*)fn, &din) != 0);
+  if(dladdr((void*)fn, &din) == 0 || din.dli_sname == NULL)
+    return none;
   return din.dli_sname;
 }
 
@@ -221,7 +424,7 @@ static const char* lookup_function_name(uint64_t fn) {
 
 static const char *none = "(none)";
 
-const char* lookup_function_name(uint64_t fn) {
+static const char* lookup_function_name(uint64_t fn) {
   (void)fn;
   return none;
 }
@@ -275,3 +478,15 @@ uint64_t* dumpi_profile_unique_addresses(void) {
   data_map_keys(keys + curr);
   return keys;
 }
+
+/*
+ * Resolve the names for a list of addresses in one pass.
+ */
+char** dumpi_profile_function_names(int count, const uint64_t *addresses) {
+  int i;
+  char **names = NULL;
+  assert((names = (char**)calloc(count + 1, sizeof(char*))) != NULL);
+  for(i = 0; i < count; ++i)
+    assert((names[i] = strdup(dumpi_function_name(addresses[i]))) != NULL);
+  return names;
+}
@@ -77,6 +77,30 @@ extern "C" {
   
 #endif /* ! DUMPI_ENABLE_INSTRUMENTATION */
 
+  /**
+   * Only trace user functions down to the given call depth
+   * (counted per thread).  A depth of zero (the default) means no limit.
+   * Calls below the limit are skipped before any timers are read.
+   */
+  void DUMPI_SKIP_INSTRUMENTING libdumpi_set_call_depth_limit(int depth);
+
+  /**
+   * Only trace user functions whose entry address lies in [lo, hi).
+   * May be called several times; if no ranges are given, all
+   * instrumented functions are traced.
+   * Should be called before the first instrumented function is entered.
+   */
+  void DUMPI_SKIP_INSTRUMENTING
+  libdumpi_add_call_range(uint64_t lo, uint64_t hi);
+
+  /**
+   * Only trace the named user function (in addition to any other
+   * ranges or symbols given).  The symbol is resolved once using dlsym,
+   * so this only works on systems that support dladdr.
+   * \return 1 if the symbol was found, 0 otherwise.
+   */
+  int DUMPI_SKIP_INSTRUMENTING libdumpi_add_call_symbol(const char *symbol);
+
   /**
    * Insert an arbitrary annotation.
    */
@@ -106,6 +130,15 @@ extern "C" {
    */
   uint64_t* DUMPI_SKIP_INSTRUMENTING dumpi_profile_unique_addresses(void);
 
+  /**
+   * Look up names for count addresses (as returned by
+   * dumpi_profile_unique_addresses) in a single pass.
+   * Addresses that cannot be resolved get the name "(none)".
+   * The caller is responsible for freeing each string and the array.
+   */
+  char** DUMPI_SKIP_INSTRUMENTING
+  dumpi_profile_function_names(int count, const uint64_t *addresses);
+
   /*@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,131 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/libdumpi/callstats.h>
+#include <dumpi/common/gettime.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* Each thread's table is also kept on a list so that it can be merged
+ * (and is not lost) after the thread exits. */
+typedef struct callstats_table {
+  dumpi_callstats stats;
+  struct callstats_table *next;
+} callstats_table;
+
+static callstats_table *tables_ = NULL;
+
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+
+static pthread_mutex_t tables_lock_ = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t table_key_;
+static pthread_once_t table_once_ = PTHREAD_ONCE_INIT;
+
+static void table_key_init(void) {
+  assert(pthread_key_create(&table_key_, NULL) == 0);
+}
+
+static dumpi_callstats* get_table(void) {
+  callstats_table *table;
+  pthread_once(&table_once_, table_key_init);
+  table = (callstats_table*)pthread_getspecific(table_key_);
+  if(table == NULL) {
+    assert((table = (callstats_table*)
+            calloc(1, sizeof(callstats_table))) != NULL);
+    assert(pthread_mutex_lock(&tables_lock_) == 0);
+    table->next = tables_;
+    tables_ = table;
+    assert(pthread_mutex_unlock(&tables_lock_) == 0);
+    assert(pthread_setspecific(table_key_, table) == 0);
+  }
+  return &table->stats;
+}
+
+#else /* ! DUMPI_USE_PTHREADS */
+
+static callstats_table table_;
+
+static dumpi_callstats* get_table(void) {
+  tables_ = &table_;
+  return &table_.stats;
+}
+
+#endif /* ! DUMPI_USE_PTHREADS */
+
+void libdumpi_record_call(dumpi_function fn, uint64_t start, uint64_t bytes) {
+  uint64_t elapsed = dumpi_get_wall_ns() - start;
+  dumpi_callstats_entry *entry;
+  assert(fn >= 0 && fn < DUMPI_ALL_FUNCTIONS);
+  entry = &get_table()->entry[fn];
+  if(entry->count == 0 || elapsed < entry->min_ns)
+    entry->min_ns = elapsed;
+  if(elapsed > entry->max_ns)
+    entry->max_ns = elapsed;
+  ++entry->count;
+  entry->total_ns += elapsed;
+  entry->bytes += bytes;
+  ++entry->time_hist[dumpi_callstats_bucket(elapsed)];
+  ++entry->size_hist[dumpi_callstats_bucket(bytes)];
+}
+
+void libdumpi_merge_callstats(dumpi_callstats *stats) {
+  int fn;
+  callstats_table *table;
+  assert(stats != NULL);
+  memset(stats, 0, sizeof(dumpi_callstats));
+#ifdef DUMPI_USE_PTHREADS
+  assert(pthread_mutex_lock(&tables_lock_) == 0);
+#endif /* ! DUMPI_USE_PTHREADS */
+  for(table = tables_; table != NULL; table = table->next) {
+    ++stats->threads;
+    for(fn = 0; fn < DUMPI_ALL_FUNCTIONS; ++fn)
+      dumpi_merge_callstats_entry(&stats->entry[fn], &table->stats.entry[fn]);
+  }
+#ifdef DUMPI_USE_PTHREADS
+  assert(pthread_mutex_unlock(&tables_lock_) == 0);
+#endif /* ! DUMPI_USE_PTHREADS */
+}
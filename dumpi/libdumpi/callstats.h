@@ -0,0 +1,85 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_LIBDUMPI_CALLSTATS_H
+#define DUMPI_LIBDUMPI_CALLSTATS_H
+
+#include <dumpi/common/types.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \ingroup libdumpi_internal
+   * \defgroup libdumpi_internal_callstats libdumpi/internal/callstats: \
+   *    In-memory call statistics for profile-only mode.
+   */
+  /*@{*/
+
+  /**
+   * Account for one completed MPI call in this thread's statistics.
+   * Each thread updates a table of its own, so no locking is needed
+   * after the table is first created.
+   * \param fn     The function that was called.
+   * \param start  Wall time at entry (from dumpi_get_wall_ns).
+   * \param bytes  Message payload of the call (0 if it has none).
+   */
+  void libdumpi_record_call(dumpi_function fn, uint64_t start, uint64_t bytes);
+
+  /**
+   * Merge the statistics of all threads into stats (which gets cleared
+   * first).  Should only be called once the other threads are done
+   * with MPI, typically from MPI_Finalize.
+   */
+  void libdumpi_merge_callstats(dumpi_callstats *stats);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" block */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_CALLSTATS_H */
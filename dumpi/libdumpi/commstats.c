@@ -0,0 +1,333 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/libdumpi/commstats.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/hashmap.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* Map communicators, peer ranks and collective communicators to slots */
+DUMPI_DECLARE_HASHMAP(cmx_comm, MPI_Comm, int)
+DUMPI_DECLARE_HASHMAP(cmx_peer, int32_t, int)
+DUMPI_DECLARE_HASHMAP(cmx_coll, uint64_t, int)
+
+/* Cached translation from communicator ranks to MPI_COMM_WORLD ranks */
+typedef struct comm_ranks {
+  int size, leader;
+  int *world;
+} comm_ranks;
+
+/* Each thread keeps its own row of the matrix.  As with the call
+ * statistics, tables are also kept on a list so that they can be merged
+ * after the thread exits. */
+typedef struct commstats_table {
+  unsigned epoch;
+  dumpi_hm_cmx_comm *comm_map;
+  comm_ranks *comm;
+  int comms, comm_cap;
+  dumpi_hm_cmx_peer *peer_map;
+  dumpi_commpeer *peer;
+  int peers, peer_cap;
+  dumpi_hm_cmx_coll *coll_map;
+  dumpi_commcoll *coll;
+  int colls, coll_cap;
+  struct commstats_table *next;
+} commstats_table;
+
+static commstats_table *tables_ = NULL;
+
+/* Bumped whenever a communicator is freed */
+static volatile unsigned epoch_ = 0;
+
+static void init_table(commstats_table *table) {
+  dumpi_hm_cmx_comm_init(&table->comm_map, 0);
+  dumpi_hm_cmx_peer_init(&table->peer_map, 0);
+  dumpi_hm_cmx_coll_init(&table->coll_map, 0);
+}
+
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+
+static pthread_mutex_t tables_lock_ = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t table_key_;
+static pthread_once_t table_once_ = PTHREAD_ONCE_INIT;
+
+static void table_key_init(void) {
+  assert(pthread_key_create(&table_key_, NULL) == 0);
+}
+
+static commstats_table* get_table(void) {
+  commstats_table *table;
+  pthread_once(&table_once_, table_key_init);
+  table = (commstats_table*)pthread_getspecific(table_key_);
+  if(table == NULL) {
+    assert((table = (commstats_table*)
+            calloc(1, sizeof(commstats_table))) != NULL);
+    init_table(table);
+    assert(pthread_mutex_lock(&tables_lock_) == 0);
+    table->next = tables_;
+    tables_ = table;
+    assert(pthread_mutex_unlock(&tables_lock_) == 0);
+    assert(pthread_setspecific(table_key_, table) == 0);
+  }
+  return table;
+}
+
+#else /* ! DUMPI_USE_PTHREADS */
+
+static commstats_table table_;
+
+static commstats_table* get_table(void) {
+  if(tables_ == NULL) {
+    init_table(&table_);
+    tables_ = &table_;
+  }
+  return &table_;
+}
+
+#endif /* ! DUMPI_USE_PTHREADS */
+
+/* Grow an array of elements of the given size to hold at least count */
+static void* reserve(void *arr, int *cap, int count, size_t size) {
+  if(count > *cap) {
+    *cap = (*cap ? 2 * *cap : 16);
+    if(*cap < count) *cap = count;
+    assert((arr = realloc(arr, *cap * size)) != NULL);
+  }
+  return arr;
+}
+
+/* Drop all cached translations */
+static void flush_comms(commstats_table *table) {
+  int i;
+  for(i = 0; i < table->comms; ++i)
+    free(table->comm[i].world);
+  table->comms = 0;
+  dumpi_hm_cmx_comm_free(&table->comm_map);
+  dumpi_hm_cmx_comm_init(&table->comm_map, 0);
+  table->epoch = epoch_;
+}
+
+/* Build the world rank translation for a communicator.  Point-to-point
+ * ranks on an intercommunicator refer to the remote group. */
+static void translate_comm(MPI_Comm comm, comm_ranks *ranks) {
+  int i, inter = 0;
+  int *local;
+  MPI_Group group, world;
+  PMPI_Comm_test_inter(comm, &inter);
+  if(inter)
+    PMPI_Comm_remote_group(comm, &group);
+  else
+    PMPI_Comm_group(comm, &group);
+  PMPI_Comm_group(MPI_COMM_WORLD, &world);
+  PMPI_Group_size(group, &ranks->size);
+  assert((local = (int*)malloc((ranks->size+1) * sizeof(int))) != NULL);
+  assert((ranks->world = (int*)malloc((ranks->size+1) * sizeof(int))) != NULL);
+  for(i = 0; i < ranks->size; ++i)
+    local[i] = i;
+  PMPI_Group_translate_ranks(group, ranks->size, local, world, ranks->world);
+  ranks->leader = (ranks->size > 0 ? ranks->world[0] : -1);
+  PMPI_Group_free(&group);
+  PMPI_Group_free(&world);
+  free(local);
+}
+
+static const comm_ranks* get_comm(commstats_table *table, MPI_Comm comm) {
+  int slot;
+  if(table->epoch != epoch_)
+    flush_comms(table);
+  slot = dumpi_hm_cmx_comm_get(table->comm_map, comm);
+  if(slot == table->comms) {
+    table->comm = (comm_ranks*)reserve(table->comm, &table->comm_cap,
+                                       table->comms+1, sizeof(comm_ranks));
+    translate_comm(comm, &table->comm[slot]);
+    ++table->comms;
+  }
+  return &table->comm[slot];
+}
+
+static uint64_t message_bytes(int count, MPI_Datatype type) {
+  int size = 0;
+  if(count <= 0 || type == MPI_DATATYPE_NULL)
+    return 0;
+  PMPI_Type_size(type, &size);
+  return (uint64_t)count * size;
+}
+
+void libdumpi_record_send(int dest, int count, MPI_Datatype type,
+                          MPI_Comm comm)
+{
+  int slot, peer;
+  commstats_table *table;
+  const comm_ranks *ranks;
+  if(dest == MPI_PROC_NULL || dest < 0 || comm == MPI_COMM_NULL)
+    return;
+  table = get_table();
+  if(comm == MPI_COMM_WORLD) {
+    if(dest >= dumpi_global->comm_size)
+      return;
+    peer = dest;
+  }
+  else {
+    ranks = get_comm(table, comm);
+    if(dest >= ranks->size)
+      return;
+    peer = ranks->world[dest];
+    if(peer == MPI_UNDEFINED)
+      return;
+  }
+  slot = dumpi_hm_cmx_peer_get(table->peer_map, peer);
+  if(slot == table->peers) {
+    table->peer = (dumpi_commpeer*)reserve(table->peer, &table->peer_cap,
+                                           table->peers+1,
+                                           sizeof(dumpi_commpeer));
+    memset(&table->peer[slot], 0, sizeof(dumpi_commpeer));
+    table->peer[slot].peer = peer;
+    ++table->peers;
+  }
+  ++table->peer[slot].messages;
+  table->peer[slot].bytes += message_bytes(count, type);
+}
+
+void libdumpi_record_collective(MPI_Comm comm, int count, MPI_Datatype type)
+{
+  int slot, size, leader;
+  commstats_table *table;
+  const comm_ranks *ranks;
+  if(comm == MPI_COMM_NULL)
+    return;
+  table = get_table();
+  if(comm == MPI_COMM_WORLD) {
+    size = dumpi_global->comm_size;
+    leader = 0;
+  }
+  else {
+    ranks = get_comm(table, comm);
+    size = ranks->size;
+    leader = ranks->leader;
+  }
+  slot = dumpi_hm_cmx_coll_get(table->coll_map,
+                               ((uint64_t)(uint32_t)size << 32) |
+                               (uint32_t)leader);
+  if(slot == table->colls) {
+    table->coll = (dumpi_commcoll*)reserve(table->coll, &table->coll_cap,
+                                           table->colls+1,
+                                           sizeof(dumpi_commcoll));
+    memset(&table->coll[slot], 0, sizeof(dumpi_commcoll));
+    table->coll[slot].size = size;
+    table->coll[slot].leader = leader;
+    ++table->colls;
+  }
+  ++table->coll[slot].calls;
+  table->coll[slot].bytes += message_bytes(count, type);
+}
+
+void libdumpi_forget_comms(void) {
+  ++epoch_;
+}
+
+static int compare_peers(const void *a, const void *b) {
+  const dumpi_commpeer *pa = (const dumpi_commpeer*)a;
+  const dumpi_commpeer *pb = (const dumpi_commpeer*)b;
+  return (pa->peer > pb->peer) - (pa->peer < pb->peer);
+}
+
+void libdumpi_merge_commstats(dumpi_commstats *stats) {
+  int i, slot;
+  commstats_table *table;
+  dumpi_hm_cmx_peer *peer_map;
+  dumpi_hm_cmx_coll *coll_map;
+  int peer_cap = 0, coll_cap = 0;
+  assert(stats != NULL);
+  memset(stats, 0, sizeof(dumpi_commstats));
+  stats->rank = dumpi_global->comm_rank;
+  dumpi_hm_cmx_peer_init(&peer_map, 0);
+  dumpi_hm_cmx_coll_init(&coll_map, 0);
+#ifdef DUMPI_USE_PTHREADS
+  assert(pthread_mutex_lock(&tables_lock_) == 0);
+#endif /* ! DUMPI_USE_PTHREADS */
+  for(table = tables_; table != NULL; table = table->next) {
+    for(i = 0; i < table->peers; ++i) {
+      const dumpi_commpeer *src = &table->peer[i];
+      slot = dumpi_hm_cmx_peer_get(peer_map, src->peer);
+      if(slot == stats->peers) {
+        stats->peer = (dumpi_commpeer*)reserve(stats->peer, &peer_cap,
+                                               stats->peers+1,
+                                               sizeof(dumpi_commpeer));
+        memset(&stats->peer[slot], 0, sizeof(dumpi_commpeer));
+        stats->peer[slot].peer = src->peer;
+        ++stats->peers;
+      }
+      stats->peer[slot].messages += src->messages;
+      stats->peer[slot].bytes += src->bytes;
+    }
+    for(i = 0; i < table->colls; ++i) {
+      const dumpi_commcoll *src = &table->coll[i];
+      slot = dumpi_hm_cmx_coll_get(coll_map,
+                                   ((uint64_t)(uint32_t)src->size << 32) |
+                                   (uint32_t)src->leader);
+      if(slot == stats->colls) {
+        stats->coll = (dumpi_commcoll*)reserve(stats->coll, &coll_cap,
+                                               stats->colls+1,
+                                               sizeof(dumpi_commcoll));
+        memset(&stats->coll[slot], 0, sizeof(dumpi_commcoll));
+        stats->coll[slot].size = src->size;
+        stats->coll[slot].leader = src->leader;
+        ++stats->colls;
+      }
+      stats->coll[slot].calls += src->calls;
+      stats->coll[slot].bytes += src->bytes;
+    }
+  }
+#ifdef DUMPI_USE_PTHREADS
+  assert(pthread_mutex_unlock(&tables_lock_) == 0);
+#endif /* ! DUMPI_USE_PTHREADS */
+  dumpi_hm_cmx_peer_free(&peer_map);
+  dumpi_hm_cmx_coll_free(&coll_map);
+  if(stats->peers > 1)
+    qsort(stats->peer, stats->peers, sizeof(dumpi_commpeer), compare_peers);
+}
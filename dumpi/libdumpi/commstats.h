@@ -0,0 +1,97 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_LIBDUMPI_COMMSTATS_H
+#define DUMPI_LIBDUMPI_COMMSTATS_H
+
+#include <dumpi/common/types.h>
+#include <mpi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \ingroup libdumpi_internal
+   * \defgroup libdumpi_internal_commstats libdumpi/internal/commstats: \
+   *    In-memory communication matrix.
+   */
+  /*@{*/
+
+  /**
+   * Account for a point-to-point send in this thread's matrix row.
+   * The destination is translated to its MPI_COMM_WORLD rank using a
+   * per-thread cache of communicator rank translations.
+   * Sends to MPI_PROC_NULL are ignored.
+   */
+  void libdumpi_record_send(int dest, int count, MPI_Datatype type,
+                            MPI_Comm comm);
+
+  /**
+   * Account for a collective call on comm (count elements of type).
+   */
+  void libdumpi_record_collective(MPI_Comm comm, int count,
+                                  MPI_Datatype type);
+
+  /**
+   * Invalidate the cached rank translations when a communicator is freed
+   * (the handle may get reused for a different communicator).
+   */
+  void libdumpi_forget_comms(void);
+
+  /**
+   * Merge the matrix rows of all threads into stats (which gets cleared
+   * first).  Should only be called once the other threads are done
+   * with MPI, typically from MPI_Finalize.
+   * The caller must release the arrays using dumpi_clear_commstats.
+   */
+  void libdumpi_merge_commstats(dumpi_commstats *stats);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" block */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_COMMSTATS_H */
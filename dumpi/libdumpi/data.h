@@ -50,6 +50,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/common/io.h>
 #include <dumpi/common/constants.h>
 #include <dumpi/dumpiconfig.h>
+#include <time.h>
 
 #ifdef DUMPI_USE_PTHREADS
 #include <pthread.h>
@@ -101,6 +102,22 @@ extern "C" {
     const char          *output_file; /*fully qualified name*/
     int                  comm_rank;   /* MPI communicator rank. */
     int                  comm_size;   /* MPI communicator size. */
+    /* Aggregate call statistics instead of writing per-call records. */
+    int                  profile_only;
+    /* Keep a rank-to-rank communication matrix (-1 until configured). */
+    int                  comm_matrix;
+    /* Checkpoint the trace at buffer flushes (-1 until configured),
+     * and also every checkpoint_interval seconds if that is positive. */
+    int                  checkpoint;
+    int                  checkpoint_interval;
+    time_t               last_checkpoint;
+    /* Spread the trace files over this many subdirectories (0: none). */
+    int                  fanout;
+    /* Set while the configuration file is still to be read (it is read
+     * once MPI is initialized, see libdumpi_open_files). */
+    int                  config_pending;
+    /* Records written so far (counted under the io lock). */
+    uint64_t             records;
   } dumpi_global_t;
 
   /**
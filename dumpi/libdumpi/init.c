@@ -45,6 +45,8 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/libdumpi/init.h>
 #include <dumpi/libdumpi/data.h>
 #include <dumpi/libdumpi/callprofile.h>
+#include <dumpi/libdumpi/callstats.h>
+#include <dumpi/libdumpi/commstats.h>
 #include <dumpi/libdumpi/mpibindings-maps.h>
 #include <dumpi/common/perfctrtags.h>
 #include <dumpi/common/perfctrs.h>
@@ -54,6 +56,8 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/common/gettime.h>
 #include <mpi.h>
 #include <unistd.h>
+#include <sys/stat.h>
+#include <errno.h>
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
@@ -81,10 +85,14 @@ static void dumpi_setup(void);
 static void dumpi_finish_profiling(void);
 static void init_global_output(void);
 static void default_config(void);
-static void read_config(FILE* fp);
+static char* read_config_file(void);
+static char* broadcast_config(void);
+static void parse_config(char *text);
+static void apply_config(char *text);
 static void open_output_file(void);
 static void process_keyval(const char *key, const char *value);
 static void create_meta_file(void);
+static void write_checkpoint(void);
 
 
 /****************************************************/
@@ -99,8 +107,7 @@ void libdumpi_init(void) {
   if(dumpi_debug & DUMPI_DEBUG_LIBDUMPI)
     fprintf(stderr, "[DUMPI-LIBDUMPI]: libdumpi_init entering\n");
   if(dumpi_global == NULL) {
-    char *dumpiconf;
-    FILE *fp;
+    int mpi_active;
 #ifdef DUMPI_USE_PTHREADS
     if(init_lock == NULL) {
       init_lock = (pthread_mutex_t*)malloc(sizeof(pthread_mutex_t));
@@ -110,19 +117,14 @@ void libdumpi_init(void) {
     DUMPI_LOCK_MUTEX;
     /* Initialize storage */
     dumpi_setup();
-    /* Read in dumpi configuration (if available) */
-    dumpiconf = getenv("DUMPI_CONF");
-    if(dumpiconf && ((fp = fopen(dumpiconf, "r")) != NULL)) {
-      read_config(fp);
-    }
-    else if((fp = fopen("dumpi.conf", "r")) != NULL) {
-      read_config(fp);
-    }
-    /* Set any undefined configuration options to a reasonable value */
-    default_config();
-    /* and initialize PAPI stuff (if requested and supported) */
-    assert(dumpi_global != NULL);
-    dumpi_init_perfctrs(dumpi_global->perf);
+    /* Read in dumpi configuration (if available).  We normally get here
+     * from MPI_Init, and then wait until MPI is up so that only rank 0
+     * has to read the file (see libdumpi_open_files). */
+    PMPI_Initialized(&mpi_active);
+    if(mpi_active)
+      apply_config(read_config_file());
+    else
+      dumpi_global->config_pending = 1;
     /* Finally, initialize the profile but leave the file unopened */
     {
       dumpi_clock cpu, wall;
@@ -142,6 +144,8 @@ void libdumpi_init(void) {
 /*
  * Open output files (each node creates its onw dump file;
  * node 0 also creates a human-readable metafile to describe the simulation).
+ * If the configuration has not been read yet, rank 0 reads it now and
+ * broadcasts it, so this has to be called by all ranks.
  *
  * Note that in a parallel run (if size > 0), node 0 broadcasts
  * its start time (as stored in dumpi_global::header::starttime)
@@ -159,6 +163,8 @@ void libdumpi_open_files(void) {
     fprintf(stderr, "libdumpi_open_files:  Error:  MPI is not initialized.");
     abort();
   }
+  if(dumpi_global->config_pending)
+    apply_config(broadcast_config());
   open_output_file();
   /* dumpi_start_stream_write(dumpi_global->profile); */
   create_meta_file();
@@ -216,6 +222,8 @@ void dumpi_setup() {
     assert(pthread_mutex_init(&dumpi_global->mutex, NULL) == 0);
 #endif /* ! DUMPI_USE_PTHREADS */
     dumpi_global->comm_rank = -getpid();
+    dumpi_global->comm_matrix = -1;
+    dumpi_global->checkpoint = -1;
   }
   if(! dumpi_global->output) {
     init_global_output();
@@ -255,6 +263,19 @@ void dumpi_finish_profiling(void) {
     fprintf(stderr, "[DUMPI-LIBDUMPI]: dumpi_finish_profiling entering\n");  
   dumpi_write_header(dumpi_global->profile, dumpi_global->header);
   dumpi_write_footer(dumpi_global->profile, dumpi_global->footer);
+  if(dumpi_global->profile_only) {
+    dumpi_callstats *stats = (dumpi_callstats*)malloc(sizeof(dumpi_callstats));
+    assert(stats != NULL);
+    libdumpi_merge_callstats(stats);
+    dumpi_write_callstats(dumpi_global->profile, stats);
+    dumpi_free_callstats(stats);
+  }
+  if(dumpi_global->comm_matrix) {
+    dumpi_commstats matrix;
+    libdumpi_merge_commstats(&matrix);
+    dumpi_write_commstats(dumpi_global->profile, &matrix);
+    dumpi_clear_commstats(&matrix);
+  }
   dumpi_write_keyval_record(dumpi_global->profile, dumpi_global->keyval);
   dumpi_write_perfctr_labels(dumpi_global->profile,
 			     dumpi_active_perfctrs(), dumpi_perfctr_labels());
@@ -262,10 +283,7 @@ void dumpi_finish_profiling(void) {
   /* Need to add an index entry in the same way as for perfctr labels */
   addr_count = dumpi_profile_unique_address_count();
   addrs = dumpi_profile_unique_addresses();
-  names = (char**)calloc(addr_count+1, sizeof(const char*));
-  assert(names != NULL);
-  for(i = 0; i < addr_count; ++i)
-    names[i] = strdup(dumpi_function_name(addrs[i]));
+  names = dumpi_profile_function_names(addr_count, addrs);
   dumpi_write_function_addresses(dumpi_global->profile, 
 				 addr_count, addrs, names);
   free(addrs);
@@ -287,6 +305,12 @@ void default_config(void) {
     dumpi_global->output->timestamps = DUMPI_TIME_FULL;
   if(dumpi_global->output->statuses < 0)
     dumpi_global->output->statuses = DUMPI_ENABLE;
+  /* The matrix is cheap next to a full trace, but mostly useful without one */
+  if(dumpi_global->comm_matrix < 0)
+    dumpi_global->comm_matrix = dumpi_global->profile_only;
+  /* Readers that predate checkpoint records cannot skip them */
+  if(dumpi_global->checkpoint < 0)
+    dumpi_global->checkpoint = 0;
   if(dumpi_global->output->function[DUMPI_ALL_FUNCTIONS] < 0)
     dumpi_global->output->function[DUMPI_ALL_FUNCTIONS] = DUMPI_ENABLE;
   for(fun = 0; fun < DUMPI_ALL_FUNCTIONS; ++fun)
@@ -296,51 +320,151 @@ void default_config(void) {
   dumpi_global->output->function[DUMPI_ALL_FUNCTIONS] = DUMPI_ENABLE;
 }
 
-void read_config(FILE* fp) {
-#define DUMPI_BUZ 1024
-  int i, len;
-  char buffer[DUMPI_BUZ];
-  char strtok_buf[DUMPI_BUZ];
-  char *sbp;
-  char *key, *value;
-  buffer[DUMPI_BUZ-1] = '\0';
-  sbp = strtok_buf;
-  while(! feof(fp)) {
-    if(fgets(buffer, DUMPI_BUZ, fp) == 0) {
-      break;
+/*
+ * Read the whole configuration file ($DUMPI_CONF or ./dumpi.conf).
+ * Returns NULL if there is none.
+ */
+char* read_config_file(void) {
+  const char *dumpiconf = getenv("DUMPI_CONF");
+  FILE *fp = NULL;
+  char *text = NULL;
+  size_t len = 0, cap = 0, got;
+  if(dumpiconf)
+    fp = fopen(dumpiconf, "r");
+  if(fp == NULL)
+    fp = fopen("dumpi.conf", "r");
+  if(fp == NULL)
+    return NULL;
+  do {
+    if(cap - len < 1024) {
+      cap = (cap ? 2*cap : 4096);
+      text = (char*)realloc(text, cap);
+      assert(text != NULL);
     }
-    /* fprintf(stderr, "DEBUG:  input line %s\n", buffer); */
-    len = strlen(buffer);
-    /* Trim out comments */
-    for(i = 0; i < len; ++i) {
-      if(buffer[i] == '#' || buffer[i] == '\n') {
-	buffer[i] = '\0';
-	break;
+    got = fread(text+len, 1, cap-len-1, fp);
+    len += got;
+  } while(got > 0);
+  text[len] = '\0';
+  fclose(fp);
+  return text;
+}
+
+/*
+ * Read the configuration on rank 0 and broadcast it, so that starting
+ * a large job does not have every rank open the same file.
+ */
+char* broadcast_config(void) {
+  int rank, size, len = 0;
+  char *text = NULL;
+  PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  PMPI_Comm_size(MPI_COMM_WORLD, &size);
+  if(rank == 0) {
+    text = read_config_file();
+    if(text != NULL)
+      len = strlen(text) + 1;
+  }
+  if(size > 1) {
+    assert(PMPI_Bcast(&len, 1, MPI_INT, 0, MPI_COMM_WORLD) == MPI_SUCCESS);
+    if(len > 0) {
+      if(rank != 0) {
+	text = (char*)malloc(len);
+	assert(text != NULL);
       }
+      assert(PMPI_Bcast(text, len, MPI_CHAR, 0, MPI_COMM_WORLD) == MPI_SUCCESS);
     }
+  }
+  return text;
+}
+
+/*
+ * Process the "key value" lines of a configuration (modifies text).
+ */
+void parse_config(char *text) {
+  char *line, *key, *value, *lines, *tokens;
+  for(line = strtok_r(text, "\n", &lines); line != NULL;
+      line = strtok_r(NULL, "\n", &lines))
+  {
+    /* Trim out comments */
+    line[strcspn(line, "#")] = '\0';
     /* Tokenize */
-    key = strtok_r(buffer, " \t=", &sbp);
+    key = strtok_r(line, " \t=", &tokens);
     if(key) {
-      value = strtok_r(NULL, " \t=", &sbp);
+      value = strtok_r(NULL, " \t=", &tokens);
       if(value)
 	process_keyval(key, value);
     }
   }
 }
 
+/*
+ * Apply a configuration (NULL if there is none), set any undefined
+ * options to a reasonable value, and initialize PAPI stuff (if requested
+ * and supported).
+ */
+void apply_config(char *text) {
+  if(text != NULL) {
+    parse_config(text);
+    free(text);
+  }
+  default_config();
+  dumpi_init_perfctrs(dumpi_global->perf);
+  dumpi_global->config_pending = 0;
+}
+
+/*
+ * The name root (before the rank) shared by all files of a run started
+ * at the given time.
+ */
+static char* stamped_root(long rank0time) {
+  const char *tmpfroot;
+  char *scratch;
+  int count;
+  time_t thetime;
+  struct tm loct;
+  if(dumpi_global->file_root == NULL) {
+    tmpfroot = "dumpi";
+  }
+  else {
+    tmpfroot = dumpi_global->file_root;
+  }
+  count = strlen(tmpfroot) + 30;
+  scratch = (char*)malloc(count); scratch[count-1] = '\0';
+  thetime = rank0time;
+  localtime_r(&thetime, &loct);
+  snprintf(scratch, count-1, "%s-%04d.%02d.%02d.%02d.%02d.%02d",
+	   tmpfroot, loct.tm_year+1900, loct.tm_mon+1, loct.tm_mday,
+	   loct.tm_hour, loct.tm_min, loct.tm_sec);
+  return scratch;
+}
+
+/*
+ * Create the subdirectories the trace files get spread over.
+ */
+static void create_trace_dirs(const char *root, int fanout) {
+  int bucket, len = strlen(root) + 16;
+  char *dir = (char*)malloc(len);
+  assert(dir != NULL);
+  for(bucket = -1; bucket < fanout; ++bucket) {
+    dumpi_trace_dirname(dir, len, root, bucket);
+    if(mkdir(dir, 0777) != 0 && errno != EEXIST) {
+      fprintf(stderr, "dumpi:  Failed to create trace directory %s: %s\n",
+	      dir, strerror(errno));
+      abort();
+    }
+  }
+  free(dir);
+}
+
 void open_output_file(void) {
   int mpi_initialized;
   int count;
   char *fname;
-  const char *tmpfroot;
   char *scratch;
   long rank0time;
-  time_t thetime;
   /*
   char scratchcwd[512];
   char *cwd;
   */
-  struct tm loct;
   assert(dumpi_global != NULL);
   assert(dumpi_global->header != NULL);
   rank0time = dumpi_global->header->starttime;
@@ -353,22 +477,17 @@ void open_output_file(void) {
     dumpi_global->comm_rank = 0;
     dumpi_global->comm_size = 1;
   }
+  if(dumpi_global->comm_rank == 0 && dumpi_global->fanout > 0) {
+    /* The broadcast below keeps the other ranks from creating their
+       files before the directories exist */
+    scratch = stamped_root(rank0time);
+    create_trace_dirs(scratch, dumpi_global->fanout);
+    free(scratch);
+  }
   if(dumpi_global->comm_size > 1) {
     assert(PMPI_Bcast(&rank0time,1,MPI_LONG,0,MPI_COMM_WORLD) == MPI_SUCCESS);
   }
-  if(dumpi_global->file_root == NULL) {
-    tmpfroot = "dumpi";
-  }
-  else {
-    tmpfroot = dumpi_global->file_root;
-  }
-  count = strlen(tmpfroot) + 30;
-  scratch = (char*)malloc(count); scratch[count-1] = '\0';
-  thetime = rank0time;
-  localtime_r(&thetime, &loct);
-  snprintf(scratch, count-1, "%s-%04d.%02d.%02d.%02d.%02d.%02d",
-	   tmpfroot, loct.tm_year+1900, loct.tm_mon+1, loct.tm_mday,
-	   loct.tm_hour, loct.tm_min, loct.tm_sec);
+  scratch = stamped_root(rank0time);
   if(dumpi_global->file_root) {
     free((void*)dumpi_global->file_root);
   }
@@ -377,21 +496,56 @@ void open_output_file(void) {
   cwd = getcwd(scratchcwd, 512);
   count = (cwd ? strlen(cwd)+1 : 0) + strlen(dumpi_global->file_root) + 30;
   */
-  count = strlen(dumpi_global->file_root) + 30;
+  count = 2*strlen(dumpi_global->file_root) + 40;
   fname = (char*)malloc(count); fname[count-1] = '\0';
   /*
   snprintf(fname, count-1, "%s%s%s-%04d.bin",
 	   (cwd ? cwd : ""), (cwd ? "/" : ""), 
 	   dumpi_global->file_root, dumpi_global->comm_rank);
   */
-  snprintf(fname, count-1, "%s-%04d.bin",
-	   dumpi_global->file_root, dumpi_global->comm_rank);
+  dumpi_trace_filename(fname, count-1, dumpi_global->file_root,
+		       DUMPI_TRACE_WIDTH, dumpi_global->fanout,
+		       dumpi_global->comm_rank);
   dumpi_global->output_file = fname;
   
   dumpi_global->profile->file = dumpi_open_output_file(fname);
   assert(dumpi_global->profile->file != NULL);
   dumpi_global->keyval = dumpi_alloc_keyval_record();
   assert(dumpi_global->profile != NULL && dumpi_global->profile->file != NULL);
+  if(dumpi_global->checkpoint > 0) {
+    /* Make the trace readable from the start */
+    write_checkpoint();
+  }
+}
+
+/*
+ * Write a checkpoint and flush everything written so far.
+ */
+static void write_checkpoint(void) {
+  dumpi_clock cpu, wall;
+  dumpi_get_time(&cpu, &wall);
+  dumpi_write_checkpoint(dumpi_global->profile, dumpi_global->records, &wall);
+  dumpi_global->last_checkpoint = time(NULL);
+}
+
+void libdumpi_record_written(void) {
+  size_t used, length;
+  int due;
+  if(dumpi_global == NULL)
+    return;
+  ++dumpi_global->records;
+  if(dumpi_global->checkpoint <= 0 || dumpi_global->profile == NULL ||
+     dumpi_global->profile->file == NULL)
+    return;
+  /* Checkpoint before the buffer overflows, since that flush could
+   * split a record. */
+  dumpi_membuf_usage(dumpi_global->profile, &used, &length);
+  due = (length > 0 && used >= length - length/4);
+  if(! due && dumpi_global->checkpoint_interval > 0)
+    due = (time(NULL) - dumpi_global->last_checkpoint >=
+	   dumpi_global->checkpoint_interval);
+  if(due)
+    write_checkpoint();
 }
 
 dumpi_setting profiling_to_setting(const char *value) {
@@ -437,10 +591,11 @@ void process_keyval(const char *key, const char *value) {
     } 
   }
   /*
-   * Next test whether we are setting any of the PAPI flags.
+   * Next test whether we are setting any of the PAPI flags
+   * (perfctr is a synonym used with the perf_event backend).
    * We only set as many of those as will fit into dumpi_perfinfo::counter_tag
    */
-  if(strncmp(key, "PAPI", 4) == 0) {
+  if(strncmp(key, "PAPI", 4) == 0 || strcmp(key, "perfctr") == 0) {
     if(dumpi_global->perf->count < DUMPI_MAX_PERFCTRS) {
       assert(strlen(value) < DUMPI_MAX_PERFCTR_NAME);
       strcpy(dumpi_global->perf->counter_tag[dumpi_global->perf->count], value);
@@ -480,6 +635,30 @@ void process_keyval(const char *key, const char *value) {
     }
     return;
   }
+  /* Limit user function tracing to a maximum call depth. */
+  if(strcmp(key, "tracing_depth") == 0) {
+    libdumpi_set_call_depth_limit(atoi(value));
+    return;
+  }
+  /* Limit user function tracing to an address range (lo-hi). */
+  if(strcmp(key, "tracing_range") == 0) {
+    char *end = NULL;
+    uint64_t lo, hi;
+    lo = strtoull(value, &end, 0);
+    if(end == NULL || *end != '-') {
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid value %s\n",
+	      "tracing_range", value);
+      return;
+    }
+    hi = strtoull(end+1, NULL, 0);
+    libdumpi_add_call_range(lo, hi);
+    return;
+  }
+  /* Limit user function tracing to a named function. */
+  if(strcmp(key, "tracing_symbol") == 0) {
+    libdumpi_add_call_symbol(value);
+    return;
+  }
   /* OK, so let's see whether this is the status flag. */
   if(strcmp(key, "statuses") == 0) {
     if(dumpi_global->output->statuses < 0) {
@@ -498,6 +677,53 @@ void process_keyval(const char *key, const char *value) {
       return;
     }
   }
+  /* Write per-call records (trace) or only aggregate statistics (profile) */
+  if(strcmp(key, "mode") == 0) {
+    if(strcmp(value, "profile") == 0)
+      dumpi_global->profile_only = 1;
+    else if(strcmp(value, "trace") == 0)
+      dumpi_global->profile_only = 0;
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid value %s\n",
+	      "mode", value);
+    return;
+  }
+  /* Keep a rank-to-rank communication matrix in memory */
+  if(strcmp(key, "commmatrix") == 0) {
+    if(strcmp(value, "enable") == 0)
+      dumpi_global->comm_matrix = 1;
+    else if(strcmp(value, "disable") == 0)
+      dumpi_global->comm_matrix = 0;
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid value %s\n",
+	      "commmatrix", value);
+    return;
+  }
+  /* Checkpoint the trace at buffer flushes (and every N seconds) */
+  if(strcmp(key, "checkpoint") == 0) {
+    if(strcmp(value, "enable") == 0)
+      dumpi_global->checkpoint = 1;
+    else if(strcmp(value, "disable") == 0)
+      dumpi_global->checkpoint = 0;
+    else if(atoi(value) > 0) {
+      dumpi_global->checkpoint = 1;
+      dumpi_global->checkpoint_interval = atoi(value);
+    }
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid value %s\n",
+	      "checkpoint", value);
+    return;
+  }
+  /* Spread the trace files over subdirectories */
+  if(strcmp(key, "fanout") == 0) {
+    int fanout = atoi(value);
+    if(fanout >= 0 && fanout <= DUMPI_MAX_FANOUT)
+      dumpi_global->fanout = fanout;
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid value %s\n",
+	      "fanout", value);
+    return;
+  }
   /* The second-to-last option is the timestamp setting */
   if(strcmp(key, "timestamp") == 0) {
     if(dumpi_global->output->timestamps < 0) {
@@ -530,7 +756,9 @@ void process_keyval(const char *key, const char *value) {
 
 void create_meta_file(void) {
   char buffer[100];
-  
+
+  if(dumpi_global->comm_rank != 0)
+    return;
   sprintf(buffer, "%s.meta", dumpi_global->file_root);
   FILE *df = fopen(buffer, "w");
   assert(df != NULL);
@@ -540,6 +768,7 @@ void create_meta_file(void) {
   fprintf(df, "username=%s\n", dumpi_global->header->username);
   fprintf(df, "startime=%llu\n", (long long)dumpi_global->header->starttime);
   fprintf(df, "fileprefix=%s\n", dumpi_global->file_root);
+  fprintf(df, "fanout=%d\n", dumpi_global->fanout);
   fprintf(df, "version=%d\nsubversion=%d\nsubsubversion=%d\n", 
 	  dumpi_global->header->version[0], 
 	  dumpi_global->header->version[1], 
@@ -66,6 +66,8 @@ extern "C" {
 
   /**
    * Initialize storage and read in configuration file.
+   * If MPI is not initialized yet, reading the configuration is left
+   * to libdumpi_open_files.
    * 
    * Storage gets freed up automatically at exit.
    * This is a no-op if(dumpi_global != NULL).
@@ -79,6 +81,9 @@ extern "C" {
    * Note that in a parallel run (if MPI is initialized and MPI size > 0),
    * node 0 broadcasts its start time (as stored in
    * dumpi_global::header::starttime) to be used for all filenames.
+   * Rank 0 also reads the configuration file (if libdumpi_init left it
+   * unread) and broadcasts it to the other ranks, and creates the
+   * subdirectories for the trace files if a fanout is configured.
    *
    * This method updates at a large portion of dumpi_global (at least
    * dumpi_global::file_root, dumpi_global::output_file,
@@ -96,6 +101,14 @@ extern "C" {
    */
   void libdumpi_finalize(void);
 
+  /**
+   * Account for a record just written to the trace and, if the output
+   * buffer is getting full (or the checkpoint interval has passed),
+   * write a checkpoint record and flush the buffer.
+   * Must be called with the io lock held (see libdumpi_unlock_io).
+   */
+  void libdumpi_record_written(void);
+
   /*@}*/ /* close comment scope */
 
 #ifdef __cplusplus
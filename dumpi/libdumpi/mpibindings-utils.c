@@ -43,6 +43,7 @@ Questions? Contact sst-macro-help@sandia.gov
 */
 
 #include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/init.h>
 #include <dumpi/dumpiconfig.h>
 #include <stdlib.h>
 #include <assert.h>
@@ -87,6 +88,7 @@ int libdumpi_lock_io(void) {
 /* A global lock for io routines. */
 int libdumpi_unlock_io(void) {
   init_stuff();
+  libdumpi_record_written();
 #ifdef DUMPI_USE_PTHREADS
   assert(pthread_mutex_unlock(&lock) == 0);
 #endif
@@ -138,6 +140,8 @@ int libdumpi_lock_io(void) {
 
 /* A global lock for io routines. */
 int libdumpi_unlock_io(void) {
+  libdumpi_record_written();
+  return 1;
 }
 
 /* Get a unique thread index for this thread. */
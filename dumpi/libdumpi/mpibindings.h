@@ -49,6 +49,8 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/libdumpi/mpibindings-utils.h>
 #include <dumpi/libdumpi/init.h>
 #include <dumpi/libdumpi/data.h>
+#include <dumpi/libdumpi/callstats.h>
+#include <dumpi/libdumpi/commstats.h>
 #include <dumpi/common/gettime.h>
 #include <dumpi/common/perfctrs.h>
 #include <dumpi/common/types.h>
@@ -91,7 +93,9 @@ extern "C" {
   /** Common setup stuff used in all MPI_* functions.
    * This is an ugly side-effect of the auto-generated MPI bindings */
 #define DUMPI_INSERT_PREAMBLE(FUNC)					\
-  int profiling, call_depth;						\
+  int profiling, call_depth, aggregate;					\
+  uint64_t agg_start = 0, agg_bytes = 0;				\
+  const dumpi_function agg_func = FUNC;					\
   call_depth = libdumpi_enter_mpi();					\
   assert(call_depth > 0);						\
   if(dumpi_debug & DUMPI_DEBUG_MPICALLS)				\
@@ -107,11 +111,61 @@ extern "C" {
   assert(dumpi_global != NULL);						\
   profiling = (call_depth == 1) && DUMPI_PROFILING(FUNC);		\
   if(!profiling) DUMPI_INCREMENT_IGNORED(FUNC);				\
-  DUMPI_INCREMENT_CALLED(FUNC)
+  DUMPI_INCREMENT_CALLED(FUNC);						\
+  /* Profile-only mode times the call but writes no record for it */	\
+  aggregate = profiling && dumpi_global->profile_only;			\
+  if(aggregate) {							\
+    profiling = 0;							\
+    agg_start = dumpi_get_wall_ns();					\
+  }
+
+  /** Re-evaluate the preamble's profiling decision once the configuration
+   * has been read (MPI_Init and MPI_Init_thread enter before it is). */
+#define DUMPI_RECHECK_PROFILING(FUNC) do {				\
+    if(profiling && !DUMPI_PROFILING(FUNC)) {				\
+      profiling = 0;							\
+      DUMPI_INCREMENT_IGNORED(FUNC);					\
+    }									\
+    if(profiling && dumpi_global->profile_only) {			\
+      profiling = 0;							\
+      aggregate = 1;							\
+      agg_start = dumpi_get_wall_ns();					\
+    }									\
+} while(0)
+
+  /** Record the message payload of a call in profile-only mode.
+   * Placed right after DUMPI_INSERT_PREAMBLE for calls that move data. */
+#define DUMPI_AGGREGATE_BYTES(BUF, COUNT, TYPE) do {			\
+    if(aggregate && (BUF) != MPI_IN_PLACE && (COUNT) > 0 &&		\
+       (TYPE) != MPI_DATATYPE_NULL) {					\
+      int agg_typesize = 0;						\
+      PMPI_Type_size((TYPE), &agg_typesize);				\
+      agg_bytes = (uint64_t)(COUNT) * agg_typesize;			\
+    }									\
+} while(0)
+
+  /** Add a point-to-point send to the communication matrix. */
+#define DUMPI_RECORD_SEND(DEST, COUNT, TYPE, COMM) do {			\
+    if((profiling || aggregate) && dumpi_global->comm_matrix)		\
+      libdumpi_record_send((DEST), (COUNT), (TYPE), (COMM));		\
+} while(0)
+
+  /** Add a collective call to the communication matrix.
+   * In-place calls are counted, but without a payload. */
+#define DUMPI_RECORD_COLLECTIVE(COMM, BUF, COUNT, TYPE) do {		\
+    if((profiling || aggregate) && dumpi_global->comm_matrix) {		\
+      if((BUF) != MPI_IN_PLACE)						\
+	libdumpi_record_collective((COMM), (COUNT), (TYPE));		\
+      else								\
+	libdumpi_record_collective((COMM), 0, MPI_DATATYPE_NULL);	\
+    }									\
+} while(0)
 
   /** Common tear-down stuff used in all MPI_* functions.
    * Another ugly side effect of the auto-generated MPI bindings */
 #define DUMPI_INSERT_POSTAMBLE do {					\
+    if(aggregate)							\
+      libdumpi_record_call(agg_func, agg_start, agg_bytes);		\
     call_depth = libdumpi_exit_mpi();					\
     if(dumpi_debug & DUMPI_DEBUG_MPICALLS)				\
       fprintf(stderr, "[DUMPI-MPI] MPI call complete at call depth %d\n", call_depth); \
@@ -192,6 +192,8 @@ int MPI_Send(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_send));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Send);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Send);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -225,6 +227,7 @@ int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, M
   memset(&stat, 0, sizeof(dumpi_recv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Recv);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Recv);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -292,6 +295,8 @@ int MPI_Bsend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_bsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bsend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -325,6 +330,8 @@ int MPI_Ssend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_ssend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ssend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ssend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -358,6 +365,8 @@ int MPI_Rsend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_rsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Rsend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Rsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -449,6 +458,8 @@ int MPI_Isend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_isend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Isend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Isend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -483,6 +494,8 @@ int MPI_Ibsend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest
   memset(&stat, 0, sizeof(dumpi_ibsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ibsend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ibsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -517,6 +530,8 @@ int MPI_Issend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest
   memset(&stat, 0, sizeof(dumpi_issend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Issend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Issend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -551,6 +566,8 @@ int MPI_Irsend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest
   memset(&stat, 0, sizeof(dumpi_irsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Irsend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Irsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -585,6 +602,7 @@ int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag,
   memset(&stat, 0, sizeof(dumpi_irecv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Irecv);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Irecv);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1046,6 +1064,7 @@ int MPI_Send_init(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int d
   memset(&stat, 0, sizeof(dumpi_send_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Send_init);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Send_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1080,6 +1099,7 @@ int MPI_Bsend_init(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int
   memset(&stat, 0, sizeof(dumpi_bsend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bsend_init);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bsend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1114,6 +1134,7 @@ int MPI_Ssend_init(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int
   memset(&stat, 0, sizeof(dumpi_ssend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ssend_init);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ssend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1148,6 +1169,7 @@ int MPI_Rsend_init(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int
   memset(&stat, 0, sizeof(dumpi_rsend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Rsend_init);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Rsend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1182,6 +1204,7 @@ int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int t
   memset(&stat, 0, sizeof(dumpi_recv_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Recv_init);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Recv_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1276,6 +1299,8 @@ int MPI_Sendrecv(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype
   memset(&stat, 0, sizeof(dumpi_sendrecv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Sendrecv);
+  DUMPI_AGGREGATE_BYTES(sendbuf, sendcount, sendtype);
+  DUMPI_RECORD_SEND(dest, sendcount, sendtype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Sendrecv);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -1315,6 +1340,8 @@ int MPI_Sendrecv_replace(void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_sendrecv_replace));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Sendrecv_replace);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Sendrecv_replace);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1671,6 +1698,7 @@ int MPI_Barrier(MPI_Comm comm) {
   memset(&stat, 0, sizeof(dumpi_barrier));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Barrier);
+  DUMPI_RECORD_COLLECTIVE(comm, MPI_BOTTOM, 0, MPI_DATATYPE_NULL);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Barrier);
     DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
@@ -1700,6 +1728,8 @@ int MPI_Bcast(void *sendbuf, int count, MPI_Datatype datatype, int root, MPI_Com
   memset(&stat, 0, sizeof(dumpi_bcast));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bcast);
+  DUMPI_AGGREGATE_BYTES(sendbuf, count, datatype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bcast);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1734,6 +1764,8 @@ int MPI_Gather(DUMPI_CONST void *inbuf, int sendcount, MPI_Datatype sendtype, vo
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Gather);
+  DUMPI_AGGREGATE_BYTES(inbuf, sendcount, sendtype);
+  DUMPI_RECORD_COLLECTIVE(comm, inbuf, sendcount, sendtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Gather);
     PMPI_Comm_rank(comm, &commrank);
@@ -1773,6 +1805,8 @@ int MPI_Gatherv(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype,
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Gatherv);
+  DUMPI_AGGREGATE_BYTES(sendbuf, sendcount, sendtype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, sendcount, sendtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Gatherv);
     PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);
@@ -1815,6 +1849,8 @@ int MPI_Scatter(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype,
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scatter);
+  DUMPI_AGGREGATE_BYTES(recvbuf, recvcount, recvtype);
+  DUMPI_RECORD_COLLECTIVE(comm, recvbuf, recvcount, recvtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scatter);
     PMPI_Comm_rank(comm, &commrank);
@@ -1854,6 +1890,7 @@ int MPI_Scatterv(DUMPI_CONST void *sendbuf, DUMPI_CONST int *sendcounts, DUMPI_C
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scatterv);
+  DUMPI_RECORD_COLLECTIVE(comm, recvbuf, recvcount, recvtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scatterv);
     PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);
@@ -1894,6 +1931,8 @@ int MPI_Allgather(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtyp
   memset(&stat, 0, sizeof(dumpi_allgather));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allgather);
+  DUMPI_AGGREGATE_BYTES(sendbuf, sendcount, sendtype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, sendcount, sendtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allgather);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -1929,6 +1968,8 @@ int MPI_Allgatherv(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendty
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allgatherv);
+  DUMPI_AGGREGATE_BYTES(sendbuf, sendcount, sendtype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, sendcount, sendtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allgatherv);
     PMPI_Comm_size(comm, &commsize);
@@ -1967,6 +2008,8 @@ int MPI_Alltoall(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype
   memset(&stat, 0, sizeof(dumpi_alltoall));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoall);
+  DUMPI_AGGREGATE_BYTES(sendbuf, sendcount, sendtype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, sendcount, sendtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoall);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -2002,6 +2045,7 @@ int MPI_Alltoallv(DUMPI_CONST void *sendbuf, DUMPI_CONST int *sendcounts, DUMPI_
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoallv);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, 0, MPI_DATATYPE_NULL);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoallv);
     PMPI_Comm_size(comm, &commsize);
@@ -2043,6 +2087,8 @@ int MPI_Reduce(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datatype
   memset(&stat, 0, sizeof(dumpi_reduce));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Reduce);
+  DUMPI_AGGREGATE_BYTES(recvbuf, count, datatype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Reduce);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2135,6 +2181,8 @@ int MPI_Allreduce(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datat
   memset(&stat, 0, sizeof(dumpi_allreduce));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allreduce);
+  DUMPI_AGGREGATE_BYTES(recvbuf, count, datatype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allreduce);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2169,6 +2217,7 @@ int MPI_Reduce_scatter(DUMPI_CONST void *sendbuf, void *recvbuf, DUMPI_CONST int
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Reduce_scatter);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, 0, MPI_DATATYPE_NULL);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Reduce_scatter);
     PMPI_Comm_size(comm, &commsize);
@@ -2204,6 +2253,8 @@ int MPI_Scan(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datatype d
   memset(&stat, 0, sizeof(dumpi_scan));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scan);
+  DUMPI_AGGREGATE_BYTES(recvbuf, count, datatype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scan);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2833,6 +2884,7 @@ int MPI_Comm_free(MPI_Comm *comm) {
   memset(&stat, 0, sizeof(dumpi_comm_free));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Comm_free);
+  libdumpi_forget_comms();
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Comm_free);
     DUMPI_COMM_FROM_MPI_COMM(stat.comm, *comm);
@@ -3974,6 +4026,12 @@ int MPI_Init(int *argc, char ***argv) {
   /* PMPI_Init is tagged as an INITIAL call */
   if(retval == MPI_SUCCESS) {
     libdumpi_open_files();
+    if(profiling) {
+      /* The configuration was only read by libdumpi_open_files */
+      DUMPI_RECHECK_PROFILING(DUMPI_Init);
+      if(!profiling && argv != NULL)
+	DUMPI_FREE_CHAR_FROM_CHAR_ARRAY_2(argc, stat.argv);
+    }
     libdumpi_init_maps();
     register_builtin_datatypes();
     DUMPI_START_TIME(cpu, wall); /* We cheat on timings for INIT. */
@@ -4081,6 +4139,8 @@ int MPI_Abort(MPI_Comm comm, int errorcode) {
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Abort);
   }
+  /* No postamble follows PMPI_Abort, so record the call here */
+  if(aggregate) libdumpi_record_call(agg_func, agg_start, agg_bytes);
   libdumpi_finalize();
   retval = PMPI_Abort(comm, errorcode);
   return retval;
@@ -4194,6 +4254,7 @@ int MPI_Comm_disconnect(MPI_Comm *comm) {
   memset(&stat, 0, sizeof(dumpi_comm_disconnect));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Comm_disconnect);
+  libdumpi_forget_comms();
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Comm_disconnect);
     DUMPI_COMM_FROM_MPI_COMM(stat.comm, *comm);
@@ -4507,6 +4568,7 @@ int MPI_Accumulate(DUMPI_CONST void *buf, int origincount, MPI_Datatype originty
   memset(&stat, 0, sizeof(dumpi_accumulate));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Accumulate);
+  DUMPI_AGGREGATE_BYTES(buf, origincount, origintype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Accumulate);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -4543,6 +4605,7 @@ int MPI_Get(void *buf, int origincount, MPI_Datatype origintype, int targetrank,
   memset(&stat, 0, sizeof(dumpi_get));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Get);
+  DUMPI_AGGREGATE_BYTES(buf, origincount, origintype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Get);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -4578,6 +4641,7 @@ int MPI_Put(DUMPI_CONST void *buf, int origincount, MPI_Datatype origintype, int
   memset(&stat, 0, sizeof(dumpi_put));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Put);
+  DUMPI_AGGREGATE_BYTES(buf, origincount, origintype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Put);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -4949,6 +5013,7 @@ int MPI_Alltoallw(DUMPI_CONST void *sendbuf, DUMPI_CONST int *sendcounts, DUMPI_
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoallw);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, 0, MPI_DATATYPE_NULL);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoallw);
     PMPI_Comm_size(comm, &commsize);
@@ -4992,6 +5057,8 @@ int MPI_Exscan(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datatype
   memset(&stat, 0, sizeof(dumpi_exscan));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Exscan);
+  DUMPI_AGGREGATE_BYTES(recvbuf, count, datatype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Exscan);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -5464,6 +5531,12 @@ int MPI_Init_thread(int *argc, char ***argv, int required, int *provided) {
   if(retval == MPI_SUCCESS) {
     /* PMPI_Init_thread is tagged as an INITIAL call */
     libdumpi_open_files();
+    if(profiling) {
+      /* The configuration was only read by libdumpi_open_files */
+      DUMPI_RECHECK_PROFILING(DUMPI_Init_thread);
+      if(!profiling && argv != NULL)
+	DUMPI_FREE_CHAR_FROM_CHAR_ARRAY_2(argc, stat.argv);
+    }
     libdumpi_init_maps();
     register_builtin_datatypes();
     DUMPI_START_TIME(cpu, wall); /* We cheat on timings for INIT. */
@@ -7694,6 +7767,7 @@ int MPI_File_read_at(MPI_File file, MPI_Offset offset, void *buf, int count, MPI
   memset(&stat, 0, sizeof(dumpi_file_read_at));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_at);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_at);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -7728,6 +7802,7 @@ int MPI_File_read_at_all(MPI_File file, MPI_Offset offset, void *buf, int count,
   memset(&stat, 0, sizeof(dumpi_file_read_at_all));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_at_all);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_at_all);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -7762,6 +7837,7 @@ int MPI_File_write_at(MPI_File file, MPI_Offset offset, DUMPI_CONST void *buf, i
   memset(&stat, 0, sizeof(dumpi_file_write_at));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_at);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_at);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -7796,6 +7872,7 @@ int MPI_File_write_at_all(MPI_File file, MPI_Offset offset, DUMPI_CONST void *bu
   memset(&stat, 0, sizeof(dumpi_file_write_at_all));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_at_all);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_at_all);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -7830,6 +7907,7 @@ int MPI_File_iread_at(MPI_File file, MPI_Offset offset, void *buf, int count, MP
   memset(&stat, 0, sizeof(dumpi_file_iread_at));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iread_at);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iread_at);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -7863,6 +7941,7 @@ int MPI_File_iwrite_at(MPI_File file, MPI_Offset offset, DUMPI_CONST void *buf,
   memset(&stat, 0, sizeof(dumpi_file_iwrite_at));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iwrite_at);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iwrite_at);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -7896,6 +7975,7 @@ int MPI_File_read(MPI_File file, void *buf, int count, MPI_Datatype datatype, MP
   memset(&stat, 0, sizeof(dumpi_file_read));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -7929,6 +8009,7 @@ int MPI_File_read_all(MPI_File file, void *buf, int count, MPI_Datatype datatype
   memset(&stat, 0, sizeof(dumpi_file_read_all));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_all);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_all);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -7962,6 +8043,7 @@ int MPI_File_write(MPI_File file, DUMPI_CONST void *buf, int count, MPI_Datatype
   memset(&stat, 0, sizeof(dumpi_file_write));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -7995,6 +8077,7 @@ int MPI_File_write_all(MPI_File file, DUMPI_CONST void *buf, int count, MPI_Data
   memset(&stat, 0, sizeof(dumpi_file_write_all));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_all);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_all);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8028,6 +8111,7 @@ int MPI_File_iread(MPI_File file, void *buf, int count, MPI_Datatype datatype, M
   memset(&stat, 0, sizeof(dumpi_file_iread));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iread);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iread);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8060,6 +8144,7 @@ int MPI_File_iwrite(MPI_File file, DUMPI_CONST void *buf, int count, MPI_Datatyp
   memset(&stat, 0, sizeof(dumpi_file_iwrite));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iwrite);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iwrite);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8184,6 +8269,7 @@ int MPI_File_read_shared(MPI_File file, void *buf, int count, MPI_Datatype datat
   memset(&stat, 0, sizeof(dumpi_file_read_shared));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_shared);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_shared);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8217,6 +8303,7 @@ int MPI_File_write_shared(MPI_File file, DUMPI_CONST void *buf, int count, MPI_D
   memset(&stat, 0, sizeof(dumpi_file_write_shared));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_shared);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_shared);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8250,6 +8337,7 @@ int MPI_File_iread_shared(MPI_File file, void *buf, int count, MPI_Datatype data
   memset(&stat, 0, sizeof(dumpi_file_iread_shared));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iread_shared);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iread_shared);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8282,6 +8370,7 @@ int MPI_File_iwrite_shared(MPI_File file, DUMPI_CONST void *buf, int count, MPI_
   memset(&stat, 0, sizeof(dumpi_file_iwrite_shared));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iwrite_shared);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iwrite_shared);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8314,6 +8403,7 @@ int MPI_File_read_ordered(MPI_File file, void *buf, int count, MPI_Datatype data
   memset(&stat, 0, sizeof(dumpi_file_read_ordered));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_ordered);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_ordered);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8347,6 +8437,7 @@ int MPI_File_write_ordered(MPI_File file, DUMPI_CONST void *buf, int count, MPI_
   memset(&stat, 0, sizeof(dumpi_file_write_ordered));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_ordered);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_ordered);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8441,6 +8532,7 @@ int MPI_File_read_at_all_begin(MPI_File file, MPI_Offset offset, void *buf, int
   memset(&stat, 0, sizeof(dumpi_file_read_at_all_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_at_all_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_at_all_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8504,6 +8596,7 @@ int MPI_File_write_at_all_begin(MPI_File file, MPI_Offset offset, DUMPI_CONST vo
   memset(&stat, 0, sizeof(dumpi_file_write_at_all_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_at_all_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_at_all_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8567,6 +8660,7 @@ int MPI_File_read_all_begin(MPI_File file, void *buf, int count, MPI_Datatype da
   memset(&stat, 0, sizeof(dumpi_file_read_all_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_all_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_all_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8629,6 +8723,7 @@ int MPI_File_write_all_begin(MPI_File file, DUMPI_CONST void *buf, int count, MP
   memset(&stat, 0, sizeof(dumpi_file_write_all_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_all_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_all_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8691,6 +8786,7 @@ int MPI_File_read_ordered_begin(MPI_File file, void *buf, int count, MPI_Datatyp
   memset(&stat, 0, sizeof(dumpi_file_read_ordered_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_ordered_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_ordered_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8753,6 +8849,7 @@ int MPI_File_write_ordered_begin(MPI_File file, DUMPI_CONST void *buf, int count
   memset(&stat, 0, sizeof(dumpi_file_write_ordered_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_ordered_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_ordered_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -192,6 +192,8 @@ int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int ta
   memset(&stat, 0, sizeof(dumpi_send));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Send);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Send);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -225,6 +227,7 @@ int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, M
   memset(&stat, 0, sizeof(dumpi_recv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Recv);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Recv);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -292,6 +295,8 @@ int MPI_Bsend(const void *buf, int count, MPI_Datatype datatype, int dest, int t
   memset(&stat, 0, sizeof(dumpi_bsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bsend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -325,6 +330,8 @@ int MPI_Ssend(const void *buf, int count, MPI_Datatype datatype, int dest, int t
   memset(&stat, 0, sizeof(dumpi_ssend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ssend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ssend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -358,6 +365,8 @@ int MPI_Rsend(const void *buf, int count, MPI_Datatype datatype, int dest, int t
   memset(&stat, 0, sizeof(dumpi_rsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Rsend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Rsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -449,6 +458,8 @@ int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int t
   memset(&stat, 0, sizeof(dumpi_isend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Isend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Isend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -483,6 +494,8 @@ int MPI_Ibsend(const void *buf, int count, MPI_Datatype datatype, int dest, int
   memset(&stat, 0, sizeof(dumpi_ibsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ibsend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ibsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -517,6 +530,8 @@ int MPI_Issend(const void *buf, int count, MPI_Datatype datatype, int dest, int
   memset(&stat, 0, sizeof(dumpi_issend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Issend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Issend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -551,6 +566,8 @@ int MPI_Irsend(const void *buf, int count, MPI_Datatype datatype, int dest, int
   memset(&stat, 0, sizeof(dumpi_irsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Irsend);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Irsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -585,6 +602,7 @@ int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag,
   memset(&stat, 0, sizeof(dumpi_irecv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Irecv);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Irecv);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1046,6 +1064,7 @@ int MPI_Send_init(const void *buf, int count, MPI_Datatype datatype, int dest, i
   memset(&stat, 0, sizeof(dumpi_send_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Send_init);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Send_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1080,6 +1099,7 @@ int MPI_Bsend_init(const void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_bsend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bsend_init);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bsend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1114,6 +1134,7 @@ int MPI_Ssend_init(const void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_ssend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ssend_init);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ssend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1148,6 +1169,7 @@ int MPI_Rsend_init(const void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_rsend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Rsend_init);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Rsend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1182,6 +1204,7 @@ int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int t
   memset(&stat, 0, sizeof(dumpi_recv_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Recv_init);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Recv_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1276,6 +1299,8 @@ int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int
   memset(&stat, 0, sizeof(dumpi_sendrecv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Sendrecv);
+  DUMPI_AGGREGATE_BYTES(sendbuf, sendcount, sendtype);
+  DUMPI_RECORD_SEND(dest, sendcount, sendtype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Sendrecv);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -1315,6 +1340,8 @@ int MPI_Sendrecv_replace(void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_sendrecv_replace));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Sendrecv_replace);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
+  DUMPI_RECORD_SEND(dest, count, datatype, comm);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Sendrecv_replace);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1893,6 +1920,7 @@ int MPI_Barrier(MPI_Comm comm) {
   memset(&stat, 0, sizeof(dumpi_barrier));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Barrier);
+  DUMPI_RECORD_COLLECTIVE(comm, MPI_BOTTOM, 0, MPI_DATATYPE_NULL);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Barrier);
     DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
@@ -1922,6 +1950,8 @@ int MPI_Bcast(void *sendbuf, int count, MPI_Datatype datatype, int root, MPI_Com
   memset(&stat, 0, sizeof(dumpi_bcast));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bcast);
+  DUMPI_AGGREGATE_BYTES(sendbuf, count, datatype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bcast);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1956,6 +1986,8 @@ int MPI_Gather(const void *inbuf, int sendcount, MPI_Datatype sendtype, void *re
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Gather);
+  DUMPI_AGGREGATE_BYTES(inbuf, sendcount, sendtype);
+  DUMPI_RECORD_COLLECTIVE(comm, inbuf, sendcount, sendtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Gather);
     PMPI_Comm_rank(comm, &commrank);
@@ -1995,6 +2027,8 @@ int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Gatherv);
+  DUMPI_AGGREGATE_BYTES(sendbuf, sendcount, sendtype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, sendcount, sendtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Gatherv);
     PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);
@@ -2037,6 +2071,8 @@ int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scatter);
+  DUMPI_AGGREGATE_BYTES(recvbuf, recvcount, recvtype);
+  DUMPI_RECORD_COLLECTIVE(comm, recvbuf, recvcount, recvtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scatter);
     PMPI_Comm_rank(comm, &commrank);
@@ -2076,6 +2112,7 @@ int MPI_Scatterv(const void *sendbuf, const int *sendcounts, const int *displs,
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scatterv);
+  DUMPI_RECORD_COLLECTIVE(comm, recvbuf, recvcount, recvtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scatterv);
     PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);
@@ -2116,6 +2153,8 @@ int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, voi
   memset(&stat, 0, sizeof(dumpi_allgather));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allgather);
+  DUMPI_AGGREGATE_BYTES(sendbuf, sendcount, sendtype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, sendcount, sendtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allgather);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -2151,6 +2190,8 @@ int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, vo
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allgatherv);
+  DUMPI_AGGREGATE_BYTES(sendbuf, sendcount, sendtype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, sendcount, sendtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allgatherv);
     PMPI_Comm_size(comm, &commsize);
@@ -2189,6 +2230,8 @@ int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void
   memset(&stat, 0, sizeof(dumpi_alltoall));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoall);
+  DUMPI_AGGREGATE_BYTES(sendbuf, sendcount, sendtype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, sendcount, sendtype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoall);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -2224,6 +2267,7 @@ int MPI_Alltoallv(const void *sendbuf, const int *sendcounts, const int *senddis
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoallv);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, 0, MPI_DATATYPE_NULL);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoallv);
     PMPI_Comm_size(comm, &commsize);
@@ -2265,6 +2309,8 @@ int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datat
   memset(&stat, 0, sizeof(dumpi_reduce));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Reduce);
+  DUMPI_AGGREGATE_BYTES(recvbuf, count, datatype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Reduce);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2357,6 +2403,8 @@ int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype da
   memset(&stat, 0, sizeof(dumpi_allreduce));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allreduce);
+  DUMPI_AGGREGATE_BYTES(recvbuf, count, datatype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allreduce);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2391,6 +2439,7 @@ int MPI_Reduce_scatter(const void *sendbuf, void *recvbuf, const int *recvcounts
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Reduce_scatter);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, 0, MPI_DATATYPE_NULL);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Reduce_scatter);
     PMPI_Comm_size(comm, &commsize);
@@ -2426,6 +2475,8 @@ int MPI_Scan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatyp
   memset(&stat, 0, sizeof(dumpi_scan));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scan);
+  DUMPI_AGGREGATE_BYTES(recvbuf, count, datatype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scan);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -3055,6 +3106,7 @@ int MPI_Comm_free(MPI_Comm *comm) {
   memset(&stat, 0, sizeof(dumpi_comm_free));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Comm_free);
+  libdumpi_forget_comms();
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Comm_free);
     DUMPI_COMM_FROM_MPI_COMM(stat.comm, *comm);
@@ -4285,6 +4337,12 @@ int MPI_Init(int *argc, char ***argv) {
   /* PMPI_Init is tagged as an INITIAL call */
   if(retval == MPI_SUCCESS) {
     libdumpi_open_files();
+    if(profiling) {
+      /* The configuration was only read by libdumpi_open_files */
+      DUMPI_RECHECK_PROFILING(DUMPI_Init);
+      if(!profiling && argv != NULL)
+	DUMPI_FREE_CHAR_FROM_CHAR_ARRAY_2(argc, stat.argv);
+    }
     libdumpi_init_maps();
     register_builtin_datatypes();
     DUMPI_START_TIME(cpu, wall); /* We cheat on timings for INIT. */
@@ -4392,6 +4450,8 @@ int MPI_Abort(MPI_Comm comm, int errorcode) {
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Abort);
   }
+  /* No postamble follows PMPI_Abort, so record the call here */
+  if(aggregate) libdumpi_record_call(agg_func, agg_start, agg_bytes);
   libdumpi_finalize();
   retval = PMPI_Abort(comm, errorcode);
   return retval;
@@ -4505,6 +4565,7 @@ int MPI_Comm_disconnect(MPI_Comm *comm) {
   memset(&stat, 0, sizeof(dumpi_comm_disconnect));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Comm_disconnect);
+  libdumpi_forget_comms();
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Comm_disconnect);
     DUMPI_COMM_FROM_MPI_COMM(stat.comm, *comm);
@@ -4818,6 +4879,7 @@ int MPI_Accumulate(const void *buf, int origincount, MPI_Datatype origintype, in
   memset(&stat, 0, sizeof(dumpi_accumulate));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Accumulate);
+  DUMPI_AGGREGATE_BYTES(buf, origincount, origintype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Accumulate);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -4854,6 +4916,7 @@ int MPI_Get(void *buf, int origincount, MPI_Datatype origintype, int targetrank,
   memset(&stat, 0, sizeof(dumpi_get));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Get);
+  DUMPI_AGGREGATE_BYTES(buf, origincount, origintype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Get);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -4889,6 +4952,7 @@ int MPI_Put(const void *buf, int origincount, MPI_Datatype origintype, int targe
   memset(&stat, 0, sizeof(dumpi_put));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Put);
+  DUMPI_AGGREGATE_BYTES(buf, origincount, origintype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Put);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -5260,6 +5324,7 @@ int MPI_Alltoallw(const void *sendbuf, const int *sendcounts, const int *senddis
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoallw);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, 0, MPI_DATATYPE_NULL);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoallw);
     PMPI_Comm_size(comm, &commsize);
@@ -5303,6 +5368,8 @@ int MPI_Exscan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datat
   memset(&stat, 0, sizeof(dumpi_exscan));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Exscan);
+  DUMPI_AGGREGATE_BYTES(recvbuf, count, datatype);
+  DUMPI_RECORD_COLLECTIVE(comm, sendbuf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Exscan);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -5775,6 +5842,12 @@ int MPI_Init_thread(int *argc, char ***argv, int required, int *provided) {
   if(retval == MPI_SUCCESS) {
     /* PMPI_Init_thread is tagged as an INITIAL call */
     libdumpi_open_files();
+    if(profiling) {
+      /* The configuration was only read by libdumpi_open_files */
+      DUMPI_RECHECK_PROFILING(DUMPI_Init_thread);
+      if(!profiling && argv != NULL)
+	DUMPI_FREE_CHAR_FROM_CHAR_ARRAY_2(argc, stat.argv);
+    }
     libdumpi_init_maps();
     register_builtin_datatypes();
     DUMPI_START_TIME(cpu, wall); /* We cheat on timings for INIT. */
@@ -8005,6 +8078,7 @@ int MPI_File_read_at(MPI_File file, MPI_Offset offset, void *buf, int count, MPI
   memset(&stat, 0, sizeof(dumpi_file_read_at));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_at);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_at);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8039,6 +8113,7 @@ int MPI_File_read_at_all(MPI_File file, MPI_Offset offset, void *buf, int count,
   memset(&stat, 0, sizeof(dumpi_file_read_at_all));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_at_all);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_at_all);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8073,6 +8148,7 @@ int MPI_File_write_at(MPI_File file, MPI_Offset offset, const void *buf, int cou
   memset(&stat, 0, sizeof(dumpi_file_write_at));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_at);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_at);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8107,6 +8183,7 @@ int MPI_File_write_at_all(MPI_File file, MPI_Offset offset, const void *buf, int
   memset(&stat, 0, sizeof(dumpi_file_write_at_all));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_at_all);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_at_all);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8141,6 +8218,7 @@ int MPI_File_iread_at(MPI_File file, MPI_Offset offset, void *buf, int count, MP
   memset(&stat, 0, sizeof(dumpi_file_iread_at));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iread_at);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iread_at);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8174,6 +8252,7 @@ int MPI_File_iwrite_at(MPI_File file, MPI_Offset offset, const void *buf, int co
   memset(&stat, 0, sizeof(dumpi_file_iwrite_at));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iwrite_at);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iwrite_at);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8207,6 +8286,7 @@ int MPI_File_read(MPI_File file, void *buf, int count, MPI_Datatype datatype, MP
   memset(&stat, 0, sizeof(dumpi_file_read));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8240,6 +8320,7 @@ int MPI_File_read_all(MPI_File file, void *buf, int count, MPI_Datatype datatype
   memset(&stat, 0, sizeof(dumpi_file_read_all));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_all);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_all);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8273,6 +8354,7 @@ int MPI_File_write(MPI_File file, const void *buf, int count, MPI_Datatype datat
   memset(&stat, 0, sizeof(dumpi_file_write));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8306,6 +8388,7 @@ int MPI_File_write_all(MPI_File file, const void *buf, int count, MPI_Datatype d
   memset(&stat, 0, sizeof(dumpi_file_write_all));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_all);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_all);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8339,6 +8422,7 @@ int MPI_File_iread(MPI_File file, void *buf, int count, MPI_Datatype datatype, M
   memset(&stat, 0, sizeof(dumpi_file_iread));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iread);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iread);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8371,6 +8455,7 @@ int MPI_File_iwrite(MPI_File file, const void *buf, int count, MPI_Datatype data
   memset(&stat, 0, sizeof(dumpi_file_iwrite));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iwrite);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iwrite);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8495,6 +8580,7 @@ int MPI_File_read_shared(MPI_File file, void *buf, int count, MPI_Datatype datat
   memset(&stat, 0, sizeof(dumpi_file_read_shared));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_shared);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_shared);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8528,6 +8614,7 @@ int MPI_File_write_shared(MPI_File file, const void *buf, int count, MPI_Datatyp
   memset(&stat, 0, sizeof(dumpi_file_write_shared));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_shared);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_shared);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8561,6 +8648,7 @@ int MPI_File_iread_shared(MPI_File file, void *buf, int count, MPI_Datatype data
   memset(&stat, 0, sizeof(dumpi_file_iread_shared));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iread_shared);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iread_shared);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8593,6 +8681,7 @@ int MPI_File_iwrite_shared(MPI_File file, const void *buf, int count, MPI_Dataty
   memset(&stat, 0, sizeof(dumpi_file_iwrite_shared));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_iwrite_shared);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_iwrite_shared);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8625,6 +8714,7 @@ int MPI_File_read_ordered(MPI_File file, void *buf, int count, MPI_Datatype data
   memset(&stat, 0, sizeof(dumpi_file_read_ordered));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_ordered);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_ordered);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8658,6 +8748,7 @@ int MPI_File_write_ordered(MPI_File file, const void *buf, int count, MPI_Dataty
   memset(&stat, 0, sizeof(dumpi_file_write_ordered));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_ordered);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_ordered);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8752,6 +8843,7 @@ int MPI_File_read_at_all_begin(MPI_File file, MPI_Offset offset, void *buf, int
   memset(&stat, 0, sizeof(dumpi_file_read_at_all_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_at_all_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_at_all_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8815,6 +8907,7 @@ int MPI_File_write_at_all_begin(MPI_File file, MPI_Offset offset, const void *bu
   memset(&stat, 0, sizeof(dumpi_file_write_at_all_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_at_all_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_at_all_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8878,6 +8971,7 @@ int MPI_File_read_all_begin(MPI_File file, void *buf, int count, MPI_Datatype da
   memset(&stat, 0, sizeof(dumpi_file_read_all_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_all_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_all_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -8940,6 +9034,7 @@ int MPI_File_write_all_begin(MPI_File file, const void *buf, int count, MPI_Data
   memset(&stat, 0, sizeof(dumpi_file_write_all_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_all_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_all_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -9002,6 +9097,7 @@ int MPI_File_read_ordered_begin(MPI_File file, void *buf, int count, MPI_Datatyp
   memset(&stat, 0, sizeof(dumpi_file_read_ordered_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_read_ordered_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_read_ordered_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
@@ -9064,6 +9160,7 @@ int MPI_File_write_ordered_begin(MPI_File file, const void *buf, int count, MPI_
   memset(&stat, 0, sizeof(dumpi_file_write_ordered_begin));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_File_write_ordered_begin);
+  DUMPI_AGGREGATE_BYTES(buf, count, datatype);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_File_write_ordered_begin);
     DUMPI_FILE_FROM_MPI_FILE(stat.file, file);
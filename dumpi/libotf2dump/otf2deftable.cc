@@ -84,4 +84,40 @@ OTF2DefTable::get(int index) const {
   return std::string();
 }
 
+OTF2RankListTable&
+OTF2RankListTable::global()
+{
+  static OTF2RankListTable table;
+  return table;
+}
+
+OTF2RankListTable::list_ptr
+OTF2RankListTable::intern(std::vector<int>&& ranks)
+{
+  size_t hash = ranks.size();
+  for (int rank : ranks){
+    hash ^= std::hash<int>()(rank) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  auto range = lists_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it){
+    list_ptr list = it->second.lock();
+    if (list && *list == ranks) return list;
+  }
+
+  // not make_shared, so the ranks are freed with the last group, not the last weak_ptr
+  list_ptr list(new std::vector<int>(std::move(ranks)));
+  lists_.emplace(hash, list);
+
+  if (lists_.size() >= sweep_at_){
+    for (auto it = lists_.begin(); it != lists_.end(); ){
+      if (it->second.expired()) it = lists_.erase(it);
+      else ++it;
+    }
+    sweep_at_ = std::max<size_t>(1024, 2*lists_.size());
+  }
+  return list;
+}
+
 }
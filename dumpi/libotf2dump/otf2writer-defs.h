@@ -53,6 +53,8 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <set>
 #include <list>
 #include <string>
+#include <memory>
+#include <mutex>
 
 
 namespace dumpi {
@@ -123,6 +125,19 @@ struct irecv_capture {
   mpi_request_t request;
 };
 
+/**
+ * @brief The request_slot struct
+ * One entry of the outstanding request table, indexed by request id.
+ * The irecv fields are only meaningful for REQUEST_TYPE_IRECV.
+ */
+struct request_slot {
+  bool active;
+  REQUEST_TYPE type;
+  // Batch in which this slot was last completed, to skip duplicates in Waitall
+  uint32_t completed_batch;
+  irecv_capture irecv;
+};
+
 /**
  * @brief The OTF2DefTable class
  * Maps an incrementing id to a string. Helps def file creation, which
@@ -158,6 +173,28 @@ class OTF2DefTable {
   int counter_ = 0;
 };
 
+/**
+ * @brief The OTF2RankListTable class
+ * Process-wide registry of group membership lists. Every member of a
+ * communicator builds the same list of world ranks; interning it here
+ * lets all of their groups share one copy instead of one per rank.
+ * Lists are released once no group refers to them.
+ */
+class OTF2RankListTable {
+ public:
+  using list_ptr = std::shared_ptr<const std::vector<int>>;
+
+  static OTF2RankListTable& global();
+
+  /** Returns the shared list equal to ranks, adding it if needed. */
+  list_ptr intern(std::vector<int>&& ranks);
+
+ private:
+  std::mutex lock_;
+  std::unordered_multimap<size_t, std::weak_ptr<const std::vector<int>>> lists_;
+  size_t sweep_at_ = 1024;
+};
+
 }
 
 #endif // OTF2WRITERDEFS_H
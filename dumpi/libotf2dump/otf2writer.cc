@@ -43,11 +43,11 @@ Questions? Contact sst-macro-help@sandia.gov
 */
 
 #include <dumpi/libotf2dump/otf2writer.h>
+#include <dumpi/common/funcs.h>
 #include <sys/stat.h>
 #include <algorithm>
 #include <limits.h>
 #include <cstring>
-#include <unordered_set>
 #include <functional>
 #include <iostream>
 #include <sstream>
@@ -65,11 +65,13 @@ static T array_sum(T* t, int n){
 
 
 
-#define _ENTER(name)                         \
-  logger(OWV_INFO, name);                    \
+// Region ids are the dumpi_function ids, so no lookup is needed per event
+#define _ENTER(func)                         \
+  logger(OWV_INFO, dumpi_function_names[func]); \
   start_time_ = std::min(start_time_, start); \
   stop_time_ = std::max(stop_time_, stop);    \
-  auto this_region = otf2_regions_table_.insert(name);  \
+  const OTF2_RegionRef this_region = func;    \
+  regions_used_.set(func);                    \
   OTF2_EvtWriter_Enter(evt_writer_,      \
                        nullptr,             \
                        start,               \
@@ -84,6 +86,11 @@ static T array_sum(T* t, int n){
   event_count_++;                \
   return OTF2_WRITER_SUCCESS;
 
+// Reject a call on an invalid request id before any event is written for it
+#define _CHECK_REQUESTS(count, requests, indices)             \
+  if (!valid_requests(count, requests, indices))              \
+    return OTF2_WRITER_ERROR_OUT_OF_RANGE;
+
 #define COLLECTIVE_WRAPPER(collective, sent, received)                                                    \
   OTF2_EvtWriter_MpiCollectiveBegin(evt_writer_, nullptr, start);                                      \
   OTF2_EvtWriter_MpiCollectiveEnd(evt_writer_, nullptr, stop, collective, \
@@ -223,409 +230,6 @@ OTF2_Writer::OTF2_Writer() :
   clock_resolution_(1),
   write_global_comms_(false)
 {
-  //add all the regions here to ensure that all ranks
-  //have a uniform number
-#define addRegion(x) \
-  add_region(#x);
-
-  addRegion(MPI_Abort)
-  addRegion(MPI_Accumulate)
-  addRegion(MPI_Add_error_class)
-  addRegion(MPI_Add_error_code)
-  addRegion(MPI_Add_error_string)
-  addRegion(MPI_Address)
-  addRegion(MPI_Aint_add)
-  addRegion(MPI_Aint_diff)
-  addRegion(MPI_Allgather)
-  addRegion(MPI_Allgatherv)
-  addRegion(MPI_Alloc_mem)
-  addRegion(MPI_Allreduce)
-  addRegion(MPI_Alltoall)
-  addRegion(MPI_Alltoallv)
-  addRegion(MPI_Alltoallw)
-  addRegion(MPI_Attr_delete)
-  addRegion(MPI_Attr_get)
-  addRegion(MPI_Attr_put)
-  addRegion(MPI_Barrier)
-  addRegion(MPI_Bcast)
-  addRegion(MPI_Bsend)
-  addRegion(MPI_Bsend_init)
-  addRegion(MPI_Buffer_attach)
-  addRegion(MPI_Buffer_detach)
-  addRegion(MPI_Cancel)
-  addRegion(MPI_Cart_coords)
-  addRegion(MPI_Cart_create)
-  addRegion(MPI_Cart_get)
-  addRegion(MPI_Cart_map)
-  addRegion(MPI_Cart_rank)
-  addRegion(MPI_Cart_shift)
-  addRegion(MPI_Cart_sub)
-  addRegion(MPI_Cartdim_get)
-  addRegion(MPI_Close_port)
-  addRegion(MPI_Comm_accept)
-  addRegion(MPI_Comm_call_errhandler)
-  addRegion(MPI_Comm_compare)
-  addRegion(MPI_Comm_connect)
-  addRegion(MPI_Comm_create)
-  addRegion(MPI_Comm_create_errhandler)
-  addRegion(MPI_Comm_create_group)
-  addRegion(MPI_Comm_create_keyval)
-  addRegion(MPI_Comm_delete_attr)
-  addRegion(MPI_Comm_disconnect)
-  addRegion(MPI_Comm_dup)
-  addRegion(MPI_Comm_dup_with_info)
-  addRegion(MPI_Comm_free)
-  addRegion(MPI_Comm_free_keyval)
-  addRegion(MPI_Comm_get_attr)
-  addRegion(MPI_Comm_get_errhandler)
-  addRegion(MPI_Comm_get_info)
-  addRegion(MPI_Comm_get_name)
-  addRegion(MPI_Comm_get_parent)
-  addRegion(MPI_Comm_group)
-  addRegion(MPI_Comm_idup)
-  addRegion(MPI_Comm_join)
-  addRegion(MPI_Comm_rank)
-  addRegion(MPI_Comm_remote_group)
-  addRegion(MPI_Comm_remote_size)
-  addRegion(MPI_Comm_set_attr)
-  addRegion(MPI_Comm_set_errhandler)
-  addRegion(MPI_Comm_set_info)
-  addRegion(MPI_Comm_set_name)
-  addRegion(MPI_Comm_size)
-  addRegion(MPI_Comm_spawn)
-  addRegion(MPI_Comm_spawn_multiple)
-  addRegion(MPI_Comm_split)
-  addRegion(MPI_Comm_split_type)
-  addRegion(MPI_Comm_test_inter)
-  addRegion(MPI_Compare_and_swap)
-  addRegion(MPI_Dims_create)
-  addRegion(MPI_Dist_graph_create)
-  addRegion(MPI_Dist_graph_create_adjacent)
-  addRegion(MPI_Dist_graph_neighbors)
-  addRegion(MPI_Dist_graph_neighbors_count)
-  addRegion(MPI_Errhandler_create)
-  addRegion(MPI_Errhandler_free)
-  addRegion(MPI_Errhandler_get)
-  addRegion(MPI_Errhandler_set)
-  addRegion(MPI_Error_class)
-  addRegion(MPI_Error_string)
-  addRegion(MPI_Exscan)
-  addRegion(MPI_Fetch_and_op)
-  addRegion(MPI_File_c2f)
-  addRegion(MPI_File_call_errhandler)
-  addRegion(MPI_File_close)
-  addRegion(MPI_File_create_errhandler)
-  addRegion(MPI_File_delete)
-  addRegion(MPI_File_f2c)
-  addRegion(MPI_File_get_amode)
-  addRegion(MPI_File_get_atomicity)
-  addRegion(MPI_File_get_byte_offset)
-  addRegion(MPI_File_get_errhandler)
-  addRegion(MPI_File_get_group)
-  addRegion(MPI_File_get_info)
-  addRegion(MPI_File_get_position)
-  addRegion(MPI_File_get_position_shared)
-  addRegion(MPI_File_get_size)
-  addRegion(MPI_File_get_type_extent)
-  addRegion(MPI_File_get_view)
-  addRegion(MPI_File_iread)
-  addRegion(MPI_File_iread_all)
-  addRegion(MPI_File_iread_at)
-  addRegion(MPI_File_iread_at_all)
-  addRegion(MPI_File_iread_shared)
-  addRegion(MPI_File_iwrite)
-  addRegion(MPI_File_iwrite_all)
-  addRegion(MPI_File_iwrite_at)
-  addRegion(MPI_File_iwrite_at_all)
-  addRegion(MPI_File_iwrite_shared)
-  addRegion(MPI_File_open)
-  addRegion(MPI_File_preallocate)
-  addRegion(MPI_File_read)
-  addRegion(MPI_File_read_all)
-  addRegion(MPI_File_read_all_begin)
-  addRegion(MPI_File_read_all_end)
-  addRegion(MPI_File_read_at)
-  addRegion(MPI_File_read_at_all)
-  addRegion(MPI_File_read_at_all_begin)
-  addRegion(MPI_File_read_at_all_end)
-  addRegion(MPI_File_read_ordered)
-  addRegion(MPI_File_read_ordered_begin)
-  addRegion(MPI_File_read_ordered_end)
-  addRegion(MPI_File_read_shared)
-  addRegion(MPI_File_seek)
-  addRegion(MPI_File_seek_shared)
-  addRegion(MPI_File_set_atomicity)
-  addRegion(MPI_File_set_errhandler)
-  addRegion(MPI_File_set_info)
-  addRegion(MPI_File_set_size)
-  addRegion(MPI_File_set_view)
-  addRegion(MPI_File_sync)
-  addRegion(MPI_File_write)
-  addRegion(MPI_File_write_all)
-  addRegion(MPI_File_write_all_begin)
-  addRegion(MPI_File_write_all_end)
-  addRegion(MPI_File_write_at)
-  addRegion(MPI_File_write_at_all)
-  addRegion(MPI_File_write_at_all_begin)
-  addRegion(MPI_File_write_at_all_end)
-  addRegion(MPI_File_write_ordered)
-  addRegion(MPI_File_write_ordered_begin)
-  addRegion(MPI_File_write_ordered_end)
-  addRegion(MPI_File_write_shared)
-  addRegion(MPI_Finalize)
-  addRegion(MPI_Finalized)
-  addRegion(MPI_Free_mem)
-  addRegion(MPI_Gather)
-  addRegion(MPI_Gatherv)
-  addRegion(MPI_Get)
-  addRegion(MPI_Get_accumulate)
-  addRegion(MPI_Get_address)
-  addRegion(MPI_Get_count)
-  addRegion(MPI_Get_elements)
-  addRegion(MPI_Get_elements_x)
-  addRegion(MPI_Get_library_version)
-  addRegion(MPI_Get_processor_name)
-  addRegion(MPI_Get_version)
-  addRegion(MPI_Graph_create)
-  addRegion(MPI_Graph_get)
-  addRegion(MPI_Graph_map)
-  addRegion(MPI_Graph_neighbors)
-  addRegion(MPI_Graph_neighbors_count)
-  addRegion(MPI_Graphdims_get)
-  addRegion(MPI_Grequest_complete)
-  addRegion(MPI_Grequest_start)
-  addRegion(MPI_Group_compare)
-  addRegion(MPI_Group_difference)
-  addRegion(MPI_Group_excl)
-  addRegion(MPI_Group_free)
-  addRegion(MPI_Group_incl)
-  addRegion(MPI_Group_intersection)
-  addRegion(MPI_Group_range_excl)
-  addRegion(MPI_Group_range_incl)
-  addRegion(MPI_Group_rank)
-  addRegion(MPI_Group_size)
-  addRegion(MPI_Group_translate_ranks)
-  addRegion(MPI_Group_union)
-  addRegion(MPI_Iallgather)
-  addRegion(MPI_Iallgatherv)
-  addRegion(MPI_Iallreduce)
-  addRegion(MPI_Ialltoall)
-  addRegion(MPI_Ialltoallv)
-  addRegion(MPI_Ialltoallw)
-  addRegion(MPI_Ibarrier)
-  addRegion(MPI_Ibcast)
-  addRegion(MPI_Ibsend)
-  addRegion(MPI_Iexscan)
-  addRegion(MPI_Igather)
-  addRegion(MPI_Igatherv)
-  addRegion(MPI_Improbe)
-  addRegion(MPI_Imrecv)
-  addRegion(MPI_Ineighbor_allgather)
-  addRegion(MPI_Ineighbor_allgatherv)
-  addRegion(MPI_Ineighbor_alltoall)
-  addRegion(MPI_Ineighbor_alltoallv)
-  addRegion(MPI_Ineighbor_alltoallw)
-  addRegion(MPI_Info_create)
-  addRegion(MPI_Info_delete)
-  addRegion(MPI_Info_dup)
-  addRegion(MPI_Info_free)
-  addRegion(MPI_Info_get)
-  addRegion(MPI_Info_get_nkeys)
-  addRegion(MPI_Info_get_nthkey)
-  addRegion(MPI_Info_get_valuelen)
-  addRegion(MPI_Info_set)
-  addRegion(MPI_Init)
-  addRegion(MPI_Init_thread)
-  addRegion(MPI_Initialized)
-  addRegion(MPI_Intercomm_create)
-  addRegion(MPI_Intercomm_merge)
-  addRegion(MPI_Iprobe)
-  addRegion(MPI_Irecv)
-  addRegion(MPI_Ireduce)
-  addRegion(MPI_Ireduce_scatter)
-  addRegion(MPI_Ireduce_scatter_block)
-  addRegion(MPI_Irsend)
-  addRegion(MPI_Is_thread_main)
-  addRegion(MPI_Iscan)
-  addRegion(MPI_Iscatter)
-  addRegion(MPI_Iscatterv)
-  addRegion(MPI_Isend)
-  addRegion(MPI_Issend)
-  addRegion(MPI_Keyval_create)
-  addRegion(MPI_Keyval_free)
-  addRegion(MPI_Lookup_name)
-  addRegion(MPI_Mprobe)
-  addRegion(MPI_Mrecv)
-  addRegion(MPI_Neighbor_allgather)
-  addRegion(MPI_Neighbor_allgatherv)
-  addRegion(MPI_Neighbor_alltoall)
-  addRegion(MPI_Neighbor_alltoallv)
-  addRegion(MPI_Neighbor_alltoallw)
-  addRegion(MPI_Op_commute)
-  addRegion(MPI_Op_create)
-  addRegion(MPI_Op_free)
-  addRegion(MPI_Open_port)
-  addRegion(MPI_Pack)
-  addRegion(MPI_Pack_external)
-  addRegion(MPI_Pack_external_size)
-  addRegion(MPI_Pack_size)
-  addRegion(MPI_Pcontrol)
-  addRegion(MPI_Probe)
-  addRegion(MPI_Publish_name)
-  addRegion(MPI_Put)
-  addRegion(MPI_Query_thread)
-  addRegion(MPI_Raccumulate)
-  addRegion(MPI_Recv)
-  addRegion(MPI_Recv_init)
-  addRegion(MPI_Reduce)
-  addRegion(MPI_Reduce_local)
-  addRegion(MPI_Reduce_scatter)
-  addRegion(MPI_Reduce_scatter_block)
-  addRegion(MPI_Register_datarep)
-  addRegion(MPI_Request_free)
-  addRegion(MPI_Request_get_status)
-  addRegion(MPI_Rget)
-  addRegion(MPI_Rget_accumulate)
-  addRegion(MPI_Rput)
-  addRegion(MPI_Rsend)
-  addRegion(MPI_Rsend_init)
-  addRegion(MPI_Scan)
-  addRegion(MPI_Scatter)
-  addRegion(MPI_Scatterv)
-  addRegion(MPI_Send)
-  addRegion(MPI_Send_init)
-  addRegion(MPI_Sendrecv)
-  addRegion(MPI_Sendrecv_replace)
-  addRegion(MPI_Ssend)
-  addRegion(MPI_Ssend_init)
-  addRegion(MPI_Start)
-  addRegion(MPI_Startall)
-  addRegion(MPI_Status_set_cancelled)
-  addRegion(MPI_Status_set_elements)
-  addRegion(MPI_Status_set_elements_x)
-  addRegion(MPI_T_category_changed)
-  addRegion(MPI_T_category_get_categories)
-  addRegion(MPI_T_category_get_cvars)
-  addRegion(MPI_T_category_get_info)
-  addRegion(MPI_T_category_get_num)
-  addRegion(MPI_T_category_get_pvars)
-  addRegion(MPI_T_cvar_get_info)
-  addRegion(MPI_T_cvar_get_num)
-  addRegion(MPI_T_cvar_handle_alloc)
-  addRegion(MPI_T_cvar_handle_free)
-  addRegion(MPI_T_cvar_read)
-  addRegion(MPI_T_cvar_write)
-  addRegion(MPI_T_enum_get_info)
-  addRegion(MPI_T_enum_get_item)
-  addRegion(MPI_T_finalize)
-  addRegion(MPI_T_init_thread)
-  addRegion(MPI_T_pvar_get_info)
-  addRegion(MPI_T_pvar_get_num)
-  addRegion(MPI_T_pvar_handle_alloc)
-  addRegion(MPI_T_pvar_handle_free)
-  addRegion(MPI_T_pvar_read)
-  addRegion(MPI_T_pvar_readreset)
-  addRegion(MPI_T_pvar_reset)
-  addRegion(MPI_T_pvar_session_create)
-  addRegion(MPI_T_pvar_session_free)
-  addRegion(MPI_T_pvar_start)
-  addRegion(MPI_T_pvar_stop)
-  addRegion(MPI_T_pvar_write)
-  addRegion(MPI_Test)
-  addRegion(MPI_Test_cancelled)
-  addRegion(MPI_Testall)
-  addRegion(MPI_Testany)
-  addRegion(MPI_Testsome)
-  addRegion(MPI_Topo_test)
-  addRegion(MPI_Type_commit)
-  addRegion(MPI_Type_contiguous)
-  addRegion(MPI_Type_create_darray)
-  addRegion(MPI_Type_create_hindexed)
-  addRegion(MPI_Type_create_hindexed_block)
-  addRegion(MPI_Type_create_hvector)
-  addRegion(MPI_Type_create_indexed_block)
-  addRegion(MPI_Type_create_keyval)
-  addRegion(MPI_Type_create_resized)
-  addRegion(MPI_Type_create_struct)
-  addRegion(MPI_Type_create_subarray)
-  addRegion(MPI_Type_delete_attr)
-  addRegion(MPI_Type_dup)
-  addRegion(MPI_Type_extent)
-  addRegion(MPI_Type_free)
-  addRegion(MPI_Type_free_keyval)
-  addRegion(MPI_Type_get_attr)
-  addRegion(MPI_Type_get_contents)
-  addRegion(MPI_Type_get_envelope)
-  addRegion(MPI_Type_get_extent)
-  addRegion(MPI_Type_get_extent_x)
-  addRegion(MPI_Type_get_name)
-  addRegion(MPI_Type_get_true_extent)
-  addRegion(MPI_Type_get_true_extent_x)
-  addRegion(MPI_Type_hindexed)
-  addRegion(MPI_Type_hvector)
-  addRegion(MPI_Type_indexed)
-  addRegion(MPI_Type_lb)
-  addRegion(MPI_Type_match_size)
-  addRegion(MPI_Type_set_attr)
-  addRegion(MPI_Type_set_name)
-  addRegion(MPI_Type_size)
-  addRegion(MPI_Type_size_x)
-  addRegion(MPI_Type_struct)
-  addRegion(MPI_Type_ub)
-  addRegion(MPI_Type_vector)
-  addRegion(MPI_Unpack)
-  addRegion(MPI_Unpack_external)
-  addRegion(MPI_Unpublish_name)
-
-  addRegion(MPI_Waitall)
-  addRegion(MPI_Waitany)
-  addRegion(MPI_Waitsome)
-  addRegion(MPI_Wait)
-
-  addRegion(MPI_Win_allocate)
-  addRegion(MPI_Win_allocate_shared)
-  addRegion(MPI_Win_attach)
-  addRegion(MPI_Win_call_errhandler)
-  addRegion(MPI_Win_complete)
-  addRegion(MPI_Win_create)
-  addRegion(MPI_Win_create_dynamic)
-  addRegion(MPI_Win_create_errhandler)
-  addRegion(MPI_Win_create_keyval)
-  addRegion(MPI_Win_delete_attr)
-  addRegion(MPI_Win_detach)
-  addRegion(MPI_Win_fence)
-  addRegion(MPI_Win_flush)
-  addRegion(MPI_Win_flush_all)
-  addRegion(MPI_Win_flush_local)
-  addRegion(MPI_Win_flush_local_all)
-  addRegion(MPI_Win_free)
-  addRegion(MPI_Win_free_keyval)
-  addRegion(MPI_Win_get_attr)
-  addRegion(MPI_Win_get_errhandler)
-  addRegion(MPI_Win_get_group)
-  addRegion(MPI_Win_get_info)
-  addRegion(MPI_Win_get_name)
-  addRegion(MPI_Win_lock)
-  addRegion(MPI_Win_lock_all)
-  addRegion(MPI_Win_post)
-  addRegion(MPI_Win_set_attr)
-  addRegion(MPI_Win_set_errhandler)
-  addRegion(MPI_Win_set_info)
-  addRegion(MPI_Win_set_name)
-  addRegion(MPI_Win_shared_query)
-  addRegion(MPI_Win_start)
-  addRegion(MPI_Win_sync)
-  addRegion(MPI_Win_test)
-  addRegion(MPI_Win_unlock)
-  addRegion(MPI_Win_unlock_all)
-  addRegion(MPI_Win_wait)
-  addRegion(MPI_Wtick)
-  addRegion(MPI_Wtime)
-  addRegion(MPIX_Comm_agree)
-  addRegion(MPIX_Comm_failure_ack)
-  addRegion(MPIX_Comm_failure_get_acked)
-  addRegion(MPIX_Comm_revoke)
-  addRegion(MPIX_Comm_shrink)
 }
 
 
@@ -778,16 +382,6 @@ OTF2_Writer::write_local_def_file()
     for (auto& pair : comms_){
       const std::list<OTF2_MPI_Comm::shared_ptr>& list = pair.second;
       for (auto& comm : list){
-        if (comm->global_id == 23 && world_.rank == 1){
-          std::stringstream sstr; sstr << "{ ";
-          for (int idx : comm->group->global_ranks){
-            sstr << idx << " ";
-          }
-          sstr << "}";
-          std::cout << "Local " << comm->local_id
-                  << " is now global " << comm->global_id
-                  << " with ranks " << sstr.str() << std::endl;
-        }
         check_otf2(OTF2_IdMap_AddIdPair(mpi_comm_map, comm->local_id, comm->global_id),
                    "Adding a communicator to the Def mapping list");
       }
@@ -843,8 +437,14 @@ OTF2_Writer::write_global_def_file(const std::vector<int>& event_counts,
     otf2_strings_table_.insert(std::string("Master Thread ") + std::to_string(rank));
   }
 
-  for(int i = 0; i < otf2_regions_table_.size(); i++){
-    otf2_strings_table_.insert(otf2_regions_table_.get(i));
+  for(int func = 0; func < DUMPI_END_OF_STREAM; func++){
+    if (regions_used_.test(func))
+      otf2_strings_table_.insert(dumpi_function_names[func]);
+  }
+
+  for (const OTF2_MPI_Comm::shared_ptr& comm : unique_comms){
+    if (!comm->name)
+      otf2_strings_table_.insert("MPI_Comm " + std::to_string(comm->global_id));
   }
 
   // STRINGS
@@ -866,10 +466,9 @@ OTF2_Writer::write_global_def_file(const std::vector<int>& event_counts,
 
   // REGIONS
   logger(OWV_INFO, "Writing REGIONs to the def file");
-  for(auto& pair : otf2_regions_table_) {
-    int region_idx = pair.second;
-    auto& region_name = pair.first;
-    int str_id = otf2_strings_table_.get(region_name);
+  for(int region_idx = 0; region_idx < DUMPI_END_OF_STREAM; region_idx++) {
+    if (!regions_used_.test(region_idx)) continue;
+    int str_id = otf2_strings_table_.get(dumpi_function_names[region_idx]);
     check_otf2(OTF2_GlobalDefWriter_WriteRegion(defwriter,
                                      region_idx,                   /* id */
                                      str_id,                        /* region name  */
@@ -969,11 +568,8 @@ OTF2_Writer::write_global_def_file(const std::vector<int>& event_counts,
         for (int i=0; i < world_.size; ++i){
           ranks[i] = i;
         }
-      } else {
-        ranks.resize(grp->global_ranks.size());
-        for (int i=0; i < grp->global_ranks.size(); ++i){
-          ranks[i] = grp->global_ranks[i];
-        }
+      } else if (grp->global_ranks) {
+        ranks.assign(grp->global_ranks->begin(), grp->global_ranks->end());
       }
 
 
@@ -995,8 +591,7 @@ OTF2_Writer::write_global_def_file(const std::vector<int>& event_counts,
     if (comm->name){
       comm_name_ref_id = otf2_strings_table_.get(comm->name);
     } else {
-      std::string comm_name = "MPI_Comm " + std::to_string(comm->global_id);
-      comm_name_ref_id = otf2_strings_table_.insert(comm_name);
+      comm_name_ref_id = otf2_strings_table_.get("MPI_Comm " + std::to_string(comm->global_id));
     }
 
     int parent_comm_ref_id = comm->parent ? comm->parent->global_id : OTF2_UNDEFINED_COMM;
@@ -1128,13 +723,15 @@ OTF2_Writer::set_clock_resolution(uint64_t ticks_per_second) {
 // TODO type sizes should be rank specific.
 void
 OTF2_Writer::register_type(mpi_type_t type, int size) {
+  if (type < 0) return;
+  if (type >= (int)type_sizes_.size()) type_sizes_.resize(type + 1, -1);
   type_sizes_[type] = size;
 }
 
 OTF2_WRITER_RESULT OTF2_Writer::mpi_send_inner(otf2_time_t start, mpi_type_t type, uint64_t count,
                                                uint32_t dest, mpi_comm_t comm, uint32_t tag) {
   OTF2_EvtWriter_MpiSend(evt_writer_, nullptr, start, dest, get_trace_comm(comm),
-                         tag, type_sizes_[type]*count);
+                         tag, std::max(type_size(type), 0)*count);
   event_count_++;
   return OTF2_WRITER_SUCCESS;
 }
@@ -1142,14 +739,14 @@ OTF2_WRITER_RESULT OTF2_Writer::mpi_send_inner(otf2_time_t start, mpi_type_t typ
 OTF2_WRITER_RESULT OTF2_Writer::mpi_send(otf2_time_t start, otf2_time_t stop, mpi_type_t type,
                                          uint64_t count, uint32_t dest, mpi_comm_t comm, uint32_t tag)
 {
-  _ENTER("MPI_Send");
+  _ENTER(DUMPI_Send);
   mpi_send_inner(start, type, count, dest, comm, tag);
   _LEAVE();
 }
 
 OTF2_WRITER_RESULT OTF2_Writer::mpi_bsend(otf2_time_t start, otf2_time_t stop, mpi_type_t type,
                                           uint64_t count, uint32_t dest, mpi_comm_t comm, uint32_t tag) {
-  _ENTER("MPI_Bsend");
+  _ENTER(DUMPI_Bsend);
   mpi_send_inner(start, type, count, dest, comm, tag);
   _LEAVE();
 }
@@ -1157,14 +754,14 @@ OTF2_WRITER_RESULT OTF2_Writer::mpi_bsend(otf2_time_t start, otf2_time_t stop, m
 OTF2_WRITER_RESULT OTF2_Writer::mpi_ssend(otf2_time_t start, otf2_time_t stop,
                                           mpi_type_t type, uint64_t count, uint32_t dest,
                                           mpi_comm_t comm, uint32_t tag) {
-  _ENTER("MPI_Ssend");
+  _ENTER(DUMPI_Ssend);
   mpi_send_inner(start, type, count, dest, comm, tag);
   _LEAVE();
 }
 
 OTF2_WRITER_RESULT OTF2_Writer::mpi_rsend(otf2_time_t start, otf2_time_t stop, mpi_type_t type,
                                           uint64_t count, uint32_t dest, mpi_comm_t comm, uint32_t tag) {
-  _ENTER("MPI_Rsend");
+  _ENTER(DUMPI_Rsend);
   mpi_send_inner(start, type, count, dest, comm, tag);
   _LEAVE();
 }
@@ -1173,7 +770,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_recv(otf2_time_t start, otf2_time_t stop, mpi_type_t type, uint64_t count,
                       uint32_t source, mpi_comm_t comm, uint32_t tag)
 {
-  _ENTER("MPI_Recv");
+  _ENTER(DUMPI_Recv);
   OTF2_EvtWriter_MpiRecv(evt_writer_, nullptr, start, source, get_trace_comm(comm),
                          tag, count_bytes(type, count));
   event_count_++;
@@ -1181,11 +778,34 @@ OTF2_Writer::mpi_recv(otf2_time_t start, otf2_time_t stop, mpi_type_t type, uint
 }
 
 // I-event handling
-void
+request_slot*
 OTF2_Writer::incomplete_call(mpi_request_t request_id, REQUEST_TYPE type) {
-  if (request_id != null_request_){
-    request_type_[request_id] = type;
+  if (request_id == null_request_ || request_id < 0) return nullptr;
+  if (request_id >= (mpi_request_t)requests_.size()) {
+    requests_.resize(request_id + 1, request_slot());
+  }
+  request_slot& slot = requests_[request_id];
+  if (!slot.active) {
+    slot.active = true;
+    ++active_requests_;
+    peak_requests_ = std::max(peak_requests_, active_requests_);
+  }
+  slot.type = type;
+  return &slot;
+}
+
+bool
+OTF2_Writer::valid_requests(int count, const mpi_request_t* requests,
+                            const int* indices) {
+  for (int i = 0; i < count; i++){
+    mpi_request_t req = requests[indices ? indices[i] : i];
+    if (req < 0 && req != null_request_) {
+      logger(OWV_ERROR, std::string("Invalid request id (") + std::to_string(req)
+             + ") on rank " + std::to_string(world_.rank));
+      return false;
+    }
   }
+  return true;
 }
 
 /*
@@ -1196,48 +816,55 @@ OTF2_Writer::incomplete_call(mpi_request_t request_id, REQUEST_TYPE type) {
 void
 OTF2_Writer::complete_call(mpi_request_t request_id, uint64_t timestamp,
                            const mpi_status_t* status) {
-  auto iter = request_type_.find(request_id);
-  if (iter == request_type_.end()) {
-    if (request_id != null_request_){
-      std::cerr << "Error: request (" << request_id << ") not found"
-                << " on rank " << world_.rank << std::endl;
-      abort();
-    } else {
-      return;
-    }
+  if (request_id == null_request_) return;
+
+  request_slot* slot = find_request(request_id);
+  if (!slot || !slot->active) {
+    std::cerr << "Error: request (" << request_id << ") not found"
+              << " on rank " << world_.rank << std::endl;
+    abort();
   }
 
-  switch (iter->second){
+  switch (slot->type){
     case REQUEST_TYPE_ISEND:
       OTF2_EvtWriter_MpiIsendComplete(evt_writer_, nullptr, timestamp, request_id);
       event_count_++;
       break;
     case REQUEST_TYPE_IRECV: {
-      auto irecv_it = irecv_requests_.find(request_id);
-      irecv_capture irecv = irecv_it->second;
-      if (irecv_it == irecv_requests_.end()) {
-        std::cerr << "Error: request id (" << request_id << ") not found"
-                  << " while trying to complete MPI_IRecv" << std::endl;
-        abort();
-      } else {
-        int tag = status ? status->tag : irecv.tag;
-        int source = status ? status->source : irecv.source;
-        if (tag == DUMPI_ANY_TAG){
-          throw std::runtime_error("got tag any, but no status with completion tag");
-        }
-        if (source == DUMPI_ANY_SOURCE){
-          throw std::runtime_error("got source any, but no status with completion source");
-        }
-        OTF2_EvtWriter_MpiIrecv(evt_writer_, nullptr, timestamp, source,
-                              get_trace_comm(irecv.comm), tag, irecv.bytes_sent, request_id);
-        //irecv.tag, irecv.bytes_sent - these could be any's
-        //trace must be 'deterministic' - force specific recvs
-        irecv_requests_.erase(irecv_it);
-        event_count_++;
+      const irecv_capture& irecv = slot->irecv;
+      int tag = status ? status->tag : irecv.tag;
+      int source = status ? status->source : irecv.source;
+      if (tag == DUMPI_ANY_TAG){
+        throw std::runtime_error("got tag any, but no status with completion tag");
+      }
+      if (source == DUMPI_ANY_SOURCE){
+        throw std::runtime_error("got source any, but no status with completion source");
       }
+      OTF2_EvtWriter_MpiIrecv(evt_writer_, nullptr, timestamp, source,
+                            get_trace_comm(irecv.comm), tag, irecv.bytes_sent, request_id);
+      //irecv.tag, irecv.bytes_sent - these could be any's
+      //trace must be 'deterministic' - force specific recvs
+      event_count_++;
     }
   }
-  request_type_.erase(iter);
+  slot->active = false;
+  slot->completed_batch = completion_batch_;
+  --active_requests_;
+}
+
+void
+OTF2_Writer::complete_calls(int count, const mpi_request_t* requests, const int* indices,
+                            uint64_t timestamp, const mpi_status_t* statuses) {
+  // Batch 0 is what fresh slots hold, so never use it
+  if (++completion_batch_ == 0) ++completion_batch_;
+  for (int i = 0; i < count; i++){
+    int idx = indices ? indices[i] : i;
+    mpi_request_t req = requests[idx];
+    if (req == null_request_) continue;
+    request_slot* slot = find_request(req);
+    if (slot && !slot->active && slot->completed_batch == completion_batch_) continue;
+    complete_call(req, timestamp, statuses ? &statuses[idx] : nullptr);
+  }
 }
 
 OTF2_WRITER_RESULT
@@ -1255,7 +882,8 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_isend(otf2_time_t start, otf2_time_t stop, mpi_type_t type, uint64_t count,
                        uint32_t dest, int comm, uint32_t tag, mpi_request_t request)
 {
-  _ENTER("MPI_Isend");
+  _CHECK_REQUESTS(1, &request, nullptr);
+  _ENTER(DUMPI_Isend);
   mpi_isend_inner(start, type, count, dest, comm, tag, request);
   _LEAVE();
 }
@@ -1264,7 +892,8 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_ibsend(otf2_time_t start, otf2_time_t stop, mpi_type_t type, uint64_t count,
                         uint32_t dest, mpi_comm_t comm, uint32_t tag, mpi_request_t request)
 {
-  _ENTER("MPI_Ibsend");
+  _CHECK_REQUESTS(1, &request, nullptr);
+  _ENTER(DUMPI_Ibsend);
   mpi_isend_inner(start, type, count, dest, comm, tag, request);
   _LEAVE();
 }
@@ -1273,7 +902,8 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_issend(otf2_time_t start, otf2_time_t stop, mpi_type_t type, uint64_t count,
                         uint32_t dest, mpi_comm_t comm, uint32_t tag, mpi_request_t request)
 {
-  _ENTER("MPI_Issend");
+  _CHECK_REQUESTS(1, &request, nullptr);
+  _ENTER(DUMPI_Issend);
   mpi_isend_inner(start, type, count, dest, comm, tag, request);
   _LEAVE();
 }
@@ -1282,7 +912,8 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_irsend(otf2_time_t start, otf2_time_t stop, mpi_type_t type, uint64_t count,
                         uint32_t dest, mpi_comm_t comm, uint32_t tag, mpi_request_t request)
 {
-  _ENTER("MPI_Irsend");
+  _CHECK_REQUESTS(1, &request, nullptr);
+  _ENTER(DUMPI_Irsend);
   mpi_isend_inner(start, type, count, dest, comm, tag, request);
   _LEAVE();
 }
@@ -1291,18 +922,19 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_irecv(otf2_time_t start, otf2_time_t stop, mpi_type_t type, uint64_t count,
                        uint32_t source, mpi_comm_t comm, uint32_t tag, mpi_request_t request)
 {
-  _ENTER("MPI_Irecv");
-  irecv_requests_[request] = {count_bytes(type, count), source, tag, comm, request};
-  incomplete_call(request, REQUEST_TYPE_IRECV);
+  _CHECK_REQUESTS(1, &request, nullptr);
+  _ENTER(DUMPI_Irecv);
+  request_slot* slot = incomplete_call(request, REQUEST_TYPE_IRECV);
+  if (slot) slot->irecv = {count_bytes(type, count), source, tag, comm, request};
   OTF2_EvtWriter_MpiIrecvRequest(evt_writer_, nullptr, start, request);
   event_count_++;
   _LEAVE();
 }
 
 OTF2_WRITER_RESULT
-OTF2_Writer::generic_call(otf2_time_t start, otf2_time_t stop, const std::string& name)
+OTF2_Writer::generic_call(otf2_time_t start, otf2_time_t stop, dumpi_function func)
 {
-  _ENTER(name);
+  _ENTER(func);
   _LEAVE();
 }
 
@@ -1310,7 +942,8 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_wait(otf2_time_t start, otf2_time_t stop, mpi_request_t request,
                       const mpi_status_t* status)
 {
-  _ENTER("MPI_Wait");
+  _CHECK_REQUESTS(1, &request, nullptr);
+  _ENTER(DUMPI_Wait);
   complete_call(request, start, status);
   _LEAVE();
 }
@@ -1319,7 +952,8 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_waitany(otf2_time_t start, otf2_time_t stop, mpi_request_t request,
                          const mpi_status_t* status)
 {
-  _ENTER("MPI_Waitany");
+  _CHECK_REQUESTS(1, &request, nullptr);
+  _ENTER(DUMPI_Waitany);
   complete_call(request, start, status);
   _LEAVE();
 }
@@ -1329,16 +963,9 @@ OTF2_Writer::mpi_waitall(otf2_time_t start, otf2_time_t stop,
                          int count, const mpi_request_t* requests,
                          const mpi_status_t* statuses)
 {
-  _ENTER("MPI_Waitall");
-
-  std::unordered_set<mpi_request_t> called;
-  for(int i = 0; i < count; i++) {
-    auto req = requests[i];
-    if (req != null_request_ && called.find(req) == called.end()) {
-      complete_call(req, start, statuses ? &statuses[i] : nullptr);
-      called.insert(req);
-    }
-  }
+  _CHECK_REQUESTS(count, requests, nullptr);
+  _ENTER(DUMPI_Waitall);
+  complete_calls(count, requests, nullptr, start, statuses);
   _LEAVE();
 }
 
@@ -1346,11 +973,9 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_waitsome(otf2_time_t start, otf2_time_t stop, const mpi_request_t* requests,
                           int outcount, const int* indices, const mpi_status_t* statuses)
 {
-  _ENTER("MPI_Waitsome");
-  for (int i = 0; i < outcount; i++){
-    int idx = indices[i];
-    complete_call(requests[idx], start, statuses ? &statuses[idx] : nullptr);
-  }
+  _CHECK_REQUESTS(outcount, requests, indices);
+  _ENTER(DUMPI_Waitsome);
+  complete_calls(outcount, requests, indices, start, statuses);
   _LEAVE();
 }
 
@@ -1358,7 +983,8 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_test(otf2_time_t start, otf2_time_t stop, mpi_request_t request, int flag,
                       const mpi_status_t* status)
 {
-  _ENTER("MPI_Test");
+  _CHECK_REQUESTS(1, &request, nullptr);
+  _ENTER(DUMPI_Test);
   if (flag){
     complete_call(request, start, status);
   }
@@ -1369,7 +995,8 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_testany(otf2_time_t start, otf2_time_t stop, const mpi_request_t* requests,
                          int index, int flag, const mpi_status_t* status)
 {
-  _ENTER("MPI_Testany");
+  if (flag) { _CHECK_REQUESTS(1, &requests[index], nullptr); }
+  _ENTER(DUMPI_Testany);
   if (flag){
     complete_call(requests[index], start, status);
   }
@@ -1381,11 +1008,10 @@ OTF2_Writer::mpi_testall(otf2_time_t start, otf2_time_t stop, int count,
                          const mpi_request_t* requests, int flag,
                          const mpi_status_t* statuses)
 {
-  _ENTER("MPI_Testall");
+  if (flag) { _CHECK_REQUESTS(count, requests, nullptr); }
+  _ENTER(DUMPI_Testall);
   if (flag){
-    for (int i = 0; i < count; i++){
-      complete_call(requests[i], start, statuses ? &statuses[i] : nullptr);
-    }
+    complete_calls(count, requests, nullptr, start, statuses);
   }
   _LEAVE();
 }
@@ -1395,18 +1021,16 @@ OTF2_Writer::mpi_testsome(otf2_time_t start, otf2_time_t stop,
                           const mpi_request_t* requests, int outcount, const int* indices,
                           const mpi_status_t* statuses)
 {
-  _ENTER("MPI_Testsome");
-  for (int i = 0; i < outcount; i++){
-    int idx = indices[i];
-    complete_call(requests[idx], start, statuses ? &statuses[idx] : nullptr);
-  }
+  _CHECK_REQUESTS(outcount, requests, indices);
+  _ENTER(DUMPI_Testsome);
+  complete_calls(outcount, requests, indices, start, statuses);
   _LEAVE();
 }
 
 OTF2_WRITER_RESULT
 OTF2_Writer::mpi_barrier(otf2_time_t start, otf2_time_t stop, mpi_comm_t comm)
 {
-  _ENTER("MPI_Barrier");
+  _ENTER(DUMPI_Barrier);
   int root = undefined_root;
   COLLECTIVE_WRAPPER(OTF2_COLLECTIVE_OP_BARRIER, 0, 0);
   _LEAVE();
@@ -1416,7 +1040,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_bcast(otf2_time_t start, otf2_time_t stop, int count, mpi_type_t type,
                        int root, mpi_comm_t comm)
 {
-  _ENTER("MPI_Bcast");
+  _ENTER(DUMPI_Bcast);
 
   auto my_comm = comms_[comm];
   int bytes = my_comm->local_rank == root ? count_bytes(type, count) : 0;
@@ -1430,7 +1054,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_gather(otf2_time_t start, otf2_time_t stop, int sendcount, mpi_type_t sendtype,
                         int recvcount, mpi_type_t recvtype, int root, mpi_comm_t comm)
 {
-  _ENTER("MPI_Gather");
+  _ENTER(DUMPI_Gather);
 
   dumpi::OTF2_MPI_Comm::shared_ptr my_comm = comms_[comm];
   bool is_root = my_comm->local_rank == root;
@@ -1446,7 +1070,7 @@ OTF2_Writer::mpi_gatherv(otf2_time_t start, otf2_time_t stop, int comm_size, int
                          mpi_type_t sendtype, const int* recvcounts, mpi_type_t recvtype,
                          int root, mpi_comm_t comm)
 {
-  _ENTER("MPI_Gatherv");
+  _ENTER(DUMPI_Gatherv);
 
   dumpi::OTF2_MPI_Comm::shared_ptr my_comm = comms_[comm];
   bool is_root = my_comm->local_rank == root;
@@ -1463,7 +1087,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_scatter(otf2_time_t start, otf2_time_t stop, int sendcount, mpi_type_t sendtype,
                          int recvcount, mpi_type_t recvtype, int root, mpi_comm_t comm)
 {
-  _ENTER("MPI_Scatter");
+  _ENTER(DUMPI_Scatter);
 
   dumpi::OTF2_MPI_Comm::shared_ptr my_comm = comms_[comm];
   bool is_root = my_comm->local_rank == root;
@@ -1480,7 +1104,7 @@ OTF2_Writer::mpi_scatterv(otf2_time_t start, otf2_time_t stop, int comm_size,
                           const int* sendcounts, mpi_type_t sendtype,
                           int recvcount, mpi_type_t recvtype, int root, mpi_comm_t comm)
 {
-  _ENTER("MPI_Scatterv");
+  _ENTER(DUMPI_Scatterv);
 
   dumpi::OTF2_MPI_Comm::shared_ptr my_comm = comms_[comm];
   bool is_root = my_comm->local_rank == root;
@@ -1495,7 +1119,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_reduce(otf2_time_t start, otf2_time_t stop, int count,
                         mpi_type_t type, int root, mpi_comm_t comm)
 {
-  _ENTER("MPI_Reduce");
+  _ENTER(DUMPI_Reduce);
 
   dumpi::OTF2_MPI_Comm::shared_ptr my_comm = comms_[comm];
   bool is_root = my_comm->local_rank == root;
@@ -1513,7 +1137,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_scan(otf2_time_t start, otf2_time_t stop, int count,
                       mpi_type_t datatype, mpi_comm_t comm)
 {
-  _ENTER("MPI_Scan");
+  _ENTER(DUMPI_Scan);
   OTF2_MPI_Comm::shared_ptr my_comm = comms_[comm];
   int bytes = count_bytes(datatype, count);
   int send_bytes = (my_comm->size() - my_comm->local_rank) * bytes;
@@ -1529,7 +1153,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_allgather(otf2_time_t start, otf2_time_t stop, int sendcount, mpi_type_t sendtype,
                            int recvcount, mpi_type_t recvtype, mpi_comm_t comm)
 {
-  _ENTER("MPI_Allgather");
+  _ENTER(DUMPI_Allgather);
 
   auto my_comm = comms_[comm];
   int root = undefined_root;
@@ -1544,7 +1168,7 @@ OTF2_Writer::mpi_allgatherv(otf2_time_t start, otf2_time_t stop, int comm_size,
                             int sendcount, mpi_type_t sendtype,
                             const int* recvcounts, mpi_type_t recvtype, mpi_comm_t comm)
 {
-  _ENTER("MPI_Allgatherv");
+  _ENTER(DUMPI_Allgatherv);
   int root = undefined_root;
   COLLECTIVE_WRAPPER(OTF2_COLLECTIVE_OP_ALLGATHERV,
                      comm_size * count_bytes(sendtype, sendcount),
@@ -1556,7 +1180,7 @@ OTF2_Writer::mpi_alltoall(otf2_time_t start, otf2_time_t stop,
                           int sendcount, mpi_type_t sendtype, int recvcount,
                           mpi_type_t recvtype, mpi_comm_t comm)
 {
-  _ENTER("MPI_Alltoall");
+  _ENTER(DUMPI_Alltoall);
   int root = undefined_root;
   auto my_comm = comms_[comm];
   int transmitted = my_comm->size() * count_bytes(recvtype, recvcount);
@@ -1570,7 +1194,7 @@ OTF2_Writer::mpi_alltoallv(otf2_time_t start, otf2_time_t stop, int comm_size,
                            const int* sendcounts, mpi_type_t sendtype,
                            const int* recvcounts, mpi_type_t recvtype, mpi_comm_t comm)
 {
-  _ENTER("MPI_Alltoallv");
+  _ENTER(DUMPI_Alltoallv);
   int root = undefined_root;
   COLLECTIVE_WRAPPER(OTF2_COLLECTIVE_OP_ALLTOALLV,
                      count_bytes(sendtype, array_sum(sendcounts, comm_size)),
@@ -1582,7 +1206,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_allreduce(otf2_time_t start, otf2_time_t stop, int count,
                            mpi_type_t type, mpi_comm_t comm)
 {
-  _ENTER("MPI_Allreduce");
+  _ENTER(DUMPI_Allreduce);
   int root = undefined_root;
   auto my_comm = comms_[comm];
   int bytes = count_bytes(type, count) * my_comm->size();
@@ -1596,11 +1220,11 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_reduce_scatter(otf2_time_t start, otf2_time_t stop, int comm_size,
                                 const int* recvcounts, mpi_type_t type, mpi_comm_t comm)
 {
-  _ENTER("MPI_Reduce_scatter");
+  _ENTER(DUMPI_Reduce_scatter);
   OTF2_MPI_Comm::shared_ptr comm_st = comms_[comm];
   int root = undefined_root;
   int sent = count_bytes(type, comm_size);
-  int recv = comm_size * recvcounts[comm_st->local_rank] * type_sizes_[type];
+  int recv = comm_size * recvcounts[comm_st->local_rank] * std::max(type_size(type), 0);
 
   COLLECTIVE_WRAPPER(OTF2_COLLECTIVE_OP_REDUCE_SCATTER,
                      sent,
@@ -1622,7 +1246,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_group_union(otf2_time_t start, otf2_time_t stop,
                              int group1, int group2, int newgroup)
 {
-  _ENTER("MPI_Group_union");
+  _ENTER(DUMPI_Group_union);
   _LEAVE();
 }
 
@@ -1640,7 +1264,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_group_difference(otf2_time_t start, otf2_time_t stop,
                                   mpi_group_t group1, mpi_group_t group2, mpi_group_t newgroup)
 {
-  _ENTER("MPI_Group_difference");
+  _ENTER(DUMPI_Group_difference);
   _LEAVE();
 }
 
@@ -1658,7 +1282,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_group_intersection(otf2_time_t start, otf2_time_t stop,
                                     mpi_group_t group1, mpi_group_t group2, mpi_group_t newgroup)
 {
-  _ENTER("MPI_Group_intersection");
+  _ENTER(DUMPI_Group_intersection);
   _LEAVE();
 }
 
@@ -1670,10 +1294,11 @@ OTF2_Writer::mpi_group_incl_first_pass(mpi_group_t group, mpi_group_t count,
   OTF2_MPI_Group::shared_ptr subGrp = groups_.make_new(newgroup);
 
   subGrp->local_id = newgroup;
-  subGrp->global_ranks.resize(count);
+  std::vector<int> members(count);
   for (int i=0; i < count; ++i){
-    subGrp->global_ranks[i] = parent->get_world_rank(ranks[i]);
+    members[i] = parent->get_world_rank(ranks[i]);
   }
+  subGrp->global_ranks = OTF2RankListTable::global().intern(std::move(members));
   return OTF2_WRITER_SUCCESS;
 }
 
@@ -1681,7 +1306,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_group_incl(otf2_time_t start, otf2_time_t stop,
                             mpi_group_t group, int count, const int* ranks, mpi_group_t newgroup)
 {
-  _ENTER("MPI_Group_incl");
+  _ENTER(DUMPI_Group_incl);
   _LEAVE();
 }
 
@@ -1689,26 +1314,19 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_group_excl_first_pass(mpi_group_t group, int count, const int* ranks, mpi_group_t newgroup)
 {
   OTF2_MPI_Group::shared_ptr parent = groups_[group];
-  OTF2_MPI_Group::shared_ptr subGrp = groups_[newgroup];
+  OTF2_MPI_Group::shared_ptr subGrp = groups_.make_new(newgroup);
   subGrp->local_id = newgroup;
 
-  std::set<int> sortedRanks;
-  for (int i=0; i < count; ++i) sortedRanks.insert(ranks[i]);
-  auto iter = sortedRanks.begin();
-
-  int numParentRanks = parent->global_ranks.size();
-  subGrp->global_ranks.resize(numParentRanks - count);
-  int nextInsertIndex = 0;
+  std::set<int> excluded(ranks, ranks + count);
+  int numParentRanks = parent->size();
+  std::vector<int> members;
+  members.reserve(numParentRanks - excluded.size());
   for (int i=0; i < numParentRanks; ++i){
-    int nextToAvoid = *iter;
-    int nextRank = parent->global_ranks[i];
-    if (nextToAvoid == i){
-      ++iter;
-    } else {
-      subGrp->global_ranks[nextInsertIndex] = nextRank;
-      ++nextInsertIndex;
+    if (!excluded.count(i)){
+      members.push_back(parent->get_world_rank(i));
     }
   }
+  subGrp->global_ranks = OTF2RankListTable::global().intern(std::move(members));
   return OTF2_WRITER_SUCCESS;
 }
 
@@ -1716,7 +1334,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_group_excl(otf2_time_t start, otf2_time_t stop,
                             mpi_group_t group, int count, const int* ranks, mpi_group_t newgroup)
 {
-  _ENTER("MPI_Group_excl");
+  _ENTER(DUMPI_Group_excl);
   _LEAVE();
 }
 
@@ -1733,14 +1351,14 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_group_range_incl(otf2_time_t start, otf2_time_t stop,
                                   mpi_group_t group, int count, int**ranges, mpi_group_t newgroup)
 {
-  _ENTER("MPI_Group_range_incl");
+  _ENTER(DUMPI_Group_range_incl);
   _LEAVE();
 }
 
 bool
 OTF2_Writer::type_is_known(mpi_type_t type)
 {
-  if (type_sizes_.find(type) == type_sizes_.end()) {
+  if (type_size(type) < 0) {
     logger(OWV_WARN, std::string("Unknown Type (") + std::to_string(type));
     return false;
   }
@@ -1766,7 +1384,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_comm_dup(otf2_time_t start, otf2_time_t stop,
                           mpi_comm_t comm, mpi_comm_t newcomm)
 {
-  _ENTER("MPI_Comm_dup");
+  _ENTER(DUMPI_Comm_dup);
   _LEAVE();
 }
 
@@ -1777,6 +1395,17 @@ OTF2_Writer::reverse_versions()
   groups_.reverse();
 }
 
+void
+OTF2_Writer::release_rank_state()
+{
+  comms_ = versioned_shared_ptr_map<int, OTF2_MPI_Comm>();
+  groups_ = versioned_shared_ptr_map<int, OTF2_MPI_Group>();
+  std::vector<OTF2_MPI_Comm::shared_ptr>().swap(unique_comms_);
+  std::vector<request_slot>().swap(requests_);
+  std::vector<int>().swap(type_sizes_);
+  pending_comm_ = nullptr;
+}
+
 OTF2_WRITER_RESULT
 OTF2_Writer::mpi_comm_free(otf2_time_t start, otf2_time_t stop, mpi_comm_t comm)
 {
@@ -1807,7 +1436,8 @@ OTF2_Writer::mpi_comm_group_first_pass(mpi_comm_t comm, mpi_group_t group)
 }
 
 OTF2_MPI_Group::shared_ptr
-OTF2_Writer::make_comm_split(OTF2_MPI_Comm::shared_ptr comm, const std::vector<int> &world_ranks)
+OTF2_Writer::make_comm_split(OTF2_MPI_Comm::shared_ptr comm,
+                             const OTF2RankListTable::list_ptr& world_ranks)
 {
   comm->is_root = comm->local_rank == 0;
   if (comm->is_root){
@@ -1824,7 +1454,7 @@ OTF2_Writer::make_comm_split(OTF2_MPI_Comm::shared_ptr comm, const std::vector<i
 OTF2_WRITER_RESULT
 OTF2_Writer::mpi_comm_group(otf2_time_t start, otf2_time_t stop, mpi_comm_t comm, mpi_group_t group)
 {
-  _ENTER("MPI_Comm_group");
+  _ENTER(DUMPI_Comm_group);
   _LEAVE();
 }
 
@@ -1839,7 +1469,7 @@ OTF2_Writer::mpi_comm_create_first_pass(mpi_comm_t comm, mpi_group_t group, mpi_
   sub_comm->local_id = newcomm;
   sub_comm->parent = parent_comm;
   sub_comm->group = subgrp;
-  sub_comm->is_root = world_.rank == subgrp->global_ranks[0];
+  sub_comm->is_root = subgrp->size() > 0 && world_.rank == subgrp->get_world_rank(0);
   sub_comm->local_rank = get_group_rank(world_.rank, subgrp);
   sub_comm->world_rank = parent_comm->world_rank;
 
@@ -1855,7 +1485,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_comm_create(otf2_time_t start, otf2_time_t stop, mpi_comm_t comm,
                              mpi_group_t group, mpi_comm_t newcomm)
 {
-  _ENTER("MPI_Comm_create");
+  _ENTER(DUMPI_Comm_create);
   _LEAVE();
 }
 
@@ -1882,7 +1512,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_comm_split(otf2_time_t start, otf2_time_t stop, mpi_comm_t oldcomm,
                             int color, int key, mpi_comm_t newcomm)
 {
-  _ENTER("MPI_Comm_split");
+  _ENTER(DUMPI_Comm_split);
   _LEAVE();
 }
 
@@ -1890,14 +1520,14 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_type_contiguous(otf2_time_t start, otf2_time_t stop,
                                  int count, mpi_type_t oldtype, mpi_type_t newtype)
 {
-  _ENTER("MPI_Type_contiguous");
+  _ENTER(DUMPI_Type_contiguous);
 
   if (!type_is_known(oldtype)){
     logger(OWV_ERROR, std::string("MPI_type_contiguous failed"));
     return OTF2_WRITER_ERROR_UKNOWN_MPI_TYPE;
   }
 
-  type_sizes_[newtype] = count_bytes(oldtype, count);
+  register_type(newtype, count_bytes(oldtype, count));
 
   _LEAVE();
 }
@@ -1906,7 +1536,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_type_hvector(otf2_time_t start, otf2_time_t stop, int count,
                               int blocklength, mpi_type_t oldtype, mpi_type_t newtype)
 {
-  _ENTER("MPI_Type_hvector");
+  _ENTER(DUMPI_Type_hvector);
   mpi_t_vector_inner("MPI_Type_hvector", count, blocklength, oldtype, newtype);
   _LEAVE();
 }
@@ -1915,7 +1545,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_type_vector(otf2_time_t start, otf2_time_t stop, int count,
                              int blocklength, mpi_type_t oldtype, mpi_type_t newtype)
 {
-  _ENTER("MPI_Type_vector");
+  _ENTER(DUMPI_Type_vector);
   mpi_t_vector_inner("MPI_Type_vector", count, blocklength, oldtype, newtype);
   _LEAVE();
 }
@@ -1928,14 +1558,14 @@ OTF2_Writer::mpi_t_vector_inner(const char* fname, int count, int blocklength,
     logger(OWV_ERROR, std::string(fname) + " failed");
     return;
   }
-  type_sizes_[newtype] = count_bytes(oldtype, blocklength) * count;
+  register_type(newtype, count_bytes(oldtype, blocklength) * count);
 }
 
 OTF2_WRITER_RESULT
 OTF2_Writer::mpi_type_indexed(otf2_time_t start, otf2_time_t stop, int count,
                               const int* lengths, mpi_type_t oldtype, mpi_type_t newtype)
 {
-  _ENTER("MPI_Type_indexed");
+  _ENTER(DUMPI_Type_indexed);
   mpi_t_indexed_inner("MPI_Type_indexed", count, lengths, oldtype, newtype);
   _LEAVE();
 }
@@ -1944,7 +1574,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_type_hindexed(otf2_time_t start, otf2_time_t stop, int count,
                                const int* lengths, mpi_type_t oldtype, mpi_type_t newtype)
 {
-  _ENTER("MPI_Type_hindexed");
+  _ENTER(DUMPI_Type_hindexed);
   mpi_t_indexed_inner("MPI_Type_hindexed", count, lengths, oldtype, newtype);
   _LEAVE();
 }
@@ -1953,7 +1583,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_type_create_hindexed(otf2_time_t start, otf2_time_t stop, int count,
                                       const int*lengths, mpi_type_t oldtype, mpi_type_t newtype)
 {
-  _ENTER("MPI_Type_hindexed");
+  _ENTER(DUMPI_Type_hindexed);
   mpi_t_indexed_inner("MPI_Type_hindexed", count, lengths, oldtype, newtype);
   _LEAVE();
 }
@@ -1967,14 +1597,14 @@ OTF2_Writer::mpi_t_indexed_inner(const char* name, int count, const int* lengths
     return;
   }
 
-  type_sizes_[newtype] = count_bytes(oldtype, array_sum(lengths, count));
+  register_type(newtype, count_bytes(oldtype, array_sum(lengths, count)));
 }
 
 OTF2_WRITER_RESULT
 OTF2_Writer::mpi_type_struct(otf2_time_t start, otf2_time_t stop, int count,
                              const int* blocklengths, mpi_type_t* oldtypes, mpi_type_t newtype)
 {
-  _ENTER("MPI_Type_struct");
+  _ENTER(DUMPI_Type_struct);
   mpi_t_struct_inner("MPI_Type_struct", count, blocklengths, oldtypes, newtype);
   _LEAVE();
 }
@@ -1983,7 +1613,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_type_create_struct(otf2_time_t start, otf2_time_t stop, int count,
                                     const int* blocklengths, mpi_type_t* oldtypes, mpi_type_t newtype)
 {
-  _ENTER("MPI_Type_create_struct");
+  _ENTER(DUMPI_Type_create_struct);
   mpi_t_struct_inner("MPI_Type_create_struct", count, blocklengths, oldtypes, newtype);
   _LEAVE();
 }
@@ -2001,21 +1631,21 @@ OTF2_Writer::mpi_t_struct_inner(const char* fname, int count, const int* blockle
     sum += count_bytes(oldtypes[i], blocklengths[i]);
   }
 
-  type_sizes_[newtype] = sum;
+  register_type(newtype, sum);
 }
 
 OTF2_WRITER_RESULT
 OTF2_Writer::mpi_type_create_subarray(otf2_time_t start, otf2_time_t stop,
                                       int ndims, const int* subsizes, mpi_type_t oldtype, mpi_type_t newtype)
 {
-  _ENTER("MPI_Type_create_subarray");
+  _ENTER(DUMPI_Type_create_subarray);
 
   if (!type_is_known(oldtype)){
     logger(OWV_ERROR, std::string("MPI_Type_create_subarray failed"));
     return OTF2_WRITER_ERROR_UKNOWN_MPI_TYPE;
   }
 
-  type_sizes_[newtype] = count_bytes(oldtype, array_sum(subsizes, ndims));
+  register_type(newtype, count_bytes(oldtype, array_sum(subsizes, ndims)));
 
   _LEAVE();
 }
@@ -2024,7 +1654,7 @@ OTF2_WRITER_RESULT
 OTF2_Writer::mpi_type_create_hvector(otf2_time_t start, otf2_time_t stop, int count,
                                      int blocklength, mpi_type_t oldtype, mpi_type_t newtype)
 {
-  _ENTER("MPI_Type_create_hvector");
+  _ENTER(DUMPI_Type_create_hvector);
   mpi_t_vector_inner("MPI_Type_create_hvector", count, blocklength, oldtype, newtype);
   _LEAVE();
 }
@@ -2038,7 +1668,8 @@ OTF2_Writer::get_group_rank(int world_rank, OTF2_MPI_Group::shared_ptr group)
     return 0;
   }
 
-  auto& ranks = group->global_ranks;
+  if (!group->global_ranks) return -1;
+  auto& ranks = *group->global_ranks;
   for (int idx=0; idx < ranks.size(); ++idx){
     if (ranks[idx] == world_rank) return idx;
   }
@@ -2049,12 +1680,13 @@ OTF2_Writer::get_group_rank(int world_rank, OTF2_MPI_Group::shared_ptr group)
 uint64_t
 OTF2_Writer::count_bytes(mpi_type_t type, uint64_t count)
 {
- if (type_sizes_.find(type) == type_sizes_.end()) {
+ int size = type_size(type);
+ if (size < 0) {
    logger(OWV_ERROR, std::string("Unkown data type (")
           + std::to_string((int)type) + "). Assuming 4 bytes in size.");
    return 4*count;
  } else {
-   return type_sizes_[type]*count;
+   return size*count;
  }
 }
 
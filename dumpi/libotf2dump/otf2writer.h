@@ -47,7 +47,9 @@ Questions? Contact sst-macro-help@sandia.gov
 
 #include "otf2writer-defs.h"
 #include <memory>
+#include <bitset>
 #include <dumpi/common/constants.h>
+#include <dumpi/common/funclabels.h>
 
 namespace dumpi {
 
@@ -58,20 +60,21 @@ struct OTF2_MPI_Group {
   bool is_comm_self;
   bool written;
   int world_size;
-  std::vector<int> global_ranks;
+  // Shared with every other group that has the same members
+  OTF2RankListTable::list_ptr global_ranks;
 
   using shared_ptr = std::shared_ptr<OTF2_MPI_Group>;
 
   int size() const {
     if (is_comm_world) return world_size;
     else if (is_comm_self) return 1;
-    else return global_ranks.size();
+    else return global_ranks ? global_ranks->size() : 0;
   }
 
   int get_world_rank(int local_rank){
     if (is_comm_world) return local_rank;
     else if (is_comm_self) return 0;
-    else return global_ranks[local_rank];
+    else return (*global_ranks)[local_rank];
   }
 
   OTF2_MPI_Group() :
@@ -226,6 +229,14 @@ class OTF2_Writer {
     return stop_time_;
   }
 
+  /**
+   * The largest number of nonblocking requests that were outstanding
+   * at the same time on this rank
+   */
+  size_t peak_requests() const {
+    return peak_requests_;
+  }
+
   /**
    * When doing another pass, all the versions of a comm/group
    * with the same local ID need to be "reset" or reversed
@@ -241,7 +252,7 @@ class OTF2_Writer {
   void set_verbosity(OTF2_WRITER_VERBOSITY verbosity);
   void set_clock_resolution(uint64_t ticks_per_second);
 
-  OTF2_WRITER_RESULT generic_call(otf2_time_t start, otf2_time_t stop, const std::string& name);
+  OTF2_WRITER_RESULT generic_call(otf2_time_t start, otf2_time_t stop, dumpi_function func);
 
   OTF2_WRITER_RESULT mpi_send(otf2_time_t start, otf2_time_t stop, mpi_type_t type,
                               uint64_t count, uint32_t dest, mpi_comm_t comm, uint32_t tag);
@@ -433,8 +444,16 @@ class OTF2_Writer {
     write_global_comms_ = flag;
   }
 
-  void add_region(const std::string& name){
-    otf2_regions_table_.insert(name);
+  void add_region(dumpi_function func){
+    regions_used_.set(func);
+  }
+
+  /**
+   * The global def file is written by a single writer, so it has to
+   * know about the regions entered on every other rank.
+   */
+  void add_regions(const OTF2_Writer& other){
+    regions_used_ |= other.regions_used_;
   }
 
   mpi_comm_t get_trace_comm(mpi_comm_t local) const {
@@ -446,7 +465,14 @@ class OTF2_Writer {
   }
 
   OTF2_MPI_Group::shared_ptr make_comm_split(OTF2_MPI_Comm::shared_ptr comm,
-                                             const std::vector<int>& world_ranks);
+                                             const OTF2RankListTable::list_ptr& world_ranks);
+
+  /**
+   * Drop the communicators, groups, types and requests of this rank once
+   * its local definitions are written. Root communicators handed out by
+   * unique_comms() stay alive through those shared pointers.
+   */
+  void release_rank_state();
 
   static constexpr mpi_group_t COMM_LOCATIONS_GROUP_ID{0};
   static constexpr mpi_group_t MPI_GROUP_WORLD_ID{1};
@@ -469,6 +495,10 @@ class OTF2_Writer {
 
   uint64_t count_bytes(mpi_type_t type, uint64_t count);
 
+  int type_size(mpi_type_t type) const {
+    return (type >= 0 && type < (int)type_sizes_.size()) ? type_sizes_[type] : -1;
+  }
+
   bool type_is_known(mpi_type_t type);
 
   // For MPI call variants
@@ -484,11 +514,32 @@ class OTF2_Writer {
                            mpi_type_t oldtype, mpi_type_t newtype);
 
  private:
-  void incomplete_call(mpi_request_t request_id, REQUEST_TYPE type);
+  /**
+   * Mark a request as outstanding. Returns its slot, or null for the
+   * null request.
+   */
+  request_slot* incomplete_call(mpi_request_t request_id, REQUEST_TYPE type);
 
   void complete_call(mpi_request_t request_id, uint64_t timestamp,
                      const mpi_status_t* status);
 
+  /**
+   * Complete a set of requests from an array call (Waitall, Testsome, ...).
+   * If indices is null, the first count requests are completed, otherwise
+   * requests[indices[i]]. A request repeated within the set completes once.
+   */
+  void complete_calls(int count, const mpi_request_t* requests, const int* indices,
+                      uint64_t timestamp, const mpi_status_t* statuses);
+
+  // False (after logging an error) if any request id is negative and
+  // not the null request.
+  bool valid_requests(int count, const mpi_request_t* requests, const int* indices);
+
+  request_slot* find_request(mpi_request_t request_id) {
+    if (request_id < 0 || request_id >= (mpi_request_t)requests_.size()) return nullptr;
+    return &requests_[request_id];
+  }
+
   struct exception : public std::runtime_error {
     exception(const std::string& error) :
       std::runtime_error(error)
@@ -497,13 +548,15 @@ class OTF2_Writer {
 
   std::string directory_;
 
-  std::unordered_map<mpi_type_t, int> type_sizes_;
+  // Indexed by type id; -1 marks a type that was never registered
+  std::vector<int> type_sizes_;
 
   versioned_shared_ptr_map<int, OTF2_MPI_Comm> comms_;
   versioned_shared_ptr_map<int, OTF2_MPI_Group> groups_;
 
   OTF2DefTable otf2_strings_table_;
-  OTF2DefTable otf2_regions_table_;
+  // Region ids are dumpi_function ids; this records which ones were entered
+  std::bitset<DUMPI_END_OF_STREAM> regions_used_;
 
   OTF2_Archive* archive_ = nullptr;
   OTF2_TimeStamp start_time_;
@@ -514,8 +567,13 @@ class OTF2_Writer {
 
   static constexpr int undefined_root = -1;
   OTF2_EvtWriter* evt_writer_ = nullptr;
-  std::unordered_map<mpi_request_t, irecv_capture> irecv_requests_;
-  std::unordered_map<mpi_request_t, REQUEST_TYPE> request_type_;
+  // Outstanding nonblocking requests, indexed by the dumpi request id.
+  // libdumpi hands out small dense ids and reuses them, so slots are
+  // freed on completion and recycled rather than erased.
+  std::vector<request_slot> requests_;
+  size_t active_requests_ = 0;
+  size_t peak_requests_ = 0;
+  uint32_t completion_batch_ = 0;
 
   worldConfig world_;
 
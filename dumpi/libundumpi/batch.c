@@ -0,0 +1,390 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/libundumpi/batch.h>
+#include <dumpi/libundumpi/bindings.h>
+#include <dumpi/common/iodefs.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+struct undumpi_batch_state {
+  /** The profile we are reading from (NULL until the first batch). */
+  dumpi_profile      *profile;
+  /** Set once the end of the stream has been reached. */
+  int                 finished;
+  /** Backward compatibility flag, see undumpi_read_single_call. */
+  int                 mpi_finalized;
+  /** File offset of the next call record. */
+  int64_t             pos;
+  /** Datatype sizes from the trace (for the bytes column). */
+  dumpi_sizeof        sizes;
+  /** Parsers paired with the column capture functions. */
+  libundumpi_cbpair   callarr[DUMPI_END_OF_STREAM];
+};
+
+/* Convert a dumpi_clock to nanoseconds */
+static inline int64_t to_nsec(const dumpi_clock *clk) {
+  return (int64_t)clk->sec * 1000000000LL + clk->nsec;
+}
+
+/* Total bytes for count elements of a datatype, -1 if the size is unknown */
+static inline int64_t to_bytes(const undumpi_batch *batch, int count,
+                               dumpi_datatype datatype)
+{
+  const dumpi_sizeof *sizes = &batch->state->sizes;
+  if(datatype >= 0 && datatype < sizes->count && sizes->size != NULL)
+    return (int64_t)count * sizes->size[datatype];
+  return -1;
+}
+
+/* Fill the fields every call has; returns the index of the call. */
+static inline int capture_common(undumpi_batch *batch, uint16_t thread,
+                                 const dumpi_time *cpu, const dumpi_time *wall)
+{
+  int i = batch->count;
+  batch->thread[i] = thread;
+  batch->cpu_start[i] = to_nsec(&cpu->start);
+  batch->cpu_stop[i] = to_nsec(&cpu->stop);
+  batch->wall_start[i] = to_nsec(&wall->start);
+  batch->wall_stop[i] = to_nsec(&wall->stop);
+  return i;
+}
+
+static int capture_any(const void *prm, uint16_t thread, const dumpi_time *cpu,
+                       const dumpi_time *wall, const dumpi_perfinfo *perf,
+                       void *uarg)
+{
+  (void)prm; (void)perf;
+  capture_common((undumpi_batch*)uarg, thread, cpu, wall);
+  return 1;
+}
+
+/* Point-to-point calls share the layout {count, datatype, peer, tag, comm} */
+#define UNDUMPI_CAPTURE_P2P(NAME, PEER)                                 \
+static int capture_##NAME(const void *prm, uint16_t thread,             \
+                          const dumpi_time *cpu, const dumpi_time *wall, \
+                          const dumpi_perfinfo *perf, void *uarg)       \
+{                                                                       \
+  const dumpi_##NAME *val = (const dumpi_##NAME*)prm;                   \
+  undumpi_batch *batch = (undumpi_batch*)uarg;                          \
+  int i = capture_common(batch, thread, cpu, wall);                     \
+  (void)perf;                                                           \
+  batch->peer[i] = val->PEER;                                           \
+  batch->tag[i] = val->tag;                                             \
+  batch->comm[i] = val->comm;                                           \
+  batch->bytes[i] = to_bytes(batch, val->count, val->datatype);         \
+  return 1;                                                             \
+}
+
+UNDUMPI_CAPTURE_P2P(send, dest)
+UNDUMPI_CAPTURE_P2P(bsend, dest)
+UNDUMPI_CAPTURE_P2P(ssend, dest)
+UNDUMPI_CAPTURE_P2P(rsend, dest)
+UNDUMPI_CAPTURE_P2P(isend, dest)
+UNDUMPI_CAPTURE_P2P(ibsend, dest)
+UNDUMPI_CAPTURE_P2P(issend, dest)
+UNDUMPI_CAPTURE_P2P(irsend, dest)
+UNDUMPI_CAPTURE_P2P(send_init, dest)
+UNDUMPI_CAPTURE_P2P(bsend_init, dest)
+UNDUMPI_CAPTURE_P2P(ssend_init, dest)
+UNDUMPI_CAPTURE_P2P(rsend_init, dest)
+UNDUMPI_CAPTURE_P2P(recv, source)
+UNDUMPI_CAPTURE_P2P(irecv, source)
+UNDUMPI_CAPTURE_P2P(recv_init, source)
+
+static int capture_sendrecv(const void *prm, uint16_t thread,
+                            const dumpi_time *cpu, const dumpi_time *wall,
+                            const dumpi_perfinfo *perf, void *uarg)
+{
+  const dumpi_sendrecv *val = (const dumpi_sendrecv*)prm;
+  undumpi_batch *batch = (undumpi_batch*)uarg;
+  int i = capture_common(batch, thread, cpu, wall);
+  (void)perf;
+  batch->peer[i] = val->dest;
+  batch->tag[i] = val->sendtag;
+  batch->comm[i] = val->comm;
+  batch->bytes[i] = to_bytes(batch, val->sendcount, val->sendtype);
+  return 1;
+}
+
+static int capture_sendrecv_replace(const void *prm, uint16_t thread,
+                                    const dumpi_time *cpu,
+                                    const dumpi_time *wall,
+                                    const dumpi_perfinfo *perf, void *uarg)
+{
+  const dumpi_sendrecv_replace *val = (const dumpi_sendrecv_replace*)prm;
+  undumpi_batch *batch = (undumpi_batch*)uarg;
+  int i = capture_common(batch, thread, cpu, wall);
+  (void)perf;
+  batch->peer[i] = val->dest;
+  batch->tag[i] = val->sendtag;
+  batch->comm[i] = val->comm;
+  batch->bytes[i] = to_bytes(batch, val->count, val->datatype);
+  return 1;
+}
+
+/* Probes have a peer, tag and communicator but no payload */
+#define UNDUMPI_CAPTURE_PROBE(NAME)                                     \
+static int capture_##NAME(const void *prm, uint16_t thread,             \
+                          const dumpi_time *cpu, const dumpi_time *wall, \
+                          const dumpi_perfinfo *perf, void *uarg)       \
+{                                                                       \
+  const dumpi_##NAME *val = (const dumpi_##NAME*)prm;                   \
+  undumpi_batch *batch = (undumpi_batch*)uarg;                          \
+  int i = capture_common(batch, thread, cpu, wall);                     \
+  (void)perf;                                                           \
+  batch->peer[i] = val->source;                                         \
+  batch->tag[i] = val->tag;                                             \
+  batch->comm[i] = val->comm;                                           \
+  return 1;                                                             \
+}
+
+UNDUMPI_CAPTURE_PROBE(probe)
+UNDUMPI_CAPTURE_PROBE(iprobe)
+
+/* Collectives: ROOT is a field name or nothing, COUNT/TYPE the send side */
+#define UNDUMPI_CAPTURE_COLL(NAME, ROOT, COUNT, TYPE)                   \
+static int capture_##NAME(const void *prm, uint16_t thread,             \
+                          const dumpi_time *cpu, const dumpi_time *wall, \
+                          const dumpi_perfinfo *perf, void *uarg)       \
+{                                                                       \
+  const dumpi_##NAME *val = (const dumpi_##NAME*)prm;                   \
+  undumpi_batch *batch = (undumpi_batch*)uarg;                          \
+  int i = capture_common(batch, thread, cpu, wall);                     \
+  (void)perf;                                                           \
+  batch->peer[i] = ROOT;                                                \
+  batch->comm[i] = val->comm;                                           \
+  batch->bytes[i] = to_bytes(batch, val->COUNT, val->TYPE);             \
+  return 1;                                                             \
+}
+
+UNDUMPI_CAPTURE_COLL(bcast, val->root, count, datatype)
+UNDUMPI_CAPTURE_COLL(reduce, val->root, count, datatype)
+UNDUMPI_CAPTURE_COLL(gather, val->root, sendcount, sendtype)
+UNDUMPI_CAPTURE_COLL(scatter, val->root, sendcount, sendtype)
+UNDUMPI_CAPTURE_COLL(allreduce, UNDUMPI_BATCH_NONE, count, datatype)
+UNDUMPI_CAPTURE_COLL(scan, UNDUMPI_BATCH_NONE, count, datatype)
+UNDUMPI_CAPTURE_COLL(allgather, UNDUMPI_BATCH_NONE, sendcount, sendtype)
+UNDUMPI_CAPTURE_COLL(alltoall, UNDUMPI_BATCH_NONE, sendcount, sendtype)
+
+static int capture_barrier(const void *prm, uint16_t thread,
+                           const dumpi_time *cpu, const dumpi_time *wall,
+                           const dumpi_perfinfo *perf, void *uarg)
+{
+  const dumpi_barrier *val = (const dumpi_barrier*)prm;
+  undumpi_batch *batch = (undumpi_batch*)uarg;
+  int i = capture_common(batch, thread, cpu, wall);
+  (void)perf;
+  batch->comm[i] = val->comm;
+  return 1;
+}
+
+/* Set up parsers and capture functions for a batch. */
+static void populate_capture(libundumpi_cbpair *callarr) {
+  int i;
+  libundumpi_callbacks unused;
+  libundumpi_clear_callbacks(&unused);
+  libundumpi_populate_handlers(&unused, callarr);
+  for(i = 0; i < DUMPI_END_OF_STREAM; ++i)
+    callarr[i].callout = capture_any;
+#define UNDUMPI_SET_CAPTURE(FUNC, NAME)                         \
+  callarr[FUNC].callout = (libundumpi_unsafe_fun)capture_##NAME
+  UNDUMPI_SET_CAPTURE(DUMPI_Send, send);
+  UNDUMPI_SET_CAPTURE(DUMPI_Bsend, bsend);
+  UNDUMPI_SET_CAPTURE(DUMPI_Ssend, ssend);
+  UNDUMPI_SET_CAPTURE(DUMPI_Rsend, rsend);
+  UNDUMPI_SET_CAPTURE(DUMPI_Isend, isend);
+  UNDUMPI_SET_CAPTURE(DUMPI_Ibsend, ibsend);
+  UNDUMPI_SET_CAPTURE(DUMPI_Issend, issend);
+  UNDUMPI_SET_CAPTURE(DUMPI_Irsend, irsend);
+  UNDUMPI_SET_CAPTURE(DUMPI_Send_init, send_init);
+  UNDUMPI_SET_CAPTURE(DUMPI_Bsend_init, bsend_init);
+  UNDUMPI_SET_CAPTURE(DUMPI_Ssend_init, ssend_init);
+  UNDUMPI_SET_CAPTURE(DUMPI_Rsend_init, rsend_init);
+  UNDUMPI_SET_CAPTURE(DUMPI_Recv, recv);
+  UNDUMPI_SET_CAPTURE(DUMPI_Irecv, irecv);
+  UNDUMPI_SET_CAPTURE(DUMPI_Recv_init, recv_init);
+  UNDUMPI_SET_CAPTURE(DUMPI_Sendrecv, sendrecv);
+  UNDUMPI_SET_CAPTURE(DUMPI_Sendrecv_replace, sendrecv_replace);
+  UNDUMPI_SET_CAPTURE(DUMPI_Probe, probe);
+  UNDUMPI_SET_CAPTURE(DUMPI_Iprobe, iprobe);
+  UNDUMPI_SET_CAPTURE(DUMPI_Bcast, bcast);
+  UNDUMPI_SET_CAPTURE(DUMPI_Reduce, reduce);
+  UNDUMPI_SET_CAPTURE(DUMPI_Gather, gather);
+  UNDUMPI_SET_CAPTURE(DUMPI_Scatter, scatter);
+  UNDUMPI_SET_CAPTURE(DUMPI_Allreduce, allreduce);
+  UNDUMPI_SET_CAPTURE(DUMPI_Scan, scan);
+  UNDUMPI_SET_CAPTURE(DUMPI_Allgather, allgather);
+  UNDUMPI_SET_CAPTURE(DUMPI_Alltoall, alltoall);
+  UNDUMPI_SET_CAPTURE(DUMPI_Barrier, barrier);
+#undef UNDUMPI_SET_CAPTURE
+}
+
+undumpi_batch* undumpi_batch_alloc(int capacity) {
+  undumpi_batch *batch;
+  assert(capacity > 0);
+  assert((batch = (undumpi_batch*)calloc(1, sizeof(undumpi_batch))) != NULL);
+  batch->capacity = capacity;
+  assert((batch->function = (uint16_t*)malloc(capacity*sizeof(uint16_t)))
+         != NULL);
+  assert((batch->thread = (uint16_t*)malloc(capacity*sizeof(uint16_t)))
+         != NULL);
+  assert((batch->cpu_start = (int64_t*)malloc(capacity*sizeof(int64_t)))
+         != NULL);
+  assert((batch->cpu_stop = (int64_t*)malloc(capacity*sizeof(int64_t)))
+         != NULL);
+  assert((batch->wall_start = (int64_t*)malloc(capacity*sizeof(int64_t)))
+         != NULL);
+  assert((batch->wall_stop = (int64_t*)malloc(capacity*sizeof(int64_t)))
+         != NULL);
+  assert((batch->peer = (int32_t*)malloc(capacity*sizeof(int32_t))) != NULL);
+  assert((batch->tag = (int32_t*)malloc(capacity*sizeof(int32_t))) != NULL);
+  assert((batch->comm = (int32_t*)malloc(capacity*sizeof(int32_t))) != NULL);
+  assert((batch->bytes = (int64_t*)malloc(capacity*sizeof(int64_t))) != NULL);
+  assert((batch->offset = (int64_t*)malloc(capacity*sizeof(int64_t)))
+         != NULL);
+  assert((batch->state = (struct undumpi_batch_state*)
+          calloc(1, sizeof(struct undumpi_batch_state))) != NULL);
+  return batch;
+}
+
+void undumpi_batch_free(undumpi_batch *batch) {
+  if(batch == NULL) return;
+  free(batch->function);
+  free(batch->thread);
+  free(batch->cpu_start);
+  free(batch->cpu_stop);
+  free(batch->wall_start);
+  free(batch->wall_stop);
+  free(batch->peer);
+  free(batch->tag);
+  free(batch->comm);
+  free(batch->bytes);
+  free(batch->offset);
+  if(batch->state->sizes.size != NULL)
+    free(batch->state->sizes.size);
+  free(batch->state);
+  free(batch);
+}
+
+/* Set up the batch state the first time it is used with a profile */
+static void start_batch(dumpi_profile *profile, undumpi_batch *batch) {
+  struct undumpi_batch_state *state = batch->state;
+  state->profile = profile;
+  state->finished = 0;
+  state->mpi_finalized = 0;
+  state->sizes = undumpi_read_datatype_sizes(profile);
+  populate_capture(state->callarr);
+  assert(dumpi_start_stream_read(profile) != 0);
+  state->pos = DUMPI_READ_TELL(profile);
+}
+
+int undumpi_next_batch(dumpi_profile *profile, undumpi_batch *batch,
+                       int max_events)
+{
+  struct undumpi_batch_state *state;
+  dumpi_function currfunc;
+  int i;
+  assert(profile != NULL && profile->file != NULL && batch != NULL);
+  state = batch->state;
+  if(state->profile != profile)
+    start_batch(profile, batch);
+  if(max_events <= 0 || max_events > batch->capacity)
+    max_events = batch->capacity;
+  batch->count = 0;
+  while(batch->count < max_events && ! state->finished) {
+    if((currfunc = dumpi_read_next_function(profile)) >= DUMPI_END_OF_STREAM) {
+      state->finished = 1;
+      break;
+    }
+    if(state->mpi_finalized && currfunc == 0) {
+      /* Old-style end of stream (see undumpi_read_single_call) */
+      state->finished = 1;
+      break;
+    }
+    if(currfunc == DUMPI_Finalize)
+      state->mpi_finalized = 1;
+    i = batch->count;
+    batch->function[i] = (uint16_t)currfunc;
+    batch->offset[i] = state->pos;
+    batch->peer[i] = UNDUMPI_BATCH_NONE;
+    batch->tag[i] = UNDUMPI_BATCH_NONE;
+    batch->comm[i] = UNDUMPI_BATCH_NONE;
+    batch->bytes[i] = -1;
+    assert(state->callarr[currfunc].handler(profile,
+                                             state->callarr[currfunc].callout,
+                                             batch));
+    ++batch->count;
+    profile->pos = state->pos = DUMPI_READ_TELL(profile);
+    if(profile->pos >= dumpi_stream_end(profile) ||
+       profile->pos >= profile->terminate_pos)
+      state->finished = 1;
+  }
+  return batch->count;
+}
+
+int undumpi_batch_decode(dumpi_profile *profile, const undumpi_batch *batch,
+                         int index, const libundumpi_callbacks *callback,
+                         void *userarg)
+{
+  dumpi_function currfunc;
+  libundumpi_cbpair callarr[DUMPI_END_OF_STREAM] = {{NULL, NULL}};
+  int64_t resume;
+  int retval;
+  assert(profile != NULL && batch != NULL && callback != NULL);
+  if(index < 0 || index >= batch->count)
+    return 0;
+  libundumpi_populate_handlers(callback, callarr);
+  libundumpi_populate_callouts(callback, callarr);
+  resume = DUMPI_READ_TELL(profile);
+  assert(DUMPI_SEEK(profile, batch->offset[index], SEEK_SET) == 0);
+  currfunc = dumpi_read_next_function(profile);
+  retval = (currfunc == batch->function[index]);
+  if(retval)
+    retval = callarr[currfunc].handler(profile, callarr[currfunc].callout,
+                                       userarg);
+  assert(DUMPI_SEEK(profile, resume, SEEK_SET) == 0);
+  return retval;
+}
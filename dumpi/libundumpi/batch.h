@@ -0,0 +1,152 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_LIBUNDUMPI_BATCH_H
+#define DUMPI_LIBUNDUMPI_BATCH_H
+
+#include <dumpi/libundumpi/libundumpi.h>
+#include <dumpi/common/types.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \ingroup libundumpi
+   * \defgroup libundumpi_batch libundumpi/batch:  \
+   *    Pull-based, batched access to the MPI call stream.
+   */
+  /*@{*/ /* put subsequent doxygen comments in group libundumpi_batch */
+
+  /** Value used in the peer, tag and comm columns for calls where the
+   *  field does not apply (e.g. the peer of an MPI_Allreduce). */
+#define UNDUMPI_BATCH_NONE INT32_MIN
+
+  /** Internal state kept between calls to undumpi_next_batch. */
+  struct undumpi_batch_state;
+
+  /**
+   * A batch of decoded MPI calls, stored as a structure of arrays.
+   * Each column has room for capacity entries; the first count are valid.
+   *
+   * Only fields common to many calls are decoded into columns.
+   * The full argument list of any call can be obtained with
+   * undumpi_batch_decode (using the record offset in the trace).
+   */
+  typedef struct undumpi_batch {
+    /** The number of calls in this batch. */
+    int count;
+    /** The number of calls the columns have room for. */
+    int capacity;
+    /** The dumpi_function of each call. */
+    uint16_t *function;
+    /** The thread that made each call. */
+    uint16_t *thread;
+    /** CPU time at entry and exit (nanoseconds). */
+    int64_t *cpu_start, *cpu_stop;
+    /** Wall time at entry and exit (nanoseconds). */
+    int64_t *wall_start, *wall_stop;
+    /** Destination, source or root rank (or UNDUMPI_BATCH_NONE). */
+    int32_t *peer;
+    /** Message tag (or UNDUMPI_BATCH_NONE). */
+    int32_t *tag;
+    /** Communicator (or UNDUMPI_BATCH_NONE). */
+    int32_t *comm;
+    /** Bytes sent (count times datatype size), -1 if not known. */
+    int64_t *bytes;
+    /** File offset of each call record in the trace. */
+    int64_t *offset;
+    /** Internal state (stream position etc.) -- don't touch. */
+    struct undumpi_batch_state *state;
+  } undumpi_batch;
+
+  /**
+   * Allocate a batch with room for capacity calls.
+   * Release using undumpi_batch_free.
+   */
+  undumpi_batch* undumpi_batch_alloc(int capacity);
+
+  /**
+   * Release a batch.
+   */
+  void undumpi_batch_free(undumpi_batch *batch);
+
+  /**
+   * Decode up to max_events calls from the stream into the batch,
+   * replacing its previous contents.  The first call starts reading at the
+   * beginning of the stream (dumpi_start_stream_read should not be called);
+   * subsequent calls continue where the previous one stopped.
+   * A batch should only be used with one profile.
+   * \param profile     a profile previously opened using undumpi_open
+   * \param batch       the batch to fill
+   * \param max_events  the largest number of calls to read (at most the
+   *                    capacity of the batch; 0 means the full capacity)
+   * \return the number of calls in the batch (0 at the end of the stream).
+   */
+  int undumpi_next_batch(dumpi_profile *profile, undumpi_batch *batch,
+                         int max_events);
+
+  /**
+   * Decode the full arguments of one call in the batch and pass them to
+   * the matching callback.  The stream position used by undumpi_next_batch
+   * is left unchanged.
+   * \param profile    the profile the batch was read from
+   * \param batch      a batch filled by undumpi_next_batch
+   * \param index      the call in the batch (0 <= index < batch->count)
+   * \param callback   the functions that get called for each MPI function
+   * \param userarg    this argument gets sent back with the callback
+   * \return 1 on success, 0 on failure.
+   */
+  int undumpi_batch_decode(dumpi_profile *profile, const undumpi_batch *batch,
+                           int index, const libundumpi_callbacks *callback,
+                           void *userarg);
+
+  /*@}*/ /* close doxygen comment group */
+
+#ifdef __cplusplus
+} /* End of extern "C" block */
+#endif /* ! __cplusplus */
+
+#endif /* DUMPI_LIBUNDUMPI_BATCH_H */
@@ -43,27 +43,55 @@ Questions? Contact sst-macro-help@sandia.gov
 */
 
 #include <dumpi/libundumpi/bindings.h>
-#include <dumpi/libundumpi/freedefs.h>
+#include <dumpi/libundumpi/records.h>
 #include <dumpi/common/dumpiio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <assert.h>
 
 #define DUMPI_RELEASE_PERFTAGS(PERF) do {		\
 } while(0)
 
+/* Handed to callbacks for every record without perfcounters. */
+static const dumpi_perfinfo empty_perfinfo_;
+
+const dumpi_perfinfo* libundumpi_perfinfo_compat(dumpi_profile *profile,
+                                                 const dumpi_perfdata *perf)
+{
+  int i, count;
+  dumpi_perfinfo *compat;
+  if(perf->count <= 0)
+    return &empty_perfinfo_;
+  count = (perf->count < DUMPI_MAX_PERFCTRS ? perf->count : DUMPI_MAX_PERFCTRS);
+  if(profile->perfcompat == NULL) {
+    /* The label table is fixed for a profile, so copy it just once */
+    assert((profile->perfcompat =
+            (dumpi_perfinfo*)calloc(1, sizeof(dumpi_perfinfo))) != NULL);
+    for(i = 0; i < DUMPI_MAX_PERFCTRS; ++i)
+      memcpy(profile->perfcompat->counter_tag[i], perf->counter_tag[i],
+             DUMPI_MAX_PERFCTR_NAME);
+  }
+  compat = profile->perfcompat;
+  compat->count = count;
+  memcpy(compat->invalue, perf->invalue, count*sizeof(int64_t));
+  memcpy(compat->outvalue, perf->outvalue, count*sizeof(int64_t));
+  return compat;
+}
+
 int libundumpi_grab_send(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
   dumpi_send val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_send));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_send(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_send_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_send_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -72,16 +100,17 @@ int libundumpi_grab_recv(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_recv val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_recv));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_recv(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_recv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_recv_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_recv(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -90,16 +119,17 @@ int libundumpi_grab_get_count(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_get_count val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_get_count));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_get_count(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_get_count_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_get_count_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_get_count(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -108,15 +138,16 @@ int libundumpi_grab_bsend(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_bsend val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_bsend));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_bsend(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_bsend_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_bsend_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -125,15 +156,16 @@ int libundumpi_grab_ssend(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_ssend val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_ssend));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_ssend(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_ssend_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_ssend_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -142,15 +174,16 @@ int libundumpi_grab_rsend(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_rsend val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_rsend));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_rsend(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_rsend_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_rsend_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -159,15 +192,16 @@ int libundumpi_grab_buffer_attach(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_buffer_attach val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_buffer_attach));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_buffer_attach(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_buffer_attach_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_buffer_attach_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -176,15 +210,16 @@ int libundumpi_grab_buffer_detach(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_buffer_detach val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_buffer_detach));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_buffer_detach(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_buffer_detach_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_buffer_detach_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -193,15 +228,16 @@ int libundumpi_grab_isend(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_isend val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_isend));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_isend(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_isend_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_isend_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -210,15 +246,16 @@ int libundumpi_grab_ibsend(dumpi_profile *profile, libundumpi_unsafe_fun callout
   dumpi_ibsend val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_ibsend));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_ibsend(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_ibsend_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_ibsend_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -227,15 +264,16 @@ int libundumpi_grab_issend(dumpi_profile *profile, libundumpi_unsafe_fun callout
   dumpi_issend val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_issend));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_issend(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_issend_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_issend_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -244,15 +282,16 @@ int libundumpi_grab_irsend(dumpi_profile *profile, libundumpi_unsafe_fun callout
   dumpi_irsend val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_irsend));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_irsend(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_irsend_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_irsend_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -261,15 +300,16 @@ int libundumpi_grab_irecv(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_irecv val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_irecv));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_irecv(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_irecv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_irecv_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -278,16 +318,17 @@ int libundumpi_grab_wait(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_wait val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_wait));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_wait(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_wait_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_wait_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_wait(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -296,16 +337,17 @@ int libundumpi_grab_test(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_test val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_test));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_test(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_test_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_test_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_test(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -314,15 +356,16 @@ int libundumpi_grab_request_free(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_request_free val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_request_free));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_request_free(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_request_free_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_request_free_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -331,17 +374,17 @@ int libundumpi_grab_waitany(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_waitany val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_waitany));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_waitany(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_waitany_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.requests != NULL) DUMPI_FREE_REQUEST(val.requests);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_waitany_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_waitany(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -350,17 +393,17 @@ int libundumpi_grab_testany(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_testany val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_testany));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_testany(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_testany_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.requests != NULL) DUMPI_FREE_REQUEST(val.requests);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_testany_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_testany(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -369,17 +412,17 @@ int libundumpi_grab_waitall(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_waitall val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_waitall));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_waitall(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_waitall_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.requests != NULL) DUMPI_FREE_REQUEST(val.requests);
-  if(val.statuses != NULL) DUMPI_FREE_STATUS(val.statuses);
+    ((dumpi_waitall_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_waitall(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -388,17 +431,17 @@ int libundumpi_grab_testall(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_testall val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_testall));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_testall(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_testall_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.requests != NULL) DUMPI_FREE_REQUEST(val.requests);
-  if(val.statuses != NULL) DUMPI_FREE_STATUS(val.statuses);
+    ((dumpi_testall_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_testall(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -407,18 +450,17 @@ int libundumpi_grab_waitsome(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_waitsome val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_waitsome));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_waitsome(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_waitsome_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.requests != NULL) DUMPI_FREE_REQUEST(val.requests);
-  if(val.indices != NULL) DUMPI_FREE_INT(val.indices);
-  if(val.statuses != NULL) DUMPI_FREE_STATUS(val.statuses);
+    ((dumpi_waitsome_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_waitsome(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -427,18 +469,17 @@ int libundumpi_grab_testsome(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_testsome val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_testsome));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_testsome(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_testsome_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.requests != NULL) DUMPI_FREE_REQUEST(val.requests);
-  if(val.indices != NULL) DUMPI_FREE_INT(val.indices);
-  if(val.statuses != NULL) DUMPI_FREE_STATUS(val.statuses);
+    ((dumpi_testsome_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_testsome(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -447,16 +488,17 @@ int libundumpi_grab_iprobe(dumpi_profile *profile, libundumpi_unsafe_fun callout
   dumpi_iprobe val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_iprobe));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_iprobe(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_iprobe_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_iprobe_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_iprobe(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -465,16 +507,17 @@ int libundumpi_grab_probe(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_probe val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_probe));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_probe(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_probe_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_probe_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_probe(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -483,15 +526,16 @@ int libundumpi_grab_cancel(dumpi_profile *profile, libundumpi_unsafe_fun callout
   dumpi_cancel val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_cancel));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_cancel(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_cancel_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_cancel_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -500,16 +544,17 @@ int libundumpi_grab_test_cancelled(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_test_cancelled val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_test_cancelled));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_test_cancelled(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_test_cancelled_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_test_cancelled_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_test_cancelled(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -518,15 +563,16 @@ int libundumpi_grab_send_init(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_send_init val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_send_init));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_send_init(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_send_init_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_send_init_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -535,15 +581,16 @@ int libundumpi_grab_bsend_init(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_bsend_init val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_bsend_init));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_bsend_init(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_bsend_init_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_bsend_init_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -552,15 +599,16 @@ int libundumpi_grab_ssend_init(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_ssend_init val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_ssend_init));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_ssend_init(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_ssend_init_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_ssend_init_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -569,15 +617,16 @@ int libundumpi_grab_rsend_init(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_rsend_init val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_rsend_init));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_rsend_init(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_rsend_init_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_rsend_init_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -586,15 +635,16 @@ int libundumpi_grab_recv_init(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_recv_init val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_recv_init));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_recv_init(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_recv_init_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_recv_init_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -603,15 +653,16 @@ int libundumpi_grab_start(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_start val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_start));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_start(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_start_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_start_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -620,15 +671,16 @@ int libundumpi_grab_startall(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_startall val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_startall));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_startall(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_startall_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_startall_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -637,16 +689,17 @@ int libundumpi_grab_sendrecv(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_sendrecv val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_sendrecv));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_sendrecv(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_sendrecv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_sendrecv_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_sendrecv(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -655,16 +708,17 @@ int libundumpi_grab_sendrecv_replace(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_sendrecv_replace val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_sendrecv_replace));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_sendrecv_replace(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_sendrecv_replace_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_sendrecv_replace_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_sendrecv_replace(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -673,15 +727,16 @@ int libundumpi_grab_type_contiguous(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_type_contiguous val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_contiguous));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_contiguous(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_contiguous_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_contiguous_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -690,15 +745,16 @@ int libundumpi_grab_type_vector(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_type_vector val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_vector));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_vector(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_vector_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_vector_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -707,15 +763,16 @@ int libundumpi_grab_type_hvector(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_type_hvector val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_hvector));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_hvector(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_hvector_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_hvector_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -724,17 +781,17 @@ int libundumpi_grab_type_indexed(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_type_indexed val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_indexed));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_indexed(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_indexed_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.lengths != NULL) DUMPI_FREE_INT(val.lengths);
-  if(val.indices != NULL) DUMPI_FREE_INT(val.indices);
+    ((dumpi_type_indexed_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_indexed(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -743,17 +800,17 @@ int libundumpi_grab_type_hindexed(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_type_hindexed val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_hindexed));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_hindexed(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_hindexed_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.lengths != NULL) DUMPI_FREE_INT(val.lengths);
-  if(val.indices != NULL) DUMPI_FREE_INT(val.indices);
+    ((dumpi_type_hindexed_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_hindexed(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -762,17 +819,17 @@ int libundumpi_grab_type_struct(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_type_struct val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_struct));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_struct(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_struct_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.lengths != NULL) DUMPI_FREE_INT(val.lengths);
-  if(val.oldtypes != NULL) DUMPI_FREE_DATATYPE(val.oldtypes);
+    ((dumpi_type_struct_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_struct(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -781,15 +838,16 @@ int libundumpi_grab_address(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_address val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_address));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_address(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_address_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_address_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -798,15 +856,16 @@ int libundumpi_grab_type_extent(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_type_extent val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_extent));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_extent(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_extent_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_extent_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -815,15 +874,16 @@ int libundumpi_grab_type_size(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_type_size val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_size));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_size(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_size_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_size_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -832,15 +892,16 @@ int libundumpi_grab_type_lb(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_type_lb val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_lb));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_lb(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_lb_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_lb_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -849,15 +910,16 @@ int libundumpi_grab_type_ub(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_type_ub val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_ub));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_ub(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_ub_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_ub_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -866,15 +928,16 @@ int libundumpi_grab_type_commit(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_type_commit val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_commit));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_commit(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_commit_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_commit_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -883,15 +946,16 @@ int libundumpi_grab_type_free(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_type_free val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_free));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_free(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_free_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_free_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -900,16 +964,17 @@ int libundumpi_grab_get_elements(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_get_elements val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_get_elements));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_get_elements(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_get_elements_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_get_elements_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_get_elements(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -918,15 +983,16 @@ int libundumpi_grab_pack(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_pack val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_pack));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_pack(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_pack_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_pack_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -935,15 +1001,16 @@ int libundumpi_grab_unpack(dumpi_profile *profile, libundumpi_unsafe_fun callout
   dumpi_unpack val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_unpack));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_unpack(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_unpack_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_unpack_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -952,15 +1019,16 @@ int libundumpi_grab_pack_size(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_pack_size val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_pack_size));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_pack_size(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_pack_size_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_pack_size_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -969,15 +1037,16 @@ int libundumpi_grab_barrier(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_barrier val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_barrier));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_barrier(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_barrier_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_barrier_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -986,15 +1055,16 @@ int libundumpi_grab_bcast(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_bcast val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_bcast));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_bcast(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_bcast_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_bcast_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1003,15 +1073,16 @@ int libundumpi_grab_gather(dumpi_profile *profile, libundumpi_unsafe_fun callout
   dumpi_gather val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_gather));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_gather(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_gather_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_gather_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1020,17 +1091,17 @@ int libundumpi_grab_gatherv(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_gatherv val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_gatherv));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_gatherv(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_gatherv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
-  if(val.displs != NULL) DUMPI_FREE_INT(val.displs);
+    ((dumpi_gatherv_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_gatherv(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1039,15 +1110,16 @@ int libundumpi_grab_scatter(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_scatter val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_scatter));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_scatter(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_scatter_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_scatter_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1056,17 +1128,17 @@ int libundumpi_grab_scatterv(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_scatterv val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_scatterv));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_scatterv(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_scatterv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.sendcounts != NULL) DUMPI_FREE_INT(val.sendcounts);
-  if(val.displs != NULL) DUMPI_FREE_INT(val.displs);
+    ((dumpi_scatterv_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_scatterv(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1075,15 +1147,16 @@ int libundumpi_grab_allgather(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_allgather val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_allgather));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_allgather(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_allgather_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_allgather_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1092,17 +1165,17 @@ int libundumpi_grab_allgatherv(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_allgatherv val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_allgatherv));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_allgatherv(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_allgatherv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
-  if(val.displs != NULL) DUMPI_FREE_INT(val.displs);
+    ((dumpi_allgatherv_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_allgatherv(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1111,15 +1184,16 @@ int libundumpi_grab_alltoall(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_alltoall val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_alltoall));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_alltoall(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_alltoall_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_alltoall_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1128,19 +1202,17 @@ int libundumpi_grab_alltoallv(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_alltoallv val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_alltoallv));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_alltoallv(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_alltoallv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.sendcounts != NULL) DUMPI_FREE_INT(val.sendcounts);
-  if(val.senddispls != NULL) DUMPI_FREE_INT(val.senddispls);
-  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
-  if(val.recvdispls != NULL) DUMPI_FREE_INT(val.recvdispls);
+    ((dumpi_alltoallv_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_alltoallv(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1149,15 +1221,16 @@ int libundumpi_grab_reduce(dumpi_profile *profile, libundumpi_unsafe_fun callout
   dumpi_reduce val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_reduce));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_reduce(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_reduce_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_reduce_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1166,15 +1239,16 @@ int libundumpi_grab_op_create(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_op_create val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_op_create));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_op_create(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_op_create_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_op_create_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1183,15 +1257,16 @@ int libundumpi_grab_op_free(dumpi_profile *profile, libundumpi_unsafe_fun callou
   dumpi_op_free val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_op_free));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_op_free(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_op_free_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_op_free_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1200,15 +1275,16 @@ int libundumpi_grab_allreduce(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_allreduce val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_allreduce));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_allreduce(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_allreduce_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_allreduce_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1217,16 +1293,17 @@ int libundumpi_grab_reduce_scatter(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_reduce_scatter val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_reduce_scatter));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_reduce_scatter(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_reduce_scatter_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
+    ((dumpi_reduce_scatter_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_reduce_scatter(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1235,15 +1312,16 @@ int libundumpi_grab_scan(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_scan val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_scan));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_scan(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_scan_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_scan_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1252,15 +1330,16 @@ int libundumpi_grab_group_size(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_group_size val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_size));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_size(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_size_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_group_size_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1269,15 +1348,16 @@ int libundumpi_grab_group_rank(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_group_rank val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_rank));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_rank(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_rank_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_group_rank_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1286,17 +1366,17 @@ int libundumpi_grab_group_translate_ranks(dumpi_profile *profile, libundumpi_uns
   dumpi_group_translate_ranks val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_translate_ranks));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_translate_ranks(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_translate_ranks_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.ranks1 != NULL) DUMPI_FREE_INT(val.ranks1);
-  if(val.ranks2 != NULL) DUMPI_FREE_INT(val.ranks2);
+    ((dumpi_group_translate_ranks_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_group_translate_ranks(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1305,15 +1385,16 @@ int libundumpi_grab_group_compare(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_group_compare val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_compare));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_compare(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_compare_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_group_compare_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1322,15 +1403,16 @@ int libundumpi_grab_comm_group(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_comm_group val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_group));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_group(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_group_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_group_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1339,15 +1421,16 @@ int libundumpi_grab_group_union(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_group_union val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_union));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_union(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_union_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_group_union_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1356,15 +1439,16 @@ int libundumpi_grab_group_intersection(dumpi_profile *profile, libundumpi_unsafe
   dumpi_group_intersection val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_intersection));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_intersection(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_intersection_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_group_intersection_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1373,15 +1457,16 @@ int libundumpi_grab_group_difference(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_group_difference val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_difference));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_difference(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_difference_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_group_difference_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1390,16 +1475,17 @@ int libundumpi_grab_group_incl(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_group_incl val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_incl));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_incl(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_incl_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.ranks != NULL) DUMPI_FREE_INT(val.ranks);
+    ((dumpi_group_incl_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_group_incl(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1408,16 +1494,17 @@ int libundumpi_grab_group_excl(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_group_excl val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_excl));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_excl(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_excl_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.ranks != NULL) DUMPI_FREE_INT(val.ranks);
+    ((dumpi_group_excl_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_group_excl(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1426,17 +1513,17 @@ int libundumpi_grab_group_range_incl(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_group_range_incl val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_range_incl));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_range_incl(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_range_incl_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.ranges != NULL)
-    DUMPI_FREE_INT_ARRAY_2(val.count, val.ranges);
+    ((dumpi_group_range_incl_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_group_range_incl(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1445,17 +1532,17 @@ int libundumpi_grab_group_range_excl(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_group_range_excl val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_range_excl));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_range_excl(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_range_excl_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.ranges != NULL)
-    DUMPI_FREE_INT_ARRAY_2(val.count, val.ranges);
+    ((dumpi_group_range_excl_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_group_range_excl(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1464,15 +1551,16 @@ int libundumpi_grab_group_free(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_group_free val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_group_free));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_group_free(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_group_free_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_group_free_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1481,15 +1569,16 @@ int libundumpi_grab_comm_size(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_comm_size val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_size));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_size(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_size_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_size_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1498,15 +1587,16 @@ int libundumpi_grab_comm_rank(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_comm_rank val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_rank));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_rank(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_rank_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_rank_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1515,15 +1605,16 @@ int libundumpi_grab_comm_compare(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_comm_compare val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_compare));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_compare(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_compare_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_compare_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1532,15 +1623,16 @@ int libundumpi_grab_comm_dup(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_comm_dup val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_dup));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_dup(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_dup_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_dup_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1549,15 +1641,16 @@ int libundumpi_grab_comm_create(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_comm_create val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_create));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_create(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_create_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_create_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1566,15 +1659,16 @@ int libundumpi_grab_comm_split(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_comm_split val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_split));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_split(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_split_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_split_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1583,15 +1677,16 @@ int libundumpi_grab_comm_free(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_comm_free val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_free));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_free(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_free_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_free_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1600,15 +1695,16 @@ int libundumpi_grab_comm_test_inter(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_comm_test_inter val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_test_inter));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_test_inter(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_test_inter_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_test_inter_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1617,15 +1713,16 @@ int libundumpi_grab_comm_remote_size(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_comm_remote_size val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_remote_size));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_remote_size(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_remote_size_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_remote_size_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1634,15 +1731,16 @@ int libundumpi_grab_comm_remote_group(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_comm_remote_group val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_remote_group));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_remote_group(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_remote_group_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_remote_group_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1651,15 +1749,16 @@ int libundumpi_grab_intercomm_create(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_intercomm_create val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_intercomm_create));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_intercomm_create(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_intercomm_create_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_intercomm_create_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1668,15 +1767,16 @@ int libundumpi_grab_intercomm_merge(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_intercomm_merge val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_intercomm_merge));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_intercomm_merge(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_intercomm_merge_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_intercomm_merge_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1685,15 +1785,16 @@ int libundumpi_grab_keyval_create(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_keyval_create val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_keyval_create));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_keyval_create(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_keyval_create_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_keyval_create_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1702,15 +1803,16 @@ int libundumpi_grab_keyval_free(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_keyval_free val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_keyval_free));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_keyval_free(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_keyval_free_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_keyval_free_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1719,15 +1821,16 @@ int libundumpi_grab_attr_put(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_attr_put val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_attr_put));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_attr_put(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_attr_put_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_attr_put_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1736,15 +1839,16 @@ int libundumpi_grab_attr_get(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_attr_get val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_attr_get));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_attr_get(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_attr_get_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_attr_get_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1753,15 +1857,16 @@ int libundumpi_grab_attr_delete(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_attr_delete val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_attr_delete));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_attr_delete(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_attr_delete_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_attr_delete_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1770,15 +1875,16 @@ int libundumpi_grab_topo_test(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_topo_test val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_topo_test));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_topo_test(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_topo_test_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_topo_test_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1787,17 +1893,17 @@ int libundumpi_grab_cart_create(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_cart_create val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_cart_create));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_cart_create(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_cart_create_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.dims != NULL) DUMPI_FREE_INT(val.dims);
-  if(val.periods != NULL) DUMPI_FREE_INT(val.periods);
+    ((dumpi_cart_create_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_cart_create(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1806,17 +1912,17 @@ int libundumpi_grab_dims_create(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_dims_create val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_dims_create));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_dims_create(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_dims_create_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.dims.in != NULL) DUMPI_FREE_INT(val.dims.in);
-  if(val.dims.out != NULL) DUMPI_FREE_INT(val.dims.out);
+    ((dumpi_dims_create_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_dims_create(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1825,17 +1931,17 @@ int libundumpi_grab_graph_create(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_graph_create val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_graph_create));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_graph_create(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_graph_create_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.index != NULL) DUMPI_FREE_INT(val.index);
-  if(val.edges != NULL) DUMPI_FREE_INT(val.edges);
+    ((dumpi_graph_create_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_graph_create(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1844,15 +1950,16 @@ int libundumpi_grab_graphdims_get(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_graphdims_get val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_graphdims_get));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_graphdims_get(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_graphdims_get_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_graphdims_get_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1861,17 +1968,17 @@ int libundumpi_grab_graph_get(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_graph_get val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_graph_get));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_graph_get(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_graph_get_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.index != NULL) DUMPI_FREE_INT(val.index);
-  if(val.edges != NULL) DUMPI_FREE_INT(val.edges);
+    ((dumpi_graph_get_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_graph_get(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1880,15 +1987,16 @@ int libundumpi_grab_cartdim_get(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_cartdim_get val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_cartdim_get));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_cartdim_get(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_cartdim_get_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_cartdim_get_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1897,17 +2005,17 @@ int libundumpi_grab_cart_get(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_cart_get val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_cart_get));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_cart_get(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_cart_get_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.dims != NULL) DUMPI_FREE_INT(val.dims);
-  if(val.periods != NULL) DUMPI_FREE_INT(val.periods);
+    ((dumpi_cart_get_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_cart_get(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1916,16 +2024,17 @@ int libundumpi_grab_cart_rank(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_cart_rank val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_cart_rank));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_cart_rank(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_cart_rank_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.coords != NULL) DUMPI_FREE_INT(val.coords);
+    ((dumpi_cart_rank_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_cart_rank(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1934,16 +2043,17 @@ int libundumpi_grab_cart_coords(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_cart_coords val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_cart_coords));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_cart_coords(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_cart_coords_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.coords != NULL) DUMPI_FREE_INT(val.coords);
+    ((dumpi_cart_coords_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_cart_coords(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1952,15 +2062,16 @@ int libundumpi_grab_graph_neighbors_count(dumpi_profile *profile, libundumpi_uns
   dumpi_graph_neighbors_count val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_graph_neighbors_count));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_graph_neighbors_count(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_graph_neighbors_count_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_graph_neighbors_count_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1969,16 +2080,17 @@ int libundumpi_grab_graph_neighbors(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_graph_neighbors val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_graph_neighbors));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_graph_neighbors(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_graph_neighbors_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.neighbors != NULL) DUMPI_FREE_INT(val.neighbors);
+    ((dumpi_graph_neighbors_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_graph_neighbors(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -1987,15 +2099,16 @@ int libundumpi_grab_cart_shift(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_cart_shift val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_cart_shift));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_cart_shift(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_cart_shift_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_cart_shift_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2004,16 +2117,17 @@ int libundumpi_grab_cart_sub(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_cart_sub val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_cart_sub));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_cart_sub(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_cart_sub_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.remain_dims != NULL) DUMPI_FREE_INT(val.remain_dims);
+    ((dumpi_cart_sub_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_cart_sub(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2022,17 +2136,17 @@ int libundumpi_grab_cart_map(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_cart_map val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_cart_map));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_cart_map(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_cart_map_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.dims != NULL) DUMPI_FREE_INT(val.dims);
-  if(val.period != NULL) DUMPI_FREE_INT(val.period);
+    ((dumpi_cart_map_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_cart_map(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2041,17 +2155,17 @@ int libundumpi_grab_graph_map(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_graph_map val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_graph_map));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_graph_map(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_graph_map_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.index != NULL) DUMPI_FREE_INT(val.index);
-  if(val.edges != NULL) DUMPI_FREE_INT(val.edges);
+    ((dumpi_graph_map_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_graph_map(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2060,16 +2174,17 @@ int libundumpi_grab_get_processor_name(dumpi_profile *profile, libundumpi_unsafe
   dumpi_get_processor_name val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_get_processor_name));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_get_processor_name(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_get_processor_name_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.name != NULL) DUMPI_FREE_CHAR(val.name);
+    ((dumpi_get_processor_name_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_get_processor_name(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2078,15 +2193,16 @@ int libundumpi_grab_get_version(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_get_version val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_get_version));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_get_version(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_get_version_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_get_version_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2095,15 +2211,16 @@ int libundumpi_grab_errhandler_create(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_errhandler_create val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_errhandler_create));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_errhandler_create(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_errhandler_create_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_errhandler_create_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2112,15 +2229,16 @@ int libundumpi_grab_errhandler_set(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_errhandler_set val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_errhandler_set));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_errhandler_set(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_errhandler_set_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_errhandler_set_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2129,15 +2247,16 @@ int libundumpi_grab_errhandler_get(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_errhandler_get val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_errhandler_get));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_errhandler_get(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_errhandler_get_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_errhandler_get_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2146,15 +2265,16 @@ int libundumpi_grab_errhandler_free(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_errhandler_free val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_errhandler_free));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_errhandler_free(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_errhandler_free_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_errhandler_free_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2163,16 +2283,17 @@ int libundumpi_grab_error_string(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_error_string val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_error_string));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_error_string(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_error_string_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.errorstring != NULL) DUMPI_FREE_CHAR(val.errorstring);
+    ((dumpi_error_string_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_error_string(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2181,15 +2302,16 @@ int libundumpi_grab_error_class(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_error_class val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_error_class));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_error_class(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_error_class_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_error_class_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2198,15 +2320,16 @@ int libundumpi_grab_wtime(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_wtime val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_wtime));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_wtime(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_wtime_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_wtime_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2215,15 +2338,16 @@ int libundumpi_grab_wtick(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_wtick val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_wtick));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_wtick(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_wtick_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_wtick_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2232,17 +2356,17 @@ int libundumpi_grab_init(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_init val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_init));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_init(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_init_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.argv != NULL)
-    DUMPI_FREE_CHAR_ARRAY_2(val.argc, val.argv);
+    ((dumpi_init_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_init(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2251,15 +2375,16 @@ int libundumpi_grab_finalize(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_finalize val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_finalize));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_finalize(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_finalize_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_finalize_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2268,15 +2393,16 @@ int libundumpi_grab_initialized(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_initialized val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_initialized));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_initialized(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_initialized_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_initialized_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2285,15 +2411,16 @@ int libundumpi_grab_abort(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpi_abort val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_abort));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_abort(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_abort_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_abort_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2302,16 +2429,17 @@ int libundumpi_grab_close_port(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_close_port val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_close_port));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_close_port(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_close_port_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.portname != NULL) DUMPI_FREE_CHAR(val.portname);
+    ((dumpi_close_port_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_close_port(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2320,16 +2448,17 @@ int libundumpi_grab_comm_accept(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_comm_accept val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_accept));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_accept(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_accept_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.portname != NULL) DUMPI_FREE_CHAR(val.portname);
+    ((dumpi_comm_accept_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_comm_accept(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2338,16 +2467,17 @@ int libundumpi_grab_comm_connect(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_comm_connect val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_connect));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_connect(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_connect_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.portname != NULL) DUMPI_FREE_CHAR(val.portname);
+    ((dumpi_comm_connect_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_comm_connect(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2356,15 +2486,16 @@ int libundumpi_grab_comm_disconnect(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_comm_disconnect val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_disconnect));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_disconnect(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_disconnect_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_disconnect_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2373,15 +2504,16 @@ int libundumpi_grab_comm_get_parent(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_comm_get_parent val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_get_parent));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_get_parent(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_get_parent_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_get_parent_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2390,15 +2522,16 @@ int libundumpi_grab_comm_join(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_comm_join val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_join));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_join(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_join_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_join_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2407,19 +2540,17 @@ int libundumpi_grab_comm_spawn(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_comm_spawn val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_spawn));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_spawn(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_spawn_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.command != NULL) DUMPI_FREE_CHAR(val.command);
-  if(val.argv != NULL)
-    DUMPI_FREE_CHAR_ARRAY_2(DUMPI_NULLTERM, val.argv);
-  if(val.errcodes != NULL) DUMPI_FREE_ERRCODE(val.errcodes);
+    ((dumpi_comm_spawn_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_comm_spawn(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2428,22 +2559,17 @@ int libundumpi_grab_comm_spawn_multiple(dumpi_profile *profile, libundumpi_unsaf
   dumpi_comm_spawn_multiple val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_spawn_multiple));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_spawn_multiple(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_spawn_multiple_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.commands != NULL)
-    DUMPI_FREE_CHAR_ARRAY_2(val.count, val.commands);
-  if(val.argvs != NULL)
-    DUMPI_FREE_CHAR_ARRAY_3(val.count, DUMPI_NULLTERM, val.argvs);
-  if(val.maxprocs != NULL) DUMPI_FREE_INT(val.maxprocs);
-  if(val.info != NULL) DUMPI_FREE_INFO(val.info);
-  if(val.errcodes != NULL) DUMPI_FREE_ERRCODE(val.errcodes);
+    ((dumpi_comm_spawn_multiple_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_comm_spawn_multiple(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2452,17 +2578,17 @@ int libundumpi_grab_lookup_name(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_lookup_name val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_lookup_name));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_lookup_name(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_lookup_name_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.servicename != NULL) DUMPI_FREE_CHAR(val.servicename);
-  if(val.portname != NULL) DUMPI_FREE_CHAR(val.portname);
+    ((dumpi_lookup_name_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_lookup_name(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2471,16 +2597,17 @@ int libundumpi_grab_open_port(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_open_port val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_open_port));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_open_port(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_open_port_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.portname != NULL) DUMPI_FREE_CHAR(val.portname);
+    ((dumpi_open_port_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_open_port(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2489,17 +2616,17 @@ int libundumpi_grab_publish_name(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_publish_name val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_publish_name));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_publish_name(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_publish_name_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.servicename != NULL) DUMPI_FREE_CHAR(val.servicename);
-  if(val.portname != NULL) DUMPI_FREE_CHAR(val.portname);
+    ((dumpi_publish_name_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_publish_name(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2508,17 +2635,17 @@ int libundumpi_grab_unpublish_name(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_unpublish_name val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_unpublish_name));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_unpublish_name(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_unpublish_name_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.servicename != NULL) DUMPI_FREE_CHAR(val.servicename);
-  if(val.portname != NULL) DUMPI_FREE_CHAR(val.portname);
+    ((dumpi_unpublish_name_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_unpublish_name(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2527,15 +2654,16 @@ int libundumpi_grab_accumulate(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_accumulate val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_accumulate));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_accumulate(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_accumulate_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_accumulate_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2544,15 +2672,16 @@ int libundumpi_grab_get(dumpi_profile *profile, libundumpi_unsafe_fun callout, v
   dumpi_get val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_get));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_get(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_get_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_get_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2561,15 +2690,16 @@ int libundumpi_grab_put(dumpi_profile *profile, libundumpi_unsafe_fun callout, v
   dumpi_put val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_put));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_put(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_put_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_put_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2578,15 +2708,16 @@ int libundumpi_grab_win_complete(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_win_complete val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_complete));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_complete(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_complete_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_complete_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2595,15 +2726,16 @@ int libundumpi_grab_win_create(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_win_create val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_create));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_create(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_create_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_create_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2612,15 +2744,16 @@ int libundumpi_grab_win_fence(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_win_fence val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_fence));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_fence(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_fence_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_fence_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2629,15 +2762,16 @@ int libundumpi_grab_win_free(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_win_free val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_free));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_free(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_free_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_free_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2646,15 +2780,16 @@ int libundumpi_grab_win_get_group(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_win_get_group val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_get_group));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_get_group(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_get_group_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_get_group_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2663,15 +2798,16 @@ int libundumpi_grab_win_lock(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_win_lock val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_lock));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_lock(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_lock_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_lock_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2680,15 +2816,16 @@ int libundumpi_grab_win_post(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_win_post val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_post));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_post(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_post_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_post_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2697,15 +2834,16 @@ int libundumpi_grab_win_start(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_win_start val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_start));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_start(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_start_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_start_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2714,15 +2852,16 @@ int libundumpi_grab_win_test(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_win_test val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_test));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_test(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_test_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_test_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2731,15 +2870,16 @@ int libundumpi_grab_win_unlock(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_win_unlock val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_unlock));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_unlock(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_unlock_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_unlock_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2748,15 +2888,16 @@ int libundumpi_grab_win_wait(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_win_wait val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_wait));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_wait(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_wait_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_wait_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2765,21 +2906,17 @@ int libundumpi_grab_alltoallw(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_alltoallw val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_alltoallw));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_alltoallw(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_alltoallw_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.sendcounts != NULL) DUMPI_FREE_INT(val.sendcounts);
-  if(val.senddispls != NULL) DUMPI_FREE_INT(val.senddispls);
-  if(val.sendtypes != NULL) DUMPI_FREE_DATATYPE(val.sendtypes);
-  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
-  if(val.recvdispls != NULL) DUMPI_FREE_INT(val.recvdispls);
-  if(val.recvtypes != NULL) DUMPI_FREE_DATATYPE(val.recvtypes);
+    ((dumpi_alltoallw_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_alltoallw(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2788,15 +2925,16 @@ int libundumpi_grab_exscan(dumpi_profile *profile, libundumpi_unsafe_fun callout
   dumpi_exscan val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_exscan));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_exscan(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_exscan_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_exscan_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2805,15 +2943,16 @@ int libundumpi_grab_add_error_class(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_add_error_class val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_add_error_class));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_add_error_class(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_add_error_class_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_add_error_class_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2822,15 +2961,16 @@ int libundumpi_grab_add_error_code(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_add_error_code val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_add_error_code));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_add_error_code(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_add_error_code_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_add_error_code_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2839,16 +2979,17 @@ int libundumpi_grab_add_error_string(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_add_error_string val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_add_error_string));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_add_error_string(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_add_error_string_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.errorstring != NULL) DUMPI_FREE_CHAR(val.errorstring);
+    ((dumpi_add_error_string_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_add_error_string(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2857,15 +2998,16 @@ int libundumpi_grab_comm_call_errhandler(dumpi_profile *profile, libundumpi_unsa
   dumpi_comm_call_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_call_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_call_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_call_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_call_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2874,15 +3016,16 @@ int libundumpi_grab_comm_create_keyval(dumpi_profile *profile, libundumpi_unsafe
   dumpi_comm_create_keyval val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_create_keyval));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_create_keyval(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_create_keyval_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_create_keyval_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2891,15 +3034,16 @@ int libundumpi_grab_comm_delete_attr(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_comm_delete_attr val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_delete_attr));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_delete_attr(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_delete_attr_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_delete_attr_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2908,15 +3052,16 @@ int libundumpi_grab_comm_free_keyval(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_comm_free_keyval val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_free_keyval));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_free_keyval(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_free_keyval_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_free_keyval_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2925,15 +3070,16 @@ int libundumpi_grab_comm_get_attr(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_comm_get_attr val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_get_attr));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_get_attr(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_get_attr_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_get_attr_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2942,16 +3088,17 @@ int libundumpi_grab_comm_get_name(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_comm_get_name val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_get_name));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_get_name(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_get_name_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.name != NULL) DUMPI_FREE_CHAR(val.name);
+    ((dumpi_comm_get_name_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_comm_get_name(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2960,15 +3107,16 @@ int libundumpi_grab_comm_set_attr(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_comm_set_attr val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_set_attr));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_set_attr(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_set_attr_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_set_attr_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2977,16 +3125,17 @@ int libundumpi_grab_comm_set_name(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_comm_set_name val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_set_name));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_set_name(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_set_name_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.name != NULL) DUMPI_FREE_CHAR(val.name);
+    ((dumpi_comm_set_name_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_comm_set_name(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -2995,15 +3144,16 @@ int libundumpi_grab_file_call_errhandler(dumpi_profile *profile, libundumpi_unsa
   dumpi_file_call_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_call_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_call_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_call_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_call_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3012,15 +3162,16 @@ int libundumpi_grab_grequest_complete(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_grequest_complete val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_grequest_complete));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_grequest_complete(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_grequest_complete_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_grequest_complete_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3029,15 +3180,16 @@ int libundumpi_grab_grequest_start(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_grequest_start val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_grequest_start));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_grequest_start(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_grequest_start_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_grequest_start_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3046,17 +3198,17 @@ int libundumpi_grab_init_thread(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_init_thread val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_init_thread));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_init_thread(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_init_thread_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.argv != NULL)
-    DUMPI_FREE_CHAR_ARRAY_2(val.argc, val.argv);
+    ((dumpi_init_thread_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_init_thread(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3065,15 +3217,16 @@ int libundumpi_grab_is_thread_main(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_is_thread_main val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_is_thread_main));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_is_thread_main(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_is_thread_main_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_is_thread_main_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3082,15 +3235,16 @@ int libundumpi_grab_query_thread(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_query_thread val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_query_thread));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_query_thread(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_query_thread_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_query_thread_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3099,16 +3253,17 @@ int libundumpi_grab_status_set_cancelled(dumpi_profile *profile, libundumpi_unsa
   dumpi_status_set_cancelled val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_status_set_cancelled));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_status_set_cancelled(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_status_set_cancelled_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_status_set_cancelled_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_status_set_cancelled(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3117,16 +3272,17 @@ int libundumpi_grab_status_set_elements(dumpi_profile *profile, libundumpi_unsaf
   dumpi_status_set_elements val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_status_set_elements));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_status_set_elements(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_status_set_elements_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_status_set_elements_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_status_set_elements(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3135,15 +3291,16 @@ int libundumpi_grab_type_create_keyval(dumpi_profile *profile, libundumpi_unsafe
   dumpi_type_create_keyval val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_create_keyval));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_create_keyval(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_create_keyval_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_create_keyval_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3152,15 +3309,16 @@ int libundumpi_grab_type_delete_attr(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_type_delete_attr val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_delete_attr));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_delete_attr(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_delete_attr_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_delete_attr_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3169,15 +3327,16 @@ int libundumpi_grab_type_dup(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_type_dup val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_dup));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_dup(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_dup_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_dup_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3186,15 +3345,16 @@ int libundumpi_grab_type_free_keyval(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_type_free_keyval val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_free_keyval));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_free_keyval(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_free_keyval_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_free_keyval_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3203,15 +3363,16 @@ int libundumpi_grab_type_get_attr(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_type_get_attr val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_get_attr));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_get_attr(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_get_attr_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_get_attr_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3220,18 +3381,17 @@ int libundumpi_grab_type_get_contents(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_type_get_contents val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_get_contents));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_get_contents(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_get_contents_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.arrintegers != NULL) DUMPI_FREE_INT(val.arrintegers);
-  if(val.arraddresses != NULL) DUMPI_FREE_INT(val.arraddresses);
-  if(val.arrdatatypes != NULL) DUMPI_FREE_DATATYPE(val.arrdatatypes);
+    ((dumpi_type_get_contents_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_get_contents(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3240,15 +3400,16 @@ int libundumpi_grab_type_get_envelope(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_type_get_envelope val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_get_envelope));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_get_envelope(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_get_envelope_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_get_envelope_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3257,16 +3418,17 @@ int libundumpi_grab_type_get_name(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_type_get_name val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_get_name));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_get_name(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_get_name_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.name != NULL) DUMPI_FREE_CHAR(val.name);
+    ((dumpi_type_get_name_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_get_name(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3275,15 +3437,16 @@ int libundumpi_grab_type_set_attr(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_type_set_attr val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_set_attr));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_set_attr(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_set_attr_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_set_attr_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3292,16 +3455,17 @@ int libundumpi_grab_type_set_name(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_type_set_name val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_set_name));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_set_name(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_set_name_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.name != NULL) DUMPI_FREE_CHAR(val.name);
+    ((dumpi_type_set_name_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_set_name(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3310,15 +3474,16 @@ int libundumpi_grab_type_match_size(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_type_match_size val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_match_size));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_match_size(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_match_size_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_match_size_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3327,15 +3492,16 @@ int libundumpi_grab_win_call_errhandler(dumpi_profile *profile, libundumpi_unsaf
   dumpi_win_call_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_call_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_call_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_call_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_call_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3344,15 +3510,16 @@ int libundumpi_grab_win_create_keyval(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_win_create_keyval val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_create_keyval));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_create_keyval(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_create_keyval_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_create_keyval_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3361,15 +3528,16 @@ int libundumpi_grab_win_delete_attr(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_win_delete_attr val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_delete_attr));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_delete_attr(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_delete_attr_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_delete_attr_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3378,15 +3546,16 @@ int libundumpi_grab_win_free_keyval(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_win_free_keyval val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_free_keyval));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_free_keyval(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_free_keyval_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_free_keyval_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3395,15 +3564,16 @@ int libundumpi_grab_win_get_attr(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_win_get_attr val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_get_attr));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_get_attr(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_get_attr_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_get_attr_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3412,16 +3582,17 @@ int libundumpi_grab_win_get_name(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_win_get_name val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_get_name));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_get_name(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_get_name_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.name != NULL) DUMPI_FREE_CHAR(val.name);
+    ((dumpi_win_get_name_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_win_get_name(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3430,15 +3601,16 @@ int libundumpi_grab_win_set_attr(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_win_set_attr val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_set_attr));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_set_attr(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_set_attr_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_set_attr_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3447,16 +3619,17 @@ int libundumpi_grab_win_set_name(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_win_set_name val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_set_name));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_set_name(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_set_name_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.name != NULL) DUMPI_FREE_CHAR(val.name);
+    ((dumpi_win_set_name_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_win_set_name(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3465,15 +3638,16 @@ int libundumpi_grab_alloc_mem(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_alloc_mem val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_alloc_mem));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_alloc_mem(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_alloc_mem_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_alloc_mem_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3482,15 +3656,16 @@ int libundumpi_grab_comm_create_errhandler(dumpi_profile *profile, libundumpi_un
   dumpi_comm_create_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_create_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_create_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_create_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_create_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3499,15 +3674,16 @@ int libundumpi_grab_comm_get_errhandler(dumpi_profile *profile, libundumpi_unsaf
   dumpi_comm_get_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_get_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_get_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_get_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_get_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3516,15 +3692,16 @@ int libundumpi_grab_comm_set_errhandler(dumpi_profile *profile, libundumpi_unsaf
   dumpi_comm_set_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_comm_set_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_comm_set_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_comm_set_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_comm_set_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3533,15 +3710,16 @@ int libundumpi_grab_file_create_errhandler(dumpi_profile *profile, libundumpi_un
   dumpi_file_create_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_create_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_create_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_create_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_create_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3550,15 +3728,16 @@ int libundumpi_grab_file_get_errhandler(dumpi_profile *profile, libundumpi_unsaf
   dumpi_file_get_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_get_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3567,15 +3746,16 @@ int libundumpi_grab_file_set_errhandler(dumpi_profile *profile, libundumpi_unsaf
   dumpi_file_set_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_set_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_set_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_set_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_set_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3584,15 +3764,16 @@ int libundumpi_grab_finalized(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_finalized val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_finalized));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_finalized(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_finalized_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_finalized_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3601,15 +3782,16 @@ int libundumpi_grab_free_mem(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_free_mem val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_free_mem));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_free_mem(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_free_mem_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_free_mem_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3618,15 +3800,16 @@ int libundumpi_grab_get_address(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_get_address val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_get_address));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_get_address(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_get_address_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_get_address_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3635,15 +3818,16 @@ int libundumpi_grab_info_create(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_info_create val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_info_create));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_info_create(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_info_create_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_info_create_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3652,16 +3836,17 @@ int libundumpi_grab_info_delete(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_info_delete val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_info_delete));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_info_delete(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_info_delete_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.key != NULL) DUMPI_FREE_CHAR(val.key);
+    ((dumpi_info_delete_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_info_delete(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3670,15 +3855,16 @@ int libundumpi_grab_info_dup(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_info_dup val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_info_dup));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_info_dup(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_info_dup_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_info_dup_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3687,15 +3873,16 @@ int libundumpi_grab_info_free(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_info_free val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_info_free));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_info_free(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_info_free_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_info_free_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3704,17 +3891,17 @@ int libundumpi_grab_info_get(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_info_get val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_info_get));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_info_get(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_info_get_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.key != NULL) DUMPI_FREE_CHAR(val.key);
-  if(val.value != NULL) DUMPI_FREE_CHAR(val.value);
+    ((dumpi_info_get_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_info_get(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3723,15 +3910,16 @@ int libundumpi_grab_info_get_nkeys(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_info_get_nkeys val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_info_get_nkeys));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_info_get_nkeys(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_info_get_nkeys_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_info_get_nkeys_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3740,16 +3928,17 @@ int libundumpi_grab_info_get_nthkey(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_info_get_nthkey val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_info_get_nthkey));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_info_get_nthkey(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_info_get_nthkey_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.key != NULL) DUMPI_FREE_CHAR(val.key);
+    ((dumpi_info_get_nthkey_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_info_get_nthkey(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3758,16 +3947,17 @@ int libundumpi_grab_info_get_valuelen(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_info_get_valuelen val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_info_get_valuelen));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_info_get_valuelen(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_info_get_valuelen_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.key != NULL) DUMPI_FREE_CHAR(val.key);
+    ((dumpi_info_get_valuelen_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_info_get_valuelen(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3776,17 +3966,17 @@ int libundumpi_grab_info_set(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpi_info_set val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_info_set));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_info_set(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_info_set_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.key != NULL) DUMPI_FREE_CHAR(val.key);
-  if(val.value != NULL) DUMPI_FREE_CHAR(val.value);
+    ((dumpi_info_set_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_info_set(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3795,16 +3985,17 @@ int libundumpi_grab_pack_external(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_pack_external val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_pack_external));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_pack_external(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_pack_external_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.datarep != NULL) DUMPI_FREE_CHAR(val.datarep);
+    ((dumpi_pack_external_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_pack_external(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3813,16 +4004,17 @@ int libundumpi_grab_pack_external_size(dumpi_profile *profile, libundumpi_unsafe
   dumpi_pack_external_size val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_pack_external_size));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_pack_external_size(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_pack_external_size_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.datarep != NULL) DUMPI_FREE_CHAR(val.datarep);
+    ((dumpi_pack_external_size_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_pack_external_size(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3831,16 +4023,17 @@ int libundumpi_grab_request_get_status(dumpi_profile *profile, libundumpi_unsafe
   dumpi_request_get_status val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_request_get_status));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_request_get_status(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_request_get_status_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_request_get_status_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_request_get_status(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3849,19 +4042,17 @@ int libundumpi_grab_type_create_darray(dumpi_profile *profile, libundumpi_unsafe
   dumpi_type_create_darray val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_create_darray));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_create_darray(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_create_darray_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.gsizes != NULL) DUMPI_FREE_INT(val.gsizes);
-  if(val.distribs != NULL) DUMPI_FREE_DISTRIBUTION(val.distribs);
-  if(val.dargs != NULL) DUMPI_FREE_INT(val.dargs);
-  if(val.psizes != NULL) DUMPI_FREE_INT(val.psizes);
+    ((dumpi_type_create_darray_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_create_darray(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3870,17 +4061,17 @@ int libundumpi_grab_type_create_hindexed(dumpi_profile *profile, libundumpi_unsa
   dumpi_type_create_hindexed val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_create_hindexed));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_create_hindexed(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_create_hindexed_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.blocklengths != NULL) DUMPI_FREE_INT(val.blocklengths);
-  if(val.displacements != NULL) DUMPI_FREE_INT(val.displacements);
+    ((dumpi_type_create_hindexed_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_create_hindexed(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3889,15 +4080,16 @@ int libundumpi_grab_type_create_hvector(dumpi_profile *profile, libundumpi_unsaf
   dumpi_type_create_hvector val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_create_hvector));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_create_hvector(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_create_hvector_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_create_hvector_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3906,16 +4098,17 @@ int libundumpi_grab_type_create_indexed_block(dumpi_profile *profile, libundumpi
   dumpi_type_create_indexed_block val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_create_indexed_block));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_create_indexed_block(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_create_indexed_block_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.displacments != NULL) DUMPI_FREE_INT(val.displacments);
+    ((dumpi_type_create_indexed_block_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_create_indexed_block(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3924,15 +4117,16 @@ int libundumpi_grab_type_create_resized(dumpi_profile *profile, libundumpi_unsaf
   dumpi_type_create_resized val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_create_resized));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_create_resized(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_create_resized_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_create_resized_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3941,18 +4135,17 @@ int libundumpi_grab_type_create_struct(dumpi_profile *profile, libundumpi_unsafe
   dumpi_type_create_struct val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_create_struct));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_create_struct(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_create_struct_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.blocklengths != NULL) DUMPI_FREE_INT(val.blocklengths);
-  if(val.displacements != NULL) DUMPI_FREE_INT(val.displacements);
-  if(val.oldtypes != NULL) DUMPI_FREE_DATATYPE(val.oldtypes);
+    ((dumpi_type_create_struct_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_create_struct(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3961,18 +4154,17 @@ int libundumpi_grab_type_create_subarray(dumpi_profile *profile, libundumpi_unsa
   dumpi_type_create_subarray val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_create_subarray));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_create_subarray(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_create_subarray_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.sizes != NULL) DUMPI_FREE_INT(val.sizes);
-  if(val.subsizes != NULL) DUMPI_FREE_INT(val.subsizes);
-  if(val.starts != NULL) DUMPI_FREE_INT(val.starts);
+    ((dumpi_type_create_subarray_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_type_create_subarray(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3981,15 +4173,16 @@ int libundumpi_grab_type_get_extent(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_type_get_extent val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_get_extent));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_get_extent(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_get_extent_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_get_extent_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -3998,15 +4191,16 @@ int libundumpi_grab_type_get_true_extent(dumpi_profile *profile, libundumpi_unsa
   dumpi_type_get_true_extent val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_type_get_true_extent));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_type_get_true_extent(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_type_get_true_extent_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_type_get_true_extent_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4015,16 +4209,17 @@ int libundumpi_grab_unpack_external(dumpi_profile *profile, libundumpi_unsafe_fu
   dumpi_unpack_external val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_unpack_external));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_unpack_external(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_unpack_external_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.datarep != NULL) DUMPI_FREE_CHAR(val.datarep);
+    ((dumpi_unpack_external_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_unpack_external(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4033,15 +4228,16 @@ int libundumpi_grab_win_create_errhandler(dumpi_profile *profile, libundumpi_uns
   dumpi_win_create_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_create_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_create_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_create_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_create_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4050,15 +4246,16 @@ int libundumpi_grab_win_get_errhandler(dumpi_profile *profile, libundumpi_unsafe
   dumpi_win_get_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_get_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_get_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_get_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_get_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4067,15 +4264,16 @@ int libundumpi_grab_win_set_errhandler(dumpi_profile *profile, libundumpi_unsafe
   dumpi_win_set_errhandler val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_win_set_errhandler));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_win_set_errhandler(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_win_set_errhandler_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_win_set_errhandler_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4084,16 +4282,17 @@ int libundumpi_grab_file_open(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_file_open val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_open));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_open(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_open_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.filename != NULL) DUMPI_FREE_CHAR(val.filename);
+    ((dumpi_file_open_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_open(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4102,15 +4301,16 @@ int libundumpi_grab_file_close(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_file_close val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_close));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_close(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_close_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_close_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4119,16 +4319,17 @@ int libundumpi_grab_file_delete(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_file_delete val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_delete));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_delete(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_delete_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.filename != NULL) DUMPI_FREE_CHAR(val.filename);
+    ((dumpi_file_delete_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_delete(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4137,15 +4338,16 @@ int libundumpi_grab_file_set_size(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_set_size val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_set_size));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_set_size(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_set_size_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_set_size_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4154,15 +4356,16 @@ int libundumpi_grab_file_preallocate(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_file_preallocate val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_preallocate));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_preallocate(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_preallocate_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_preallocate_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4171,15 +4374,16 @@ int libundumpi_grab_file_get_size(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_get_size val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_size));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_size(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_size_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_get_size_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4188,15 +4392,16 @@ int libundumpi_grab_file_get_group(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_get_group val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_group));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_group(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_group_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_get_group_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4205,15 +4410,16 @@ int libundumpi_grab_file_get_amode(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_get_amode val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_amode));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_amode(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_amode_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_get_amode_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4222,15 +4428,16 @@ int libundumpi_grab_file_set_info(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_set_info val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_set_info));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_set_info(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_set_info_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_set_info_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4239,15 +4446,16 @@ int libundumpi_grab_file_get_info(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_get_info val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_info));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_info(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_info_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_get_info_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4256,16 +4464,17 @@ int libundumpi_grab_file_set_view(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_set_view val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_set_view));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_set_view(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_set_view_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.datarep != NULL) DUMPI_FREE_CHAR(val.datarep);
+    ((dumpi_file_set_view_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_set_view(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4274,16 +4483,17 @@ int libundumpi_grab_file_get_view(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_get_view val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_view));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_view(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_view_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.datarep != NULL) DUMPI_FREE_CHAR(val.datarep);
+    ((dumpi_file_get_view_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_get_view(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4292,16 +4502,17 @@ int libundumpi_grab_file_read_at(dumpi_profile *profile, libundumpi_unsafe_fun c
   dumpi_file_read_at val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_at));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_at(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_at_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_read_at_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_read_at(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4310,16 +4521,17 @@ int libundumpi_grab_file_read_at_all(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_file_read_at_all val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_at_all));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_at_all(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_at_all_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_read_at_all_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_read_at_all(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4328,16 +4540,17 @@ int libundumpi_grab_file_write_at(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_write_at val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_at));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_at(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_at_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_write_at_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_write_at(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4346,16 +4559,17 @@ int libundumpi_grab_file_write_at_all(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_file_write_at_all val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_at_all));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_at_all(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_at_all_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_write_at_all_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_write_at_all(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4364,15 +4578,16 @@ int libundumpi_grab_file_iread_at(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_iread_at val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_iread_at));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_iread_at(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_iread_at_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_iread_at_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4381,15 +4596,16 @@ int libundumpi_grab_file_iwrite_at(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_iwrite_at val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_iwrite_at));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_iwrite_at(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_iwrite_at_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_iwrite_at_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4398,16 +4614,17 @@ int libundumpi_grab_file_read(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_file_read val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_read_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_read(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4416,16 +4633,17 @@ int libundumpi_grab_file_read_all(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_read_all val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_all));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_all(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_all_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_read_all_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_read_all(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4434,16 +4652,17 @@ int libundumpi_grab_file_write(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_file_write val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_write_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_write(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4452,16 +4671,17 @@ int libundumpi_grab_file_write_all(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_file_write_all val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_all));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_all(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_all_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_write_all_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_write_all(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4470,15 +4690,16 @@ int libundumpi_grab_file_iread(dumpi_profile *profile, libundumpi_unsafe_fun cal
   dumpi_file_iread val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_iread));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_iread(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_iread_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_iread_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4487,15 +4708,16 @@ int libundumpi_grab_file_iwrite(dumpi_profile *profile, libundumpi_unsafe_fun ca
   dumpi_file_iwrite val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_iwrite));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_iwrite(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_iwrite_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_iwrite_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4504,15 +4726,16 @@ int libundumpi_grab_file_seek(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_file_seek val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_seek));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_seek(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_seek_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_seek_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4521,15 +4744,16 @@ int libundumpi_grab_file_get_position(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_file_get_position val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_position));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_position(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_position_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_get_position_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4538,15 +4762,16 @@ int libundumpi_grab_file_get_byte_offset(dumpi_profile *profile, libundumpi_unsa
   dumpi_file_get_byte_offset val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_byte_offset));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_byte_offset(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_byte_offset_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_get_byte_offset_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4555,16 +4780,17 @@ int libundumpi_grab_file_read_shared(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_file_read_shared val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_shared));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_shared(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_shared_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_read_shared_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_read_shared(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4573,16 +4799,17 @@ int libundumpi_grab_file_write_shared(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_file_write_shared val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_shared));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_shared(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_shared_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_write_shared_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_write_shared(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4591,15 +4818,16 @@ int libundumpi_grab_file_iread_shared(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_file_iread_shared val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_iread_shared));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_iread_shared(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_iread_shared_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_iread_shared_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4608,15 +4836,16 @@ int libundumpi_grab_file_iwrite_shared(dumpi_profile *profile, libundumpi_unsafe
   dumpi_file_iwrite_shared val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_iwrite_shared));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_iwrite_shared(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_iwrite_shared_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_iwrite_shared_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4625,16 +4854,17 @@ int libundumpi_grab_file_read_ordered(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_file_read_ordered val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_ordered));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_ordered(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_ordered_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_read_ordered_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_read_ordered(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4643,16 +4873,17 @@ int libundumpi_grab_file_write_ordered(dumpi_profile *profile, libundumpi_unsafe
   dumpi_file_write_ordered val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_ordered));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_ordered(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_ordered_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_write_ordered_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_write_ordered(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4661,15 +4892,16 @@ int libundumpi_grab_file_seek_shared(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_file_seek_shared val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_seek_shared));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_seek_shared(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_seek_shared_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_seek_shared_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4678,15 +4910,16 @@ int libundumpi_grab_file_get_position_shared(dumpi_profile *profile, libundumpi_
   dumpi_file_get_position_shared val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_position_shared));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_position_shared(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_position_shared_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_get_position_shared_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4695,15 +4928,16 @@ int libundumpi_grab_file_read_at_all_begin(dumpi_profile *profile, libundumpi_un
   dumpi_file_read_at_all_begin val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_at_all_begin));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_at_all_begin(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_at_all_begin_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_read_at_all_begin_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4712,16 +4946,17 @@ int libundumpi_grab_file_read_at_all_end(dumpi_profile *profile, libundumpi_unsa
   dumpi_file_read_at_all_end val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_at_all_end));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_at_all_end(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_at_all_end_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_read_at_all_end_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_read_at_all_end(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4730,15 +4965,16 @@ int libundumpi_grab_file_write_at_all_begin(dumpi_profile *profile, libundumpi_u
   dumpi_file_write_at_all_begin val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_at_all_begin));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_at_all_begin(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_at_all_begin_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_write_at_all_begin_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4747,16 +4983,17 @@ int libundumpi_grab_file_write_at_all_end(dumpi_profile *profile, libundumpi_uns
   dumpi_file_write_at_all_end val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_at_all_end));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_at_all_end(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_at_all_end_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_write_at_all_end_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_write_at_all_end(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4765,15 +5002,16 @@ int libundumpi_grab_file_read_all_begin(dumpi_profile *profile, libundumpi_unsaf
   dumpi_file_read_all_begin val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_all_begin));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_all_begin(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_all_begin_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_read_all_begin_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4782,16 +5020,17 @@ int libundumpi_grab_file_read_all_end(dumpi_profile *profile, libundumpi_unsafe_
   dumpi_file_read_all_end val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_all_end));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_all_end(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_all_end_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_read_all_end_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_read_all_end(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4800,15 +5039,16 @@ int libundumpi_grab_file_write_all_begin(dumpi_profile *profile, libundumpi_unsa
   dumpi_file_write_all_begin val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_all_begin));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_all_begin(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_all_begin_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_write_all_begin_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4817,16 +5057,17 @@ int libundumpi_grab_file_write_all_end(dumpi_profile *profile, libundumpi_unsafe
   dumpi_file_write_all_end val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_all_end));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_all_end(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_all_end_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_write_all_end_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_write_all_end(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4835,15 +5076,16 @@ int libundumpi_grab_file_read_ordered_begin(dumpi_profile *profile, libundumpi_u
   dumpi_file_read_ordered_begin val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_ordered_begin));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_ordered_begin(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_ordered_begin_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_read_ordered_begin_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4852,16 +5094,17 @@ int libundumpi_grab_file_read_ordered_end(dumpi_profile *profile, libundumpi_uns
   dumpi_file_read_ordered_end val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_read_ordered_end));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_read_ordered_end(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_read_ordered_end_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_read_ordered_end_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_read_ordered_end(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4870,15 +5113,16 @@ int libundumpi_grab_file_write_ordered_begin(dumpi_profile *profile, libundumpi_
   dumpi_file_write_ordered_begin val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_ordered_begin));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_ordered_begin(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_ordered_begin_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_write_ordered_begin_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4887,16 +5131,17 @@ int libundumpi_grab_file_write_ordered_end(dumpi_profile *profile, libundumpi_un
   dumpi_file_write_ordered_end val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_write_ordered_end));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_write_ordered_end(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_write_ordered_end_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+    ((dumpi_file_write_ordered_end_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_file_write_ordered_end(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4905,15 +5150,16 @@ int libundumpi_grab_file_get_type_extent(dumpi_profile *profile, libundumpi_unsa
   dumpi_file_get_type_extent val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_type_extent));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_type_extent(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_type_extent_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_get_type_extent_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4922,16 +5168,17 @@ int libundumpi_grab_register_datarep(dumpi_profile *profile, libundumpi_unsafe_f
   dumpi_register_datarep val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_register_datarep));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_register_datarep(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_register_datarep_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
-  if(val.name != NULL) DUMPI_FREE_CHAR(val.name);
+    ((dumpi_register_datarep_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
+  libundumpi_release_register_datarep(&val);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4940,15 +5187,16 @@ int libundumpi_grab_file_set_atomicity(dumpi_profile *profile, libundumpi_unsafe
   dumpi_file_set_atomicity val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_set_atomicity));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_set_atomicity(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_set_atomicity_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_set_atomicity_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4957,15 +5205,16 @@ int libundumpi_grab_file_get_atomicity(dumpi_profile *profile, libundumpi_unsafe
   dumpi_file_get_atomicity val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_get_atomicity));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_get_atomicity(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_get_atomicity_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_get_atomicity_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4974,15 +5223,16 @@ int libundumpi_grab_file_sync(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpi_file_sync val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_file_sync));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_file_sync(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_file_sync_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_file_sync_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -4991,15 +5241,16 @@ int libdumpi_grab_io_test(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpio_test val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpio_test));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpio_read_test(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpio_test_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpio_test_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
@@ -5009,15 +5260,16 @@ int libdumpi_grab_io_wait(dumpi_profile *profile, libundumpi_unsafe_fun callout,
   dumpio_wait val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpio_wait));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpio_read_wait(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpio_wait_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpio_wait_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
@@ -5027,15 +5279,16 @@ int libdumpi_grab_io_testall(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpio_testall val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpio_testall));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpio_read_testall(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpio_testall_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpio_testall_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   if(val.requests != NULL) DUMPIO_FREE_REQUEST(val.requests);
   if(val.statuses != NULL) DUMPI_FREE_STATUS(val.statuses);
   DUMPI_RELEASE_PERFTAGS(perf);
@@ -5046,15 +5299,16 @@ int libdumpi_grab_io_waitall(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpio_waitall val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpio_waitall));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpio_read_waitall(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpio_waitall_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpio_waitall_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   if(val.requests != NULL) DUMPIO_FREE_REQUEST(val.requests);
   if(val.statuses != NULL) DUMPI_FREE_STATUS(val.statuses);
   DUMPI_RELEASE_PERFTAGS(perf);
@@ -5065,15 +5319,16 @@ int libdumpi_grab_io_testany(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpio_testany val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpio_testany));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpio_read_testany(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpio_testany_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpio_testany_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   if(val.requests != NULL) DUMPIO_FREE_REQUEST(val.requests);
   if(val.statuses != NULL) DUMPI_FREE_STATUS(val.statuses);
   DUMPI_RELEASE_PERFTAGS(perf);
@@ -5084,15 +5339,16 @@ int libdumpi_grab_io_waitany(dumpi_profile *profile, libundumpi_unsafe_fun callo
   dumpio_waitany val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpio_waitany));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpio_read_waitany(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpio_waitany_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpio_waitany_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   if(val.requests != NULL) DUMPIO_FREE_REQUEST(val.requests);
   if(val.statuses != NULL) DUMPI_FREE_STATUS(val.statuses);
   DUMPI_RELEASE_PERFTAGS(perf);
@@ -5103,15 +5359,16 @@ int libdumpi_grab_io_waitsome(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpio_waitsome val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpio_waitsome));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpio_read_waitsome(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpio_waitsome_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpio_waitsome_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   if(val.requests != NULL) DUMPIO_FREE_REQUEST(val.requests);
   if(val.indices != NULL) DUMPI_FREE_INT(val.indices);
   if(val.statuses != NULL) DUMPI_FREE_STATUS(val.statuses);
@@ -5123,15 +5380,16 @@ int libdumpi_grab_io_testsome(dumpi_profile *profile, libundumpi_unsafe_fun call
   dumpio_testsome val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpio_testsome));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpio_read_testsome(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpio_testsome_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpio_testsome_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   if(val.requests != NULL) DUMPIO_FREE_REQUEST(val.requests);
   if(val.indices != NULL) DUMPI_FREE_INT(val.indices);
   if(val.statuses != NULL) DUMPI_FREE_STATUS(val.statuses);
@@ -5151,15 +5409,16 @@ int libundumpi_grab_function_enter(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_func_call val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_func_call));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_func_enter(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_function_enter_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_function_enter_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -5168,15 +5427,16 @@ int libundumpi_grab_function_exit(dumpi_profile *profile, libundumpi_unsafe_fun
   dumpi_func_call val;
   uint16_t thread;
   dumpi_time cpu, wall;
-  dumpi_perfinfo perf;
+  dumpi_perfdata perf;
   memset(&val, 0, sizeof(dumpi_func_call));
   thread = 0;
   memset(&cpu, 0, sizeof(dumpi_time));
   memset(&wall, 0, sizeof(dumpi_time));
-  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  perf.count = 0;
   dumpi_read_func_exit(&val, &thread, &cpu, &wall, &perf, profile);
   if(callout != NULL)
-    ((dumpi_function_exit_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+    ((dumpi_function_exit_call)callout)(&val, thread, &cpu, &wall,
+                                     libundumpi_perfinfo_compat(profile, &perf), uarg);
   DUMPI_RELEASE_PERFTAGS(perf);
   return 1;
 }
@@ -102,6 +102,19 @@ extern "C" {
     libundumpi_unsafe_fun   callout;
   } libundumpi_cbpair;
 
+  /**
+   * Compatibility shim from the compact dumpi_perfdata used while reading
+   * to the dumpi_perfinfo struct passed to callbacks.
+   * Records without perfcounters all share one empty (zeroed) struct, so
+   * the common case does no work at all.  Otherwise the values are copied
+   * into a struct owned by the profile (the labels only the first time).
+   * \param profile   The input profile the record was read from.
+   * \param perf      Perfcounter data for the current record.
+   * \return a struct that stays valid until the next record is read.
+   */
+  const dumpi_perfinfo* libundumpi_perfinfo_compat(dumpi_profile *profile,
+                                                   const dumpi_perfdata *perf);
+
   /**
    * Parse MPI send.
    * \param profile   An profile positioned at the start of the MPI call.
@@ -0,0 +1,856 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/libundumpi/dumpistate-internal-setup.h>
+#include <dumpi/libundumpi/libundumpi.h>
+#include <dumpi/libundumpi/bindings.h>
+#include <dumpi/common/iodefs.h>
+#include <dumpi/common/hashmap.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <assert.h>
+
+#define DUMPISTATE_BLEN 1024
+
+/* Map (parent uid, construct number) to a construct id and
+ * (construct id, color) to the uid of the new communicator */
+DUMPI_DECLARE_HASHMAP(ds_construct, uint64_t, int)
+DUMPI_DECLARE_HASHMAP(ds_uid, uint64_t, int)
+
+/* One rank's part in an MPI_Comm_split */
+typedef struct dumpistate_split {
+  int uid, key, world, parent_rank;
+  dumpistate_group *parent, *target;
+} dumpistate_split;
+
+/* State shared across all ranks while pre-parsing */
+typedef struct dumpistate_setup {
+  dumpi_hm_ds_construct *constructs;
+  dumpi_hm_ds_uid *uids;
+  int splits, maxsplits;
+  dumpistate_split *split;
+} dumpistate_setup;
+
+/* State for pre-parsing a single rank */
+typedef struct dumpistate_preparse {
+  dumpistate *state;
+  dumpistate_local *local;
+  dumpistate_setup *setup;
+  int rank, started;
+  dumpi_sizeof sizes;
+} dumpistate_preparse;
+
+static void set_message(char **message, const char *fmt, ...) {
+  char buf[DUMPISTATE_BLEN];
+  va_list args;
+  if(message == NULL) return;
+  va_start(args, fmt);
+  vsnprintf(buf, DUMPISTATE_BLEN, fmt, args);
+  va_end(args);
+  *message = strdup(buf);
+  assert(*message != NULL);
+}
+
+/*
+ * Read the number of ranks and the trace file names from a metafile.
+ */
+int dumpistate_read_metafile(const char *metafile, dumpistate_meta *meta,
+			     char **message)
+{
+  char buf[DUMPISTATE_BLEN], *dir, *prefix = NULL, *key, *value, *slash;
+  int i, width, found = 0, fanout = -1;
+  FILE *fp;
+  assert(metafile != NULL && meta != NULL);
+  memset(meta, 0, sizeof(dumpistate_meta));
+  if((fp = fopen(metafile, "r")) == NULL) {
+    set_message(message, "dumpistate_read_metafile:  Failed to open "
+		"metafile \"%s\": %s", metafile, strerror(errno));
+    return 0;
+  }
+  while(fgets(buf, DUMPISTATE_BLEN, fp) != NULL) {
+    buf[strcspn(buf, "\r\n")] = '\0';
+    if((value = strchr(buf, '=')) == NULL) continue;
+    *value++ = '\0';
+    key = buf;
+    if(strcmp(key, "numprocs") == 0)
+      meta->procs = atoi(value);
+    else if(strcmp(key, "fileprefix") == 0 && prefix == NULL)
+      prefix = strdup(value);
+    else if(strcmp(key, "fanout") == 0)
+      fanout = atoi(value);
+  }
+  fclose(fp);
+  if(meta->procs <= 0 || prefix == NULL) {
+    set_message(message, "dumpistate_read_metafile:  Could not find "
+		"numprocs and fileprefix in metafile \"%s\"", metafile);
+    free(prefix);
+    return 0;
+  }
+  /* Trace files live next to the metafile */
+  dir = strdup(metafile);
+  assert(dir != NULL);
+  if((slash = strrchr(dir, '/')) != NULL) slash[1] = '\0';
+  else dir[0] = '\0';
+  snprintf(buf, DUMPISTATE_BLEN, "%s%s", dir, prefix);
+  free(dir);
+  free(prefix);
+  meta->prefix = strdup(buf);
+  assert(meta->prefix != NULL);
+  meta->width = DUMPI_TRACE_WIDTH;
+  if(fanout >= 0) {
+    /* Newer metafiles give the layout of the trace files */
+    meta->fanout = fanout;
+    return 1;
+  }
+  /* dumpi writes %04d by default, but try wider ranks as well */
+  for(width = 4; width < 14 && ! found; ++width) {
+    found = 1;
+    for(i = 0; i < meta->procs; ++i) {
+      dumpi_trace_filename(buf, DUMPISTATE_BLEN, meta->prefix, width, 0, i);
+      if((fp = fopen(buf, "r")) == NULL) {
+	found = 0;
+	break;
+      }
+      fclose(fp);
+    }
+    if(found)
+      meta->width = width;
+  }
+  if(! found) {
+    set_message(message, "dumpistate_read_metafile:  Failed to find %d "
+		"trace files with prefix %s", meta->procs, meta->prefix);
+    free(meta->prefix);
+    meta->prefix = NULL;
+    return 0;
+  }
+  return 1;
+}
+
+/*
+ * Allocate the per-rank state.
+ */
+int dumpistate_alloc_locals(dumpistate *state, char **message) {
+  assert(state != NULL);
+  state->state = (dumpistate_local*)calloc(state->meta.procs,
+					   sizeof(dumpistate_local));
+  if(state->state == NULL) {
+    set_message(message, "dumpistate_alloc_locals:  Failed to allocate "
+		"state for %d ranks", state->meta.procs);
+    return 0;
+  }
+  return 1;
+}
+
+/*
+ * Open the trace file of the given rank.
+ */
+dumpi_profile* dumpistate_open_stream(const dumpistate *state, int rank) {
+  char fname[DUMPISTATE_BLEN];
+  dumpi_trace_filename(fname, DUMPISTATE_BLEN, state->meta.prefix,
+		       state->meta.width, state->meta.fanout, rank);
+  return undumpi_open(fname);
+}
+
+/* Make room for index in a table of list heads */
+static void* grow_table(void *entry, int *length, int index) {
+  void **table = (void**)entry;
+  int newlen;
+  if(index < *length) return table;
+  newlen = (*length > 0 ? *length : 16);
+  while(newlen <= index) newlen *= 2;
+  table = (void**)realloc(table, newlen * sizeof(void*));
+  assert(table != NULL);
+  memset(table + *length, 0, (newlen - *length) * sizeof(void*));
+  *length = newlen;
+  return table;
+}
+
+/* Add a new communicator (or group, or type) at the head of its list */
+static dumpistate_comm* push_comm(dumpistate_local *local, dumpi_comm index) {
+  dumpistate_comm_ll *ll;
+  assert(index >= 0);
+  local->comms.entry = (dumpistate_comm_ll**)
+    grow_table(local->comms.entry, &local->comms.length, index);
+  assert((ll = (dumpistate_comm_ll*)calloc(1, sizeof(dumpistate_comm_ll)))
+	 != NULL);
+  ll->next = local->comms.entry[index];
+  local->comms.entry[index] = ll;
+  return &ll->comm;
+}
+
+static dumpistate_group* push_group(dumpistate_local *local,
+				    dumpi_group index)
+{
+  dumpistate_group_ll *ll;
+  assert(index >= 0);
+  local->groups.entry = (dumpistate_group_ll**)
+    grow_table(local->groups.entry, &local->groups.length, index);
+  assert((ll = (dumpistate_group_ll*)calloc(1, sizeof(dumpistate_group_ll)))
+	 != NULL);
+  ll->next = local->groups.entry[index];
+  local->groups.entry[index] = ll;
+  return &ll->group;
+}
+
+static dumpistate_type* push_type(dumpistate_local *local,
+				  dumpi_datatype index)
+{
+  dumpistate_type_ll *ll;
+  assert(index >= 0);
+  local->types.entry = (dumpistate_type_ll**)
+    grow_table(local->types.entry, &local->types.length, index);
+  assert((ll = (dumpistate_type_ll*)calloc(1, sizeof(dumpistate_type_ll)))
+	 != NULL);
+  ll->next = local->types.entry[index];
+  local->types.entry[index] = ll;
+  return &ll->type;
+}
+
+/* The most recent communicator (or group, or type) using an index */
+static dumpistate_comm* current_comm(dumpistate_local *local,
+				     dumpi_comm index)
+{
+  if(index < 0 || index >= local->comms.length ||
+     local->comms.entry[index] == NULL)
+    return NULL;
+  return &local->comms.entry[index]->comm;
+}
+
+static dumpistate_group* current_group(dumpistate_local *local,
+				       dumpi_group index)
+{
+  if(index < 0 || index >= local->groups.length ||
+     local->groups.entry[index] == NULL)
+    return NULL;
+  return &local->groups.entry[index]->group;
+}
+
+static int current_type_size(const dumpistate_preparse *pp,
+			     dumpi_datatype index)
+{
+  const dumpistate_local *local = pp->local;
+  if(index >= 0 && index < local->types.length &&
+     local->types.entry[index] != NULL)
+    return local->types.entry[index]->type.size;
+  if(index >= 0 && index < pp->sizes.count && pp->sizes.size != NULL)
+    return pp->sizes.size[index];
+  return 0;
+}
+
+/* Uid of a communicator built from parent (the same on all ranks that
+ * share the new communicator) */
+static int next_uid(dumpistate_setup *setup, dumpistate_comm *parent,
+		    int color)
+{
+  uint64_t key = ((uint64_t)(uint32_t)parent->uid << 32) |
+    (uint32_t)parent->constructs++;
+  int construct = dumpi_hm_ds_construct_get(setup->constructs, key);
+  key = ((uint64_t)(uint32_t)construct << 32) | (uint32_t)color;
+  return dumpi_hm_ds_uid_get(setup->uids, key);
+}
+
+/* Add a communicator that copies the membership of another group */
+static dumpistate_comm* derived_comm(dumpistate_preparse *pp,
+				     dumpi_function creator,
+				     dumpi_comm index, dumpistate_group *source,
+				     const dumpi_time *wall)
+{
+  dumpistate_comm *comm = push_comm(pp->local, index);
+  comm->committed = wall->stop;
+  comm->creator = creator;
+  comm->group.created = wall->stop;
+  comm->group.size = comm->group.rank = -1;
+  comm->group.recipe = (source ? DUMPISTATE_COPY : DUMPISTATE_UNKNOWN);
+  comm->group.source = source;
+  return comm;
+}
+
+/* Every call goes through here (time bounds) */
+static int preparse_any(const void *prm, uint16_t thread,
+			const dumpi_time *cpu, const dumpi_time *wall,
+			const dumpi_perfinfo *perf, void *uarg)
+{
+  dumpistate_preparse *pp = (dumpistate_preparse*)uarg;
+  (void)prm; (void)thread; (void)cpu; (void)perf;
+  if(! pp->started) {
+    pp->local->time_bounds.start = wall->start;
+    pp->started = 1;
+  }
+  pp->local->time_bounds.stop = wall->stop;
+  return 1;
+}
+
+/* Boilerplate for the calls we need to look at */
+#define DUMPISTATE_PREPARSE(NAME)					\
+static int preparse_##NAME(const dumpi_##NAME *prm, uint16_t thread,	\
+			   const dumpi_time *cpu, const dumpi_time *wall, \
+			   const dumpi_perfinfo *perf, void *uarg)	\
+{									\
+  dumpistate_preparse *pp = (dumpistate_preparse*)uarg;		\
+  preparse_any(prm, thread, cpu, wall, perf, uarg);
+
+#define DUMPISTATE_PREPARSE_END			\
+  return 1;					\
+}
+
+static void mpi_started(dumpistate_preparse *pp, const dumpi_time *wall) {
+  dumpistate_local *local = pp->local;
+  local->mpi_bounds.start = wall->start;
+  local->init_done = wall->stop;
+  current_comm(local, DUMPI_COMM_WORLD)->committed = wall->stop;
+  current_comm(local, DUMPI_COMM_WORLD)->group.created = wall->stop;
+  current_comm(local, DUMPI_COMM_SELF)->committed = wall->stop;
+  current_comm(local, DUMPI_COMM_SELF)->group.created = wall->stop;
+}
+
+DUMPISTATE_PREPARSE(init)
+  mpi_started(pp, wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(init_thread)
+  mpi_started(pp, wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(finalize)
+  dumpistate_local *local = pp->local;
+  local->mpi_bounds.stop = wall->stop;
+  current_comm(local, DUMPI_COMM_WORLD)->freed = wall->start;
+  current_comm(local, DUMPI_COMM_WORLD)->group.destroyed = wall->start;
+  current_comm(local, DUMPI_COMM_SELF)->freed = wall->start;
+  current_comm(local, DUMPI_COMM_SELF)->group.destroyed = wall->start;
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(comm_dup)
+  dumpistate_comm *parent = current_comm(pp->local, prm->oldcomm);
+  if(parent != NULL && prm->newcomm != DUMPI_COMM_NULL) {
+    int uid = next_uid(pp->setup, parent, 0);
+    derived_comm(pp, DUMPI_Comm_dup, prm->newcomm, &parent->group,
+		 wall)->uid = uid;
+  }
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(comm_create)
+  dumpistate_comm *parent = current_comm(pp->local, prm->oldcomm);
+  if(parent != NULL) {
+    int uid = next_uid(pp->setup, parent, 0);
+    if(prm->newcomm != DUMPI_COMM_NULL)
+      derived_comm(pp, DUMPI_Comm_create, prm->newcomm,
+		   current_group(pp->local, prm->group), wall)->uid = uid;
+  }
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(comm_split)
+  dumpistate_comm *parent = current_comm(pp->local, prm->oldcomm);
+  if(parent != NULL) {
+    int uid = next_uid(pp->setup, parent, prm->color);
+    if(prm->newcomm != DUMPI_COMM_NULL) {
+      dumpistate_setup *setup = pp->setup;
+      dumpistate_comm *comm = derived_comm(pp, DUMPI_Comm_split,
+					   prm->newcomm, NULL, wall);
+      dumpistate_split *split;
+      comm->uid = uid;
+      comm->group.recipe = DUMPISTATE_SPLIT;
+      if(setup->splits == setup->maxsplits) {
+	setup->maxsplits = (setup->maxsplits ? 2*setup->maxsplits : 64);
+	setup->split = (dumpistate_split*)
+	  realloc(setup->split, setup->maxsplits * sizeof(dumpistate_split));
+	assert(setup->split != NULL);
+      }
+      split = &setup->split[setup->splits++];
+      split->uid = uid;
+      split->key = prm->key;
+      split->world = pp->rank;
+      split->parent_rank = -1;
+      split->parent = &parent->group;
+      split->target = &comm->group;
+    }
+  }
+DUMPISTATE_PREPARSE_END
+
+/* Cartesian and graph communicators are taken to keep the rank order of
+ * the parent (i.e. the implementation does not reorder). */
+DUMPISTATE_PREPARSE(cart_create)
+  dumpistate_comm *parent = current_comm(pp->local, prm->oldcomm);
+  if(parent != NULL) {
+    int uid = next_uid(pp->setup, parent, 0);
+    if(prm->newcomm != DUMPI_COMM_NULL)
+      derived_comm(pp, DUMPI_Cart_create, prm->newcomm, &parent->group,
+		   wall)->uid = uid;
+  }
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(graph_create)
+  dumpistate_comm *parent = current_comm(pp->local, prm->oldcomm);
+  if(parent != NULL) {
+    int uid = next_uid(pp->setup, parent, 0);
+    if(prm->newcomm != DUMPI_COMM_NULL)
+      derived_comm(pp, DUMPI_Graph_create, prm->newcomm, &parent->group,
+		   wall)->uid = uid;
+  }
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(comm_free)
+  dumpistate_comm *comm = current_comm(pp->local, prm->comm);
+  if(comm != NULL) {
+    comm->freed = wall->start;
+    comm->group.destroyed = wall->start;
+  }
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(comm_group)
+  dumpistate_comm *comm = current_comm(pp->local, prm->comm);
+  dumpistate_group *group = push_group(pp->local, prm->group);
+  group->created = wall->stop;
+  group->size = group->rank = -1;
+  group->recipe = (comm ? DUMPISTATE_COPY : DUMPISTATE_UNKNOWN);
+  group->source = (comm ? &comm->group : NULL);
+DUMPISTATE_PREPARSE_END
+
+/* MPI_Group_incl and MPI_Group_excl */
+static void group_subset(dumpistate_preparse *pp, dumpistate_recipe recipe,
+			 dumpi_group source, int count, const int *ranks,
+			 dumpi_group newgroup, const dumpi_time *wall)
+{
+  dumpistate_group *group = push_group(pp->local, newgroup);
+  group->created = wall->stop;
+  group->size = group->rank = -1;
+  group->source = current_group(pp->local, source);
+  group->recipe = (group->source ? recipe : DUMPISTATE_UNKNOWN);
+  if(count > 0) {
+    assert((group->ranks = (int*)malloc(count * sizeof(int))) != NULL);
+    memcpy(group->ranks, ranks, count * sizeof(int));
+    group->nranks = count;
+  }
+}
+
+DUMPISTATE_PREPARSE(group_incl)
+  group_subset(pp, DUMPISTATE_INCL, prm->group, prm->count, prm->ranks,
+	       prm->newgroup, wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(group_excl)
+  group_subset(pp, DUMPISTATE_EXCL, prm->group, prm->count, prm->ranks,
+	       prm->newgroup, wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(group_free)
+  dumpistate_group *group = current_group(pp->local, prm->group);
+  if(group != NULL)
+    group->destroyed = wall->start;
+DUMPISTATE_PREPARSE_END
+
+/* User-defined datatypes */
+static void new_type(dumpistate_preparse *pp, dumpi_datatype index,
+		     int64_t size, const dumpi_time *wall)
+{
+  dumpistate_type *type = push_type(pp->local, index);
+  type->created = wall->stop;
+  type->size = (int)size;
+}
+
+static int64_t sum_lengths(int count, const int *lengths) {
+  int64_t sum = 0;
+  int i;
+  for(i = 0; i < count; ++i) sum += lengths[i];
+  return sum;
+}
+
+DUMPISTATE_PREPARSE(type_contiguous)
+  new_type(pp, prm->newtype,
+	   (int64_t)prm->count * current_type_size(pp, prm->oldtype), wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(type_vector)
+  new_type(pp, prm->newtype, (int64_t)prm->count * prm->blocklength *
+	   current_type_size(pp, prm->oldtype), wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(type_hvector)
+  new_type(pp, prm->newtype, (int64_t)prm->count * prm->blocklength *
+	   current_type_size(pp, prm->oldtype), wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(type_indexed)
+  new_type(pp, prm->newtype, sum_lengths(prm->count, prm->lengths) *
+	   current_type_size(pp, prm->oldtype), wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(type_hindexed)
+  new_type(pp, prm->newtype, sum_lengths(prm->count, prm->lengths) *
+	   current_type_size(pp, prm->oldtype), wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(type_struct)
+  int64_t size = 0;
+  int i;
+  for(i = 0; i < prm->count; ++i)
+    size += (int64_t)prm->lengths[i] * current_type_size(pp, prm->oldtypes[i]);
+  new_type(pp, prm->newtype, size, wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(type_create_struct)
+  int64_t size = 0;
+  int i;
+  for(i = 0; i < prm->count; ++i)
+    size += (int64_t)prm->blocklengths[i] *
+      current_type_size(pp, prm->oldtypes[i]);
+  new_type(pp, prm->newtype, size, wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(type_dup)
+  new_type(pp, prm->newtype, current_type_size(pp, prm->oldtype), wall);
+DUMPISTATE_PREPARSE_END
+
+DUMPISTATE_PREPARSE(type_free)
+  if(prm->datatype >= 0 && prm->datatype < pp->local->types.length &&
+     pp->local->types.entry[prm->datatype] != NULL)
+    pp->local->types.entry[prm->datatype]->type.freed = wall->start;
+DUMPISTATE_PREPARSE_END
+
+/* Set up parsers and the callouts above */
+static void populate_preparse(libundumpi_cbpair *callarr) {
+  int i;
+  libundumpi_callbacks unused;
+  libundumpi_clear_callbacks(&unused);
+  libundumpi_populate_handlers(&unused, callarr);
+  for(i = 0; i < DUMPI_END_OF_STREAM; ++i)
+    callarr[i].callout = preparse_any;
+#define DUMPISTATE_SET_PREPARSE(FUNC, NAME)			\
+  callarr[FUNC].callout = (libundumpi_unsafe_fun)preparse_##NAME
+  DUMPISTATE_SET_PREPARSE(DUMPI_Init, init);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Init_thread, init_thread);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Finalize, finalize);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Comm_dup, comm_dup);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Comm_create, comm_create);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Comm_split, comm_split);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Cart_create, cart_create);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Graph_create, graph_create);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Comm_free, comm_free);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Comm_group, comm_group);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Group_incl, group_incl);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Group_excl, group_excl);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Group_free, group_free);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Type_contiguous, type_contiguous);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Type_vector, type_vector);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Type_hvector, type_hvector);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Type_indexed, type_indexed);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Type_hindexed, type_hindexed);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Type_struct, type_struct);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Type_create_struct, type_create_struct);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Type_dup, type_dup);
+  DUMPISTATE_SET_PREPARSE(DUMPI_Type_free, type_free);
+#undef DUMPISTATE_SET_PREPARSE
+}
+
+/* Built-in communicators, groups and datatypes */
+static void add_builtins(dumpistate_preparse *pp) {
+  dumpistate_local *local = pp->local;
+  dumpistate_comm *comm;
+  dumpistate_group *group;
+  dumpi_datatype i;
+  comm = push_comm(local, DUMPI_COMM_WORLD);
+  comm->creator = DUMPI_Init;
+  comm->uid = 0;
+  comm->group.size = pp->state->meta.procs;
+  comm->group.rank = pp->rank;
+  comm = push_comm(local, DUMPI_COMM_SELF);
+  comm->creator = DUMPI_Init;
+  comm->uid = 1 + pp->rank;
+  comm->group.size = 1;
+  comm->group.rank = 0;
+  assert((comm->group.global = (int*)malloc(sizeof(int))) != NULL);
+  comm->group.global[0] = pp->rank;
+  comm->group.owns_global = 1;
+  group = push_group(local, DUMPI_GROUP_EMPTY);
+  group->rank = -1;
+  for(i = 0; i < pp->sizes.count && i < DUMPI_FIRST_USER_DATATYPE; ++i)
+    push_type(local, i)->size = pp->sizes.size[i];
+}
+
+/* Pre-parse the trace of one rank */
+static int preparse_rank(dumpistate *state, dumpistate_setup *setup,
+			 int rank, char **message)
+{
+  libundumpi_cbpair callarr[DUMPI_END_OF_STREAM] = {{NULL, NULL}};
+  dumpistate_preparse pp;
+  dumpistate_local *local = &state->state[rank];
+  dumpi_profile *profile;
+  dumpi_function currfunc;
+  int finalized = 0, count = 0, i;
+  uint64_t *addresses = NULL;
+  char **names = NULL;
+  if((profile = dumpistate_open_stream(state, rank)) == NULL) {
+    set_message(message, "dumpistate_preparse_streams:  Failed to open "
+		"the trace file of rank %d", rank);
+    return 0;
+  }
+  memset(&pp, 0, sizeof(dumpistate_preparse));
+  pp.state = state;
+  pp.local = local;
+  pp.setup = setup;
+  pp.rank = rank;
+  pp.sizes = undumpi_read_datatype_sizes(profile);
+  dumpi_read_function_addresses(profile, &count, &addresses, &names);
+  if(count > 0) {
+    assert((local->functions.func = (dumpistate_function*)
+	    malloc(count * sizeof(dumpistate_function))) != NULL);
+    for(i = 0; i < count; ++i) {
+      local->functions.func[i].address = addresses[i];
+      local->functions.func[i].name = names[i];
+    }
+    local->functions.length = count;
+  }
+  free(addresses);
+  free(names);
+  add_builtins(&pp);
+  populate_preparse(callarr);
+  if(dumpi_start_stream_read(profile)) {
+    while((currfunc = dumpi_read_next_function(profile))
+	  < DUMPI_END_OF_STREAM) {
+      if(finalized && currfunc == 0)
+	break; /* old-style end of stream */
+      if(currfunc == DUMPI_Finalize)
+	finalized = 1;
+      callarr[currfunc].handler(profile, callarr[currfunc].callout, &pp);
+      profile->pos = DUMPI_READ_TELL(profile);
+      if(profile->pos >= dumpi_stream_end(profile))
+	break;
+    }
+  }
+  /* Types built by calls we don't model get the size libdumpi recorded */
+  for(i = DUMPI_FIRST_USER_DATATYPE; i < pp.sizes.count; ++i)
+    if(i >= local->types.length || local->types.entry[i] == NULL)
+      push_type(local, i)->size = pp.sizes.size[i];
+  free(pp.sizes.size);
+  undumpi_close(profile);
+  free(profile);
+  return 1;
+}
+
+/* Local rank of a global rank in a resolved group (-1 if absent) */
+static int find_rank(const dumpistate_group *group, int world) {
+  int i;
+  if(group->size < 0) return -1;
+  if(group->global == NULL)
+    return (world < group->size ? world : -1);
+  for(i = 0; i < group->size; ++i)
+    if(group->global[i] == world) return i;
+  return -1;
+}
+
+/* Work out the membership of a group from its recipe */
+static void resolve_group(dumpistate_group *group, int world) {
+  dumpistate_group *source = group->source;
+  int i, j, n;
+  switch(group->recipe) {
+  case DUMPISTATE_RESOLVED:
+    return;
+  case DUMPISTATE_COPY:
+    resolve_group(source, world);
+    group->size = source->size;
+    group->global = source->global;
+    group->rank = source->rank;
+    break;
+  case DUMPISTATE_INCL:
+  case DUMPISTATE_EXCL:
+    resolve_group(source, world);
+    if(source->size < 0) break;
+    assert((group->global = (int*)malloc((source->size+1) * sizeof(int)))
+	   != NULL);
+    group->owns_global = 1;
+    n = 0;
+    if(group->recipe == DUMPISTATE_INCL) {
+      for(i = 0; i < group->nranks; ++i)
+	if(group->ranks[i] >= 0 && group->ranks[i] < source->size)
+	  group->global[n++] = (source->global ?
+				source->global[group->ranks[i]] :
+				group->ranks[i]);
+    }
+    else {
+      for(i = 0; i < source->size; ++i) {
+	for(j = 0; j < group->nranks; ++j)
+	  if(group->ranks[j] == i) break;
+	if(j == group->nranks)
+	  group->global[n++] = (source->global ? source->global[i] : i);
+      }
+    }
+    group->size = n;
+    group->rank = find_rank(group, world);
+    break;
+  default:
+    /* Split partners were not found, or the group was never defined */
+    group->size = group->rank = -1;
+    break;
+  }
+  group->recipe = DUMPISTATE_RESOLVED;
+}
+
+static int split_order(const void *pa, const void *pb) {
+  const dumpistate_split *a = (const dumpistate_split*)pa;
+  const dumpistate_split *b = (const dumpistate_split*)pb;
+  if(a->uid != b->uid) return (a->uid < b->uid ? -1 : 1);
+  if(a->key != b->key) return (a->key < b->key ? -1 : 1);
+  if(a->parent_rank != b->parent_rank)
+    return (a->parent_rank < b->parent_rank ? -1 : 1);
+  return (a->world < b->world ? -1 : (a->world > b->world));
+}
+
+/* Collect the members of every MPI_Comm_split from all ranks.
+ * Parents always have a smaller uid than their children, so splits are
+ * resolved in uid order. */
+static void resolve_splits(dumpistate_setup *setup) {
+  int first, last, i, *global;
+  if(setup->splits > 0)
+    qsort(setup->split, setup->splits, sizeof(dumpistate_split),
+	  split_order);
+  for(first = 0; first < setup->splits; first = last) {
+    for(last = first; last < setup->splits &&
+	  setup->split[last].uid == setup->split[first].uid; ++last) {
+      dumpistate_split *split = &setup->split[last];
+      resolve_group(split->parent, split->world);
+      split->parent_rank = find_rank(split->parent, split->world);
+    }
+    qsort(setup->split + first, last - first, sizeof(dumpistate_split),
+	  split_order);
+    assert((global = (int*)malloc((last - first) * sizeof(int))) != NULL);
+    for(i = first; i < last; ++i)
+      global[i - first] = setup->split[i].world;
+    for(i = first; i < last; ++i) {
+      dumpistate_group *target = setup->split[i].target;
+      target->size = last - first;
+      target->rank = i - first;
+      target->global = global;
+      target->owns_global = (i == first);
+      target->recipe = DUMPISTATE_RESOLVED;
+    }
+  }
+}
+
+/*
+ * Run through the trace of every rank.
+ */
+int dumpistate_preparse_streams(dumpistate *state, char **message) {
+  dumpistate_setup setup;
+  int rank, i, status = 1;
+  memset(&setup, 0, sizeof(dumpistate_setup));
+  dumpi_hm_ds_construct_init(&setup.constructs, 0);
+  /* 0 is MPI_COMM_WORLD and 1..procs are MPI_COMM_SELF */
+  dumpi_hm_ds_uid_init(&setup.uids, state->meta.procs + 1);
+  for(rank = 0; rank < state->meta.procs && status; ++rank)
+    status = preparse_rank(state, &setup, rank, message);
+  if(status) {
+    resolve_splits(&setup);
+    for(rank = 0; rank < state->meta.procs; ++rank) {
+      dumpistate_local *local = &state->state[rank];
+      for(i = 0; i < local->comms.length; ++i) {
+	dumpistate_comm_ll *ll;
+	for(ll = local->comms.entry[i]; ll != NULL; ll = ll->next)
+	  resolve_group(&ll->comm.group, rank);
+      }
+      for(i = 0; i < local->groups.length; ++i) {
+	dumpistate_group_ll *ll;
+	for(ll = local->groups.entry[i]; ll != NULL; ll = ll->next)
+	  resolve_group(&ll->group, rank);
+      }
+    }
+  }
+  dumpi_hm_ds_construct_free(&setup.constructs);
+  dumpi_hm_ds_uid_free(&setup.uids);
+  free(setup.split);
+  return status;
+}
+
+static void free_group(dumpistate_group *group) {
+  if(group->owns_global)
+    free(group->global);
+  free(group->ranks);
+}
+
+/*
+ * Release everything allocated while setting up.
+ */
+void dumpistate_free_locals(dumpistate *state) {
+  int rank, i;
+  if(state->state != NULL) {
+    for(rank = 0; rank < state->meta.procs; ++rank) {
+      dumpistate_local *local = &state->state[rank];
+      for(i = 0; i < local->comms.length; ++i) {
+	dumpistate_comm_ll *ll = local->comms.entry[i], *next;
+	for(; ll != NULL; ll = next) {
+	  next = ll->next;
+	  free_group(&ll->comm.group);
+	  free(ll);
+	}
+      }
+      for(i = 0; i < local->groups.length; ++i) {
+	dumpistate_group_ll *ll = local->groups.entry[i], *next;
+	for(; ll != NULL; ll = next) {
+	  next = ll->next;
+	  free_group(&ll->group);
+	  free(ll);
+	}
+      }
+      for(i = 0; i < local->types.length; ++i) {
+	dumpistate_type_ll *ll = local->types.entry[i], *next;
+	for(; ll != NULL; ll = next) {
+	  next = ll->next;
+	  free(ll);
+	}
+      }
+      for(i = 0; i < local->functions.length; ++i)
+	free(local->functions.func[i].name);
+      free(local->comms.entry);
+      free(local->groups.entry);
+      free(local->types.entry);
+      free(local->functions.func);
+    }
+    free(state->state);
+    state->state = NULL;
+  }
+  free(state->meta.prefix);
+  state->meta.prefix = NULL;
+}
@@ -0,0 +1,89 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_LIBUNDUMPI_DUMPISTATE_INTERNAL_SETUP_H
+#define DUMPI_LIBUNDUMPI_DUMPISTATE_INTERNAL_SETUP_H
+
+#include <dumpi/libundumpi/dumpistate-internal-types.h>
+#include <dumpi/common/types.h>
+
+/**
+ * \ingroup dumpistate_internal
+ */
+/*@{*/ /* put subsequent doxygen comments in group dumpistate_internal */
+
+/**
+ * Read the number of ranks and the trace file names from a metafile.
+ * \return 1 on success, 0 on failure (*message is then set if non-NULL).
+ */
+int dumpistate_read_metafile(const char *metafile, dumpistate_meta *meta,
+			     char **message);
+
+/**
+ * Allocate the per-rank state (meta.procs entries).
+ * \return 1 on success, 0 on failure (*message is then set if non-NULL).
+ */
+int dumpistate_alloc_locals(dumpistate *state, char **message);
+
+/**
+ * Run through the trace of every rank to collect time bounds,
+ * communicator, group and datatype history and function names.
+ * \return 1 on success, 0 on failure (*message is then set if non-NULL).
+ */
+int dumpistate_preparse_streams(dumpistate *state, char **message);
+
+/**
+ * Release everything allocated by the three calls above.
+ */
+void dumpistate_free_locals(dumpistate *state);
+
+/**
+ * Open the trace file of the given rank.
+ * \return the profile (release with undumpi_close and free), or NULL.
+ */
+dumpi_profile* dumpistate_open_stream(const dumpistate *state, int rank);
+
+/*@}*/ /* close doxygen group 'dumpistate_internal' */
+
+#endif /* DUMPI_LIBUNDUMPI_DUMPISTATE_INTERNAL_SETUP_H */
@@ -0,0 +1,189 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_LIBUNDUMPI_DUMPISTATE_INTERNAL_TYPES_H
+#define DUMPI_LIBUNDUMPI_DUMPISTATE_INTERNAL_TYPES_H
+
+#include <dumpi/libundumpi/dumpistate.h>
+#include <dumpi/common/types.h>
+#include <stdint.h>
+
+/**
+ * \ingroup dumpistate
+ * \defgroup dumpistate_internal dumpistate/internal:  Internal types \
+ *   used by dumpistate (not a stable interface).
+ */
+/*@{*/ /* put subsequent doxygen comments in group dumpistate_internal */
+
+/** Number of calls each rank reads ahead in dumpistate_parse_all. */
+#define DUMPISTATE_READAHEAD 1024
+
+/**
+ * How the membership of a group is obtained once all streams have been
+ * pre-parsed (communicators built with MPI_Comm_split need the arguments
+ * from every participating rank).
+ */
+typedef enum dumpistate_recipe {
+  DUMPISTATE_RESOLVED = 0,
+  DUMPISTATE_COPY,
+  DUMPISTATE_INCL,
+  DUMPISTATE_EXCL,
+  DUMPISTATE_SPLIT,
+  DUMPISTATE_UNKNOWN
+} dumpistate_recipe;
+
+struct dumpistate_group {
+  /** Walltime at return from the creating call. */
+  dumpi_clock created;
+  /** Walltime at entry into the freeing call (zero if never freed). */
+  dumpi_clock destroyed;
+  /** Number of members (-1 if the membership could not be worked out). */
+  int size;
+  /** Rank of the host node in the group (-1 if not a member). */
+  int rank;
+  /** Global rank of each local rank.  NULL means the identity map
+   *  (the group of MPI_COMM_WORLD). */
+  int *global;
+  /** Set if global belongs to this group (it is otherwise shared). */
+  int owns_global;
+  /** How the membership is built (DUMPISTATE_RESOLVED once it is). */
+  dumpistate_recipe recipe;
+  /** The group this one is copied or derived from. */
+  struct dumpistate_group *source;
+  /** Ranks (in source) passed to MPI_Group_incl or MPI_Group_excl. */
+  int nranks, *ranks;
+};
+
+struct dumpistate_comm {
+  /** Walltime at return from the creating call. */
+  dumpi_clock committed;
+  /** Walltime at entry into MPI_Comm_free (zero if never freed). */
+  dumpi_clock freed;
+  /** The call that created this communicator. */
+  dumpi_function creator;
+  /** Membership. */
+  dumpistate_group group;
+  /** Identifier shared by all ranks holding this communicator. */
+  int uid;
+  /** Number of communicators built from this one so far. */
+  int constructs;
+};
+
+struct dumpistate_type {
+  /** Walltime at return from the creating call (zero for built-ins). */
+  dumpi_clock created;
+  /** Walltime at entry into MPI_Type_free (zero if never freed). */
+  dumpi_clock freed;
+  /** Size in bytes. */
+  int size;
+};
+
+/** All communicators that have used a given index (newest first). */
+typedef struct dumpistate_comm_ll {
+  dumpistate_comm comm;
+  struct dumpistate_comm_ll *next;
+} dumpistate_comm_ll;
+
+/** All groups that have used a given index (newest first). */
+typedef struct dumpistate_group_ll {
+  dumpistate_group group;
+  struct dumpistate_group_ll *next;
+} dumpistate_group_ll;
+
+/** All datatypes that have used a given index (newest first). */
+typedef struct dumpistate_type_ll {
+  dumpistate_type type;
+  struct dumpistate_type_ll *next;
+} dumpistate_type_ll;
+
+/** A profiled function address and its name. */
+typedef struct dumpistate_function {
+  uint64_t address;
+  char *name;
+} dumpistate_function;
+
+/** Everything we know about one rank. */
+typedef struct dumpistate_local {
+  /** Entry into the first and exit from the last call in the trace. */
+  dumpi_time time_bounds;
+  /** Entry into MPI_Init* and exit from MPI_Finalize. */
+  dumpi_time mpi_bounds;
+  /** Exit from MPI_Init* (used to line up the clocks of all ranks). */
+  dumpi_clock init_done;
+  struct {
+    int length;
+    dumpistate_comm_ll **entry;
+  } comms;
+  struct {
+    int length;
+    dumpistate_group_ll **entry;
+  } groups;
+  struct {
+    int length;
+    dumpistate_type_ll **entry;
+  } types;
+  struct {
+    int length;
+    dumpistate_function *func;
+  } functions;
+} dumpistate_local;
+
+/** What we get from the metafile. */
+typedef struct dumpistate_meta {
+  /** Number of ranks. */
+  int procs;
+  /** Trace files are named as in dumpi_trace_filename. */
+  char *prefix;
+  int width, fanout;
+} dumpistate_meta;
+
+struct dumpistate {
+  dumpistate_meta meta;
+  /** One entry per rank. */
+  dumpistate_local *state;
+};
+
+/*@}*/ /* close doxygen group 'dumpistate_internal' */
+
+#endif /* DUMPI_LIBUNDUMPI_DUMPISTATE_INTERNAL_TYPES_H */
@@ -45,6 +45,10 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <dumpi/libundumpi/dumpistate.h>
 #include <dumpi/libundumpi/dumpistate-internal-types.h>
 #include <dumpi/libundumpi/dumpistate-internal-setup.h>
+#include <dumpi/libundumpi/libundumpi.h>
+#include <dumpi/libundumpi/bindings.h>
+#include <dumpi/libundumpi/batch.h>
+#include <dumpi/common/iodefs.h>
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
@@ -55,8 +59,6 @@ Questions? Contact sst-macro-help@sandia.gov
 dumpistate* dumpistate_create(const char *metafile, char **message)
 {
   dumpistate *retval = (dumpistate*)calloc(1, sizeof(dumpistate));
-  (void)metafile;
-  (void)message;
   if(retval == NULL) {
     if(message != NULL) {
       *message = strdup("dumpistate_create:  Failed to allocate dumpistate.");
@@ -67,8 +69,6 @@ dumpistate* dumpistate_create(const char *metafile, char **message)
     /* This is a little ugly since we don't want to leak memory
      * (it would be a little prettier with goto, though */
     int scratch = dumpistate_read_metafile(metafile, &retval->meta, message);
-    if(scratch) scratch = 
-		  dumpistate_read_metafile(metafile, &retval->meta, message);
     if(scratch) scratch = dumpistate_alloc_locals(retval, message);
     if(scratch) scratch = dumpistate_preparse_streams(retval, message);
     if(scratch == 0) {
@@ -83,20 +83,207 @@ dumpistate* dumpistate_create(const char *metafile, char **message)
  * Free all memory dynamically allocated to the given dumpi state.
  */
 void dumpistate_free(dumpistate *state) {
-  fprintf(stderr, "Unimplemented:  dumpistate_free\n");
+  if(state == NULL) return;
+  dumpistate_free_locals(state);
+  free(state);
+}
+
+/* Convert a dumpi_clock to nanoseconds */
+static inline int64_t to_nsec(const dumpi_clock *clk) {
+  return (int64_t)clk->sec * 1000000000LL + clk->nsec;
+}
+
+/* Passes decoded calls on to the user callback */
+typedef struct dumpistate_relay {
+  int rank;
+  dumpi_function func;
+  dumpistate_callback_fun_t callb;
+  void *userarg;
+  int status;
+} dumpistate_relay;
+
+static int relay_call(const void *prm, uint16_t thread, const dumpi_time *cpu,
+		      const dumpi_time *wall, const dumpi_perfinfo *perf,
+		      void *uarg)
+{
+  dumpistate_relay *relay = (dumpistate_relay*)uarg;
+  relay->status = relay->callb(relay->rank, relay->func, (void*)prm, thread,
+			       cpu, wall, perf, relay->userarg);
+  return relay->status;
+}
+
+/* Set up parsers that send every call to relay_call */
+static void populate_relay(libundumpi_cbpair *callarr) {
+  int i;
+  libundumpi_callbacks unused;
+  libundumpi_clear_callbacks(&unused);
+  libundumpi_populate_handlers(&unused, callarr);
+  for(i = 0; i < DUMPI_END_OF_STREAM; ++i)
+    callarr[i].callout = relay_call;
+}
+
+/*
+ * One rank in dumpistate_parse_all.  Up to DUMPISTATE_READAHEAD calls are
+ * read ahead with undumpi_next_batch (which only keeps times and offsets);
+ * calls are decoded in full when their turn comes.
+ */
+typedef struct dumpistate_stream {
+  int rank;
+  dumpi_profile *profile;
+  undumpi_batch *batch;
+  /** Next call in the batch to hand out. */
+  int next;
+  /** The call the file is positioned at. */
+  int at;
+  /** Where the next batch starts (-1 before the first batch). */
+  int64_t resume;
+  /** Subtracted from wall times to line up the ranks. */
+  int64_t skew;
+} dumpistate_stream;
+
+/* Make sure a stream has a call to hand out.  Returns 0 at the end. */
+static int stream_fill(dumpistate_stream *stream) {
+  if(stream->next < stream->batch->count) return 1;
+  if(stream->resume >= 0)
+    assert(DUMPI_SEEK(stream->profile, stream->resume, SEEK_SET) == 0);
+  stream->next = 0;
+  if(undumpi_next_batch(stream->profile, stream->batch, 0) == 0)
+    return 0;
+  stream->resume = DUMPI_READ_TELL(stream->profile);
+  stream->at = stream->batch->count;
+  return 1;
+}
+
+/* Time of the next call on a stream, corrected for clock skew */
+static inline int64_t stream_time(const dumpistate_stream *stream) {
+  return stream->batch->wall_start[stream->next] - stream->skew;
+}
+
+/* Decode the next call on a stream and pass it on */
+static int stream_emit(dumpistate_stream *stream, libundumpi_cbpair *callarr,
+		       dumpistate_relay *relay)
+{
+  const undumpi_batch *batch = stream->batch;
+  int index = stream->next++;
+  dumpi_function func;
+  if(stream->at != index)
+    assert(DUMPI_SEEK(stream->profile, batch->offset[index], SEEK_SET) == 0);
+  func = dumpi_read_next_function(stream->profile);
+  assert(func == batch->function[index]);
+  relay->rank = stream->rank;
+  relay->func = func;
+  relay->status = 1;
+  callarr[func].handler(stream->profile, callarr[func].callout, relay);
+  stream->at = index + 1;
+  return relay->status;
+}
+
+/* Heap order:  earliest next call first, lowest rank on ties */
+static inline int stream_before(const dumpistate_stream *a,
+				const dumpistate_stream *b)
+{
+  int64_t ta = stream_time(a), tb = stream_time(b);
+  return (ta < tb || (ta == tb && a->rank < b->rank));
+}
+
+static void heap_down(dumpistate_stream **heap, int size, int pos) {
+  dumpistate_stream *moving = heap[pos];
+  int child;
+  while((child = 2*pos + 1) < size) {
+    if(child + 1 < size && stream_before(heap[child+1], heap[child]))
+      ++child;
+    if(! stream_before(heap[child], moving)) break;
+    heap[pos] = heap[child];
+    pos = child;
+  }
+  heap[pos] = moving;
 }
 
 /*
  * Parse all streams simultaneously and return a collection of callbacks 
  * in a roughly time-sequential manner.
+ *
+ * The streams are merged with a min-heap keyed on the (skew-corrected)
+ * entry time of the next call of each rank.  With a sync interval,
+ * time is cut into windows of that length and every rank taken off the
+ * heap hands out all its calls up to the end of the current window.
  */
 int dumpistate_parse_all(const dumpistate *state,
 			 dumpistate_callback_fun_t callb,
 			 const dumpi_clock *sync_interval,
 			 void *userarg)
 {
-  fprintf(stderr, "Unimplemented:  dumpistate_parse_all\n");
-  return 0;
+  libundumpi_cbpair callarr[DUMPI_END_OF_STREAM] = {{NULL, NULL}};
+  dumpistate_relay relay;
+  dumpistate_stream *streams, **heap;
+  int64_t window = (sync_interval ? to_nsec(sync_interval) : 0);
+  int procs, rank, size = 0, status = 1, skewed = 1;
+  if(state == NULL || callb == NULL) {
+    fprintf(stderr, __FILE__ ":%d:  dumpistate_parse_all:  NULL argument\n",
+	    __LINE__);
+    abort();
+  }
+  procs = state->meta.procs;
+  populate_relay(callarr);
+  relay.callb = callb;
+  relay.userarg = userarg;
+  assert((streams = (dumpistate_stream*)calloc(procs,
+					       sizeof(dumpistate_stream)))
+	 != NULL);
+  assert((heap = (dumpistate_stream**)malloc(procs *
+					     sizeof(dumpistate_stream*)))
+	 != NULL);
+  /* Only line up clocks if every rank has an MPI_Init* in its trace */
+  for(rank = 0; rank < procs; ++rank)
+    if(to_nsec(&state->state[rank].init_done) == 0) skewed = 0;
+  for(rank = 0; rank < procs && status; ++rank) {
+    dumpistate_stream *stream = &streams[rank];
+    stream->rank = rank;
+    stream->resume = -1;
+    stream->skew = (skewed ? to_nsec(&state->state[rank].init_done) : 0);
+    if((stream->profile = dumpistate_open_stream(state, rank)) == NULL) {
+      fprintf(stderr, "dumpistate_parse_all:  Failed to open the trace "
+	      "file of rank %d\n", rank);
+      status = 0;
+      break;
+    }
+    stream->batch = undumpi_batch_alloc(DUMPISTATE_READAHEAD);
+    if(stream_fill(stream))
+      heap[size++] = stream;
+  }
+  for(rank = size/2 - 1; rank >= 0; --rank)
+    heap_down(heap, size, rank);
+  while(size > 0 && status) {
+    dumpistate_stream *stream = heap[0];
+    int more;
+    if(window > 0) {
+      int64_t start = stream_time(stream), end;
+      /* Round down (times before MPI_Init returned are negative) */
+      end = (start / window - (start % window < 0)) * window + window;
+      do {
+	status = stream_emit(stream, callarr, &relay);
+      } while((more = stream_fill(stream)) && status &&
+	      stream_time(stream) < end);
+    }
+    else {
+      status = stream_emit(stream, callarr, &relay);
+      more = stream_fill(stream);
+    }
+    if(! more)
+      heap[0] = heap[--size];
+    if(size > 0)
+      heap_down(heap, size, 0);
+  }
+  for(rank = 0; rank < procs; ++rank) {
+    if(streams[rank].profile != NULL) {
+      undumpi_close(streams[rank].profile);
+      free(streams[rank].profile);
+    }
+    undumpi_batch_free(streams[rank].batch);
+  }
+  free(heap);
+  free(streams);
+  return status;
 }
 
 /*
@@ -109,8 +296,44 @@ int dumpistate_parse_single(const dumpistate *state,
 			    dumpistate_callback_fun_t callb,
 			    void *userarg)
 {
-  fprintf(stderr, "Unimplemented:  dumpistate_parse_single\n");
-  return 0;
+  libundumpi_cbpair callarr[DUMPI_END_OF_STREAM] = {{NULL, NULL}};
+  dumpistate_relay relay;
+  dumpi_profile *profile;
+  dumpi_function func;
+  int finalized = 0;
+  if(state == NULL || callb == NULL || mpi_index < 0 ||
+     mpi_index >= state->meta.procs) {
+    fprintf(stderr, __FILE__ ":%d:  dumpistate_parse_single:  Invalid "
+	    "argument\n", __LINE__);
+    abort();
+  }
+  if((profile = dumpistate_open_stream(state, mpi_index)) == NULL) {
+    fprintf(stderr, "dumpistate_parse_single:  Failed to open the trace "
+	    "file of rank %d\n", mpi_index);
+    return 0;
+  }
+  populate_relay(callarr);
+  relay.rank = mpi_index;
+  relay.callb = callb;
+  relay.userarg = userarg;
+  relay.status = 1;
+  if(dumpi_start_stream_read(profile)) {
+    while(relay.status &&
+	  (func = dumpi_read_next_function(profile)) < DUMPI_END_OF_STREAM) {
+      if(finalized && func == 0)
+	break; /* old-style end of stream */
+      if(func == DUMPI_Finalize)
+	finalized = 1;
+      relay.func = func;
+      callarr[func].handler(profile, callarr[func].callout, &relay);
+      profile->pos = DUMPI_READ_TELL(profile);
+      if(profile->pos >= dumpi_stream_end(profile))
+	break;
+    }
+  }
+  undumpi_close(profile);
+  free(profile);
+  return relay.status;
 }
 
 /*
@@ -136,13 +359,128 @@ int dumpistate_world_size(const dumpistate *state)
 	    "NULL state pointer.\n", __LINE__);				\
     abort();								\
   }									\
-  if(global_mpi_rank < 0 || global_mpi_rank >= state->meta.procs) {	\
+  if((RANK) < 0 || (RANK) >= (STATE)->meta.procs) {			\
     fprintf(stderr, __FILE__ ":%d: " FUNCTION ": "			\
-	    "Invalid MPI rank %d\n", __LINE__, global_mpi_rank);	\
+	    "Invalid MPI rank %d\n", __LINE__, (RANK));		\
+    abort();								\
   }									\
-  assert(state->state != NULL);						\
+  assert((STATE)->state != NULL);					\
 } while(0)
 
+/*
+ * Get the first timestamp during which this dumpistate was valid.
+ */
+const dumpi_clock* dumpistate_mpi_started(const dumpistate *state,
+					  int global_rank)
+{
+  DUMPI_VALIDATE_LOCAL_STATE(state, global_rank, "dumpistate_mpi_started");
+  return &state->state[global_rank].mpi_bounds.start;
+}
+
+/*
+ * Get the last time at which this dumpistate was valid.
+ */
+const dumpi_clock* dumpistate_mpi_stopped(const dumpistate *state,
+					  int global_rank)
+{
+  DUMPI_VALIDATE_LOCAL_STATE(state, global_rank, "dumpistate_mpi_stopped");
+  return &state->state[global_rank].mpi_bounds.stop;
+}
+
+/*
+ * Get COMM_WORLD for the given global rank.
+ */
+const dumpistate_comm* dumpistate_comm_world(const dumpistate *state,
+					     int globalrank)
+{
+  DUMPI_VALIDATE_LOCAL_STATE(state, globalrank, "dumpistate_comm_world");
+  assert(state->state[globalrank].comms.length > DUMPI_COMM_WORLD);
+  return &state->state[globalrank].comms.entry[DUMPI_COMM_WORLD]->comm;
+}
+
+/*
+ * Accessors for communicators.
+ */
+const dumpi_clock* dumpistate_comm_created(const dumpistate_comm *ds) {
+  assert(ds != NULL);
+  return &ds->committed;
+}
+
+const dumpi_clock* dumpistate_comm_destroyed(const dumpistate_comm *ds) {
+  assert(ds != NULL);
+  return &ds->freed;
+}
+
+dumpi_function dumpistate_comm_creator(const dumpistate_comm *ds) {
+  assert(ds != NULL);
+  return ds->creator;
+}
+
+int dumpistate_comm_size(const dumpistate_comm *ds) {
+  assert(ds != NULL);
+  return ds->group.size;
+}
+
+int dumpistate_comm_rank(const dumpistate_comm *ds) {
+  assert(ds != NULL);
+  return ds->group.rank;
+}
+
+int dumpistate_comm_local_rank(const dumpistate_comm *ds, int global_rank) {
+  assert(ds != NULL);
+  return dumpistate_group_local_rank(&ds->group, global_rank);
+}
+
+int dumpistate_comm_global_rank(const dumpistate_comm *ds, int local_rank) {
+  assert(ds != NULL);
+  return dumpistate_group_global_rank(&ds->group, local_rank);
+}
+
+dumpistate_group* dumpistate_comm_group(const dumpistate_comm *comm) {
+  assert(comm != NULL);
+  return (dumpistate_group*)&comm->group;
+}
+
+/*
+ * Accessors for groups.
+ */
+const dumpi_clock* dumpistate_group_created(const dumpistate_group *ds) {
+  assert(ds != NULL);
+  return &ds->created;
+}
+
+const dumpi_clock* dumpistate_group_destroyed(const dumpistate_group *ds) {
+  assert(ds != NULL);
+  return &ds->destroyed;
+}
+
+int dumpistate_group_size(const dumpistate_group *ds) {
+  assert(ds != NULL);
+  return ds->size;
+}
+
+int dumpistate_group_rank(const dumpistate_group *ds) {
+  assert(ds != NULL);
+  return ds->rank;
+}
+
+int dumpistate_group_local_rank(const dumpistate_group *ds, int global_rank) {
+  int i;
+  assert(ds != NULL);
+  if(ds->global == NULL)
+    return (global_rank >= 0 && global_rank < ds->size ? global_rank : -1);
+  for(i = 0; i < ds->size; ++i)
+    if(ds->global[i] == global_rank) return i;
+  return -1;
+}
+
+int dumpistate_group_global_rank(const dumpistate_group *ds, int local_rank) {
+  assert(ds != NULL);
+  if(local_rank < 0 || local_rank >= ds->size)
+    return -1;
+  return (ds->global ? ds->global[local_rank] : local_rank);
+}
+
 /*
  * Get the earliest timestamp encountered in the trace for the given
  * node index.
@@ -239,7 +577,7 @@ int dumpistate_get_type_size(const dumpistate *state,
 			     const dumpi_clock *at_time)
 {
   const dumpistate_type *retval = NULL;
-  (state, global_mpi_rank, "dumpistate_get_type_size");
+  DUMPI_VALIDATE_LOCAL_STATE(state, global_mpi_rank, "dumpistate_get_type_size");
   /* We could technically return NULL here, but this is almost
    * certainly a programming error or corrupt input */
   if(type < 0 || type >= state->state[global_mpi_rank].types.length) {
@@ -274,7 +612,8 @@ const char* dumpistate_get_function_name(const dumpistate *state,
 {
   int i;
   const char *retval = NULL;
-  DUMPI_VALIDATE_LOCAL_STATE(state, global_mpi_rank, "dumpistate_get_type_size");
+  DUMPI_VALIDATE_LOCAL_STATE(state, global_mpi_rank,
+			     "dumpistate_get_function_name");
   for(i = 0; i < state->state[global_mpi_rank].functions.length; ++i) {
     if(state->state[global_mpi_rank].functions.func[i].address == address) {
       retval = state->state[global_mpi_rank].functions.func[i].name;
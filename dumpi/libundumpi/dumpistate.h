@@ -46,10 +46,14 @@ Questions? Contact sst-macro-help@sandia.gov
 #define DUMPI_LIBUNDUMPI_DUMPISTATE_H
 
 #include <dumpi/common/types.h>
-#include <dumpi/common/funclab>ls.h>
+#include <dumpi/common/funclabels.h>
 #include <dumpi/common/constants.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
 /**
  * \defgroup dumpistate dumpistate: Trace state information and parsing
  */
@@ -117,7 +121,7 @@ const dumpi_clock* dumpistate_mpi_started(const dumpistate *ds, int global_rank)
 
 /**
  * Get the last time at which this dumpistate was valid.
- * This is the time at which the node in question returned from MPI_Init.
+ * This is the time at which the node in question returned from MPI_Finalize.
  */
 const dumpi_clock* dumpistate_mpi_stopped(const dumpistate *ds, int global_rank);
 
@@ -156,6 +160,9 @@ dumpi_function dumpistate_comm_creator(const dumpistate_comm *ds);
 
 /**
  * Query the size of a dumpistate communicator.
+ * Returns -1 if the membership could not be worked out from the traces
+ * (communicators are followed through MPI_Comm_dup, MPI_Comm_split,
+ * MPI_Comm_create, MPI_Cart_create and MPI_Graph_create).
  */
 int dumpistate_comm_size(const dumpistate_comm *ds);
 
@@ -260,6 +267,11 @@ typedef int (*dumpistate_callback_fun_t)(int node_index,
  * with the given interval.  Setting this parameter to zero will result in
  * parsing the streams in strictly time-ordered manner, but at the cost of
  * a significant performance hit.
+ *
+ * The streams are read concurrently (all trace files are open at once),
+ * but only DUMPISTATE_READAHEAD calls per rank are buffered at any time.
+ * The times passed to the callback are the ones recorded in the trace
+ * (the skew correction is only used for ordering).
  * 
  * \param state         a valid dumpistate created using dumpistate_create.
  * \param callb         a function called for each function encountered.
@@ -382,4 +394,8 @@ const char* dumpistate_get_function_name(const dumpistate *state,
 
 /*@}*/ /* close doxygen group 'dumpistate' */
 
+#ifdef __cplusplus
+} /* End of extern "C" block */
+#endif /* ! __cplusplus */
+
 #endif /* DUMPI_LIBUNDUMPI_DUMPISTATE_H */
@@ -0,0 +1,197 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <dumpi/libundumpi/filter.h>
+#include <dumpi/libundumpi/records.h>
+#include <dumpi/common/iodefs.h>
+#include <string.h>
+#include <assert.h>
+
+void undumpi_filter_init(undumpi_filter *filter) {
+  assert(filter != NULL);
+  memset(filter, 0, sizeof(undumpi_filter));
+  undumpi_filter_all_functions(filter, 1);
+  filter->thread = -1;
+  filter->peer = filter->tag = filter->comm = UNDUMPI_FILTER_ANY;
+}
+
+void undumpi_filter_all_functions(undumpi_filter *filter, int keep) {
+  memset(filter->function, (keep ? 1 : 0), sizeof(filter->function));
+}
+
+void undumpi_set_filter(dumpi_profile *profile, const undumpi_filter *filter)
+{
+  assert(profile != NULL);
+  profile->filter = filter;
+}
+
+/* True for the calls undumpi_filter_args knows the peer, tag and comm of */
+static int is_p2p(dumpi_function function) {
+  switch(function) {
+  case DUMPI_Send: case DUMPI_Bsend: case DUMPI_Ssend: case DUMPI_Rsend:
+  case DUMPI_Isend: case DUMPI_Ibsend: case DUMPI_Issend: case DUMPI_Irsend:
+  case DUMPI_Send_init: case DUMPI_Bsend_init: case DUMPI_Ssend_init:
+  case DUMPI_Rsend_init: case DUMPI_Recv: case DUMPI_Irecv:
+  case DUMPI_Recv_init: case DUMPI_Probe: case DUMPI_Iprobe:
+  case DUMPI_Sendrecv: case DUMPI_Sendrecv_replace:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+/* dumpi_clock comparison (a < b) */
+static inline int clock_before(const dumpi_clock *a, const dumpi_clock *b) {
+  return (a->sec < b->sec || (a->sec == b->sec && a->nsec < b->nsec));
+}
+
+int undumpi_filter_record(dumpi_profile *profile, dumpi_function function,
+                          dumpi_record_prefix *prefix)
+{
+  const undumpi_filter *filter = profile->filter;
+  int window;
+  if(filter == NULL)
+    return 1;
+  if(! filter->function[function] ||
+     (undumpi_filter_has_args(filter) && ! is_p2p(function)))
+  {
+    undumpi_skip_record(profile, function, NULL);
+    return 0;
+  }
+  window = clock_before(&filter->wall_begin, &filter->wall_end);
+  if(filter->thread < 0 && ! window)
+    return 1;
+  get_record_prefix(profile, prefix);
+  if((filter->thread >= 0 && prefix->thread != filter->thread) ||
+     (window && (clock_before(&prefix->wall.start, &filter->wall_begin) ||
+                 ! clock_before(&prefix->wall.start, &filter->wall_end))))
+  {
+    undumpi_skip_record(profile, function, prefix);
+    return 0;
+  }
+  profile->prefix = prefix;
+  return 1;
+}
+
+/* Peer, tag and comm match, with UNDUMPI_FILTER_ANY as wildcard */
+static inline int matches(const undumpi_filter *filter,
+                          int peer, int tag, int comm)
+{
+  return ((filter->peer == UNDUMPI_FILTER_ANY || filter->peer == peer) &&
+          (filter->tag == UNDUMPI_FILTER_ANY || filter->tag == tag) &&
+          (filter->comm == UNDUMPI_FILTER_ANY || filter->comm == comm));
+}
+
+#define UNDUMPI_FILTER_P2P(FUNC, TYPE, PEER)                            \
+  case FUNC: {                                                          \
+    const TYPE *prm = (const TYPE*)val;                                 \
+    return matches(filter, prm->PEER, prm->tag, prm->comm);             \
+  }
+
+int undumpi_filter_args(const undumpi_filter *filter,
+                        dumpi_function function, const void *val)
+{
+  if(filter == NULL || ! undumpi_filter_has_args(filter))
+    return 1;
+  switch(function) {
+    UNDUMPI_FILTER_P2P(DUMPI_Send, dumpi_send, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Bsend, dumpi_bsend, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Ssend, dumpi_ssend, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Rsend, dumpi_rsend, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Isend, dumpi_isend, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Ibsend, dumpi_ibsend, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Issend, dumpi_issend, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Irsend, dumpi_irsend, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Send_init, dumpi_send_init, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Bsend_init, dumpi_bsend_init, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Ssend_init, dumpi_ssend_init, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Rsend_init, dumpi_rsend_init, dest)
+    UNDUMPI_FILTER_P2P(DUMPI_Recv, dumpi_recv, source)
+    UNDUMPI_FILTER_P2P(DUMPI_Irecv, dumpi_irecv, source)
+    UNDUMPI_FILTER_P2P(DUMPI_Recv_init, dumpi_recv_init, source)
+    UNDUMPI_FILTER_P2P(DUMPI_Probe, dumpi_probe, source)
+    UNDUMPI_FILTER_P2P(DUMPI_Iprobe, dumpi_iprobe, source)
+  case DUMPI_Sendrecv: {
+    const dumpi_sendrecv *prm = (const dumpi_sendrecv*)val;
+    return (matches(filter, prm->dest, prm->sendtag, prm->comm) ||
+            matches(filter, prm->source, prm->recvtag, prm->comm));
+  }
+  case DUMPI_Sendrecv_replace: {
+    const dumpi_sendrecv_replace *prm = (const dumpi_sendrecv_replace*)val;
+    return (matches(filter, prm->dest, prm->sendtag, prm->comm) ||
+            matches(filter, prm->source, prm->recvtag, prm->comm));
+  }
+  default:
+    return 0;
+  }
+}
+
+#undef UNDUMPI_FILTER_P2P
+
+void undumpi_skip_record(dumpi_profile *profile, dumpi_function function,
+                         dumpi_record_prefix *prefix)
+{
+  uint16_t thread = 0;
+  dumpi_time cpu, wall;
+  dumpi_perfdata perf;
+  perf.count = 0;
+  profile->prefix = prefix;
+  profile->skipping = 1;
+  switch(function) {
+#define UNDUMPI_SKIP_CASE(ENUM, NAME, TYPE, READ)                       \
+  case ENUM: {                                                          \
+    TYPE val;                                                           \
+    memset(&val, 0, sizeof(TYPE));                                      \
+    READ(&val, &thread, &cpu, &wall, &perf, profile);                   \
+    break;                                                              \
+  }
+    LIBUNDUMPI_FOREACH_RECORD(UNDUMPI_SKIP_CASE)
+#undef UNDUMPI_SKIP_CASE
+  default:
+    /* DUMPI_ALL_FUNCTIONS carries no payload */
+    break;
+  }
+  profile->skipping = 0;
+  profile->prefix = NULL;
+}
@@ -0,0 +1,152 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_LIBUNDUMPI_FILTER_H
+#define DUMPI_LIBUNDUMPI_FILTER_H
+
+#include <dumpi/common/types.h>
+#include <dumpi/common/funcs.h>
+#include <stdint.h>
+#include <limits.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \ingroup libundumpi
+   * \defgroup libundumpi_filter libundumpi/filter:  \
+   *    Dropping unwanted records while the stream is read.
+   *
+   * A filter attached to a profile with undumpi_set_filter is applied by
+   * undumpi_read_stream (and friends) and by dumpi::read_stream.
+   * The function label and the fixed record prefix (thread and times)
+   * are tested first.  Records that fail are stepped over without
+   * allocating their array arguments and without calling the callback.
+   * Since records carry no length, the rest of such a record still has
+   * to be parsed, but only to find where it ends.
+   */
+  /*@{*/ /* put subsequent doxygen comments in group libundumpi_filter */
+
+  /** Matches any value in the peer, tag and comm fields of a filter. */
+#define UNDUMPI_FILTER_ANY INT_MIN
+
+  /**
+   * Which records to keep.  Initialize with undumpi_filter_init, which
+   * keeps everything, then narrow it down.
+   */
+  typedef struct undumpi_filter {
+    /** Non-zero for each dumpi_function whose records are kept. */
+    uint8_t     function[DUMPI_END_OF_STREAM];
+    /** Keep records whose wall start time is in [wall_begin, wall_end).
+     *  Ignored unless wall_end is after wall_begin. */
+    dumpi_clock wall_begin, wall_end;
+    /** Keep records from this thread only (-1 for all threads). */
+    int         thread;
+    /** Keep point-to-point calls (sends, receives, probes and sendrecvs)
+     *  with this peer rank, tag and communicator.  Setting any of them to
+     *  something other than UNDUMPI_FILTER_ANY drops all other calls. */
+    int         peer, tag, comm;
+  } undumpi_filter;
+
+  /** Set up a filter that keeps every record. */
+  void undumpi_filter_init(undumpi_filter *filter);
+
+  /** Keep (keep != 0) or drop the records of every MPI function. */
+  void undumpi_filter_all_functions(undumpi_filter *filter, int keep);
+
+  /**
+   * Use the given filter when reading from profile (NULL to keep all
+   * records).  The filter is not copied and has to stay around while
+   * the profile is read.
+   */
+  void undumpi_set_filter(dumpi_profile *profile,
+                          const undumpi_filter *filter);
+
+  /** Non-zero if the filter constrains the peer, tag or communicator. */
+  static inline int undumpi_filter_has_args(const undumpi_filter *filter) {
+    return (filter->peer != UNDUMPI_FILTER_ANY ||
+            filter->tag != UNDUMPI_FILTER_ANY ||
+            filter->comm != UNDUMPI_FILTER_ANY);
+  }
+
+  /**
+   * Test the record that follows the function label just read off the
+   * stream.  If it is rejected, it is skipped and 0 is returned.
+   * Otherwise the record prefix may have been read into the given space,
+   * and the following dumpi_read_* call for function picks it up.
+   * \param profile   a profile with a filter set.
+   * \param function  the function label of the record.
+   * \param prefix    space for the record prefix (used until the read).
+   * \return non-zero if the record should be read.
+   */
+  int undumpi_filter_record(dumpi_profile *profile, dumpi_function function,
+                            dumpi_record_prefix *prefix);
+
+  /**
+   * Test the arguments of a decoded record against the peer, tag and
+   * comm fields of the filter.
+   * \param filter    the filter (NULL keeps everything).
+   * \param function  the function label of the record.
+   * \param val       the decoded record (e.g. a dumpi_send).
+   * \return non-zero if the record is kept.
+   */
+  int undumpi_filter_args(const undumpi_filter *filter,
+                          dumpi_function function, const void *val);
+
+  /**
+   * Step over the record for function (following its label) without
+   * allocating anything.  If prefix is not NULL, the record prefix has
+   * already been read into it.
+   */
+  void undumpi_skip_record(dumpi_profile *profile, dumpi_function function,
+                           dumpi_record_prefix *prefix);
+
+  /*@}*/ /* close doxygen comment group */
+
+#ifdef __cplusplus
+} /* End of extern "C" block */
+#endif /* ! __cplusplus */
+
+#endif /* DUMPI_LIBUNDUMPI_FILTER_H */
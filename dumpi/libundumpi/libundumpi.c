@@ -44,10 +44,12 @@ Questions? Contact sst-macro-help@sandia.gov
 
 #include <dumpi/libundumpi/libundumpi.h>
 #include <dumpi/libundumpi/bindings.h>
+#include <dumpi/libundumpi/filter.h>
 #include <dumpi/common/funcs.h>
 #include <dumpi/common/iodefs.h>
 #include <assert.h>
 #include <sys/time.h>
+#include <time.h>
 
 /*
 typedef int (*unsafe_fun)(void *parsearg, void *userarg);
@@ -72,6 +74,7 @@ dumpi_profile* undumpi_open(const char* fname) {
 void undumpi_close(dumpi_profile *profile) {
   assert(profile != NULL && profile->file != NULL);
   fclose(profile->file);
+  dumpi_free_perfctr_cache(profile);
 }
 
 /*
@@ -85,6 +88,24 @@ dumpi_header* undumpi_read_header(dumpi_profile* profile) {
   return retval;
 }
 
+/* A callback wrapped to test the peer, tag and comm of the record first */
+typedef struct filtered_callout {
+  const undumpi_filter  *filter;
+  dumpi_function         function;
+  libundumpi_unsafe_fun  callout;
+  void                  *uarg;
+} filtered_callout;
+
+static int call_if_matched(const void *parsearg, uint16_t thread,
+                           const dumpi_time *cpu, const dumpi_time *wall,
+                           const dumpi_perfinfo *perf, void *userarg)
+{
+  const filtered_callout *fc = (const filtered_callout*)userarg;
+  if(! undumpi_filter_args(fc->filter, fc->function, parsearg))
+    return 1;
+  return fc->callout(parsearg, thread, cpu, wall, perf, fc->uarg);
+}
+
 /* Read a single MPI call off a stream starting at current position.
  * Returns 1 if the stream is still active, 0 if it is terminated.
  * Note that you need to call dumpi_start_stream_read before calling
@@ -96,7 +117,11 @@ int undumpi_read_single_call(dumpi_profile *profile,
 {
   dumpi_function currfunc;
   int retval = 0;
-  off_t end_stream = profile->footer;
+  off_t end_stream = dumpi_stream_end(profile);
+  if(profile->chkpt > 0 && profile->pos >= (uint64_t)end_stream) {
+    /* Nothing (more) has been recovered from an incomplete trace */
+    return 0;
+  }
   if((currfunc = dumpi_read_next_function(profile)) < DUMPI_END_OF_STREAM) {
     retval = 1;
     /*
@@ -113,7 +138,21 @@ int undumpi_read_single_call(dumpi_profile *profile,
       /* Backward compatibility issue -- we used to terminate the stream here */
       *mpi_finalized = 1;
     }
-    assert(callarr[currfunc].handler(profile, callarr[currfunc].callout, uarg));
+    if(profile->filter == NULL) {
+      assert(callarr[currfunc].handler(profile, callarr[currfunc].callout,
+                                       uarg));
+    }
+    else {
+      dumpi_record_prefix prefix;
+      if(undumpi_filter_record(profile, currfunc, &prefix)) {
+        libundumpi_unsafe_fun callout = callarr[currfunc].callout;
+        filtered_callout fc = { profile->filter, currfunc, callout, uarg };
+        if(callout != NULL && undumpi_filter_has_args(profile->filter))
+          assert(callarr[currfunc].handler(profile, call_if_matched, &fc));
+        else
+          assert(callarr[currfunc].handler(profile, callout, uarg));
+      }
+    }
     /*
     printf("After reading function %d (%s), filepos is at %ld (end at %ld)\n",
 	   (int)currfunc, dumpi_function_label(currfunc),
@@ -172,6 +211,44 @@ int undumpi_read_stream_full(
   return 1;
 }
 
+int undumpi_follow_stream(dumpi_profile* profile,
+                          const libundumpi_callbacks *callback,
+                          void *uarg, int timeout,
+                          undumpi_idle_callback idle)
+{
+  int mpi_finalized = 0, active = 1, waited_ms = 0;
+  libundumpi_cbpair callarr[DUMPI_END_OF_STREAM] = {{NULL, NULL}};
+  struct timespec poll = { UNDUMPI_FOLLOW_POLL_MS / 1000,
+                           (UNDUMPI_FOLLOW_POLL_MS % 1000) * 1000000L };
+  assert(profile != NULL && profile->file != NULL && callback != NULL);
+
+  libundumpi_populate_handlers(callback, callarr);
+  libundumpi_populate_callouts(callback, callarr);
+
+  assert(dumpi_start_stream_read(profile) != 0);
+  for(;;) {
+    while(active && profile->pos < dumpi_stream_end(profile))
+      active = undumpi_read_single_call(profile, callarr, uarg,
+                                        &mpi_finalized);
+    if(profile->chkpt == 0) {
+      /* The trace is complete */
+      return 1;
+    }
+    active = 1;
+    if(idle)
+      idle(uarg);
+    nanosleep(&poll, NULL);
+    if(dumpi_refresh_input_file(profile)) {
+      waited_ms = 0;
+    }
+    else {
+      waited_ms += UNDUMPI_FOLLOW_POLL_MS;
+      if(timeout > 0 && waited_ms >= timeout * 1000)
+        return 0;
+    }
+  }
+}
+
 dumpi_keyval_record* undumpi_read_keyval_record(dumpi_profile* profile) {
   dumpi_keyval_record* retval = (dumpi_keyval_record*)calloc(1, sizeof(dumpi_keyval_record));
   assert(retval != NULL);
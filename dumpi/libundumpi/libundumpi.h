@@ -127,6 +127,33 @@ extern "C" {
                           const libundumpi_callbacks *callback,
                           void *userarg, bool print_progress);
 
+  /**
+   * Called by undumpi_follow_stream each time it waits for more of
+   * the trace (e.g. to flush output).
+   */
+  typedef void (*undumpi_idle_callback)(void *userarg);
+
+  /**
+   * Parse the stream of MPI commands of a trace that may still be
+   * written ("tail -f").  After the readable part of the stream is
+   * parsed, the file is checked for new checkpoints every
+   * UNDUMPI_FOLLOW_POLL_MS until the trace is complete.
+   * \param profile  the file that gets read.
+   * \param callback the functions that get called for each MPI function
+   * \param userarg  this argument gets sent back with each callback.
+   * \param timeout  give up after this many seconds without new data
+   *                 (0 waits forever).
+   * \param idle     if not NULL, called before each wait.
+   * \return 1 if the complete trace was read, 0 on timeout.
+   */
+  int undumpi_follow_stream(dumpi_profile* profile,
+                            const libundumpi_callbacks *callback,
+                            void *userarg, int timeout,
+                            undumpi_idle_callback idle);
+
+  /** How often undumpi_follow_stream looks for more of the trace */
+#define UNDUMPI_FOLLOW_POLL_MS 500
+
   /**
    * Parse the keyval (user-populated) record from this file.
    * It is the caller's responsibility to free the returned object
@@ -0,0 +1,252 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_LIBUNDUMPI_READER_H
+#define DUMPI_LIBUNDUMPI_READER_H
+
+#ifndef __cplusplus
+#error "dumpi/libundumpi/reader.h is a C++ header"
+#endif
+
+#include <dumpi/libundumpi/libundumpi.h>
+#include <dumpi/libundumpi/bindings.h>
+#include <dumpi/libundumpi/records.h>
+#include <dumpi/libundumpi/filter.h>
+#include <dumpi/common/iodefs.h>
+#include <dumpi/common/io.h>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace dumpi {
+
+  /**
+   * \ingroup libundumpi
+   * \defgroup libundumpi_reader libundumpi/reader:  \
+   *    Statically dispatched C++ access to the MPI call stream.
+   *
+   * An alternative to undumpi_read_stream for C++ tools.  Instead of a
+   * libundumpi_callbacks table, the caller passes a visitor object with
+   * overloads of the form
+   *
+   *   void on(const dumpi_send &prm, const dumpi::event &ev);
+   *
+   * Each record is decoded straight into a local struct and handed to the
+   * matching overload with an ordinary (inlinable) call.  Record types with
+   * no matching overload are still decoded -- the stream has no record
+   * lengths, so there is nothing to seek past -- but the call and the
+   * perfcounter conversion are compiled out.  A template overload
+   * can be used as a catch-all for every record type.
+   *
+   * A filter set on the profile with undumpi_set_filter is honored:
+   * rejected records are skipped and never reach the visitor.
+   */
+  /*@{*/ /* put subsequent doxygen comments in group libundumpi_reader */
+
+  /**
+   * Everything about a record other than its MPI arguments.
+   * Only valid for the duration of the visitor call.
+   */
+  struct event {
+    /// Which record this is (the dumpi_func_call records use this to
+    /// distinguish function entry from function exit).
+    dumpi_function function;
+    uint16_t thread;
+    dumpi_time cpu, wall;
+    dumpi_perfdata perf;
+    dumpi_profile *profile;
+
+    /// Perfcounter values in the form passed to the C callbacks.
+    const dumpi_perfinfo* perfinfo() const {
+      return libundumpi_perfinfo_compat(profile, &perf);
+    }
+  };
+
+  namespace reader_detail {
+
+    /// True if V has an on(const T&, const event&) member we can call.
+    template <typename V, typename T>
+    class handles {
+      template <typename U>
+      static char test(decltype(std::declval<U&>().on(std::declval<const T&>(),
+                                                       std::declval<const event&>()))*);
+      template <typename U>
+      static long test(...);
+    public:
+      static const bool value = (sizeof(test<V>(0)) == sizeof(char));
+    };
+
+    template <bool handled>
+    struct invoke {
+      template <typename V, typename T>
+      static void call(V&, const T&, const event&) {}
+    };
+
+    template <>
+    struct invoke<true> {
+      template <typename V, typename T>
+      static void call(V &visitor, const T &prm, const event &ev) {
+        visitor.on(prm, ev);
+      }
+    };
+
+    /// Decode one record of type T, visit it, and release it.
+    template <typename T, typename V>
+    inline void visit_record(int (*read)(T*, DUMPI_READARGS),
+                             void (*release)(T*),
+                             V &visitor, event &ev)
+    {
+      T val;
+      memset(&val, 0, sizeof(T));
+      ev.thread = 0;
+      memset(&ev.cpu, 0, sizeof(dumpi_time));
+      memset(&ev.wall, 0, sizeof(dumpi_time));
+      ev.perf.count = 0;
+      read(&val, &ev.thread, &ev.cpu, &ev.wall, &ev.perf, ev.profile);
+      if(ev.profile->filter == NULL ||
+         undumpi_filter_args(ev.profile->filter, ev.function, &val))
+      {
+        invoke<handles<V, T>::value>::call(visitor, (const T&)val,
+                                           (const event&)ev);
+      }
+      release(&val);
+    }
+
+  } // end of namespace reader_detail
+
+  /**
+   * Read a single MPI call off a stream starting at current position.
+   * Same contract as undumpi_read_single_call.
+   * \param profile        the file that gets read.
+   * \param visitor        receives the record if it has a matching overload.
+   * \param mpi_finalized  state flag (should be 0 on the first call).
+   * \return               true if the stream is still active.
+   */
+  template <typename V>
+  bool read_single_call(dumpi_profile *profile, V &visitor,
+                        int *mpi_finalized)
+  {
+    event ev;
+    bool retval = false;
+    if(profile->chkpt > 0 && profile->pos >= dumpi_stream_end(profile))
+      return false;
+    dumpi_function currfunc = dumpi_read_next_function(profile);
+    if(currfunc < DUMPI_END_OF_STREAM) {
+      retval = true;
+      if(*mpi_finalized && (currfunc == 0)) {
+        /* Backward compatibility -- see undumpi_read_single_call */
+        retval = false;
+      }
+      if(currfunc == DUMPI_Finalize) {
+        *mpi_finalized = 1;
+      }
+      ev.function = currfunc;
+      ev.profile = profile;
+      dumpi_record_prefix prefix;
+      if(profile->filter != NULL &&
+         ! undumpi_filter_record(profile, currfunc, &prefix))
+      {
+        currfunc = DUMPI_END_OF_STREAM; /* already skipped */
+      }
+      switch(currfunc) {
+#define DUMPI_READER_CASE(ENUM, NAME, TYPE, READ)                      \
+        case ENUM:                                                    \
+          reader_detail::visit_record<TYPE>(READ,                     \
+                                            libundumpi_release_##NAME, \
+                                            visitor, ev);             \
+          break;
+        LIBUNDUMPI_FOREACH_RECORD(DUMPI_READER_CASE)
+#undef DUMPI_READER_CASE
+      default:
+        /* DUMPI_ALL_FUNCTIONS carries no payload, and filtered records
+           have been skipped */
+        break;
+      }
+      profile->pos = ftello(profile->file);
+      if(profile->pos >= dumpi_stream_end(profile)) {
+        retval = false;
+      }
+    }
+    return retval;
+  }
+
+  /**
+   * Parse the stream of MPI commands.
+   * Same contract as undumpi_read_stream_full.
+   * \param profile         the file that gets read.
+   * \param visitor         gets each record it has an overload for.
+   * \param print_progress  print a line for every percent read.
+   * \param metaname        label for the progress lines.
+   */
+  template <typename V>
+  void read_stream(dumpi_profile *profile, V &visitor,
+                   bool print_progress = false, const char *metaname = "")
+  {
+    int mpi_finalized = 0, last_percent_done = 0, started;
+    assert(profile != NULL && profile->file != NULL);
+    started = dumpi_start_stream_read(profile);
+    assert(started != 0);
+    (void)started;
+    while(read_single_call(profile, visitor, &mpi_finalized) &&
+          profile->pos < profile->terminate_pos)
+    {
+      if(print_progress) {
+        int int_percent_done = (int)(100. * ((double)profile->pos) /
+                                     ((double)profile->total_file_size));
+        if(int_percent_done > last_percent_done) {
+          printf("DUMPI trace %3d percent complete: %s\n",
+                 int_percent_done, metaname);
+          fflush(stdout);
+        }
+        last_percent_done = int_percent_done;
+      }
+    }
+  }
+
+  /*@}*/ /* close doxygen comment group */
+
+} // end of namespace dumpi
+
+#endif /* DUMPI_LIBUNDUMPI_READER_H */
@@ -0,0 +1,1272 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#ifndef DUMPI_LIBUNDUMPI_RECORDS_H
+#define DUMPI_LIBUNDUMPI_RECORDS_H
+
+#include <dumpi/common/argtypes.h>
+#include <dumpi/common/dumpiio.h>
+#include <dumpi/libundumpi/freedefs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libundumpi_internal
+   */
+  /*@{*/ /* plop all subsequent comments in the libundumpi_internal group */
+
+  /**
+   * Release the heap storage that dumpi_read_<name> attached to a record.
+   * One of these exists for every record type in the stream (including
+   * the ones that own no storage), so generic code can always call
+   * libundumpi_release_##NAME after reading.
+   */
+  static inline void libundumpi_release_send(dumpi_send *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_recv(dumpi_recv *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_get_count(dumpi_get_count *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_bsend(dumpi_bsend *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_ssend(dumpi_ssend *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_rsend(dumpi_rsend *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_buffer_attach(dumpi_buffer_attach *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_buffer_detach(dumpi_buffer_detach *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_isend(dumpi_isend *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_ibsend(dumpi_ibsend *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_issend(dumpi_issend *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_irsend(dumpi_irsend *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_irecv(dumpi_irecv *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_wait(dumpi_wait *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_test(dumpi_test *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_request_free(dumpi_request_free *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_waitany(dumpi_waitany *val) {
+    if(val->requests != NULL) DUMPI_FREE_REQUEST(val->requests);
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_testany(dumpi_testany *val) {
+    if(val->requests != NULL) DUMPI_FREE_REQUEST(val->requests);
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_waitall(dumpi_waitall *val) {
+    if(val->requests != NULL) DUMPI_FREE_REQUEST(val->requests);
+    if(val->statuses != NULL) DUMPI_FREE_STATUS(val->statuses);
+  }
+  static inline void libundumpi_release_testall(dumpi_testall *val) {
+    if(val->requests != NULL) DUMPI_FREE_REQUEST(val->requests);
+    if(val->statuses != NULL) DUMPI_FREE_STATUS(val->statuses);
+  }
+  static inline void libundumpi_release_waitsome(dumpi_waitsome *val) {
+    if(val->requests != NULL) DUMPI_FREE_REQUEST(val->requests);
+    if(val->indices != NULL) DUMPI_FREE_INT(val->indices);
+    if(val->statuses != NULL) DUMPI_FREE_STATUS(val->statuses);
+  }
+  static inline void libundumpi_release_testsome(dumpi_testsome *val) {
+    if(val->requests != NULL) DUMPI_FREE_REQUEST(val->requests);
+    if(val->indices != NULL) DUMPI_FREE_INT(val->indices);
+    if(val->statuses != NULL) DUMPI_FREE_STATUS(val->statuses);
+  }
+  static inline void libundumpi_release_iprobe(dumpi_iprobe *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_probe(dumpi_probe *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_cancel(dumpi_cancel *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_test_cancelled(dumpi_test_cancelled *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_send_init(dumpi_send_init *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_bsend_init(dumpi_bsend_init *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_ssend_init(dumpi_ssend_init *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_rsend_init(dumpi_rsend_init *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_recv_init(dumpi_recv_init *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_start(dumpi_start *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_startall(dumpi_startall *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_sendrecv(dumpi_sendrecv *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_sendrecv_replace(dumpi_sendrecv_replace *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_type_contiguous(dumpi_type_contiguous *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_vector(dumpi_type_vector *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_hvector(dumpi_type_hvector *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_indexed(dumpi_type_indexed *val) {
+    if(val->lengths != NULL) DUMPI_FREE_INT(val->lengths);
+    if(val->indices != NULL) DUMPI_FREE_INT(val->indices);
+  }
+  static inline void libundumpi_release_type_hindexed(dumpi_type_hindexed *val) {
+    if(val->lengths != NULL) DUMPI_FREE_INT(val->lengths);
+    if(val->indices != NULL) DUMPI_FREE_INT(val->indices);
+  }
+  static inline void libundumpi_release_type_struct(dumpi_type_struct *val) {
+    if(val->lengths != NULL) DUMPI_FREE_INT(val->lengths);
+    if(val->oldtypes != NULL) DUMPI_FREE_DATATYPE(val->oldtypes);
+  }
+  static inline void libundumpi_release_address(dumpi_address *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_extent(dumpi_type_extent *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_size(dumpi_type_size *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_lb(dumpi_type_lb *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_ub(dumpi_type_ub *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_commit(dumpi_type_commit *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_free(dumpi_type_free *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_get_elements(dumpi_get_elements *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_pack(dumpi_pack *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_unpack(dumpi_unpack *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_pack_size(dumpi_pack_size *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_barrier(dumpi_barrier *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_bcast(dumpi_bcast *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_gather(dumpi_gather *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_gatherv(dumpi_gatherv *val) {
+    if(val->recvcounts != NULL) DUMPI_FREE_INT(val->recvcounts);
+    if(val->displs != NULL) DUMPI_FREE_INT(val->displs);
+  }
+  static inline void libundumpi_release_scatter(dumpi_scatter *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_scatterv(dumpi_scatterv *val) {
+    if(val->sendcounts != NULL) DUMPI_FREE_INT(val->sendcounts);
+    if(val->displs != NULL) DUMPI_FREE_INT(val->displs);
+  }
+  static inline void libundumpi_release_allgather(dumpi_allgather *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_allgatherv(dumpi_allgatherv *val) {
+    if(val->recvcounts != NULL) DUMPI_FREE_INT(val->recvcounts);
+    if(val->displs != NULL) DUMPI_FREE_INT(val->displs);
+  }
+  static inline void libundumpi_release_alltoall(dumpi_alltoall *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_alltoallv(dumpi_alltoallv *val) {
+    if(val->sendcounts != NULL) DUMPI_FREE_INT(val->sendcounts);
+    if(val->senddispls != NULL) DUMPI_FREE_INT(val->senddispls);
+    if(val->recvcounts != NULL) DUMPI_FREE_INT(val->recvcounts);
+    if(val->recvdispls != NULL) DUMPI_FREE_INT(val->recvdispls);
+  }
+  static inline void libundumpi_release_reduce(dumpi_reduce *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_op_create(dumpi_op_create *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_op_free(dumpi_op_free *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_allreduce(dumpi_allreduce *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_reduce_scatter(dumpi_reduce_scatter *val) {
+    if(val->recvcounts != NULL) DUMPI_FREE_INT(val->recvcounts);
+  }
+  static inline void libundumpi_release_scan(dumpi_scan *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_group_size(dumpi_group_size *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_group_rank(dumpi_group_rank *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_group_translate_ranks(dumpi_group_translate_ranks *val) {
+    if(val->ranks1 != NULL) DUMPI_FREE_INT(val->ranks1);
+    if(val->ranks2 != NULL) DUMPI_FREE_INT(val->ranks2);
+  }
+  static inline void libundumpi_release_group_compare(dumpi_group_compare *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_group(dumpi_comm_group *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_group_union(dumpi_group_union *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_group_intersection(dumpi_group_intersection *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_group_difference(dumpi_group_difference *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_group_incl(dumpi_group_incl *val) {
+    if(val->ranks != NULL) DUMPI_FREE_INT(val->ranks);
+  }
+  static inline void libundumpi_release_group_excl(dumpi_group_excl *val) {
+    if(val->ranks != NULL) DUMPI_FREE_INT(val->ranks);
+  }
+  static inline void libundumpi_release_group_range_incl(dumpi_group_range_incl *val) {
+    if(val->ranges != NULL)
+      DUMPI_FREE_INT_ARRAY_2(val->count, val->ranges);
+  }
+  static inline void libundumpi_release_group_range_excl(dumpi_group_range_excl *val) {
+    if(val->ranges != NULL)
+      DUMPI_FREE_INT_ARRAY_2(val->count, val->ranges);
+  }
+  static inline void libundumpi_release_group_free(dumpi_group_free *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_size(dumpi_comm_size *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_rank(dumpi_comm_rank *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_compare(dumpi_comm_compare *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_dup(dumpi_comm_dup *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_create(dumpi_comm_create *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_split(dumpi_comm_split *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_free(dumpi_comm_free *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_test_inter(dumpi_comm_test_inter *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_remote_size(dumpi_comm_remote_size *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_remote_group(dumpi_comm_remote_group *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_intercomm_create(dumpi_intercomm_create *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_intercomm_merge(dumpi_intercomm_merge *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_keyval_create(dumpi_keyval_create *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_keyval_free(dumpi_keyval_free *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_attr_put(dumpi_attr_put *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_attr_get(dumpi_attr_get *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_attr_delete(dumpi_attr_delete *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_topo_test(dumpi_topo_test *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_cart_create(dumpi_cart_create *val) {
+    if(val->dims != NULL) DUMPI_FREE_INT(val->dims);
+    if(val->periods != NULL) DUMPI_FREE_INT(val->periods);
+  }
+  static inline void libundumpi_release_dims_create(dumpi_dims_create *val) {
+    if(val->dims.in != NULL) DUMPI_FREE_INT(val->dims.in);
+    if(val->dims.out != NULL) DUMPI_FREE_INT(val->dims.out);
+  }
+  static inline void libundumpi_release_graph_create(dumpi_graph_create *val) {
+    if(val->index != NULL) DUMPI_FREE_INT(val->index);
+    if(val->edges != NULL) DUMPI_FREE_INT(val->edges);
+  }
+  static inline void libundumpi_release_graphdims_get(dumpi_graphdims_get *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_graph_get(dumpi_graph_get *val) {
+    if(val->index != NULL) DUMPI_FREE_INT(val->index);
+    if(val->edges != NULL) DUMPI_FREE_INT(val->edges);
+  }
+  static inline void libundumpi_release_cartdim_get(dumpi_cartdim_get *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_cart_get(dumpi_cart_get *val) {
+    if(val->dims != NULL) DUMPI_FREE_INT(val->dims);
+    if(val->periods != NULL) DUMPI_FREE_INT(val->periods);
+  }
+  static inline void libundumpi_release_cart_rank(dumpi_cart_rank *val) {
+    if(val->coords != NULL) DUMPI_FREE_INT(val->coords);
+  }
+  static inline void libundumpi_release_cart_coords(dumpi_cart_coords *val) {
+    if(val->coords != NULL) DUMPI_FREE_INT(val->coords);
+  }
+  static inline void libundumpi_release_graph_neighbors_count(dumpi_graph_neighbors_count *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_graph_neighbors(dumpi_graph_neighbors *val) {
+    if(val->neighbors != NULL) DUMPI_FREE_INT(val->neighbors);
+  }
+  static inline void libundumpi_release_cart_shift(dumpi_cart_shift *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_cart_sub(dumpi_cart_sub *val) {
+    if(val->remain_dims != NULL) DUMPI_FREE_INT(val->remain_dims);
+  }
+  static inline void libundumpi_release_cart_map(dumpi_cart_map *val) {
+    if(val->dims != NULL) DUMPI_FREE_INT(val->dims);
+    if(val->period != NULL) DUMPI_FREE_INT(val->period);
+  }
+  static inline void libundumpi_release_graph_map(dumpi_graph_map *val) {
+    if(val->index != NULL) DUMPI_FREE_INT(val->index);
+    if(val->edges != NULL) DUMPI_FREE_INT(val->edges);
+  }
+  static inline void libundumpi_release_get_processor_name(dumpi_get_processor_name *val) {
+    if(val->name != NULL) DUMPI_FREE_CHAR(val->name);
+  }
+  static inline void libundumpi_release_get_version(dumpi_get_version *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_errhandler_create(dumpi_errhandler_create *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_errhandler_set(dumpi_errhandler_set *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_errhandler_get(dumpi_errhandler_get *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_errhandler_free(dumpi_errhandler_free *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_error_string(dumpi_error_string *val) {
+    if(val->errorstring != NULL) DUMPI_FREE_CHAR(val->errorstring);
+  }
+  static inline void libundumpi_release_error_class(dumpi_error_class *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_wtime(dumpi_wtime *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_wtick(dumpi_wtick *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_init(dumpi_init *val) {
+    if(val->argv != NULL)
+      DUMPI_FREE_CHAR_ARRAY_2(val->argc, val->argv);
+  }
+  static inline void libundumpi_release_finalize(dumpi_finalize *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_initialized(dumpi_initialized *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_abort(dumpi_abort *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_close_port(dumpi_close_port *val) {
+    if(val->portname != NULL) DUMPI_FREE_CHAR(val->portname);
+  }
+  static inline void libundumpi_release_comm_accept(dumpi_comm_accept *val) {
+    if(val->portname != NULL) DUMPI_FREE_CHAR(val->portname);
+  }
+  static inline void libundumpi_release_comm_connect(dumpi_comm_connect *val) {
+    if(val->portname != NULL) DUMPI_FREE_CHAR(val->portname);
+  }
+  static inline void libundumpi_release_comm_disconnect(dumpi_comm_disconnect *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_get_parent(dumpi_comm_get_parent *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_join(dumpi_comm_join *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_spawn(dumpi_comm_spawn *val) {
+    if(val->command != NULL) DUMPI_FREE_CHAR(val->command);
+    if(val->argv != NULL)
+      DUMPI_FREE_CHAR_ARRAY_2(DUMPI_NULLTERM, val->argv);
+    if(val->errcodes != NULL) DUMPI_FREE_ERRCODE(val->errcodes);
+  }
+  static inline void libundumpi_release_comm_spawn_multiple(dumpi_comm_spawn_multiple *val) {
+    if(val->commands != NULL)
+      DUMPI_FREE_CHAR_ARRAY_2(val->count, val->commands);
+    if(val->argvs != NULL)
+      DUMPI_FREE_CHAR_ARRAY_3(val->count, DUMPI_NULLTERM, val->argvs);
+    if(val->maxprocs != NULL) DUMPI_FREE_INT(val->maxprocs);
+    if(val->info != NULL) DUMPI_FREE_INFO(val->info);
+    if(val->errcodes != NULL) DUMPI_FREE_ERRCODE(val->errcodes);
+  }
+  static inline void libundumpi_release_lookup_name(dumpi_lookup_name *val) {
+    if(val->servicename != NULL) DUMPI_FREE_CHAR(val->servicename);
+    if(val->portname != NULL) DUMPI_FREE_CHAR(val->portname);
+  }
+  static inline void libundumpi_release_open_port(dumpi_open_port *val) {
+    if(val->portname != NULL) DUMPI_FREE_CHAR(val->portname);
+  }
+  static inline void libundumpi_release_publish_name(dumpi_publish_name *val) {
+    if(val->servicename != NULL) DUMPI_FREE_CHAR(val->servicename);
+    if(val->portname != NULL) DUMPI_FREE_CHAR(val->portname);
+  }
+  static inline void libundumpi_release_unpublish_name(dumpi_unpublish_name *val) {
+    if(val->servicename != NULL) DUMPI_FREE_CHAR(val->servicename);
+    if(val->portname != NULL) DUMPI_FREE_CHAR(val->portname);
+  }
+  static inline void libundumpi_release_accumulate(dumpi_accumulate *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_get(dumpi_get *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_put(dumpi_put *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_complete(dumpi_win_complete *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_create(dumpi_win_create *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_fence(dumpi_win_fence *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_free(dumpi_win_free *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_get_group(dumpi_win_get_group *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_lock(dumpi_win_lock *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_post(dumpi_win_post *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_start(dumpi_win_start *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_test(dumpi_win_test *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_unlock(dumpi_win_unlock *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_wait(dumpi_win_wait *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_alltoallw(dumpi_alltoallw *val) {
+    if(val->sendcounts != NULL) DUMPI_FREE_INT(val->sendcounts);
+    if(val->senddispls != NULL) DUMPI_FREE_INT(val->senddispls);
+    if(val->sendtypes != NULL) DUMPI_FREE_DATATYPE(val->sendtypes);
+    if(val->recvcounts != NULL) DUMPI_FREE_INT(val->recvcounts);
+    if(val->recvdispls != NULL) DUMPI_FREE_INT(val->recvdispls);
+    if(val->recvtypes != NULL) DUMPI_FREE_DATATYPE(val->recvtypes);
+  }
+  static inline void libundumpi_release_exscan(dumpi_exscan *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_add_error_class(dumpi_add_error_class *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_add_error_code(dumpi_add_error_code *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_add_error_string(dumpi_add_error_string *val) {
+    if(val->errorstring != NULL) DUMPI_FREE_CHAR(val->errorstring);
+  }
+  static inline void libundumpi_release_comm_call_errhandler(dumpi_comm_call_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_create_keyval(dumpi_comm_create_keyval *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_delete_attr(dumpi_comm_delete_attr *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_free_keyval(dumpi_comm_free_keyval *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_get_attr(dumpi_comm_get_attr *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_get_name(dumpi_comm_get_name *val) {
+    if(val->name != NULL) DUMPI_FREE_CHAR(val->name);
+  }
+  static inline void libundumpi_release_comm_set_attr(dumpi_comm_set_attr *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_set_name(dumpi_comm_set_name *val) {
+    if(val->name != NULL) DUMPI_FREE_CHAR(val->name);
+  }
+  static inline void libundumpi_release_file_call_errhandler(dumpi_file_call_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_grequest_complete(dumpi_grequest_complete *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_grequest_start(dumpi_grequest_start *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_init_thread(dumpi_init_thread *val) {
+    if(val->argv != NULL)
+      DUMPI_FREE_CHAR_ARRAY_2(val->argc, val->argv);
+  }
+  static inline void libundumpi_release_is_thread_main(dumpi_is_thread_main *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_query_thread(dumpi_query_thread *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_status_set_cancelled(dumpi_status_set_cancelled *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_status_set_elements(dumpi_status_set_elements *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_type_create_keyval(dumpi_type_create_keyval *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_delete_attr(dumpi_type_delete_attr *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_dup(dumpi_type_dup *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_free_keyval(dumpi_type_free_keyval *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_get_attr(dumpi_type_get_attr *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_get_contents(dumpi_type_get_contents *val) {
+    if(val->arrintegers != NULL) DUMPI_FREE_INT(val->arrintegers);
+    if(val->arraddresses != NULL) DUMPI_FREE_INT(val->arraddresses);
+    if(val->arrdatatypes != NULL) DUMPI_FREE_DATATYPE(val->arrdatatypes);
+  }
+  static inline void libundumpi_release_type_get_envelope(dumpi_type_get_envelope *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_get_name(dumpi_type_get_name *val) {
+    if(val->name != NULL) DUMPI_FREE_CHAR(val->name);
+  }
+  static inline void libundumpi_release_type_set_attr(dumpi_type_set_attr *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_set_name(dumpi_type_set_name *val) {
+    if(val->name != NULL) DUMPI_FREE_CHAR(val->name);
+  }
+  static inline void libundumpi_release_type_match_size(dumpi_type_match_size *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_call_errhandler(dumpi_win_call_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_create_keyval(dumpi_win_create_keyval *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_delete_attr(dumpi_win_delete_attr *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_free_keyval(dumpi_win_free_keyval *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_get_attr(dumpi_win_get_attr *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_get_name(dumpi_win_get_name *val) {
+    if(val->name != NULL) DUMPI_FREE_CHAR(val->name);
+  }
+  static inline void libundumpi_release_win_set_attr(dumpi_win_set_attr *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_set_name(dumpi_win_set_name *val) {
+    if(val->name != NULL) DUMPI_FREE_CHAR(val->name);
+  }
+  static inline void libundumpi_release_alloc_mem(dumpi_alloc_mem *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_create_errhandler(dumpi_comm_create_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_get_errhandler(dumpi_comm_get_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_comm_set_errhandler(dumpi_comm_set_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_create_errhandler(dumpi_file_create_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_get_errhandler(dumpi_file_get_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_set_errhandler(dumpi_file_set_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_finalized(dumpi_finalized *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_free_mem(dumpi_free_mem *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_get_address(dumpi_get_address *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_info_create(dumpi_info_create *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_info_delete(dumpi_info_delete *val) {
+    if(val->key != NULL) DUMPI_FREE_CHAR(val->key);
+  }
+  static inline void libundumpi_release_info_dup(dumpi_info_dup *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_info_free(dumpi_info_free *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_info_get(dumpi_info_get *val) {
+    if(val->key != NULL) DUMPI_FREE_CHAR(val->key);
+    if(val->value != NULL) DUMPI_FREE_CHAR(val->value);
+  }
+  static inline void libundumpi_release_info_get_nkeys(dumpi_info_get_nkeys *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_info_get_nthkey(dumpi_info_get_nthkey *val) {
+    if(val->key != NULL) DUMPI_FREE_CHAR(val->key);
+  }
+  static inline void libundumpi_release_info_get_valuelen(dumpi_info_get_valuelen *val) {
+    if(val->key != NULL) DUMPI_FREE_CHAR(val->key);
+  }
+  static inline void libundumpi_release_info_set(dumpi_info_set *val) {
+    if(val->key != NULL) DUMPI_FREE_CHAR(val->key);
+    if(val->value != NULL) DUMPI_FREE_CHAR(val->value);
+  }
+  static inline void libundumpi_release_pack_external(dumpi_pack_external *val) {
+    if(val->datarep != NULL) DUMPI_FREE_CHAR(val->datarep);
+  }
+  static inline void libundumpi_release_pack_external_size(dumpi_pack_external_size *val) {
+    if(val->datarep != NULL) DUMPI_FREE_CHAR(val->datarep);
+  }
+  static inline void libundumpi_release_request_get_status(dumpi_request_get_status *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_type_create_darray(dumpi_type_create_darray *val) {
+    if(val->gsizes != NULL) DUMPI_FREE_INT(val->gsizes);
+    if(val->distribs != NULL) DUMPI_FREE_DISTRIBUTION(val->distribs);
+    if(val->dargs != NULL) DUMPI_FREE_INT(val->dargs);
+    if(val->psizes != NULL) DUMPI_FREE_INT(val->psizes);
+  }
+  static inline void libundumpi_release_type_create_hindexed(dumpi_type_create_hindexed *val) {
+    if(val->blocklengths != NULL) DUMPI_FREE_INT(val->blocklengths);
+    if(val->displacements != NULL) DUMPI_FREE_INT(val->displacements);
+  }
+  static inline void libundumpi_release_type_create_hvector(dumpi_type_create_hvector *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_create_indexed_block(dumpi_type_create_indexed_block *val) {
+    if(val->displacments != NULL) DUMPI_FREE_INT(val->displacments);
+  }
+  static inline void libundumpi_release_type_create_resized(dumpi_type_create_resized *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_create_struct(dumpi_type_create_struct *val) {
+    if(val->blocklengths != NULL) DUMPI_FREE_INT(val->blocklengths);
+    if(val->displacements != NULL) DUMPI_FREE_INT(val->displacements);
+    if(val->oldtypes != NULL) DUMPI_FREE_DATATYPE(val->oldtypes);
+  }
+  static inline void libundumpi_release_type_create_subarray(dumpi_type_create_subarray *val) {
+    if(val->sizes != NULL) DUMPI_FREE_INT(val->sizes);
+    if(val->subsizes != NULL) DUMPI_FREE_INT(val->subsizes);
+    if(val->starts != NULL) DUMPI_FREE_INT(val->starts);
+  }
+  static inline void libundumpi_release_type_get_extent(dumpi_type_get_extent *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_type_get_true_extent(dumpi_type_get_true_extent *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_unpack_external(dumpi_unpack_external *val) {
+    if(val->datarep != NULL) DUMPI_FREE_CHAR(val->datarep);
+  }
+  static inline void libundumpi_release_win_create_errhandler(dumpi_win_create_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_get_errhandler(dumpi_win_get_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_win_set_errhandler(dumpi_win_set_errhandler *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_open(dumpi_file_open *val) {
+    if(val->filename != NULL) DUMPI_FREE_CHAR(val->filename);
+  }
+  static inline void libundumpi_release_file_close(dumpi_file_close *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_delete(dumpi_file_delete *val) {
+    if(val->filename != NULL) DUMPI_FREE_CHAR(val->filename);
+  }
+  static inline void libundumpi_release_file_set_size(dumpi_file_set_size *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_preallocate(dumpi_file_preallocate *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_get_size(dumpi_file_get_size *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_get_group(dumpi_file_get_group *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_get_amode(dumpi_file_get_amode *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_set_info(dumpi_file_set_info *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_get_info(dumpi_file_get_info *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_set_view(dumpi_file_set_view *val) {
+    if(val->datarep != NULL) DUMPI_FREE_CHAR(val->datarep);
+  }
+  static inline void libundumpi_release_file_get_view(dumpi_file_get_view *val) {
+    if(val->datarep != NULL) DUMPI_FREE_CHAR(val->datarep);
+  }
+  static inline void libundumpi_release_file_read_at(dumpi_file_read_at *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_read_at_all(dumpi_file_read_at_all *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_write_at(dumpi_file_write_at *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_write_at_all(dumpi_file_write_at_all *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_iread_at(dumpi_file_iread_at *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_iwrite_at(dumpi_file_iwrite_at *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_read(dumpi_file_read *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_read_all(dumpi_file_read_all *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_write(dumpi_file_write *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_write_all(dumpi_file_write_all *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_iread(dumpi_file_iread *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_iwrite(dumpi_file_iwrite *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_seek(dumpi_file_seek *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_get_position(dumpi_file_get_position *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_get_byte_offset(dumpi_file_get_byte_offset *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_read_shared(dumpi_file_read_shared *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_write_shared(dumpi_file_write_shared *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_iread_shared(dumpi_file_iread_shared *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_iwrite_shared(dumpi_file_iwrite_shared *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_read_ordered(dumpi_file_read_ordered *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_write_ordered(dumpi_file_write_ordered *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_seek_shared(dumpi_file_seek_shared *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_get_position_shared(dumpi_file_get_position_shared *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_read_at_all_begin(dumpi_file_read_at_all_begin *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_read_at_all_end(dumpi_file_read_at_all_end *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_write_at_all_begin(dumpi_file_write_at_all_begin *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_write_at_all_end(dumpi_file_write_at_all_end *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_read_all_begin(dumpi_file_read_all_begin *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_read_all_end(dumpi_file_read_all_end *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_write_all_begin(dumpi_file_write_all_begin *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_write_all_end(dumpi_file_write_all_end *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_read_ordered_begin(dumpi_file_read_ordered_begin *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_read_ordered_end(dumpi_file_read_ordered_end *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_write_ordered_begin(dumpi_file_write_ordered_begin *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_write_ordered_end(dumpi_file_write_ordered_end *val) {
+    if(val->status != NULL) DUMPI_FREE_STATUS(val->status);
+  }
+  static inline void libundumpi_release_file_get_type_extent(dumpi_file_get_type_extent *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_register_datarep(dumpi_register_datarep *val) {
+    if(val->name != NULL) DUMPI_FREE_CHAR(val->name);
+  }
+  static inline void libundumpi_release_file_set_atomicity(dumpi_file_set_atomicity *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_get_atomicity(dumpi_file_get_atomicity *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_file_sync(dumpi_file_sync *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_function_enter(dumpi_func_call *val) {
+    (void)val;
+  }
+  static inline void libundumpi_release_function_exit(dumpi_func_call *val) {
+    (void)val;
+  }
+
+  /**
+   * X-macro over every record type that can appear in a trace stream.
+   * X(ENUM, NAME, TYPE, READ) is expanded once per record, where ENUM is
+   * the dumpi_function label, TYPE the argument struct, READ the function
+   * that decodes it and libundumpi_release_##NAME the matching cleanup.
+   */
+#define LIBUNDUMPI_FOREACH_RECORD(X)                                                                                                   \
+  X(DUMPI_Send, send, dumpi_send, dumpi_read_send)                                                                                     \
+  X(DUMPI_Recv, recv, dumpi_recv, dumpi_read_recv)                                                                                     \
+  X(DUMPI_Get_count, get_count, dumpi_get_count, dumpi_read_get_count)                                                                 \
+  X(DUMPI_Bsend, bsend, dumpi_bsend, dumpi_read_bsend)                                                                                 \
+  X(DUMPI_Ssend, ssend, dumpi_ssend, dumpi_read_ssend)                                                                                 \
+  X(DUMPI_Rsend, rsend, dumpi_rsend, dumpi_read_rsend)                                                                                 \
+  X(DUMPI_Buffer_attach, buffer_attach, dumpi_buffer_attach, dumpi_read_buffer_attach)                                                 \
+  X(DUMPI_Buffer_detach, buffer_detach, dumpi_buffer_detach, dumpi_read_buffer_detach)                                                 \
+  X(DUMPI_Isend, isend, dumpi_isend, dumpi_read_isend)                                                                                 \
+  X(DUMPI_Ibsend, ibsend, dumpi_ibsend, dumpi_read_ibsend)                                                                             \
+  X(DUMPI_Issend, issend, dumpi_issend, dumpi_read_issend)                                                                             \
+  X(DUMPI_Irsend, irsend, dumpi_irsend, dumpi_read_irsend)                                                                             \
+  X(DUMPI_Irecv, irecv, dumpi_irecv, dumpi_read_irecv)                                                                                 \
+  X(DUMPI_Wait, wait, dumpi_wait, dumpi_read_wait)                                                                                     \
+  X(DUMPI_Test, test, dumpi_test, dumpi_read_test)                                                                                     \
+  X(DUMPI_Request_free, request_free, dumpi_request_free, dumpi_read_request_free)                                                     \
+  X(DUMPI_Waitany, waitany, dumpi_waitany, dumpi_read_waitany)                                                                         \
+  X(DUMPI_Testany, testany, dumpi_testany, dumpi_read_testany)                                                                         \
+  X(DUMPI_Waitall, waitall, dumpi_waitall, dumpi_read_waitall)                                                                         \
+  X(DUMPI_Testall, testall, dumpi_testall, dumpi_read_testall)                                                                         \
+  X(DUMPI_Waitsome, waitsome, dumpi_waitsome, dumpi_read_waitsome)                                                                     \
+  X(DUMPI_Testsome, testsome, dumpi_testsome, dumpi_read_testsome)                                                                     \
+  X(DUMPI_Iprobe, iprobe, dumpi_iprobe, dumpi_read_iprobe)                                                                             \
+  X(DUMPI_Probe, probe, dumpi_probe, dumpi_read_probe)                                                                                 \
+  X(DUMPI_Cancel, cancel, dumpi_cancel, dumpi_read_cancel)                                                                             \
+  X(DUMPI_Test_cancelled, test_cancelled, dumpi_test_cancelled, dumpi_read_test_cancelled)                                             \
+  X(DUMPI_Send_init, send_init, dumpi_send_init, dumpi_read_send_init)                                                                 \
+  X(DUMPI_Bsend_init, bsend_init, dumpi_bsend_init, dumpi_read_bsend_init)                                                             \
+  X(DUMPI_Ssend_init, ssend_init, dumpi_ssend_init, dumpi_read_ssend_init)                                                             \
+  X(DUMPI_Rsend_init, rsend_init, dumpi_rsend_init, dumpi_read_rsend_init)                                                             \
+  X(DUMPI_Recv_init, recv_init, dumpi_recv_init, dumpi_read_recv_init)                                                                 \
+  X(DUMPI_Start, start, dumpi_start, dumpi_read_start)                                                                                 \
+  X(DUMPI_Startall, startall, dumpi_startall, dumpi_read_startall)                                                                     \
+  X(DUMPI_Sendrecv, sendrecv, dumpi_sendrecv, dumpi_read_sendrecv)                                                                     \
+  X(DUMPI_Sendrecv_replace, sendrecv_replace, dumpi_sendrecv_replace, dumpi_read_sendrecv_replace)                                     \
+  X(DUMPI_Type_contiguous, type_contiguous, dumpi_type_contiguous, dumpi_read_type_contiguous)                                         \
+  X(DUMPI_Type_vector, type_vector, dumpi_type_vector, dumpi_read_type_vector)                                                         \
+  X(DUMPI_Type_hvector, type_hvector, dumpi_type_hvector, dumpi_read_type_hvector)                                                     \
+  X(DUMPI_Type_indexed, type_indexed, dumpi_type_indexed, dumpi_read_type_indexed)                                                     \
+  X(DUMPI_Type_hindexed, type_hindexed, dumpi_type_hindexed, dumpi_read_type_hindexed)                                                 \
+  X(DUMPI_Type_struct, type_struct, dumpi_type_struct, dumpi_read_type_struct)                                                         \
+  X(DUMPI_Address, address, dumpi_address, dumpi_read_address)                                                                         \
+  X(DUMPI_Type_extent, type_extent, dumpi_type_extent, dumpi_read_type_extent)                                                         \
+  X(DUMPI_Type_size, type_size, dumpi_type_size, dumpi_read_type_size)                                                                 \
+  X(DUMPI_Type_lb, type_lb, dumpi_type_lb, dumpi_read_type_lb)                                                                         \
+  X(DUMPI_Type_ub, type_ub, dumpi_type_ub, dumpi_read_type_ub)                                                                         \
+  X(DUMPI_Type_commit, type_commit, dumpi_type_commit, dumpi_read_type_commit)                                                         \
+  X(DUMPI_Type_free, type_free, dumpi_type_free, dumpi_read_type_free)                                                                 \
+  X(DUMPI_Get_elements, get_elements, dumpi_get_elements, dumpi_read_get_elements)                                                     \
+  X(DUMPI_Pack, pack, dumpi_pack, dumpi_read_pack)                                                                                     \
+  X(DUMPI_Unpack, unpack, dumpi_unpack, dumpi_read_unpack)                                                                             \
+  X(DUMPI_Pack_size, pack_size, dumpi_pack_size, dumpi_read_pack_size)                                                                 \
+  X(DUMPI_Barrier, barrier, dumpi_barrier, dumpi_read_barrier)                                                                         \
+  X(DUMPI_Bcast, bcast, dumpi_bcast, dumpi_read_bcast)                                                                                 \
+  X(DUMPI_Gather, gather, dumpi_gather, dumpi_read_gather)                                                                             \
+  X(DUMPI_Gatherv, gatherv, dumpi_gatherv, dumpi_read_gatherv)                                                                         \
+  X(DUMPI_Scatter, scatter, dumpi_scatter, dumpi_read_scatter)                                                                         \
+  X(DUMPI_Scatterv, scatterv, dumpi_scatterv, dumpi_read_scatterv)                                                                     \
+  X(DUMPI_Allgather, allgather, dumpi_allgather, dumpi_read_allgather)                                                                 \
+  X(DUMPI_Allgatherv, allgatherv, dumpi_allgatherv, dumpi_read_allgatherv)                                                             \
+  X(DUMPI_Alltoall, alltoall, dumpi_alltoall, dumpi_read_alltoall)                                                                     \
+  X(DUMPI_Alltoallv, alltoallv, dumpi_alltoallv, dumpi_read_alltoallv)                                                                 \
+  X(DUMPI_Reduce, reduce, dumpi_reduce, dumpi_read_reduce)                                                                             \
+  X(DUMPI_Op_create, op_create, dumpi_op_create, dumpi_read_op_create)                                                                 \
+  X(DUMPI_Op_free, op_free, dumpi_op_free, dumpi_read_op_free)                                                                         \
+  X(DUMPI_Allreduce, allreduce, dumpi_allreduce, dumpi_read_allreduce)                                                                 \
+  X(DUMPI_Reduce_scatter, reduce_scatter, dumpi_reduce_scatter, dumpi_read_reduce_scatter)                                             \
+  X(DUMPI_Scan, scan, dumpi_scan, dumpi_read_scan)                                                                                     \
+  X(DUMPI_Group_size, group_size, dumpi_group_size, dumpi_read_group_size)                                                             \
+  X(DUMPI_Group_rank, group_rank, dumpi_group_rank, dumpi_read_group_rank)                                                             \
+  X(DUMPI_Group_translate_ranks, group_translate_ranks, dumpi_group_translate_ranks, dumpi_read_group_translate_ranks)                 \
+  X(DUMPI_Group_compare, group_compare, dumpi_group_compare, dumpi_read_group_compare)                                                 \
+  X(DUMPI_Comm_group, comm_group, dumpi_comm_group, dumpi_read_comm_group)                                                             \
+  X(DUMPI_Group_union, group_union, dumpi_group_union, dumpi_read_group_union)                                                         \
+  X(DUMPI_Group_intersection, group_intersection, dumpi_group_intersection, dumpi_read_group_intersection)                             \
+  X(DUMPI_Group_difference, group_difference, dumpi_group_difference, dumpi_read_group_difference)                                     \
+  X(DUMPI_Group_incl, group_incl, dumpi_group_incl, dumpi_read_group_incl)                                                             \
+  X(DUMPI_Group_excl, group_excl, dumpi_group_excl, dumpi_read_group_excl)                                                             \
+  X(DUMPI_Group_range_incl, group_range_incl, dumpi_group_range_incl, dumpi_read_group_range_incl)                                     \
+  X(DUMPI_Group_range_excl, group_range_excl, dumpi_group_range_excl, dumpi_read_group_range_excl)                                     \
+  X(DUMPI_Group_free, group_free, dumpi_group_free, dumpi_read_group_free)                                                             \
+  X(DUMPI_Comm_size, comm_size, dumpi_comm_size, dumpi_read_comm_size)                                                                 \
+  X(DUMPI_Comm_rank, comm_rank, dumpi_comm_rank, dumpi_read_comm_rank)                                                                 \
+  X(DUMPI_Comm_compare, comm_compare, dumpi_comm_compare, dumpi_read_comm_compare)                                                     \
+  X(DUMPI_Comm_dup, comm_dup, dumpi_comm_dup, dumpi_read_comm_dup)                                                                     \
+  X(DUMPI_Comm_create, comm_create, dumpi_comm_create, dumpi_read_comm_create)                                                         \
+  X(DUMPI_Comm_split, comm_split, dumpi_comm_split, dumpi_read_comm_split)                                                             \
+  X(DUMPI_Comm_free, comm_free, dumpi_comm_free, dumpi_read_comm_free)                                                                 \
+  X(DUMPI_Comm_test_inter, comm_test_inter, dumpi_comm_test_inter, dumpi_read_comm_test_inter)                                         \
+  X(DUMPI_Comm_remote_size, comm_remote_size, dumpi_comm_remote_size, dumpi_read_comm_remote_size)                                     \
+  X(DUMPI_Comm_remote_group, comm_remote_group, dumpi_comm_remote_group, dumpi_read_comm_remote_group)                                 \
+  X(DUMPI_Intercomm_create, intercomm_create, dumpi_intercomm_create, dumpi_read_intercomm_create)                                     \
+  X(DUMPI_Intercomm_merge, intercomm_merge, dumpi_intercomm_merge, dumpi_read_intercomm_merge)                                         \
+  X(DUMPI_Keyval_create, keyval_create, dumpi_keyval_create, dumpi_read_keyval_create)                                                 \
+  X(DUMPI_Keyval_free, keyval_free, dumpi_keyval_free, dumpi_read_keyval_free)                                                         \
+  X(DUMPI_Attr_put, attr_put, dumpi_attr_put, dumpi_read_attr_put)                                                                     \
+  X(DUMPI_Attr_get, attr_get, dumpi_attr_get, dumpi_read_attr_get)                                                                     \
+  X(DUMPI_Attr_delete, attr_delete, dumpi_attr_delete, dumpi_read_attr_delete)                                                         \
+  X(DUMPI_Topo_test, topo_test, dumpi_topo_test, dumpi_read_topo_test)                                                                 \
+  X(DUMPI_Cart_create, cart_create, dumpi_cart_create, dumpi_read_cart_create)                                                         \
+  X(DUMPI_Dims_create, dims_create, dumpi_dims_create, dumpi_read_dims_create)                                                         \
+  X(DUMPI_Graph_create, graph_create, dumpi_graph_create, dumpi_read_graph_create)                                                     \
+  X(DUMPI_Graphdims_get, graphdims_get, dumpi_graphdims_get, dumpi_read_graphdims_get)                                                 \
+  X(DUMPI_Graph_get, graph_get, dumpi_graph_get, dumpi_read_graph_get)                                                                 \
+  X(DUMPI_Cartdim_get, cartdim_get, dumpi_cartdim_get, dumpi_read_cartdim_get)                                                         \
+  X(DUMPI_Cart_get, cart_get, dumpi_cart_get, dumpi_read_cart_get)                                                                     \
+  X(DUMPI_Cart_rank, cart_rank, dumpi_cart_rank, dumpi_read_cart_rank)                                                                 \
+  X(DUMPI_Cart_coords, cart_coords, dumpi_cart_coords, dumpi_read_cart_coords)                                                         \
+  X(DUMPI_Graph_neighbors_count, graph_neighbors_count, dumpi_graph_neighbors_count, dumpi_read_graph_neighbors_count)                 \
+  X(DUMPI_Graph_neighbors, graph_neighbors, dumpi_graph_neighbors, dumpi_read_graph_neighbors)                                         \
+  X(DUMPI_Cart_shift, cart_shift, dumpi_cart_shift, dumpi_read_cart_shift)                                                             \
+  X(DUMPI_Cart_sub, cart_sub, dumpi_cart_sub, dumpi_read_cart_sub)                                                                     \
+  X(DUMPI_Cart_map, cart_map, dumpi_cart_map, dumpi_read_cart_map)                                                                     \
+  X(DUMPI_Graph_map, graph_map, dumpi_graph_map, dumpi_read_graph_map)                                                                 \
+  X(DUMPI_Get_processor_name, get_processor_name, dumpi_get_processor_name, dumpi_read_get_processor_name)                             \
+  X(DUMPI_Get_version, get_version, dumpi_get_version, dumpi_read_get_version)                                                         \
+  X(DUMPI_Errhandler_create, errhandler_create, dumpi_errhandler_create, dumpi_read_errhandler_create)                                 \
+  X(DUMPI_Errhandler_set, errhandler_set, dumpi_errhandler_set, dumpi_read_errhandler_set)                                             \
+  X(DUMPI_Errhandler_get, errhandler_get, dumpi_errhandler_get, dumpi_read_errhandler_get)                                             \
+  X(DUMPI_Errhandler_free, errhandler_free, dumpi_errhandler_free, dumpi_read_errhandler_free)                                         \
+  X(DUMPI_Error_string, error_string, dumpi_error_string, dumpi_read_error_string)                                                     \
+  X(DUMPI_Error_class, error_class, dumpi_error_class, dumpi_read_error_class)                                                         \
+  X(DUMPI_Wtime, wtime, dumpi_wtime, dumpi_read_wtime)                                                                                 \
+  X(DUMPI_Wtick, wtick, dumpi_wtick, dumpi_read_wtick)                                                                                 \
+  X(DUMPI_Init, init, dumpi_init, dumpi_read_init)                                                                                     \
+  X(DUMPI_Finalize, finalize, dumpi_finalize, dumpi_read_finalize)                                                                     \
+  X(DUMPI_Initialized, initialized, dumpi_initialized, dumpi_read_initialized)                                                         \
+  X(DUMPI_Abort, abort, dumpi_abort, dumpi_read_abort)                                                                                 \
+  X(DUMPI_Close_port, close_port, dumpi_close_port, dumpi_read_close_port)                                                             \
+  X(DUMPI_Comm_accept, comm_accept, dumpi_comm_accept, dumpi_read_comm_accept)                                                         \
+  X(DUMPI_Comm_connect, comm_connect, dumpi_comm_connect, dumpi_read_comm_connect)                                                     \
+  X(DUMPI_Comm_disconnect, comm_disconnect, dumpi_comm_disconnect, dumpi_read_comm_disconnect)                                         \
+  X(DUMPI_Comm_get_parent, comm_get_parent, dumpi_comm_get_parent, dumpi_read_comm_get_parent)                                         \
+  X(DUMPI_Comm_join, comm_join, dumpi_comm_join, dumpi_read_comm_join)                                                                 \
+  X(DUMPI_Comm_spawn, comm_spawn, dumpi_comm_spawn, dumpi_read_comm_spawn)                                                             \
+  X(DUMPI_Comm_spawn_multiple, comm_spawn_multiple, dumpi_comm_spawn_multiple, dumpi_read_comm_spawn_multiple)                         \
+  X(DUMPI_Lookup_name, lookup_name, dumpi_lookup_name, dumpi_read_lookup_name)                                                         \
+  X(DUMPI_Open_port, open_port, dumpi_open_port, dumpi_read_open_port)                                                                 \
+  X(DUMPI_Publish_name, publish_name, dumpi_publish_name, dumpi_read_publish_name)                                                     \
+  X(DUMPI_Unpublish_name, unpublish_name, dumpi_unpublish_name, dumpi_read_unpublish_name)                                             \
+  X(DUMPI_Accumulate, accumulate, dumpi_accumulate, dumpi_read_accumulate)                                                             \
+  X(DUMPI_Get, get, dumpi_get, dumpi_read_get)                                                                                         \
+  X(DUMPI_Put, put, dumpi_put, dumpi_read_put)                                                                                         \
+  X(DUMPI_Win_complete, win_complete, dumpi_win_complete, dumpi_read_win_complete)                                                     \
+  X(DUMPI_Win_create, win_create, dumpi_win_create, dumpi_read_win_create)                                                             \
+  X(DUMPI_Win_fence, win_fence, dumpi_win_fence, dumpi_read_win_fence)                                                                 \
+  X(DUMPI_Win_free, win_free, dumpi_win_free, dumpi_read_win_free)                                                                     \
+  X(DUMPI_Win_get_group, win_get_group, dumpi_win_get_group, dumpi_read_win_get_group)                                                 \
+  X(DUMPI_Win_lock, win_lock, dumpi_win_lock, dumpi_read_win_lock)                                                                     \
+  X(DUMPI_Win_post, win_post, dumpi_win_post, dumpi_read_win_post)                                                                     \
+  X(DUMPI_Win_start, win_start, dumpi_win_start, dumpi_read_win_start)                                                                 \
+  X(DUMPI_Win_test, win_test, dumpi_win_test, dumpi_read_win_test)                                                                     \
+  X(DUMPI_Win_unlock, win_unlock, dumpi_win_unlock, dumpi_read_win_unlock)                                                             \
+  X(DUMPI_Win_wait, win_wait, dumpi_win_wait, dumpi_read_win_wait)                                                                     \
+  X(DUMPI_Alltoallw, alltoallw, dumpi_alltoallw, dumpi_read_alltoallw)                                                                 \
+  X(DUMPI_Exscan, exscan, dumpi_exscan, dumpi_read_exscan)                                                                             \
+  X(DUMPI_Add_error_class, add_error_class, dumpi_add_error_class, dumpi_read_add_error_class)                                         \
+  X(DUMPI_Add_error_code, add_error_code, dumpi_add_error_code, dumpi_read_add_error_code)                                             \
+  X(DUMPI_Add_error_string, add_error_string, dumpi_add_error_string, dumpi_read_add_error_string)                                     \
+  X(DUMPI_Comm_call_errhandler, comm_call_errhandler, dumpi_comm_call_errhandler, dumpi_read_comm_call_errhandler)                     \
+  X(DUMPI_Comm_create_keyval, comm_create_keyval, dumpi_comm_create_keyval, dumpi_read_comm_create_keyval)                             \
+  X(DUMPI_Comm_delete_attr, comm_delete_attr, dumpi_comm_delete_attr, dumpi_read_comm_delete_attr)                                     \
+  X(DUMPI_Comm_free_keyval, comm_free_keyval, dumpi_comm_free_keyval, dumpi_read_comm_free_keyval)                                     \
+  X(DUMPI_Comm_get_attr, comm_get_attr, dumpi_comm_get_attr, dumpi_read_comm_get_attr)                                                 \
+  X(DUMPI_Comm_get_name, comm_get_name, dumpi_comm_get_name, dumpi_read_comm_get_name)                                                 \
+  X(DUMPI_Comm_set_attr, comm_set_attr, dumpi_comm_set_attr, dumpi_read_comm_set_attr)                                                 \
+  X(DUMPI_Comm_set_name, comm_set_name, dumpi_comm_set_name, dumpi_read_comm_set_name)                                                 \
+  X(DUMPI_File_call_errhandler, file_call_errhandler, dumpi_file_call_errhandler, dumpi_read_file_call_errhandler)                     \
+  X(DUMPI_Grequest_complete, grequest_complete, dumpi_grequest_complete, dumpi_read_grequest_complete)                                 \
+  X(DUMPI_Grequest_start, grequest_start, dumpi_grequest_start, dumpi_read_grequest_start)                                             \
+  X(DUMPI_Init_thread, init_thread, dumpi_init_thread, dumpi_read_init_thread)                                                         \
+  X(DUMPI_Is_thread_main, is_thread_main, dumpi_is_thread_main, dumpi_read_is_thread_main)                                             \
+  X(DUMPI_Query_thread, query_thread, dumpi_query_thread, dumpi_read_query_thread)                                                     \
+  X(DUMPI_Status_set_cancelled, status_set_cancelled, dumpi_status_set_cancelled, dumpi_read_status_set_cancelled)                     \
+  X(DUMPI_Status_set_elements, status_set_elements, dumpi_status_set_elements, dumpi_read_status_set_elements)                         \
+  X(DUMPI_Type_create_keyval, type_create_keyval, dumpi_type_create_keyval, dumpi_read_type_create_keyval)                             \
+  X(DUMPI_Type_delete_attr, type_delete_attr, dumpi_type_delete_attr, dumpi_read_type_delete_attr)                                     \
+  X(DUMPI_Type_dup, type_dup, dumpi_type_dup, dumpi_read_type_dup)                                                                     \
+  X(DUMPI_Type_free_keyval, type_free_keyval, dumpi_type_free_keyval, dumpi_read_type_free_keyval)                                     \
+  X(DUMPI_Type_get_attr, type_get_attr, dumpi_type_get_attr, dumpi_read_type_get_attr)                                                 \
+  X(DUMPI_Type_get_contents, type_get_contents, dumpi_type_get_contents, dumpi_read_type_get_contents)                                 \
+  X(DUMPI_Type_get_envelope, type_get_envelope, dumpi_type_get_envelope, dumpi_read_type_get_envelope)                                 \
+  X(DUMPI_Type_get_name, type_get_name, dumpi_type_get_name, dumpi_read_type_get_name)                                                 \
+  X(DUMPI_Type_set_attr, type_set_attr, dumpi_type_set_attr, dumpi_read_type_set_attr)                                                 \
+  X(DUMPI_Type_set_name, type_set_name, dumpi_type_set_name, dumpi_read_type_set_name)                                                 \
+  X(DUMPI_Type_match_size, type_match_size, dumpi_type_match_size, dumpi_read_type_match_size)                                         \
+  X(DUMPI_Win_call_errhandler, win_call_errhandler, dumpi_win_call_errhandler, dumpi_read_win_call_errhandler)                         \
+  X(DUMPI_Win_create_keyval, win_create_keyval, dumpi_win_create_keyval, dumpi_read_win_create_keyval)                                 \
+  X(DUMPI_Win_delete_attr, win_delete_attr, dumpi_win_delete_attr, dumpi_read_win_delete_attr)                                         \
+  X(DUMPI_Win_free_keyval, win_free_keyval, dumpi_win_free_keyval, dumpi_read_win_free_keyval)                                         \
+  X(DUMPI_Win_get_attr, win_get_attr, dumpi_win_get_attr, dumpi_read_win_get_attr)                                                     \
+  X(DUMPI_Win_get_name, win_get_name, dumpi_win_get_name, dumpi_read_win_get_name)                                                     \
+  X(DUMPI_Win_set_attr, win_set_attr, dumpi_win_set_attr, dumpi_read_win_set_attr)                                                     \
+  X(DUMPI_Win_set_name, win_set_name, dumpi_win_set_name, dumpi_read_win_set_name)                                                     \
+  X(DUMPI_Alloc_mem, alloc_mem, dumpi_alloc_mem, dumpi_read_alloc_mem)                                                                 \
+  X(DUMPI_Comm_create_errhandler, comm_create_errhandler, dumpi_comm_create_errhandler, dumpi_read_comm_create_errhandler)             \
+  X(DUMPI_Comm_get_errhandler, comm_get_errhandler, dumpi_comm_get_errhandler, dumpi_read_comm_get_errhandler)                         \
+  X(DUMPI_Comm_set_errhandler, comm_set_errhandler, dumpi_comm_set_errhandler, dumpi_read_comm_set_errhandler)                         \
+  X(DUMPI_File_create_errhandler, file_create_errhandler, dumpi_file_create_errhandler, dumpi_read_file_create_errhandler)             \
+  X(DUMPI_File_get_errhandler, file_get_errhandler, dumpi_file_get_errhandler, dumpi_read_file_get_errhandler)                         \
+  X(DUMPI_File_set_errhandler, file_set_errhandler, dumpi_file_set_errhandler, dumpi_read_file_set_errhandler)                         \
+  X(DUMPI_Finalized, finalized, dumpi_finalized, dumpi_read_finalized)                                                                 \
+  X(DUMPI_Free_mem, free_mem, dumpi_free_mem, dumpi_read_free_mem)                                                                     \
+  X(DUMPI_Get_address, get_address, dumpi_get_address, dumpi_read_get_address)                                                         \
+  X(DUMPI_Info_create, info_create, dumpi_info_create, dumpi_read_info_create)                                                         \
+  X(DUMPI_Info_delete, info_delete, dumpi_info_delete, dumpi_read_info_delete)                                                         \
+  X(DUMPI_Info_dup, info_dup, dumpi_info_dup, dumpi_read_info_dup)                                                                     \
+  X(DUMPI_Info_free, info_free, dumpi_info_free, dumpi_read_info_free)                                                                 \
+  X(DUMPI_Info_get, info_get, dumpi_info_get, dumpi_read_info_get)                                                                     \
+  X(DUMPI_Info_get_nkeys, info_get_nkeys, dumpi_info_get_nkeys, dumpi_read_info_get_nkeys)                                             \
+  X(DUMPI_Info_get_nthkey, info_get_nthkey, dumpi_info_get_nthkey, dumpi_read_info_get_nthkey)                                         \
+  X(DUMPI_Info_get_valuelen, info_get_valuelen, dumpi_info_get_valuelen, dumpi_read_info_get_valuelen)                                 \
+  X(DUMPI_Info_set, info_set, dumpi_info_set, dumpi_read_info_set)                                                                     \
+  X(DUMPI_Pack_external, pack_external, dumpi_pack_external, dumpi_read_pack_external)                                                 \
+  X(DUMPI_Pack_external_size, pack_external_size, dumpi_pack_external_size, dumpi_read_pack_external_size)                             \
+  X(DUMPI_Request_get_status, request_get_status, dumpi_request_get_status, dumpi_read_request_get_status)                             \
+  X(DUMPI_Type_create_darray, type_create_darray, dumpi_type_create_darray, dumpi_read_type_create_darray)                             \
+  X(DUMPI_Type_create_hindexed, type_create_hindexed, dumpi_type_create_hindexed, dumpi_read_type_create_hindexed)                     \
+  X(DUMPI_Type_create_hvector, type_create_hvector, dumpi_type_create_hvector, dumpi_read_type_create_hvector)                         \
+  X(DUMPI_Type_create_indexed_block, type_create_indexed_block, dumpi_type_create_indexed_block, dumpi_read_type_create_indexed_block) \
+  X(DUMPI_Type_create_resized, type_create_resized, dumpi_type_create_resized, dumpi_read_type_create_resized)                         \
+  X(DUMPI_Type_create_struct, type_create_struct, dumpi_type_create_struct, dumpi_read_type_create_struct)                             \
+  X(DUMPI_Type_create_subarray, type_create_subarray, dumpi_type_create_subarray, dumpi_read_type_create_subarray)                     \
+  X(DUMPI_Type_get_extent, type_get_extent, dumpi_type_get_extent, dumpi_read_type_get_extent)                                         \
+  X(DUMPI_Type_get_true_extent, type_get_true_extent, dumpi_type_get_true_extent, dumpi_read_type_get_true_extent)                     \
+  X(DUMPI_Unpack_external, unpack_external, dumpi_unpack_external, dumpi_read_unpack_external)                                         \
+  X(DUMPI_Win_create_errhandler, win_create_errhandler, dumpi_win_create_errhandler, dumpi_read_win_create_errhandler)                 \
+  X(DUMPI_Win_get_errhandler, win_get_errhandler, dumpi_win_get_errhandler, dumpi_read_win_get_errhandler)                             \
+  X(DUMPI_Win_set_errhandler, win_set_errhandler, dumpi_win_set_errhandler, dumpi_read_win_set_errhandler)                             \
+  X(DUMPI_File_open, file_open, dumpi_file_open, dumpi_read_file_open)                                                                 \
+  X(DUMPI_File_close, file_close, dumpi_file_close, dumpi_read_file_close)                                                             \
+  X(DUMPI_File_delete, file_delete, dumpi_file_delete, dumpi_read_file_delete)                                                         \
+  X(DUMPI_File_set_size, file_set_size, dumpi_file_set_size, dumpi_read_file_set_size)                                                 \
+  X(DUMPI_File_preallocate, file_preallocate, dumpi_file_preallocate, dumpi_read_file_preallocate)                                     \
+  X(DUMPI_File_get_size, file_get_size, dumpi_file_get_size, dumpi_read_file_get_size)                                                 \
+  X(DUMPI_File_get_group, file_get_group, dumpi_file_get_group, dumpi_read_file_get_group)                                             \
+  X(DUMPI_File_get_amode, file_get_amode, dumpi_file_get_amode, dumpi_read_file_get_amode)                                             \
+  X(DUMPI_File_set_info, file_set_info, dumpi_file_set_info, dumpi_read_file_set_info)                                                 \
+  X(DUMPI_File_get_info, file_get_info, dumpi_file_get_info, dumpi_read_file_get_info)                                                 \
+  X(DUMPI_File_set_view, file_set_view, dumpi_file_set_view, dumpi_read_file_set_view)                                                 \
+  X(DUMPI_File_get_view, file_get_view, dumpi_file_get_view, dumpi_read_file_get_view)                                                 \
+  X(DUMPI_File_read_at, file_read_at, dumpi_file_read_at, dumpi_read_file_read_at)                                                     \
+  X(DUMPI_File_read_at_all, file_read_at_all, dumpi_file_read_at_all, dumpi_read_file_read_at_all)                                     \
+  X(DUMPI_File_write_at, file_write_at, dumpi_file_write_at, dumpi_read_file_write_at)                                                 \
+  X(DUMPI_File_write_at_all, file_write_at_all, dumpi_file_write_at_all, dumpi_read_file_write_at_all)                                 \
+  X(DUMPI_File_iread_at, file_iread_at, dumpi_file_iread_at, dumpi_read_file_iread_at)                                                 \
+  X(DUMPI_File_iwrite_at, file_iwrite_at, dumpi_file_iwrite_at, dumpi_read_file_iwrite_at)                                             \
+  X(DUMPI_File_read, file_read, dumpi_file_read, dumpi_read_file_read)                                                                 \
+  X(DUMPI_File_read_all, file_read_all, dumpi_file_read_all, dumpi_read_file_read_all)                                                 \
+  X(DUMPI_File_write, file_write, dumpi_file_write, dumpi_read_file_write)                                                             \
+  X(DUMPI_File_write_all, file_write_all, dumpi_file_write_all, dumpi_read_file_write_all)                                             \
+  X(DUMPI_File_iread, file_iread, dumpi_file_iread, dumpi_read_file_iread)                                                             \
+  X(DUMPI_File_iwrite, file_iwrite, dumpi_file_iwrite, dumpi_read_file_iwrite)                                                         \
+  X(DUMPI_File_seek, file_seek, dumpi_file_seek, dumpi_read_file_seek)                                                                 \
+  X(DUMPI_File_get_position, file_get_position, dumpi_file_get_position, dumpi_read_file_get_position)                                 \
+  X(DUMPI_File_get_byte_offset, file_get_byte_offset, dumpi_file_get_byte_offset, dumpi_read_file_get_byte_offset)                     \
+  X(DUMPI_File_read_shared, file_read_shared, dumpi_file_read_shared, dumpi_read_file_read_shared)                                     \
+  X(DUMPI_File_write_shared, file_write_shared, dumpi_file_write_shared, dumpi_read_file_write_shared)                                 \
+  X(DUMPI_File_iread_shared, file_iread_shared, dumpi_file_iread_shared, dumpi_read_file_iread_shared)                                 \
+  X(DUMPI_File_iwrite_shared, file_iwrite_shared, dumpi_file_iwrite_shared, dumpi_read_file_iwrite_shared)                             \
+  X(DUMPI_File_read_ordered, file_read_ordered, dumpi_file_read_ordered, dumpi_read_file_read_ordered)                                 \
+  X(DUMPI_File_write_ordered, file_write_ordered, dumpi_file_write_ordered, dumpi_read_file_write_ordered)                             \
+  X(DUMPI_File_seek_shared, file_seek_shared, dumpi_file_seek_shared, dumpi_read_file_seek_shared)                                     \
+  X(DUMPI_File_get_position_shared, file_get_position_shared, dumpi_file_get_position_shared, dumpi_read_file_get_position_shared)     \
+  X(DUMPI_File_read_at_all_begin, file_read_at_all_begin, dumpi_file_read_at_all_begin, dumpi_read_file_read_at_all_begin)             \
+  X(DUMPI_File_read_at_all_end, file_read_at_all_end, dumpi_file_read_at_all_end, dumpi_read_file_read_at_all_end)                     \
+  X(DUMPI_File_write_at_all_begin, file_write_at_all_begin, dumpi_file_write_at_all_begin, dumpi_read_file_write_at_all_begin)         \
+  X(DUMPI_File_write_at_all_end, file_write_at_all_end, dumpi_file_write_at_all_end, dumpi_read_file_write_at_all_end)                 \
+  X(DUMPI_File_read_all_begin, file_read_all_begin, dumpi_file_read_all_begin, dumpi_read_file_read_all_begin)                         \
+  X(DUMPI_File_read_all_end, file_read_all_end, dumpi_file_read_all_end, dumpi_read_file_read_all_end)                                 \
+  X(DUMPI_File_write_all_begin, file_write_all_begin, dumpi_file_write_all_begin, dumpi_read_file_write_all_begin)                     \
+  X(DUMPI_File_write_all_end, file_write_all_end, dumpi_file_write_all_end, dumpi_read_file_write_all_end)                             \
+  X(DUMPI_File_read_ordered_begin, file_read_ordered_begin, dumpi_file_read_ordered_begin, dumpi_read_file_read_ordered_begin)         \
+  X(DUMPI_File_read_ordered_end, file_read_ordered_end, dumpi_file_read_ordered_end, dumpi_read_file_read_ordered_end)                 \
+  X(DUMPI_File_write_ordered_begin, file_write_ordered_begin, dumpi_file_write_ordered_begin, dumpi_read_file_write_ordered_begin)     \
+  X(DUMPI_File_write_ordered_end, file_write_ordered_end, dumpi_file_write_ordered_end, dumpi_read_file_write_ordered_end)             \
+  X(DUMPI_File_get_type_extent, file_get_type_extent, dumpi_file_get_type_extent, dumpi_read_file_get_type_extent)                     \
+  X(DUMPI_Register_datarep, register_datarep, dumpi_register_datarep, dumpi_read_register_datarep)                                     \
+  X(DUMPI_File_set_atomicity, file_set_atomicity, dumpi_file_set_atomicity, dumpi_read_file_set_atomicity)                             \
+  X(DUMPI_File_get_atomicity, file_get_atomicity, dumpi_file_get_atomicity, dumpi_read_file_get_atomicity)                             \
+  X(DUMPI_File_sync, file_sync, dumpi_file_sync, dumpi_read_file_sync)                                                                 \
+  X(DUMPI_Function_enter, function_enter, dumpi_func_call, dumpi_read_func_enter)                                                      \
+  X(DUMPI_Function_exit, function_exit, dumpi_func_call, dumpi_read_func_exit)
+
+  /*@}*/ /* close doxygen comment group */
+
+#ifdef __cplusplus
+} /* End of extern "C" block */
+#endif /* ! __cplusplus */
+
+#endif /* DUMPI_LIBUNDUMPI_RECORDS_H */